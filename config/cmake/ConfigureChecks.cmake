@@ -163,6 +163,21 @@ if (NOT WINDOWS)
   endif ()
 endif ()
 
+#-----------------------------------------------------------------------------
+#  Check if the io_uring driver can be built
+#-----------------------------------------------------------------------------
+if (CMAKE_SYSTEM_NAME MATCHES "Linux")
+  option (HDF5_ENABLE_IOURING_VFD "Build the io_uring Virtual File Driver" OFF)
+  if (HDF5_ENABLE_IOURING_VFD)
+    CHECK_INCLUDE_FILE ("linux/io_uring.h" HAVE_LINUX_IO_URING_H)
+    if (HAVE_LINUX_IO_URING_H)
+      set (${HDF_PREFIX}_HAVE_IOURING 1)
+    else ()
+      message (FATAL_ERROR "The io_uring VFD was requested but linux/io_uring.h was not found")
+    endif ()
+  endif ()
+endif ()
+
 #-----------------------------------------------------------------------------
 # Check if C has __float128 extension
 #-----------------------------------------------------------------------------
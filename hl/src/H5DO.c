@@ -166,6 +166,169 @@ done:
     return ret_value;
 } /* end H5DOread_chunk() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5DOwrite_chunks
+ *
+ * Purpose:     Writes several entire chunks to the file directly.
+ *		OFFSETS holds the logical offsets of the NCHUNKS chunks,
+ *		one after another (NCHUNKS times the dataset's rank
+ *		values).  FILTERS, DATA_SIZES and BUFS give each chunk's
+ *		filter mask, size and data as for H5DOwrite_chunk();
+ *		FILTERS may be NULL when no filter is skipped.
+ *
+ *		The chunks are given space in the file together and
+ *		written in file address order, so that adjacent chunks
+ *		can be written with one I/O request.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5DOwrite_chunks(hid_t dset_id, hid_t dxpl_id, size_t nchunks,
+    const uint32_t *filters, const hsize_t *offsets, const size_t *data_sizes,
+    const void *bufs[])
+{
+    hbool_t created_dxpl = FALSE;       /* Whether we created a DXPL */
+    hbool_t do_direct_write = TRUE;     /* Flag for direct writes */
+    H5D_direct_chunk_batch_t batch;     /* Batch of chunks to write */
+    H5D_direct_chunk_batch_t *batch_ptr = &batch;   /* Pointer to batch, for property */
+    herr_t  ret_value = FAIL;           /* Return value */
+
+    /* Check arguments */
+    if(dset_id < 0)
+        goto done;
+    if(nchunks > 0 && (!offsets || !data_sizes || !bufs))
+        goto done;
+
+    /* Set up the batch */
+    HDmemset(&batch, 0, sizeof(batch));
+    batch.nchunks = nchunks;
+    batch.offsets = offsets;
+    batch.filters = filters;
+    batch.sizes = data_sizes;
+    batch.wbufs = bufs;
+
+    /* If the user passed in a default DXPL, create one to pass to H5Dwrite() */
+    if(H5P_DEFAULT == dxpl_id) {
+        if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+            goto done;
+        created_dxpl = TRUE;
+    } /* end if */
+
+    /* Set direct write parameters */
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &do_direct_write) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_BATCH_NAME, &batch_ptr) < 0)
+        goto done;
+
+    /* Write chunks */
+    if(H5Dwrite(dset_id, 0, H5S_ALL, H5S_ALL, dxpl_id, &batch) < 0)
+        goto done;
+
+    /* Indicate success */
+    ret_value = SUCCEED;
+
+done:
+    if(created_dxpl) {
+        if(H5Pclose(dxpl_id) < 0)
+            ret_value = FAIL;
+    } /* end if */
+    else {
+        /* Reset the direct write flag and batch on user DXPL */
+        do_direct_write = FALSE;
+        batch_ptr = NULL;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &do_direct_write) < 0)
+            ret_value = FAIL;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_BATCH_NAME, &batch_ptr) < 0)
+            ret_value = FAIL;
+    }
+
+    return ret_value;
+} /* end H5DOwrite_chunks() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5DOread_chunks
+ *
+ * Purpose:     Reads several entire chunks from the file directly.
+ *		OFFSETS holds the logical offsets of the NCHUNKS chunks,
+ *		one after another (NCHUNKS times the dataset's rank
+ *		values).  Each chunk is read into the matching buffer in
+ *		BUFS, which must be large enough for the chunk as stored,
+ *		and its filter mask is returned in FILTERS.
+ *
+ *		The chunks are read in file address order, so that
+ *		adjacent chunks can be read with one I/O request.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *---------------------------------------------------------------------------
+ */
+herr_t
+H5DOread_chunks(hid_t dset_id, hid_t dxpl_id, size_t nchunks,
+    const hsize_t *offsets, uint32_t *filters, void *bufs[])
+{
+    hbool_t created_dxpl = FALSE;       /* Whether we created a DXPL */
+    hbool_t do_direct_read = TRUE;      /* Flag for direct reads */
+    H5D_direct_chunk_batch_t batch;     /* Batch of chunks to read */
+    H5D_direct_chunk_batch_t *batch_ptr = &batch;   /* Pointer to batch, for property */
+    herr_t  ret_value = FAIL;           /* Return value */
+
+    /* Check arguments */
+    if(dset_id < 0)
+        goto done;
+    if(nchunks > 0 && (!offsets || !filters || !bufs))
+        goto done;
+
+    /* Set up the batch */
+    HDmemset(&batch, 0, sizeof(batch));
+    batch.nchunks = nchunks;
+    batch.offsets = offsets;
+    batch.filters_out = filters;
+    batch.rbufs = bufs;
+
+    /* If the user passed in a default DXPL, create one to pass to H5Dread() */
+    if(H5P_DEFAULT == dxpl_id) {
+        if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+            goto done;
+        created_dxpl = TRUE;
+    } /* end if */
+
+    /* Set direct read parameters */
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_BATCH_NAME, &batch_ptr) < 0)
+        goto done;
+
+    /* Read chunks */
+    if(H5Dread(dset_id, 0, H5S_ALL, H5S_ALL, dxpl_id, &batch) < 0)
+        goto done;
+
+    /* Indicate success */
+    ret_value = SUCCEED;
+
+done:
+    if(created_dxpl) {
+        if(H5Pclose(dxpl_id) < 0)
+            ret_value = FAIL;
+    } /* end if */
+    else {
+        /* Reset the direct read flag and batch on user DXPL */
+        do_direct_read = FALSE;
+        batch_ptr = NULL;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+            ret_value = FAIL;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_BATCH_NAME, &batch_ptr) < 0)
+            ret_value = FAIL;
+    }
+
+    return ret_value;
+} /* end H5DOread_chunks() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5DOappend()
@@ -34,6 +34,17 @@ H5_HLDLL herr_t H5DOread_chunk(hid_t dset_id, /*in*/
             uint32_t *filters,     /*out*/
             void *buf);            /*out*/
 
+H5_HLDLL herr_t H5DOwrite_chunks(hid_t dset_id, hid_t dxpl_id, size_t nchunks,
+    const uint32_t *filters, const hsize_t *offsets, const size_t *data_sizes,
+    const void *bufs[]);
+
+H5_HLDLL herr_t H5DOread_chunks(hid_t dset_id, /*in*/
+            hid_t dxpl_id,         /*in*/
+            size_t nchunks,        /*in*/
+            const hsize_t *offsets, /*in*/
+            uint32_t *filters,     /*out*/
+            void *bufs[]);         /*out*/
+
 H5_HLDLL herr_t H5DOappend(hid_t dset_id, hid_t dxpl_id, unsigned axis,
     size_t extension, hid_t memtype, const void *buf);
 
@@ -40,6 +40,7 @@
 #define DATASETNAME10       "read_w_valid_cache"
 #define DATASETNAME11       "unallocated_chunk"
 #define DATASETNAME12       "unfiltered_data"
+#define DATASETNAME13       "chunk_batch"
 
 #define RANK         2
 #define NX     16
@@ -1976,6 +1977,172 @@ error:
     return 1;
 } /* test_read_unallocated_chunk() */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_direct_chunk_batch
+ *
+ * Purpose:     Test writing and reading several chunks at once with
+ *              H5DOwrite_chunks and H5DOread_chunks.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_direct_chunk_batch(hid_t file)
+{
+    hid_t       dataspace = -1, dataset = -1;
+    hid_t       cparms = -1, dxpl = -1;
+    hsize_t     dims[2]  = {NX, NY};
+    hsize_t     chunk_dims[2] ={CHUNK_NX, CHUNK_NY};
+    int         data[NX][NY];
+    int         check[NX][NY];
+    int         chunks[NX/CHUNK_NX * NY/CHUNK_NY][CHUNK_NX][CHUNK_NY];
+    int         direct_buf[NX/CHUNK_NX * NY/CHUNK_NY][CHUNK_NX][CHUNK_NY];
+    hsize_t     offsets[NX/CHUNK_NX * NY/CHUNK_NY][2];
+    uint32_t    filters[NX/CHUNK_NX * NY/CHUNK_NY];
+    size_t      sizes[NX/CHUNK_NX * NY/CHUNK_NY];
+    const void *wbufs[NX/CHUNK_NX * NY/CHUNK_NY];
+    void       *rbufs[NX/CHUNK_NX * NY/CHUNK_NY];
+    size_t      nchunks = NX/CHUNK_NX * NY/CHUNK_NY;
+    size_t      n;
+    int         i, j, k, l;
+    herr_t      status;
+
+    TESTING("writing and reading several chunks at once");
+
+    /* Create the data space */
+    if((dataspace = H5Screate_simple(RANK, dims, NULL)) < 0)
+        goto error;
+
+    /* Modify dataset creation properties, i.e. enable chunking and the
+     * filter which adds ADD_ON to every value */
+    if((cparms = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+    if(H5Pset_chunk(cparms, RANK, chunk_dims) < 0)
+        goto error;
+    if(H5Zregister(H5Z_BOGUS1) < 0)
+        goto error;
+    if(H5Pset_filter(cparms, H5Z_FILTER_BOGUS1, 0, (size_t)0, NULL) < 0)
+        goto error;
+
+    if((dataset = H5Dcreate2(file, DATASETNAME13, H5T_NATIVE_INT, dataspace, H5P_DEFAULT,
+            cparms, H5P_DEFAULT)) < 0)
+        goto error;
+
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+
+    /* Set up the chunks, last chunk first, so the batch isn't in index
+     * order.  Every other chunk is "filtered" here and the others skip
+     * the filter. */
+    for(i = 0; i < NX; i++)
+        for(j = 0; j < NY; j++)
+            data[i][j] = i * NY + j;
+    for(n = 0; n < nchunks; n++) {
+        size_t idx = nchunks - n - 1;
+
+        offsets[n][0] = (hsize_t)(idx / (NY / CHUNK_NY)) * CHUNK_NX;
+        offsets[n][1] = (hsize_t)(idx % (NY / CHUNK_NY)) * CHUNK_NY;
+        filters[n] = (n % 2) ? 0x1 : 0;
+        for(k = 0; k < CHUNK_NX; k++)
+            for(l = 0; l < CHUNK_NY; l++)
+                chunks[n][k][l] = data[offsets[n][0] + (hsize_t)k][offsets[n][1] + (hsize_t)l]
+                        + (filters[n] ? 0 : ADD_ON);
+        sizes[n] = sizeof(chunks[n]);
+        wbufs[n] = chunks[n];
+        rbufs[n] = direct_buf[n];
+    } /* end for */
+
+    /* Write all the chunks */
+    if((status = H5DOwrite_chunks(dataset, dxpl, nchunks, filters, &offsets[0][0], sizes, wbufs)) < 0)
+        goto error;
+
+    /* Read the dataset back and check it */
+    HDmemset(check, 0, sizeof(check));
+    if(H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check) < 0)
+        goto error;
+    for(i = 0; i < NX; i++)
+        for(j = 0; j < NY; j++)
+            if(check[i][j] != data[i][j]) {
+                HDprintf("\n    1. Read different values than written.");
+                HDprintf("    At index %d,%d\n", i, j);
+                HDprintf("    data=%d, check=%d\n", data[i][j], check[i][j]);
+                goto error;
+            } /* end if */
+
+    /* Read the raw chunks back and check them and their filter masks */
+    HDmemset(direct_buf, 0, sizeof(direct_buf));
+    for(n = 0; n < nchunks; n++)
+        filters[n] = UINT_MAX;
+    if((status = H5DOread_chunks(dataset, dxpl, nchunks, &offsets[0][0], filters, rbufs)) < 0)
+        goto error;
+    for(n = 0; n < nchunks; n++) {
+        if(filters[n] != ((n % 2) ? 0x1 : 0))
+            goto error;
+        if(HDmemcmp(direct_buf[n], chunks[n], sizeof(chunks[n])))
+            goto error;
+    } /* end for */
+
+    /* Overwrite the dataset with H5Dwrite, leaving dirty chunks in the
+     * chunk cache, and check the batch read sees the new data */
+    for(i = 0; i < NX; i++)
+        for(j = 0; j < NY; j++)
+            data[i][j] = -(i * NY + j);
+    if(H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0)
+        goto error;
+    if((status = H5DOread_chunks(dataset, dxpl, nchunks, &offsets[0][0], filters, rbufs)) < 0)
+        goto error;
+    for(n = 0; n < nchunks; n++) {
+        if(filters[n] != 0)
+            goto error;
+        for(k = 0; k < CHUNK_NX; k++)
+            for(l = 0; l < CHUNK_NY; l++)
+                if(direct_buf[n][k][l] != data[offsets[n][0] + (hsize_t)k][offsets[n][1] + (hsize_t)l] + ADD_ON) {
+                    HDprintf("\n    2. Read different values than written.");
+                    HDprintf("    At chunk %u, index %d,%d\n", (unsigned)n, k, l);
+                    goto error;
+                } /* end if */
+    } /* end for */
+
+    /* Writing the same chunk twice in one batch should fail */
+    offsets[1][0] = offsets[0][0];
+    offsets[1][1] = offsets[0][1];
+    H5E_BEGIN_TRY {
+        status = H5DOwrite_chunks(dataset, dxpl, (size_t)2, NULL, &offsets[0][0], sizes, wbufs);
+    } H5E_END_TRY;
+    if(status >= 0)
+        goto error;
+
+    /* Offsets not on a chunk boundary should fail */
+    offsets[1][1] = offsets[0][1] + 1;
+    H5E_BEGIN_TRY {
+        status = H5DOread_chunks(dataset, dxpl, (size_t)2, &offsets[0][0], filters, rbufs);
+    } H5E_END_TRY;
+    if(status >= 0)
+        goto error;
+
+    /* Close/release resources. */
+    H5Dclose(dataset);
+    H5Sclose(dataspace);
+    H5Pclose(cparms);
+    H5Pclose(dxpl);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Sclose(dataspace);
+        H5Pclose(cparms);
+        H5Pclose(dxpl);
+    } H5E_END_TRY;
+
+    H5_FAILED();
+    return 1;
+} /* test_direct_chunk_batch() */
+
 /*-------------------------------------------------------------------------
  * Function:    test_single_chunk_latest
  *
@@ -2153,6 +2320,9 @@ int main( void )
     nerrors += test_read_unfiltered_dset(file_id);
     nerrors += test_read_unallocated_chunk(file_id);
 
+    /* Test writing and reading several chunks at once */
+    nerrors += test_direct_chunk_batch(file_id);
+
     nerrors += test_single_chunk_latest();
 
     if(H5Fclose(file_id) < 0)
@@ -4129,6 +4129,9 @@ Java_hdf_hdf5lib_H5_H5Pset_1mdc_1config
     const char *str;
     H5AC_cache_config_t cacheinfo;
 
+    /* The Java structure has no replacement policy */
+    cacheinfo.replacement_policy = H5C_rp__lru;
+
     cls = ENVPTR->GetObjectClass(ENVPAR cache_config);
     fid = ENVPTR->GetFieldID(ENVPAR cls, "version", "I");
     if(fid == 0) {
@@ -294,6 +294,10 @@ H5_term_library(void)
         /* Try to organize these so the "higher" level components get shut
          * down before "lower" level components that they might rely on. -QAK
          */
+        /* Close event sets first, so that the operations still queued in
+         * them are released while the rest of the library is available.
+         */
+        pending += DOWN(ES);
         pending += DOWN(L);
 
         /* Close the "top" of various interfaces (IDs, etc) but don't shut
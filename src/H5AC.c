@@ -128,7 +128,8 @@ static const H5AC_class_t *const H5AC_class_s[] = {
     H5AC_DRVRINFO,              /* (26) driver info block (supplements superblock) */
     H5AC_EPOCH_MARKER,          /* (27) epoch marker - always internal to cache */
     H5AC_PROXY_ENTRY,           /* (28) cache entry proxy               */
-    H5AC_PREFETCHED_ENTRY  	/* (29) prefetched entry - always internal to cache */
+    H5AC_PREFETCHED_ENTRY,  	/* (29) prefetched entry - always internal to cache */
+    H5AC_DSHARD                 /* (30) dataset shard offset table      */
 };
 
 
@@ -211,9 +212,13 @@ H5AC_term_package(void)
 {
     FUNC_ENTER_NOAPI_NOINIT_NOERR
 
-    if(H5_PKG_INIT_VAR)
+    if(H5_PKG_INIT_VAR) {
+        /* Stop the cache's helper threads */
+        H5C_stop_serialize_threads();
+
         /* Reset interface initialization flag */
         H5_PKG_INIT_VAR = FALSE;
+    } /* end if */
 
     FUNC_LEAVE_NOAPI(0)
 } /* end H5AC_term_package() */
@@ -417,6 +422,14 @@ H5AC_create(const H5F_t *f, H5AC_cache_config_t *config_ptr, H5AC_cache_image_co
     if(H5AC_set_cache_auto_resize_config(f->shared->cache, config_ptr) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_CANTSET, FAIL, "auto resize configuration failed")
 
+    /* Read only protects of clean entries needn't update the LRU list in
+     * a file that is opened read only.  Not done in the parallel case, as
+     * the parallel code scans the LRU list on its own.
+     */
+    if(!(H5F_INTENT(f) & H5F_ACC_RDWR) && !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        if(H5C_set_deferred_lru(f->shared->cache, TRUE) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTSET, FAIL, "can't enable deferred LRU updates")
+
     /* Don't need to get the current H5C image config here since the
      * cache has just been created, and thus f->shared->cache->image_ctl 
      * must still set to its initial value (H5C__DEFAULT_CACHE_IMAGE_CTL).  
@@ -2016,13 +2029,15 @@ H5AC_get_cache_auto_resize_config(const H5AC_t *cache_ptr,
 {
     H5C_auto_size_ctl_t internal_config;
     hbool_t evictions_enabled;
+    enum H5C_cache_rp_mode replacement_policy;
     herr_t ret_value = SUCCEED;      /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
 
     /* Check args */
     if((cache_ptr == NULL) || (config_ptr == NULL) ||
-            (config_ptr->version != H5AC__CURR_CACHE_CONFIG_VERSION))
+            (config_ptr->version < H5AC__MIN_CACHE_CONFIG_VERSION) ||
+            (config_ptr->version > H5AC__CURR_CACHE_CONFIG_VERSION))
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr or config_ptr on entry")
 #ifdef H5_HAVE_PARALLEL
 {
@@ -2039,6 +2054,8 @@ H5AC_get_cache_auto_resize_config(const H5AC_t *cache_ptr,
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_get_cache_auto_resize_config() failed")
     if(H5C_get_evictions_enabled((const H5C_t *)cache_ptr, &evictions_enabled) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_get_resize_enabled() failed")
+    if(H5C_get_replacement_policy((const H5C_t *)cache_ptr, &replacement_policy) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_get_replacement_policy() failed")
 
     /* Set the information to return */
     if(internal_config.rpt_fcn == NULL)
@@ -2071,6 +2088,8 @@ H5AC_get_cache_auto_resize_config(const H5AC_t *cache_ptr,
     config_ptr->epochs_before_eviction = (int)(internal_config.epochs_before_eviction);
     config_ptr->apply_empty_reserve    = internal_config.apply_empty_reserve;
     config_ptr->empty_reserve          = internal_config.empty_reserve;
+    if(config_ptr->version >= H5AC__CACHE_CONFIG_RP_VERSION)
+        config_ptr->replacement_policy = replacement_policy;
 #ifdef H5_HAVE_PARALLEL
 {
     H5AC_aux_t *aux_ptr;
@@ -2214,7 +2233,7 @@ H5AC_set_cache_auto_resize_config(H5AC_t *cache_ptr, H5AC_cache_config_t *config
      * pointer, as that may change before we use it.
      */
     if(config_ptr != NULL)
-        trace_config = *config_ptr;
+        HDmemcpy(&trace_config, config_ptr, H5AC__CACHE_CONFIG_SIZE(config_ptr->version));
 #endif /* H5AC__TRACE_FILE_ENABLED */
 
     if(cache_ptr == NULL)
@@ -2260,6 +2279,9 @@ H5AC_set_cache_auto_resize_config(H5AC_t *cache_ptr, H5AC_cache_config_t *config
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_set_cache_auto_resize_config() failed")
     if(H5C_set_evictions_enabled(cache_ptr, config_ptr->evictions_enabled) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_set_evictions_enabled() failed")
+    if(H5C_set_replacement_policy(cache_ptr,
+            config_ptr->version >= H5AC__CACHE_CONFIG_RP_VERSION ? config_ptr->replacement_policy : H5C_rp__lru) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_set_replacement_policy() failed")
 
 #ifdef H5_HAVE_PARALLEL
 {
@@ -2282,7 +2304,7 @@ done:
      */
     if(NULL != (trace_file_ptr = H5C_get_trace_file_ptr(cache_ptr)))
 	HDfprintf(trace_file_ptr,
-                  "%s %d %d %d %d \"%s\" %d %d %d %f %d %d %ld %d %f %f %d %f %f %d %d %d %f %f %d %d %d %d %f %zu %d %d\n",
+                  "%s %d %d %d %d \"%s\" %d %d %d %f %d %d %ld %d %f %f %d %f %f %d %d %d %f %f %d %d %d %d %f %zu %d %d %d\n",
 		  "H5AC_set_cache_auto_resize_config",
 		  trace_config.version,
 		  (int)(trace_config.rpt_fcn_enabled),
@@ -2314,6 +2336,7 @@ done:
 		  trace_config.empty_reserve,
 		  trace_config.dirty_bytes_threshold,
 		  trace_config.metadata_write_strategy,
+		  (int)(trace_config.replacement_policy),
 		  (int)ret_value);
 #endif /* H5AC__TRACE_FILE_ENABLED */
 
@@ -2359,7 +2382,8 @@ H5AC_validate_config(H5AC_cache_config_t *config_ptr)
     /* Check args */
     if(config_ptr == NULL)
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "NULL config_ptr on entry")
-    if(config_ptr->version != H5AC__CURR_CACHE_CONFIG_VERSION)
+    if((config_ptr->version < H5AC__MIN_CACHE_CONFIG_VERSION) ||
+            (config_ptr->version > H5AC__CURR_CACHE_CONFIG_VERSION))
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Unknown config version")
 
     /* don't bother to test trace_file_name unless open_trace_file is TRUE */
@@ -2392,6 +2416,11 @@ H5AC_validate_config(H5AC_cache_config_t *config_ptr)
          (config_ptr->metadata_write_strategy != H5AC_METADATA_WRITE_STRATEGY__DISTRIBUTED))
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "config_ptr->metadata_write_strategy out of range")
 
+    if((config_ptr->version >= H5AC__CACHE_CONFIG_RP_VERSION) &&
+         (config_ptr->replacement_policy != H5C_rp__lru) &&
+         (config_ptr->replacement_policy != H5C_rp__2q))
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "config_ptr->replacement_policy out of range")
+
     if(H5AC__ext_config_2_int_config(config_ptr, &internal_config) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5AC__ext_config_2_int_config() failed")
 
@@ -2539,7 +2568,9 @@ H5AC__ext_config_2_int_config(H5AC_cache_config_t *ext_conf_ptr,
 
     FUNC_ENTER_STATIC
 
-    if((ext_conf_ptr == NULL) || (ext_conf_ptr->version != H5AC__CURR_CACHE_CONFIG_VERSION) ||
+    if((ext_conf_ptr == NULL) ||
+            (ext_conf_ptr->version < H5AC__MIN_CACHE_CONFIG_VERSION) ||
+            (ext_conf_ptr->version > H5AC__CURR_CACHE_CONFIG_VERSION) ||
             (int_conf_ptr == NULL))
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad ext_conf_ptr or inf_conf_ptr on entry")
 
@@ -82,6 +82,7 @@ typedef enum {
     H5AC_EPOCH_MARKER_ID,       /* (27) epoch marker - always internal to cache     */
     H5AC_PROXY_ENTRY_ID,        /* (28) cache entry proxy                           */
     H5AC_PREFETCHED_ENTRY_ID, 	/* (29) prefetched entry - always internal to cache */
+    H5AC_DSHARD_ID,             /* (30) dataset shard offset table                  */
     H5AC_NTYPES                 /* Number of types, must be last                    */
 } H5AC_type_t;
 
@@ -176,6 +177,7 @@ typedef H5C_notify_action_t     H5AC_notify_action_t;
 
 #define H5AC__CLASS_NO_FLAGS_SET 	H5C__CLASS_NO_FLAGS_SET
 #define H5AC__CLASS_SPECULATIVE_LOAD_FLAG H5C__CLASS_SPECULATIVE_LOAD_FLAG
+#define H5AC__CLASS_THREADED_SERIALIZE_FLAG H5C__CLASS_THREADED_SERIALIZE_FLAG
 
 /* The following flags should only appear in test code */
 #define H5AC__CLASS_SKIP_READS              H5C__CLASS_SKIP_READS
@@ -225,6 +227,17 @@ typedef struct H5AC_proxy_entry_t {
                                         /* (Note that this currently duplicates some cache functionality) */
 } H5AC_proxy_entry_t;
 
+/* Versions of H5AC_cache_config_t accepted.  Version 1 has no
+ * replacement_policy field (its configurations use the modified LRU
+ * policy), so only the fields before it may be read or written.
+ */
+#define H5AC__MIN_CACHE_CONFIG_VERSION          1
+#define H5AC__CACHE_CONFIG_RP_VERSION           2
+#define H5AC__CACHE_CONFIG_SIZE(version)                                      \
+    ((version) < H5AC__CACHE_CONFIG_RP_VERSION ?                              \
+        offsetof(H5AC_cache_config_t, replacement_policy) :                   \
+        sizeof(H5AC_cache_config_t))
+
 /* Default cache configuration. */
 #define H5AC__DEFAULT_METADATA_WRITE_STRATEGY   \
                                 H5AC_METADATA_WRITE_STRATEGY__DISTRIBUTED
@@ -232,7 +245,7 @@ typedef struct H5AC_proxy_entry_t {
 #ifdef H5_HAVE_PARALLEL
 #define H5AC__DEFAULT_CACHE_CONFIG                                            \
 {                                                                             \
-  /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION, \
+  /* int         version                = */ H5AC__MIN_CACHE_CONFIG_VERSION,  \
   /* hbool_t     rpt_fcn_enabled        = */ FALSE,                           \
   /* hbool_t     open_trace_file        = */ FALSE,                           \
   /* hbool_t     close_trace_file       = */ FALSE,                           \
@@ -263,12 +276,14 @@ typedef struct H5AC_proxy_entry_t {
   /* double      empty_reserve          = */ 0.1f,                            \
   /* size_t	 dirty_bytes_threshold  = */ (256 * 1024),                    \
   /* int	metadata_write_strategy = */                                  \
-				       H5AC__DEFAULT_METADATA_WRITE_STRATEGY  \
+				       H5AC__DEFAULT_METADATA_WRITE_STRATEGY, \
+  /* enum H5C_cache_rp_mode                */                                 \
+  /*                 replacement_policy = */ H5C_rp__lru                      \
 }
 #else /* H5_HAVE_PARALLEL */
 #define H5AC__DEFAULT_CACHE_CONFIG                                            \
 {                                                                             \
-  /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,     \
+  /* int         version                = */ H5AC__MIN_CACHE_CONFIG_VERSION,  \
   /* hbool_t     rpt_fcn_enabled        = */ FALSE,                           \
   /* hbool_t     open_trace_file        = */ FALSE,                           \
   /* hbool_t     close_trace_file       = */ FALSE,                           \
@@ -299,7 +314,9 @@ typedef struct H5AC_proxy_entry_t {
   /* double      empty_reserve          = */ 0.1f,                            \
   /* size_t	 dirty_bytes_threshold  = */ (256 * 1024),                    \
   /* int	metadata_write_strategy = */                                  \
-				       H5AC__DEFAULT_METADATA_WRITE_STRATEGY  \
+				       H5AC__DEFAULT_METADATA_WRITE_STRATEGY, \
+  /* enum H5C_cache_rp_mode                */                                 \
+  /*                 replacement_policy = */ H5C_rp__lru                      \
 }
 #endif /* H5_HAVE_PARALLEL */
 
@@ -380,6 +397,7 @@ H5_DLLVAR const H5AC_class_t H5AC_DRVRINFO[1];
 H5_DLLVAR const H5AC_class_t H5AC_EPOCH_MARKER[1];
 H5_DLLVAR const H5AC_class_t H5AC_PROXY_ENTRY[1];
 H5_DLLVAR const H5AC_class_t H5AC_PREFETCHED_ENTRY[1];
+H5_DLLVAR const H5AC_class_t H5AC_DSHARD[1];
 
 
 /* external function declarations: */
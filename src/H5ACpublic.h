@@ -67,6 +67,10 @@ extern "C" {
  *      H5AC_cache_config_t passed to the cache must have a known
  *      version number, or an error will be flagged.
  *
+ *      Versions 1 and 2 are known.  Version 1 structures end before
+ *      the replacement_policy field, which is neither read nor written
+ *      for them, and select the H5C_rp__lru policy.
+ *
  * rpt_fcn_enabled: Boolean field used to enable and disable the default
  *    reporting function.  This function is invoked every time the
  *    automatic cache resize code is run, and reports on its activities.
@@ -436,9 +440,41 @@ extern "C" {
  *    To avoid possible messages from the past/future, all caches must
  *    wait until all caches are done before leaving the sync point.
  *
+ *
+ * Replacement policy configuration field:
+ *
+ * replacement_policy: Enumerated value indicating the policy the cache
+ *    uses to choose entries for eviction.  At present, two policies are
+ *    supported:
+ *
+ *    H5C_rp__lru:  The cache evicts the least recently used entries
+ *    first.  This is the default, the only policy supported by
+ *    earlier versions of the library, and the policy of version 1
+ *    configurations.
+ *
+ *    H5C_rp__2q:  A variant of the 2Q policy, intended to keep frequently
+ *    used entries resident while a large number of entries is touched
+ *    once, as when iterating over a big group.
+ *
+ *    Under this policy, entries loaded into the cache are placed on
+ *    probation, and are evicted before any entry in the "hot" part of
+ *    the cache, however recently they were used.  The cache remembers
+ *    the addresses of entries recently evicted from probation, and an
+ *    entry loaded again while its address is remembered becomes hot.
+ *    Hot entries are kept in least recently used order, and may occupy
+ *    at most three quarters of the maximum cache size.  Beyond that,
+ *    the least recently used hot entries are placed back on probation.
+ *
+ *    Thus an entry must be used again after being evicted from probation
+ *    before it can displace hot entries, and a scan of entries that are
+ *    each used only once can only evict other entries on probation.
+ *
+ *    The policy may be changed while the file is open.  When switching
+ *    to H5C_rp__2q, all entries in the cache are initially treated as hot.
+ *
  ****************************************************************************/
 
-#define H5AC__CURR_CACHE_CONFIG_VERSION     1
+#define H5AC__CURR_CACHE_CONFIG_VERSION     2
 #define H5AC__MAX_TRACE_FILE_NAME_LEN        1024
 
 #define H5AC_METADATA_WRITE_STRATEGY__PROCESS_0_ONLY    0
@@ -503,6 +539,10 @@ typedef struct H5AC_cache_config_t
     size_t                   dirty_bytes_threshold;
     int                      metadata_write_strategy;
 
+
+    /* replacement policy configuration field: */
+    enum H5C_cache_rp_mode   replacement_policy;
+
 } H5AC_cache_config_t;
 
 
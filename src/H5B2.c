@@ -288,13 +288,85 @@ H5B2_insert(H5B2_t *bt2, void *udata)
     hdr = bt2->hdr;
 
     /* Insert the record */
-    if(H5B2__insert(hdr, udata) < 0)
+    if(hdr->bulk) {
+        if(H5B2__bulk_insert(hdr, udata) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "unable to insert record into B-tree")
+    } /* end if */
+    else if(H5B2__insert(hdr, udata) < 0)
         HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "unable to insert record into B-tree")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5B2_insert() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2_bulk_begin
+ *
+ * Purpose:	Announce that NREC records are about to be inserted into an
+ *		empty B-tree, in increasing order, so that it can be built
+ *		from the root down with full nodes instead of by splitting
+ *		nodes as they fill.  Until H5B2_bulk_end is called, the
+ *		B-tree can only be searched for records greater than the
+ *		last one inserted.
+ *
+ *		Does nothing if the B-tree isn't empty.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2_bulk_begin(H5B2_t *bt2, hsize_t nrec)
+{
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check arguments. */
+    HDassert(bt2);
+    HDassert(!bt2->hdr->bulk);
+
+    /* Set the shared v2 B-tree header's file context for this operation */
+    bt2->hdr->f = bt2->f;
+
+    if(H5B2__bulk_begin(bt2->hdr, nrec) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to start bulk load of B-tree")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2_bulk_begin() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2_bulk_end
+ *
+ * Purpose:	Finish inserting records announced with H5B2_bulk_begin.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2_bulk_end(H5B2_t *bt2)
+{
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check arguments. */
+    HDassert(bt2);
+
+    /* Set the shared v2 B-tree header's file context for this operation */
+    bt2->hdr->f = bt2->f;
+
+    if(bt2->hdr->bulk && H5B2__bulk_end(bt2->hdr) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTRELEASE, FAIL, "unable to finish bulk load of B-tree")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2_bulk_end() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5B2_update
@@ -331,6 +403,13 @@ H5B2_update(H5B2_t *bt2, void *udata, H5B2_modify_t op, void *op_data)
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* Records arriving during a bulk load are all new */
+    if(hdr->bulk) {
+        if(H5B2__bulk_insert(hdr, udata) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "unable to insert record into B-tree")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
     /* Check if the root node is allocated yet */
     if(!H5F_addr_defined(hdr->root.addr)) {
         /* Create root node as leaf node in B-tree */
@@ -425,7 +504,7 @@ H5B2_iterate(H5B2_t *bt2, H5B2_operator_t op, void *op_data)
     H5B2_hdr_t	*hdr;                   /* Pointer to the B-tree header */
     herr_t	ret_value = SUCCEED;    /* Return value */
 
-    FUNC_ENTER_NOAPI_NOERR
+    FUNC_ENTER_NOAPI(FAIL)
 
     /* Check arguments. */
     HDassert(bt2);
@@ -437,12 +516,17 @@ H5B2_iterate(H5B2_t *bt2, H5B2_operator_t op, void *op_data)
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* The B-tree can't be used until a bulk load is finished */
+    if(hdr->bulk)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTLIST, FAIL, "B-tree is being bulk loaded")
+
     /* Iterate through records */
     if(hdr->root.node_nrec > 0)
         /* Iterate through nodes */
         if((ret_value = H5B2__iterate_node(hdr, hdr->depth, &hdr->root, hdr, op, op_data)) < 0)
             HERROR(H5E_BTREE, H5E_CANTLIST, "node iteration failed");
 
+done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5B2_iterate() */
 
@@ -493,6 +577,19 @@ H5B2_find(H5B2_t *bt2, void *udata, H5B2_found_t op, void *op_data)
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* During a bulk load, only records after the last one inserted can be
+     *  looked for (and aren't there yet)
+     */
+    if(hdr->bulk) {
+        if(hdr->bulk->ninserted > 0) {
+            if((hdr->cls->compare)(udata, hdr->bulk->last_rec, &cmp) < 0)
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTCOMPARE, FAIL, "can't compare btree2 records")
+            if(cmp <= 0)
+                HGOTO_ERROR(H5E_BTREE, H5E_NOTFOUND, FAIL, "can't search B-tree during bulk load")
+        } /* end if */
+        HGOTO_DONE(FALSE)
+    } /* end if */
+
     /* Make copy of the root node pointer to start search with */
     curr_node_ptr = hdr->root;
 
@@ -732,6 +829,10 @@ H5B2_index(H5B2_t *bt2, H5_iter_order_t order, hsize_t idx, H5B2_found_t op,
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* The B-tree can't be used until a bulk load is finished */
+    if(hdr->bulk)
+        HGOTO_ERROR(H5E_BTREE, H5E_NOTFOUND, FAIL, "B-tree is being bulk loaded")
+
     /* Make copy of the root node pointer to start search with */
     curr_node_ptr = hdr->root;
 
@@ -916,6 +1017,10 @@ H5B2_remove(H5B2_t *bt2, void *udata, H5B2_remove_t op, void *op_data)
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* The B-tree can't be used until a bulk load is finished */
+    if(hdr->bulk)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTREMOVE, FAIL, "B-tree is being bulk loaded")
+
     /* Check for empty B-tree */
     if(0 == hdr->root.all_nrec)
         HGOTO_ERROR(H5E_BTREE, H5E_NOTFOUND, FAIL, "record is not in B-tree")
@@ -991,6 +1096,10 @@ H5B2_remove_by_idx(H5B2_t *bt2, H5_iter_order_t order, hsize_t idx,
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* The B-tree can't be used until a bulk load is finished */
+    if(hdr->bulk)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTREMOVE, FAIL, "B-tree is being bulk loaded")
+
     /* Check for empty B-tree */
     if(0 == hdr->root.all_nrec)
         HGOTO_ERROR(H5E_BTREE, H5E_NOTFOUND, FAIL, "record is not in B-tree")
@@ -1116,6 +1225,10 @@ H5B2_neighbor(H5B2_t *bt2, H5B2_compare_t range, void *udata,
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* The B-tree can't be used until a bulk load is finished */
+    if(hdr->bulk)
+        HGOTO_ERROR(H5E_BTREE, H5E_NOTFOUND, FAIL, "B-tree is being bulk loaded")
+
     /* Check for empty tree */
     if(!H5F_addr_defined(hdr->root.addr))
         HGOTO_ERROR(H5E_BTREE, H5E_NOTFOUND, FAIL, "B-tree has no records")
@@ -1179,6 +1292,10 @@ H5B2_modify(H5B2_t *bt2, void *udata, H5B2_modify_t op, void *op_data)
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* The B-tree can't be used until a bulk load is finished */
+    if(hdr->bulk)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTMODIFY, FAIL, "B-tree is being bulk loaded")
+
     /* Make copy of the root node pointer to start search with */
     curr_node_ptr = hdr->root;
 
@@ -1402,6 +1519,15 @@ H5B2_close(H5B2_t *bt2)
     HDassert(bt2);
     HDassert(bt2->f);
 
+    /* A bulk load must be finished before the B-tree is closed; release
+     * the nodes it was filling, so they aren't left protected */
+    if(bt2->hdr->bulk) {
+        bt2->hdr->f = bt2->f;
+        if(H5B2__bulk_end(bt2->hdr) < 0)
+            HDONE_ERROR(H5E_BTREE, H5E_CANTRELEASE, FAIL, "unable to end bulk load")
+        HDONE_ERROR(H5E_BTREE, H5E_CANTCLOSEOBJ, FAIL, "B-tree closed during bulk load")
+    } /* end if */
+
     /* Decrement file reference & check if this is the last open v2 B-tree using the shared B-tree header */
     if(0 == H5B2__hdr_fuse_decr(bt2->hdr)) {
         /* Set the shared v2 B-tree header's file context for this operation */
@@ -35,6 +35,7 @@
 #include "H5private.h"		/* Generic Functions			*/
 #include "H5B2pkg.h"		/* v2 B-trees				*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5MMprivate.h"	/* Memory management			*/
 #include "H5VMprivate.h"	/* Vectors and arrays 			*/
 
 
@@ -59,6 +60,10 @@
 static herr_t H5B2__update_child_flush_depends(H5B2_hdr_t *hdr, 
     unsigned depth, const H5B2_node_ptr_t *node_ptrs, unsigned start_idx,
     unsigned end_idx, void *old_parent, void *new_parent);
+static herr_t H5B2__add_depth(H5B2_hdr_t *hdr);
+static herr_t H5B2__bulk_open(H5B2_hdr_t *hdr, uint16_t depth, void *parent,
+    H5B2_node_ptr_t *node_ptr, hsize_t all_nrec);
+static herr_t H5B2__bulk_close(H5B2_hdr_t *hdr, uint16_t depth);
 
 
 /*********************/
@@ -327,30 +332,24 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5B2__split_root
+ * Function:	H5B2__add_depth
  *
- * Purpose:	Split the root node
+ * Purpose:	Increase the depth of the B-tree by one, setting up the node
+ *		info for the new level of internal nodes.
  *
  * Return:	Success:	Non-negative
  *		Failure:	Negative
  *
- * Programmer:	Quincey Koziol
- *		koziol@ncsa.uiuc.edu
- *		Feb  3 2005
- *
  *-------------------------------------------------------------------------
  */
-herr_t
-H5B2__split_root(H5B2_hdr_t *hdr)
+static herr_t
+H5B2__add_depth(H5B2_hdr_t *hdr)
 {
-    H5B2_internal_t *new_root = NULL;   /* Pointer to new root node */
-    unsigned new_root_flags = H5AC__NO_FLAGS_SET;   /* Cache flags for new root node */
-    H5B2_node_ptr_t old_root_ptr;       /* Old node pointer to root node in B-tree */
     size_t sz_max_nrec;                 /* Temporary variable for range checking */
     unsigned u_max_nrec_size;           /* Temporary variable for range checking */
     herr_t ret_value = SUCCEED;         /* Return value */
 
-    FUNC_ENTER_PACKAGE
+    FUNC_ENTER_STATIC
 
     /* Check arguments. */
     HDassert(hdr);
@@ -376,6 +375,42 @@ H5B2__split_root(H5B2_hdr_t *hdr)
     if(NULL == (hdr->node_info[hdr->depth].node_ptr_fac = H5FL_fac_init(sizeof(H5B2_node_ptr_t) * (hdr->node_info[hdr->depth].max_nrec + 1))))
 	HGOTO_ERROR(H5E_RESOURCE, H5E_CANTINIT, FAIL, "can't create internal 'branch' node node pointer block factory")
 
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5B2__add_depth() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__split_root
+ *
+ * Purpose:	Split the root node
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ * Programmer:	Quincey Koziol
+ *		koziol@ncsa.uiuc.edu
+ *		Feb  3 2005
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2__split_root(H5B2_hdr_t *hdr)
+{
+    H5B2_internal_t *new_root = NULL;   /* Pointer to new root node */
+    unsigned new_root_flags = H5AC__NO_FLAGS_SET;   /* Cache flags for new root node */
+    H5B2_node_ptr_t old_root_ptr;       /* Old node pointer to root node in B-tree */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check arguments. */
+    HDassert(hdr);
+
+    /* Update depth of B-tree */
+    if(H5B2__add_depth(hdr) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to increase depth of B-tree")
+
     /* Keep old root node pointer info */
     old_root_ptr = hdr->root;
 
@@ -1484,6 +1519,346 @@ done:
 } /* H5B2__insert() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__bulk_begin
+ *
+ * Purpose:	Start a bulk load of NREC records into an empty B-tree.
+ *
+ *		The records must then be inserted in increasing order.  The
+ *		shape of the tree is worked out from NREC up front (as few
+ *		nodes as possible, each filled no further than its split
+ *		point, with the records spread evenly between siblings) and
+ *		each record is stored straight into its final place as it
+ *		arrives, so no node is ever split or redistributed.
+ *
+ *		Does nothing if the B-tree isn't empty.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2__bulk_begin(H5B2_hdr_t *hdr, hsize_t nrec)
+{
+    H5B2_bulk_t *bulk = NULL;           /* Bulk load state */
+    hsize_t     cap;                    /* Max. # of records in a subtree */
+    unsigned    u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check arguments. */
+    HDassert(hdr);
+    HDassert(!hdr->bulk);
+
+    /* Only an empty B-tree can be bulk loaded */
+    if(nrec == 0 || H5F_addr_defined(hdr->root.addr) || hdr->depth > 0)
+        HGOTO_DONE(SUCCEED)
+    if(hdr->node_info[0].split_nrec < 2)
+        HGOTO_DONE(SUCCEED)
+
+    /* Deepen the B-tree until a subtree at the root's depth can hold the records */
+    cap = hdr->node_info[0].split_nrec;
+    while(cap < nrec) {
+        hsize_t split_nrec;             /* Max. # of records in an internal node */
+
+        if(H5B2__add_depth(hdr) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to increase depth of B-tree")
+        split_nrec = hdr->node_info[hdr->depth].split_nrec;
+        if(split_nrec == 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_BADVALUE, FAIL, "internal nodes can't hold any records")
+        if((cap + 1) > (HSIZET_MAX / (split_nrec + 1)))
+            cap = HSIZET_MAX;
+        else
+            cap = ((split_nrec + 1) * (cap + 1)) - 1;
+    } /* end while */
+
+    /* Set up the bulk load state */
+    if(NULL == (bulk = (H5B2_bulk_t *)H5MM_calloc(sizeof(H5B2_bulk_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for bulk load info")
+    if(NULL == (bulk->path = (H5B2_bulk_node_t *)H5MM_calloc((size_t)(hdr->depth + 1) * sizeof(H5B2_bulk_node_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for bulk load info")
+    if(NULL == (bulk->last_rec = (uint8_t *)H5MM_malloc(hdr->cls->nrec_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for bulk load info")
+    bulk->nrec = nrec;
+    bulk->path[0].cap = hdr->node_info[0].split_nrec;
+    for(u = 1; u <= hdr->depth; u++) {
+        hsize_t split_nrec = hdr->node_info[u].split_nrec;
+
+        if((bulk->path[u - 1].cap + 1) > (HSIZET_MAX / (split_nrec + 1)))
+            bulk->path[u].cap = HSIZET_MAX;
+        else
+            bulk->path[u].cap = ((split_nrec + 1) * (bulk->path[u - 1].cap + 1)) - 1;
+    } /* end for */
+    hdr->bulk = bulk;
+    bulk = NULL;
+
+    /* Forget any cached min & max records */
+    if(hdr->min_native_rec)
+        hdr->min_native_rec = H5MM_xfree(hdr->min_native_rec);
+    if(hdr->max_native_rec)
+        hdr->max_native_rec = H5MM_xfree(hdr->max_native_rec);
+
+    /* Open the nodes down the left edge of the B-tree */
+    if(H5B2__bulk_open(hdr, hdr->depth, hdr, &hdr->root, nrec) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to create B-tree nodes")
+
+    /* Mark B-tree header as dirty */
+    if(H5B2__hdr_dirty(hdr) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTMARKDIRTY, FAIL, "unable to mark B-tree header dirty")
+
+done:
+    if(ret_value < 0) {
+        if(bulk) {
+            H5MM_xfree(bulk->path);
+            H5MM_xfree(bulk);
+        } /* end if */
+        if(hdr->bulk && H5B2__bulk_end(hdr) < 0)
+            HDONE_ERROR(H5E_BTREE, H5E_CANTRELEASE, FAIL, "unable to end bulk load")
+        if(!H5F_addr_defined(hdr->root.addr))
+            hdr->depth = 0;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__bulk_begin() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__bulk_open
+ *
+ * Purpose:	Create and protect a node of a B-tree being bulk loaded,
+ *		for a subtree of ALL_NREC records, along with the first
+ *		child of each new node down to a leaf.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5B2__bulk_open(H5B2_hdr_t *hdr, uint16_t depth, void *parent,
+    H5B2_node_ptr_t *node_ptr, hsize_t all_nrec)
+{
+    H5B2_bulk_t *bulk = hdr->bulk;      /* Bulk load state */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check arguments. */
+    HDassert(bulk);
+    HDassert(all_nrec > 0);
+
+    while(1) {
+        H5B2_bulk_node_t *bnode = &bulk->path[depth];     /* Node at this depth */
+
+        HDassert(NULL == bnode->node);
+        HDassert(all_nrec <= bnode->cap);
+
+        bnode->node_ptr = node_ptr;
+        bnode->all_nrec = all_nrec;
+        bnode->nstored = 0;
+        node_ptr->node_nrec = 0;
+        node_ptr->all_nrec = 0;
+
+        if(depth == 0) {
+            if(H5B2__create_leaf(hdr, parent, node_ptr) < 0)
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to create B-tree leaf node")
+            if(NULL == (bnode->node = H5B2__protect_leaf(hdr, parent, node_ptr, FALSE, H5AC__NO_FLAGS_SET)))
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTPROTECT, FAIL, "unable to protect B-tree leaf node")
+            H5_CHECKED_ASSIGN(bnode->nrec, unsigned, all_nrec, hsize_t);
+            break;
+        } /* end if */
+        else {
+            H5B2_internal_t *internal;  /* Pointer to internal node */
+            hsize_t     child_cap = bulk->path[depth - 1].cap; /* Max. # of records in a child's subtree */
+            hsize_t     nchild;         /* Number of children */
+
+            if(H5B2__create_internal(hdr, parent, node_ptr, depth) < 0)
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to create B-tree internal node")
+            if(NULL == (internal = H5B2__protect_internal(hdr, parent, node_ptr, depth, FALSE, H5AC__NO_FLAGS_SET)))
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTPROTECT, FAIL, "unable to protect B-tree internal node")
+            bnode->node = internal;
+
+            /* Use as few children as will hold the records, and spread
+             * the records evenly between them */
+            if(child_cap == HSIZET_MAX)
+                nchild = 1;
+            else
+                nchild = (all_nrec + 1 + child_cap) / (child_cap + 1);
+            H5_CHECKED_ASSIGN(bnode->nrec, unsigned, nchild - 1, hsize_t);
+            bnode->child_nrec = (all_nrec - (nchild - 1)) / nchild;
+            bnode->nbig = (all_nrec - (nchild - 1)) % nchild;
+            HDassert(bnode->child_nrec > 0);
+
+            /* Move on to the first child */
+            parent = internal;
+            node_ptr = &internal->node_ptrs[0];
+            all_nrec = bnode->child_nrec + (bnode->nbig > 0 ? 1 : 0);
+            depth--;
+        } /* end else */
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__bulk_open() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__bulk_close
+ *
+ * Purpose:	Release a node of a B-tree being bulk loaded, once it's
+ *		filled, and record its size in its parent.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5B2__bulk_close(H5B2_hdr_t *hdr, uint16_t depth)
+{
+    H5B2_bulk_node_t *bnode = &hdr->bulk->path[depth];  /* Node to close */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check arguments. */
+    HDassert(bnode->node);
+
+    H5_CHECKED_ASSIGN(bnode->node_ptr->node_nrec, uint16_t, bnode->nstored, unsigned);
+    bnode->node_ptr->all_nrec = bnode->all_nrec;
+    if(H5AC_unprotect(hdr->f, (depth > 0 ? H5AC_BT2_INT : H5AC_BT2_LEAF), bnode->node_ptr->addr, bnode->node, H5AC__DIRTIED_FLAG) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTUNPROTECT, FAIL, "unable to release B-tree node")
+    bnode->node = NULL;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__bulk_close() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__bulk_insert
+ *
+ * Purpose:	Adds the next record to a B-tree being bulk loaded.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2__bulk_insert(H5B2_hdr_t *hdr, void *udata)
+{
+    H5B2_bulk_t *bulk = hdr->bulk;      /* Bulk load state */
+    H5B2_bulk_node_t *bnode;            /* Node the record goes in */
+    uint16_t    depth;                  /* Depth of node the record goes in */
+    uint8_t     *native;                /* Location of the record in its node */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check arguments. */
+    HDassert(bulk);
+    HDassert(udata);
+
+    /* Check the record against the bulk load's plan */
+    if(bulk->ninserted == bulk->nrec)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "more records than announced for bulk load")
+    if(bulk->ninserted > 0) {
+        int cmp;                        /* Comparison value of records */
+
+        if((hdr->cls->compare)(udata, bulk->last_rec, &cmp) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTCOMPARE, FAIL, "can't compare btree2 records")
+        if(cmp <= 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "records for bulk load are not in increasing order")
+    } /* end if */
+
+    /* Store the record in its node */
+    depth = bulk->sep_depth;
+    bnode = &bulk->path[depth];
+    HDassert(bnode->node);
+    HDassert(bnode->nstored < bnode->nrec);
+    if(depth > 0)
+        native = H5B2_INT_NREC((H5B2_internal_t *)bnode->node, hdr, bnode->nstored);
+    else
+        native = H5B2_LEAF_NREC((H5B2_leaf_t *)bnode->node, hdr, bnode->nstored);
+    if((hdr->cls->store)(native, udata) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "unable to store record")
+    HDmemcpy(bulk->last_rec, native, hdr->cls->nrec_size);
+    bnode->nstored++;
+    bulk->ninserted++;
+
+    if(depth > 0) {
+        H5B2_internal_t *internal = (H5B2_internal_t *)bnode->node;   /* Pointer to internal node */
+        hsize_t     child_nrec;         /* Number of records in next child's subtree */
+
+        H5_CHECKED_ASSIGN(internal->nrec, uint16_t, bnode->nstored, unsigned);
+
+        /* The record separates the last child from the next one, so start it */
+        child_nrec = bnode->child_nrec + ((hsize_t)bnode->nstored < bnode->nbig ? 1 : 0);
+        if(H5B2__bulk_open(hdr, (uint16_t)(depth - 1), internal, &internal->node_ptrs[bnode->nstored], child_nrec) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to create B-tree nodes")
+        bulk->sep_depth = 0;
+    } /* end if */
+    else {
+        H5_CHECKED_ASSIGN(((H5B2_leaf_t *)bnode->node)->nrec, uint16_t, bnode->nstored, unsigned);
+
+        /* Release the nodes this record completes, up to the first one
+         * that still has children to come */
+        while(bnode->nstored == bnode->nrec) {
+            if(H5B2__bulk_close(hdr, depth) < 0)
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTUNPROTECT, FAIL, "unable to release B-tree node")
+            if(depth == hdr->depth)
+                break;
+            bnode = &bulk->path[++depth];
+            if(bnode->nstored < bnode->nrec)
+                bulk->sep_depth = depth;
+        } /* end while */
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__bulk_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__bulk_end
+ *
+ * Purpose:	Finish a bulk load, releasing its state.  Fails if fewer
+ *		records were inserted than announced.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2__bulk_end(H5B2_hdr_t *hdr)
+{
+    H5B2_bulk_t *bulk = hdr->bulk;      /* Bulk load state */
+    unsigned    u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check arguments. */
+    HDassert(bulk);
+
+    /* Release any nodes still being filled */
+    for(u = 0; u <= hdr->depth; u++)
+        if(bulk->path[u].node && H5B2__bulk_close(hdr, (uint16_t)u) < 0)
+            HDONE_ERROR(H5E_BTREE, H5E_CANTUNPROTECT, FAIL, "unable to release B-tree node")
+    if(bulk->ninserted < bulk->nrec)
+        HDONE_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "fewer records than announced for bulk load")
+
+    /* Mark B-tree header as dirty */
+    if(H5B2__hdr_dirty(hdr) < 0)
+        HDONE_ERROR(H5E_BTREE, H5E_CANTMARKDIRTY, FAIL, "unable to mark B-tree header dirty")
+
+    H5MM_xfree(bulk->last_rec);
+    H5MM_xfree(bulk->path);
+    hdr->bulk = (H5B2_bulk_t *)H5MM_xfree(bulk);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__bulk_end() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5B2__iterate_node
  *
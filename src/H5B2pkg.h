@@ -149,6 +149,28 @@ typedef struct {
     H5FL_fac_head_t *node_ptr_fac;  /* Factory for node pointer blocks */
 } H5B2_node_info_t;
 
+/* A node being filled during a bulk load */
+typedef struct {
+    void        *node;          /* Node, protected while it's filled (NULL once complete) */
+    H5B2_node_ptr_t *node_ptr;  /* Node pointer to node, in its parent */
+    hsize_t     cap;            /* Max. # of records in a subtree rooted at this depth */
+    hsize_t     all_nrec;       /* Number of records in node and all it's children */
+    unsigned    nrec;           /* Number of records to store in node */
+    unsigned    nstored;        /* Number of records stored in node so far */
+    hsize_t     child_nrec;     /* Number of records in each child's subtree */
+    hsize_t     nbig;           /* Number of children with one more record */
+} H5B2_bulk_node_t;
+
+/* State of a bulk load, which builds the B-tree from the root down as
+ * records arrive in increasing order */
+typedef struct {
+    hsize_t     nrec;           /* Number of records announced */
+    hsize_t     ninserted;      /* Number of records inserted so far */
+    uint16_t    sep_depth;      /* Depth of node the next record goes in */
+    uint8_t     *last_rec;      /* Copy of the last native record inserted */
+    H5B2_bulk_node_t *path;     /* Nodes being filled, indexed by depth */
+} H5B2_bulk_t;
+
 /* The B-tree header information */
 typedef struct H5B2_hdr_t {
     /* Information for H5AC cache functions, _must_ be first field in structure */
@@ -185,6 +207,7 @@ typedef struct H5B2_hdr_t {
     H5B2_node_info_t *node_info; /* Table of node info structs for current depth of B-tree */
     void        *min_native_rec; /* Pointer to minimum native record                  */
     void        *max_native_rec; /* Pointer to maximum native record                  */
+    H5B2_bulk_t *bulk;          /* Bulk load in progress, or NULL */
 
     /* SWMR / Flush dependency information (not stored) */
     hbool_t     swmr_write;     /* Whether we are doing SWMR writes */
@@ -393,6 +416,9 @@ H5_DLL herr_t H5B2__internal_free(H5B2_internal_t *i);
 
 /* Routines for inserting records */
 H5_DLL herr_t H5B2__insert(H5B2_hdr_t *hdr, void *udata);
+H5_DLL herr_t H5B2__bulk_begin(H5B2_hdr_t *hdr, hsize_t nrec);
+H5_DLL herr_t H5B2__bulk_insert(H5B2_hdr_t *hdr, void *udata);
+H5_DLL herr_t H5B2__bulk_end(H5B2_hdr_t *hdr);
 H5_DLL herr_t H5B2__insert_internal(H5B2_hdr_t *hdr, uint16_t depth,
     unsigned *parent_cache_info_flags_ptr, H5B2_node_ptr_t *curr_node_ptr,
     H5B2_nodepos_t curr_pos, void *parent, void *udata);
@@ -130,6 +130,8 @@ H5_DLL H5B2_t *H5B2_create(H5F_t *f, const H5B2_create_t *cparam,
 H5_DLL H5B2_t *H5B2_open(H5F_t *f, haddr_t addr, void *ctx_udata);
 H5_DLL herr_t H5B2_get_addr(const H5B2_t *bt2, haddr_t *addr/*out*/);
 H5_DLL herr_t H5B2_insert(H5B2_t *bt2, void *udata);
+H5_DLL herr_t H5B2_bulk_begin(H5B2_t *bt2, hsize_t nrec);
+H5_DLL herr_t H5B2_bulk_end(H5B2_t *bt2);
 H5_DLL herr_t H5B2_iterate(H5B2_t *bt2, H5B2_operator_t op, void *op_data);
 H5_DLL htri_t H5B2_find(H5B2_t *bt2, void *udata, H5B2_found_t op, void *op_data);
 H5_DLL herr_t H5B2_index(H5B2_t *bt2, H5_iter_order_t order, hsize_t idx,
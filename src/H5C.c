@@ -106,6 +106,47 @@
 /* Local Typedefs */
 /******************/
 
+/* Buffers used by H5C__flush_ring() to write adjacent entries at once */
+typedef struct H5C_write_gather_t {
+    uint8_t    *buf;                    /* Buffer the entries' images are gathered into */
+    size_t      buf_size;               /* Size of 'buf' */
+    H5C_cache_entry_t **entries;        /* Entries written together */
+    size_t      entries_alloc;          /* # of entries allocated in 'entries' */
+} H5C_write_gather_t;
+
+#ifdef H5C_HAVE_SERIALIZE_THREADS
+/* An entry to serialize with H5C__serialize_entries_threads() */
+typedef struct H5C_serialize_job_t {
+    H5C_cache_entry_t *entry_ptr;       /* Entry to serialize */
+    herr_t      status;                 /* Result of serializing it */
+    H5E_t      *errors;                 /* Errors of an entry which failed on a helper thread */
+} H5C_serialize_job_t;
+
+/* Work shared by the threads running H5C__serialize_entries_threads() */
+typedef struct H5C_serialize_work_t {
+    H5F_t      *f;                      /* File the entries belong to */
+    size_t      njobs;                  /* # of entries to serialize */
+    H5C_serialize_job_t *jobs;          /* Entries to serialize */
+    size_t      next;                   /* Next entry to serialize */
+    unsigned    nhelpers;               /* # of helper threads which may still join */
+    unsigned    nactive;                /* # of helper threads working on it */
+} H5C_serialize_work_t;
+
+/* Helper threads for H5C__serialize_entries_threads(), kept until the
+ * library is closed.  Only one thread at a time hands them work, since
+ * the caller holds the API lock.
+ */
+typedef struct H5C_serialize_pool_t {
+    pthread_mutex_t lock;               /* Protects the fields below and the work */
+    pthread_cond_t work_cond;           /* Signals the helpers about work or shutdown */
+    pthread_cond_t done_cond;           /* Signals the caller that the helpers are done */
+    pthread_t  *threads;                /* Helper threads */
+    unsigned    nthreads;               /* # of helper threads */
+    H5C_serialize_work_t *work;         /* Work for the helpers, or NULL */
+    hbool_t     shutdown;               /* Whether the helpers should exit */
+} H5C_serialize_pool_t;
+#endif /* H5C_HAVE_SERIALIZE_THREADS */
+
 
 /********************/
 /* Local Prototypes */
@@ -142,12 +183,41 @@ static herr_t H5C__autoadjust__ageout__remove_excess_markers(H5C_t * cache_ptr);
 static herr_t H5C__flash_increase_cache_size(H5C_t * cache_ptr,
     size_t old_entry_size, size_t new_entry_size);
 
+static void H5C__rp_2q_discard_ghosts(H5C_t *cache_ptr);
+
+static int H5C__lock_ro_ref_count(H5C_cache_entry_t *entry_ptr);
+
+static int H5C__protect_ro_in_lru(H5C_cache_entry_t *entry_ptr);
+
+static hbool_t H5C__unprotect_ro_in_lru(H5C_cache_entry_t *entry_ptr);
+
+static herr_t H5C__move_ro_in_lru_entry_to_pl(H5C_t *cache_ptr,
+    H5C_cache_entry_t *entry_ptr);
+
 static herr_t H5C__flush_invalidate_cache(H5F_t *f, unsigned flags);
 
 static herr_t H5C_flush_invalidate_ring(H5F_t *f, H5C_ring_t ring, unsigned flags);
 
 static herr_t H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags);
 
+static hbool_t H5C__can_gather_entry(const H5C_cache_entry_t *prev_ptr,
+    const H5C_cache_entry_t *entry_ptr, H5C_ring_t ring,
+    hbool_t flush_marked_entries);
+
+static herr_t H5C__flush_gathered_entries(H5F_t *f, H5C_write_gather_t *gather,
+    H5C_cache_entry_t *entry_ptr, H5SL_node_t **node_ptr_ptr,
+    H5C_cache_entry_t **next_entry_ptr_ptr, H5C_ring_t ring, unsigned flags,
+    hbool_t flush_marked_entries);
+
+#ifdef H5C_HAVE_SERIALIZE_THREADS
+static herr_t H5C__serialize_entries_threads(H5F_t *f, H5C_ring_t ring,
+    hbool_t flush_marked_entries, unsigned nthreads);
+static void H5C__serialize_entries_run(H5C_serialize_work_t *work,
+    hbool_t helper);
+static void *H5C__serialize_entries_helper(void *_pool);
+static void H5C__serialize_pool_grow(unsigned nthreads);
+#endif /* H5C_HAVE_SERIALIZE_THREADS */
+
 static void * H5C_load_entry(H5F_t *             f,
 #ifdef H5_HAVE_PARALLEL
                              hbool_t             coll_access,
@@ -207,9 +277,18 @@ H5FL_DEFINE(H5C_tag_info_t);
 /* Declare a free list to manage the H5C_t struct */
 H5FL_DEFINE_STATIC(H5C_t);
 
+/* Declare a free list to manage the H5C_rp_ghost_t struct */
+H5FL_DEFINE_STATIC(H5C_rp_ghost_t);
+
 /* Declare a free list to manage flush dependency arrays */
 H5FL_BLK_DEFINE_STATIC(parent);
 
+#ifdef H5C_HAVE_SERIALIZE_THREADS
+/* Helper threads serializing entries */
+static H5C_serialize_pool_t H5C_serialize_pool_g = {PTHREAD_MUTEX_INITIALIZER,
+        PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, 0, NULL, FALSE};
+#endif /* H5C_HAVE_SERIALIZE_THREADS */
+
 
 
 /*-------------------------------------------------------------------------
@@ -305,6 +384,7 @@ H5C_create(size_t		      max_cache_size,
     cache_ptr->log_flush			= log_flush;
 
     cache_ptr->evictions_enabled		= TRUE;
+    cache_ptr->deferred_lru			= FALSE;
     cache_ptr->close_warning_received		= FALSE;
 
     cache_ptr->index_len			= 0;
@@ -381,6 +461,15 @@ H5C_create(size_t		      max_cache_size,
     cache_ptr->dLRU_tail_ptr			= NULL;
 #endif /* H5C_MAINTAIN_CLEAN_AND_DIRTY_LRU_LISTS */
 
+    cache_ptr->rp_mode				= H5C_rp__lru;
+    cache_ptr->rp_hot_size			= (size_t)0;
+    cache_ptr->rp_cold_head_ptr			= NULL;
+    cache_ptr->rp_ghost_slist_ptr		= NULL;
+    cache_ptr->rp_ghost_len			= 0;
+    cache_ptr->rp_ghost_size			= (size_t)0;
+    cache_ptr->rp_ghost_head_ptr		= NULL;
+    cache_ptr->rp_ghost_tail_ptr		= NULL;
+
     cache_ptr->size_increase_possible		= FALSE;
     cache_ptr->flash_size_increase_possible     = FALSE;
     cache_ptr->flash_size_increase_threshold    = 0;
@@ -865,6 +954,9 @@ H5C_dest(H5F_t * f)
         cache_ptr->tag_list = NULL;
     } /* end if */
 
+    /* Forget the entries evicted under the 2Q policy */
+    H5C__rp_2q_discard_ghosts(cache_ptr);
+
 #ifndef NDEBUG
 #if H5C_DO_SANITY_CHECKS
     if(cache_ptr->get_entry_ptr_from_addr_counter > 0)
@@ -1313,6 +1405,8 @@ H5C_insert_entry(H5F_t *             f,
     entry_ptr->is_protected = FALSE;
     entry_ptr->is_read_only = FALSE;
     entry_ptr->ro_ref_count = 0;
+    entry_ptr->ro_in_lru = FALSE;
+    entry_ptr->lru_ref_bit = FALSE;
 
     entry_ptr->is_pinned = insert_pinned;
     entry_ptr->pinned_from_client = insert_pinned;
@@ -2001,6 +2095,13 @@ H5C_resize_entry(void *thing, size_t new_size)
     if ( entry_ptr->size != new_size ) {
         hbool_t		was_clean;
 
+        /* the entry is about to be marked dirty, so it can't stay on the
+         * clean LRU list if it was protected there
+         */
+        if(entry_ptr->ro_in_lru)
+            if(H5C__move_ro_in_lru_entry_to_pl(cache_ptr, entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTRESIZE, FAIL, "Can't move entry to protected list")
+
         /* make note of whether the entry was clean to begin with */
         was_clean = !entry_ptr->is_dirty;
 
@@ -2201,6 +2302,7 @@ H5C_protect(H5F_t *		f,
 #endif /* H5_HAVE_PARALLEL */
     hbool_t		write_permitted;
     hbool_t             was_loaded = FALSE;     /* Whether the entry was loaded as a result of the protect */
+    int                 ro_ref_count;           /* Read only protects of an entry left on the LRU lists */
     size_t		empty_space;
     void *		thing;
     H5C_cache_entry_t *	entry_ptr;
@@ -2497,30 +2599,53 @@ H5C_protect(H5F_t *		f,
     HDassert(entry_ptr->addr == addr);
     HDassert(entry_ptr->type == type);
 
-    if(entry_ptr->is_protected) {
-	if(read_only && entry_ptr->is_read_only) {
-	    HDassert(entry_ptr->ro_ref_count > 0);
-	    (entry_ptr->ro_ref_count)++;
-	} /* end if */
-        else 
-            HGOTO_ERROR(H5E_CACHE, H5E_CANTPROTECT, NULL, "Target already protected & not read only?!?")
+    if(read_only && cache_ptr->deferred_lru &&
+            !entry_ptr->is_dirty && !entry_ptr->is_pinned &&
+            ((ro_ref_count = H5C__protect_ro_in_lru(entry_ptr)) > 0)) {
+        /* The entry was left where it is on the LRU lists, and only the
+         * entry itself was updated.  See the discussion of deferred_lru
+         * in H5Cpkg.h.
+         */
+        if(hit) {
+            H5C__UPDATE_CACHE_HIT_RATE_STATS_FOR_RO_IN_LRU_HIT(cache_ptr)
+
+            H5C__UPDATE_STATS_FOR_RO_IN_LRU_HIT(cache_ptr, entry_ptr, ro_ref_count)
+        } /* end if */
+        else {
+            H5C__UPDATE_CACHE_HIT_RATE_STATS(cache_ptr, hit)
+
+            H5C__UPDATE_STATS_FOR_PROTECT(cache_ptr, entry_ptr, hit)
+        } /* end else */
     } /* end if */
     else {
-    	H5C__UPDATE_RP_FOR_PROTECT(cache_ptr, entry_ptr, NULL)
+        if(entry_ptr->is_protected) {
+            if(read_only && entry_ptr->is_read_only) {
+                HDassert(entry_ptr->ro_ref_count > 0);
+                (entry_ptr->ro_ref_count)++;
+            } /* end if */
+            else 
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTPROTECT, NULL, "Target already protected & not read only?!?")
+        } /* end if */
+        else {
+            H5C__UPDATE_RP_FOR_PROTECT(cache_ptr, entry_ptr, NULL)
 
-    	entry_ptr->is_protected = TRUE;
+            entry_ptr->is_protected = TRUE;
 
-	if ( read_only ) {
-	    entry_ptr->is_read_only = TRUE;
-	    entry_ptr->ro_ref_count = 1;
-	} /* end if */
+            /* the entry goes to the head of the LRU list when unprotected */
+            entry_ptr->lru_ref_bit = FALSE;
 
-    	entry_ptr->dirtied = FALSE;
-    } /* end else */
+            if ( read_only ) {
+                entry_ptr->is_read_only = TRUE;
+                entry_ptr->ro_ref_count = 1;
+            } /* end if */
 
-    H5C__UPDATE_CACHE_HIT_RATE_STATS(cache_ptr, hit)
+            entry_ptr->dirtied = FALSE;
+        } /* end else */
+
+        H5C__UPDATE_CACHE_HIT_RATE_STATS(cache_ptr, hit)
 
-    H5C__UPDATE_STATS_FOR_PROTECT(cache_ptr, entry_ptr, hit)
+        H5C__UPDATE_STATS_FOR_PROTECT(cache_ptr, entry_ptr, hit)
+    } /* end else */
 
     ret_value = thing;
 
@@ -2903,242 +3028,695 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_set_evictions_enabled() */
 
-
+
 /*-------------------------------------------------------------------------
- * Function:    H5C_unpin_entry()
- *
- * Purpose:	Unpin a cache entry.  The entry can be either protected or
- * 		unprotected at the time of call, but must be pinned.
+ * Function:    H5C_set_deferred_lru()
  *
- * Return:      Non-negative on success/Negative on failure
+ * Purpose:     Set cache_ptr->deferred_lru to the value of the
+ *              deferred_lru parameter.
  *
- * Programmer:  John Mainzer
- *              3/22/06
+ *              Entries that are currently protected read only without
+ *              having left the LRU list are not affected, and are
+ *              handled as such when they are unprotected.
  *
- * Changes:	Added extreme sanity checks on entry and exit.
-                				JRM -- 4/26/14 
+ * Return:      SUCCEED on success, and FAIL on failure.
  *
  *-------------------------------------------------------------------------
  */
 herr_t
-H5C_unpin_entry(void *_entry_ptr)
+H5C_set_deferred_lru(H5C_t *cache_ptr, hbool_t deferred_lru)
 {
-    H5C_t             * cache_ptr;
-    H5C_cache_entry_t * entry_ptr = (H5C_cache_entry_t *)_entry_ptr; /* Pointer to entry to unpin */
-    herr_t              ret_value = SUCCEED;    /* Return value */
+    herr_t ret_value = SUCCEED;      /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
 
-    /* Sanity check */
-    HDassert(entry_ptr);
-    cache_ptr = entry_ptr->cache_ptr;
-    HDassert(cache_ptr);
-    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
-
-#if H5C_DO_EXTREME_SANITY_CHECKS
-    if((H5C_validate_protected_entry_list(cache_ptr) < 0) ||
-            (H5C_validate_pinned_entry_list(cache_ptr) < 0) ||
-            (H5C_validate_lru_list(cache_ptr) < 0))
-        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "an extreme sanity check failed on entry")
-#endif /* H5C_DO_EXTREME_SANITY_CHECKS */
-
+    if((cache_ptr == NULL) || (cache_ptr->magic != H5C__H5C_T_MAGIC))
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry")
 
-    /* Unpin the entry */
-    if(H5C__unpin_entry_from_client(cache_ptr, entry_ptr, TRUE) < 0)
-        HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPIN, FAIL, "Can't unpin entry from client")
+    cache_ptr->deferred_lru = deferred_lru;
 
 done:
-#if H5C_DO_EXTREME_SANITY_CHECKS
-    if((H5C_validate_protected_entry_list(cache_ptr) < 0) ||
-            (H5C_validate_pinned_entry_list(cache_ptr) < 0) ||
-            (H5C_validate_lru_list(cache_ptr) < 0))
-        HDONE_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "an extreme sanity check failed on exit")
-#endif /* H5C_DO_EXTREME_SANITY_CHECKS */
-
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5C_unpin_entry() */
+} /* H5C_set_deferred_lru() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:    H5C_unprotect
- *
- * Purpose:	Undo an H5C_protect() call -- specifically, mark the
- *		entry as unprotected, remove it from the protected list,
- *		and give it back to the replacement policy.
- *
- *		The TYPE and ADDR arguments must be the same as those in
- *		the corresponding call to H5C_protect() and the THING
- *		argument must be the value returned by that call to
- *		H5C_protect().
+ * Function:    H5C_set_replacement_policy()
  *
- * Return:      Non-negative on success/Negative on failure
+ * Purpose:     Set the replacement policy of the cache.
  *
- *		If the deleted flag is TRUE, simply remove the target entry
- *		from the cache, clear it, and free it without writing it to
- *		disk.
+ *              On a switch to the 2Q policy, all entries in the cache
+ *              become hot, and then the least recently used of them are
+ *              demoted until the hot segment of the LRU list is within
+ *              its size limit.  On a switch back to the modified LRU
+ *              policy, the addresses remembered from 2Q evictions are
+ *              discarded.
  *
- * Return:      Non-negative on success/Negative on failure
+ *              The LRU list itself is not reordered in either case.
  *
- * Programmer:  John Mainzer
- *              6/2/04
+ * Return:      SUCCEED on success, and FAIL on failure.
  *
  *-------------------------------------------------------------------------
  */
 herr_t
-H5C_unprotect(H5F_t *f, haddr_t	addr, void *thing, unsigned flags)
+H5C_set_replacement_policy(H5C_t *cache_ptr, enum H5C_cache_rp_mode policy)
 {
-    H5C_t *             cache_ptr;
-    hbool_t		deleted;
-    hbool_t		dirtied;
-    hbool_t             set_flush_marker;
-    hbool_t		pin_entry;
-    hbool_t		unpin_entry;
-    hbool_t		free_file_space;
-    hbool_t		take_ownership;
-    hbool_t 		was_clean;
-#ifdef H5_HAVE_PARALLEL
-    hbool_t		clear_entry = FALSE;
-#endif /* H5_HAVE_PARALLEL */
-    H5C_cache_entry_t *	entry_ptr;
-    H5C_cache_entry_t *	test_entry_ptr;
-    herr_t              ret_value = SUCCEED;    /* Return value */
+    H5C_cache_entry_t * entry_ptr;
+    herr_t ret_value = SUCCEED;      /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
 
-    deleted                = ((flags & H5C__DELETED_FLAG) != 0);
-    dirtied                = ((flags & H5C__DIRTIED_FLAG) != 0);
-    set_flush_marker       = ((flags & H5C__SET_FLUSH_MARKER_FLAG) != 0);
-    pin_entry              = ((flags & H5C__PIN_ENTRY_FLAG) != 0);
-    unpin_entry            = ((flags & H5C__UNPIN_ENTRY_FLAG) != 0);
-    free_file_space        = ((flags & H5C__FREE_FILE_SPACE_FLAG) != 0);
-    take_ownership         = ((flags & H5C__TAKE_OWNERSHIP_FLAG) != 0);
+    if((cache_ptr == NULL) || (cache_ptr->magic != H5C__H5C_T_MAGIC))
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry")
+    if((policy != H5C_rp__lru) && (policy != H5C_rp__2q))
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Unknown replacement policy")
 
-    HDassert( f );
-    HDassert( f->shared );
+    if(policy == cache_ptr->rp_mode)
+        HGOTO_DONE(SUCCEED)
 
-    cache_ptr = f->shared->cache;
+    if(policy == H5C_rp__2q) {
+        HDassert(cache_ptr->rp_ghost_slist_ptr == NULL);
+        HDassert(cache_ptr->rp_ghost_len == 0);
 
-    HDassert( cache_ptr );
-    HDassert( cache_ptr->magic == H5C__H5C_T_MAGIC );
-    HDassert( H5F_addr_defined(addr) );
-    HDassert( thing );
-    HDassert( ! ( pin_entry && unpin_entry ) );
-    HDassert( ( ! free_file_space ) || ( deleted ) );   /* deleted flag must accompany free_file_space */
-    HDassert( ( ! take_ownership ) || ( deleted ) );    /* deleted flag must accompany take_ownership */
-    HDassert( ! ( free_file_space && take_ownership ) );    /* can't have both free_file_space & take_ownership */
+        if(NULL == (cache_ptr->rp_ghost_slist_ptr = H5SL_create(H5SL_TYPE_HADDR, NULL)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, FAIL, "can't create ghost skip list")
 
-    entry_ptr = (H5C_cache_entry_t *)thing;
+        /* Make all entries hot, including those not on the LRU list now */
+        for(entry_ptr = cache_ptr->il_head; entry_ptr != NULL; entry_ptr = entry_ptr->il_next)
+            entry_ptr->rp_hot = TRUE;
 
-    HDassert( entry_ptr->addr == addr );
+        cache_ptr->rp_hot_size = 0;
+        for(entry_ptr = cache_ptr->LRU_head_ptr; entry_ptr != NULL; entry_ptr = entry_ptr->next)
+            if(entry_ptr->rp_hot)
+                cache_ptr->rp_hot_size += entry_ptr->size;
+        cache_ptr->rp_cold_head_ptr = NULL;
 
-    /* also set the dirtied variable if the dirtied field is set in
-     * the entry.
-     */
-    dirtied |= entry_ptr->dirtied;
-    was_clean = ! ( entry_ptr->is_dirty );
+        cache_ptr->rp_mode = H5C_rp__2q;
 
-#if H5C_DO_EXTREME_SANITY_CHECKS
-    if((H5C_validate_protected_entry_list(cache_ptr) < 0) ||
-            (H5C_validate_pinned_entry_list(cache_ptr) < 0) ||
-            (H5C_validate_lru_list(cache_ptr) < 0))
-        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "an extreme sanity check failed on entry")
-#endif /* H5C_DO_EXTREME_SANITY_CHECKS */
+        H5C__RP_2Q_DEMOTE_HOT(cache_ptr)
+    } /* end if */
+    else {
+        H5C__rp_2q_discard_ghosts(cache_ptr);
 
-    /* if the entry has multiple read only protects, just decrement
-     * the ro_ref_counter.  Don't actually unprotect until the ref count
-     * drops to zero.
-     */
-    if(entry_ptr->ro_ref_count > 1) {
-        /* Sanity check */
-	HDassert(entry_ptr->is_protected);
-        HDassert(entry_ptr->is_read_only);
+        cache_ptr->rp_hot_size = 0;
+        cache_ptr->rp_cold_head_ptr = NULL;
 
-	if(dirtied)
-            HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPROTECT, FAIL, "Read only entry modified??")
+        cache_ptr->rp_mode = H5C_rp__lru;
+    } /* end else */
 
-        /* Reduce the RO ref count */
-	(entry_ptr->ro_ref_count)--;
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_set_replacement_policy() */
 
-        /* Pin or unpin the entry as requested. */
-        if(pin_entry) {
-            /* Pin the entry from a client */
-            if(H5C__pin_entry_from_client(cache_ptr, entry_ptr) < 0)
-                HGOTO_ERROR(H5E_CACHE, H5E_CANTPIN, FAIL, "Can't pin entry by client")
-        } else if(unpin_entry) {
-            /* Unpin the entry from a client */
-            if(H5C__unpin_entry_from_client(cache_ptr, entry_ptr, FALSE) < 0)
-                HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPIN, FAIL, "Can't unpin entry by client")
-        } /* end if */
-    } else {
-	if(entry_ptr->is_read_only) {
-            /* Sanity check */
-	    HDassert(entry_ptr->ro_ref_count == 1);
 
-	    if(dirtied)
-                HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPROTECT, FAIL, "Read only entry modified??")
+/*-------------------------------------------------------------------------
+ * Function:    H5C__rp_2q_remember_ghost()
+ *
+ * Purpose:     Remember the address of a cold entry that is about to be
+ *              evicted to make space in the cache, so that it enters the
+ *              cache hot if it is loaded again soon.
+ *
+ *              The oldest addresses remembered are forgotten as needed to
+ *              keep the ghost list within its limits.
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C__rp_2q_remember_ghost(H5C_t *cache_ptr, const H5C_cache_entry_t *entry_ptr)
+{
+    H5C_rp_ghost_t * ghost_ptr;
+    size_t ghost_max_size;
+    herr_t ret_value = SUCCEED;      /* Return value */
 
-	    entry_ptr->is_read_only = FALSE;
-	    entry_ptr->ro_ref_count = 0;
-	} /* end if */
+    FUNC_ENTER_PACKAGE
 
-#ifdef H5_HAVE_PARALLEL
-        /* When the H5C code is used to implement the metadata cache in the
-         * PHDF5 case, only the cache on process 0 is allowed to write to file.
-         * All the other metadata caches must hold dirty entries until they
-         * are told that the entries are clean.
-         *
-         * The clear_on_unprotect flag in the H5C_cache_entry_t structure
-         * exists to deal with the case in which an entry is protected when
-         * its cache receives word that the entry is now clean.  In this case,
-         * the clear_on_unprotect flag is set, and the entry is flushed with
-         * the H5C__FLUSH_CLEAR_ONLY_FLAG.
-         *
-         * All this is a bit awkward, but until the metadata cache entries
-         * are contiguous, with only one dirty flag, we have to let the supplied
-         * functions deal with the reseting the is_dirty flag.
-         */
-        if(entry_ptr->clear_on_unprotect) {
-            /* Sanity check */
-            HDassert(entry_ptr->is_dirty);
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->rp_mode == H5C_rp__2q);
+    HDassert(cache_ptr->rp_ghost_slist_ptr);
+    HDassert(entry_ptr);
+    HDassert(!entry_ptr->rp_hot);
 
-            entry_ptr->clear_on_unprotect = FALSE;
-            if(!dirtied)
-                clear_entry = TRUE;
-        } /* end if */
-#endif /* H5_HAVE_PARALLEL */
+    /* An address may be reused by a different entry */
+    H5C__rp_2q_forget_ghost(cache_ptr, entry_ptr->addr);
 
-        if(!entry_ptr->is_protected)
-            HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPROTECT, FAIL, "Entry already unprotected??")
+    if(NULL == (ghost_ptr = H5FL_MALLOC(H5C_rp_ghost_t)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "can't allocate ghost")
+    ghost_ptr->addr = entry_ptr->addr;
+    ghost_ptr->size = entry_ptr->size;
 
-        /* Mark the entry as dirty if appropriate */
-        entry_ptr->is_dirty = (entry_ptr->is_dirty || dirtied);
+    if(H5SL_insert(cache_ptr->rp_ghost_slist_ptr, ghost_ptr, &(ghost_ptr->addr)) < 0) {
+        ghost_ptr = H5FL_FREE(H5C_rp_ghost_t, ghost_ptr);
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTINSERT, FAIL, "can't insert ghost in skip list")
+    } /* end if */
 
-	if(dirtied)
-	    if(entry_ptr->image_up_to_date) {
-	        entry_ptr->image_up_to_date = FALSE;
-	        if(entry_ptr->flush_dep_nparents > 0)
-		    if(H5C__mark_flush_dep_unserialized(entry_ptr) < 0)
-                        HGOTO_ERROR(H5E_CACHE, H5E_CANTNOTIFY, FAIL, "Can't propagate serialization status to fd parents")
-            } /* end if */
+    ghost_ptr->prev = NULL;
+    ghost_ptr->next = cache_ptr->rp_ghost_head_ptr;
+    if(cache_ptr->rp_ghost_head_ptr != NULL)
+        cache_ptr->rp_ghost_head_ptr->prev = ghost_ptr;
+    else
+        cache_ptr->rp_ghost_tail_ptr = ghost_ptr;
+    cache_ptr->rp_ghost_head_ptr = ghost_ptr;
+    cache_ptr->rp_ghost_len++;
+    cache_ptr->rp_ghost_size += ghost_ptr->size;
+
+    /* Forget the oldest ghosts beyond the limits */
+    ghost_max_size = (cache_ptr->max_cache_size / 100) * H5C__2Q_GHOST_SIZE_PERCENT;
+    while(cache_ptr->rp_ghost_len > 1 &&
+            (cache_ptr->rp_ghost_size > ghost_max_size ||
+             cache_ptr->rp_ghost_len > cache_ptr->index_len))
+        H5C__rp_2q_forget_ghost(cache_ptr, cache_ptr->rp_ghost_tail_ptr->addr);
 
-        /* Check for newly dirtied entry */
-        if(was_clean && entry_ptr->is_dirty) {
-            /* Update index for newly dirtied entry */
-            H5C__UPDATE_INDEX_FOR_ENTRY_DIRTY(cache_ptr, entry_ptr)
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__rp_2q_remember_ghost() */
 
-            /* If the entry's type has a 'notify' callback send a 'entry dirtied'
-             * notice now that the entry is fully integrated into the cache.
-             */
-            if(entry_ptr->type->notify &&
-                    (entry_ptr->type->notify)(H5C_NOTIFY_ACTION_ENTRY_DIRTIED, entry_ptr) < 0)
-                HGOTO_ERROR(H5E_CACHE, H5E_CANTNOTIFY, FAIL, "can't notify client about entry dirty flag set")
 
-            /* Propagate the flush dep dirty flag up the flush dependency chain
-             * if appropriate */
-            if(entry_ptr->flush_dep_nparents > 0)
-                if(H5C__mark_flush_dep_dirty(entry_ptr) < 0)
-                    HGOTO_ERROR(H5E_CACHE, H5E_CANTMARKDIRTY, FAIL, "Can't propagate flush dep dirty flag")
-        } /* end if */ 
+/*-------------------------------------------------------------------------
+ * Function:    H5C__rp_2q_forget_ghost()
+ *
+ * Purpose:     Forget the specified address if it is on the ghost list.
+ *
+ * Return:      TRUE if the address was on the ghost list, FALSE otherwise.
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5C__rp_2q_forget_ghost(H5C_t *cache_ptr, haddr_t addr)
+{
+    H5C_rp_ghost_t * ghost_ptr;
+    hbool_t ret_value = FALSE;       /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    if(cache_ptr->rp_ghost_len > 0 &&
+            NULL != (ghost_ptr = (H5C_rp_ghost_t *)H5SL_remove(cache_ptr->rp_ghost_slist_ptr, &addr))) {
+        if(ghost_ptr->prev != NULL)
+            ghost_ptr->prev->next = ghost_ptr->next;
+        else
+            cache_ptr->rp_ghost_head_ptr = ghost_ptr->next;
+        if(ghost_ptr->next != NULL)
+            ghost_ptr->next->prev = ghost_ptr->prev;
+        else
+            cache_ptr->rp_ghost_tail_ptr = ghost_ptr->prev;
+
+        HDassert(cache_ptr->rp_ghost_size >= ghost_ptr->size);
+        cache_ptr->rp_ghost_len--;
+        cache_ptr->rp_ghost_size -= ghost_ptr->size;
+
+        ghost_ptr = H5FL_FREE(H5C_rp_ghost_t, ghost_ptr);
+        ret_value = TRUE;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__rp_2q_forget_ghost() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__rp_2q_discard_ghosts()
+ *
+ * Purpose:     Forget all addresses on the ghost list, and release the
+ *              ghost skip list.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5C__rp_2q_discard_ghosts(H5C_t *cache_ptr)
+{
+    H5C_rp_ghost_t * ghost_ptr;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    ghost_ptr = cache_ptr->rp_ghost_head_ptr;
+    while(ghost_ptr != NULL) {
+        H5C_rp_ghost_t * next_ptr = ghost_ptr->next;
+
+        ghost_ptr = H5FL_FREE(H5C_rp_ghost_t, ghost_ptr);
+        ghost_ptr = next_ptr;
+    } /* end while */
+
+    if(cache_ptr->rp_ghost_slist_ptr != NULL) {
+        H5SL_close(cache_ptr->rp_ghost_slist_ptr);
+        cache_ptr->rp_ghost_slist_ptr = NULL;
+    } /* end if */
+
+    cache_ptr->rp_ghost_len = 0;
+    cache_ptr->rp_ghost_size = (size_t)0;
+    cache_ptr->rp_ghost_head_ptr = NULL;
+    cache_ptr->rp_ghost_tail_ptr = NULL;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C__rp_2q_discard_ghosts() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__lock_ro_ref_count()
+ *
+ * Purpose:     Wait until no other thread holds the entry's ro_ref_count,
+ *              and swap it for H5C__RO_REF_COUNT_BUSY.  The caller then
+ *              owns the entry's protect fields until it stores a new
+ *              count with H5C__ATOMIC_STORE().
+ *
+ * Return:      The entry's read only protect count
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5C__lock_ro_ref_count(H5C_cache_entry_t *entry_ptr)
+{
+    int         ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    do {
+        ret_value = H5C__ATOMIC_LOAD(&entry_ptr->ro_ref_count);
+    } while((ret_value == H5C__RO_REF_COUNT_BUSY) ||
+            !H5C__ATOMIC_CAS(&entry_ptr->ro_ref_count, ret_value, H5C__RO_REF_COUNT_BUSY));
+
+    HDassert(ret_value >= 0);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__lock_ro_ref_count() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__protect_ro_in_lru()
+ *
+ * Purpose:     Protect a clean, unpinned entry read only without taking
+ *              it off the LRU lists, if it isn't protected otherwise.
+ *
+ *              Only the entry's protect fields are changed, with its
+ *              ro_ref_count held, so several threads may do this at
+ *              once.  See the discussion of deferred_lru in H5Cpkg.h.
+ *
+ * Return:      The entry's new read only protect count, or zero if the
+ *              entry is protected read/write or is on the protected
+ *              list, and must be handled by the ordinary protect path.
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5C__protect_ro_in_lru(H5C_cache_entry_t *entry_ptr)
+{
+    int         ro_ref_count;           /* Read only protect count */
+    int         ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(entry_ptr);
+    HDassert(!entry_ptr->is_dirty);
+    HDassert(!entry_ptr->is_pinned);
+
+    ro_ref_count = H5C__lock_ro_ref_count(entry_ptr);
+
+    if(ro_ref_count == 0) {
+        if(!entry_ptr->is_protected) {
+            entry_ptr->is_protected = TRUE;
+            entry_ptr->is_read_only = TRUE;
+            entry_ptr->ro_in_lru = TRUE;
+            entry_ptr->dirtied = FALSE;
+            ret_value = ++ro_ref_count;
+        } /* end if */
+    } /* end if */
+    else if(entry_ptr->ro_in_lru) {
+        HDassert(entry_ptr->is_protected);
+        HDassert(entry_ptr->is_read_only);
+        ret_value = ++ro_ref_count;
+    } /* end else-if */
+
+    H5C__ATOMIC_STORE(&entry_ptr->ro_ref_count, ro_ref_count);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__protect_ro_in_lru() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__unprotect_ro_in_lru()
+ *
+ * Purpose:     Undo a read only protect made by H5C__protect_ro_in_lru(),
+ *              if the entry is still on the LRU lists.  The entry is
+ *              given its reference bit for the benefit of
+ *              H5C__make_space_in_cache().
+ *
+ *              As in H5C__protect_ro_in_lru(), only the entry's protect
+ *              fields are changed, with its ro_ref_count held.
+ *
+ * Return:      TRUE if the entry was unprotected, and FALSE if it has
+ *              been moved to the protected list, and must be handled by
+ *              the ordinary unprotect path.
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5C__unprotect_ro_in_lru(H5C_cache_entry_t *entry_ptr)
+{
+    int         ro_ref_count;           /* Read only protect count */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(entry_ptr);
+
+    ro_ref_count = H5C__lock_ro_ref_count(entry_ptr);
+
+    if(entry_ptr->ro_in_lru) {
+        /* Sanity checks */
+        HDassert(ro_ref_count > 0);
+        HDassert(entry_ptr->is_protected);
+        HDassert(entry_ptr->is_read_only);
+        HDassert(!entry_ptr->is_pinned);
+        HDassert(!entry_ptr->is_dirty);
+
+        if(--ro_ref_count == 0) {
+            entry_ptr->is_protected = FALSE;
+            entry_ptr->is_read_only = FALSE;
+            entry_ptr->ro_in_lru = FALSE;
+        } /* end if */
+        entry_ptr->lru_ref_bit = TRUE;
+
+        ret_value = TRUE;
+    } /* end if */
+
+    H5C__ATOMIC_STORE(&entry_ptr->ro_ref_count, ro_ref_count);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__unprotect_ro_in_lru() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__move_ro_in_lru_entry_to_pl()
+ *
+ * Purpose:     Move an entry that was protected read only while deferred
+ *              LRU updates were in effect from the LRU lists to the
+ *              protected list, so that it can be handled like any other
+ *              protected entry from then on.
+ *
+ *              This is done before such an entry is pinned or resized,
+ *              and before it is unprotected with flags that require the
+ *              full unprotect processing.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__move_ro_in_lru_entry_to_pl(H5C_t *cache_ptr, H5C_cache_entry_t *entry_ptr)
+{
+    int         ro_ref_count;           /* Saved read only ref count */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(entry_ptr);
+    HDassert(entry_ptr->ro_in_lru);
+    HDassert(entry_ptr->is_protected);
+    HDassert(entry_ptr->is_read_only);
+    HDassert(entry_ptr->ro_ref_count > 0);
+    HDassert(!entry_ptr->is_pinned);
+
+    /* H5C__UPDATE_RP_FOR_PROTECT expects an entry that is not protected
+     * yet, so hide the read only protect from it.
+     */
+    ro_ref_count = entry_ptr->ro_ref_count;
+    entry_ptr->is_protected = FALSE;
+    entry_ptr->is_read_only = FALSE;
+    entry_ptr->ro_ref_count = 0;
+
+    H5C__UPDATE_RP_FOR_PROTECT(cache_ptr, entry_ptr, FAIL)
+
+    entry_ptr->is_protected = TRUE;
+    entry_ptr->is_read_only = TRUE;
+    entry_ptr->ro_ref_count = ro_ref_count;
+    entry_ptr->ro_in_lru = FALSE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__move_ro_in_lru_entry_to_pl() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_unpin_entry()
+ *
+ * Purpose:	Unpin a cache entry.  The entry can be either protected or
+ * 		unprotected at the time of call, but must be pinned.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ * Programmer:  John Mainzer
+ *              3/22/06
+ *
+ * Changes:	Added extreme sanity checks on entry and exit.
+                				JRM -- 4/26/14 
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_unpin_entry(void *_entry_ptr)
+{
+    H5C_t             * cache_ptr;
+    H5C_cache_entry_t * entry_ptr = (H5C_cache_entry_t *)_entry_ptr; /* Pointer to entry to unpin */
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(entry_ptr);
+    cache_ptr = entry_ptr->cache_ptr;
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+#if H5C_DO_EXTREME_SANITY_CHECKS
+    if((H5C_validate_protected_entry_list(cache_ptr) < 0) ||
+            (H5C_validate_pinned_entry_list(cache_ptr) < 0) ||
+            (H5C_validate_lru_list(cache_ptr) < 0))
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "an extreme sanity check failed on entry")
+#endif /* H5C_DO_EXTREME_SANITY_CHECKS */
+
+
+    /* Unpin the entry */
+    if(H5C__unpin_entry_from_client(cache_ptr, entry_ptr, TRUE) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPIN, FAIL, "Can't unpin entry from client")
+
+done:
+#if H5C_DO_EXTREME_SANITY_CHECKS
+    if((H5C_validate_protected_entry_list(cache_ptr) < 0) ||
+            (H5C_validate_pinned_entry_list(cache_ptr) < 0) ||
+            (H5C_validate_lru_list(cache_ptr) < 0))
+        HDONE_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "an extreme sanity check failed on exit")
+#endif /* H5C_DO_EXTREME_SANITY_CHECKS */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_unpin_entry() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_unprotect
+ *
+ * Purpose:	Undo an H5C_protect() call -- specifically, mark the
+ *		entry as unprotected, remove it from the protected list,
+ *		and give it back to the replacement policy.
+ *
+ *		The TYPE and ADDR arguments must be the same as those in
+ *		the corresponding call to H5C_protect() and the THING
+ *		argument must be the value returned by that call to
+ *		H5C_protect().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *		If the deleted flag is TRUE, simply remove the target entry
+ *		from the cache, clear it, and free it without writing it to
+ *		disk.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ * Programmer:  John Mainzer
+ *              6/2/04
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_unprotect(H5F_t *f, haddr_t	addr, void *thing, unsigned flags)
+{
+    H5C_t *             cache_ptr;
+    hbool_t		deleted;
+    hbool_t		dirtied;
+    hbool_t             set_flush_marker;
+    hbool_t		pin_entry;
+    hbool_t		unpin_entry;
+    hbool_t		free_file_space;
+    hbool_t		take_ownership;
+    hbool_t 		was_clean;
+#ifdef H5_HAVE_PARALLEL
+    hbool_t		clear_entry = FALSE;
+#endif /* H5_HAVE_PARALLEL */
+    H5C_cache_entry_t *	entry_ptr;
+    H5C_cache_entry_t *	test_entry_ptr;
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    deleted                = ((flags & H5C__DELETED_FLAG) != 0);
+    dirtied                = ((flags & H5C__DIRTIED_FLAG) != 0);
+    set_flush_marker       = ((flags & H5C__SET_FLUSH_MARKER_FLAG) != 0);
+    pin_entry              = ((flags & H5C__PIN_ENTRY_FLAG) != 0);
+    unpin_entry            = ((flags & H5C__UNPIN_ENTRY_FLAG) != 0);
+    free_file_space        = ((flags & H5C__FREE_FILE_SPACE_FLAG) != 0);
+    take_ownership         = ((flags & H5C__TAKE_OWNERSHIP_FLAG) != 0);
+
+    HDassert( f );
+    HDassert( f->shared );
+
+    cache_ptr = f->shared->cache;
+
+    HDassert( cache_ptr );
+    HDassert( cache_ptr->magic == H5C__H5C_T_MAGIC );
+    HDassert( H5F_addr_defined(addr) );
+    HDassert( thing );
+    HDassert( ! ( pin_entry && unpin_entry ) );
+    HDassert( ( ! free_file_space ) || ( deleted ) );   /* deleted flag must accompany free_file_space */
+    HDassert( ( ! take_ownership ) || ( deleted ) );    /* deleted flag must accompany take_ownership */
+    HDassert( ! ( free_file_space && take_ownership ) );    /* can't have both free_file_space & take_ownership */
+
+    entry_ptr = (H5C_cache_entry_t *)thing;
+
+    HDassert( entry_ptr->addr == addr );
+
+    /* also set the dirtied variable if the dirtied field is set in
+     * the entry.
+     */
+    dirtied |= entry_ptr->dirtied;
+    was_clean = ! ( entry_ptr->is_dirty );
+
+#if H5C_DO_EXTREME_SANITY_CHECKS
+    if((H5C_validate_protected_entry_list(cache_ptr) < 0) ||
+            (H5C_validate_pinned_entry_list(cache_ptr) < 0) ||
+            (H5C_validate_lru_list(cache_ptr) < 0))
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "an extreme sanity check failed on entry")
+#endif /* H5C_DO_EXTREME_SANITY_CHECKS */
+
+    /* if the entry has multiple read only protects, just decrement
+     * the ro_ref_counter.  Don't actually unprotect until the ref count
+     * drops to zero.
+     */
+    if(!dirtied && !deleted && !pin_entry && !unpin_entry &&
+            H5C__unprotect_ro_in_lru(entry_ptr)) {
+        /* The entry never left the LRU lists, and neither the lists nor
+         * the statistics maintained below change.
+         */
+        HGOTO_DONE(SUCCEED)
+    } else if(entry_ptr->ro_ref_count > 1) {
+        /* Sanity check */
+	HDassert(entry_ptr->is_protected);
+        HDassert(entry_ptr->is_read_only);
+
+	if(dirtied)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPROTECT, FAIL, "Read only entry modified??")
+
+        /* Reduce the RO ref count */
+	(entry_ptr->ro_ref_count)--;
+
+        /* Pin or unpin the entry as requested. */
+        if(pin_entry) {
+            /* Pin the entry from a client */
+            if(H5C__pin_entry_from_client(cache_ptr, entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTPIN, FAIL, "Can't pin entry by client")
+        } else if(unpin_entry) {
+            /* Unpin the entry from a client */
+            if(H5C__unpin_entry_from_client(cache_ptr, entry_ptr, FALSE) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPIN, FAIL, "Can't unpin entry by client")
+        } /* end if */
+    } else {
+        if(entry_ptr->ro_in_lru)
+            if(H5C__move_ro_in_lru_entry_to_pl(cache_ptr, entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPROTECT, FAIL, "Can't move entry to protected list")
+
+	if(entry_ptr->is_read_only) {
+            /* Sanity check */
+	    HDassert(entry_ptr->ro_ref_count == 1);
+
+	    if(dirtied)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPROTECT, FAIL, "Read only entry modified??")
+
+	    entry_ptr->is_read_only = FALSE;
+	    entry_ptr->ro_ref_count = 0;
+	} /* end if */
+
+#ifdef H5_HAVE_PARALLEL
+        /* When the H5C code is used to implement the metadata cache in the
+         * PHDF5 case, only the cache on process 0 is allowed to write to file.
+         * All the other metadata caches must hold dirty entries until they
+         * are told that the entries are clean.
+         *
+         * The clear_on_unprotect flag in the H5C_cache_entry_t structure
+         * exists to deal with the case in which an entry is protected when
+         * its cache receives word that the entry is now clean.  In this case,
+         * the clear_on_unprotect flag is set, and the entry is flushed with
+         * the H5C__FLUSH_CLEAR_ONLY_FLAG.
+         *
+         * All this is a bit awkward, but until the metadata cache entries
+         * are contiguous, with only one dirty flag, we have to let the supplied
+         * functions deal with the reseting the is_dirty flag.
+         */
+        if(entry_ptr->clear_on_unprotect) {
+            /* Sanity check */
+            HDassert(entry_ptr->is_dirty);
+
+            entry_ptr->clear_on_unprotect = FALSE;
+            if(!dirtied)
+                clear_entry = TRUE;
+        } /* end if */
+#endif /* H5_HAVE_PARALLEL */
+
+        if(!entry_ptr->is_protected)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTUNPROTECT, FAIL, "Entry already unprotected??")
+
+        /* Mark the entry as dirty if appropriate */
+        entry_ptr->is_dirty = (entry_ptr->is_dirty || dirtied);
+
+	if(dirtied)
+	    if(entry_ptr->image_up_to_date) {
+	        entry_ptr->image_up_to_date = FALSE;
+	        if(entry_ptr->flush_dep_nparents > 0)
+		    if(H5C__mark_flush_dep_unserialized(entry_ptr) < 0)
+                        HGOTO_ERROR(H5E_CACHE, H5E_CANTNOTIFY, FAIL, "Can't propagate serialization status to fd parents")
+            } /* end if */
+
+        /* Check for newly dirtied entry */
+        if(was_clean && entry_ptr->is_dirty) {
+            /* Update index for newly dirtied entry */
+            H5C__UPDATE_INDEX_FOR_ENTRY_DIRTY(cache_ptr, entry_ptr)
+
+            /* If the entry's type has a 'notify' callback send a 'entry dirtied'
+             * notice now that the entry is fully integrated into the cache.
+             */
+            if(entry_ptr->type->notify &&
+                    (entry_ptr->type->notify)(H5C_NOTIFY_ACTION_ENTRY_DIRTIED, entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTNOTIFY, FAIL, "can't notify client about entry dirty flag set")
+
+            /* Propagate the flush dep dirty flag up the flush dependency chain
+             * if appropriate */
+            if(entry_ptr->flush_dep_nparents > 0)
+                if(H5C__mark_flush_dep_dirty(entry_ptr) < 0)
+                    HGOTO_ERROR(H5E_CACHE, H5E_CANTMARKDIRTY, FAIL, "Can't propagate flush dep dirty flag")
+        } /* end if */ 
         /* Check for newly clean entry */
         else if(!was_clean && !entry_ptr->is_dirty) {
             /* If the entry's type has a 'notify' callback send a 'entry cleaned'
@@ -3613,6 +4191,11 @@ H5C_create_flush_dependency(void * parent_thing, void * child_thing)
         HDassert(!parent_entry->pinned_from_client);
         HDassert(!parent_entry->pinned_from_cache);
 
+        /* Pinned entries can't stay on the LRU list while protected */
+        if(parent_entry->ro_in_lru)
+            if(H5C__move_ro_in_lru_entry_to_pl(cache_ptr, parent_entry) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTPIN, FAIL, "Can't move parent entry to protected list")
+
         /* Pin the parent entry */
         parent_entry->is_pinned = TRUE;
         H5C__UPDATE_STATS_FOR_PIN(cache_ptr, parent_entry)
@@ -3825,13 +4408,8 @@ done:
  *
  *-------------------------------------------------------------------------
  */
-#if H5C_COLLECT_CACHE_STATS
 static herr_t
 H5C__pin_entry_from_client(H5C_t *cache_ptr, H5C_cache_entry_t *entry_ptr)
-#else
-static herr_t
-H5C__pin_entry_from_client(H5C_t H5_ATTR_UNUSED *cache_ptr, H5C_cache_entry_t *entry_ptr)
-#endif
 {
     herr_t ret_value = SUCCEED;    /* Return value */
 
@@ -3849,6 +4427,11 @@ H5C__pin_entry_from_client(H5C_t H5_ATTR_UNUSED *cache_ptr, H5C_cache_entry_t *e
             HGOTO_ERROR(H5E_CACHE, H5E_CANTPIN, FAIL, "entry is already pinned")
     } /* end if */
     else {
+        /* Pinned entries can't stay on the LRU list while protected */
+        if(entry_ptr->ro_in_lru)
+            if(H5C__move_ro_in_lru_entry_to_pl(cache_ptr, entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTPIN, FAIL, "Can't move entry to protected list")
+
         entry_ptr->is_pinned = TRUE;
 
         H5C__UPDATE_STATS_FOR_PIN(cache_ptr, entry_ptr)
@@ -4424,15 +5007,10 @@ H5C__autoadjust__ageout__cycle_epoch_marker(H5C_t * cache_ptr)
     if((cache_ptr->epoch_marker_active)[i] != TRUE)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "unused marker in LRU?!?")
 
-    H5C__DLL_REMOVE((&((cache_ptr->epoch_markers)[i])), \
-                    (cache_ptr)->LRU_head_ptr, \
-                    (cache_ptr)->LRU_tail_ptr, \
-                    (cache_ptr)->LRU_list_len, \
-                    (cache_ptr)->LRU_list_size, \
-                    (FAIL))
+    H5C__RP_LRU_REMOVE(cache_ptr, (&((cache_ptr->epoch_markers)[i])), FAIL)
 
-    /* now, re-insert it at the head of the LRU list, and at the tail of
-     * the ring buffer.
+    /* now, re-insert it at the head of the LRU list (or of its cold
+     * segment under the 2Q policy), and at the tail of the ring buffer.
      */
 
     HDassert(((cache_ptr->epoch_markers)[i]).addr == (haddr_t)i);
@@ -4450,12 +5028,7 @@ H5C__autoadjust__ageout__cycle_epoch_marker(H5C_t * cache_ptr)
     if(cache_ptr->epoch_marker_ringbuf_size > H5C__MAX_EPOCH_MARKERS)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "ring buffer overflow")
 
-    H5C__DLL_PREPEND((&((cache_ptr->epoch_markers)[i])), \
-                     (cache_ptr)->LRU_head_ptr, \
-                     (cache_ptr)->LRU_tail_ptr, \
-                     (cache_ptr)->LRU_list_len, \
-                     (cache_ptr)->LRU_list_size, \
-                     (FAIL))
+    H5C__RP_LRU_INSERT(cache_ptr, (&((cache_ptr->epoch_markers)[i])), FAIL)
 done:
 
     FUNC_LEAVE_NOAPI(ret_value)
@@ -4509,6 +5082,7 @@ H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t *f, hbool_t write_permitte
     size_t		eviction_size_limit;
     size_t		bytes_evicted = 0;
     hbool_t		prev_is_dirty = FALSE;
+    hbool_t		prev_is_protected = FALSE;
     hbool_t             restart_scan;
     H5C_cache_entry_t * entry_ptr;
     H5C_cache_entry_t * next_ptr;
@@ -4548,17 +5122,29 @@ H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t *f, hbool_t write_permitte
             hbool_t skipping_entry = FALSE;
 
             HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
-            HDassert( ! (entry_ptr->is_protected) );
-            HDassert( ! (entry_ptr->is_read_only) );
-            HDassert( (entry_ptr->ro_ref_count) == 0 );
+            HDassert( ( ! (entry_ptr->is_protected) ) ||
+                      ( entry_ptr->ro_in_lru ) );
 
 	    next_ptr = entry_ptr->next;
             prev_ptr = entry_ptr->prev;
 
-	    if(prev_ptr != NULL)
+	    if(prev_ptr != NULL) {
                 prev_is_dirty = prev_ptr->is_dirty;
+                prev_is_protected = prev_ptr->is_protected;
+            } /* end if */
 
-            if(entry_ptr->is_dirty ) {
+            if(entry_ptr->is_protected)
+                /* protected read only without leaving the LRU list */
+                skipping_entry = TRUE;
+            else if(entry_ptr->lru_ref_bit) {
+                /* used since it was last placed at the head of the LRU
+                 * list -- put it back there instead of evicting it.
+                 */
+                entry_ptr->lru_ref_bit = FALSE;
+                H5C__FAKE_RP_FOR_MOST_RECENT_ACCESS(cache_ptr, entry_ptr, FAIL)
+                skipping_entry = TRUE;
+            } /* end else-if */
+            else if(entry_ptr->is_dirty ) {
                 HDassert(!entry_ptr->prefetched_dirty);
 
                 /* dirty corked entry is skipped */
@@ -4602,7 +5188,7 @@ H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t *f, hbool_t write_permitte
                     entry_ptr = prev_ptr;
 		else if(restart_scan || (prev_ptr->is_dirty != prev_is_dirty)
                           || (prev_ptr->next != next_ptr)
-                          || (prev_ptr->is_protected)
+                          || (prev_ptr->is_protected != prev_is_protected)
                           || (prev_ptr->is_pinned)) {
                     /* Something has happened to the LRU -- start over
 		     * from the tail.
@@ -4654,11 +5240,19 @@ H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t *f, hbool_t write_permitte
         while(entry_ptr != NULL &&
                 ((entry_ptr->type)->id != H5AC_EPOCH_MARKER_ID) &&
                 (bytes_evicted < eviction_size_limit)) {
-            HDassert(!(entry_ptr->is_protected));
+            HDassert(!(entry_ptr->is_protected) || entry_ptr->ro_in_lru);
 
             prev_ptr = entry_ptr->prev;
 
-            if(!(entry_ptr->is_dirty) && !(entry_ptr->prefetched_dirty))
+            if(entry_ptr->is_protected) {
+                /* protected read only without leaving the LRU list -- skip it */
+            } /* end if */
+            else if(entry_ptr->lru_ref_bit) {
+                /* used since it was last placed at the head of the LRU list */
+                entry_ptr->lru_ref_bit = FALSE;
+                H5C__FAKE_RP_FOR_MOST_RECENT_ACCESS(cache_ptr, entry_ptr, FAIL)
+            } /* end else-if */
+            else if(!(entry_ptr->is_dirty) && !(entry_ptr->prefetched_dirty))
                 if(H5C__flush_single_entry(f, entry_ptr, H5C__FLUSH_INVALIDATE_FLAG | H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG) < 0)
                     HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "unable to flush clean entry")
 
@@ -4736,12 +5330,7 @@ H5C__autoadjust__ageout__insert_new_marker(H5C_t * cache_ptr)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "ring buffer overflow")
     }
 
-    H5C__DLL_PREPEND((&((cache_ptr->epoch_markers)[i])), \
-                     (cache_ptr)->LRU_head_ptr, \
-                     (cache_ptr)->LRU_tail_ptr, \
-                     (cache_ptr)->LRU_list_len, \
-                     (cache_ptr)->LRU_list_size, \
-                     (FAIL))
+    H5C__RP_LRU_INSERT(cache_ptr, (&((cache_ptr->epoch_markers)[i])), FAIL)
 
     cache_ptr->epoch_markers_active += 1;
 
@@ -4799,12 +5388,7 @@ H5C__autoadjust__ageout__remove_all_markers(H5C_t * cache_ptr)
             HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "unused marker in LRU?!?")
 
         /* remove the epoch marker from the LRU list */
-        H5C__DLL_REMOVE((&((cache_ptr->epoch_markers)[i])), \
-                        (cache_ptr)->LRU_head_ptr, \
-                        (cache_ptr)->LRU_tail_ptr, \
-                        (cache_ptr)->LRU_list_len, \
-                        (cache_ptr)->LRU_list_size, \
-                        (FAIL))
+        H5C__RP_LRU_REMOVE(cache_ptr, (&((cache_ptr->epoch_markers)[i])), FAIL)
 
         /* mark the epoch marker as unused. */
         (cache_ptr->epoch_marker_active)[i] = FALSE;
@@ -4877,12 +5461,7 @@ H5C__autoadjust__ageout__remove_excess_markers(H5C_t * cache_ptr)
             HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "unused marker in LRU?!?")
 
         /* remove the epoch marker from the LRU list */
-        H5C__DLL_REMOVE((&((cache_ptr->epoch_markers)[i])), \
-                        (cache_ptr)->LRU_head_ptr, \
-                        (cache_ptr)->LRU_tail_ptr, \
-                        (cache_ptr)->LRU_list_len, \
-                        (cache_ptr)->LRU_list_size, \
-                        (FAIL))
+        H5C__RP_LRU_REMOVE(cache_ptr, (&((cache_ptr->epoch_markers)[i])), FAIL)
 
         /* mark the epoch marker as unused. */
         (cache_ptr->epoch_marker_active)[i] = FALSE;
@@ -5681,6 +6260,11 @@ H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags)
     hbool_t		ignore_protected;
     hbool_t		tried_to_flush_protected_entry = FALSE;
     hbool_t		restart_slist_scan;
+#ifdef H5C_HAVE_SERIALIZE_THREADS
+    unsigned            nthreads = H5F_get_mdc_flush_threads(f);
+#endif /* H5C_HAVE_SERIALIZE_THREADS */
+    hbool_t             gather_writes;
+    H5C_write_gather_t  gather;
     uint32_t		protected_entries = 0;
     H5SL_node_t * 	node_ptr = NULL;
     H5C_cache_entry_t *	entry_ptr = NULL;
@@ -5717,6 +6301,27 @@ H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags)
 
     HDassert(cache_ptr->flush_in_progress);
 
+    /* Images of entries which are adjacent in the file are gathered and
+     * written together, unless something below the cache depends on
+     * seeing each entry's write: the page buffer, which caches metadata
+     * in pages, SWMR writers, which order writes for SWMR readers, or a
+     * cache image being built, which may suppress entries' writes.  In
+     * the parallel case entries are written collectively instead.
+     *
+     * Drivers which accumulate metadata already merge adjacent writes,
+     * so gathering them here would only copy the images once more.
+     */
+    gather_writes = ((flags & H5C__FLUSH_CLEAR_ONLY_FLAG) == 0)
+            && !H5F_HAS_FEATURE(f, H5FD_FEAT_ACCUMULATE_METADATA)
+            && (NULL == f->shared->page_buf)
+            && ((H5F_INTENT(f) & H5F_ACC_SWMR_WRITE) == 0)
+            && !cache_ptr->image_ctl.generate_image;
+#ifdef H5_HAVE_PARALLEL
+    if(cache_ptr->aux_ptr)
+        gather_writes = FALSE;
+#endif /* H5_HAVE_PARALLEL */
+    HDmemset(&gather, 0, sizeof(gather));
+
     /* When we are only flushing marked entries, the slist will usually
      * still contain entries when we have flushed everything we should.
      * Thus we track whether we have flushed any entries in the last
@@ -5776,7 +6381,17 @@ H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags)
          * expected slist length and size and compare this with the
          * value recorded in the cache's instance of H5C_t.
          */
-#endif /* H5C_DO_SANITY_CHECKS */
+#endif /* H5C_DO_SANITY_CHECKS */
+
+#ifdef H5C_HAVE_SERIALIZE_THREADS
+        /* Serialize the entries this pass is able to flush so far on
+         * several threads, if the file asks for that, leaving them to
+         * be written below
+         */
+        if(nthreads > 1 && (flags & H5C__FLUSH_CLEAR_ONLY_FLAG) == 0)
+            if(H5C__serialize_entries_threads(f, ring, flush_marked_entries, nthreads) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTSERIALIZE, FAIL, "can't serialize entries")
+#endif /* H5C_HAVE_SERIALIZE_THREADS */
 
         restart_slist_scan = TRUE;
 
@@ -5868,7 +6483,13 @@ H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags)
                     protected_entries++;
                 } /* end if */
                 else {
-                    if(H5C__flush_single_entry(f, entry_ptr, (flags | H5C__DURING_FLUSH_FLAG)) < 0)
+                    if(gather_writes && next_entry_ptr
+                            && (entry_ptr->image_up_to_date || NULL == entry_ptr->type->pre_serialize)
+                            && H5C__can_gather_entry(entry_ptr, next_entry_ptr, ring, flush_marked_entries)) {
+                        if(H5C__flush_gathered_entries(f, &gather, entry_ptr, &node_ptr, &next_entry_ptr, ring, flags, flush_marked_entries) < 0)
+                            HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't flush entries")
+                    } /* end if */
+                    else if(H5C__flush_single_entry(f, entry_ptr, (flags | H5C__DURING_FLUSH_FLAG)) < 0)
                         HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't flush entry")
 
                     if(cache_ptr->slist_changed) {
@@ -5909,9 +6530,528 @@ H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags)
 #endif /* H5C_DO_SANITY_CHECKS */
 
 done:
+    gather.buf = (uint8_t *)H5MM_xfree(gather.buf);
+    gather.entries = (H5C_cache_entry_t **)H5MM_xfree(gather.entries);
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__flush_ring() */
 
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__can_gather_entry
+ *
+ * Purpose:     Determines whether the image of an entry which follows
+ *		PREV_PTR in the slist can be written along with it by
+ *		H5C__flush_gathered_entries(): it must be one that
+ *		H5C__flush_ring() would flush now, be of the same type and
+ *		start where the previous entry ends in the file, and be
+ *		serialized without a pre-serialize callback (which may move
+ *		or resize entries) if its image is out of date.
+ *
+ * Return:      TRUE if the entry can be gathered, FALSE if not
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5C__can_gather_entry(const H5C_cache_entry_t *prev_ptr,
+    const H5C_cache_entry_t *entry_ptr, H5C_ring_t ring,
+    hbool_t flush_marked_entries)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(prev_ptr);
+    HDassert(entry_ptr);
+    HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
+    HDassert(entry_ptr->is_dirty);
+
+    FUNC_LEAVE_NOAPI(entry_ptr->ring == ring
+            && H5F_addr_eq(prev_ptr->addr + prev_ptr->size, entry_ptr->addr)
+            && (!flush_marked_entries || entry_ptr->flush_marker)
+            && !entry_ptr->flush_me_last
+            && (entry_ptr->flush_dep_nchildren == 0 || entry_ptr->flush_dep_ndirty_children == 0)
+            && !entry_ptr->is_protected
+            && !entry_ptr->prefetched && !prev_ptr->prefetched
+            && ((entry_ptr->type->flags | prev_ptr->type->flags) & H5C__CLASS_SKIP_WRITES) == 0
+            && (entry_ptr->image_up_to_date || NULL == entry_ptr->type->pre_serialize)
+            && entry_ptr->type->mem_type == prev_ptr->type->mem_type)
+} /* H5C__can_gather_entry() */
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__flush_gathered_entries
+ *
+ * Purpose:     Flushes the entry ENTRY_PTR along with the entries after
+ *		it in the slist which can be written with it (see
+ *		H5C__can_gather_entry()), gathering their images into one
+ *		buffer which is written to the file at once.  The entries
+ *		are then flushed one by one, as H5C__flush_ring() would
+ *		have, except for their writes.
+ *
+ *		*NODE_PTR_PTR and *NEXT_ENTRY_PTR_PTR are advanced past
+ *		the entries gathered.  If serializing or flushing them
+ *		changes the slist otherwise, the entries left are left
+ *		dirty to be written again, and the caller must restart its
+ *		scan of the slist, as it does after flushing single
+ *		entries.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__flush_gathered_entries(H5F_t *f, H5C_write_gather_t *gather,
+    H5C_cache_entry_t *entry_ptr, H5SL_node_t **node_ptr_ptr,
+    H5C_cache_entry_t **next_entry_ptr_ptr, H5C_ring_t ring, unsigned flags,
+    hbool_t flush_marked_entries)
+{
+    H5C_t              *cache_ptr = f->shared->cache;
+    H5C_cache_entry_t  *prev_ptr;       /* Last entry gathered */
+    size_t              nentries = 0;   /* # of entries gathered */
+    size_t              nbytes = 0;     /* Size of the entries gathered */
+    size_t              u;              /* Local index variable */
+    herr_t              ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(gather);
+    HDassert(entry_ptr);
+    HDassert(node_ptr_ptr);
+    HDassert(next_entry_ptr_ptr);
+
+    /* Gather the entries, serializing the ones which need it.  Stop at
+     * the first entry which can't be gathered, which would make the
+     * write too large, or if serializing an entry changes the slist.
+     */
+    prev_ptr = NULL;
+    while(entry_ptr) {
+        if(prev_ptr) {
+            if(!H5C__can_gather_entry(prev_ptr, entry_ptr, ring, flush_marked_entries)
+                    || nbytes + entry_ptr->size > H5C_WRITE_GATHER_MAX_SIZE)
+                break;
+        } /* end if */
+
+        if(!entry_ptr->image_up_to_date) {
+            HDassert(NULL == prev_ptr || NULL == entry_ptr->type->pre_serialize);
+
+            if(NULL == entry_ptr->image_ptr) {
+                if(NULL == (entry_ptr->image_ptr = H5MM_malloc(entry_ptr->size + H5C_IMAGE_EXTRA_SPACE)))
+                    HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for on disk image buffer")
+#if H5C_DO_MEMORY_SANITY_CHECKS
+                HDmemcpy(((uint8_t *)entry_ptr->image_ptr) + entry_ptr->size, H5C_IMAGE_SANITY_VALUE, H5C_IMAGE_EXTRA_SPACE);
+#endif /* H5C_DO_MEMORY_SANITY_CHECKS */
+            } /* end if */
+
+            if(H5C__generate_image(f, cache_ptr, entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTGET, FAIL, "can't generate entry's image")
+
+            /* Entries after this one may have changed -- leave them to
+             * be flushed by the caller once it restarts its scan.
+             */
+            if(cache_ptr->slist_changed && prev_ptr)
+                break;
+        } /* end if */
+
+        if(nentries == gather->entries_alloc) {
+            H5C_cache_entry_t **new_entries;
+            size_t new_alloc = MAX(2 * gather->entries_alloc, 64);
+
+            if(NULL == (new_entries = (H5C_cache_entry_t **)H5MM_realloc(gather->entries, new_alloc * sizeof(H5C_cache_entry_t *))))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for entries to write")
+            gather->entries = new_entries;
+            gather->entries_alloc = new_alloc;
+        } /* end if */
+        gather->entries[nentries++] = entry_ptr;
+        nbytes += entry_ptr->size;
+        prev_ptr = entry_ptr;
+
+        /* The first entry is flushed alone if serializing it changed
+         * the slist, or it's already in the caller's hands
+         */
+        if(cache_ptr->slist_changed)
+            break;
+
+        /* Advance to the next entry */
+        if(nentries > 1) {
+            *node_ptr_ptr = H5SL_next(*node_ptr_ptr);
+            *next_entry_ptr_ptr = *node_ptr_ptr ? (H5C_cache_entry_t *)H5SL_item(*node_ptr_ptr) : NULL;
+        } /* end if */
+        entry_ptr = *next_entry_ptr_ptr;
+    } /* end while */
+    HDassert(nentries > 0);
+
+    /* Write the entries' images at once */
+    if(nentries > 1) {
+        uint8_t *p;                     /* Pointer into gather buffer */
+
+        if(nbytes > gather->buf_size) {
+            uint8_t *new_buf;
+
+            if(NULL == (new_buf = (uint8_t *)H5MM_realloc(gather->buf, nbytes)))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for gathered images")
+            gather->buf = new_buf;
+            gather->buf_size = nbytes;
+        } /* end if */
+
+        for(u = 0, p = gather->buf; u < nentries; u++) {
+            HDmemcpy(p, gather->entries[u]->image_ptr, gather->entries[u]->size);
+            p += gather->entries[u]->size;
+        } /* end for */
+
+        if(H5F_block_write(f, gather->entries[0]->type->mem_type, gather->entries[0]->addr, nbytes, gather->buf) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't write images to file")
+    } /* end if */
+
+    /* Flush the entries, except for their writes.  If the slist changes,
+     * the entries left may have too -- leave them to be written again.
+     */
+    for(u = 0; u < nentries; u++) {
+        H5C_cache_entry_t *gathered_ptr = gather->entries[u];
+        unsigned gathered_flags = flags | H5C__DURING_FLUSH_FLAG;
+
+        if(u > 0 && cache_ptr->slist_changed)
+            break;
+
+        if(nentries > 1 && gathered_ptr->image_up_to_date)
+            gathered_flags |= H5C__IMAGE_WRITTEN_FLAG;
+        if(H5C__flush_single_entry(f, gathered_ptr, gathered_flags) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't flush entry")
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__flush_gathered_entries() */
+
+#ifdef H5C_HAVE_SERIALIZE_THREADS
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__serialize_entries_threads
+ *
+ * Purpose:     Serializes the dirty entries in the specified ring which
+ *		H5C__flush_ring() could flush now, and whose classes allow
+ *		it (see H5C__CLASS_THREADED_SERIALIZE_FLAG), using up to
+ *		NTHREADS threads (including the calling thread) at once.
+ *
+ *		The entries are only encoded into their images and left
+ *		dirty in the slist, as in H5C__generate_image(), so they
+ *		are still written by H5C__flush_single_entry(), in address
+ *		order.  Entries with flush dependency children which are
+ *		unserialized are left alone -- they are serialized as
+ *		before once their children have been.
+ *
+ *		The helper threads are kept for later flushes, and the
+ *		errors of entries which failed on them are pushed on the
+ *		calling thread's error stack.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__serialize_entries_threads(H5F_t *f, H5C_ring_t ring,
+    hbool_t flush_marked_entries, unsigned nthreads)
+{
+    H5C_t              *cache_ptr = f->shared->cache;
+    H5C_serialize_work_t work;          /* Work shared by the threads */
+    H5C_serialize_job_t *jobs = NULL;   /* Entries to serialize */
+    size_t              njobs = 0;      /* # of entries to serialize */
+    size_t              jobs_alloc = 0; /* # of entries allocated in 'jobs' */
+    H5C_serialize_pool_t *pool = &H5C_serialize_pool_g;
+    hbool_t             failed = FALSE; /* Whether any entry failed */
+    H5SL_node_t        *node_ptr;
+    size_t              u;              /* Local index variable */
+    herr_t              ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->slist_ptr);
+    HDassert(nthreads > 1);
+
+    /* Gather the entries to serialize, allocating their image buffers */
+    for(node_ptr = H5SL_first(cache_ptr->slist_ptr); node_ptr != NULL; node_ptr = H5SL_next(node_ptr)) {
+        H5C_cache_entry_t *entry_ptr = (H5C_cache_entry_t *)H5SL_item(node_ptr);
+
+        HDassert(entry_ptr);
+        HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
+        HDassert(entry_ptr->is_dirty);
+
+        if(entry_ptr->ring != ring || entry_ptr->image_up_to_date
+                || entry_ptr->is_protected || entry_ptr->prefetched
+                || entry_ptr->flush_me_last
+                || (flush_marked_entries && !entry_ptr->flush_marker)
+                || entry_ptr->flush_dep_nunser_children > 0
+                || (entry_ptr->type->flags & H5C__CLASS_THREADED_SERIALIZE_FLAG) == 0
+                || entry_ptr->type->pre_serialize)
+            continue;
+
+        if(njobs == jobs_alloc) {
+            H5C_serialize_job_t *new_jobs;
+
+            jobs_alloc = MAX(2 * jobs_alloc, 256);
+            if(NULL == (new_jobs = (H5C_serialize_job_t *)H5MM_realloc(jobs, jobs_alloc * sizeof(H5C_serialize_job_t))))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for entries to serialize")
+            jobs = new_jobs;
+        } /* end if */
+
+        if(NULL == entry_ptr->image_ptr) {
+            if(NULL == (entry_ptr->image_ptr = H5MM_malloc(entry_ptr->size + H5C_IMAGE_EXTRA_SPACE)))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for on disk image buffer")
+#if H5C_DO_MEMORY_SANITY_CHECKS
+            HDmemcpy(((uint8_t *)entry_ptr->image_ptr) + entry_ptr->size, H5C_IMAGE_SANITY_VALUE, H5C_IMAGE_EXTRA_SPACE);
+#endif /* H5C_DO_MEMORY_SANITY_CHECKS */
+        } /* end if */
+
+        jobs[njobs].entry_ptr = entry_ptr;
+        jobs[njobs].status = FAIL;
+        jobs[njobs].errors = NULL;
+        njobs++;
+    } /* end for */
+
+    /* Too few entries aren't worth starting threads for -- they are
+     * serialized by H5C__flush_single_entry() as usual
+     */
+    if(njobs <= H5C_SERIALIZE_THREAD_NENTRIES)
+        HGOTO_DONE(SUCCEED)
+
+    /* Don't start more threads than there are entries to share */
+    if((size_t)nthreads > njobs / H5C_SERIALIZE_THREAD_NENTRIES)
+        nthreads = (unsigned)(njobs / H5C_SERIALIZE_THREAD_NENTRIES);
+
+    H5C__serialize_pool_grow(nthreads - 1);
+
+    work.f = f;
+    work.njobs = njobs;
+    work.jobs = jobs;
+    work.next = 0;
+    work.nhelpers = MIN(nthreads - 1, pool->nthreads);
+    work.nactive = 0;
+
+    /* Hand the work to the helpers, serialize entries on this thread too,
+     * then wait for the helpers which joined
+     */
+    pthread_mutex_lock(&pool->lock);
+    pool->work = &work;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    H5C__serialize_entries_run(&work, FALSE);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->work = NULL;
+    while(work.nactive > 0)
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+
+    /* Check for entries which failed, reporting the errors of the ones
+     * which failed on helper threads
+     */
+    for(u = 0; u < njobs; u++)
+        if(jobs[u].status < 0) {
+            if(jobs[u].errors) {
+                (void)H5E_push_helper_errors(jobs[u].errors);
+                jobs[u].errors = NULL;
+            } /* end if */
+            failed = TRUE;
+        } /* end if */
+    if(failed)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "unable to serialize entry")
+
+    /* Finish off the entries serialized, in order, as
+     * H5C__generate_image() would have
+     */
+    for(u = 0; u < njobs; u++) {
+        H5C_cache_entry_t *entry_ptr = jobs[u].entry_ptr;
+
+#if H5C_DO_MEMORY_SANITY_CHECKS
+        HDassert(0 == HDmemcmp(((uint8_t *)entry_ptr->image_ptr) + entry_ptr->size, H5C_IMAGE_SANITY_VALUE, H5C_IMAGE_EXTRA_SPACE));
+#endif /* H5C_DO_MEMORY_SANITY_CHECKS */
+        entry_ptr->image_up_to_date = TRUE;
+
+        if(entry_ptr->flush_dep_nparents > 0)
+            if(H5C__mark_flush_dep_serialized(entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTNOTIFY, FAIL, "Can't propagate serialization status to fd parents")
+    } /* end for */
+
+done:
+    jobs = (H5C_serialize_job_t *)H5MM_xfree(jobs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__serialize_entries_threads() */
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__serialize_entries_run
+ *
+ * Purpose:     Takes entries from the work shared by the threads of
+ *		H5C__serialize_entries_threads() and calls their classes'
+ *		serialize callbacks until none are left.  A helper thread
+ *		hands the errors of an entry which failed back in the
+ *		entry's job, for the calling thread to report.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5C__serialize_entries_run(H5C_serialize_work_t *work, hbool_t helper)
+{
+    size_t      start, end;             /* Range of entries taken */
+    size_t      u;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(;;) {
+        /* Take the next few entries */
+        pthread_mutex_lock(&H5C_serialize_pool_g.lock);
+        start = work->next;
+        end = MIN(start + H5C_SERIALIZE_THREAD_NENTRIES, work->njobs);
+        work->next = end;
+        pthread_mutex_unlock(&H5C_serialize_pool_g.lock);
+        if(start >= end)
+            break;
+
+        for(u = start; u < end; u++) {
+            H5C_serialize_job_t *job = &work->jobs[u];
+            H5C_cache_entry_t *entry_ptr = job->entry_ptr;
+
+            job->status = entry_ptr->type->serialize(work->f,
+                    entry_ptr->image_ptr, entry_ptr->size, (void *)entry_ptr);
+            if(job->status < 0 && helper)
+                job->errors = H5E_take_helper_errors();
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C__serialize_entries_run() */
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__serialize_entries_helper
+ *
+ * Purpose:     Entry point of the helper threads of
+ *		H5C__serialize_entries_threads().  Waits for work and
+ *		helps with it, until the pool of helper threads is
+ *		stopped.
+ *
+ * Return:      NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5C__serialize_entries_helper(void *_pool)
+{
+    H5C_serialize_pool_t *pool = (H5C_serialize_pool_t *)_pool;
+
+    /* Keep errors for the calling thread to report */
+    H5E_init_helper_stack();
+
+    pthread_mutex_lock(&pool->lock);
+    for(;;) {
+        H5C_serialize_work_t *work;     /* Work to help with */
+
+        while(!pool->shutdown && (NULL == pool->work || 0 == pool->work->nhelpers))
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+        if(pool->shutdown)
+            break;
+
+        /* Join the work */
+        work = pool->work;
+        work->nhelpers--;
+        work->nactive++;
+        pthread_mutex_unlock(&pool->lock);
+
+        H5C__serialize_entries_run(work, TRUE);
+
+        pthread_mutex_lock(&pool->lock);
+        if(0 == --work->nactive)
+            pthread_cond_signal(&pool->done_cond);
+    } /* end for */
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+} /* H5C__serialize_entries_helper() */
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__serialize_pool_grow
+ *
+ * Purpose:     Starts helper threads for H5C__serialize_entries_threads()
+ *		until there are NTHREADS of them.  When threads can't be
+ *		started, the ones already started are used.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5C__serialize_pool_grow(unsigned nthreads)
+{
+    H5C_serialize_pool_t *pool = &H5C_serialize_pool_g;
+    pthread_t  *threads;                /* Reallocated array of threads */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(nthreads > pool->nthreads
+            && NULL != (threads = (pthread_t *)H5MM_realloc(pool->threads, sizeof(pthread_t) * nthreads))) {
+        pool->threads = threads;
+        while(pool->nthreads < nthreads
+                && 0 == pthread_create(&pool->threads[pool->nthreads], NULL, H5C__serialize_entries_helper, pool))
+            pool->nthreads++;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C__serialize_pool_grow() */
+#endif /* H5C_HAVE_SERIALIZE_THREADS */
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C_stop_serialize_threads
+ *
+ * Purpose:     Stops the helper threads which serialize entries when the
+ *		cache is flushed.  They're started again the next time
+ *		they're needed.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5C_stop_serialize_threads(void)
+{
+#ifdef H5C_HAVE_SERIALIZE_THREADS
+    H5C_serialize_pool_t *pool = &H5C_serialize_pool_g;
+    unsigned    u;                      /* Local index variable */
+#endif /* H5C_HAVE_SERIALIZE_THREADS */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5C_HAVE_SERIALIZE_THREADS
+    if(pool->nthreads > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pool->shutdown = TRUE;
+        pthread_cond_broadcast(&pool->work_cond);
+        pthread_mutex_unlock(&pool->lock);
+        for(u = 0; u < pool->nthreads; u++)
+            pthread_join(pool->threads[u], NULL);
+        pool->nthreads = 0;
+        pool->shutdown = FALSE;
+    } /* end if */
+    pool->threads = (pthread_t *)H5MM_xfree(pool->threads);
+#endif /* H5C_HAVE_SERIALIZE_THREADS */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C_stop_serialize_threads() */
+
 
 /*-------------------------------------------------------------------------
  *
@@ -5960,6 +7100,7 @@ H5C__flush_single_entry(H5F_t *f, H5C_cache_entry_t *entry_ptr, unsigned flags)
     hbool_t		destroy_entry;		/* internal flag */
     hbool_t		generate_image;		/* internal flag */
     hbool_t		update_page_buffer;	/* internal flag */
+    hbool_t		image_written;		/* external flag */
     hbool_t		was_dirty;
     hbool_t		suppress_image_entry_writes = FALSE;
     hbool_t		suppress_image_entry_frees = FALSE;
@@ -5986,6 +7127,7 @@ H5C__flush_single_entry(H5F_t *f, H5C_cache_entry_t *entry_ptr, unsigned flags)
     during_flush           = ((flags & H5C__DURING_FLUSH_FLAG) != 0);
     generate_image         = ((flags & H5C__GENERATE_IMAGE_FLAG) != 0);
     update_page_buffer     = ((flags & H5C__UPDATE_PAGE_BUFFER_FLAG) != 0);
+    image_written          = ((flags & H5C__IMAGE_WRITTEN_FLAG) != 0);
 
     /* Set the flag for destroying the entry, based on the 'take ownership'
      * and 'destroy' flags
@@ -6106,8 +7248,13 @@ H5C__flush_single_entry(H5F_t *f, H5C_cache_entry_t *entry_ptr, unsigned flags)
          * entry_ptr->include_in_image are TRUE, or if the 
          * H5AC__CLASS_SKIP_WRITES is set in the entry's type.  This
          * flag should only be used in test code
+         *
+         * The image has already been written if H5C__flush_ring()
+         * wrote it along with the entries around it.
          */
-        if((!suppress_image_entry_writes || !entry_ptr->include_in_image)
+        HDassert(!image_written || entry_ptr->image_up_to_date);
+        if(!image_written
+                && (!suppress_image_entry_writes || !entry_ptr->include_in_image)
                 && (((entry_ptr->type->flags) & H5C__CLASS_SKIP_WRITES) == 0)) {
             H5FD_mem_t mem_type = H5FD_MEM_DEFAULT;
 
@@ -6761,6 +7908,8 @@ H5C_load_entry(H5F_t *              f,
     entry->is_protected                 = FALSE;
     entry->is_read_only                 = FALSE;
     entry->ro_ref_count                 = 0;
+    entry->ro_in_lru                    = FALSE;
+    entry->lru_ref_bit                  = FALSE;
     entry->is_pinned                    = FALSE;
     entry->in_slist                     = FALSE;
     entry->flush_marker                 = FALSE;
@@ -6880,6 +8029,7 @@ H5C__make_space_in_cache(H5F_t *f, size_t space_needed, hbool_t	write_permitted)
     size_t		empty_space;
     hbool_t             reentrant_call = FALSE;
     hbool_t		prev_is_dirty = FALSE;
+    hbool_t		prev_is_protected = FALSE;
     hbool_t             didnt_flush_entry = FALSE;
     hbool_t		restart_scan;
     H5C_cache_entry_t *	entry_ptr;
@@ -6936,17 +8086,34 @@ H5C__make_space_in_cache(H5F_t *f, size_t space_needed, hbool_t	write_permitted)
               )
         {
 	    HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
-            HDassert( !(entry_ptr->is_protected) );
-            HDassert( ! (entry_ptr->is_read_only) );
-            HDassert( (entry_ptr->ro_ref_count) == 0 );
+            HDassert( ( !(entry_ptr->is_protected) ) ||
+                      ( entry_ptr->ro_in_lru ) );
 
 	    next_ptr = entry_ptr->next;
             prev_ptr = entry_ptr->prev;
 
-	    if(prev_ptr != NULL)
+	    if(prev_ptr != NULL) {
 		prev_is_dirty = prev_ptr->is_dirty;
+		prev_is_protected = prev_ptr->is_protected;
+            }
+
+	    if(entry_ptr->is_protected) {
+
+                /* Skip entries protected read only without leaving
+                 * the LRU list.
+                 */
+                didnt_flush_entry = TRUE;
+
+            } else if(entry_ptr->lru_ref_bit) {
+
+                /* The entry has been used since it was last placed at
+                 * the head of the LRU list -- give it a second chance.
+                 */
+                entry_ptr->lru_ref_bit = FALSE;
+                H5C__FAKE_RP_FOR_MOST_RECENT_ACCESS(cache_ptr, entry_ptr, FAIL)
+                didnt_flush_entry = TRUE;
 
-	    if(entry_ptr->is_dirty &&
+            } else if(entry_ptr->is_dirty &&
                     (entry_ptr->tag_info && entry_ptr->tag_info->corked)) {
 
                 /* Skip "dirty" corked entries.  */
@@ -6998,6 +8165,10 @@ H5C__make_space_in_cache(H5F_t *f, size_t space_needed, hbool_t	write_permitted)
                     cache_ptr->entries_scanned_to_make_space++;
 #endif /* H5C_COLLECT_CACHE_STATS */
 
+                    if(cache_ptr->rp_mode == H5C_rp__2q && !entry_ptr->rp_hot)
+                        if(H5C__rp_2q_remember_ghost(cache_ptr, entry_ptr) < 0)
+                            HGOTO_ERROR(H5E_CACHE, H5E_CANTINSERT, FAIL, "unable to remember evicted entry")
+
                     if(H5C__flush_single_entry(f, entry_ptr, H5C__FLUSH_INVALIDATE_FLAG | H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG) < 0)
                         HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "unable to flush entry")
                 } else {
@@ -7044,7 +8215,7 @@ H5C__make_space_in_cache(H5F_t *f, size_t space_needed, hbool_t	write_permitted)
 		            ||
 		            ( prev_ptr->next != next_ptr )
 		            ||
-		            ( prev_ptr->is_protected )
+		            ( prev_ptr->is_protected != prev_is_protected )
 		            ||
 		            ( prev_ptr->is_pinned ) ) {
 
@@ -7140,18 +8311,33 @@ H5C__make_space_in_cache(H5F_t *f, size_t space_needed, hbool_t	write_permitted)
                 ( entry_ptr != NULL )
               )
         {
-            HDassert( ! (entry_ptr->is_protected) );
-            HDassert( ! (entry_ptr->is_read_only) );
-            HDassert( (entry_ptr->ro_ref_count) == 0 );
+            HDassert( ( ! (entry_ptr->is_protected) ) ||
+                      ( entry_ptr->ro_in_lru ) );
             HDassert( ! (entry_ptr->is_dirty) );
 
             prev_ptr = entry_ptr->aux_prev;
 
-            if ( ( !(entry_ptr->prefetched_dirty) ) 
+            if ( entry_ptr->is_protected ) {
+
+                /* protected read only without leaving the LRU lists */
+
+            } else if ( entry_ptr->lru_ref_bit ) {
+
+                /* used since it was last placed at the head of the LRU
+                 * lists -- give it a second chance.
+                 */
+                entry_ptr->lru_ref_bit = FALSE;
+                H5C__FAKE_RP_FOR_MOST_RECENT_ACCESS(cache_ptr, entry_ptr, FAIL)
+
+            } else if ( ( !(entry_ptr->prefetched_dirty) ) 
 #ifdef H5_HAVE_PARALLEL
                  && ( ! (entry_ptr->coll_access) )
 #endif /* H5_HAVE_PARALLEL */
                ) {
+                if(cache_ptr->rp_mode == H5C_rp__2q && !entry_ptr->rp_hot)
+                    if(H5C__rp_2q_remember_ghost(cache_ptr, entry_ptr) < 0)
+                        HGOTO_ERROR(H5E_CACHE, H5E_CANTINSERT, FAIL, "unable to remember evicted entry")
+
                 if(H5C__flush_single_entry(f, entry_ptr,
                         H5C__FLUSH_INVALIDATE_FLAG | H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG) < 0)
                     HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "unable to flush entry")
@@ -7210,6 +8396,8 @@ H5C_validate_lru_list(H5C_t * cache_ptr)
     herr_t		ret_value = SUCCEED;      /* Return value */
     int32_t             len = 0;
     size_t              size = 0;
+    size_t              hot_size = 0;
+    hbool_t             cold = FALSE;
     H5C_cache_entry_t *	entry_ptr = NULL;
 
     FUNC_ENTER_NOAPI_NOINIT
@@ -7284,6 +8472,26 @@ H5C_validate_lru_list(H5C_t * cache_ptr)
             HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Check 7 failed")
         }
 
+        if ( cache_ptr->rp_mode == H5C_rp__2q ) {
+
+            if ( entry_ptr == cache_ptr->rp_cold_head_ptr )
+                cold = TRUE;
+
+            if ( ( entry_ptr->rp_hot == cold ) &&
+                 ( entry_ptr->type->id != H5AC_EPOCH_MARKER_ID ) ) {
+
+                HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Check 9 failed")
+            }
+
+            if ( entry_ptr->rp_hot )
+                hot_size += entry_ptr->size;
+        }
+
+        if ( ( entry_ptr->is_protected ) && ( ! ( entry_ptr->ro_in_lru ) ) ) {
+
+            HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Check 11 failed")
+        }
+
         len++;
         size += entry_ptr->size;
         entry_ptr = entry_ptr->next;
@@ -7295,6 +8503,13 @@ H5C_validate_lru_list(H5C_t * cache_ptr)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Check 8 failed")
     }
 
+    if ( ( cache_ptr->rp_mode == H5C_rp__2q ) &&
+         ( ( cache_ptr->rp_hot_size != hot_size ) ||
+           ( ( cache_ptr->rp_cold_head_ptr != NULL ) && ( ! cold ) ) ) ) {
+
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Check 10 failed")
+    }
+
 done:
 
     if ( ret_value != SUCCEED ) {
@@ -7541,6 +8756,11 @@ H5C_validate_protected_entry_list(H5C_t * cache_ptr)
             HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Check 8 failed")
         }
 
+        if ( entry_ptr->ro_in_lru ) {
+
+            HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Check 10 failed")
+        }
+
         len++;
         size += entry_ptr->size;
         entry_ptr = entry_ptr->next;
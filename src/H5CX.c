@@ -213,6 +213,10 @@ typedef struct H5CX_t {
     hbool_t btree_split_ratio_valid;    /* Whether B-tree split ratios are valid */
     size_t vec_size;            /* Size of hyperslab vector (H5D_XFER_HYPER_VECTOR_SIZE_NAME) */
     hbool_t vec_size_valid;     /* Whether hyperslab vector is valid */
+    unsigned filter_threads;    /* # of filter pipeline threads (H5D_XFER_FILTER_THREADS_NAME) */
+    hbool_t filter_threads_valid; /* Whether # of filter pipeline threads is valid */
+    hbool_t chunk_cache_bypass; /* Whether reads of whole chunks bypass the chunk cache (H5D_XFER_CHUNK_CACHE_BYPASS_NAME) */
+    hbool_t chunk_cache_bypass_valid; /* Whether chunk cache bypass flag is valid */
 #ifdef H5_HAVE_PARALLEL
     H5FD_mpio_xfer_t io_xfer_mode; /* Parallel transfer mode for this request (H5D_XFER_IO_XFER_MODE_NAME) */
     hbool_t io_xfer_mode_valid; /* Whether parallel transfer mode is valid */
@@ -245,6 +249,8 @@ typedef struct H5CX_t {
     hbool_t dcw_offset_valid;   /* Whether direct chunk write offset is valid */
     uint32_t dcw_datasize;      /* Direct chunk write data size (H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME) */
     hbool_t dcw_datasize_valid; /* Whether direct chunk write data size is valid */
+    H5D_direct_chunk_batch_t *dc_batch; /* Batch of chunks for direct chunk I/O (H5D_XFER_DIRECT_CHUNK_BATCH_NAME) */
+    hbool_t dc_batch_valid;     /* Whether batch of chunks for direct chunk I/O is valid */
     H5T_conv_cb_t dt_conv_cb;   /* Datatype conversion struct (H5D_XFER_CONV_CB_NAME) */
     hbool_t dt_conv_cb_valid;   /* Whether datatype conversion struct is valid */
 
@@ -308,6 +314,8 @@ typedef struct H5CX_dxpl_cache_t {
     H5T_bkg_t bkgr_buf_type;        /* Background buffer type (H5D_XFER_BKGR_BUF_NAME) */
     double btree_split_ratio[3];    /* B-tree split ratios (H5D_XFER_BTREE_SPLIT_RATIO_NAME) */
     size_t vec_size;                /* Size of hyperslab vector (H5D_XFER_HYPER_VECTOR_SIZE_NAME) */
+    unsigned filter_threads;        /* # of filter pipeline threads (H5D_XFER_FILTER_THREADS_NAME) */
+    hbool_t chunk_cache_bypass;     /* Whether reads of whole chunks bypass the chunk cache (H5D_XFER_CHUNK_CACHE_BYPASS_NAME) */
 #ifdef H5_HAVE_PARALLEL
     H5FD_mpio_xfer_t io_xfer_mode;  /* Parallel transfer mode for this request (H5D_XFER_IO_XFER_MODE_NAME) */
     H5FD_mpio_collective_opt_t mpio_coll_opt; /* Parallel transfer with independent IO or collective IO with this mode (H5D_XFER_MPIO_COLLECTIVE_OPT_NAME) */
@@ -327,6 +335,7 @@ typedef struct H5CX_dxpl_cache_t {
     uint32_t dcw_datasize;          /* Direct chunk write data size (H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME) */
     hsize_t *dcw_offset;            /* Direct chunk write offset (H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME) */
     uint32_t dcw_filters;           /* Direct chunk write filter flags (H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_NAME) */
+    H5D_direct_chunk_batch_t *dc_batch; /* Batch of chunks for direct chunk I/O (H5D_XFER_DIRECT_CHUNK_BATCH_NAME) */
     H5T_conv_cb_t dt_conv_cb;       /* Datatype conversion struct (H5D_XFER_CONV_CB_NAME) */
 } H5CX_dxpl_cache_t;
 
@@ -424,6 +433,14 @@ H5CX__init_package(void)
     if(H5P_get(dx_plist, H5D_XFER_HYPER_VECTOR_SIZE_NAME, &H5CX_def_dxpl_cache.vec_size) < 0)
         HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve I/O vector size")
 
+    /* Get # of filter pipeline threads */
+    if(H5P_get(dx_plist, H5D_XFER_FILTER_THREADS_NAME, &H5CX_def_dxpl_cache.filter_threads) < 0)
+        HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve # of filter pipeline threads")
+
+    /* Get chunk cache bypass flag */
+    if(H5P_get(dx_plist, H5D_XFER_CHUNK_CACHE_BYPASS_NAME, &H5CX_def_dxpl_cache.chunk_cache_bypass) < 0)
+        HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve chunk cache bypass flag")
+
 #ifdef H5_HAVE_PARALLEL
     /* Collect Parallel I/O information for possible later use */
     if(H5P_get(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &H5CX_def_dxpl_cache.io_xfer_mode) < 0)
@@ -485,6 +502,10 @@ H5CX__init_package(void)
     if(H5P_get(dx_plist, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME, &H5CX_def_dxpl_cache.dcw_datasize) < 0)
         HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve direct chunk write data size")
 
+    /* Get batch of chunks for direct chunk I/O */
+    if(H5P_get(dx_plist, H5D_XFER_DIRECT_CHUNK_BATCH_NAME, &H5CX_def_dxpl_cache.dc_batch) < 0)
+        HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve direct chunk I/O batch")
+
     /* Get datatype conversion struct */
     if(H5P_get(dx_plist, H5D_XFER_CONV_CB_NAME, &H5CX_def_dxpl_cache.dt_conv_cb) < 0)
         HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve datatype conversion exception callback")
@@ -1355,6 +1376,74 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5CX_get_vec_size() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_filter_threads
+ *
+ * Purpose:     Retrieves the number of threads which may run the I/O filter
+ *              pipeline for the current API call context.
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5CX_get_filter_threads(unsigned *filter_threads)
+{
+    H5CX_node_t **head = H5CX_get_my_context();  /* Get the pointer to the head of the API context, for this thread */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(filter_threads);
+    HDassert(head && *head);
+    HDassert(H5P_DEFAULT != (*head)->ctx.dxpl_id);
+
+    H5CX_RETRIEVE_PROP_VALID(dxpl, H5P_DATASET_XFER_DEFAULT, H5D_XFER_FILTER_THREADS_NAME, filter_threads)
+
+    /* Get the value */
+    *filter_threads = (*head)->ctx.filter_threads;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5CX_get_filter_threads() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_chunk_cache_bypass
+ *
+ * Purpose:     Retrieves whether reads of whole chunks bypass the chunk
+ *              cache for the current API call context.
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5CX_get_chunk_cache_bypass(hbool_t *chunk_cache_bypass)
+{
+    H5CX_node_t **head = H5CX_get_my_context();  /* Get the pointer to the head of the API context, for this thread */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(chunk_cache_bypass);
+    HDassert(head && *head);
+    HDassert(H5P_DEFAULT != (*head)->ctx.dxpl_id);
+
+    H5CX_RETRIEVE_PROP_VALID(dxpl, H5P_DATASET_XFER_DEFAULT, H5D_XFER_CHUNK_CACHE_BYPASS_NAME, chunk_cache_bypass)
+
+    /* Get the value */
+    *chunk_cache_bypass = (*head)->ctx.chunk_cache_bypass;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5CX_get_chunk_cache_bypass() */
+
 #ifdef H5_HAVE_PARALLEL
 
 /*-------------------------------------------------------------------------
@@ -1999,6 +2088,40 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5CX_get_dcw_datasize() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_dc_batch
+ *
+ * Purpose:     Retrieves the batch of chunks for direct chunk I/O for the
+ *              current API call context.
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5CX_get_dc_batch(H5D_direct_chunk_batch_t **dc_batch)
+{
+    H5CX_node_t **head = H5CX_get_my_context();  /* Get the pointer to the head of the API context, for this thread */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(dc_batch);
+    HDassert(head && *head);
+    HDassert(H5P_DEFAULT != (*head)->ctx.dxpl_id);
+
+    H5CX_RETRIEVE_PROP_VALID(dxpl, H5P_DATASET_XFER_DEFAULT, H5D_XFER_DIRECT_CHUNK_BATCH_NAME, dc_batch)
+
+    /* Get the value */
+    *dc_batch = (*head)->ctx.dc_batch;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5CX_get_dc_batch() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5CX_get_dt_conv_cb
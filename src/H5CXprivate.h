@@ -82,6 +82,8 @@ H5_DLL herr_t H5CX_get_tconv_buf(void **tconv_buf);
 H5_DLL herr_t H5CX_get_bkgr_buf(void **bkgr_buf);
 H5_DLL herr_t H5CX_get_bkgr_buf_type(H5T_bkg_t *bkgr_buf_type);
 H5_DLL herr_t H5CX_get_vec_size(size_t *vec_size);
+H5_DLL herr_t H5CX_get_filter_threads(unsigned *filter_threads);
+H5_DLL herr_t H5CX_get_chunk_cache_bypass(hbool_t *chunk_cache_bypass);
 #ifdef H5_HAVE_PARALLEL
 H5_DLL herr_t H5CX_get_io_xfer_mode(H5FD_mpio_xfer_t *io_xfer_mode);
 H5_DLL herr_t H5CX_get_mpio_coll_opt(H5FD_mpio_collective_opt_t *mpio_coll_opt);
@@ -101,6 +103,7 @@ H5_DLL herr_t H5CX_get_dcw_flag(hbool_t *direct_write);
 H5_DLL herr_t H5CX_get_dcw_filters(uint32_t *direct_filters);
 H5_DLL herr_t H5CX_get_dcw_offset(hsize_t **direct_offset);
 H5_DLL herr_t H5CX_get_dcw_datasize(uint32_t *direct_datasize);
+H5_DLL herr_t H5CX_get_dc_batch(H5D_direct_chunk_batch_t **dc_batch);
 H5_DLL herr_t H5CX_get_dt_conv_cb(H5T_conv_cb_t *cb_struct);
 
 /* "Getter" routines for LAPL properties cached in API context */
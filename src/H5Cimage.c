@@ -617,6 +617,8 @@ H5C__deserialize_prefetched_entry(H5F_t *f, H5C_t *cache_ptr,
     ds_entry_ptr->is_protected              	= FALSE;
     ds_entry_ptr->is_read_only              	= FALSE;
     ds_entry_ptr->ro_ref_count              	= 0;
+    ds_entry_ptr->ro_in_lru                 	= FALSE;
+    ds_entry_ptr->lru_ref_bit               	= FALSE;
     ds_entry_ptr->is_pinned                 	= FALSE;
     ds_entry_ptr->in_slist                  	= FALSE;
     ds_entry_ptr->flush_marker              	= FALSE;
@@ -53,6 +53,55 @@
 /* Initial allocated size of the "flush_dep_parent" array */
 #define H5C_FLUSH_DEP_PARENT_INIT 8
 
+/* Whether H5C__flush_ring() can serialize entries on several threads */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5_HAVE_WIN_THREADS)
+#define H5C_HAVE_SERIALIZE_THREADS
+#endif
+
+/* # of entries a thread serializing entries for a flush takes at once */
+#define H5C_SERIALIZE_THREAD_NENTRIES 16
+
+/* Largest write H5C__flush_ring() gathers the images of adjacent entries into */
+#define H5C_WRITE_GATHER_MAX_SIZE     (4 * 1024 * 1024)
+
+/* Under the 2Q replacement policy, the percentage of the maximum cache size
+ * the hot segment of the LRU list may hold, and the percentage the ghost
+ * list of entries recently evicted from the cold segment may cover.
+ */
+#define H5C__2Q_HOT_SIZE_PERCENT        75
+#define H5C__2Q_GHOST_SIZE_PERCENT      50
+
+/* Atomic accesses for the read only protect path of entries that stay on
+ * the LRU lists (see the discussion of deferred_lru below).  Without the
+ * GCC atomic builtins these are plain accesses, which are only correct as
+ * long as calls into the cache are serialized.
+ */
+#if defined(__GNUC__)
+#define H5C__ATOMIC_LOAD(P)             __atomic_load_n((P), __ATOMIC_ACQUIRE)
+#define H5C__ATOMIC_STORE(P, V)         __atomic_store_n((P), (V), __ATOMIC_RELEASE)
+#define H5C__ATOMIC_ADD(P, V)           ((void)__atomic_add_fetch((P), (V), __ATOMIC_RELAXED))
+#define H5C__ATOMIC_CAS(P, E, D)        __atomic_compare_exchange_n((P), &(E), (D), FALSE, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)
+#else
+#define H5C__ATOMIC_LOAD(P)             (*(P))
+#define H5C__ATOMIC_STORE(P, V)         (*(P) = (V))
+#define H5C__ATOMIC_ADD(P, V)           ((void)(*(P) += (V)))
+#define H5C__ATOMIC_CAS(P, E, D)        ((*(P) == (E)) ? (*(P) = (D), TRUE) : ((E) = *(P), FALSE))
+#endif
+
+/* Raise *P to V if it is smaller, atomically */
+#define H5C__ATOMIC_MAX(P, V)                                               \
+{                                                                           \
+    int32_t old_max_ = H5C__ATOMIC_LOAD(P);                                 \
+                                                                            \
+    while((old_max_ < (V)) && !H5C__ATOMIC_CAS((P), old_max_, (V)))         \
+        ;                                                                   \
+}
+
+/* Value of an entry's ro_ref_count while a thread on the read only protect
+ * path owns the entry's protect fields
+ */
+#define H5C__RO_REF_COUNT_BUSY          (-1)
+
 /****************************************************************************
  *
  * We maintain doubly linked lists of instances of H5C_cache_entry_t for a
@@ -286,6 +335,25 @@ if ( ( (new_size) > (dll_size) ) ||                                            \
     (Size) += entry_ptr->size;                                               \
 } /* H5C__DLL_PREPEND() */
 
+#define H5C__DLL_INSERT_BEFORE(entry_ptr, next_ptr, head_ptr, tail_ptr, len, \
+                               Size, fail_val)                               \
+{                                                                            \
+    H5C__DLL_PRE_INSERT_SC(entry_ptr, head_ptr, tail_ptr, len, Size,         \
+                           fail_val)                                         \
+    HDassert( (next_ptr) != NULL );                                          \
+    if ( (head_ptr) == (next_ptr) )                                          \
+       (head_ptr) = (entry_ptr);                                             \
+    else                                                                     \
+    {                                                                        \
+       (next_ptr)->prev->next = (entry_ptr);                                 \
+       (entry_ptr)->prev = (next_ptr)->prev;                                 \
+    }                                                                        \
+    (next_ptr)->prev = (entry_ptr);                                          \
+    (entry_ptr)->next = (next_ptr);                                          \
+    (len)++;                                                                 \
+    (Size) += (entry_ptr)->size;                                             \
+} /* H5C__DLL_INSERT_BEFORE() */
+
 #define H5C__DLL_REMOVE(entry_ptr, head_ptr, tail_ptr, len, Size, fail_val) \
 {                                                                           \
     H5C__DLL_PRE_REMOVE_SC(entry_ptr, head_ptr, tail_ptr, len, Size,        \
@@ -601,6 +669,13 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
             (cache_ptr->cache_hits)++;                   \
         }                                                \
 
+/* Hits on the read only protect path of entries that stay on the LRU lists
+ * may be counted by several threads at once.
+ */
+#define H5C__UPDATE_CACHE_HIT_RATE_STATS_FOR_RO_IN_LRU_HIT(cache_ptr) \
+        H5C__ATOMIC_ADD(&((cache_ptr)->cache_accesses), 1);           \
+        H5C__ATOMIC_ADD(&((cache_ptr)->cache_hits), 1);
+
 #if H5C_COLLECT_CACHE_STATS
 
 #define H5C__UPDATE_MAX_INDEX_SIZE_STATS(cache_ptr)                        \
@@ -658,13 +733,16 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
 #define H5C__UPDATE_STATS_FOR_HT_DELETION(cache_ptr) \
 	(cache_ptr)->total_ht_deletions++;
 
-#define H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, success, depth)  \
-	if ( success ) {                                            \
-	    (cache_ptr)->successful_ht_searches++;                  \
-	    (cache_ptr)->total_successful_ht_search_depth += depth; \
-	} else {                                                    \
-	    (cache_ptr)->failed_ht_searches++;                      \
-	    (cache_ptr)->total_failed_ht_search_depth += depth;     \
+/* Atomic, as searches on the read only protect path may run concurrently */
+#define H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, success, depth)              \
+	if ( success ) {                                                        \
+	    H5C__ATOMIC_ADD(&((cache_ptr)->successful_ht_searches), 1);         \
+	    H5C__ATOMIC_ADD(&((cache_ptr)->total_successful_ht_search_depth),   \
+                            depth);                                             \
+	} else {                                                                \
+	    H5C__ATOMIC_ADD(&((cache_ptr)->failed_ht_searches), 1);             \
+	    H5C__ATOMIC_ADD(&((cache_ptr)->total_failed_ht_search_depth),       \
+                            depth);                                             \
 	}
 
 #define H5C__UPDATE_STATS_FOR_UNPIN(cache_ptr, entry_ptr) \
@@ -823,6 +901,20 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
     ((entry_ptr)->accesses)++;                                              \
 }
 
+/* The read only protect path of entries that stay on the LRU lists leaves
+ * the index and the lists alone, so only the per type counts can change.
+ * They are updated atomically, as several threads may take this path at
+ * once.
+ */
+#define H5C__UPDATE_STATS_FOR_RO_IN_LRU_HIT(cache_ptr, entry_ptr, ro_ref_count) \
+{                                                                           \
+    H5C__ATOMIC_ADD(&(((cache_ptr)->hits)[(entry_ptr)->type->id]), 1);      \
+    H5C__ATOMIC_ADD(&(((cache_ptr)->read_protects)[(entry_ptr)->type->id]), 1); \
+    H5C__ATOMIC_MAX(&(((cache_ptr)->max_read_protects)[(entry_ptr)->type->id]), \
+                    (int32_t)(ro_ref_count))                                \
+    H5C__ATOMIC_ADD(&((entry_ptr)->accesses), 1);                           \
+}
+
 #define H5C__UPDATE_STATS_FOR_PIN(cache_ptr, entry_ptr)      \
 {                                                            \
     ((cache_ptr)->pins)[(entry_ptr)->type->id]++;            \
@@ -904,6 +996,14 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
         (cache_ptr)->max_pl_size = (cache_ptr)->pl_size;                    \
 }
 
+#define H5C__UPDATE_STATS_FOR_RO_IN_LRU_HIT(cache_ptr, entry_ptr, ro_ref_count) \
+{                                                                           \
+    H5C__ATOMIC_ADD(&(((cache_ptr)->hits)[(entry_ptr)->type->id]), 1);      \
+    H5C__ATOMIC_ADD(&(((cache_ptr)->read_protects)[(entry_ptr)->type->id]), 1); \
+    H5C__ATOMIC_MAX(&(((cache_ptr)->max_read_protects)[(entry_ptr)->type->id]), \
+                    (int32_t)(ro_ref_count))                                \
+}
+
 #define H5C__UPDATE_STATS_FOR_PIN(cache_ptr, entry_ptr)      \
 {                                                            \
     ((cache_ptr)->pins)[(entry_ptr)->type->id]++;            \
@@ -930,6 +1030,7 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
 #define H5C__UPDATE_STATS_FOR_FLUSH(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_EVICTION(cache_ptr, entry_ptr, take_ownership)
 #define H5C__UPDATE_STATS_FOR_PROTECT(cache_ptr, entry_ptr, hit)
+#define H5C__UPDATE_STATS_FOR_RO_IN_LRU_HIT(cache_ptr, entry_ptr, ro_ref_count)
 #define H5C__UPDATE_STATS_FOR_PIN(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_UNPIN(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_SLIST_SCAN_RESTART(cache_ptr)
@@ -1402,7 +1503,8 @@ if ( ( (cache_ptr)->index_size !=                                           \
     while(entry_ptr) {                                                      \
         if(H5F_addr_eq(Addr, (entry_ptr)->addr)) {                          \
             H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, k, fail_val)   \
-            if(entry_ptr != ((cache_ptr)->index)[k]) {                      \
+            if(entry_ptr != ((cache_ptr)->index)[k] &&                      \
+                    !(cache_ptr)->deferred_lru) {                           \
                 if((entry_ptr)->ht_next)                                    \
                     (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;   \
                 HDassert((entry_ptr)->ht_prev != NULL);                     \
@@ -1430,7 +1532,8 @@ if ( ( (cache_ptr)->index_size !=                                           \
     while(entry_ptr) {                                                      \
         if(H5F_addr_eq(Addr, (entry_ptr)->addr)) {                          \
             H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, k, fail_val)   \
-            if(entry_ptr != ((cache_ptr)->index)[k]) {                      \
+            if(entry_ptr != ((cache_ptr)->index)[k] &&                      \
+                    !(cache_ptr)->deferred_lru) {                           \
                 if((entry_ptr)->ht_next)                                    \
                     (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;   \
                 HDassert((entry_ptr)->ht_prev != NULL);                     \
@@ -1849,6 +1952,153 @@ if ( ( (cache_ptr)->index_size !=                                           \
  *
  **************************************************************************/
 
+/*-------------------------------------------------------------------------
+ *
+ * Macro:	H5C__RP_2Q_DEMOTE_HOT
+ *
+ * Purpose:     Move the least recently used hot entries on the LRU list
+ *		to the cold segment until the hot segment is no larger
+ *		than H5C__2Q_HOT_SIZE_PERCENT percent of max_cache_size.
+ *
+ *		This macro must only be used when the 2Q policy is in
+ *		effect.
+ *
+ * Return:      N/A
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define H5C__RP_2Q_DEMOTE_HOT(cache_ptr)                                    \
+{                                                                           \
+    size_t _hot_max_size = ((cache_ptr)->max_cache_size / 100) *            \
+                           H5C__2Q_HOT_SIZE_PERCENT;                        \
+                                                                            \
+    HDassert( (cache_ptr)->rp_mode == H5C_rp__2q );                         \
+                                                                            \
+    while ( (cache_ptr)->rp_hot_size > _hot_max_size ) {                    \
+                                                                            \
+        H5C_cache_entry_t * _demote_ptr;                                    \
+                                                                            \
+        if ( (cache_ptr)->rp_cold_head_ptr == NULL )                        \
+            _demote_ptr = (cache_ptr)->LRU_tail_ptr;                        \
+        else                                                                \
+            _demote_ptr = (cache_ptr)->rp_cold_head_ptr->prev;              \
+                                                                            \
+        HDassert( _demote_ptr );                                            \
+                                                                            \
+        /* epoch markers are never hot, and just change sides */            \
+        if ( _demote_ptr->rp_hot ) {                                        \
+                                                                            \
+            HDassert( (cache_ptr)->rp_hot_size >= _demote_ptr->size );      \
+            _demote_ptr->rp_hot = FALSE;                                    \
+            (cache_ptr)->rp_hot_size -= _demote_ptr->size;                  \
+        }                                                                   \
+        (cache_ptr)->rp_cold_head_ptr = _demote_ptr;                        \
+    }                                                                       \
+} /* H5C__RP_2Q_DEMOTE_HOT */
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Macro:	H5C__RP_LRU_INSERT
+ *
+ * Purpose:     Insert the specified entry in the LRU list at the position
+ *		the current replacement policy gives a just used entry.
+ *
+ *		Under the modified LRU policy, and for hot entries under
+ *		the 2Q policy, this is the head of the list.  Cold entries
+ *		under the 2Q policy are inserted at the head of the cold
+ *		segment instead.
+ *
+ *		If inserting a hot entry leaves the hot segment larger
+ *		than H5C__2Q_HOT_SIZE_PERCENT percent of the maximum cache
+ *		size, move the boundary between the segments towards the
+ *		head of the list, thereby demoting the least recently used
+ *		hot entries to the cold segment.
+ *
+ *		The clean and dirty LRU lists are not affected.
+ *
+ * Return:      N/A
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define H5C__RP_LRU_INSERT(cache_ptr, entry_ptr, fail_val)                  \
+{                                                                           \
+    if ( ( (cache_ptr)->rp_mode == H5C_rp__2q ) &&                          \
+         ( ! ((entry_ptr)->rp_hot) ) ) {                                    \
+                                                                            \
+        if ( (cache_ptr)->rp_cold_head_ptr == NULL ) {                      \
+                                                                            \
+            H5C__DLL_APPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,         \
+                            (cache_ptr)->LRU_tail_ptr,                      \
+                            (cache_ptr)->LRU_list_len,                      \
+                            (cache_ptr)->LRU_list_size, (fail_val))         \
+        } else {                                                            \
+                                                                            \
+            H5C__DLL_INSERT_BEFORE((entry_ptr),                             \
+                                   (cache_ptr)->rp_cold_head_ptr,           \
+                                   (cache_ptr)->LRU_head_ptr,               \
+                                   (cache_ptr)->LRU_tail_ptr,               \
+                                   (cache_ptr)->LRU_list_len,               \
+                                   (cache_ptr)->LRU_list_size, (fail_val))  \
+        }                                                                   \
+        (cache_ptr)->rp_cold_head_ptr = (entry_ptr);                        \
+                                                                            \
+    } else {                                                                \
+                                                                            \
+        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
+                         (cache_ptr)->LRU_tail_ptr,                         \
+                         (cache_ptr)->LRU_list_len,                         \
+                         (cache_ptr)->LRU_list_size, (fail_val))            \
+                                                                            \
+        if ( (cache_ptr)->rp_mode == H5C_rp__2q ) {                         \
+                                                                            \
+            (cache_ptr)->rp_hot_size += (entry_ptr)->size;                  \
+            H5C__RP_2Q_DEMOTE_HOT(cache_ptr)                                \
+        }                                                                   \
+    }                                                                       \
+} /* H5C__RP_LRU_INSERT */
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Macro:	H5C__RP_LRU_REMOVE
+ *
+ * Purpose:     Remove the specified entry from the LRU list, and update
+ *		the fields supporting the 2Q policy if it is in effect.
+ *
+ *		This macro must be used for all removals from the LRU
+ *		list, epoch markers included, as the head of the cold
+ *		segment may be any entry in the list.
+ *
+ *		The clean and dirty LRU lists are not affected.
+ *
+ * Return:      N/A
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define H5C__RP_LRU_REMOVE(cache_ptr, entry_ptr, fail_val)                  \
+{                                                                           \
+    if ( (cache_ptr)->rp_mode == H5C_rp__2q ) {                             \
+                                                                            \
+        if ( (cache_ptr)->rp_cold_head_ptr == (entry_ptr) )                 \
+            (cache_ptr)->rp_cold_head_ptr = (entry_ptr)->next;              \
+                                                                            \
+        if ( (entry_ptr)->rp_hot ) {                                        \
+                                                                            \
+            HDassert( (cache_ptr)->rp_hot_size >= (entry_ptr)->size );      \
+            (cache_ptr)->rp_hot_size -= (entry_ptr)->size;                  \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,                 \
+                    (cache_ptr)->LRU_tail_ptr, (cache_ptr)->LRU_list_len,   \
+                    (cache_ptr)->LRU_list_size, (fail_val))                 \
+} /* H5C__RP_LRU_REMOVE */
+
+
 /*-------------------------------------------------------------------------
  *
  * Macro:	H5C__FAKE_RP_FOR_MOST_RECENT_ACCESS
@@ -1859,10 +2109,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
  *		most recently touched so we can repair any such
  *		confusion.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the macro
- *		should switch on the current policy and act accordingly.
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
  *
  * Return:      N/A
  *
@@ -1902,15 +2151,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
         /* remove the entry from the LRU list, and re-insert it at the head.\
 	 */                                                                 \
                                                                             \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                        (cache_ptr)->LRU_tail_ptr,                          \
-			(cache_ptr)->LRU_list_len,                          \
-                        (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
-                         (cache_ptr)->LRU_tail_ptr,                         \
-			 (cache_ptr)->LRU_list_len,                         \
-                         (cache_ptr)->LRU_list_size, (fail_val))            \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
         /* Use the dirty flag to infer whether the entry is on the clean or \
          * dirty LRU list, and remove it.  Then insert it at the head of    \
@@ -1965,15 +2208,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
         /* remove the entry from the LRU list, and re-insert it at the head \
 	 */                                                                 \
                                                                             \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                        (cache_ptr)->LRU_tail_ptr,                          \
-			(cache_ptr)->LRU_list_len,                          \
-                        (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
-                         (cache_ptr)->LRU_tail_ptr,                         \
-			 (cache_ptr)->LRU_list_len,                         \
-                         (cache_ptr)->LRU_list_size, (fail_val))            \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
         /* End modified LRU specific code. */                               \
     }                                                                       \
@@ -1989,10 +2226,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
  * Purpose:     Update the replacement policy data structures for an
  *		eviction of the specified cache entry.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
  *
  * Return:      Non-negative on success/Negative on failure.
  *
@@ -2042,9 +2278,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                              \
     /* remove the entry from the LRU list. */                                \
                                                                              \
-    H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,                  \
-                    (cache_ptr)->LRU_tail_ptr, (cache_ptr)->LRU_list_len,    \
-                    (cache_ptr)->LRU_list_size, (fail_val))                  \
+    H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))                 \
                                                                              \
     /* If the entry is clean when it is evicted, it should be on the         \
      * clean LRU list, if it was dirty, it should be on the dirty LRU list.  \
@@ -2084,9 +2318,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                              \
     /* remove the entry from the LRU list. */                                \
                                                                              \
-    H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,                  \
-                    (cache_ptr)->LRU_tail_ptr, (cache_ptr)->LRU_list_len,    \
-                    (cache_ptr)->LRU_list_size, (fail_val))                  \
+    H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))                 \
                                                                              \
 } /* H5C__UPDATE_RP_FOR_EVICTION */
 
@@ -2100,10 +2332,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
  * Purpose:     Update the replacement policy data structures for a flush
  *		of the specified cache entry.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
  *
  * Return:      N/A
  *
@@ -2158,15 +2389,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
 	 * head.                                                            \
 	 */                                                                 \
                                                                             \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                        (cache_ptr)->LRU_tail_ptr,                          \
-			(cache_ptr)->LRU_list_len,                          \
-                        (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
-                         (cache_ptr)->LRU_tail_ptr,                         \
-			 (cache_ptr)->LRU_list_len,                         \
-                         (cache_ptr)->LRU_list_size, (fail_val))            \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
         /* since the entry is being flushed or cleared, one would think     \
 	 * that it must be dirty -- but that need not be the case.  Use the \
@@ -2220,15 +2445,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
 	 * head.                                                            \
 	 */                                                                 \
                                                                             \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                        (cache_ptr)->LRU_tail_ptr,                          \
-			(cache_ptr)->LRU_list_len,                          \
-                        (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
-                         (cache_ptr)->LRU_tail_ptr,                         \
-			 (cache_ptr)->LRU_list_len,                         \
-                         (cache_ptr)->LRU_list_size, (fail_val))            \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
         /* End modified LRU specific code. */                               \
     }                                                                       \
@@ -2252,10 +2471,11 @@ if ( ( (cache_ptr)->index_size !=                                           \
  *		the reconstruction of the metadata cache from a cache 
  *		image block.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		Under the 2Q policy, the new entry joins the cold segment.
+ *
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
  *
  * Return:      N/A
  *
@@ -2276,6 +2496,8 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( ((entry_ptr)->ro_ref_count) == 0 );                          \
     HDassert( (entry_ptr)->size > 0 );                                     \
                                                                            \
+    (entry_ptr)->rp_hot = FALSE;                                           \
+                                                                           \
     if ( (entry_ptr)->is_pinned ) {                                        \
                                                                            \
         H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->pel_head_ptr,           \
@@ -2294,6 +2516,10 @@ if ( ( (cache_ptr)->index_size !=                                           \
 		        (cache_ptr)->LRU_list_len,                         \
                         (cache_ptr)->LRU_list_size, (fail_val))            \
                                                                            \
+        if ( ( (cache_ptr)->rp_mode == H5C_rp__2q ) &&                     \
+             ( (cache_ptr)->rp_cold_head_ptr == NULL ) )                   \
+            (cache_ptr)->rp_cold_head_ptr = (entry_ptr);                   \
+                                                                           \
         /* insert the entry at the tail of the clean or dirty LRU list as  \
          * appropriate.                                                    \
          */                                                                \
@@ -2326,6 +2552,8 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( ((entry_ptr)->ro_ref_count) == 0 );                          \
     HDassert( (entry_ptr)->size > 0 );                                     \
                                                                            \
+    (entry_ptr)->rp_hot = FALSE;                                           \
+                                                                           \
     if ( (entry_ptr)->is_pinned ) {                                        \
                                                                            \
         H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->pel_head_ptr,           \
@@ -2344,6 +2572,10 @@ if ( ( (cache_ptr)->index_size !=                                           \
 			(cache_ptr)->LRU_list_len,                         \
                         (cache_ptr)->LRU_list_size, (fail_val))            \
                                                                            \
+        if ( ( (cache_ptr)->rp_mode == H5C_rp__2q ) &&                     \
+             ( (cache_ptr)->rp_cold_head_ptr == NULL ) )                   \
+            (cache_ptr)->rp_cold_head_ptr = (entry_ptr);                   \
+                                                                           \
         /* End modified LRU specific code. */                              \
     }                                                                      \
 }
@@ -2358,10 +2590,13 @@ if ( ( (cache_ptr)->index_size !=                                           \
  * Purpose:     Update the replacement policy data structures for an
  *		insertion of the specified cache entry.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
+ *
+ *		Under the 2Q policy, the new entry is hot if its address
+ *		is on the ghost list of entries recently evicted from the
+ *		cold segment, and cold otherwise.
  *
  * Return:      N/A
  *
@@ -2410,6 +2645,10 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( ((entry_ptr)->ro_ref_count) == 0 );                          \
     HDassert( (entry_ptr)->size > 0 );                                     \
                                                                            \
+    (entry_ptr)->rp_hot = ( (cache_ptr)->rp_mode == H5C_rp__2q ) &&        \
+                          H5C__rp_2q_forget_ghost((cache_ptr),             \
+                                                  (entry_ptr)->addr);      \
+                                                                           \
     if ( (entry_ptr)->is_pinned ) {                                        \
                                                                            \
         H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->pel_head_ptr,           \
@@ -2423,10 +2662,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                            \
         /* insert the entry at the head of the LRU list. */                \
                                                                            \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                         (cache_ptr)->LRU_tail_ptr,                        \
-			 (cache_ptr)->LRU_list_len,                        \
-                         (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))           \
                                                                            \
         /* insert the entry at the head of the clean or dirty LRU list as  \
          * appropriate.                                                    \
@@ -2460,6 +2696,10 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( ((entry_ptr)->ro_ref_count) == 0 );                          \
     HDassert( (entry_ptr)->size > 0 );                                     \
                                                                            \
+    (entry_ptr)->rp_hot = ( (cache_ptr)->rp_mode == H5C_rp__2q ) &&        \
+                          H5C__rp_2q_forget_ghost((cache_ptr),             \
+                                                  (entry_ptr)->addr);      \
+                                                                           \
     if ( (entry_ptr)->is_pinned ) {                                        \
                                                                            \
         H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->pel_head_ptr,           \
@@ -2473,10 +2713,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                            \
         /* insert the entry at the head of the LRU list. */                \
                                                                            \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                         (cache_ptr)->LRU_tail_ptr,                        \
-			 (cache_ptr)->LRU_list_len,                        \
-                         (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))           \
                                                                            \
         /* End modified LRU specific code. */                              \
     }                                                                      \
@@ -2496,10 +2733,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
  *		structures used by the replacement policy, and add the
  *		entry to the protected list.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
  *
  * Return:      N/A
  *
@@ -2558,10 +2794,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                           \
         /* remove the entry from the LRU list. */                         \
                                                                           \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                        (cache_ptr)->LRU_tail_ptr,                        \
-			(cache_ptr)->LRU_list_len,                        \
-                        (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))          \
                                                                           \
         /* Similarly, remove the entry from the clean or dirty LRU list   \
          * as appropriate.                                                \
@@ -2620,10 +2853,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                           \
         /* remove the entry from the LRU list. */                         \
                                                                           \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                        (cache_ptr)->LRU_tail_ptr,                        \
-			(cache_ptr)->LRU_list_len,                        \
-                        (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))          \
                                                                           \
         /* End modified LRU specific code. */                             \
     }                                                                     \
@@ -2648,10 +2878,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
  * Purpose:     Update the replacement policy data structures for a
  *		move of the specified cache entry.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
  *
  * Return:      N/A
  *
@@ -2678,15 +2907,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
         /* remove the entry from the LRU list, and re-insert it at the head. \
 	 */                                                                  \
                                                                              \
-            H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,          \
-                             (cache_ptr)->LRU_tail_ptr,                      \
-			     (cache_ptr)->LRU_list_len,                      \
-                             (cache_ptr)->LRU_list_size, (fail_val))         \
+            H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))         \
                                                                              \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                         (cache_ptr)->LRU_tail_ptr,                          \
-			 (cache_ptr)->LRU_list_len,                          \
-                         (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))             \
                                                                              \
             /* remove the entry from either the clean or dirty LUR list as   \
              * indicated by the was_dirty parameter                          \
@@ -2755,15 +2978,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
         /* remove the entry from the LRU list, and re-insert it at the head. \
 	 */                                                                  \
                                                                              \
-            H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,          \
-                             (cache_ptr)->LRU_tail_ptr,                      \
-			     (cache_ptr)->LRU_list_len,                      \
-                             (cache_ptr)->LRU_list_size, (fail_val))         \
+            H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))         \
                                                                              \
-            H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,         \
-                              (cache_ptr)->LRU_tail_ptr,                     \
-			      (cache_ptr)->LRU_list_len,                     \
-                              (cache_ptr)->LRU_list_size, (fail_val))        \
+            H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))         \
                                                                              \
             /* End modified LRU specific code. */                            \
         }                                                                    \
@@ -2786,10 +3003,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
  *		replacement policy.  Update the appropriate replacement
  *		policy data structures.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
  *
  * Return:      N/A
  *
@@ -2844,6 +3060,13 @@ if ( ( (cache_ptr)->index_size !=                                           \
 			                (entry_ptr)->size,                \
 					(new_size));                      \
                                                                           \
+        if ( ( (cache_ptr)->rp_mode == H5C_rp__2q ) &&                    \
+             ( (entry_ptr)->rp_hot ) ) {                                  \
+                                                                          \
+            (cache_ptr)->rp_hot_size -= (entry_ptr)->size;                \
+            (cache_ptr)->rp_hot_size += (new_size);                       \
+        }                                                                 \
+                                                                          \
         /* Similarly, update the size of the clean or dirty LRU list as   \
 	 * appropriate.  At present, the entry must be clean, but that    \
 	 * could change.                                                  \
@@ -2900,6 +3123,13 @@ if ( ( (cache_ptr)->index_size !=                                           \
 			                (entry_ptr)->size,                \
 					(new_size));                      \
                                                                           \
+        if ( ( (cache_ptr)->rp_mode == H5C_rp__2q ) &&                    \
+             ( (entry_ptr)->rp_hot ) ) {                                  \
+                                                                          \
+            (cache_ptr)->rp_hot_size -= (entry_ptr)->size;                \
+            (cache_ptr)->rp_hot_size += (new_size);                       \
+        }                                                                 \
+                                                                          \
         /* End modified LRU specific code. */                             \
     }                                                                     \
                                                                           \
@@ -2919,10 +3149,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
  *		entry list, and re-insert it in the data structures used
  *		by the current replacement policy.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the macro
- *		should switch on the current policy and act accordingly.
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
  *
  * Return:      N/A
  *
@@ -2961,10 +3190,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                        \
     /* insert the entry at the head of the LRU list. */                \
                                                                        \
-    H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                     (cache_ptr)->LRU_tail_ptr,                        \
-                     (cache_ptr)->LRU_list_len,                        \
-                     (cache_ptr)->LRU_list_size, (fail_val))           \
+    H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))           \
                                                                        \
     /* Similarly, insert the entry at the head of either the clean     \
      * or dirty LRU list as appropriate.                               \
@@ -3017,10 +3243,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                        \
         /* insert the entry at the head of the LRU list. */            \
                                                                        \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,       \
-                         (cache_ptr)->LRU_tail_ptr,                    \
-                         (cache_ptr)->LRU_list_len,                    \
-                         (cache_ptr)->LRU_list_size, (fail_val))       \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))       \
                                                                        \
         /* End modified LRU specific code. */                          \
                                                                        \
@@ -3040,10 +3263,9 @@ if ( ( (cache_ptr)->index_size !=                                           \
  *		list, and re-insert it in the data structures used by the
  *		current replacement policy.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The 2Q policy uses the data structures of the modified
+ *		LRU policy, and only differs in where entries are placed
+ *		in the LRU list.  See H5C__RP_LRU_INSERT.
  *
  * Return:      N/A
  *
@@ -3103,10 +3325,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                            \
         /* insert the entry at the head of the LRU list. */                \
                                                                            \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                         (cache_ptr)->LRU_tail_ptr,                        \
-                         (cache_ptr)->LRU_list_len,                        \
-                         (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))           \
                                                                            \
         /* Similarly, insert the entry at the head of either the clean or  \
          * dirty LRU list as appropriate.                                  \
@@ -3162,10 +3381,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
                                                                            \
         /* insert the entry at the head of the LRU list. */                \
                                                                            \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                         (cache_ptr)->LRU_tail_ptr,                        \
-                         (cache_ptr)->LRU_list_len,                        \
-                         (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))           \
                                                                            \
         /* End modified LRU specific code. */                              \
     }                                                                      \
@@ -3452,6 +3668,37 @@ typedef struct H5C_tag_info_t {
 } H5C_tag_info_t;
 
 
+/****************************************************************************
+ *
+ * structure H5C_rp_ghost_t
+ *
+ * Under the 2Q replacement policy, the cache remembers the base addresses
+ * of entries recently evicted from the cold segment of the LRU list, so
+ * that an entry loaded again shortly after its eviction can be placed in
+ * the hot segment.  Each such address is stored in an instance of
+ * H5C_rp_ghost_t on the ghost list.
+ *
+ * The fields of this structure are discussed individually below:
+ *
+ * addr: Base address of the evicted entry.
+ *
+ * size: Size of the evicted entry in bytes.
+ *
+ * next: Pointer to the next older ghost on the ghost list, or NULL if
+ * 		there is none.
+ *
+ * prev: Pointer to the next newer ghost on the ghost list, or NULL if
+ * 		there is none.
+ *
+ ****************************************************************************/
+typedef struct H5C_rp_ghost_t {
+    haddr_t addr;                       /* Address of the evicted entry */
+    size_t size;                        /* Size of the evicted entry */
+    struct H5C_rp_ghost_t *next;        /* Next older ghost */
+    struct H5C_rp_ghost_t *prev;        /* Next newer ghost */
+} H5C_rp_ghost_t;
+
+
 /****************************************************************************
  *
  * structure H5C_t
@@ -3469,7 +3716,8 @@ typedef struct H5C_tag_info_t {
  * was readily available, which reduced development time.
  *
  * While the cache was designed with multiple replacement policies in mind,
- * at present only a modified form of LRU is supported.
+ * at present only a modified form of LRU, and a form of 2Q built on top
+ * of it, are supported.
  *
  *                                              JRM - 4/26/04
  *
@@ -3611,6 +3859,52 @@ typedef struct H5C_tag_info_t {
  * 		Needless to say, this feature must be used with care.
  *
  *
+ * Every protect of an entry updates the hash table (the entry is moved to
+ * the front of its bucket) and the replacement policy (the entry is moved
+ * from the LRU list to the protected list, and back to the head of the
+ * LRU list on unprotect).  Thus even read only accesses of entries that
+ * are already in cache modify shared data structures.
+ *
+ * When the file is opened read only, this work can be deferred.  A read
+ * only protect of a clean, unpinned entry then leaves the entry on the LRU
+ * lists, and only sets fields in the entry itself (see the ro_in_lru and
+ * lru_ref_bit fields of H5C_cache_entry_t).  The LRU list is maintained
+ * approximately, in the manner of the CLOCK algorithm:  The eviction code
+ * skips entries that are protected this way, and moves entries whose
+ * lru_ref_bit is set to the head of the LRU list instead of evicting them.
+ *
+ * deferred_lru: Boolean flag that is initialized to FALSE.  When this
+ *		flag is TRUE, read only protects of clean, unpinned entries
+ *		are handled as described above, and hash table searches
+ *		don't move the target entry to the front of its bucket.
+ *
+ *		Entries protected this way are moved to the protected list
+ *		if they are pinned or resized while protected, so that
+ *		the rest of the cache need not be aware of them.  The flag
+ *		may be changed at any time.
+ *
+ * This is a prerequisite for letting several threads read from the cache
+ * at once, not an implementation of it:  Calls into the cache are still
+ * serialized by the library's API lock.  What it provides is a cache hit
+ * path for read only protects and unprotects of clean, unpinned entries
+ * that neither modifies the index nor the lists, and whose updates of the
+ * entry and the statistics are made safe against each other:
+ *
+ *	- The protect fields of such an entry (is_protected, is_read_only,
+ *	  ro_in_lru, dirtied and lru_ref_bit) are only changed by a thread
+ *	  that has swapped the entry's ro_ref_count for
+ *	  H5C__RO_REF_COUNT_BUSY, and the new count is stored when it is
+ *	  done.  The ro_ref_count thus doubles as a per entry spin lock.
+ *
+ *	- Hit rate statistics, hash table search statistics and the per
+ *	  type hit and read protect counts are updated atomically.
+ *
+ * Everything else -- misses, write protects, protects of dirty, pinned or
+ * prefetched entries, unprotects with flags, the epoch end auto resize
+ * check in H5C_protect(), evictions and flushes -- still requires that no
+ * other thread is in the cache.
+ *
+ *
  * The cache requires an index to facilitate searching for entries.  The
  * following fields support that index.
  *
@@ -3932,7 +4226,8 @@ typedef struct H5C_tag_info_t {
  * While there has been interest in several replacement policies for
  * this cache, the initial development schedule is tight.  Thus I have
  * elected to support only a modified LRU (least recently used) policy 
- * for the first cut.
+ * for the first cut.  A 2Q policy, which shares the data structures of
+ * the modified LRU, has since been added.
  *
  * To further simplify matters, I have simply included the fields needed
  * by the modified LRU in this structure.  When and if we add support for
@@ -4043,6 +4338,66 @@ typedef struct H5C_tag_info_t {
  *              This field is NULL if the list is empty.
  *
  *
+ * Fields supporting the 2Q policy:
+ *
+ * The modified LRU policy evicts the least recently used entries first,
+ * so that a pass over many entries each used once -- as when iterating
+ * over a large group -- flushes out the whole working set of the cache.
+ *
+ * The 2Q policy avoids this by dividing the LRU list into two segments: a
+ * hot segment at the head, and a cold (probationary) segment at the tail.
+ * Both are kept in LRU order, and since eviction scans the LRU list from
+ * its tail, cold entries are evicted before hot ones.
+ *
+ * Entries enter the cache cold.  When a cold entry is evicted to make
+ * space in the cache, its address is placed on the ghost list, and an
+ * entry loaded while its address is on the ghost list enters the cache
+ * hot.  Hot entries stay hot while they are used, until the hot segment
+ * grows beyond H5C__2Q_HOT_SIZE_PERCENT percent of max_cache_size, at
+ * which point its least recently used entries are moved to the cold
+ * segment.  The ghost list covers at most H5C__2Q_GHOST_SIZE_PERCENT
+ * percent of max_cache_size, and holds at most index_len addresses.
+ *
+ * As the hot segment is contiguous with the cold segment, moving entries
+ * between the segments is just a matter of moving the boundary between
+ * them.  Epoch markers are inserted at the head of the cold segment, so
+ * the age out code only ever evicts cold entries.  As the boundary moves,
+ * markers may end up in the hot segment, but are never hot themselves.
+ *
+ * The clean and dirty LRU lists are maintained as under the modified LRU
+ * policy, and so are not segmented.
+ *
+ * The policy can be changed at any time.  On a switch to 2Q, all entries
+ * in the cache become hot.
+ *
+ * rp_mode:	Replacement policy currently in effect.  This field is
+ *		H5C_rp__lru unless the policy has been set to H5C_rp__2q,
+ *		in which case the remaining fields in this section are used.
+ *
+ * rp_hot_size:	Number of bytes of hot entries on the LRU list.
+ *
+ * rp_cold_head_ptr:  Pointer to the first entry of the cold segment of the
+ *		LRU list.  All cache entries on the LRU list before this
+ *		entry are hot, and all from it on are cold.
+ *
+ *		This field is NULL if the cold segment is empty.
+ *
+ * rp_ghost_slist_ptr:  Pointer to the skip list used to look up addresses
+ *		on the ghost list, or NULL when the 2Q policy is not in
+ *		effect.
+ *
+ * rp_ghost_len:  Number of addresses on the ghost list.
+ *
+ * rp_ghost_size:  Sum of the sizes of the evicted entries whose addresses
+ *		are on the ghost list.
+ *
+ * rp_ghost_head_ptr:  Pointer to the newest ghost on the ghost list, or
+ *		NULL if the list is empty.
+ *
+ * rp_ghost_tail_ptr:  Pointer to the oldest ghost on the ghost list, or
+ *		NULL if the list is empty.
+ *
+ *
  * Automatic cache size adjustment:
  *
  * While the default cache size is adequate for most cases, we can run into
@@ -4689,6 +5044,7 @@ struct H5C_t {
     hbool_t			write_permitted;
     H5C_log_flush_func_t	log_flush;
     hbool_t			evictions_enabled;
+    hbool_t			deferred_lru;
     hbool_t			close_warning_received;
 
     /* Fields for maintaining [hash table] index of entries */
@@ -4760,6 +5116,16 @@ struct H5C_t {
     H5C_cache_entry_t *	        dLRU_tail_ptr;
 #endif /* H5C_MAINTAIN_CLEAN_AND_DIRTY_LRU_LISTS */
 
+    /* Fields for the 2Q replacement policy */
+    enum H5C_cache_rp_mode      rp_mode;
+    size_t                      rp_hot_size;
+    H5C_cache_entry_t *         rp_cold_head_ptr;
+    H5SL_t *                    rp_ghost_slist_ptr;
+    uint32_t                    rp_ghost_len;
+    size_t                      rp_ghost_size;
+    H5C_rp_ghost_t *            rp_ghost_head_ptr;
+    H5C_rp_ghost_t *            rp_ghost_tail_ptr;
+
 #ifdef H5_HAVE_PARALLEL
     /* Fields for collective metadata reads */
     uint32_t                    coll_list_len;
@@ -4943,6 +5309,11 @@ H5_DLL herr_t H5C__serialize_cache(H5F_t *f);
 H5_DLL herr_t H5C__iter_tagged_entries(H5C_t *cache, haddr_t tag, hbool_t match_global,
     H5C_tag_iter_cb_t cb, void *cb_ctx);
 
+/* Routines supporting the 2Q replacement policy */
+H5_DLL herr_t H5C__rp_2q_remember_ghost(H5C_t *cache_ptr,
+    const H5C_cache_entry_t *entry_ptr);
+H5_DLL hbool_t H5C__rp_2q_forget_ghost(H5C_t *cache_ptr, haddr_t addr);
+
 /* Routines for operating on entry tags */
 H5_DLL herr_t H5C__tag_entry(H5C_t * cache_ptr, H5C_cache_entry_t * entry_ptr);
 H5_DLL herr_t H5C__untag_entry(H5C_t *cache, H5C_cache_entry_t *entry);
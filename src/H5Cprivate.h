@@ -39,7 +39,7 @@
 /**************************/
 
 /* Cache configuration settings */
-#define H5C__MAX_NUM_TYPE_IDS   30
+#define H5C__MAX_NUM_TYPE_IDS   31
 #define H5C__PREFIX_LEN         32
 
 /* This sanity checking constant was picked out of the air.  Increase
@@ -66,6 +66,7 @@
 /* Flags for cache client class behavior */
 #define H5C__CLASS_NO_FLAGS_SET             ((unsigned)0x0)
 #define H5C__CLASS_SPECULATIVE_LOAD_FLAG    ((unsigned)0x1)
+#define H5C__CLASS_THREADED_SERIALIZE_FLAG  ((unsigned)0x8)
 /* The following flags may only appear in test code */
 #define H5C__CLASS_SKIP_READS               ((unsigned)0x2)
 #define H5C__CLASS_SKIP_WRITES              ((unsigned)0x4)
@@ -184,6 +185,7 @@
  *      H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG
  *      H5C__GENERATE_IMAGE_FLAG
  *      H5C__UPDATE_PAGE_BUFFER_FLAG
+ *      H5C__IMAGE_WRITTEN_FLAG
  */
 #define H5C__NO_FLAGS_SET			0x00000
 #define H5C__SET_FLUSH_MARKER_FLAG		0x00001
@@ -205,6 +207,7 @@
 #define H5C__DURING_FLUSH_FLAG                  0x10000 /* Set when the entire cache is being flushed */
 #define H5C__GENERATE_IMAGE_FLAG                0x20000 /* Set during parallel I/O */
 #define H5C__UPDATE_PAGE_BUFFER_FLAG            0x40000 /* Set during parallel I/O */
+#define H5C__IMAGE_WRITTEN_FLAG                 0x80000 /* Set when the image was written with adjacent entries */
 
 /* Debugging/sanity checking/statistics settings */
 #ifndef NDEBUG
@@ -315,6 +318,17 @@ typedef struct H5C_t H5C_t;
  *		read past the end of file, the size is truncated to 
  *		avoid this, and processing proceeds as normal.
  *
+ *	H5C__CLASS_THREADED_SERIALIZE_FLAG: This flag is used only in
+ *		H5C__flush_ring().  When it is set, the serialize callback
+ *		may be called for several entries of the class at once,
+ *		from threads other than the one flushing the cache (see
+ *		H5Pset_mdc_flush_threads()).  It may only be set for
+ *		classes with no pre-serialize callback, whose serialize
+ *		callback only encodes the entry into its image -- reading
+ *		the entry, the file's settings and other entries which
+ *		can't change during the flush, but not modifying anything
+ *		other than the image or calling into the cache.
+ *
  *      The following flags may only appear in test code.
  *
  *	H5C__CLASS_SKIP_READS: This flags is intended only for use in test
@@ -1055,7 +1069,9 @@ typedef int H5C_ring_t;
  *		conventional terms).
  *
  *		Note that protected entries are removed from the LRU lists
- *		and inserted on the protected list.
+ *		and inserted on the protected list -- unless the entry was
+ *		protected read only with deferred LRU updates in effect.
+ *		See ro_in_lru below.
  *
  * is_read_only: Boolean flag that is only meaningful if is_protected is
  * 		TRUE.  In this circumstance, it indicates whether the
@@ -1075,6 +1091,32 @@ typedef int H5C_ring_t;
  * 		must be zero whenever either is_protected or is_read_only
  * 		are TRUE.
  *
+ *		On the read only protect path of entries that stay on the
+ *		LRU lists, this field is accessed atomically, and holds
+ *		H5C__RO_REF_COUNT_BUSY while a thread changes the entry's
+ *		protect fields.  See the discussion of deferred_lru
+ *		in H5Cpkg.h.
+ *
+ * ro_in_lru:	Boolean flag indicating that the entry has been protected
+ *		read only while deferred LRU updates are in effect, and
+ *		has thus been left on the LRU lists instead of being
+ *		moved to the protected list.  This field must be FALSE
+ *		whenever is_read_only is FALSE.
+ *
+ *		The flag is cleared when the entry is unprotected, or when
+ *		it is moved to the protected list after all, as happens
+ *		if the entry is pinned or resized while protected.  See
+ *		the discussion of deferred_lru in H5Cpkg.h.
+ *
+ * lru_ref_bit:	Boolean flag set when an entry protected with ro_in_lru
+ *		set is unprotected (with the entry's ro_ref_count held, as
+ *		above).  As the entry was not moved to the
+ *		head of the LRU list, the flag records that it has been
+ *		used since it was last placed there.  When the eviction
+ *		code finds an entry with this flag set, it clears the flag
+ *		and moves the entry to the head of the LRU list instead of
+ *		evicting it.
+ *
  * is_pinned:	Boolean flag indicating whether the entry has been pinned
  * 		in the cache.
  *
@@ -1332,6 +1374,24 @@ typedef int H5C_ring_t;
  *		In either case, when there is no previous item, it should 
  *		be NULL.
  *
+ * 2Q:
+ *
+ * The 2Q policy keeps the LRU list above, but divides it into a hot
+ * segment at the head and a cold (probationary) segment at the tail.
+ * Entries in the cold segment are evicted first.  See the comments on
+ * H5C_t in H5Cpkg.h for more details.
+ *
+ * The next, prev, aux_next and aux_prev fields are used as under the
+ * Modified LRU policy.  In addition:
+ *
+ * rp_hot:	Boolean flag indicating whether the entry belongs to the 
+ *		hot segment of the LRU list.  The flag is kept while the 
+ *		entry is protected or pinned, so that it returns to the 
+ *		same segment when it is unprotected or unpinned.
+ *
+ *		The field is only meaningful when the 2Q policy is in 
+ *		effect.
+ *
  * Fields supporting the cache image feature:
  *
  * The following fields are used to store data about the entry which must 
@@ -1607,6 +1667,8 @@ typedef struct H5C_cache_entry_t {
     hbool_t			is_protected;
     hbool_t			is_read_only;
     int				ro_ref_count;
+    hbool_t			ro_in_lru;
+    hbool_t			lru_ref_bit;
     hbool_t			is_pinned;
     hbool_t			in_slist;
     hbool_t			flush_marker;
@@ -1649,6 +1711,7 @@ typedef struct H5C_cache_entry_t {
     struct H5C_cache_entry_t   *coll_next;
     struct H5C_cache_entry_t   *coll_prev;
 #endif /* H5_HAVE_PARALLEL */
+    hbool_t                     rp_hot;
 
     /* fields supporting cache image */
     hbool_t                     include_in_image;
@@ -2243,6 +2306,7 @@ H5_DLL herr_t H5C_evict(H5F_t *f);
 H5_DLL herr_t H5C_expunge_entry(H5F_t *f, const H5C_class_t *type, haddr_t addr,
     unsigned flags);
 H5_DLL herr_t H5C_flush_cache(H5F_t *f, unsigned flags);
+H5_DLL void H5C_stop_serialize_threads(void);
 H5_DLL herr_t H5C_flush_tagged_entries(H5F_t *f, haddr_t tag); 
 H5_DLL herr_t H5C_force_cache_image_load(H5F_t * f);
 H5_DLL herr_t H5C_evict_tagged_entries(H5F_t *f, haddr_t tag, hbool_t match_global);
@@ -2266,6 +2330,9 @@ H5_DLL herr_t H5C_get_entry_status(const H5F_t *f, haddr_t addr,
     hbool_t *is_flush_dep_parent_ptr, hbool_t *is_flush_dep_child_ptr,
     hbool_t *image_up_to_date_ptr);
 H5_DLL herr_t H5C_get_evictions_enabled(const H5C_t *cache_ptr, hbool_t *evictions_enabled_ptr);
+H5_DLL herr_t H5C_get_deferred_lru(const H5C_t *cache_ptr, hbool_t *deferred_lru_ptr);
+H5_DLL herr_t H5C_get_replacement_policy(const H5C_t *cache_ptr,
+    enum H5C_cache_rp_mode *policy_ptr);
 H5_DLL void * H5C_get_aux_ptr(const H5C_t *cache_ptr);
 H5_DLL FILE *H5C_get_trace_file_ptr(const H5C_t *cache_ptr);
 H5_DLL FILE *H5C_get_trace_file_ptr_from_entry(const H5C_cache_entry_t *entry_ptr);
@@ -2291,6 +2358,9 @@ H5_DLL herr_t H5C_set_cache_auto_resize_config(H5C_t *cache_ptr, H5C_auto_size_c
 H5_DLL herr_t H5C_set_cache_image_config(const H5F_t *f, H5C_t *cache_ptr,
     H5C_cache_image_ctl_t *config_ptr);
 H5_DLL herr_t H5C_set_evictions_enabled(H5C_t *cache_ptr, hbool_t evictions_enabled);
+H5_DLL herr_t H5C_set_deferred_lru(H5C_t *cache_ptr, hbool_t deferred_lru);
+H5_DLL herr_t H5C_set_replacement_policy(H5C_t *cache_ptr,
+    enum H5C_cache_rp_mode policy);
 H5_DLL herr_t H5C_set_prefix(H5C_t *cache_ptr, char *prefix);
 H5_DLL herr_t H5C_set_trace_file_ptr(H5C_t *cache_ptr, FILE *trace_file_ptr);
 H5_DLL herr_t H5C_stats(H5C_t *cache_ptr, const char *cache_name,
@@ -321,6 +321,67 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_get_evictions_enabled() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_get_deferred_lru()
+ *
+ * Purpose:     Copy the current value of cache_ptr->deferred_lru into
+ *              *deferred_lru_ptr.
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_get_deferred_lru(const H5C_t *cache_ptr, hbool_t *deferred_lru_ptr)
+{
+    herr_t ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if((cache_ptr == NULL ) || (cache_ptr->magic != H5C__H5C_T_MAGIC))
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry.")
+
+    if(deferred_lru_ptr == NULL)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad deferred_lru_ptr on entry.")
+
+    *deferred_lru_ptr = cache_ptr->deferred_lru;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_get_deferred_lru() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_get_replacement_policy()
+ *
+ * Purpose:     Copy the replacement policy currently in effect into
+ *              *policy_ptr.
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_get_replacement_policy(const H5C_t *cache_ptr,
+                           enum H5C_cache_rp_mode * policy_ptr)
+{
+    herr_t ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if((cache_ptr == NULL ) || (cache_ptr->magic != H5C__H5C_T_MAGIC))
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry.")
+
+    if(policy_ptr == NULL)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad policy_ptr on entry.")
+
+    *policy_ptr = cache_ptr->rp_mode;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_get_replacement_policy() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5C_get_aux_ptr
@@ -121,6 +121,9 @@ static herr_t H5D__bt2_idx_create(const H5D_chk_idx_info_t *idx_info);
 static hbool_t H5D__bt2_idx_is_space_alloc(const H5O_storage_chunk_t *storage);
 static herr_t H5D__bt2_idx_insert(const H5D_chk_idx_info_t *idx_info,
     H5D_chunk_ud_t *udata, const H5D_t *dset);
+static herr_t H5D__bt2_idx_bulk_begin(const H5D_chk_idx_info_t *idx_info,
+    hsize_t nchunks);
+static herr_t H5D__bt2_idx_bulk_end(const H5D_chk_idx_info_t *idx_info);
 static herr_t H5D__bt2_idx_get_addr(const H5D_chk_idx_info_t *idx_info,
     H5D_chunk_ud_t *udata);
 static int H5D__bt2_idx_iterate(const H5D_chk_idx_info_t *idx_info,
@@ -150,6 +153,8 @@ const H5D_chunk_ops_t H5D_COPS_BT2[1] = {{
     H5D__bt2_idx_create,                /* create */
     H5D__bt2_idx_is_space_alloc,        /* is_space_alloc */
     H5D__bt2_idx_insert,                /* insert */
+    H5D__bt2_idx_bulk_begin,            /* bulk_begin */
+    H5D__bt2_idx_bulk_end,              /* bulk_end */
     H5D__bt2_idx_get_addr,              /* get_addr */
     NULL,                               /* resize */
     H5D__bt2_idx_iterate,               /* iterate */
@@ -948,6 +953,83 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__bt2_idx_insert() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__bt2_idx_bulk_begin
+ *
+ * Purpose:	Announce that NCHUNKS new chunks are about to be inserted,
+ *		in index order, so that an empty v2 B-tree can be bulk
+ *		loaded with them.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__bt2_idx_bulk_begin(const H5D_chk_idx_info_t *idx_info, hsize_t nchunks)
+{
+    herr_t ret_value = SUCCEED;		/* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->storage);
+    HDassert(H5F_addr_defined(idx_info->storage->idx_addr));
+
+    /* Check if the v2 B-tree is open yet */
+    if(NULL == idx_info->storage->u.btree2.bt2) {
+	/* Open existing v2 B-tree */
+        if(H5D__bt2_idx_open(idx_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPENOBJ, FAIL, "can't open v2 B-tree")
+    } /* end if */
+    else  /* Patch the top level file pointer contained in bt2 if needed */
+	if(H5B2_patch_file(idx_info->storage->u.btree2.bt2, idx_info->f) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPENOBJ, FAIL, "can't patch v2 B-tree file pointer")
+
+    if(H5B2_bulk_begin(idx_info->storage->u.btree2.bt2, nchunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to start bulk load of v2 B-tree")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__bt2_idx_bulk_begin() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__bt2_idx_bulk_end
+ *
+ * Purpose:	Finish inserting the chunks announced with
+ *		H5D__bt2_idx_bulk_begin.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__bt2_idx_bulk_end(const H5D_chk_idx_info_t *idx_info)
+{
+    herr_t ret_value = SUCCEED;		/* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(idx_info);
+    HDassert(idx_info->storage);
+
+    if(idx_info->storage->u.btree2.bt2) {
+        /* Patch the top level file pointer contained in bt2 if needed */
+	if(H5B2_patch_file(idx_info->storage->u.btree2.bt2, idx_info->f) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPENOBJ, FAIL, "can't patch v2 B-tree file pointer")
+
+        if(H5B2_bulk_end(idx_info->storage->u.btree2.bt2) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to finish bulk load of v2 B-tree")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__bt2_idx_bulk_end() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__bt2_found_cb
@@ -1043,11 +1125,11 @@ H5D__bt2_idx_get_addr(const H5D_chk_idx_info_t *idx_info, H5D_chunk_ud_t *udata)
 
     /* Check for setting other info */
     if(H5F_addr_defined(udata->chunk_block.offset)) {
-        /* Sanity check */
-        HDassert(0 != found_rec.nbytes);
-
         /* Set other info for the chunk */
         if(idx_info->pline->nused > 0) { /* filtered chunk */
+            /* Sanity check */
+            HDassert(0 != found_rec.nbytes);
+
             udata->chunk_block.length = found_rec.nbytes;
             udata->filter_mask = found_rec.filter_mask;
         } /* end if */
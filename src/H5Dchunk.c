@@ -79,7 +79,8 @@
              (H5D_CHUNK_IDX_BT2 == storage->idx_type && H5D_COPS_BT2 == storage->ops) ||        \
              (H5D_CHUNK_IDX_BTREE == storage->idx_type && H5D_COPS_BTREE == storage->ops) ||    \
              (H5D_CHUNK_IDX_SINGLE == storage->idx_type && H5D_COPS_SINGLE == storage->ops) ||  \
-             (H5D_CHUNK_IDX_NONE == storage->idx_type && H5D_COPS_NONE == storage->ops));
+             (H5D_CHUNK_IDX_NONE == storage->idx_type && H5D_COPS_NONE == storage->ops) ||      \
+             (H5D_CHUNK_IDX_SHARD == storage->idx_type && H5D_COPS_SHARD == storage->ops));
 
 /*
  * Feature: If this constant is defined then every cache preemption and load
@@ -92,10 +93,6 @@
  *
  *     `:': Entry was preempted because it hasn't been used recently.
  *
- *     `#': Entry was preempted because another chunk collided with it. This
- *	    is usually a relatively bad thing.  If there are too many of
- *	    these then the number of entries in the cache can be increased.
- *
  *       c: Entry was preempted because the file is closing.
  *
  *	 w: A chunk read operation was eliminated because the library is
@@ -112,6 +109,37 @@
 #define H5D_RDCC_NEWLY_DISABLED_FILTERS 0x02u   /* Filters have been disabled since
                                                  * the last flush */
 
+/* # of chunks per filter thread in a batch of chunks whose filter pipelines
+ * run at once (bounds the memory held by a batch) */
+#define H5D_CHUNK_BATCH_PER_THREAD 4
+
+/* When pruning the chunk cache has to write out a dirty chunk, the least
+ * recently used chunks in this fraction of the cache are written out
+ * together, so their writes can be combined */
+#define H5D_RDCC_PRUNE_FLUSH_DIV 4
+
+/* Automatic chunk cache sizing (see H5D__chunk_cache_auto_resize).  The
+ * cache is resized after every epoch of this many chunk accesses... */
+#define H5D_RDCC_AUTO_EPOCH_LENGTH 64
+/* ...doubling when its hit rate in the epoch is below this... */
+#define H5D_RDCC_AUTO_LOWER_HR 0.9
+/* ...and at least one access in this many missed a chunk preempted
+ * recently, i.e. one of the last H5D_RDCC_AUTO_NGHOSTS chunks preempted... */
+#define H5D_RDCC_AUTO_GHOST_DIV 10
+#define H5D_RDCC_AUTO_NGHOSTS 256
+/* ...and halving when the entries used in the epoch fill less than this
+ * fraction of it */
+#define H5D_RDCC_AUTO_SHRINK_DIV 4
+
+/* Marks a chunk cache hash table slot whose entry was removed, so searches
+ * for entries stored further along the slot's probe sequence carry on past
+ * it (see H5D__chunk_cache_find) */
+#define H5D_RDCC_SLOT_DELETED (&H5D_rdcc_slot_deleted_g)
+
+/* Chunks of datasets with an implicit index that are next to each other in
+ * the file are filled with fill values in writes of up to this many bytes */
+#define H5D_CHUNK_FILL_RUN_NBYTES (1024 * 1024)
+
 
 /******************/
 /* Local Typedefs */
@@ -122,6 +150,8 @@ typedef struct H5D_rdcc_ent_t {
     hbool_t	locked;		/*entry is locked in cache		*/
     hbool_t	dirty;		/*needs to be written to disk?		*/
     hbool_t     deleted;        /*chunk about to be deleted		*/
+    hbool_t     prewritten;     /*dirty until written out for preemption */
+    unsigned    epoch;          /*last automatic sizing epoch it was used in */
     unsigned    edge_chunk_state; /*states related to edge chunks (see above) */
     hsize_t 	scaled[H5O_LAYOUT_NDIMS]; /*scaled chunk 'name' (coordinates) */
     uint32_t	rd_count;	/*bytes remaining to be read		*/
@@ -130,13 +160,25 @@ typedef struct H5D_rdcc_ent_t {
     hsize_t     chunk_idx;  	/*index of chunk in dataset             */
     uint8_t	*chunk;		/*the unfiltered chunk data		*/
     unsigned	idx;		/*index in hash table			*/
+    H5D_rdcc_t  *rdcc;          /*chunk cache the entry belongs to	*/
     struct H5D_rdcc_ent_t *next;/*next item in doubly-linked list	*/
     struct H5D_rdcc_ent_t *prev;/*previous item in doubly-linked list	*/
-    struct H5D_rdcc_ent_t *tmp_next;/*next item in temporary doubly-linked list */
-    struct H5D_rdcc_ent_t *tmp_prev;/*previous item in temporary doubly-linked list */
+    struct H5D_rdcc_ent_t *pool_next;/*next item in shared pool's doubly-linked list */
+    struct H5D_rdcc_ent_t *pool_prev;/*previous item in shared pool's doubly-linked list */
 } H5D_rdcc_ent_t;
 typedef H5D_rdcc_ent_t *H5D_rdcc_ent_ptr_t; /* For free lists */
 
+/* Byte budget shared by the chunk caches of all the datasets open in a file */
+typedef struct H5D_rdcc_pool_t {
+    size_t      nbytes_max;     /* Maximum raw data cached by all the datasets, in bytes */
+    size_t      nbytes_used;    /* Current raw data cached by all the datasets, in bytes */
+    int         nused;          /* Number of entries cached by all the datasets */
+    double      w0;             /* Chunk preemption policy */
+    unsigned    nusers;         /* Number of chunk caches sharing the budget */
+    H5D_rdcc_ent_t *head;       /* Least recently used entry of all the datasets */
+    H5D_rdcc_ent_t *tail;       /* Most recently used entry of all the datasets */
+} H5D_rdcc_pool_t;
+
 /* Callback info for iteration to prune chunks */
 typedef struct H5D_chunk_it_ud1_t {
     H5D_chunk_common_ud_t common;       /* Common info for B-tree user data (must be first) */
@@ -224,6 +266,54 @@ typedef struct H5D_chunk_file_iter_ud_t {
 #endif /* H5_HAVE_PARALLEL */
 } H5D_chunk_file_iter_ud_t;
 
+/* A chunk in a batch of direct chunk I/O, of chunks read ahead, or of
+ * dirty chunks flushed */
+typedef struct H5D_chunk_direct_ent_t {
+    size_t              idx;                    /* Position of the chunk in the batch */
+    hsize_t             chunk_idx;              /* Linear index of the chunk in the dataset */
+    hsize_t             scaled[H5O_LAYOUT_NDIMS];   /* Scaled coordinates of the chunk */
+    H5D_chunk_ud_t      udata;                  /* Chunk info from the index */
+    hbool_t             need_insert;            /* Whether the chunk must be inserted into the index */
+} H5D_chunk_direct_ent_t;
+
+/* Callback info for iteration to query chunks in bulk */
+typedef struct H5D_chunk_info_iter_ud_t {
+    /* down */
+    const H5D_t         *dset;                  /* Dataset whose chunks are iterated over */
+    H5S_t               *space;                 /* Selection chunks must intersect, or NULL for all chunks */
+    hsize_t             chunk_idx;              /* Index of the chunk to return (H5D__get_chunk_info) */
+    H5D_chunk_iter_op_t op;                     /* Application callback (H5D__chunk_iter) */
+    void                *op_data;               /* Application callback's user data */
+
+    /* up */
+    int                 op_ret;                 /* Application callback's last return value */
+    hsize_t             nchunks;                /* # of chunks which matched so far */
+    hbool_t             found;                  /* Whether the chunk at chunk_idx was found */
+    hsize_t             offset[H5O_LAYOUT_NDIMS];   /* Logical offset of the chunk found */
+    unsigned            filter_mask;            /* Filter mask of the chunk found */
+    haddr_t             addr;                   /* File address of the chunk found */
+    hsize_t             size;                   /* Size in the file of the chunk found */
+} H5D_chunk_info_iter_ud_t;
+
+/* A chunk in a batch of chunks to read or write */
+typedef struct H5D_chunk_batch_ent_t {
+    H5D_chunk_ud_t udata;               /* Chunk info from the index */
+    H5Z_pipeline_job_t *job;            /* Chunk's filter pipeline job, or NULL if the chunk isn't filtered with the batch */
+} H5D_chunk_batch_ent_t;
+
+/* Batch of chunks whose filter pipelines run on several threads at once */
+typedef struct H5D_chunk_batch_t {
+    unsigned nthreads;                  /* # of threads to run the pipeline on (1 if chunks aren't batched) */
+    H5Z_EDC_t err_detect;               /* Error detection info */
+    H5Z_cb_t filter_cb;                 /* I/O filter callback function */
+    size_t max_chunks;                  /* Max. # of chunks in a batch */
+    size_t nchunks;                     /* # of chunks in the current batch */
+    size_t curr;                        /* Next chunk in the batch to operate on */
+    H5D_chunk_batch_ent_t *ents;        /* Chunks in the batch */
+    size_t njobs;                       /* # of chunks in the batch to filter */
+    H5Z_pipeline_job_t *jobs;           /* Filter pipeline jobs for the batch */
+} H5D_chunk_batch_t;
+
 #ifdef H5_HAVE_PARALLEL
 /* information to construct a collective I/O operation for filling chunks */
 typedef struct H5D_chunk_coll_info_t {
@@ -261,6 +351,19 @@ H5D__nonexistent_readvv(const H5D_io_info_t *io_info,
 /* format convert cb */
 static int H5D__chunk_format_convert_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
 
+/* Direct chunk I/O batch routines */
+static int H5D__chunk_direct_cmp_idx(const void *_ent1, const void *_ent2);
+static int H5D__chunk_direct_cmp_addr(const void *_ent1, const void *_ent2);
+static herr_t H5D__chunk_direct_batch_init(const H5D_t *dset,
+    const H5D_direct_chunk_batch_t *batch, hbool_t write,
+    H5D_chunk_direct_ent_t **ents_out, H5D_chunk_direct_ent_t ***order_out);
+
+/* Bulk chunk query routines */
+static htri_t H5D__chunk_info_intersect(const H5D_t *dset, H5S_t *space,
+    const hsize_t *offset);
+static int H5D__chunk_info_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static herr_t H5D__chunk_info_iterate(H5D_t *dset, H5D_chunk_info_iter_ud_t *udata);
+
 /* Helper routines */
 static herr_t H5D__chunk_set_info_real(H5O_layout_chunk_t *layout, unsigned ndims,
     const hsize_t *curr_dims, const hsize_t *max_dims);
@@ -284,17 +387,56 @@ static herr_t H5D__chunk_file_cb(void *elem, const H5T_t *type, unsigned ndims,
 static herr_t H5D__chunk_mem_cb(void *elem, const H5T_t *type, unsigned ndims,
     const hsize_t *coords, void *fm);
 static unsigned H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled);
+static unsigned H5D__chunk_cache_find(const H5D_shared_t *shared,
+    const hsize_t *scaled, unsigned *free_idx);
+static herr_t H5D__chunk_cache_rehash(H5D_shared_t *shared, size_t nslots_alloc);
+static herr_t H5D__chunk_cache_free_slot(H5D_shared_t *shared,
+    const hsize_t *scaled, unsigned *idx);
+static void H5D__chunk_pool_remove(H5D_rdcc_pool_t *pool, H5D_rdcc_ent_t *ent);
+static void H5D__chunk_pool_append(const H5D_t *dset, H5D_rdcc_ent_t *ent);
+static herr_t H5D__chunk_pool_prune(H5D_rdcc_pool_t *pool, size_t size);
 static herr_t H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent,
     hbool_t reset);
+static herr_t H5D__chunk_flush_batch(const H5D_t *dset, H5D_rdcc_ent_t *first,
+    size_t nbytes);
+static herr_t H5D__chunk_write_block(const H5D_t *dset, H5D_chunk_ud_t *udata,
+    const H5F_block_t *old_chunk, hsize_t *scaled, const void *buf);
 static herr_t H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent,
     hbool_t flush);
 static hbool_t H5D__chunk_is_partial_edge_chunk(unsigned dset_ndims,
     const uint32_t *chunk_dims, const hsize_t *chunk_scaled, const hsize_t *dset_dims);
 static void *H5D__chunk_lock(const H5D_io_info_t *io_info,
-    H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk);
+    H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk,
+    void *prefetched);
 static herr_t H5D__chunk_unlock(const H5D_io_info_t *io_info,
     const H5D_chunk_ud_t *udata, hbool_t dirty, void *chunk, uint32_t naccessed);
+static void H5D__chunk_cache_mark_prewritten(const H5D_t *dset,
+    H5D_rdcc_ent_t *first, size_t nbytes, hbool_t mark);
 static herr_t H5D__chunk_cache_prune(const H5D_t *dset, size_t size);
+static void H5D__chunk_cache_count_evict(const H5D_t *dset,
+    const H5D_rdcc_ent_t *ent);
+static hbool_t H5D__chunk_cache_ghost_hit(const H5D_t *dset,
+    const hsize_t *scaled);
+static void H5D__chunk_cache_auto_resize(const H5D_t *dset);
+static herr_t H5D__chunk_batch_init(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, H5D_chunk_batch_t *batch);
+static herr_t H5D__chunk_batch_read(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, H5SL_node_t *chunk_node, H5D_chunk_batch_t *batch);
+static herr_t H5D__chunk_batch_write(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, const H5D_chunk_map_t *fm,
+    H5SL_node_t *chunk_node, H5D_io_info_t *cpt_io_info, H5D_chunk_batch_t *batch);
+static herr_t H5D__chunk_batch_term(const H5D_t *dset, H5D_chunk_batch_t *batch);
+static herr_t H5D__chunk_cache_load(const H5D_io_info_t *io_info,
+    H5D_chunk_direct_ent_t *ents, size_t nchunks);
+static herr_t H5D__chunk_read_ahead(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, hsize_t chunk_idx);
+static htri_t H5D__chunk_read_shard(const H5D_io_info_t *io_info,
+    const hsize_t scaled[]);
+static htri_t H5D__chunk_read_direct(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, const H5D_chunk_info_t *chunk_info,
+    const H5D_chunk_ud_t *udata, H5Z_pipeline_job_t *job);
+static htri_t H5D__chunk_whole_sel(const H5S_t *space, size_t elmt_size,
+    size_t nelmts, size_t nbytes, hsize_t *off);
 static herr_t H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk);
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__chunk_collective_fill(const H5D_t *dset, 
@@ -357,6 +499,12 @@ H5FL_SEQ_DEFINE_STATIC(H5D_rdcc_ent_ptr_t);
 /* Declare a free list to manage H5D_rdcc_ent_t objects */
 H5FL_DEFINE_STATIC(H5D_rdcc_ent_t);
 
+/* Declare a free list to manage H5D_rdcc_pool_t objects */
+H5FL_DEFINE_STATIC(H5D_rdcc_pool_t);
+
+/* Target of the pointer marking deleted chunk cache hash table slots */
+static H5D_rdcc_ent_t H5D_rdcc_slot_deleted_g;
+
 /* Declare a free list to manage the H5D_chunk_info_t struct */
 H5FL_DEFINE(H5D_chunk_info_t);
 
@@ -533,7 +681,7 @@ H5D__chunk_direct_read(const H5D_t *dset, hsize_t *offset, uint32_t* filters,
         hbool_t flush;
 
         /* Sanity checks  */
-        HDassert(udata.idx_hint < rdcc->nslots);
+        HDassert(udata.idx_hint < rdcc->nslots_alloc);
         HDassert(rdcc->slot[udata.idx_hint]);
 
         flush = (ent->dirty == TRUE) ? TRUE : FALSE;
@@ -568,6 +716,388 @@ done:
     FUNC_LEAVE_NOAPI_VOL_TAG(ret_value)
 } /* end H5D__chunk_direct_read() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_cmp_idx
+ *
+ * Purpose:     Compare two chunks of a direct chunk I/O batch by their
+ *              linear index in the dataset, for HDqsort().
+ *
+ * Return:      An integer less than, equal to or greater than zero
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_direct_cmp_idx(const void *_ent1, const void *_ent2)
+{
+    const H5D_chunk_direct_ent_t *ent1 = (const H5D_chunk_direct_ent_t *)_ent1;
+    const H5D_chunk_direct_ent_t *ent2 = (const H5D_chunk_direct_ent_t *)_ent2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    FUNC_LEAVE_NOAPI((ent1->chunk_idx > ent2->chunk_idx) - (ent1->chunk_idx < ent2->chunk_idx))
+} /* end H5D__chunk_direct_cmp_idx() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_cmp_addr
+ *
+ * Purpose:     Compare two chunks of a direct chunk I/O batch, given by
+ *              pointer, by their address in the file, for HDqsort().
+ *
+ * Return:      An integer less than, equal to or greater than zero
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_direct_cmp_addr(const void *_ent1, const void *_ent2)
+{
+    const H5D_chunk_direct_ent_t *ent1 = *(const H5D_chunk_direct_ent_t * const *)_ent1;
+    const H5D_chunk_direct_ent_t *ent2 = *(const H5D_chunk_direct_ent_t * const *)_ent2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    FUNC_LEAVE_NOAPI(H5F_addr_cmp(ent1->udata.chunk_block.offset, ent2->udata.chunk_block.offset))
+} /* end H5D__chunk_direct_cmp_addr() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_batch_init
+ *
+ * Purpose:     Check the offsets of a batch of chunks for direct chunk
+ *              I/O and set up an entry for each chunk, sorted by the
+ *              chunk's linear index so that the chunk index is visited
+ *              in order.  Duplicate offsets are an error for writes.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_direct_batch_init(const H5D_t *dset, const H5D_direct_chunk_batch_t *batch,
+    hbool_t write, H5D_chunk_direct_ent_t **ents_out, H5D_chunk_direct_ent_t ***order_out)
+{
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);   /* Dataset's chunk layout */
+    unsigned ndims = dset->shared->ndims;   /* Rank of dataset */
+    H5D_chunk_direct_ent_t *ents = NULL;    /* Entries for the chunks */
+    H5D_chunk_direct_ent_t **order = NULL;  /* Entries in file address order */
+    size_t u;                           /* Local index variable */
+    unsigned v;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(batch);
+    HDassert(ents_out);
+    HDassert(order_out);
+
+    if(NULL == batch->offsets)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk offsets")
+    if(write ? (NULL == batch->sizes || NULL == batch->wbufs) : (NULL == batch->filters_out || NULL == batch->rbufs))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk buffers")
+    if(batch->nchunks > (size_t)UINT32_MAX)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "too many chunks in batch")
+
+    if(NULL == (ents = (H5D_chunk_direct_ent_t *)H5MM_calloc(batch->nchunks * sizeof(H5D_chunk_direct_ent_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for direct chunk I/O batch")
+    if(NULL == (order = (H5D_chunk_direct_ent_t **)H5MM_malloc(batch->nchunks * sizeof(H5D_chunk_direct_ent_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for direct chunk I/O batch")
+
+    for(u = 0; u < batch->nchunks; u++) {
+        const hsize_t *offset = batch->offsets + u * ndims;    /* Chunk's offset */
+
+        if(write ? NULL == batch->wbufs[u] : NULL == batch->rbufs[u])
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no buffer for chunk")
+        if(write && (0 == batch->sizes[u] || batch->sizes[u] != (size_t)(uint32_t)batch->sizes[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "invalid chunk size")
+
+        for(v = 0; v < ndims; v++) {
+            /* Make sure the offset is within the dataset's dimensions */
+            if(offset[v] >= dset->shared->curr_dims[v])
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset exceeds dimensions of dataset")
+
+            /* Make sure the offset falls right on a chunk's boundary */
+            if(offset[v] % layout->dim[v])
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset doesn't fall on chunks's boundary")
+
+            ents[u].scaled[v] = offset[v] / layout->dim[v];
+        } /* end for */
+        ents[u].scaled[ndims] = 0;
+        ents[u].chunk_idx = H5VM_array_offset_pre(ndims, layout->down_chunks, ents[u].scaled);
+        ents[u].idx = u;
+    } /* end for */
+
+    /* Visit the chunk index in order */
+    HDqsort(ents, batch->nchunks, sizeof(H5D_chunk_direct_ent_t), H5D__chunk_direct_cmp_idx);
+    if(write)
+        for(u = 1; u < batch->nchunks; u++)
+            if(ents[u].chunk_idx == ents[u - 1].chunk_idx)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "chunk written more than once in batch")
+
+    for(u = 0; u < batch->nchunks; u++)
+        order[u] = &ents[u];
+
+    *ents_out = ents;
+    *order_out = order;
+
+done:
+    if(ret_value < 0) {
+        H5MM_xfree(ents);
+        H5MM_xfree(order);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_direct_batch_init() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_write_batch
+ *
+ * Purpose:     Internal routine to write a batch of chunks directly into
+ *              the file.  The chunks are looked up and given space in the
+ *              file in one pass over the chunk index, written with one
+ *              vector write sorted by file address (so the file driver
+ *              can combine adjacent chunks), then inserted into the
+ *              index.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_direct_write_batch(const H5D_t *dset, const H5D_direct_chunk_batch_t *batch)
+{
+    const H5O_layout_t *layout = &(dset->shared->layout);       /* Dataset layout */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    H5D_chunk_direct_ent_t *ents = NULL;        /* Entries for the chunks */
+    H5D_chunk_direct_ent_t **order = NULL;      /* Entries in file address order */
+    H5FD_mem_t *types = NULL;           /* Memory types for vector write */
+    haddr_t *addrs = NULL;              /* Addresses for vector write */
+    size_t *sizes = NULL;               /* Sizes for vector write */
+    const void **bufs = NULL;           /* Buffers for vector write */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_io_info_t io_info;              /* to hold the dset info */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dset->oloc.addr)
+
+    /* Sanity checks */
+    HDassert(dset && H5D_CHUNKED == layout->type);
+    HDassert(batch);
+
+    if(0 == batch->nchunks)
+        HGOTO_DONE(SUCCEED)
+
+    if(H5D__chunk_direct_batch_init(dset, batch, TRUE, &ents, &order) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up direct chunk write batch")
+
+    io_info.dset = dset;
+
+    /* Allocate dataspace and initialize it if it hasn't been. */
+    if(!(*layout->ops->is_space_alloc)(&layout->storage))
+        /* Allocate storage */
+        if(H5D__alloc_storage(&io_info, H5D_ALLOC_WRITE, FALSE, NULL) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.pline = &(dset->shared->dcpl_cache.pline);
+    idx_info.layout = &(dset->shared->layout.u.chunk);
+    idx_info.storage = &(dset->shared->layout.storage.u.chunk);
+
+    /* Look up each chunk and give it space in the file */
+    for(u = 0; u < batch->nchunks; u++) {
+        H5D_chunk_direct_ent_t *ent = &ents[u];
+        H5F_block_t old_chunk;          /* Offset/length of old chunk */
+
+        /* Find out the file address of the chunk (if any) */
+        if(H5D__chunk_lookup(dset, ent->scaled, &ent->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Sanity check */
+        HDassert((H5F_addr_defined(ent->udata.chunk_block.offset) && ent->udata.chunk_block.length > 0) ||
+                (!H5F_addr_defined(ent->udata.chunk_block.offset) && ent->udata.chunk_block.length == 0));
+
+        /* Set the file block information for the old chunk */
+        old_chunk = ent->udata.chunk_block;
+
+        /* Set up the size of chunk for user data */
+        ent->udata.chunk_block.length = (uint32_t)batch->sizes[ent->idx];
+
+        if(0 == idx_info.pline->nused && H5F_addr_defined(old_chunk.offset))
+            /* If there are no filters and we are overwriting the chunk we can just set values */
+            ent->need_insert = FALSE;
+        else
+            /* Otherwise, create the chunk it if it doesn't exist, or reallocate the chunk
+             * if its size has changed.
+             */
+            if(H5D__chunk_file_alloc(&idx_info, &old_chunk, &ent->udata.chunk_block, &ent->need_insert, ent->scaled) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "unable to allocate chunk")
+
+        /* Make sure the address of the chunk is returned. */
+        if(!H5F_addr_defined(ent->udata.chunk_block.offset))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "chunk address isn't defined")
+
+        /* Evict the (old) entry from the cache if present, but do not flush
+         * it to disk */
+        if(UINT_MAX != ent->udata.idx_hint)
+            if(H5D__chunk_cache_evict(dset, rdcc->slot[ent->udata.idx_hint], FALSE) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
+    } /* end for */
+
+    /* Write the chunks in file address order */
+    HDqsort(order, batch->nchunks, sizeof(H5D_chunk_direct_ent_t *), H5D__chunk_direct_cmp_addr);
+    if(NULL == (types = (H5FD_mem_t *)H5MM_malloc(batch->nchunks * sizeof(H5FD_mem_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(batch->nchunks * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(batch->nchunks * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (bufs = (const void **)H5MM_malloc(batch->nchunks * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    for(u = 0; u < batch->nchunks; u++) {
+        types[u] = H5FD_MEM_DRAW;
+        addrs[u] = order[u]->udata.chunk_block.offset;
+        sizes[u] = batch->sizes[order[u]->idx];
+        bufs[u] = batch->wbufs[order[u]->idx];
+    } /* end for */
+    if(H5F_block_write_vector(dset->oloc.file, (uint32_t)batch->nchunks, types, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+
+    /* Insert the chunk records into the index, in index order */
+    if(layout->storage.u.chunk.ops->insert)
+        for(u = 0; u < batch->nchunks; u++)
+            if(ents[u].need_insert) {
+                /* Set the chunk's filter mask to the new settings */
+                ents[u].udata.filter_mask = batch->filters ? batch->filters[ents[u].idx] : 0;
+
+                if((layout->storage.u.chunk.ops->insert)(&idx_info, &ents[u].udata, dset) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+            } /* end if */
+
+done:
+    /* The last chunk looked up may have moved since */
+    if(ents)
+        H5D__chunk_cinfo_cache_reset(&(rdcc->last));
+
+    H5MM_xfree(ents);
+    H5MM_xfree(order);
+    H5MM_xfree(types);
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* end H5D__chunk_direct_write_batch() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_read_batch
+ *
+ * Purpose:     Internal routine to read a batch of chunks directly from
+ *              the file.  The chunks are looked up in one pass over the
+ *              chunk index, then read with one vector read sorted by file
+ *              address (so the file driver can combine adjacent chunks).
+ *              Each chunk's filter mask is returned in BATCH->filters_out.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_direct_read_batch(const H5D_t *dset, const H5D_direct_chunk_batch_t *batch)
+{
+    const H5O_layout_t *layout = &(dset->shared->layout);    /* Dataset layout */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    H5D_chunk_direct_ent_t *ents = NULL;        /* Entries for the chunks */
+    H5D_chunk_direct_ent_t **order = NULL;      /* Entries in file address order */
+    H5FD_mem_t *types = NULL;           /* Memory types for vector read */
+    haddr_t *addrs = NULL;              /* Addresses for vector read */
+    size_t *sizes = NULL;               /* Sizes for vector read */
+    void **bufs = NULL;                 /* Buffers for vector read */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_VOL_TAG(dset->oloc.addr)
+
+    /* Check args */
+    HDassert(dset && H5D_CHUNKED == layout->type);
+    HDassert(batch);
+
+    if(0 == batch->nchunks)
+        HGOTO_DONE(SUCCEED)
+
+    if(!(*layout->ops->is_space_alloc)(&layout->storage))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "storage is not initialized")
+
+    if(H5D__chunk_direct_batch_init(dset, batch, FALSE, &ents, &order) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up direct chunk read batch")
+
+    /* Look up each chunk */
+    for(u = 0; u < batch->nchunks; u++) {
+        H5D_chunk_direct_ent_t *ent = &ents[u];
+
+        /* Find out the file address of the chunk */
+        if(H5D__chunk_lookup(dset, ent->scaled, &ent->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Write the chunk out first if it's in the chunk cache, and look
+         * it up again */
+        if(UINT_MAX != ent->udata.idx_hint) {
+            H5D_rdcc_ent_t *rdcc_ent = rdcc->slot[ent->udata.idx_hint];
+
+            if(H5D__chunk_cache_evict(dset, rdcc_ent, rdcc_ent->dirty) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
+            if(H5D__chunk_lookup(dset, ent->scaled, &ent->udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        } /* end if */
+
+        /* Make sure the address of the chunk is returned. */
+        if(!H5F_addr_defined(ent->udata.chunk_block.offset))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk address isn't defined")
+    } /* end for */
+
+    /* Read the chunks in file address order */
+    HDqsort(order, batch->nchunks, sizeof(H5D_chunk_direct_ent_t *), H5D__chunk_direct_cmp_addr);
+    if(NULL == (types = (H5FD_mem_t *)H5MM_malloc(batch->nchunks * sizeof(H5FD_mem_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(batch->nchunks * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(batch->nchunks * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (bufs = (void **)H5MM_malloc(batch->nchunks * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    for(u = 0; u < batch->nchunks; u++) {
+        types[u] = H5FD_MEM_DRAW;
+        addrs[u] = order[u]->udata.chunk_block.offset;
+        sizes[u] = (size_t)order[u]->udata.chunk_block.length;
+        bufs[u] = batch->rbufs[order[u]->idx];
+    } /* end for */
+    if(H5F_block_read_vector(dset->oloc.file, (uint32_t)batch->nchunks, types, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+
+    /* Return the filter masks */
+    for(u = 0; u < batch->nchunks; u++)
+        batch->filters_out[ents[u].idx] = ents[u].udata.filter_mask;
+
+done:
+    H5MM_xfree(ents);
+    H5MM_xfree(order);
+    H5MM_xfree(types);
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI_VOL_TAG(ret_value)
+} /* end H5D__chunk_direct_read_batch() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__get_chunk_storage_size
@@ -631,7 +1161,7 @@ H5D__get_chunk_storage_size(H5D_t *dset, const hsize_t *offset, hsize_t *storage
             H5D_rdcc_ent_t *ent = rdcc->slot[udata.idx_hint];
 
             /* Sanity checks  */
-            HDassert(udata.idx_hint < rdcc->nslots);
+            HDassert(udata.idx_hint < rdcc->nslots_alloc);
             HDassert(rdcc->slot[udata.idx_hint]);
 
             /* If the cached chunk is dirty, it must be flushed to get accurate size */
@@ -666,91 +1196,461 @@ done:
     FUNC_LEAVE_NOAPI_VOL_TAG(ret_value)
 } /* H5D__get_chunk_storage_size */
 
+
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_set_info_real
+ * Function:    H5D__chunk_info_intersect
  *
- * Purpose:	Internal routine to set the information about chunks for a dataset
- *
- * Return:	Non-negative on success/Negative on failure
+ * Purpose:     Check whether a chunk of a dataset has any elements in a
+ *              dataspace selection.
  *
- * Programmer:	Quincey Koziol
- *              Tuesday, June 30, 2009
+ * Return:      Success:        TRUE/FALSE
+ *              Failure:        Negative
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5D__chunk_set_info_real(H5O_layout_chunk_t *layout, unsigned ndims,
-    const hsize_t *curr_dims, const hsize_t *max_dims)
+static htri_t
+H5D__chunk_info_intersect(const H5D_t *dset, H5S_t *space, const hsize_t *offset)
 {
-    unsigned u;                 /* Local index variable */
-    herr_t ret_value = SUCCEED; /* Return value */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);    /* Dataset's chunk layout */
+    hsize_t end[H5O_LAYOUT_NDIMS];      /* Last element of the chunk within the dataset */
+    unsigned u;                         /* Local index variable */
+    htri_t ret_value = FALSE;           /* Return value */
 
     FUNC_ENTER_STATIC
 
     /* Sanity checks */
-    HDassert(layout);
-    HDassert(ndims > 0);
-    HDassert(curr_dims);
-
-    /* Compute the # of chunks in dataset dimensions */
-    for(u = 0, layout->nchunks = 1, layout->max_nchunks = 1; u < ndims; u++) {
-        /* Round up to the next integer # of chunks, to accomodate partial chunks */
-        layout->chunks[u] = ((curr_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
-        if(H5S_UNLIMITED == max_dims[u])
-            layout->max_chunks[u] = H5S_UNLIMITED;
-        else
-            layout->max_chunks[u] = ((max_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
+    HDassert(dset);
+    HDassert(space);
+    HDassert(offset);
 
-        /* Accumulate the # of chunks */
-        layout->nchunks *= layout->chunks[u];
-        layout->max_nchunks *= layout->max_chunks[u];
+    /* Compute the last element of the chunk which lies within the dataset */
+    for(u = 0; u < dset->shared->ndims; u++) {
+        end[u] = offset[u] + layout->dim[u] - 1;
+        if(end[u] >= dset->shared->curr_dims[u] && dset->shared->curr_dims[u] > offset[u])
+            end[u] = dset->shared->curr_dims[u] - 1;
     } /* end for */
 
-    /* Get the "down" sizes for each dimension */
-    if(H5VM_array_down(ndims, layout->chunks, layout->down_chunks) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't compute 'down' chunk size value")
-    if(H5VM_array_down(ndims, layout->max_chunks, layout->max_down_chunks) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't compute 'down' chunk size value")
+    switch(H5S_GET_SELECT_TYPE(space)) {
+        case H5S_SEL_ALL:
+            ret_value = TRUE;
+            break;
+
+        case H5S_SEL_NONE:
+            ret_value = FALSE;
+            break;
+
+        case H5S_SEL_HYPERSLABS:
+            if((ret_value = H5S_hyper_intersect_block(space, offset, end)) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOMPARE, FAIL, "can't check selection against chunk")
+            break;
+
+        case H5S_SEL_POINTS:
+            {
+                H5S_sel_iter_t sel_iter;    /* Selection iteration info */
+                hsize_t coords[H5O_LAYOUT_NDIMS];   /* Coordinates of a point */
+                hssize_t npoints;           /* # of points in the selection */
+                herr_t status = SUCCEED;    /* Status of iterating over the points */
+
+                if(H5S_select_iter_init(&sel_iter, space, (size_t)1) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+
+                /* Look for a point which falls in the chunk */
+                npoints = H5S_GET_SELECT_NPOINTS(space);
+                while(npoints-- > 0 && ret_value == FALSE) {
+                    if((status = H5S_SELECT_ITER_COORDS(&sel_iter, coords)) < 0)
+                        break;
+                    ret_value = TRUE;
+                    for(u = 0; u < dset->shared->ndims; u++)
+                        if(coords[u] < offset[u] || coords[u] > end[u]) {
+                            ret_value = FALSE;
+                            break;
+                        } /* end if */
+                    if(ret_value == FALSE && npoints > 0)
+                        if((status = H5S_SELECT_ITER_NEXT(&sel_iter, (size_t)1)) < 0)
+                            break;
+                } /* end while */
+
+                if(H5S_SELECT_ITER_RELEASE(&sel_iter) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+                if(status < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTNEXT, FAIL, "unable to iterate over selected points")
+            }
+            break;
+
+        case H5S_SEL_ERROR:
+        case H5S_SEL_N:
+        default:
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADSELECT, FAIL, "invalid selection type")
+    } /* end switch */
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_set_info_real() */
+} /* end H5D__chunk_info_intersect() */
+
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_set_info
- *
- * Purpose:	Sets the information about chunks for a dataset
+ * Function:    H5D__chunk_info_cb
  *
- * Return:	Non-negative on success/Negative on failure
+ * Purpose:     Chunk index callback for the bulk chunk query routines.
+ *              Skips chunks outside the selection, then either passes
+ *              the chunk to the application's callback or, when it is
+ *              the chunk asked for by index, records it and stops.
  *
- * Programmer:	Quincey Koziol
- *              Tuesday, June 30, 2009
+ * Return:      Success:        H5_ITER_CONT, or H5_ITER_STOP to stop
+ *                              early
+ *              Failure:        H5_ITER_ERROR
  *
  *-------------------------------------------------------------------------
  */
-herr_t
-H5D__chunk_set_info(const H5D_t *dset)
+static int
+H5D__chunk_info_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
 {
-    herr_t ret_value = SUCCEED;         /* Return value */
+    H5D_chunk_info_iter_ud_t *udata = (H5D_chunk_info_iter_ud_t *)_udata;  /* User data for callback */
+    const H5O_layout_chunk_t *layout = &(udata->dset->shared->layout.u.chunk);    /* Dataset's chunk layout */
+    hsize_t offset[H5O_LAYOUT_NDIMS];   /* Logical offset of the chunk */
+    unsigned u;                         /* Local index variable */
+    int ret_value = H5_ITER_CONT;       /* Return value */
 
-    FUNC_ENTER_PACKAGE
+    FUNC_ENTER_STATIC
 
-    /* Sanity checks */
-    HDassert(dset);
+    /* Compute the chunk's logical offset from its scaled coordinates */
+    for(u = 0; u < udata->dset->shared->ndims; u++)
+        offset[u] = chunk_rec->scaled[u] * layout->dim[u];
 
-    /* Set the base layout information */
-    if(H5D__chunk_set_info_real(&dset->shared->layout.u.chunk, dset->shared->ndims, dset->shared->curr_dims, dset->shared->max_dims) < 0)
-	HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't set layout's chunk info")
+    /* Skip chunks which aren't in the selection */
+    if(udata->space) {
+        htri_t intersect;               /* Whether the chunk is in the selection */
 
-    /* Call the index's "resize" callback */
-    if(dset->shared->layout.storage.u.chunk.ops->resize && (dset->shared->layout.storage.u.chunk.ops->resize)(&dset->shared->layout.u.chunk) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to resize chunk index information")
+        if((intersect = H5D__chunk_info_intersect(udata->dset, udata->space, offset)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCOMPARE, H5_ITER_ERROR, "can't check chunk against selection")
+        if(!intersect)
+            HGOTO_DONE(H5_ITER_CONT)
+    } /* end if */
+
+    if(udata->op) {
+        /* Make the application callback */
+        if((udata->op_ret = (udata->op)(offset, (unsigned)chunk_rec->filter_mask,
+                chunk_rec->chunk_addr, (hsize_t)chunk_rec->nbytes, udata->op_data)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CALLBACK, H5_ITER_ERROR, "chunk iteration operator failed")
+        if(udata->op_ret > 0)
+            ret_value = H5_ITER_STOP;
+    } /* end if */
+    else if(udata->nchunks == udata->chunk_idx && !udata->found) {
+        /* This is the chunk asked for, so return its information */
+        HDmemcpy(udata->offset, offset, udata->dset->shared->ndims * sizeof(hsize_t));
+        udata->filter_mask = (unsigned)chunk_rec->filter_mask;
+        udata->addr = chunk_rec->chunk_addr;
+        udata->size = (hsize_t)chunk_rec->nbytes;
+        udata->found = TRUE;
+        ret_value = H5_ITER_STOP;
+    } /* end if */
+
+    udata->nchunks++;
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_set_info() */
+} /* end H5D__chunk_info_cb() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_info_iterate
+ *
+ * Purpose:     Make one pass over a dataset's chunk index for the bulk
+ *              chunk query routines.  Dirty chunks in the chunk cache
+ *              are written first, so that the addresses and sizes seen
+ *              are the ones in the file.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_info_iterate(H5D_t *dset, H5D_chunk_info_iter_ud_t *udata)
+{
+    const H5O_layout_t *layout = &(dset->shared->layout);    /* Dataset layout */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC_TAG(dset->oloc.addr)
+
+    /* Sanity checks */
+    HDassert(dset && H5D_CHUNKED == layout->type);
+    HDassert(udata);
+
+    udata->dset = dset;
+    udata->op_ret = 0;
+    udata->nchunks = 0;
+    udata->found = FALSE;
+
+    /* Write out any chunks which are only in the cache */
+    if(H5D__chunk_flush(dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush raw data chunks")
+
+    /* There are no chunks if no storage has been allocated for the index */
+    if(!(*layout->ops->is_space_alloc)(&layout->storage))
+        HGOTO_DONE(SUCCEED)
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Visit each chunk in the index once */
+    if((layout->storage.u.chunk.ops->iterate)(&idx_info, H5D__chunk_info_cb, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to iterate over chunk index")
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* end H5D__chunk_info_iterate() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__get_num_chunks
+ *
+ * Purpose:     Count the chunks of a dataset which have storage in the
+ *              file and contain elements of a selection.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__get_num_chunks(H5D_t *dset, H5S_t *space, hsize_t *nchunks)
+{
+    H5D_chunk_info_iter_ud_t udata;     /* User data for iteration callback */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(nchunks);
+
+    /* Count all the matching chunks */
+    HDmemset(&udata, 0, sizeof(udata));
+    udata.space = space;
+    udata.chunk_idx = HSIZE_UNDEF;
+    if(H5D__chunk_info_iterate(dset, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOUNT, FAIL, "unable to count chunks")
+
+    *nchunks = udata.nchunks;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__get_num_chunks() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__get_chunk_cache_stats
+ *
+ * Purpose:     Copy out the statistics of a dataset's chunk cache.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__get_chunk_cache_stats(const H5D_t *dset, H5D_chunk_cache_stats_t *stats)
+{
+    const H5D_rdcc_t *rdcc;             /* Raw data chunk cache */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(stats);
+
+    rdcc = &(dset->shared->cache.chunk);
+    stats->hits = rdcc->stats.nhits;
+    stats->misses = rdcc->stats.nmisses;
+    stats->evictions_clean = rdcc->stats.nevict_clean;
+    stats->evictions_dirty = rdcc->stats.nevict_dirty;
+    stats->bytes_read = rdcc->stats.nbytes_read;
+    stats->bytes_decompressed = rdcc->stats.nbytes_unfiltered;
+    stats->filter_time = rdcc->stats.filter_time;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__get_chunk_cache_stats() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__get_chunk_info
+ *
+ * Purpose:     Get the logical offset, filter mask, file address and
+ *              size in the file of the chunk at position CHK_IDX among
+ *              the chunks counted by H5D__get_num_chunks.  Any of the
+ *              output pointers may be NULL.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__get_chunk_info(H5D_t *dset, H5S_t *space, hsize_t chk_idx,
+    hsize_t *offset, unsigned *filter_mask, haddr_t *addr, hsize_t *size)
+{
+    H5D_chunk_info_iter_ud_t udata;     /* User data for iteration callback */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(dset);
+
+    /* Find the chunk */
+    HDmemset(&udata, 0, sizeof(udata));
+    udata.space = space;
+    udata.chunk_idx = chk_idx;
+    if(H5D__chunk_info_iterate(dset, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to look up chunk")
+    if(!udata.found)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk index is out of range")
+
+    if(offset)
+        HDmemcpy(offset, udata.offset, dset->shared->ndims * sizeof(hsize_t));
+    if(filter_mask)
+        *filter_mask = udata.filter_mask;
+    if(addr)
+        *addr = udata.addr;
+    if(size)
+        *size = udata.size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__get_chunk_info() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_iter
+ *
+ * Purpose:     Call an application callback for each chunk of a dataset
+ *              which has storage in the file, in a single pass over the
+ *              chunk index.
+ *
+ * Return:      Success:        Non-negative (the callback's value if it
+ *                              stopped the iteration)
+ *              Failure:        Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_iter(H5D_t *dset, H5D_chunk_iter_op_t op, void *op_data)
+{
+    H5D_chunk_info_iter_ud_t udata;     /* User data for iteration callback */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(op);
+
+    HDmemset(&udata, 0, sizeof(udata));
+    udata.op = op;
+    udata.op_data = op_data;
+    if(H5D__chunk_info_iterate(dset, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to iterate over chunks")
+
+    /* Pass on the value the callback stopped the iteration with */
+    ret_value = udata.op_ret;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_iter() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_set_info_real
+ *
+ * Purpose:	Internal routine to set the information about chunks for a dataset
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *              Tuesday, June 30, 2009
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_set_info_real(H5O_layout_chunk_t *layout, unsigned ndims,
+    const hsize_t *curr_dims, const hsize_t *max_dims)
+{
+    unsigned u;                 /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(layout);
+    HDassert(ndims > 0);
+    HDassert(curr_dims);
+
+    /* Compute the # of chunks in dataset dimensions */
+    for(u = 0, layout->nchunks = 1, layout->max_nchunks = 1; u < ndims; u++) {
+        /* Round up to the next integer # of chunks, to accomodate partial chunks */
+        layout->chunks[u] = ((curr_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
+        if(H5S_UNLIMITED == max_dims[u])
+            layout->max_chunks[u] = H5S_UNLIMITED;
+        else
+            layout->max_chunks[u] = ((max_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
+
+        /* Accumulate the # of chunks */
+        layout->nchunks *= layout->chunks[u];
+        layout->max_nchunks *= layout->max_chunks[u];
+    } /* end for */
+
+    /* Get the "down" sizes for each dimension */
+    if(H5VM_array_down(ndims, layout->chunks, layout->down_chunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't compute 'down' chunk size value")
+    if(H5VM_array_down(ndims, layout->max_chunks, layout->max_down_chunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't compute 'down' chunk size value")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_set_info_real() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_set_info
+ *
+ * Purpose:	Sets the information about chunks for a dataset
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *              Tuesday, June 30, 2009
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_set_info(const H5D_t *dset)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+
+    /* Set the base layout information */
+    if(H5D__chunk_set_info_real(&dset->shared->layout.u.chunk, dset->shared->ndims, dset->shared->curr_dims, dset->shared->max_dims) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't set layout's chunk info")
+
+    /* Call the index's "resize" callback */
+    if(dset->shared->layout.storage.u.chunk.ops->resize && (dset->shared->layout.storage.u.chunk.ops->resize)(&dset->shared->layout.u.chunk) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to resize chunk index information")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_set_info() */
 
 
 /*-------------------------------------------------------------------------
@@ -927,13 +1827,63 @@ H5D__chunk_init(H5F_t *f, const H5D_t *dset, hid_t dapl_id)
     if(rdcc->w0 < 0)
         rdcc->w0 = H5F_RDCC_W0(f);
 
+    if(H5P_get(dapl, H5D_ACS_CHUNK_READ_AHEAD_NAME, &rdcc->read_ahead) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get # of chunks to read ahead")
+    rdcc->ra_last_idx = HSIZE_UNDEF;
+    rdcc->ra_stride = 0;
+
+    /* Let the cache resize itself, starting with room for at least a chunk */
+    if(H5P_get(dapl, H5D_ACS_CHUNK_CACHE_AUTO_NAME, &rdcc->autosize.max_nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get largest automatic chunk cache size")
+    if(rdcc->autosize.max_nbytes > 0 && rdcc->nslots > 0) {
+        size_t chunk_size;              /* Size of a chunk */
+
+        H5_CHECKED_ASSIGN(chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+        if(rdcc->nbytes_max < chunk_size)
+            rdcc->nbytes_max = MIN(chunk_size, rdcc->autosize.max_nbytes);
+        rdcc->autosize.min_nbytes = rdcc->nbytes_max;
+        rdcc->autosize.max_nbytes = MAX(rdcc->autosize.max_nbytes, rdcc->nbytes_max);
+    } /* end if */
+    else
+        rdcc->autosize.max_nbytes = 0;
+
     /* If nbytes_max or nslots is 0, set them both to 0 and avoid allocating space */
     if(!rdcc->nbytes_max || !rdcc->nslots)
         rdcc->nbytes_max = rdcc->nslots = 0;
     else {
+        /* The hash table starts with the number of slots requested, and
+         * grows when more chunks than that fit in the cache */
         rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots);
         if(NULL == rdcc->slot)
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+        rdcc->nslots_alloc = rdcc->nslots;
+        rdcc->nslots_deleted = 0;
+
+        /* Share the file's byte budget for chunk caches, if it has one */
+        if(H5F_RDCC_POOL_NBYTES(f) > 0) {
+            H5D_rdcc_pool_t *pool = H5F_RDCC_POOL(f);
+
+            if(NULL == pool) {
+                if(NULL == (pool = H5FL_CALLOC(H5D_rdcc_pool_t)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate shared chunk cache info")
+                pool->nbytes_max = H5F_RDCC_POOL_NBYTES(f);
+                pool->w0 = H5F_RDCC_W0(f);
+                H5F_SET_RDCC_POOL(f, pool);
+            } /* end if */
+            pool->nusers++;
+            rdcc->pool = pool;
+
+            /* The cache can't usefully grow past the shared budget */
+            if(rdcc->autosize.max_nbytes > pool->nbytes_max)
+                rdcc->autosize.max_nbytes = MAX(pool->nbytes_max, rdcc->autosize.min_nbytes);
+        } /* end if */
+
+        /* Start the first epoch of automatic sizing */
+        if(rdcc->autosize.max_nbytes > 0) {
+            if(NULL == (rdcc->autosize.ghosts = (hsize_t *)H5MM_malloc(H5D_RDCC_AUTO_NGHOSTS * sizeof(hsize_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for preempted chunk ring")
+            rdcc->autosize.epoch = 1;
+        } /* end if */
 
         /* Reset any cached chunk info for this dataset */
         H5D__chunk_cinfo_cache_reset(&(rdcc->last));
@@ -2110,1129 +3060,2955 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_cacheable() */
 
+
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_read
+ * Function:	H5D__chunk_batch_init
  *
- * Purpose:	Read from a chunked dataset.
+ * Purpose:	Decides whether the chunks of a read or write run their
+ *		filter pipelines in batches on several threads and sets up
+ *		BATCH for it.  They do when the dataset is filtered, the
+ *		operation covers more than one chunk, the transfer property
+ *		list allows more than one filter thread and all the filters
+ *		are registered already.  Otherwise BATCH->NTHREADS is 1 and
+ *		the chunks are operated on one at a time.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Raymond Lu
- *		Thursday, April 10, 2003
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
-    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
-    H5D_chunk_map_t *fm)
+H5D__chunk_batch_init(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
+    H5D_chunk_batch_t *batch)
 {
-    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
-    H5D_io_info_t nonexistent_io_info;  /* "nonexistent" I/O info object */
-    H5D_io_info_t ctg_io_info;          /* Contiguous I/O info object */
-    H5D_storage_t ctg_store;            /* Chunk storage information as contiguous dataset */
-    H5D_io_info_t cpt_io_info;          /* Compact I/O info object */
-    H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
-    hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
-    uint32_t    src_accessed_bytes = 0; /* Total accessed size in a chunk */
-    hbool_t     skip_missing_chunks = FALSE;    /* Whether to skip missing chunks */
-    herr_t	ret_value = SUCCEED;	/*return value		*/
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+    const H5O_pline_t *pline = &(io_info->dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    size_t nchunks;                     /* # of chunks selected */
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
 
     /* Sanity check */
     HDassert(io_info);
-    HDassert(io_info->u.rbuf);
-    HDassert(type_info);
     HDassert(fm);
+    HDassert(batch);
+
+    HDmemset(batch, 0, sizeof(*batch));
+    batch->nthreads = 1;
+
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+    nchunks = fm->use_single ? 1 : H5SL_count(fm->sel_chunks);
+    if(pline->nused > 0 && nchunks > 1) {
+        unsigned filter_threads;        /* # of filter pipeline threads allowed */
+        htri_t avail;                   /* Whether the filters are registered */
+
+        if(H5CX_get_filter_threads(&filter_threads) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get # of filter pipeline threads")
+        if(filter_threads > 1) {
+            /* Filters which need to be loaded are loaded by the serial path */
+            if((avail = H5Z_all_filters_avail(pline)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check filter availability")
+            if(avail) {
+                /* Retrieve filter settings from API context */
+                if(H5CX_get_err_detect(&batch->err_detect) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+                if(H5CX_get_filter_cb(&batch->filter_cb) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+
+                batch->max_chunks = MIN(nchunks, (size_t)filter_threads * H5D_CHUNK_BATCH_PER_THREAD);
+                if(NULL == (batch->ents = (H5D_chunk_batch_ent_t *)H5MM_calloc(batch->max_chunks * sizeof(H5D_chunk_batch_ent_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+                if(NULL == (batch->jobs = (H5Z_pipeline_job_t *)H5MM_calloc(batch->max_chunks * sizeof(H5Z_pipeline_job_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+                batch->nthreads = (unsigned)MIN(nchunks, (size_t)filter_threads);
+            } /* end if */
+        } /* end if */
+    } /* end if */
 
-    /* Set up "nonexistent" I/O info object */
-    HDmemcpy(&nonexistent_io_info, io_info, sizeof(nonexistent_io_info));
-    nonexistent_io_info.layout_ops = *H5D_LOPS_NONEXISTENT;
+done:
+    if(ret_value < 0) {
+        batch->ents = (H5D_chunk_batch_ent_t *)H5MM_xfree(batch->ents);
+        batch->jobs = (H5Z_pipeline_job_t *)H5MM_xfree(batch->jobs);
+    } /* end if */
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_batch_init() */
 
-    /* Set up contiguous I/O info object */
-    HDmemcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
-    ctg_io_info.store = &ctg_store;
-    ctg_io_info.layout_ops = *H5D_LOPS_CONTIG;
-
-    /* Initialize temporary contiguous storage info */
-    H5_CHECKED_ASSIGN(ctg_store.contig.dset_size, hsize_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
-
-    /* Set up compact I/O info object */
-    HDmemcpy(&cpt_io_info, io_info, sizeof(cpt_io_info));
-    cpt_io_info.store = &cpt_store;
-    cpt_io_info.layout_ops = *H5D_LOPS_COMPACT;
 
-    /* Initialize temporary compact storage info */
-    cpt_store.compact.dirty = &cpt_dirty;
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_batch_read
+ *
+ * Purpose:	Starts the next batch of chunks for a read, beginning at
+ *		CHUNK_NODE.  The chunks of the batch which aren't in the
+ *		chunk cache are read from the file one after another, in
+ *		order, then unfiltered on several threads at once.  Each is
+ *		then given to H5D__chunk_lock() when the read gets to it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_batch_read(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
+    H5SL_node_t *chunk_node, H5D_chunk_batch_t *batch)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk); /* Chunk layout */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk); /* Raw data chunk cache */
+    double start_time;                  /* Time the pipeline was started */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-    {
-        const H5O_fill_t *fill = &(io_info->dset->shared->dcpl_cache.fill);    /* Fill value info */
-        H5D_fill_value_t fill_status;       /* Fill value status */
+    FUNC_ENTER_STATIC
 
-        /* Check the fill value status */
-        if(H5P_is_fill_value_defined(fill, &fill_status) < 0)
-            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't tell if fill value defined")
+    /* Sanity check */
+    HDassert(batch->nthreads > 1);
+    HDassert(batch->curr == batch->nchunks);
 
-        /* If we are never to return fill values, or if we would return them
-         * but they aren't set, set the flag to skip missing chunks.
-         */
-        if(fill->fill_time == H5D_FILL_TIME_NEVER ||
-                (fill->fill_time == H5D_FILL_TIME_IFSET &&
-                 fill_status != H5D_FILL_VALUE_USER_DEFINED &&
-                 fill_status != H5D_FILL_VALUE_DEFAULT))
-            skip_missing_chunks = TRUE;
-    }
+    /* (The buffers of the previous batch have all been handed on) */
+    batch->njobs = 0;
 
-    /* Iterate through nodes in chunk skip list */
-    chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
-    while(chunk_node) {
+    /* Read the chunks in the batch which need unfiltering */
+    batch->nchunks = 0;
+    batch->curr = 0;
+    while(chunk_node && batch->nchunks < batch->max_chunks) {
         H5D_chunk_info_t *chunk_info;   /* Chunk information */
-        H5D_chunk_ud_t udata;		/* Chunk index pass-through	*/
+        H5D_chunk_batch_ent_t *ent = &batch->ents[batch->nchunks++];
 
         /* Get the actual chunk information from the skip list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
 
         /* Get the info for the chunk in the file */
-        if(H5D__chunk_lookup(io_info->dset, chunk_info->scaled, &udata) < 0)
+        if(H5D__chunk_lookup(dset, chunk_info->scaled, &ent->udata) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
-
-        /* Sanity check */
-        HDassert((H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) || 
-                (!H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length == 0));
-
-        /* Check for non-existant chunk & skip it if appropriate */
-        if(H5F_addr_defined(udata.chunk_block.offset) || UINT_MAX != udata.idx_hint
-                || !skip_missing_chunks) {
-            H5D_io_info_t *chk_io_info;     /* Pointer to I/O info object for this chunk */
-            void *chunk = NULL;             /* Pointer to locked chunk buffer */
-            htri_t cacheable;               /* Whether the chunk is cacheable */
-
-            /* Set chunk's [scaled] coordinates */
-            io_info->store->chunk.scaled = chunk_info->scaled;
-
-            /* Determine if we should use the chunk cache */
-            if((cacheable = H5D__chunk_cacheable(io_info, udata.chunk_block.offset, FALSE)) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunk is cacheable")
-            if(cacheable) {
-                /* Load the chunk into cache and lock it. */
-
-                /* Compute # of bytes accessed in chunk */
-                H5_CHECK_OVERFLOW(type_info->src_type_size, /*From:*/ size_t, /*To:*/ uint32_t);
-                src_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->src_type_size;
-
-                /* Lock the chunk into the cache */
-                if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, FALSE, FALSE)))
-                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
-
-                /* Set up the storage buffer information for this chunk */
-                cpt_store.compact.buf = chunk;
-
-                /* Point I/O info at contiguous I/O info for this chunk */
-                chk_io_info = &cpt_io_info;
-            } /* end if */
-            else if(H5F_addr_defined(udata.chunk_block.offset)) {
-                /* Set up the storage address information for this chunk */
-                ctg_store.contig.dset_addr = udata.chunk_block.offset;
-
-                /* Point I/O info at temporary I/O info for this chunk */
-                chk_io_info = &ctg_io_info;
-            } /* end else if */
-            else {
-                /* Point I/O info at "nonexistent" I/O info for this chunk */
-                chk_io_info = &nonexistent_io_info;
-            } /* end else */
-
-            /* Perform the actual read operation */
-            if((io_info->io_ops.single_read)(chk_io_info, type_info,
-                    (hsize_t)chunk_info->chunk_points, chunk_info->fspace, chunk_info->mspace) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked read failed")
-
-            /* Release the cache lock on the chunk. */
-            if(chunk && H5D__chunk_unlock(io_info, &udata, FALSE, chunk, src_accessed_bytes) < 0)
-                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+        ent->job = NULL;
+
+        /* Only chunks which aren't cached, exist in the file and are
+         * filtered (i.e. not unfiltered partial edge chunks) are read now */
+        if(UINT_MAX == ent->udata.idx_hint && H5F_addr_defined(ent->udata.chunk_block.offset)
+                && !((layout->flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                    && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims, layout->dim,
+                        chunk_info->scaled, dset->shared->curr_dims))) {
+            H5Z_pipeline_job_t *job = &batch->jobs[batch->njobs++];
+
+            H5_CHECKED_ASSIGN(job->nbytes, size_t, ent->udata.chunk_block.length, hsize_t);
+            job->buf_size = job->nbytes;
+            job->filter_mask = ent->udata.filter_mask;
+            job->status = SUCCEED;
+            if(NULL == (job->buf = H5D__chunk_mem_alloc(job->nbytes, pline)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+            if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, ent->udata.chunk_block.offset, job->nbytes, job->buf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+            rdcc->stats.nbytes_read += job->nbytes;
+            ent->job = job;
         } /* end if */
 
         /* Advance to next chunk in list */
         chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
     } /* end while */
 
+    /* Unfilter the chunks */
+    start_time = H5_get_time();
+    if(H5Z_pipeline_threads(pline, H5Z_FLAG_REVERSE, batch->err_detect, batch->filter_cb,
+            batch->nthreads, batch->njobs, batch->jobs) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+    rdcc->stats.filter_time += H5_get_time() - start_time;
+    for(u = 0; u < batch->njobs; u++)
+        rdcc->stats.nbytes_unfiltered += batch->jobs[u].nbytes;
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5D__chunk_read() */
+} /* end H5D__chunk_batch_read() */
+
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_write
+ * Function:	H5D__chunk_batch_write
  *
- * Purpose:	Writes to a chunked dataset.
+ * Purpose:	Starts the next batch of chunks for a write, beginning at
+ *		CHUNK_NODE.  The chunks of the batch which are written in
+ *		their entirety and aren't in the chunk cache are copied from
+ *		the application's buffer into buffers of their own, then
+ *		filtered on several threads at once.  The write then puts
+ *		each straight in the file, in order, without going through
+ *		the chunk cache.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Raymond Lu
- *		Thursday, April 10, 2003
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
-    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
-    H5D_chunk_map_t *fm)
+H5D__chunk_batch_write(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    const H5D_chunk_map_t *fm, H5SL_node_t *chunk_node, H5D_io_info_t *cpt_io_info,
+    H5D_chunk_batch_t *batch)
 {
-    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
-    H5D_io_info_t ctg_io_info;          /* Contiguous I/O info object */
-    H5D_storage_t ctg_store;            /* Chunk storage information as contiguous dataset */
-    H5D_io_info_t cpt_io_info;          /* Compact I/O info object */
-    H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
-    hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
-    uint32_t    dst_accessed_bytes = 0; /* Total accessed size in a chunk */
-    herr_t	ret_value = SUCCEED;	/* Return value		*/
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk); /* Chunk layout */
+    size_t chunk_size;                  /* Size of a chunk */
+    double start_time;                  /* Time the pipeline was started */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
 
     /* Sanity check */
-    HDassert(io_info);
-    HDassert(io_info->u.wbuf);
-    HDassert(type_info);
-    HDassert(fm);
-
-    /* Set up contiguous I/O info object */
-    HDmemcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
-    ctg_io_info.store = &ctg_store;
-    ctg_io_info.layout_ops = *H5D_LOPS_CONTIG;
-
-    /* Initialize temporary contiguous storage info */
-    H5_CHECKED_ASSIGN(ctg_store.contig.dset_size, hsize_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
+    HDassert(batch->nthreads > 1);
+    HDassert(batch->curr == batch->nchunks);
 
-    /* Set up compact I/O info object */
-    HDmemcpy(&cpt_io_info, io_info, sizeof(cpt_io_info));
-    cpt_io_info.store = &cpt_store;
-    cpt_io_info.layout_ops = *H5D_LOPS_COMPACT;
+    /* (The buffers of the previous batch have all been handed on) */
+    batch->njobs = 0;
 
-    /* Initialize temporary compact storage info */
-    cpt_store.compact.dirty = &cpt_dirty;
+    H5_CHECKED_ASSIGN(chunk_size, size_t, layout->size, uint32_t);
 
-    /* Iterate through nodes in chunk skip list */
-    chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
-    while(chunk_node) {
+    /* Fill in the chunks in the batch which are written entirely */
+    batch->nchunks = 0;
+    batch->curr = 0;
+    while(chunk_node && batch->nchunks < batch->max_chunks) {
         H5D_chunk_info_t *chunk_info;   /* Chunk information */
-	H5D_chk_idx_info_t idx_info;    /* Chunked index info */
-        H5D_io_info_t *chk_io_info;     /* Pointer to I/O info object for this chunk */
-        void *chunk;                    /* Pointer to locked chunk buffer */
-        H5D_chunk_ud_t udata;		/* Index pass-through	*/
-        htri_t cacheable;               /* Whether the chunk is cacheable */
-        hbool_t need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
+        H5D_chunk_batch_ent_t *ent = &batch->ents[batch->nchunks++];
 
         /* Get the actual chunk information from the skip list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
 
         /* Look up the chunk */
-        if(H5D__chunk_lookup(io_info->dset, chunk_info->scaled, &udata) < 0)
+        if(H5D__chunk_lookup(dset, chunk_info->scaled, &ent->udata) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        ent->job = NULL;
+
+        /* Only chunks which aren't cached, are written entirely and are
+         * filtered (i.e. not unfiltered partial edge chunks) are filled in now */
+        if(UINT_MAX == ent->udata.idx_hint
+                && (size_t)chunk_info->chunk_points * type_info->dst_type_size == chunk_size
+                && (size_t)chunk_info->chunk_points * type_info->src_type_size == chunk_size
+                && fm->fsel_type != H5S_SEL_POINTS
+                && !((layout->flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                    && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims, layout->dim,
+                        chunk_info->scaled, dset->shared->curr_dims))) {
+            H5Z_pipeline_job_t *job = &batch->jobs[batch->njobs++];
+
+            job->nbytes = chunk_size;
+            job->buf_size = chunk_size;
+            job->filter_mask = 0;
+            job->status = SUCCEED;
+            if(NULL == (job->buf = H5D__chunk_mem_alloc(chunk_size, pline)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
 
-        /* Sanity check */
-        HDassert((H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) || 
-                (!H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length == 0));
-
-	/* Set chunk's [scaled] coordinates */
-	io_info->store->chunk.scaled = chunk_info->scaled;
-
-        /* Determine if we should use the chunk cache */
-        if((cacheable = H5D__chunk_cacheable(io_info, udata.chunk_block.offset, TRUE)) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunk is cacheable")
-        if(cacheable) {
-            /* Load the chunk into cache.  But if the whole chunk is written,
-             * simply allocate space instead of load the chunk. */
-            hbool_t entire_chunk = TRUE;       /* Whether whole chunk is selected */
-
-            /* Compute # of bytes accessed in chunk */
-            H5_CHECK_OVERFLOW(type_info->dst_type_size, /*From:*/ size_t, /*To:*/ uint32_t);
-            dst_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->dst_type_size;
-
-            /* Determine if we will access all the data in the chunk */
-            if(dst_accessed_bytes != ctg_store.contig.dset_size ||
-                    (chunk_info->chunk_points * type_info->src_type_size) != ctg_store.contig.dset_size ||
-		    fm->fsel_type == H5S_SEL_POINTS)
-                entire_chunk = FALSE;
-
-            /* Lock the chunk into the cache */
-            if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk, FALSE)))
-                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
-
-            /* Set up the storage buffer information for this chunk */
-            cpt_store.compact.buf = chunk;
+            /* In the case that some dataset functions look through this data,
+             * clear it to all 0s. */
+            HDmemset(job->buf, 0, chunk_size);
 
-            /* Point I/O info at main I/O info for this chunk */
-            chk_io_info = &cpt_io_info;
+            /* Copy the data for the chunk into its buffer */
+            io_info->store->chunk.scaled = chunk_info->scaled;
+            cpt_io_info->store->compact.buf = job->buf;
+            if((io_info->io_ops.single_write)(cpt_io_info, type_info,
+                    (hsize_t)chunk_info->chunk_points, chunk_info->fspace, chunk_info->mspace) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "chunked write failed")
+            ent->job = job;
         } /* end if */
-        else {
-            /* If the chunk hasn't been allocated on disk, do so now. */
-            if(!H5F_addr_defined(udata.chunk_block.offset)) {
-                /* Compose chunked index info struct */
-                idx_info.f = io_info->dset->oloc.file;
-                idx_info.pline = &(io_info->dset->shared->dcpl_cache.pline);
-                idx_info.layout = &(io_info->dset->shared->layout.u.chunk);
-                idx_info.storage = &(io_info->dset->shared->layout.storage.u.chunk);
-
-                /* Set up the size of chunk for user data */
-                udata.chunk_block.length = io_info->dset->shared->layout.u.chunk.size;
-
-                /* Allocate the chunk */
-		if(H5D__chunk_file_alloc(&idx_info, NULL, &udata.chunk_block, &need_insert, chunk_info->scaled) < 0)
-		    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
-
-                /* Make sure the address of the chunk is returned. */
-                if(!H5F_addr_defined(udata.chunk_block.offset))
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk address isn't defined")
-
-                /* Cache the new chunk information */
-                H5D__chunk_cinfo_cache_update(&io_info->dset->shared->cache.chunk.last, &udata);
-            } /* end if */
-
-            /* Set up the storage address information for this chunk */
-            ctg_store.contig.dset_addr = udata.chunk_block.offset;
-
-            /* No chunk cached */
-            chunk = NULL;
-
-            /* Point I/O info at temporary I/O info for this chunk */
-            chk_io_info = &ctg_io_info;
-        } /* end else */
-
-        /* Perform the actual write operation */
-        if((io_info->io_ops.single_write)(chk_io_info, type_info,
-                (hsize_t)chunk_info->chunk_points, chunk_info->fspace, chunk_info->mspace) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked write failed")
-
-	/* Release the cache lock on the chunk, or insert chunk into index. */
-	if(chunk) {
-	    if(H5D__chunk_unlock(io_info, &udata, TRUE, chunk, dst_accessed_bytes) < 0)
-		HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
-	} /* end if */
-	else {
-            if(need_insert && io_info->dset->shared->layout.storage.u.chunk.ops->insert)
-                if((io_info->dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, NULL) < 0)
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
-	} /* end else */
 
         /* Advance to next chunk in list */
         chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
     } /* end while */
 
+    /* Filter the chunks */
+    start_time = H5_get_time();
+    if(H5Z_pipeline_threads(pline, 0, batch->err_detect, batch->filter_cb,
+            batch->nthreads, batch->njobs, batch->jobs) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "output pipeline failed")
+    dset->shared->cache.chunk.stats.filter_time += H5_get_time() - start_time;
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5D__chunk_write() */
+} /* end H5D__chunk_batch_write() */
+
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_flush
+ * Function:	H5D__chunk_batch_term
  *
- * Purpose:	Writes all dirty chunks to disk and optionally preempts them
- *		from the cache.
+ * Purpose:	Releases a batch of chunks, including the buffers of any
+ *		chunks the read or write didn't get to.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Robb Matzke
- *              Thursday, May 21, 1998
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_flush(H5D_t *dset)
+H5D__chunk_batch_term(const H5D_t *dset, H5D_chunk_batch_t *batch)
 {
-    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
-    H5D_rdcc_ent_t	*ent, *next;
-    unsigned		nerrors = 0;    /* Count of any errors encountered when flushing chunks */
-    herr_t ret_value = SUCCEED;         /* Return value */
+    size_t u;                           /* Local index variable */
 
-    FUNC_ENTER_STATIC
+    FUNC_ENTER_STATIC_NOERR
 
     /* Sanity check */
     HDassert(dset);
+    HDassert(batch);
 
-    /* Loop over all entries in the chunk cache */
-    for(ent = rdcc->head; ent; ent = next) {
-	next = ent->next;
-        if(H5D__chunk_flush_entry(dset, ent, FALSE) < 0)
-            nerrors++;
-    } /* end for */
-    if(nerrors)
-	HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+    if(batch->jobs) {
+        for(u = 0; u < batch->njobs; u++)
+            if(batch->jobs[u].buf)
+                batch->jobs[u].buf = H5D__chunk_mem_xfree(batch->jobs[u].buf, &(dset->shared->dcpl_cache.pline));
+        batch->jobs = (H5Z_pipeline_job_t *)H5MM_xfree(batch->jobs);
+    } /* end if */
+    batch->ents = (H5D_chunk_batch_ent_t *)H5MM_xfree(batch->ents);
+    batch->njobs = 0;
 
-done:
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_flush() */
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__chunk_batch_term() */
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_io_term
+ * Function:	H5D__chunk_cache_load
  *
- * Purpose:	Destroy I/O operation information.
+ * Purpose:	Loads the NCHUNKS chunks described by ENTS into the chunk
+ *		cache.  The chunks must be allocated, not cached, and not
+ *		partial edge chunks stored unfiltered; ENTS[u].idx must be
+ *		u.
+ *		They are read with one vector request, in file address
+ *		order (so that chunks adjacent in the file take a single
+ *		I/O with drivers which merge them), unfiltered together (on
+ *		several threads if the transfer property list allows it)
+ *		and put in the cache.
  *
- * Return:	Non-negative on success/Negative on failure
+ *		A chunk which can't be unfiltered is dropped, and the read
+ *		which needs it reports the error.
  *
- * Programmer:	Quincey Koziol
- *		Saturday, May 17, 2003
+ * Return:	Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_io_term(const H5D_chunk_map_t *fm)
+H5D__chunk_cache_load(const H5D_io_info_t *io_info, H5D_chunk_direct_ent_t *ents,
+    size_t nchunks)
 {
-    herr_t	ret_value = SUCCEED;	/*return value		*/
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    H5D_io_info_t ld_io_info;           /* I/O info for caching the chunks */
+    H5D_storage_t ld_store;             /* Chunk storage information for them */
+    H5D_chunk_direct_ent_t **order = NULL;      /* Chunks in file address order */
+    H5Z_pipeline_job_t *jobs = NULL;    /* Buffers of the chunks */
+    H5FD_mem_t *types = NULL;           /* Memory types for vector read */
+    haddr_t *addrs = NULL;              /* Addresses for vector read */
+    size_t *sizes = NULL;               /* Sizes for vector read */
+    void **bufs = NULL;                 /* Buffers for vector read */
+    double start_time;                  /* Time the pipeline was started */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
 
-    /* Single element I/O vs. multiple element I/O cleanup */
-    if(fm->use_single) {
-        /* Sanity checks */
-        HDassert(fm->sel_chunks == NULL);
-        HDassert(fm->single_chunk_info);
-        HDassert(fm->single_chunk_info->fspace_shared);
-        HDassert(fm->single_chunk_info->mspace_shared);
-
-        /* Reset the selection for the single element I/O */
-        H5S_select_all(fm->single_space, TRUE);
+    /* Sanity check */
+    HDassert(ents);
+    HDassert(nchunks > 0);
+
+    /* Read the chunks in file address order */
+    if(NULL == (jobs = (H5Z_pipeline_job_t *)H5MM_calloc(nchunks * sizeof(H5Z_pipeline_job_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunks to load")
+    if(NULL == (order = (H5D_chunk_direct_ent_t **)H5MM_malloc(nchunks * sizeof(H5D_chunk_direct_ent_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunks to load")
+    if(NULL == (types = (H5FD_mem_t *)H5MM_malloc(nchunks * sizeof(H5FD_mem_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(nchunks * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(nchunks * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (bufs = (void **)H5MM_malloc(nchunks * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    for(u = 0; u < nchunks; u++) {
+        H5Z_pipeline_job_t *job = &jobs[u];
+
+        H5_CHECKED_ASSIGN(job->nbytes, size_t, ents[u].udata.chunk_block.length, hsize_t);
+        job->buf_size = job->nbytes;
+        job->filter_mask = ents[u].udata.filter_mask;
+        job->status = SUCCEED;
+        if(NULL == (job->buf = H5D__chunk_mem_alloc(job->nbytes, pline)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+        order[u] = &ents[u];
+    } /* end for */
+    HDqsort(order, nchunks, sizeof(H5D_chunk_direct_ent_t *), H5D__chunk_direct_cmp_addr);
+    for(u = 0; u < nchunks; u++) {
+        types[u] = H5FD_MEM_DRAW;
+        addrs[u] = order[u]->udata.chunk_block.offset;
+        sizes[u] = jobs[order[u]->idx].nbytes;
+        bufs[u] = jobs[order[u]->idx].buf;
+    } /* end for */
+    if(H5F_block_read_vector(dset->oloc.file, (uint32_t)nchunks, types, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+    for(u = 0; u < nchunks; u++)
+        rdcc->stats.nbytes_read += sizes[u];
+
+    /* Unfilter the chunks */
+    if(pline->nused > 0) {
+        H5Z_EDC_t err_detect;           /* Error detection info */
+        H5Z_cb_t filter_cb;             /* I/O filter callback function */
+        unsigned nthreads = 1;          /* # of threads to run the pipeline on */
+
+        if(H5CX_get_err_detect(&err_detect) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+        if(H5CX_get_filter_cb(&filter_cb) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+        {
+            unsigned filter_threads;    /* # of filter pipeline threads allowed */
+            htri_t avail;               /* Whether the filters are registered */
+
+            if(H5CX_get_filter_threads(&filter_threads) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get # of filter pipeline threads")
+            if(filter_threads > 1) {
+                if((avail = H5Z_all_filters_avail(pline)) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check filter availability")
+                if(avail)
+                    nthreads = filter_threads;
+            } /* end if */
+        }
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+        /* (Chunks which fail are dropped below) */
+        start_time = H5_get_time();
+        if(H5Z_pipeline_threads(pline, H5Z_FLAG_REVERSE, err_detect, filter_cb,
+                nthreads, nchunks, jobs) < 0)
+            H5E_clear_stack(NULL);
+        rdcc->stats.filter_time += H5_get_time() - start_time;
+        for(u = 0; u < nchunks; u++)
+            if(jobs[u].status >= 0)
+                rdcc->stats.nbytes_unfiltered += jobs[u].nbytes;
     } /* end if */
-    else {
-        /* Release the nodes on the list of selected chunks */
-        if(fm->sel_chunks)
-            if(H5SL_free(fm->sel_chunks, H5D__free_chunk_info, NULL) < 0)
-                HGOTO_ERROR(H5E_PLIST, H5E_CANTNEXT, FAIL, "can't iterate over chunks")
-    } /* end else */
 
-    /* Free the memory chunk dataspace template */
-    if(fm->mchunk_tmpl)
-        if(H5S_close(fm->mchunk_tmpl) < 0)
-            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "can't release memory chunk dataspace template")
-#ifdef H5_HAVE_PARALLEL
-    if(fm->select_chunk)
-        H5MM_xfree(fm->select_chunk);
-#endif /* H5_HAVE_PARALLEL */
+    /* Put the chunks in the cache */
+    HDmemcpy(&ld_io_info, io_info, sizeof(ld_io_info));
+    ld_io_info.store = &ld_store;
+    for(u = 0; u < nchunks; u++) {
+        void *chunk;                    /* Chunk's buffer in the cache */
+
+        if(jobs[u].status < 0)
+            continue;
+
+        ld_store.chunk.scaled = ents[u].scaled;
+        ents[u].udata.filter_mask = jobs[u].filter_mask;
+        chunk = H5D__chunk_lock(&ld_io_info, &ents[u].udata, FALSE, FALSE, jobs[u].buf);
+        jobs[u].buf = NULL;
+        if(NULL == chunk)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to cache raw data chunk")
+        if(H5D__chunk_unlock(&ld_io_info, &ents[u].udata, FALSE, chunk, (uint32_t)0) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+    } /* end for */
 
 done:
+    if(jobs) {
+        for(u = 0; u < nchunks; u++)
+            if(jobs[u].buf)
+                jobs[u].buf = H5D__chunk_mem_xfree(jobs[u].buf, pline);
+        H5MM_xfree(jobs);
+    } /* end if */
+    H5MM_xfree(order);
+    H5MM_xfree(types);
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_io_term() */
+} /* end H5D__chunk_cache_load() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_dest
+ * Function:	H5D__chunk_read_ahead
  *
- * Purpose:	Destroy the entire chunk cache by flushing dirty entries,
- *		preempting all entries, and freeing the cache itself.
+ * Purpose:	Follows the chunks a dataset's reads visit and reads ahead
+ *		of them.  When the last three chunks visited are equally
+ *		far apart in the dataset's linear chunk order, and the next
+ *		chunk along that stride which the current read doesn't
+ *		select isn't cached, up to the dataset's read-ahead number
+ *		of chunks along the stride are loaded into the chunk cache
+ *		(see H5D__chunk_cache_load).
  *
- * Return:	Non-negative on success/Negative on failure
+ *		Chunks which are cached already, aren't allocated, or are
+ *		partial edge chunks stored unfiltered are skipped.
  *
- * Programmer:	Robb Matzke
- *              Thursday, May 21, 1998
+ * Return:	Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_dest(H5D_t *dset)
+H5D__chunk_read_ahead(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
+    hsize_t chunk_idx)
 {
-    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
-    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
-    H5D_rdcc_ent_t	*ent = NULL, *next = NULL;      /* Pointer to current & next cache entries */
-    int		nerrors = 0;            /* Accumulated count of errors */
-    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
-    herr_t      ret_value = SUCCEED;       /* Return value */
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk); /* Chunk layout */
+    H5D_chunk_direct_ent_t *ents = NULL;        /* Chunks to read ahead */
+    hssize_t stride;                    /* Distance from the chunk visited last */
+    hsize_t next;                       /* Index of the next chunk along the stride */
+    hbool_t first = TRUE;               /* Whether no chunk outside the read has been looked at */
+    size_t chunk_size;                  /* Size of a chunk */
+    size_t max_chunks;                  /* Max. # of chunks to read ahead */
+    size_t nchunks = 0;                 /* # of chunks to read ahead */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-    FUNC_ENTER_STATIC_TAG(dset->oloc.addr)
+    FUNC_ENTER_STATIC
 
-    /* Sanity checks */
-    HDassert(dset);
-    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+    /* Sanity check */
+    HDassert(rdcc->read_ahead > 0);
 
-    /* Flush all the cached chunks */
-    for(ent = rdcc->head; ent; ent = next) {
-        next = ent->next;
-        if(H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
-            nerrors++;
-    } /* end for */
-    
-    /* Continue even if there are failures. */
-    if(nerrors)
-        HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+    /* Visiting the same chunk again doesn't change the pattern */
+    if(chunk_idx == rdcc->ra_last_idx)
+        HGOTO_DONE(SUCCEED)
 
-    /* Release cache structures */
-    if(rdcc->slot)
-        rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
-    HDmemset(rdcc, 0, sizeof(H5D_rdcc_t));
+    /* Update the pattern, and read ahead if it repeats */
+    stride = (HSIZE_UNDEF == rdcc->ra_last_idx) ? 0 : (hssize_t)(chunk_idx - rdcc->ra_last_idx);
+    rdcc->ra_last_idx = chunk_idx;
+    if(0 == stride || stride != rdcc->ra_stride) {
+        rdcc->ra_stride = stride;
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
 
-    /* Compose chunked index info struct */
-    idx_info.f = dset->oloc.file;
-    idx_info.pline = &dset->shared->dcpl_cache.pline;
-    idx_info.layout = &dset->shared->layout.u.chunk;
-    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+#ifdef H5_HAVE_PARALLEL
+    /* Other processes may be writing the chunks */
+    if(io_info->using_mpi_vfd)
+        HGOTO_DONE(SUCCEED)
+#endif /* H5_HAVE_PARALLEL */
 
-    /* Free any index structures */
-    if(dset->shared->layout.storage.u.chunk.ops->dest &&
-            (dset->shared->layout.storage.u.chunk.ops->dest)(&idx_info) < 0)
-	HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release chunk index info")
+    /* Read no more chunks than the cache holds besides the one visited */
+    H5_CHECKED_ASSIGN(chunk_size, size_t, layout->size, uint32_t);
+    if(0 == rdcc->nslots)
+        HGOTO_DONE(SUCCEED)
+    max_chunks = rdcc->nbytes_max / chunk_size;
+    if(rdcc->pool)
+        max_chunks = MIN(max_chunks, rdcc->pool->nbytes_max / chunk_size);
+    if(max_chunks < 2)
+        HGOTO_DONE(SUCCEED)
+    max_chunks = MIN(max_chunks - 1, (size_t)rdcc->read_ahead);
+
+    if(NULL == (ents = (H5D_chunk_direct_ent_t *)H5MM_calloc(max_chunks * sizeof(H5D_chunk_direct_ent_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunks to read ahead")
+
+    /* Find the chunks to read */
+    next = chunk_idx;
+    for(u = 0; u < max_chunks; u++) {
+        H5D_chunk_direct_ent_t *ent = &ents[nchunks];
+
+        /* Stop at either end of the dataset */
+        if(stride > 0 ? (hsize_t)stride >= layout->nchunks - next : (hsize_t)(-stride) > next)
+            break;
+        next += (hsize_t)stride;
+
+        /* Leave the chunks the read selects to it */
+        if(fm->use_single ? next == fm->single_chunk_info->index : NULL != H5SL_search(fm->sel_chunks, &next))
+            continue;
+
+        ent->chunk_idx = next;
+        if(H5VM_array_calc_pre(next, layout->ndims - 1, layout->down_chunks, ent->scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute chunk's scaled coordinates")
+        ent->scaled[layout->ndims - 1] = 0;
+        if(H5D__chunk_lookup(dset, ent->scaled, &ent->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* The chunks ahead are still cached from the last time */
+        if(UINT_MAX != ent->udata.idx_hint) {
+            if(first)
+                HGOTO_DONE(SUCCEED)
+            continue;
+        } /* end if */
+        first = FALSE;
+
+        if(!H5F_addr_defined(ent->udata.chunk_block.offset))
+            continue;
+        if((layout->flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims, layout->dim,
+                    ent->scaled, dset->shared->curr_dims))
+            continue;
+
+        ent->idx = nchunks++;
+    } /* end for */
+    if(0 == nchunks)
+        HGOTO_DONE(SUCCEED)
+
+    /* Load them into the cache */
+    if(H5D__chunk_cache_load(io_info, ents, nchunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to load chunks read ahead")
 
 done:
-    FUNC_LEAVE_NOAPI_TAG(ret_value)
-} /* end H5D__chunk_dest() */
+    H5MM_xfree(ents);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_read_ahead() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D_chunk_idx_reset
+ * Function:	H5D__chunk_read_shard
  *
- * Purpose:	Reset index information
+ * Purpose:	Reads the whole shard holding the chunk at SCALED, for a
+ *		dataset with a sharded chunk index: the other allocated
+ *		chunks of the shard which aren't cached are loaded into
+ *		the chunk cache along with it (see H5D__chunk_cache_load),
+ *		so that the reads of a shard's chunks take one I/O request
+ *		instead of one each.
  *
- * Return:	Non-negative on success/Negative on failure
+ *		Nothing is read when the cache can't hold the shard's
+ *		chunks, or when fewer than two of them need reading.
  *
- * Programmer:	Quincey Koziol
- *              Thursday, January 15, 2009
+ * Return:	TRUE if the shard was read/FALSE if not/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
-herr_t
-H5D_chunk_idx_reset(H5O_storage_chunk_t *storage, hbool_t reset_addr)
+static htri_t
+H5D__chunk_read_shard(const H5D_io_info_t *io_info, const hsize_t scaled[])
 {
-    herr_t ret_value = SUCCEED;         /* Return value */
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk); /* Chunk layout */
+    H5D_chunk_direct_ent_t *ents = NULL;        /* Chunks of the shard to read */
+    hsize_t start[H5O_LAYOUT_NDIMS];    /* First chunk of the shard in each dimension */
+    hsize_t count[H5O_LAYOUT_NDIMS];    /* # of the shard's chunks in each dimension */
+    hsize_t curr[H5O_LAYOUT_NDIMS];     /* Chunk of the shard being looked at */
+    size_t chunk_size;                  /* Size of a chunk */
+    size_t max_chunks;                  /* Max. # of chunks the cache holds */
+    size_t shard_chunks = 1;            /* # of chunks in the shard */
+    size_t nchunks = 0;                 /* # of chunks to read */
+    unsigned ndims = layout->ndims - 1; /* # of dataset dimensions */
+    unsigned u;                         /* Local index variable */
+    htri_t ret_value = FALSE;           /* Return value */
 
-    FUNC_ENTER_NOAPI(FAIL)
+    FUNC_ENTER_STATIC
 
-    /* Sanity checks */
-    HDassert(storage);
-    HDassert(storage->ops);
-    H5D_CHUNK_STORAGE_INDEX_CHK(storage);
+    /* Sanity check */
+    HDassert(H5D_CHUNK_IDX_SHARD == dset->shared->layout.storage.u.chunk.idx_type);
 
-    /* Reset index structures */
-    if((storage->ops->reset)(storage, reset_addr) < 0)
-	HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to reset chunk index info")
+#ifdef H5_HAVE_PARALLEL
+    /* Other processes may be writing the chunks */
+    if(io_info->using_mpi_vfd)
+        HGOTO_DONE(FALSE)
+#endif /* H5_HAVE_PARALLEL */
+
+    /* Find the shard's chunks, clipped to the dataset's extent */
+    for(u = 0; u < ndims; u++) {
+        hsize_t shard_dim = layout->u.shard.shard_dim[u];
+
+        start[u] = (scaled[u] / shard_dim) * shard_dim;
+        count[u] = MIN(shard_dim, layout->chunks[u] - start[u]);
+        curr[u] = start[u];
+        shard_chunks *= (size_t)count[u];
+    } /* end for */
+    curr[ndims] = 0;
+    if(shard_chunks < 2)
+        HGOTO_DONE(FALSE)
+
+    /* Read only shards the cache holds whole */
+    H5_CHECKED_ASSIGN(chunk_size, size_t, layout->size, uint32_t);
+    if(0 == rdcc->nslots)
+        HGOTO_DONE(FALSE)
+    max_chunks = rdcc->nbytes_max / chunk_size;
+    if(rdcc->pool)
+        max_chunks = MIN(max_chunks, rdcc->pool->nbytes_max / chunk_size);
+    if(shard_chunks > max_chunks || shard_chunks > rdcc->nslots)
+        HGOTO_DONE(FALSE)
+
+    if(NULL == (ents = (H5D_chunk_direct_ent_t *)H5MM_calloc(shard_chunks * sizeof(H5D_chunk_direct_ent_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunks of shard")
+
+    /* Look the shard's chunks up, in the shard's row-major order */
+    do {
+        H5D_chunk_direct_ent_t *ent = &ents[nchunks];
+
+        HDmemcpy(ent->scaled, curr, sizeof(curr));
+        if(H5D__chunk_lookup(dset, ent->scaled, &ent->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Skip chunks cached already, not allocated, or which can't be cached */
+        if(UINT_MAX == ent->udata.idx_hint && H5F_addr_defined(ent->udata.chunk_block.offset)
+                && !((layout->flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                    && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims, layout->dim,
+                        ent->scaled, dset->shared->curr_dims))) {
+            ent->chunk_idx = H5VM_array_offset_pre(ndims, layout->down_chunks, curr);
+            ent->idx = nchunks++;
+        } /* end if */
+
+        /* Advance to the shard's next chunk */
+        for(u = ndims; u > 0; u--) {
+            if(++curr[u - 1] < start[u - 1] + count[u - 1])
+                break;
+            curr[u - 1] = start[u - 1];
+        } /* end for */
+    } while(u > 0);
+    if(nchunks < 2)
+        HGOTO_DONE(FALSE)
+
+    /* Load them into the cache */
+    if(H5D__chunk_cache_load(io_info, ents, nchunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to load chunks of shard")
+    ret_value = TRUE;
 
 done:
+    H5MM_xfree(ents);
+
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D_chunk_idx_reset() */
+} /* end H5D__chunk_read_shard() */
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_cinfo_cache_reset
+ * Function:	H5D__chunk_whole_sel
  *
- * Purpose:	Reset the cached chunk info
- *
- * Return:	Non-negative on success/Negative on failure
+ * Purpose:	Checks whether the selection in SPACE, iterated in order,
+ *		is a single run of NBYTES bytes, and if so returns the
+ *		run's offset in the buffer through OFF.
  *
- * Programmer:	Quincey Koziol
- *              November 27, 2007
+ * Return:	TRUE/FALSE on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5D__chunk_cinfo_cache_reset(H5D_chunk_cached_t *last)
+static htri_t
+H5D__chunk_whole_sel(const H5S_t *space, size_t elmt_size, size_t nelmts,
+    size_t nbytes, hsize_t *off)
 {
-    FUNC_ENTER_PACKAGE_NOERR
+    H5S_sel_iter_t *iter = NULL;        /* Selection iteration info */
+    hbool_t     iter_init = FALSE;      /* Whether the iterator is set up */
+    hsize_t     seq_off[2];             /* Offsets of the selection's first sequences */
+    size_t      seq_len[2];             /* Lengths of the selection's first sequences */
+    size_t      nseq;                   /* Number of sequences found */
+    size_t      nelem;                  /* Number of elements in the sequences */
+    htri_t      ret_value = FALSE;      /* Return value */
 
-    /* Sanity check */
-    HDassert(last);
+    FUNC_ENTER_STATIC
 
-    /* Indicate that the cached info is not valid */
-    last->valid = FALSE;
+    HDassert(space);
+    HDassert(off);
 
-    FUNC_LEAVE_NOAPI(SUCCEED)
-} /* H5D__chunk_cinfo_cache_reset() */
+    if(NULL == (iter = H5FL_MALLOC(H5S_sel_iter_t)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate selection iterator")
+    if(H5S_select_iter_init(iter, space, elmt_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    iter_init = TRUE;
+
+    /* Look for more than one sequence, to tell a single one apart */
+    if(H5S_SELECT_GET_SEQ_LIST(space, 0, iter, (size_t)2, nelmts, &nseq, &nelem, seq_off, seq_len) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "sequence length generation failed")
+
+    if(1 == nseq && seq_len[0] == nbytes) {
+        *off = seq_off[0];
+        ret_value = TRUE;
+    } /* end if */
+
+done:
+    if(iter_init && H5S_SELECT_ITER_RELEASE(iter) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release selection iterator")
+    if(iter)
+        iter = H5FL_FREE(H5S_sel_iter_t, iter);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_whole_sel() */
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_cinfo_cache_update
+ * Function:	H5D__chunk_read_direct
  *
- * Purpose:	Update the cached chunk info
+ * Purpose:	Reads a chunk straight from the file into the application's
+ *		buffer, bypassing the chunk cache and the copy out of it,
+ *		for transfers set up with H5Pset_chunk_cache_bypass().
  *
- * Return:	Non-negative on success/Negative on failure
+ *		This is only done when the read selects the whole chunk in
+ *		the chunk's own element order, lands in one contiguous run
+ *		of the buffer, needs no datatype conversion or data
+ *		transform, and the chunk is stored and not in the chunk
+ *		cache already.
  *
- * Programmer:	Quincey Koziol
- *              November 27, 2007
+ *		A filtered chunk is unfiltered straight into the
+ *		application's buffer when the last filter run is deflate
+ *		(see H5Z_pipeline_into).  Otherwise it is unfiltered in a
+ *		buffer of its own and copied, since filters allocate their
+ *		output.  If JOB is given, the chunk was unfiltered in JOB's
+ *		buffer already, which is copied and released.
+ *
+ * Return:	TRUE if the chunk was read, FALSE if it wasn't suitable,
+ *		Negative on failure
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5D__chunk_cinfo_cache_update(H5D_chunk_cached_t *last, const H5D_chunk_ud_t *udata)
+static htri_t
+H5D__chunk_read_direct(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    const H5D_chunk_info_t *chunk_info, const H5D_chunk_ud_t *udata, H5Z_pipeline_job_t *job)
 {
-    FUNC_ENTER_STATIC_NOERR
+    const H5D_t *dset = io_info->dset;  /* Dataset being read */
+    H5D_rdcc_t  *rdcc = &(dset->shared->cache.chunk);   /* Raw data chunk cache */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline);  /* I/O pipeline info */
+    size_t      chunk_size = dset->shared->layout.u.chunk.size; /* Size of a chunk */
+    hsize_t     file_off;               /* Offset of the selection in the chunk */
+    hsize_t     mem_off;                /* Offset of the selection in the buffer */
+    void        *buf = NULL;            /* Buffer to unfilter the chunk in */
+    htri_t      in_rbuf = FALSE;        /* Whether the chunk was unfiltered into the application's buffer */
+    htri_t      whole;                  /* Whether a selection is one whole run */
+    htri_t      ret_value = FALSE;      /* Return value */
 
-    /* Sanity check */
-    HDassert(last);
+    FUNC_ENTER_STATIC
+
+    HDassert(io_info);
+    HDassert(type_info);
+    HDassert(chunk_info);
     HDassert(udata);
-    HDassert(udata->common.layout);
-    HDassert(udata->common.scaled);
 
-    /* Stored the information to cache */
-    HDmemcpy(last->scaled, udata->common.scaled, sizeof(hsize_t) * udata->common.layout->ndims);
-    last->addr = udata->chunk_block.offset;
-    H5_CHECKED_ASSIGN(last->nbytes, uint32_t, udata->chunk_block.length, hsize_t);
-    last->chunk_idx = udata->chunk_idx;
-    last->filter_mask = udata->filter_mask;
+    /* Check the cheap conditions first.  Selecting every element rules
+     * out partial edge chunks, which may be stored unfiltered. */
+    if(!type_info->is_conv_noop || !type_info->is_xform_noop
+            || UINT_MAX != udata->idx_hint
+            || !H5F_addr_defined(udata->chunk_block.offset)
+            || (size_t)chunk_info->chunk_points * type_info->src_type_size != chunk_size)
+        HGOTO_DONE(FALSE)
+    HDassert(pline->nused > 0 || udata->chunk_block.length == chunk_size);
+    HDassert(!job || pline->nused > 0);
+
+    /* The chunk's elements must be read in their stored order ... */
+    if((whole = H5D__chunk_whole_sel(chunk_info->fspace, type_info->src_type_size,
+            (size_t)chunk_info->chunk_points, chunk_size, &file_off)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check chunk selection")
+    if(!whole || file_off != 0)
+        HGOTO_DONE(FALSE)
+
+    /* ... into one run of the buffer */
+    if((whole = H5D__chunk_whole_sel(chunk_info->mspace, type_info->dst_type_size,
+            (size_t)chunk_info->chunk_points, chunk_size, &mem_off)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check memory selection")
+    if(!whole)
+        HGOTO_DONE(FALSE)
+
+    if(job) {
+        /* Take over the batch's unfiltered chunk */
+        if(job->nbytes != chunk_size)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADSIZE, FAIL, "unfiltered chunk has the wrong size")
+        buf = job->buf;
+        job->buf = NULL;
+    } /* end if */
+    else if(pline->nused > 0) {
+        H5Z_EDC_t err_detect;           /* Error detection info */
+        H5Z_cb_t filter_cb;             /* I/O filter callback function */
+        unsigned filter_mask = udata->filter_mask;  /* Filters skipped for the chunk */
+        size_t  nbytes;                 /* Size of the chunk's data */
+        size_t  buf_alloc;              /* [Re-]allocated buffer size */
+        double  start_time;             /* Time the pipeline was started */
+
+        /* Retrieve filter settings from API context */
+        if(H5CX_get_err_detect(&err_detect) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+        if(H5CX_get_filter_cb(&filter_cb) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+
+        H5_CHECKED_ASSIGN(nbytes, size_t, udata->chunk_block.length, hsize_t);
+        buf_alloc = nbytes;
+        if(NULL == (buf = H5D__chunk_mem_alloc(nbytes, pline)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+        if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, udata->chunk_block.offset, nbytes, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+        rdcc->stats.nbytes_read += nbytes;
+
+        /* Unfilter the chunk, straight into the application's buffer if
+         * the pipeline can */
+        start_time = H5_get_time();
+        if((in_rbuf = H5Z_pipeline_into(pline, &filter_mask, err_detect, filter_cb,
+                &nbytes, &buf_alloc, &buf, (uint8_t *)io_info->u.rbuf + mem_off, chunk_size)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+        rdcc->stats.filter_time += H5_get_time() - start_time;
+        rdcc->stats.nbytes_unfiltered += nbytes;
+        if(nbytes != chunk_size)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADSIZE, FAIL, "unfiltered chunk has the wrong size")
+    } /* end if */
 
-    /* Indicate that the cached info is valid */
-    last->valid = TRUE;
+    if(buf) {
+        if(!in_rbuf)
+            HDmemcpy((uint8_t *)io_info->u.rbuf + mem_off, buf, chunk_size);
+    } /* end if */
+    else {
+        /* Chunks the cache decided not to hold may be in the sieve buffer */
+        if(H5D__flush_sieve_buf(dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush sieve buffer")
+
+        if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, udata->chunk_block.offset,
+                chunk_size, (uint8_t *)io_info->u.rbuf + mem_off) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+        rdcc->stats.nbytes_read += chunk_size;
+    } /* end else */
 
-    FUNC_LEAVE_NOAPI(SUCCEED)
-} /* H5D__chunk_cinfo_cache_update() */
+    ret_value = TRUE;
+
+done:
+    if(buf)
+        buf = H5D__chunk_mem_xfree(buf, pline);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_read_direct() */
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_cinfo_cache_found
+ * Function:	H5D__chunk_read
  *
- * Purpose:	Look for chunk info in cache
+ * Purpose:	Read from a chunked dataset.
  *
- * Return:	TRUE/FALSE/FAIL
+ * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Quincey Koziol
- *              November 27, 2007
+ * Programmer:	Raymond Lu
+ *		Thursday, April 10, 2003
  *
  *-------------------------------------------------------------------------
  */
-static hbool_t
-H5D__chunk_cinfo_cache_found(const H5D_chunk_cached_t *last, H5D_chunk_ud_t *udata)
+static herr_t
+H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
+    H5D_chunk_map_t *fm)
 {
-    hbool_t ret_value = FALSE;          /* Return value */
-
-    FUNC_ENTER_STATIC_NOERR
-
-    /* Sanity check */
-    HDassert(last);
-    HDassert(udata);
-    HDassert(udata->common.layout);
-    HDassert(udata->common.scaled);
-
+    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
+    H5D_io_info_t nonexistent_io_info;  /* "nonexistent" I/O info object */
+    H5D_io_info_t ctg_io_info;          /* Contiguous I/O info object */
+    H5D_storage_t ctg_store;            /* Chunk storage information as contiguous dataset */
+    H5D_io_info_t cpt_io_info;          /* Compact I/O info object */
+    H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
+    hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
+    uint32_t    src_accessed_bytes = 0; /* Total accessed size in a chunk */
+    hbool_t     skip_missing_chunks = FALSE;    /* Whether to skip missing chunks */
+    H5D_chunk_batch_t batch;            /* Batch of chunks to unfilter at once */
+    hbool_t     batch_init = FALSE;     /* Whether the chunk batch has been set up */
+    hbool_t     bypass;                 /* Whether whole chunks bypass the chunk cache */
+    herr_t	ret_value = SUCCEED;	/*return value		*/
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(io_info);
+    HDassert(io_info->u.rbuf);
+    HDassert(type_info);
+    HDassert(fm);
+
+    /* Set up "nonexistent" I/O info object */
+    HDmemcpy(&nonexistent_io_info, io_info, sizeof(nonexistent_io_info));
+    nonexistent_io_info.layout_ops = *H5D_LOPS_NONEXISTENT;
+
+    /* Set up contiguous I/O info object */
+    HDmemcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
+    ctg_io_info.store = &ctg_store;
+    ctg_io_info.layout_ops = *H5D_LOPS_CONTIG;
+
+    /* Initialize temporary contiguous storage info */
+    H5_CHECKED_ASSIGN(ctg_store.contig.dset_size, hsize_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
+
+    /* Set up compact I/O info object */
+    HDmemcpy(&cpt_io_info, io_info, sizeof(cpt_io_info));
+    cpt_io_info.store = &cpt_store;
+    cpt_io_info.layout_ops = *H5D_LOPS_COMPACT;
+
+    /* Initialize temporary compact storage info */
+    cpt_store.compact.dirty = &cpt_dirty;
+
+    {
+        const H5O_fill_t *fill = &(io_info->dset->shared->dcpl_cache.fill);    /* Fill value info */
+        H5D_fill_value_t fill_status;       /* Fill value status */
+
+        /* Check the fill value status */
+        if(H5P_is_fill_value_defined(fill, &fill_status) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't tell if fill value defined")
+
+        /* If we are never to return fill values, or if we would return them
+         * but they aren't set, set the flag to skip missing chunks.
+         */
+        if(fill->fill_time == H5D_FILL_TIME_NEVER ||
+                (fill->fill_time == H5D_FILL_TIME_IFSET &&
+                 fill_status != H5D_FILL_VALUE_USER_DEFINED &&
+                 fill_status != H5D_FILL_VALUE_DEFAULT))
+            skip_missing_chunks = TRUE;
+    }
+
+    /* Check whether whole chunks should bypass the chunk cache */
+    if(H5CX_get_chunk_cache_bypass(&bypass) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get chunk cache bypass flag")
+
+    /* Check whether to unfilter the chunks in batches on several threads */
+    if(H5D__chunk_batch_init(io_info, fm, &batch) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't set up batch of chunks")
+    batch_init = TRUE;
+
+    /* Iterate through nodes in chunk skip list */
+    chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
+    while(chunk_node) {
+        H5D_chunk_info_t *chunk_info;   /* Chunk information */
+        H5D_chunk_ud_t udata;		/* Chunk index pass-through	*/
+        H5Z_pipeline_job_t *job = NULL; /* Chunk's job in the batch */
+        htri_t direct;                  /* Whether the chunk was read directly */
+
+        /* Get the actual chunk information from the skip list node */
+        chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
+
+        /* Read and unfilter the next batch of chunks, if needed */
+        if(batch.nthreads > 1) {
+            if(batch.curr == batch.nchunks)
+                if(H5D__chunk_batch_read(io_info, fm, chunk_node, &batch) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read batch of chunks")
+            job = batch.ents[batch.curr].job;
+            if(job) {
+                /* The chunk wasn't cached and nothing since has cached it */
+                udata = batch.ents[batch.curr].udata;
+                udata.filter_mask = job->filter_mask;
+            } /* end if */
+            batch.curr++;
+        } /* end if */
+
+        /* Get the info for the chunk in the file */
+        if(!job && H5D__chunk_lookup(io_info->dset, chunk_info->scaled, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Read the rest of a sharded chunk's shard along with it */
+        if(!job && !bypass && H5D_CHUNK_IDX_SHARD == io_info->dset->shared->layout.storage.u.chunk.idx_type
+                && UINT_MAX == udata.idx_hint && H5F_addr_defined(udata.chunk_block.offset)) {
+            htri_t shard_read;          /* Whether the shard was read */
+
+            if((shard_read = H5D__chunk_read_shard(io_info, chunk_info->scaled)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read shard")
+            if(shard_read && H5D__chunk_lookup(io_info->dset, chunk_info->scaled, &udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        } /* end if */
+
+        /* Sanity check */
+        HDassert((H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) || 
+                (!H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length == 0));
+
+        /* Read a whole chunk straight into the buffer, if asked to */
+        direct = FALSE;
+        if(bypass && (direct = H5D__chunk_read_direct(io_info, type_info, chunk_info, &udata, job)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+        /* Check for non-existant chunk & skip it if appropriate */
+        if(!direct && (H5F_addr_defined(udata.chunk_block.offset) || UINT_MAX != udata.idx_hint
+                || !skip_missing_chunks)) {
+            H5D_io_info_t *chk_io_info;     /* Pointer to I/O info object for this chunk */
+            void *chunk = NULL;             /* Pointer to locked chunk buffer */
+            htri_t cacheable;               /* Whether the chunk is cacheable */
+
+            /* Set chunk's [scaled] coordinates */
+            io_info->store->chunk.scaled = chunk_info->scaled;
+
+            /* Determine if we should use the chunk cache */
+            if((cacheable = H5D__chunk_cacheable(io_info, udata.chunk_block.offset, FALSE)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunk is cacheable")
+            if(cacheable) {
+                /* Load the chunk into cache and lock it. */
+
+                /* Compute # of bytes accessed in chunk */
+                H5_CHECK_OVERFLOW(type_info->src_type_size, /*From:*/ size_t, /*To:*/ uint32_t);
+                src_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->src_type_size;
+
+                /* Lock the chunk into the cache (which takes over any
+                 * buffer the chunk was already unfiltered into) */
+                chunk = H5D__chunk_lock(io_info, &udata, FALSE, FALSE, (job ? job->buf : NULL));
+                if(job)
+                    job->buf = NULL;
+                if(NULL == chunk)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+                /* Set up the storage buffer information for this chunk */
+                cpt_store.compact.buf = chunk;
+
+                /* Point I/O info at contiguous I/O info for this chunk */
+                chk_io_info = &cpt_io_info;
+            } /* end if */
+            else if(H5F_addr_defined(udata.chunk_block.offset)) {
+                /* Set up the storage address information for this chunk */
+                ctg_store.contig.dset_addr = udata.chunk_block.offset;
+
+                /* Point I/O info at temporary I/O info for this chunk */
+                chk_io_info = &ctg_io_info;
+            } /* end else if */
+            else {
+                /* Point I/O info at "nonexistent" I/O info for this chunk */
+                chk_io_info = &nonexistent_io_info;
+            } /* end else */
+
+            /* Perform the actual read operation */
+            if((io_info->io_ops.single_read)(chk_io_info, type_info,
+                    (hsize_t)chunk_info->chunk_points, chunk_info->fspace, chunk_info->mspace) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked read failed")
+
+            /* Release the cache lock on the chunk. */
+            if(chunk && H5D__chunk_unlock(io_info, &udata, FALSE, chunk, src_accessed_bytes) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+        } /* end if */
+
+        /* Read ahead of sequential or strided access */
+        if(io_info->dset->shared->cache.chunk.read_ahead > 0
+                && H5D__chunk_read_ahead(io_info, fm, chunk_info->index) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read ahead")
+
+        /* Advance to next chunk in list */
+        chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+    } /* end while */
+
+done:
+    /* Release the batch of chunks */
+    if(batch_init && H5D__chunk_batch_term(io_info->dset, &batch) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release batch of chunks")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write
+ *
+ * Purpose:	Writes to a chunked dataset.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Raymond Lu
+ *		Thursday, April 10, 2003
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
+    H5D_chunk_map_t *fm)
+{
+    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
+    H5D_io_info_t ctg_io_info;          /* Contiguous I/O info object */
+    H5D_storage_t ctg_store;            /* Chunk storage information as contiguous dataset */
+    H5D_io_info_t cpt_io_info;          /* Compact I/O info object */
+    H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
+    hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
+    uint32_t    dst_accessed_bytes = 0; /* Total accessed size in a chunk */
+    H5D_chunk_batch_t batch;            /* Batch of chunks to filter at once */
+    hbool_t     batch_init = FALSE;     /* Whether the chunk batch has been set up */
+    herr_t	ret_value = SUCCEED;	/* Return value		*/
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(io_info);
+    HDassert(io_info->u.wbuf);
+    HDassert(type_info);
+    HDassert(fm);
+
+    /* Set up contiguous I/O info object */
+    HDmemcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
+    ctg_io_info.store = &ctg_store;
+    ctg_io_info.layout_ops = *H5D_LOPS_CONTIG;
+
+    /* Initialize temporary contiguous storage info */
+    H5_CHECKED_ASSIGN(ctg_store.contig.dset_size, hsize_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
+
+    /* Set up compact I/O info object */
+    HDmemcpy(&cpt_io_info, io_info, sizeof(cpt_io_info));
+    cpt_io_info.store = &cpt_store;
+    cpt_io_info.layout_ops = *H5D_LOPS_COMPACT;
+
+    /* Initialize temporary compact storage info */
+    cpt_store.compact.dirty = &cpt_dirty;
+
+    /* Check whether to filter the chunks in batches on several threads */
+    if(H5D__chunk_batch_init(io_info, fm, &batch) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't set up batch of chunks")
+    batch_init = TRUE;
+
+    /* Iterate through nodes in chunk skip list */
+    chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
+    while(chunk_node) {
+        H5D_chunk_info_t *chunk_info;   /* Chunk information */
+	H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+        H5D_io_info_t *chk_io_info;     /* Pointer to I/O info object for this chunk */
+        void *chunk;                    /* Pointer to locked chunk buffer */
+        H5D_chunk_ud_t udata;		/* Index pass-through	*/
+        htri_t cacheable;               /* Whether the chunk is cacheable */
+        hbool_t need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
+
+        /* Get the actual chunk information from the skip list node */
+        chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
+
+        /* Fill in and filter the next batch of chunks, if needed */
+        if(batch.nthreads > 1) {
+            H5D_chunk_batch_ent_t *ent;     /* Chunk's entry in the batch */
+
+            if(batch.curr == batch.nchunks)
+                if(H5D__chunk_batch_write(io_info, type_info, fm, chunk_node, &cpt_io_info, &batch) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write batch of chunks")
+            ent = &batch.ents[batch.curr++];
+
+            /* Write a filtered chunk from the batch straight to the file */
+            if(ent->job) {
+                H5F_block_t old_chunk = ent->udata.chunk_block; /* Chunk's location before the write */
+
+#if H5_SIZEOF_SIZE_T > 4
+                /* Check for the chunk expanding too much to encode in a 32-bit value */
+                if(ent->job->nbytes > ((size_t)0xffffffff))
+                    HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+                H5_CHECKED_ASSIGN(ent->udata.chunk_block.length, hsize_t, ent->job->nbytes, size_t);
+                ent->udata.filter_mask = ent->job->filter_mask;
+                if(H5D__chunk_write_block(io_info->dset, &ent->udata, &old_chunk, chunk_info->scaled, ent->job->buf) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data chunk")
+                ent->job->buf = H5D__chunk_mem_xfree(ent->job->buf, &(io_info->dset->shared->dcpl_cache.pline));
+
+                /* Advance to next chunk in list */
+                chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+                continue;
+            } /* end if */
+        } /* end if */
+
+        /* Look up the chunk */
+        if(H5D__chunk_lookup(io_info->dset, chunk_info->scaled, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Sanity check */
+        HDassert((H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) || 
+                (!H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length == 0));
+
+	/* Set chunk's [scaled] coordinates */
+	io_info->store->chunk.scaled = chunk_info->scaled;
+
+        /* Determine if we should use the chunk cache */
+        if((cacheable = H5D__chunk_cacheable(io_info, udata.chunk_block.offset, TRUE)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunk is cacheable")
+        if(cacheable) {
+            /* Load the chunk into cache.  But if the whole chunk is written,
+             * simply allocate space instead of load the chunk. */
+            hbool_t entire_chunk = TRUE;       /* Whether whole chunk is selected */
+
+            /* Compute # of bytes accessed in chunk */
+            H5_CHECK_OVERFLOW(type_info->dst_type_size, /*From:*/ size_t, /*To:*/ uint32_t);
+            dst_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->dst_type_size;
+
+            /* Determine if we will access all the data in the chunk */
+            if(dst_accessed_bytes != ctg_store.contig.dset_size ||
+                    (chunk_info->chunk_points * type_info->src_type_size) != ctg_store.contig.dset_size ||
+		    fm->fsel_type == H5S_SEL_POINTS)
+                entire_chunk = FALSE;
+
+            /* Lock the chunk into the cache */
+            if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk, FALSE, NULL)))
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+            /* Set up the storage buffer information for this chunk */
+            cpt_store.compact.buf = chunk;
+
+            /* Point I/O info at main I/O info for this chunk */
+            chk_io_info = &cpt_io_info;
+        } /* end if */
+        else {
+            /* If the chunk hasn't been allocated on disk, do so now. */
+            if(!H5F_addr_defined(udata.chunk_block.offset)) {
+                /* Compose chunked index info struct */
+                idx_info.f = io_info->dset->oloc.file;
+                idx_info.pline = &(io_info->dset->shared->dcpl_cache.pline);
+                idx_info.layout = &(io_info->dset->shared->layout.u.chunk);
+                idx_info.storage = &(io_info->dset->shared->layout.storage.u.chunk);
+
+                /* Set up the size of chunk for user data */
+                udata.chunk_block.length = io_info->dset->shared->layout.u.chunk.size;
+
+                /* Allocate the chunk */
+		if(H5D__chunk_file_alloc(&idx_info, NULL, &udata.chunk_block, &need_insert, chunk_info->scaled) < 0)
+		    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+
+                /* Make sure the address of the chunk is returned. */
+                if(!H5F_addr_defined(udata.chunk_block.offset))
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk address isn't defined")
+
+                /* Cache the new chunk information */
+                H5D__chunk_cinfo_cache_update(&io_info->dset->shared->cache.chunk.last, &udata);
+            } /* end if */
+
+            /* Set up the storage address information for this chunk */
+            ctg_store.contig.dset_addr = udata.chunk_block.offset;
+
+            /* No chunk cached */
+            chunk = NULL;
+
+            /* Point I/O info at temporary I/O info for this chunk */
+            chk_io_info = &ctg_io_info;
+        } /* end else */
+
+        /* Perform the actual write operation */
+        if((io_info->io_ops.single_write)(chk_io_info, type_info,
+                (hsize_t)chunk_info->chunk_points, chunk_info->fspace, chunk_info->mspace) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked write failed")
+
+	/* Release the cache lock on the chunk, or insert chunk into index. */
+	if(chunk) {
+	    if(H5D__chunk_unlock(io_info, &udata, TRUE, chunk, dst_accessed_bytes) < 0)
+		HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+	} /* end if */
+	else {
+            if(need_insert && io_info->dset->shared->layout.storage.u.chunk.ops->insert)
+                if((io_info->dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, NULL) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+	} /* end else */
+
+        /* Advance to next chunk in list */
+        chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+    } /* end while */
+
+done:
+    /* Release the batch of chunks */
+    if(batch_init && H5D__chunk_batch_term(io_info->dset, &batch) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release batch of chunks")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush
+ *
+ * Purpose:	Writes all dirty chunks to disk and optionally preempts them
+ *		from the cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush(H5D_t *dset)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(dset);
+
+    /* Write all the dirty entries in the chunk cache at once */
+    if(H5D__chunk_flush_batch(dset, rdcc->head, SIZET_MAX) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_io_term
+ *
+ * Purpose:	Destroy I/O operation information.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *		Saturday, May 17, 2003
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_io_term(const H5D_chunk_map_t *fm)
+{
+    herr_t	ret_value = SUCCEED;	/*return value		*/
+
+    FUNC_ENTER_STATIC
+
+    /* Single element I/O vs. multiple element I/O cleanup */
+    if(fm->use_single) {
+        /* Sanity checks */
+        HDassert(fm->sel_chunks == NULL);
+        HDassert(fm->single_chunk_info);
+        HDassert(fm->single_chunk_info->fspace_shared);
+        HDassert(fm->single_chunk_info->mspace_shared);
+
+        /* Reset the selection for the single element I/O */
+        H5S_select_all(fm->single_space, TRUE);
+    } /* end if */
+    else {
+        /* Release the nodes on the list of selected chunks */
+        if(fm->sel_chunks)
+            if(H5SL_free(fm->sel_chunks, H5D__free_chunk_info, NULL) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTNEXT, FAIL, "can't iterate over chunks")
+    } /* end else */
+
+    /* Free the memory chunk dataspace template */
+    if(fm->mchunk_tmpl)
+        if(H5S_close(fm->mchunk_tmpl) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "can't release memory chunk dataspace template")
+#ifdef H5_HAVE_PARALLEL
+    if(fm->select_chunk)
+        H5MM_xfree(fm->select_chunk);
+#endif /* H5_HAVE_PARALLEL */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_io_term() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dest
+ *
+ * Purpose:	Destroy the entire chunk cache by flushing dirty entries,
+ *		preempting all entries, and freeing the cache itself.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_dest(H5D_t *dset)
+{
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    H5D_rdcc_ent_t	*ent = NULL, *next = NULL;      /* Pointer to current & next cache entries */
+    int		nerrors = 0;            /* Accumulated count of errors */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC_TAG(dset->oloc.addr)
+
+    /* Sanity checks */
+    HDassert(dset);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+
+    /* Write the dirty chunks at once, then evict all the cached chunks
+     * (flushing any chunks left dirty by themselves) */
+    if(H5D__chunk_flush_batch(dset, rdcc->head, SIZET_MAX) < 0)
+        nerrors++;
+    for(ent = rdcc->head; ent; ent = next) {
+        next = ent->next;
+        if(H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
+            nerrors++;
+    } /* end for */
+    
+    /* Continue even if there are failures. */
+    if(nerrors)
+        HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+
+    /* Stop sharing the file's chunk cache byte budget, releasing it if
+     * this was the last dataset sharing it */
+    if(rdcc->pool) {
+        HDassert(rdcc->pool->nusers > 0);
+        if(--rdcc->pool->nusers == 0) {
+            HDassert(NULL == rdcc->pool->head);
+            HDassert(H5F_RDCC_POOL(dset->oloc.file) == rdcc->pool);
+            H5F_SET_RDCC_POOL(dset->oloc.file, NULL);
+            rdcc->pool = H5FL_FREE(H5D_rdcc_pool_t, rdcc->pool);
+        } /* end if */
+    } /* end if */
+
+    /* Release cache structures */
+    if(rdcc->slot)
+        rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+    if(rdcc->autosize.ghosts)
+        rdcc->autosize.ghosts = (hsize_t *)H5MM_xfree(rdcc->autosize.ghosts);
+    HDmemset(rdcc, 0, sizeof(H5D_rdcc_t));
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Free any index structures */
+    if(dset->shared->layout.storage.u.chunk.ops->dest &&
+            (dset->shared->layout.storage.u.chunk.ops->dest)(&idx_info) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release chunk index info")
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* end H5D__chunk_dest() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D_chunk_idx_reset
+ *
+ * Purpose:	Reset index information
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *              Thursday, January 15, 2009
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D_chunk_idx_reset(H5O_storage_chunk_t *storage, hbool_t reset_addr)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(storage);
+    HDassert(storage->ops);
+    H5D_CHUNK_STORAGE_INDEX_CHK(storage);
+
+    /* Reset index structures */
+    if((storage->ops->reset)(storage, reset_addr) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to reset chunk index info")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D_chunk_idx_reset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cinfo_cache_reset
+ *
+ * Purpose:	Reset the cached chunk info
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *              November 27, 2007
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cinfo_cache_reset(H5D_chunk_cached_t *last)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity check */
+    HDassert(last);
+
+    /* Indicate that the cached info is not valid */
+    last->valid = FALSE;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5D__chunk_cinfo_cache_reset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cinfo_cache_update
+ *
+ * Purpose:	Update the cached chunk info
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *              November 27, 2007
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cinfo_cache_update(H5D_chunk_cached_t *last, const H5D_chunk_ud_t *udata)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(last);
+    HDassert(udata);
+    HDassert(udata->common.layout);
+    HDassert(udata->common.scaled);
+
+    /* Stored the information to cache */
+    HDmemcpy(last->scaled, udata->common.scaled, sizeof(hsize_t) * udata->common.layout->ndims);
+    last->addr = udata->chunk_block.offset;
+    H5_CHECKED_ASSIGN(last->nbytes, uint32_t, udata->chunk_block.length, hsize_t);
+    last->chunk_idx = udata->chunk_idx;
+    last->filter_mask = udata->filter_mask;
+
+    /* Indicate that the cached info is valid */
+    last->valid = TRUE;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5D__chunk_cinfo_cache_update() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cinfo_cache_found
+ *
+ * Purpose:	Look for chunk info in cache
+ *
+ * Return:	TRUE/FALSE/FAIL
+ *
+ * Programmer:	Quincey Koziol
+ *              November 27, 2007
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_cinfo_cache_found(const H5D_chunk_cached_t *last, H5D_chunk_ud_t *udata)
+{
+    hbool_t ret_value = FALSE;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(last);
+    HDassert(udata);
+    HDassert(udata->common.layout);
+    HDassert(udata->common.scaled);
+
     /* Check if the cached information is what is desired */
     if(last->valid) {
         unsigned    u;                      /* Local index variable */
 
-        /* Check that the scaled offset is the same */
-        for(u = 0; u < udata->common.layout->ndims; u++)
-            if(last->scaled[u] != udata->common.scaled[u])
-                HGOTO_DONE(FALSE)
+        /* Check that the scaled offset is the same */
+        for(u = 0; u < udata->common.layout->ndims; u++)
+            if(last->scaled[u] != udata->common.scaled[u])
+                HGOTO_DONE(FALSE)
+
+        /* Retrieve the information from the cache */
+        udata->chunk_block.offset = last->addr;
+        udata->chunk_block.length = last->nbytes;
+        udata->chunk_idx = last->chunk_idx;
+        udata->filter_mask = last->filter_mask;
+
+        /* Indicate that the data was found */
+        HGOTO_DONE(TRUE)
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cinfo_cache_found() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_create
+ *
+ * Purpose:	Creates a new chunked storage index and initializes the
+ *		layout information with information about the storage.  The
+ *		layout info should be immediately written to the object header.
+ *
+ * Return:	Non-negative on success (with the layout information initialized
+ *		and ready to write to an object header). Negative on failure.
+ *
+ * Programmer:	Quincey Koziol
+ *		Thursday, May 22, 2008
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_create(const H5D_t *dset /*in,out*/)
+{
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(dset);
+    HDassert(H5D_CHUNKED == dset->shared->layout.type);
+    HDassert(dset->shared->layout.u.chunk.ndims > 0 && dset->shared->layout.u.chunk.ndims <= H5O_LAYOUT_NDIMS);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+
+#ifndef NDEBUG
+{
+    unsigned u;                         /* Local index variable */
+
+    for(u = 0; u < dset->shared->layout.u.chunk.ndims; u++)
+	HDassert(dset->shared->layout.u.chunk.dim[u] > 0);
+}
+#endif
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Create the index for the chunks */
+    if((dset->shared->layout.storage.u.chunk.ops->create)(&idx_info) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't create chunk index")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_hash_val
+ *
+ * Purpose:	To calculate an index based on the dataset's scaled coordinates and
+ *		sizes of the faster dimensions.  This is the first slot of the
+ *		chunk cache's hash table searched for the chunk.
+ *
+ * Return:	Hash value index
+ *
+ * Programmer:	Vailin Choi; Nov 2014
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
+{
+    hsize_t val;        /* Intermediate value */
+    unsigned ndims = shared->ndims;      /* Rank of dataset */
+    unsigned ret = 0;   /* Value to return */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(shared);
+    HDassert(scaled);
+
+    /* If the fastest changing dimension doesn't have enough entropy, use
+     *  other dimensions too
+     */
+    if(ndims > 1 && shared->cache.chunk.scaled_dims[ndims - 1] <= shared->cache.chunk.nslots) {
+        unsigned u;          /* Local index variable */
+
+        val = scaled[0];
+        for(u = 1; u < ndims; u++) {
+            val <<= shared->cache.chunk.scaled_encode_bits[u];
+            val ^= scaled[u];
+        } /* end for */
+    } /* end if */
+    else
+        val = scaled[ndims - 1];
+
+    /* Modulo value against the number of array slots */
+    ret = (unsigned)(val % shared->cache.chunk.nslots_alloc);
+
+    FUNC_LEAVE_NOAPI(ret)
+} /* H5D__chunk_hash_val() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_find
+ *
+ * Purpose:	Searches the chunk cache's hash table for a chunk.  Chunks
+ *		whose hash values collide are stored in the slots following
+ *		the slot they hash to (linear probing), so the search stops
+ *		at the chunk or at the first empty slot.
+ *
+ *		If FREE_IDX is not NULL, it's set to the first deleted or
+ *		empty slot on the way, where the chunk can be inserted, or
+ *		UINT_MAX if there's none.
+ *
+ * Return:	Index of the chunk's slot if it is cached, or UINT_MAX
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_cache_find(const H5D_shared_t *shared, const hsize_t *scaled,
+    unsigned *free_idx)
+{
+    const H5D_rdcc_t *rdcc = &(shared->cache.chunk);    /* Raw data chunk cache */
+    unsigned idx;                       /* Slot being searched */
+    size_t u;                           /* Local index variable */
+    unsigned ret_value = UINT_MAX;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(scaled);
+    HDassert(rdcc->nslots_alloc > 0);
+
+    if(free_idx)
+        *free_idx = UINT_MAX;
+
+    idx = H5D__chunk_hash_val(shared, scaled);
+    for(u = 0; u < rdcc->nslots_alloc; u++) {
+        const H5D_rdcc_ent_t *ent = rdcc->slot[idx];
+
+        if(NULL == ent || H5D_RDCC_SLOT_DELETED == ent) {
+            if(free_idx && UINT_MAX == *free_idx)
+                *free_idx = idx;
+            if(NULL == ent)
+                break;
+        } /* end if */
+        else if(!HDmemcmp(ent->scaled, scaled, sizeof(hsize_t) * shared->ndims)) {
+            ret_value = idx;
+            break;
+        } /* end if */
+
+        if(++idx == rdcc->nslots_alloc)
+            idx = 0;
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_rehash
+ *
+ * Purpose:	Rebuilds the chunk cache's hash table with NSLOTS_ALLOC
+ *		slots, inserting each cached chunk at its current hash value
+ *		and dropping the deleted slot markers.  No chunk may be
+ *		locked, since the index of its slot changes.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_rehash(H5D_shared_t *shared, size_t nslots_alloc)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    H5D_rdcc_ent_t **old_slot = rdcc->slot;     /* Hash table being replaced */
+    H5D_rdcc_ent_t *ent;                /* Cache entry */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(nslots_alloc > (size_t)rdcc->nused);
+
+    if(NULL == (rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, nslots_alloc))) {
+        rdcc->slot = old_slot;
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk cache hash table")
+    } /* end if */
+    rdcc->nslots_alloc = nslots_alloc;
+    rdcc->nslots_deleted = 0;
+
+    for(ent = rdcc->head; ent; ent = ent->next) {
+        unsigned idx = H5D__chunk_hash_val(shared, ent->scaled);
+
+        HDassert(!ent->locked);
+        while(rdcc->slot[idx])
+            if(++idx == rdcc->nslots_alloc)
+                idx = 0;
+        rdcc->slot[idx] = ent;
+        ent->idx = idx;
+    } /* end for */
+
+    old_slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, old_slot);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_rehash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_free_slot
+ *
+ * Purpose:	Finds the slot of the chunk cache's hash table in which to
+ *		insert a chunk that isn't cached.  When the table is three
+ *		quarters full, counting deleted slots, it's rebuilt first,
+ *		with twice as many slots as cached chunks (but never fewer
+ *		than the number requested for the cache), unless a chunk is
+ *		locked.
+ *
+ * Return:	Non-negative on success/Negative on failure.  IDX is set to
+ *		UINT_MAX if the table has no room for the chunk.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_free_slot(H5D_shared_t *shared, const hsize_t *scaled,
+    unsigned *idx)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    size_t nfull = (size_t)rdcc->nused + rdcc->nslots_deleted + 1; /* # of slots not empty after the insertion */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(scaled);
+    HDassert(idx);
+
+    /* Rebuild the table if it's getting full */
+    if(4 * nfull > 3 * rdcc->nslots_alloc) {
+        const H5D_rdcc_ent_t *ent;      /* Cache entry */
+
+        for(ent = rdcc->head; ent; ent = ent->next)
+            if(ent->locked)
+                break;
+        if(NULL == ent) {
+            if(H5D__chunk_cache_rehash(shared, MAX(rdcc->nslots, 2 * ((size_t)rdcc->nused + 1))) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "unable to resize chunk cache hash table")
+            nfull = (size_t)rdcc->nused + 1;
+        } /* end if */
+    } /* end if */
+
+    /* Leave at least one empty slot, where searches stop */
+    if(nfull < rdcc->nslots_alloc) {
+        unsigned found_idx;             /* Slot of the chunk, if it's cached */
+
+        found_idx = H5D__chunk_cache_find(shared, scaled, idx);
+        HDassert(UINT_MAX == found_idx);
+    } /* end if */
+    else
+        *idx = UINT_MAX;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_free_slot() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_lookup
+ *
+ * Purpose:	Loops up a chunk in cache and on disk, and retrieves
+ *              information about that chunk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Albert Cheng
+ *              June 27, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_lookup(const H5D_t *dset, const hsize_t *scaled,
+    H5D_chunk_ud_t *udata)
+{
+    H5D_rdcc_ent_t  *ent = NULL;        /* Cache entry */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    unsigned idx;                       /* Index of chunk in cache, if present */
+    hbool_t found = FALSE;              /* In cache? */
+    herr_t ret_value = SUCCEED;	        /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(dset->shared->layout.u.chunk.ndims > 0);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+    HDassert(scaled);
+    HDassert(udata);
+
+    /* Initialize the query information about the chunk we are looking for */
+    udata->common.layout = &(dset->shared->layout.u.chunk);
+    udata->common.storage = &(dset->shared->layout.storage.u.chunk);
+    udata->common.scaled = scaled;
+
+    /* Reset information about the chunk we are looking for */
+    udata->chunk_block.offset = HADDR_UNDEF;
+    udata->chunk_block.length = 0;
+    udata->filter_mask = 0;
+    udata->new_unfilt_chunk = FALSE;
+
+    /* Check for chunk in cache */
+    if(dset->shared->cache.chunk.nslots > 0) {
+        /* Determine the chunk's location in the hash table */
+        idx = H5D__chunk_cache_find(dset->shared, scaled, NULL);
+
+        /* Get the chunk cache entry for that location */
+        if(UINT_MAX != idx) {
+            ent = dset->shared->cache.chunk.slot[idx];
+            found = TRUE;
+        } /* end if */
+    } /* end if */
+
+    /* Retrieve chunk addr */
+    if(found) {
+        udata->idx_hint = idx;
+        udata->chunk_block.offset = ent->chunk_block.offset;
+        udata->chunk_block.length = ent->chunk_block.length;;
+        udata->chunk_idx = ent->chunk_idx;
+    } /* end if */
+    else {
+        /* Invalidate idx_hint, to signal that the chunk is not in cache */
+        udata->idx_hint = UINT_MAX;
+
+        /* Check for cached information */
+        if(!H5D__chunk_cinfo_cache_found(&dset->shared->cache.chunk.last, udata)) {
+            H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+#ifdef H5_HAVE_PARALLEL
+            H5P_coll_md_read_flag_t temp_cmr;   /* Temp value to hold the coll metadata read setting */
+#endif /* H5_HAVE_PARALLEL */
+
+            /* Compose chunked index info struct */
+            idx_info.f = dset->oloc.file;
+            idx_info.pline = &dset->shared->dcpl_cache.pline;
+            idx_info.layout = &dset->shared->layout.u.chunk;
+            idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+#ifdef H5_HAVE_PARALLEL
+            if(H5F_HAS_FEATURE(idx_info.f, H5FD_FEAT_HAS_MPI)) {
+                /* disable collective metadata read for chunk indexes
+                   as it is highly unlikely that users would read the
+                   same chunks from all processes. MSC - might turn on
+                   for root node? */
+                temp_cmr = H5F_COLL_MD_READ(idx_info.f);
+                H5F_set_coll_md_read(idx_info.f, H5P_FORCE_FALSE);
+            } /* end if */
+#endif /* H5_HAVE_PARALLEL */
+
+            /* Go get the chunk information */
+            if((dset->shared->layout.storage.u.chunk.ops->get_addr)(&idx_info, udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't query chunk address")
+
+#ifdef H5_HAVE_PARALLEL
+            if(H5F_HAS_FEATURE(idx_info.f, H5FD_FEAT_HAS_MPI))
+                H5F_set_coll_md_read(idx_info.f, temp_cmr);
+#endif /* H5_HAVE_PARALLEL */
+
+            /* Cache the information retrieved */
+            H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, udata);
+        } /* end if */
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_lookup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_entry
+ *
+ * Purpose:	Writes a chunk to disk.  If RESET is non-zero then the
+ *		entry is cleared -- it's slightly faster to flush a chunk if
+ *		the RESET flag is turned on because it results in one fewer
+ *		memory copy.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
+{
+    void	*buf = NULL;	        /* Temporary buffer		*/
+    hbool_t	point_of_no_return = FALSE;
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    herr_t	ret_value = SUCCEED;	/* Return value			*/
+
+    FUNC_ENTER_STATIC_TAG(dset->oloc.addr)
+
+    HDassert(dset);
+    HDassert(dset->shared);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+    HDassert(ent);
+    HDassert(!ent->locked);
+
+    buf = ent->chunk;
+    if(ent->dirty) {
+        H5D_chunk_ud_t 	udata;		/* pass through B-tree		*/
+        hbool_t must_alloc = FALSE;     /* Whether the chunk must be allocated */
+
+        /* Set up user data for index callbacks */
+        udata.common.layout = &dset->shared->layout.u.chunk;
+        udata.common.storage = &dset->shared->layout.storage.u.chunk;
+        udata.common.scaled = ent->scaled;
+        udata.chunk_block.offset = ent->chunk_block.offset;
+        udata.chunk_block.length = dset->shared->layout.u.chunk.size;
+        udata.filter_mask = 0;
+        udata.chunk_idx = ent->chunk_idx;
+
+        /* Should the chunk be filtered before writing it to disk? */
+        if(dset->shared->dcpl_cache.pline.nused
+                && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)) {
+            H5Z_EDC_t err_detect;       /* Error detection info */
+            H5Z_cb_t filter_cb;         /* I/O filter callback function */
+            size_t alloc = udata.chunk_block.length;        /* Bytes allocated for BUF	*/
+            size_t nbytes;              /* Chunk size (in bytes) */
+            double start_time;          /* Time the pipeline was started */
+
+            /* Retrieve filter settings from API context */
+            if(H5CX_get_err_detect(&err_detect) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+            if(H5CX_get_filter_cb(&filter_cb) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+
+            if(!reset) {
+                /*
+                 * Copy the chunk to a new buffer before running it through
+                 * the pipeline because we'll want to save the original buffer
+                 * for later.
+                 */
+                if(NULL == (buf = H5MM_malloc(alloc)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+                HDmemcpy(buf, ent->chunk, alloc);
+            } /* end if */
+            else {
+                /*
+                 * If we are reseting and something goes wrong after this
+                 * point then it's too late to recover because we may have
+                 * destroyed the original data by calling H5Z_pipeline().
+                 * The only safe option is to continue with the reset
+                 * even if we can't write the data to disk.
+                 */
+                point_of_no_return = TRUE;
+                ent->chunk = NULL;
+            } /* end else */
+            H5_CHECKED_ASSIGN(nbytes, size_t, udata.chunk_block.length, hsize_t);
+            start_time = H5_get_time();
+            if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask),
+                    err_detect, filter_cb, &nbytes, &alloc, &buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "output pipeline failed")
+            dset->shared->cache.chunk.stats.filter_time += H5_get_time() - start_time;
+#if H5_SIZEOF_SIZE_T > 4
+            /* Check for the chunk expanding too much to encode in a 32-bit value */
+            if(nbytes > ((size_t)0xffffffff))
+                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+            H5_CHECKED_ASSIGN(udata.chunk_block.length, hsize_t, nbytes, size_t);
+
+            /* Indicate that the chunk must be allocated */
+            must_alloc = TRUE;
+        } /* end if */
+        else if(!H5F_addr_defined(udata.chunk_block.offset)) {
+            /* Indicate that the chunk must be allocated */
+            must_alloc = TRUE;
+
+            /* This flag could be set for this chunk, just remove and ignore it
+             */
+            ent->edge_chunk_state &= ~H5D_RDCC_NEWLY_DISABLED_FILTERS;
+        } /* end else */
+        else if(ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS) {
+            /* Chunk on disk is still filtered, must insert to allocate correct
+             * size */
+            must_alloc = TRUE;
+
+            /* Set the disable filters field back to the standard disable
+             * filters setting, as it no longer needs to be inserted with every
+             * flush */
+            ent->edge_chunk_state &= ~H5D_RDCC_NEWLY_DISABLED_FILTERS;
+        } /* end else */
+
+        HDassert(!(ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS));
+
+        /* Allocate the chunk if needed (it also could exist already and the
+         *      chunk alloc operation could resize it), then write it */
+        if(H5D__chunk_write_block(dset, &udata, (must_alloc ? &(ent->chunk_block) : NULL), ent->scaled, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data chunk")
+
+        /* Update the chunk entry's info, in case it was allocated or relocated */
+        if(must_alloc) {
+            ent->chunk_block.offset = udata.chunk_block.offset;
+            ent->chunk_block.length = udata.chunk_block.length;
+        } /* end if */
+
+        /* Mark cache entry as clean */
+        ent->dirty = FALSE;
+
+        /* Increment # of flushed entries */
+        dset->shared->cache.chunk.stats.nflushes++;
+    } /* end if */
+
+    /* Reset, but do not free or removed from list */
+    if(reset) {
+        point_of_no_return = FALSE;
+        if(buf == ent->chunk)
+            buf = NULL;
+        if(ent->chunk != NULL)
+            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
+                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
+                    : &(dset->shared->dcpl_cache.pline)));
+    } /* end if */
+
+done:
+    /* Free the temp buffer only if it's different than the entry chunk */
+    if(buf != ent->chunk)
+        H5MM_xfree(buf);
+
+    /*
+     * If we reached the point of no return then we have no choice but to
+     * reset the entry.  This can only happen if RESET is true but the
+     * output pipeline failed.  Do not free the entry or remove it from the
+     * list.
+     */
+    if(ret_value < 0 && point_of_no_return)
+        if(ent->chunk)
+            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
+                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
+                    : &(dset->shared->dcpl_cache.pline)));
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* end H5D__chunk_flush_entry() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_batch
+ *
+ * Purpose:	Writes dirty chunks in the cache to disk together, starting
+ *		at FIRST and following the cache's LRU list until chunks
+ *		taking up NBYTES bytes of the cache have been looked at.
+ *		Locked chunks are skipped, and the chunks stay in the cache.
+ *
+ *		The chunks are run through the filter pipeline at once,
+ *		given space in the file in chunk index order (so new chunks
+ *		are laid out one after another), written with one vector
+ *		write sorted by file address (so the file driver can combine
+ *		adjacent chunks), then inserted into the index.  Chunks which
+ *		can't be filtered are left dirty.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_batch(const H5D_t *dset, H5D_rdcc_ent_t *first, size_t nbytes)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    H5D_rdcc_ent_t *ent;                /* Current cache entry */
+    H5D_rdcc_ent_t **cents = NULL;      /* Cache entries of the chunks */
+    H5D_chunk_direct_ent_t *ents = NULL;        /* Chunks to write */
+    H5D_chunk_direct_ent_t **order = NULL;      /* Chunks in file address order */
+    H5Z_pipeline_job_t *jobs = NULL;    /* Buffers of the chunks to filter */
+    H5FD_mem_t *types = NULL;           /* Memory types for vector write */
+    haddr_t *addrs = NULL;              /* Addresses for vector write */
+    size_t *sizes = NULL;               /* Sizes for vector write */
+    const void **bufs = NULL;           /* Buffers for vector write */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    hbool_t *must_alloc = NULL;         /* Whether each chunk must be allocated */
+    size_t chunk_size;                  /* Size of a chunk */
+    size_t seen;                        /* # of bytes of the cache looked at */
+    size_t ndirty = 0;                  /* # of dirty chunks */
+    size_t njobs = 0;                   /* # of dirty chunks to filter */
+    size_t nchunks = 0;                 /* # of chunks to write */
+    size_t nfilt, nunfilt;              /* Positions of the next chunks */
+    size_t u;                           /* Local index variable */
+    hbool_t filter_failed = FALSE;      /* Whether any chunk couldn't be filtered */
+    hbool_t bulk_insert = FALSE;        /* Whether the index is loading the chunks in bulk */
+    double start_time;                  /* Time the pipeline was started */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC_TAG(dset->oloc.addr)
+
+    /* Sanity checks */
+    HDassert(dset);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+
+    H5_CHECKED_ASSIGN(chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+
+    /* Count the dirty chunks, and the ones to filter */
+    for(ent = first, seen = 0; ent && seen < nbytes; ent = ent->next, seen += chunk_size)
+        if(ent->dirty && !ent->locked) {
+            ndirty++;
+            if(pline->nused && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS))
+                njobs++;
+        } /* end if */
+    if(0 == ndirty)
+        HGOTO_DONE(SUCCEED)
+
+    /* Allocate space for the batch */
+    if(NULL == (cents = (H5D_rdcc_ent_t **)H5MM_malloc(ndirty * sizeof(H5D_rdcc_ent_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    if(NULL == (ents = (H5D_chunk_direct_ent_t *)H5MM_calloc(ndirty * sizeof(H5D_chunk_direct_ent_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    if(NULL == (order = (H5D_chunk_direct_ent_t **)H5MM_malloc(ndirty * sizeof(H5D_chunk_direct_ent_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    if(NULL == (must_alloc = (hbool_t *)H5MM_malloc(ndirty * sizeof(hbool_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    if(njobs > 0 && NULL == (jobs = (H5Z_pipeline_job_t *)H5MM_calloc(njobs * sizeof(H5Z_pipeline_job_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    if(NULL == (types = (H5FD_mem_t *)H5MM_malloc(ndirty * sizeof(H5FD_mem_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(ndirty * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(ndirty * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    if(NULL == (bufs = (const void **)H5MM_malloc(ndirty * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+
+    /* Collect the dirty chunks, the ones to filter first so they line up
+     * with their jobs */
+    nfilt = 0;
+    nunfilt = njobs;
+    for(ent = first, seen = 0; ent && seen < nbytes; ent = ent->next, seen += chunk_size)
+        if(ent->dirty && !ent->locked) {
+            if(pline->nused && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)) {
+                H5Z_pipeline_job_t *job = &jobs[nfilt];
+
+                /* Copy the chunk, since the cache keeps the original */
+                job->nbytes = chunk_size;
+                job->buf_size = chunk_size;
+                job->filter_mask = 0;
+                job->status = SUCCEED;
+                if(NULL == (job->buf = H5MM_malloc(chunk_size)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+                HDmemcpy(job->buf, ent->chunk, chunk_size);
+                cents[nfilt++] = ent;
+            } /* end if */
+            else
+                cents[nunfilt++] = ent;
+        } /* end if */
+    HDassert(nfilt == njobs && nunfilt == ndirty);
+
+    /* Filter the chunks */
+    if(njobs > 0) {
+        H5Z_EDC_t err_detect;           /* Error detection info */
+        H5Z_cb_t filter_cb;             /* I/O filter callback function */
+        unsigned nthreads = 1;          /* # of threads to run the pipeline on */
+
+        if(H5CX_get_err_detect(&err_detect) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+        if(H5CX_get_filter_cb(&filter_cb) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+        {
+            unsigned filter_threads;    /* # of filter pipeline threads allowed */
+            htri_t avail;               /* Whether the filters are registered */
+
+            if(H5CX_get_filter_threads(&filter_threads) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get # of filter pipeline threads")
+            if(filter_threads > 1) {
+                if((avail = H5Z_all_filters_avail(pline)) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check filter availability")
+                if(avail)
+                    nthreads = filter_threads;
+            } /* end if */
+        }
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+        /* (Chunks which fail are left out of the write below) */
+        start_time = H5_get_time();
+        if(H5Z_pipeline_threads(pline, 0, err_detect, filter_cb, nthreads, njobs, jobs) < 0)
+            filter_failed = TRUE;
+        rdcc->stats.filter_time += H5_get_time() - start_time;
+    } /* end if */
+
+    /* Set up the chunks to write */
+    for(u = 0; u < ndirty; u++) {
+        H5D_chunk_direct_ent_t *bent = &ents[nchunks];
+
+        ent = cents[u];
+        bent->idx = u;
+        HDmemcpy(bent->scaled, ent->scaled, sizeof(bent->scaled));
+        bent->chunk_idx = H5VM_array_offset_pre(dset->shared->ndims,
+                dset->shared->layout.u.chunk.down_chunks, bent->scaled);
+        bent->udata.common.layout = &dset->shared->layout.u.chunk;
+        bent->udata.common.storage = sc;
+        bent->udata.chunk_block.offset = ent->chunk_block.offset;
+        bent->udata.chunk_block.length = dset->shared->layout.u.chunk.size;
+        bent->udata.filter_mask = 0;
+        bent->udata.chunk_idx = ent->chunk_idx;
+        bent->need_insert = FALSE;
+
+        if(u < njobs) {
+            if(jobs[u].status < 0)
+                continue;
+#if H5_SIZEOF_SIZE_T > 4
+            /* Check for the chunk expanding too much to encode in a 32-bit value */
+            if(jobs[u].nbytes > ((size_t)0xffffffff))
+                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+            H5_CHECKED_ASSIGN(bent->udata.chunk_block.length, hsize_t, jobs[u].nbytes, size_t);
+            bent->udata.filter_mask = jobs[u].filter_mask;
+            must_alloc[u] = TRUE;
+        } /* end if */
+        else
+            /* Unallocated chunks, and chunks still stored filtered on disk,
+             * must be allocated */
+            must_alloc[u] = !H5F_addr_defined(ent->chunk_block.offset)
+                    || (ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS);
+        nchunks++;
+    } /* end for */
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.pline = pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = sc;
+
+    /* Give the chunks space in the file, in chunk index order */
+    HDqsort(ents, nchunks, sizeof(H5D_chunk_direct_ent_t), H5D__chunk_direct_cmp_idx);
+    for(u = 0; u < nchunks; u++) {
+        ents[u].udata.common.scaled = ents[u].scaled;
+        if(must_alloc[ents[u].idx])
+            if(H5D__chunk_file_alloc(&idx_info, &(cents[ents[u].idx]->chunk_block),
+                    &ents[u].udata.chunk_block, &ents[u].need_insert, ents[u].scaled) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+        HDassert(H5F_addr_defined(ents[u].udata.chunk_block.offset));
+        order[u] = &ents[u];
+    } /* end for */
+
+    /* Write the chunks in file address order */
+    HDqsort(order, nchunks, sizeof(H5D_chunk_direct_ent_t *), H5D__chunk_direct_cmp_addr);
+    for(u = 0; u < nchunks; u++) {
+        size_t idx = order[u]->idx;     /* Position of the chunk in the batch */
+
+        types[u] = H5FD_MEM_DRAW;
+        addrs[u] = order[u]->udata.chunk_block.offset;
+        H5_CHECKED_ASSIGN(sizes[u], size_t, order[u]->udata.chunk_block.length, hsize_t);
+        bufs[u] = (idx < njobs) ? jobs[idx].buf : cents[idx]->chunk;
+    } /* end for */
+    if(H5F_block_write_vector(dset->oloc.file, (uint32_t)nchunks, types, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+
+    /* Insert the new chunk records into the index, in index order, and
+     * mark the chunks clean */
+    if(sc->ops->bulk_begin && sc->ops->insert) {
+        hsize_t ninsert = 0;    /* Number of chunks to insert */
+
+        for(u = 0; u < nchunks; u++)
+            if(ents[u].need_insert)
+                ninsert++;
+        if(ninsert > 1) {
+            if((sc->ops->bulk_begin)(&idx_info, ninsert) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to start bulk insert into index")
+            bulk_insert = TRUE;
+        } /* end if */
+    } /* end if */
+    for(u = 0; u < nchunks; u++) {
+        ent = cents[ents[u].idx];
+
+        if(ents[u].need_insert && sc->ops->insert)
+            if((sc->ops->insert)(&idx_info, &ents[u].udata, dset) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
 
-        /* Retrieve the information from the cache */
-        udata->chunk_block.offset = last->addr;
-        udata->chunk_block.length = last->nbytes;
-        udata->chunk_idx = last->chunk_idx;
-        udata->filter_mask = last->filter_mask;
+        /* Update the chunk entry's info, in case it was allocated or relocated */
+        if(must_alloc[ents[u].idx]) {
+            ent->chunk_block.offset = ents[u].udata.chunk_block.offset;
+            ent->chunk_block.length = ents[u].udata.chunk_block.length;
+            ent->edge_chunk_state &= ~H5D_RDCC_NEWLY_DISABLED_FILTERS;
+        } /* end if */
 
-        /* Indicate that the data was found */
-        HGOTO_DONE(TRUE)
+        /* Mark cache entry as clean */
+        ent->dirty = FALSE;
+        rdcc->stats.nflushes++;
+    } /* end for */
+    if(bulk_insert) {
+        bulk_insert = FALSE;
+        if((sc->ops->bulk_end)(&idx_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to finish bulk insert into index")
     } /* end if */
 
+    /* Cache the last chunk's info, in case it's accessed again shortly */
+    if(nchunks > 0)
+        H5D__chunk_cinfo_cache_update(&rdcc->last, &ents[nchunks - 1].udata);
+
+    if(filter_failed)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "output pipeline failed")
+
 done:
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* H5D__chunk_cinfo_cache_found() */
+    if(bulk_insert && (sc->ops->bulk_end)(&idx_info) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to finish bulk insert into index")
+    if(jobs) {
+        for(u = 0; u < njobs; u++)
+            H5MM_xfree(jobs[u].buf);
+        H5MM_xfree(jobs);
+    } /* end if */
+    H5MM_xfree(cents);
+    H5MM_xfree(ents);
+    H5MM_xfree(order);
+    H5MM_xfree(must_alloc);
+    H5MM_xfree(types);
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* end H5D__chunk_flush_batch() */
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_create
- *
- * Purpose:	Creates a new chunked storage index and initializes the
- *		layout information with information about the storage.  The
- *		layout info should be immediately written to the object header.
+ * Function:	H5D__chunk_write_block
  *
- * Return:	Non-negative on success (with the layout information initialized
- *		and ready to write to an object header). Negative on failure.
+ * Purpose:	Writes the (already filtered) data for a chunk to the file
+ *		and updates the chunk index.  If OLD_CHUNK is not NULL then
+ *		the chunk is first created in the file, or reallocated if
+ *		its size changed from OLD_CHUNK, and UDATA is updated with
+ *		its new location.
  *
- * Programmer:	Quincey Koziol
- *		Thursday, May 22, 2008
+ * Return:	Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
-herr_t
-H5D__chunk_create(const H5D_t *dset /*in,out*/)
+static herr_t
+H5D__chunk_write_block(const H5D_t *dset, H5D_chunk_ud_t *udata,
+    const H5F_block_t *old_chunk, hsize_t *scaled, const void *buf)
 {
     H5D_chk_idx_info_t idx_info;        /* Chunked index info */
-    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    hbool_t need_insert = FALSE;        /* Whether the chunk needs to be inserted into the index */
     herr_t ret_value = SUCCEED;         /* Return value */
 
-    FUNC_ENTER_PACKAGE
+    FUNC_ENTER_STATIC
 
-    /* Check args */
     HDassert(dset);
-    HDassert(H5D_CHUNKED == dset->shared->layout.type);
-    HDassert(dset->shared->layout.u.chunk.ndims > 0 && dset->shared->layout.u.chunk.ndims <= H5O_LAYOUT_NDIMS);
-    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+    HDassert(udata);
+    HDassert(scaled);
+    HDassert(buf);
 
-#ifndef NDEBUG
-{
-    unsigned u;                         /* Local index variable */
+    /* Check if the chunk needs to be allocated */
+    if(old_chunk) {
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = &dset->shared->layout.storage.u.chunk;
 
-    for(u = 0; u < dset->shared->layout.u.chunk.ndims; u++)
-	HDassert(dset->shared->layout.u.chunk.dim[u] > 0);
-}
-#endif
+        /* Create the chunk it if it doesn't exist, or reallocate the chunk
+         *  if its size changed.
+         */
+        if(H5D__chunk_file_alloc(&idx_info, old_chunk, &udata->chunk_block, &need_insert, scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+    } /* end if */
 
-    /* Compose chunked index info struct */
-    idx_info.f = dset->oloc.file;
-    idx_info.pline = &dset->shared->dcpl_cache.pline;
-    idx_info.layout = &dset->shared->layout.u.chunk;
-    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+    /* Write the data to the file */
+    HDassert(H5F_addr_defined(udata->chunk_block.offset));
+    H5_CHECK_OVERFLOW(udata->chunk_block.length, hsize_t, size_t);
+    if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata->chunk_block.offset, (size_t)udata->chunk_block.length, buf) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
 
-    /* Create the index for the chunks */
-    if((dset->shared->layout.storage.u.chunk.ops->create)(&idx_info) < 0)
-	HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't create chunk index")
+    /* Insert the chunk record into the index */
+    if(need_insert && dset->shared->layout.storage.u.chunk.ops->insert)
+        if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, udata, dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+
+    /* Cache the chunk's info, in case it's accessed again shortly */
+    H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, udata);
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_create() */
+} /* end H5D__chunk_write_block() */
+
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_hash_val
+ * Function:    H5D__chunk_cache_evict
  *
- * Purpose:	To calculate an index based on the dataset's scaled coordinates and
- *		sizes of the faster dimensions.
+ * Purpose:     Preempts the specified entry from the cache, flushing it to
+ *              disk if necessary.
  *
- * Return:	Hash value index
+ * Return:      Non-negative on success/Negative on failure
  *
- * Programmer:	Vailin Choi; Nov 2014
+ * Programmer:  Robb Matzke
+ *              Thursday, May 21, 1998
  *
  *-------------------------------------------------------------------------
  */
-static unsigned
-H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
+static herr_t
+H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent,
+    hbool_t flush)
 {
-    hsize_t val;        /* Intermediate value */
-    unsigned ndims = shared->ndims;      /* Rank of dataset */
-    unsigned ret = 0;   /* Value to return */
-
-    FUNC_ENTER_STATIC_NOERR
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
+    herr_t      ret_value = SUCCEED;       /* Return value */
 
-    /* Sanity check */
-    HDassert(shared);
-    HDassert(scaled);
+    FUNC_ENTER_STATIC
 
-    /* If the fastest changing dimension doesn't have enough entropy, use
-     *  other dimensions too
-     */
-    if(ndims > 1 && shared->cache.chunk.scaled_dims[ndims - 1] <= shared->cache.chunk.nslots) {
-        unsigned u;          /* Local index variable */
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(ent);
+    HDassert(!ent->locked);
+    HDassert(ent->idx < rdcc->nslots_alloc);
+    HDassert(rdcc->slot[ent->idx] == ent);
 
-        val = scaled[0];
-        for(u = 1; u < ndims; u++) {
-            val <<= shared->cache.chunk.scaled_encode_bits[u];
-            val ^= scaled[u];
-        } /* end for */
+    if(flush) {
+        /* Flush */
+        if(H5D__chunk_flush_entry(dset, ent, TRUE) < 0)
+            HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
     } /* end if */
+    else {
+        /* Don't flush, just free chunk */
+        if(ent->chunk != NULL)
+            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
+                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
+                    : &(dset->shared->dcpl_cache.pline)));
+    } /* end else */
+
+    /* Unlink from list */
+    if(ent->prev)
+        ent->prev->next = ent->next;
     else
-        val = scaled[ndims - 1];
+        rdcc->head = ent->next;
+    if(ent->next)
+        ent->next->prev = ent->prev;
+    else
+        rdcc->tail = ent->prev;
+    ent->prev = ent->next = NULL;
 
-    /* Modulo value against the number of array slots */
-    ret = (unsigned)(val % shared->cache.chunk.nslots);
+    /* Unlink from the shared pool's list */
+    if(rdcc->pool) {
+        H5D__chunk_pool_remove(rdcc->pool, ent);
+        rdcc->pool->nbytes_used -= dset->shared->layout.u.chunk.size;
+        --rdcc->pool->nused;
+    } /* end if */
 
-    FUNC_LEAVE_NOAPI(ret)
-} /* H5D__chunk_hash_val() */
+    /* Clear the hash table slot.  Searches must carry on past it to the
+     * chunks stored after it, unless the next slot is empty too. */
+    if(NULL == rdcc->slot[(ent->idx + 1) % rdcc->nslots_alloc])
+        rdcc->slot[ent->idx] = NULL;
+    else {
+        rdcc->slot[ent->idx] = H5D_RDCC_SLOT_DELETED;
+        rdcc->nslots_deleted++;
+    } /* end else */
+
+    /* Remove from cache */
+    ent->idx = UINT_MAX;
+    rdcc->nbytes_used -= dset->shared->layout.u.chunk.size;
+    --rdcc->nused;
+
+    /* Free */
+    ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_evict() */
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_lookup
- *
- * Purpose:	Loops up a chunk in cache and on disk, and retrieves
- *              information about that chunk.
+ * Function:	H5D__chunk_cache_mark_prewritten
  *
- * Return:	Non-negative on success/Negative on failure
+ * Purpose:	Marks (if MARK is set) or unmarks the dirty entries in the
+ *		first NBYTES bytes of the cache starting at FIRST, which
+ *		H5D__chunk_flush_batch is about to write out ahead of
+ *		preempting them, so they are still counted as dirty
+ *		evictions.
  *
- * Programmer:	Albert Cheng
- *              June 27, 1998
+ * Return:	None
  *
  *-------------------------------------------------------------------------
  */
-herr_t
-H5D__chunk_lookup(const H5D_t *dset, const hsize_t *scaled,
-    H5D_chunk_ud_t *udata)
+static void
+H5D__chunk_cache_mark_prewritten(const H5D_t *dset, H5D_rdcc_ent_t *first,
+    size_t nbytes, hbool_t mark)
 {
-    H5D_rdcc_ent_t  *ent = NULL;        /* Cache entry */
-    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
-    unsigned idx;                       /* Index of chunk in cache, if present */
-    hbool_t found = FALSE;              /* In cache? */
-    herr_t ret_value = SUCCEED;	        /* Return value */
+    H5D_rdcc_ent_t *ent;                /* Current cache entry */
+    size_t chunk_size;                  /* Size of a chunk */
+    size_t seen;                        /* # of bytes of the cache looked at */
 
-    FUNC_ENTER_PACKAGE
+    FUNC_ENTER_STATIC_NOERR
 
-    /* Sanity checks */
     HDassert(dset);
-    HDassert(dset->shared->layout.u.chunk.ndims > 0);
-    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
-    HDassert(scaled);
-    HDassert(udata);
 
-    /* Initialize the query information about the chunk we are looking for */
-    udata->common.layout = &(dset->shared->layout.u.chunk);
-    udata->common.storage = &(dset->shared->layout.storage.u.chunk);
-    udata->common.scaled = scaled;
+    H5_CHECKED_ASSIGN(chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+    for(ent = first, seen = 0; ent && seen < nbytes; ent = ent->next, seen += chunk_size)
+        ent->prewritten = mark && ent->dirty && !ent->locked;
 
-    /* Reset information about the chunk we are looking for */
-    udata->chunk_block.offset = HADDR_UNDEF;
-    udata->chunk_block.length = 0;
-    udata->filter_mask = 0;
-    udata->new_unfilt_chunk = FALSE;
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_mark_prewritten() */
 
-    /* Check for chunk in cache */
-    if(dset->shared->cache.chunk.nslots > 0) {
-        /* Determine the chunk's location in the hash table */
-        idx = H5D__chunk_hash_val(dset->shared, scaled);
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_prune
+ *
+ * Purpose:	Prune the cache by preempting some things until the cache has
+ *		room for something which is SIZE bytes.  Only unlocked
+ *		entries are considered for preemption.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
+{
+    const H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);
+    size_t		total = rdcc->nbytes_max;
+    const int		nmeth = 2;	/*number of methods		*/
+    int		        w[1];		/*weighting as an interval	*/
+    H5D_rdcc_ent_t	*p[2], *cur;	/*list pointers			*/
+    H5D_rdcc_ent_t	*n[2];		/*list next pointers		*/
+    size_t		nflush = 0;	/*bytes of the cache written out first */
+    int		nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t      ret_value = SUCCEED;       /* Return value */
 
-        /* Get the chunk cache entry for that location */
-        ent = dset->shared->cache.chunk.slot[idx];
-        if(ent) {
-            unsigned u;                  /* Counter */
+    FUNC_ENTER_STATIC
 
-            /* Speculatively set the 'found' flag */
-            found = TRUE;
+    /*
+     * Preemption is accomplished by having multiple pointers (currently two)
+     * slide down the list beginning at the head. Pointer p(N+1) will start
+     * traversing the list when pointer pN reaches wN percent of the original
+     * list.  In other words, preemption method N gets to consider entries in
+     * approximate least recently used order w0 percent before method N+1
+     * where 100% means tha method N will run to completion before method N+1
+     * begins.  The pointers participating in the list traversal are each
+     * given a chance at preemption before any of the pointers are advanced.
+     */
+    w[0] = (int)(rdcc->nused * rdcc->w0);
+    p[0] = rdcc->head;
+    p[1] = NULL;
 
-            /* Verify that the cache entry is the correct chunk */
-            for(u = 0; u < dset->shared->ndims; u++)
-                if(scaled[u] != ent->scaled[u]) {
-                    found = FALSE;
-                    break;
-                } /* end if */
-        } /* end if */
+    /* Write out the least recently used dirty entries together first, so
+     * preempting them below doesn't write them one at a time.  (Remember
+     * which were dirty, to count them as dirty when they're preempted).
+     * Only do this when the head of the list is dirty, since otherwise the
+     * entries were written out by an earlier prune and the ones after them
+     * are mostly clean too, and looking them over again on every prune
+     * would make filling the cache quadratic in its number of entries. */
+    if((rdcc->nbytes_used + size) > total && rdcc->head && rdcc->head->dirty) {
+        nflush = MAX((rdcc->nbytes_used + size) - total, total / H5D_RDCC_PRUNE_FLUSH_DIV);
+        H5D__chunk_cache_mark_prewritten(dset, rdcc->head, nflush, TRUE);
+        if(H5D__chunk_flush_batch(dset, rdcc->head, nflush) < 0)
+            nerrors++;
     } /* end if */
 
-    /* Retrieve chunk addr */
-    if(found) {
-        udata->idx_hint = idx;
-        udata->chunk_block.offset = ent->chunk_block.offset;
-        udata->chunk_block.length = ent->chunk_block.length;;
-        udata->chunk_idx = ent->chunk_idx;
-    } /* end if */
-    else {
-        /* Invalidate idx_hint, to signal that the chunk is not in cache */
-        udata->idx_hint = UINT_MAX;
+    while((p[0] || p[1]) && (rdcc->nbytes_used + size) > total) {
+        int i;          /* Local index variable */
+
+	/* Introduce new pointers */
+	for(i = 0; i < nmeth - 1; i++)
+            if(0 == w[i])
+                p[i + 1] = rdcc->head;
+
+	/* Compute next value for each pointer */
+	for(i = 0; i < nmeth; i++)
+            n[i] = p[i] ? p[i]->next : NULL;
 
-        /* Check for cached information */
-        if(!H5D__chunk_cinfo_cache_found(&dset->shared->cache.chunk.last, udata)) {
-            H5D_chk_idx_info_t idx_info;        /* Chunked index info */
-#ifdef H5_HAVE_PARALLEL
-            H5P_coll_md_read_flag_t temp_cmr;   /* Temp value to hold the coll metadata read setting */
-#endif /* H5_HAVE_PARALLEL */
+	/* Give each method a chance */
+	for(i = 0; i < nmeth && (rdcc->nbytes_used + size) > total; i++) {
+	    if(0 == i && p[0] && !p[0]->locked &&
+                    ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
+                     (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
+                     (dset->shared->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
+		/*
+		 * Method 0: Preempt entries that have been completely written
+		 * and/or completely read but not entries that are partially
+		 * written or partially read.
+		 */
+		cur = p[0];
+	    } else if(1 == i && p[1] && !p[1]->locked) {
+		/*
+		 * Method 1: Preempt the entry without regard to
+		 * considerations other than being locked.  This is the last
+		 * resort preemption.
+		 */
+		cur = p[1];
+	    } else {
+		/* Nothing to preempt at this point */
+		cur = NULL;
+	    }
 
-            /* Compose chunked index info struct */
-            idx_info.f = dset->oloc.file;
-            idx_info.pline = &dset->shared->dcpl_cache.pline;
-            idx_info.layout = &dset->shared->layout.u.chunk;
-            idx_info.storage = &dset->shared->layout.storage.u.chunk;
+	    if(cur) {
+                int j;          /* Local index variable */
 
-#ifdef H5_HAVE_PARALLEL
-            if(H5F_HAS_FEATURE(idx_info.f, H5FD_FEAT_HAS_MPI)) {
-                /* disable collective metadata read for chunk indexes
-                   as it is highly unlikely that users would read the
-                   same chunks from all processes. MSC - might turn on
-                   for root node? */
-                temp_cmr = H5F_COLL_MD_READ(idx_info.f);
-                H5F_set_coll_md_read(idx_info.f, H5P_FORCE_FALSE);
-            } /* end if */
-#endif /* H5_HAVE_PARALLEL */
+		for(j = 0; j < nmeth; j++) {
+		    if(p[j] == cur)
+                        p[j] = NULL;
+		    if(n[j] == cur)
+                        n[j] = cur->next;
+		} /* end for */
+                H5D__chunk_cache_count_evict(dset, cur);
+		if(H5D__chunk_cache_evict(dset, cur, TRUE) < 0)
+                    nerrors++;
+	    } /* end if */
+	} /* end for */
 
-            /* Go get the chunk information */
-            if((dset->shared->layout.storage.u.chunk.ops->get_addr)(&idx_info, udata) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't query chunk address")
+	/* Advance pointers */
+	for(i = 0; i < nmeth; i++)
+            p[i] = n[i];
+	for(i = 0; i < nmeth - 1; i++)
+            w[i] -= 1;
+    } /* end while */
 
-#ifdef H5_HAVE_PARALLEL
-            if(H5F_HAS_FEATURE(idx_info.f, H5FD_FEAT_HAS_MPI))
-                H5F_set_coll_md_read(idx_info.f, temp_cmr);
-#endif /* H5_HAVE_PARALLEL */
+    /* Entries written out above which weren't preempted are just clean now
+     * (they're all still within NFLUSH bytes of the head) */
+    if(nflush > 0)
+        H5D__chunk_cache_mark_prewritten(dset, rdcc->head, nflush, FALSE);
 
-            /* Cache the information retrieved */
-            H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, udata);
-        } /* end if */
-    } /* end else */
+    if(nerrors)
+	HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5D__chunk_lookup() */
+} /* end H5D__chunk_cache_prune() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_flush_entry
- *
- * Purpose:	Writes a chunk to disk.  If RESET is non-zero then the
- *		entry is cleared -- it's slightly faster to flush a chunk if
- *		the RESET flag is turned on because it results in one fewer
- *		memory copy.
+ * Function:	H5D__chunk_cache_count_evict
  *
- * Return:	Non-negative on success/Negative on failure
+ * Purpose:	Counts the preemption of ENT from the cache of dataset DSET,
+ *		and remembers the chunk for automatic sizing of the cache.
  *
- * Programmer:	Robb Matzke
- *              Thursday, May 21, 1998
+ * Return:	None
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
+static void
+H5D__chunk_cache_count_evict(const H5D_t *dset, const H5D_rdcc_ent_t *ent)
 {
-    void	*buf = NULL;	        /* Temporary buffer		*/
-    hbool_t	point_of_no_return = FALSE;
-    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
-    herr_t	ret_value = SUCCEED;	/* Return value			*/
+    H5D_rdcc_t *rdcc = ent->rdcc;       /* Cache the entry belongs to */
 
-    FUNC_ENTER_STATIC_TAG(dset->oloc.addr)
+    FUNC_ENTER_STATIC_NOERR
 
     HDassert(dset);
-    HDassert(dset->shared);
-    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
-    HDassert(ent);
-    HDassert(!ent->locked);
-
-    buf = ent->chunk;
-    if(ent->dirty) {
-        H5D_chk_idx_info_t idx_info;    /* Chunked index info */
-        H5D_chunk_ud_t 	udata;		/* pass through B-tree		*/
-        hbool_t must_alloc = FALSE;     /* Whether the chunk must be allocated */
-        hbool_t need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
+    HDassert(rdcc == &(dset->shared->cache.chunk));
 
-        /* Set up user data for index callbacks */
-        udata.common.layout = &dset->shared->layout.u.chunk;
-        udata.common.storage = &dset->shared->layout.storage.u.chunk;
-        udata.common.scaled = ent->scaled;
-        udata.chunk_block.offset = ent->chunk_block.offset;
-        udata.chunk_block.length = dset->shared->layout.u.chunk.size;
-        udata.filter_mask = 0;
-        udata.chunk_idx = ent->chunk_idx;
+    if(ent->dirty || ent->prewritten)
+        rdcc->stats.nevict_dirty++;
+    else
+        rdcc->stats.nevict_clean++;
 
-        /* Should the chunk be filtered before writing it to disk? */
-        if(dset->shared->dcpl_cache.pline.nused
-                && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)) {
-            H5Z_EDC_t err_detect;       /* Error detection info */
-            H5Z_cb_t filter_cb;         /* I/O filter callback function */
-            size_t alloc = udata.chunk_block.length;        /* Bytes allocated for BUF	*/
-            size_t nbytes;              /* Chunk size (in bytes) */
+    if(rdcc->autosize.ghosts) {
+        const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);
 
-            /* Retrieve filter settings from API context */
-            if(H5CX_get_err_detect(&err_detect) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
-            if(H5CX_get_filter_cb(&filter_cb) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+        rdcc->autosize.ghosts[rdcc->autosize.ghost_next] =
+                H5VM_array_offset_pre(layout->ndims - 1, layout->down_chunks, ent->scaled);
+        rdcc->autosize.ghost_next = (rdcc->autosize.ghost_next + 1) % H5D_RDCC_AUTO_NGHOSTS;
+        if(rdcc->autosize.nghosts < H5D_RDCC_AUTO_NGHOSTS)
+            rdcc->autosize.nghosts++;
+    } /* end if */
 
-            if(!reset) {
-                /*
-                 * Copy the chunk to a new buffer before running it through
-                 * the pipeline because we'll want to save the original buffer
-                 * for later.
-                 */
-                if(NULL == (buf = H5MM_malloc(alloc)))
-                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
-                HDmemcpy(buf, ent->chunk, alloc);
-            } /* end if */
-            else {
-                /*
-                 * If we are reseting and something goes wrong after this
-                 * point then it's too late to recover because we may have
-                 * destroyed the original data by calling H5Z_pipeline().
-                 * The only safe option is to continue with the reset
-                 * even if we can't write the data to disk.
-                 */
-                point_of_no_return = TRUE;
-                ent->chunk = NULL;
-            } /* end else */
-            H5_CHECKED_ASSIGN(nbytes, size_t, udata.chunk_block.length, hsize_t);
-            if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask),
-                    err_detect, filter_cb, &nbytes, &alloc, &buf) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "output pipeline failed")
-#if H5_SIZEOF_SIZE_T > 4
-            /* Check for the chunk expanding too much to encode in a 32-bit value */
-            if(nbytes > ((size_t)0xffffffff))
-                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
-#endif /* H5_SIZEOF_SIZE_T > 4 */
-            H5_CHECKED_ASSIGN(udata.chunk_block.length, hsize_t, nbytes, size_t);
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_count_evict() */
 
-            /* Indicate that the chunk must be allocated */
-            must_alloc = TRUE;
-        } /* end if */
-        else if(!H5F_addr_defined(udata.chunk_block.offset)) {
-            /* Indicate that the chunk must be allocated */
-            must_alloc = TRUE;
 
-            /* This flag could be set for this chunk, just remove and ignore it
-             */
-            ent->edge_chunk_state &= ~H5D_RDCC_NEWLY_DISABLED_FILTERS;
-        } /* end else */
-        else if(ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS) {
-            /* Chunk on disk is still filtered, must insert to allocate correct
-             * size */
-            must_alloc = TRUE;
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_ghost_hit
+ *
+ * Purpose:	Checks whether the chunk at SCALED, which is missing from
+ *		the cache of dataset DSET, is one of the chunks preempted
+ *		from it last, i.e. whether a larger cache would have kept
+ *		it.  A chunk found is forgotten, so it only counts once.
+ *
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_cache_ghost_hit(const H5D_t *dset, const hsize_t *scaled)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk); /* Chunk layout */
+    hsize_t chunk_idx;                  /* Chunk's index */
+    unsigned u;                         /* Local index variable */
+    hbool_t ret_value = FALSE;          /* Return value */
 
-            /* Set the disable filters field back to the standard disable
-             * filters setting, as it no longer needs to be inserted with every
-             * flush */
-            ent->edge_chunk_state &= ~H5D_RDCC_NEWLY_DISABLED_FILTERS;
-        } /* end else */
+    FUNC_ENTER_STATIC_NOERR
 
-        HDassert(!(ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS));
+    HDassert(rdcc->autosize.ghosts);
 
-        /* Check if the chunk needs to be allocated (it also could exist already
-         *      and the chunk alloc operation could resize it)
-         */
-        if(must_alloc) {
-            /* Compose chunked index info struct */
-            idx_info.f = dset->oloc.file;
-            idx_info.pline = &dset->shared->dcpl_cache.pline;
-            idx_info.layout = &dset->shared->layout.u.chunk;
-            idx_info.storage = &dset->shared->layout.storage.u.chunk;
+    chunk_idx = H5VM_array_offset_pre(layout->ndims - 1, layout->down_chunks, scaled);
+    for(u = 0; u < rdcc->autosize.nghosts; u++)
+        if(rdcc->autosize.ghosts[u] == chunk_idx) {
+            rdcc->autosize.ghosts[u] = HSIZE_UNDEF;
+            HGOTO_DONE(TRUE)
+        } /* end if */
 
-            /* Create the chunk it if it doesn't exist, or reallocate the chunk
-             *  if its size changed.
-             */
-            if(H5D__chunk_file_alloc(&idx_info, &(ent->chunk_block), &udata.chunk_block, &need_insert, ent->scaled) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_ghost_hit() */
 
-            /* Update the chunk entry's info, in case it was allocated or relocated */
-            ent->chunk_block.offset = udata.chunk_block.offset;
-            ent->chunk_block.length = udata.chunk_block.length;
-        } /* end if */
 
-        /* Write the data to the file */
-        HDassert(H5F_addr_defined(udata.chunk_block.offset));
-        H5_CHECK_OVERFLOW(udata.chunk_block.length, hsize_t, size_t);
-        if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, (size_t)udata.chunk_block.length, buf) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_auto_resize
+ *
+ * Purpose:	Ends an epoch of automatic sizing of the chunk cache of
+ *		dataset DSET, in the manner of the metadata cache's
+ *		H5C__auto_adjust_cache_size.  The cache doubles (up to its
+ *		maximum size) when its hit rate in the epoch was low and
+ *		enough of the misses were on chunks it had preempted
+ *		recently, since a larger cache would have kept those.
+ *		Misses on chunks never cached, as when streaming through a
+ *		dataset, don't make it grow.  Otherwise it halves (down to
+ *		its minimum size) when the entries used in the epoch fill
+ *		only a small part of it, the least recently used entries
+ *		being preempted as chunks are next read into it (preempting
+ *		them here could drop the entry the caller just looked up).
+ *
+ * Return:	None
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_auto_resize(const H5D_t *dset)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    hsize_t nhits;                      /* # of hits in the epoch */
+    unsigned naccesses;                 /* # of accesses in the epoch */
 
-        /* Insert the chunk record into the index */
-        if(need_insert && dset->shared->layout.storage.u.chunk.ops->insert)
-            if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, dset) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+    FUNC_ENTER_STATIC_NOERR
 
-        /* Cache the chunk's info, in case it's accessed again shortly */
-        H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, &udata);
+    HDassert(rdcc->autosize.max_nbytes > 0);
 
-        /* Mark cache entry as clean */
-        ent->dirty = FALSE;
+    nhits = rdcc->stats.nhits - rdcc->autosize.nhits;
+    naccesses = rdcc->autosize.naccesses;
 
-        /* Increment # of flushed entries */
-        dset->shared->cache.chunk.stats.nflushes++;
+    if((double)nhits < H5D_RDCC_AUTO_LOWER_HR * (double)naccesses
+            && rdcc->autosize.nghost_hits * H5D_RDCC_AUTO_GHOST_DIV >= naccesses) {
+        if(rdcc->nbytes_max < rdcc->autosize.max_nbytes)
+            rdcc->nbytes_max = (rdcc->autosize.max_nbytes - rdcc->nbytes_max > rdcc->nbytes_max)
+                    ? 2 * rdcc->nbytes_max : rdcc->autosize.max_nbytes;
     } /* end if */
+    else if(rdcc->autosize.nbytes_touched < rdcc->nbytes_max / H5D_RDCC_AUTO_SHRINK_DIV)
+        rdcc->nbytes_max = MAX(rdcc->nbytes_max / 2, rdcc->autosize.min_nbytes);
 
-    /* Reset, but do not free or removed from list */
-    if(reset) {
-        point_of_no_return = FALSE;
-        if(buf == ent->chunk)
-            buf = NULL;
-        if(ent->chunk != NULL)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
-                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
-                    : &(dset->shared->dcpl_cache.pline)));
-    } /* end if */
+    /* Start the next epoch */
+    rdcc->autosize.epoch++;
+    rdcc->autosize.naccesses = 0;
+    rdcc->autosize.nhits = rdcc->stats.nhits;
+    rdcc->autosize.nghost_hits = 0;
+    rdcc->autosize.nbytes_touched = 0;
 
-done:
-    /* Free the temp buffer only if it's different than the entry chunk */
-    if(buf != ent->chunk)
-        H5MM_xfree(buf);
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_auto_resize() */
 
-    /*
-     * If we reached the point of no return then we have no choice but to
-     * reset the entry.  This can only happen if RESET is true but the
-     * output pipeline failed.  Do not free the entry or remove it from the
-     * list.
-     */
-    if(ret_value < 0 && point_of_no_return)
-        if(ent->chunk)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
-                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
-                    : &(dset->shared->dcpl_cache.pline)));
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_pool_remove
+ *
+ * Purpose:	Unlinks a chunk cache entry from the list of entries of all
+ *		the caches sharing a file's byte budget.
+ *
+ * Return:	None
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_pool_remove(H5D_rdcc_pool_t *pool, H5D_rdcc_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(pool);
+    HDassert(ent);
+
+    if(ent->pool_prev)
+        ent->pool_prev->pool_next = ent->pool_next;
+    else
+        pool->head = ent->pool_next;
+    if(ent->pool_next)
+        ent->pool_next->pool_prev = ent->pool_prev;
+    else
+        pool->tail = ent->pool_prev;
+    ent->pool_prev = ent->pool_next = NULL;
 
-    FUNC_LEAVE_NOAPI_TAG(ret_value)
-} /* end H5D__chunk_flush_entry() */
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_pool_remove() */
 
 
 /*-------------------------------------------------------------------------
- * Function:    H5D__chunk_cache_evict
- *
- * Purpose:     Preempts the specified entry from the cache, flushing it to
- *              disk if necessary.
+ * Function:	H5D__chunk_pool_append
  *
- * Return:      Non-negative on success/Negative on failure
+ * Purpose:	Links a chunk cache entry of DSET at the most recently
+ *		used end of the list of entries of all the caches sharing
+ *		a file's byte budget.  DSET becomes the handle the pool
+ *		flushes the dataset's entries through when it preempts
+ *		them.
  *
- * Programmer:  Robb Matzke
- *              Thursday, May 21, 1998
+ * Return:	None
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent,
-    hbool_t flush)
+static void
+H5D__chunk_pool_append(const H5D_t *dset, H5D_rdcc_ent_t *ent)
 {
-    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
-    herr_t      ret_value = SUCCEED;       /* Return value */
+    H5D_rdcc_pool_t *pool;
 
-    FUNC_ENTER_STATIC
+    FUNC_ENTER_STATIC_NOERR
 
-    /* Sanity checks */
     HDassert(dset);
     HDassert(ent);
-    HDassert(!ent->locked);
-    HDassert(ent->idx < rdcc->nslots);
-
-    if(flush) {
-        /* Flush */
-        if(H5D__chunk_flush_entry(dset, ent, TRUE) < 0)
-            HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
-    } /* end if */
-    else {
-        /* Don't flush, just free chunk */
-        if(ent->chunk != NULL)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
-                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
-                    : &(dset->shared->dcpl_cache.pline)));
-    } /* end else */
+    HDassert(ent->rdcc == &(dset->shared->cache.chunk));
+    HDassert(ent->rdcc->pool);
+    HDassert(NULL == ent->pool_prev && NULL == ent->pool_next);
 
-    /* Unlink from list */
-    if(ent->prev)
-        ent->prev->next = ent->next;
-    else
-        rdcc->head = ent->next;
-    if(ent->next)
-        ent->next->prev = ent->prev;
-    else
-        rdcc->tail = ent->prev;
-    ent->prev = ent->next = NULL;
+    pool = ent->rdcc->pool;
+    ent->rdcc->pool_dset = dset;
 
-    /* Unlink from temporary list */
-    if(ent->tmp_prev) {
-        HDassert(rdcc->tmp_head->tmp_next);
-        ent->tmp_prev->tmp_next = ent->tmp_next;
-        if(ent->tmp_next) {
-            ent->tmp_next->tmp_prev = ent->tmp_prev;
-            ent->tmp_next = NULL;
-        } /* end if */
-        ent->tmp_prev = NULL;
+    if(pool->tail) {
+        pool->tail->pool_next = ent;
+        ent->pool_prev = pool->tail;
+        pool->tail = ent;
     } /* end if */
     else
-        /* Only clear hash table slot if the chunk was not on the temporary list
-         */
-        rdcc->slot[ent->idx] = NULL;
-
-    /* Remove from cache */
-    HDassert(rdcc->slot[ent->idx] != ent);
-    ent->idx = UINT_MAX;
-    rdcc->nbytes_used -= dset->shared->layout.u.chunk.size;
-    --rdcc->nused;
-
-    /* Free */
-    ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+        pool->head = pool->tail = ent;
 
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_cache_evict() */
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_pool_append() */
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_cache_prune
- *
- * Purpose:	Prune the cache by preempting some things until the cache has
- *		room for something which is SIZE bytes.  Only unlocked
- *		entries are considered for preemption.
+ * Function:	H5D__chunk_pool_prune
+ *
+ * Purpose:	Prune the chunk caches sharing a file's byte budget by
+ *		preempting entries until the budget has room for something
+ *		which is SIZE bytes.  Entries are considered in least
+ *		recently used order across all the datasets, with the same
+ *		methods and W0 weighting as H5D__chunk_cache_prune, using
+ *		the file's W0 value.  Locked entries are not considered.
+ *		Entries of other datasets are flushed through the handle
+ *		that last added them to the pool, under that dataset's
+ *		metadata tag.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Robb Matzke
- *              Thursday, May 21, 1998
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
+H5D__chunk_pool_prune(H5D_rdcc_pool_t *pool, size_t size)
 {
-    const H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);
-    size_t		total = rdcc->nbytes_max;
+    size_t		total = pool->nbytes_max;
     const int		nmeth = 2;	/*number of methods		*/
     int		        w[1];		/*weighting as an interval	*/
     H5D_rdcc_ent_t	*p[2], *cur;	/*list pointers			*/
@@ -3242,55 +6018,40 @@ H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
 
     FUNC_ENTER_STATIC
 
-    /*
-     * Preemption is accomplished by having multiple pointers (currently two)
-     * slide down the list beginning at the head. Pointer p(N+1) will start
-     * traversing the list when pointer pN reaches wN percent of the original
-     * list.  In other words, preemption method N gets to consider entries in
-     * approximate least recently used order w0 percent before method N+1
-     * where 100% means tha method N will run to completion before method N+1
-     * begins.  The pointers participating in the list traversal are each
-     * given a chance at preemption before any of the pointers are advanced.
-     */
-    w[0] = (int)(rdcc->nused * rdcc->w0);
-    p[0] = rdcc->head;
+    /* See H5D__chunk_cache_prune for how the two methods take turns */
+    w[0] = (int)(pool->nused * pool->w0);
+    p[0] = pool->head;
     p[1] = NULL;
 
-    while((p[0] || p[1]) && (rdcc->nbytes_used + size) > total) {
+    while((p[0] || p[1]) && (pool->nbytes_used + size) > total) {
         int i;          /* Local index variable */
 
 	/* Introduce new pointers */
 	for(i = 0; i < nmeth - 1; i++)
             if(0 == w[i])
-                p[i + 1] = rdcc->head;
+                p[i + 1] = pool->head;
 
 	/* Compute next value for each pointer */
 	for(i = 0; i < nmeth; i++)
-            n[i] = p[i] ? p[i]->next : NULL;
+            n[i] = p[i] ? p[i]->pool_next : NULL;
 
 	/* Give each method a chance */
-	for(i = 0; i < nmeth && (rdcc->nbytes_used + size) > total; i++) {
-	    if(0 == i && p[0] && !p[0]->locked &&
-                    ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
-                     (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
-                     (dset->shared->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
-		/*
-		 * Method 0: Preempt entries that have been completely written
-		 * and/or completely read but not entries that are partially
-		 * written or partially read.
-		 */
-		cur = p[0];
-	    } else if(1 == i && p[1] && !p[1]->locked) {
-		/*
-		 * Method 1: Preempt the entry without regard to
-		 * considerations other than being locked.  This is the last
-		 * resort preemption.
-		 */
-		cur = p[1];
-	    } else {
-		/* Nothing to preempt at this point */
-		cur = NULL;
-	    }
+	for(i = 0; i < nmeth && (pool->nbytes_used + size) > total; i++) {
+            cur = NULL;
+            if(p[i] && !p[i]->locked) {
+                uint32_t chunk_size;
+
+                HDassert(p[i]->rdcc->pool_dset);
+                chunk_size = p[i]->rdcc->pool_dset->shared->layout.u.chunk.size;
+
+                /* Method 0: Preempt entries that have been completely
+                 * written and/or completely read.  Method 1: Preempt the
+                 * entry without regard to anything else. */
+                if(1 == i || (0 == p[i]->rd_count && 0 == p[i]->wr_count) ||
+                        (0 == p[i]->rd_count && chunk_size == p[i]->wr_count) ||
+                        (chunk_size == p[i]->rd_count && 0 == p[i]->wr_count))
+                    cur = p[i];
+            } /* end if */
 
 	    if(cur) {
                 int j;          /* Local index variable */
@@ -3299,10 +6060,19 @@ H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
 		    if(p[j] == cur)
                         p[j] = NULL;
 		    if(n[j] == cur)
-                        n[j] = cur->next;
+                        n[j] = cur->pool_next;
 		} /* end for */
-		if(H5D__chunk_cache_evict(dset, cur, TRUE) < 0)
-                    nerrors++;
+                {
+                    const H5D_t *cur_dset = cur->rdcc->pool_dset;
+
+                    /* Flushing the chunk may touch the other dataset's
+                     * chunk index, which belongs to that dataset's tag */
+                    H5_BEGIN_TAG(cur_dset->oloc.addr);
+                    H5D__chunk_cache_count_evict(cur_dset, cur);
+                    if(H5D__chunk_cache_evict(cur_dset, cur, TRUE) < 0)
+                        nerrors++;
+                    H5_END_TAG
+                }
 	    } /* end if */
 	} /* end for */
 
@@ -3318,7 +6088,56 @@ H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_cache_prune() */
+} /* end H5D__chunk_pool_prune() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_pool_detach
+ *
+ * Purpose:	Called when a handle to a dataset which shares a file's
+ *		chunk cache byte budget is closed while other handles to
+ *		the dataset remain open.  If the pool would flush the
+ *		dataset's entries through this handle, they are flushed
+ *		and evicted now, so that every entry in the pool always
+ *		has an open handle to be flushed through.  The next
+ *		handle to cache a chunk of the dataset takes over.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_pool_detach(H5D_t *dset)
+{
+    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    H5D_rdcc_ent_t	*ent, *next;            /* Pointer to current & next cache entries */
+    int		nerrors = 0;            /* Accumulated count of errors */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dset->oloc.addr)
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(H5D_CHUNKED == dset->shared->layout.type);
+
+    if(rdcc->pool && rdcc->pool_dset == dset) {
+        /* Write the dirty chunks at once, then evict all the cached chunks */
+        if(H5D__chunk_flush_batch(dset, rdcc->head, SIZET_MAX) < 0)
+            nerrors++;
+        for(ent = rdcc->head; ent; ent = next) {
+            next = ent->next;
+            if(H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
+                nerrors++;
+        } /* end for */
+        rdcc->pool_dset = NULL;
+
+        if(nerrors)
+            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* end H5D__chunk_pool_detach() */
 
 
 /*-------------------------------------------------------------------------
@@ -3339,6 +6158,11 @@ done:
  *		for output functions that are about to overwrite the entire
  *		chunk.
  *
+ *		If PREFETCHED is not NULL then it is a buffer holding the
+ *		chunk, which isn't in the cache, already read from the file
+ *		and passed through the filter pipeline.  The chunk takes
+ *		over the buffer, which is freed on failure.
+ *
  * Return:	Success:	Ptr to a file chunk.
  *
  *		Failure:	NULL
@@ -3350,7 +6174,7 @@ done:
  */
 static void *
 H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
-    hbool_t relax, hbool_t prev_unfilt_chunk)
+    hbool_t relax, hbool_t prev_unfilt_chunk, void *prefetched)
 {
     const H5D_t         *dset = io_info->dset;  /* Local pointer to the dataset info */
     const H5O_pline_t   *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info - always equal to the pline passed to H5D__chunk_mem_alloc */
@@ -3374,16 +6198,22 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
     HDassert(udata);
     HDassert(dset);
     HDassert(!(udata->new_unfilt_chunk && prev_unfilt_chunk));
-    HDassert(!rdcc->tmp_head);
+    HDassert(!prefetched || (UINT_MAX == udata->idx_hint && !relax
+            && !prev_unfilt_chunk && !udata->new_unfilt_chunk
+            && H5F_addr_defined(udata->chunk_block.offset)));
 
     /* Get the chunk's size */
     HDassert(layout->u.chunk.size > 0);
     H5_CHECKED_ASSIGN(chunk_size, size_t, layout->u.chunk.size, uint32_t);
 
+    /* Resize the cache at the end of each epoch, if it sizes itself */
+    if(rdcc->autosize.max_nbytes > 0 && ++rdcc->autosize.naccesses >= H5D_RDCC_AUTO_EPOCH_LENGTH)
+        H5D__chunk_cache_auto_resize(dset);
+
     /* Check if the chunk is in the cache */
     if(UINT_MAX != udata->idx_hint) {
         /* Sanity check */
-        HDassert(udata->idx_hint < rdcc->nslots);
+        HDassert(udata->idx_hint < rdcc->nslots_alloc);
         HDassert(rdcc->slot[udata->idx_hint]);
 
         /* Get the entry */
@@ -3483,6 +6313,12 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
             ent->next = ent->next->next;
             ent->prev->next = ent;
         } /* end if */
+
+        /* Make it the most recently used entry of the file's shared budget */
+        if(rdcc->pool) {
+            H5D__chunk_pool_remove(rdcc->pool, ent);
+            H5D__chunk_pool_append(dset, ent);
+        } /* end if */
     } /* end if */
     else {
         haddr_t             chunk_addr;         /* Address of chunk on disk */
@@ -3547,8 +6383,18 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
              *      or an init if it isn't.
              */
 
+            /* Check if the chunk was already read and unfiltered by the caller */
+            if(prefetched) {
+                /* Take over the caller's buffer */
+                chunk = prefetched;
+
+                /* Increment # of cache misses */
+                rdcc->stats.nmisses++;
+                if(rdcc->autosize.ghosts && H5D__chunk_cache_ghost_hit(dset, udata->common.scaled))
+                    rdcc->autosize.nghost_hits++;
+            } /* end if */
             /* Check if the chunk exists on disk */
-            if(H5F_addr_defined(chunk_addr)) {
+            else if(H5F_addr_defined(chunk_addr)) {
                 size_t my_chunk_alloc = chunk_alloc;	/* Allocated buffer size */
                 size_t buf_alloc = chunk_alloc;	        /* [Re-]allocated buffer size */
 
@@ -3558,10 +6404,12 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
                 if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, chunk_addr, my_chunk_alloc, chunk) < 0)
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "unable to read raw data chunk")
+                rdcc->stats.nbytes_read += my_chunk_alloc;
 
                 if(old_pline && old_pline->nused) {
                     H5Z_EDC_t err_detect;       /* Error detection info */
                     H5Z_cb_t filter_cb;         /* I/O filter callback function */
+                    double start_time;          /* Time the pipeline was started */
 
                     /* Retrieve filter settings from API context */
                     if(H5CX_get_err_detect(&err_detect) < 0)
@@ -3569,9 +6417,12 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                     if(H5CX_get_filter_cb(&filter_cb) < 0)
                         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, NULL, "can't get I/O filter callback function")
 
+                    start_time = H5_get_time();
                     if(H5Z_pipeline(old_pline, H5Z_FLAG_REVERSE, &(udata->filter_mask),
                             err_detect, filter_cb, &my_chunk_alloc, &buf_alloc, &chunk) < 0)
                         HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, NULL, "data pipeline read failed")
+                    rdcc->stats.filter_time += H5_get_time() - start_time;
+                    rdcc->stats.nbytes_unfiltered += my_chunk_alloc;
 
                     /* Reallocate chunk if necessary */
                     if(udata->new_unfilt_chunk) {
@@ -3588,6 +6439,8 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
 
                 /* Increment # of cache misses */
                 rdcc->stats.nmisses++;
+                if(rdcc->autosize.ghosts && H5D__chunk_cache_ghost_hit(dset, udata->common.scaled))
+                    rdcc->autosize.nghost_hits++;
             } /* end if */
             else {
                 H5D_fill_value_t	fill_status;
@@ -3635,21 +6488,20 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         } /* end else */
 
         /* See if the chunk can be cached */
-        if(rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max) {
-            /* Calculate the index */
-            udata->idx_hint = H5D__chunk_hash_val(io_info->dset->shared, udata->common.scaled);
-
-            /* Add the chunk to the cache only if the slot is not already locked */
-            ent = rdcc->slot[udata->idx_hint];
-            if(!ent || !ent->locked) {
-                /* Preempt enough things from the cache to make room */
-                if(ent) {
-                    if(H5D__chunk_cache_evict(io_info->dset, ent, TRUE) < 0)
-                        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
-                } /* end if */
-                if(H5D__chunk_cache_prune(io_info->dset, chunk_size) < 0)
-                    HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
-
+        if(rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max
+                && (NULL == rdcc->pool || chunk_size <= rdcc->pool->nbytes_max)) {
+            /* Preempt enough things from the cache to make room */
+            if(H5D__chunk_cache_prune(io_info->dset, chunk_size) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
+            if(rdcc->pool && H5D__chunk_pool_prune(rdcc->pool, chunk_size) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from shared cache")
+
+            /* Find a slot for the chunk in the hash table */
+            if(H5D__chunk_cache_free_slot(io_info->dset->shared, udata->common.scaled, &udata->idx_hint) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, NULL, "unable to find chunk cache slot")
+
+            /* Add the chunk to the cache only if there's room in the table */
+            if(UINT_MAX != udata->idx_hint) {
                 /* Create a new entry */
                 if(NULL == (ent = H5FL_CALLOC(H5D_rdcc_ent_t)))
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate raw data chunk entry")
@@ -3668,9 +6520,12 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                 ent->chunk = (uint8_t *)chunk;
 
                 /* Add it to the cache */
-                HDassert(NULL == rdcc->slot[udata->idx_hint]);
+                HDassert(NULL == rdcc->slot[udata->idx_hint] || H5D_RDCC_SLOT_DELETED == rdcc->slot[udata->idx_hint]);
+                if(H5D_RDCC_SLOT_DELETED == rdcc->slot[udata->idx_hint])
+                    rdcc->nslots_deleted--;
                 rdcc->slot[udata->idx_hint] = ent;
                 ent->idx = udata->idx_hint;
+                ent->rdcc = rdcc;
                 rdcc->nbytes_used += chunk_size;
                 rdcc->nused++;
 
@@ -3682,9 +6537,13 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                 } /* end if */
                 else
                     rdcc->head = rdcc->tail = ent;
-                ent->tmp_next = NULL;
-                ent->tmp_prev = NULL;
 
+                /* Count it against the file's shared budget */
+                if(rdcc->pool) {
+                    H5D__chunk_pool_append(dset, ent);
+                    rdcc->pool->nbytes_used += chunk_size;
+                    rdcc->pool->nused++;
+                } /* end if */
             } /* end if */
             else
                 /* We did not add the chunk to cache */
@@ -3699,6 +6558,12 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         HDassert(!ent->locked);
         ent->locked = TRUE;
         chunk = ent->chunk;
+
+        /* Count the entry as used in this epoch */
+        if(rdcc->autosize.max_nbytes > 0 && ent->epoch != rdcc->autosize.epoch) {
+            ent->epoch = rdcc->autosize.epoch;
+            rdcc->autosize.nbytes_touched += chunk_size;
+        } /* end if */
     } /* end if */
     else
         /*
@@ -3810,7 +6675,7 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
         H5D_rdcc_ent_t	*ent;   /* Chunk's entry in the cache */
 
         /* Sanity check */
-	HDassert(udata->idx_hint < rdcc->nslots);
+	HDassert(udata->idx_hint < rdcc->nslots_alloc);
 	HDassert(rdcc->slot[udata->idx_hint]);
 	HDassert(rdcc->slot[udata->idx_hint]->chunk == chunk);
 
@@ -3964,6 +6829,11 @@ H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_
     hsize_t     edge_chunk_scaled[H5O_LAYOUT_NDIMS]; /* Offset of the unfiltered edge chunks at the edge of each dimension */
     unsigned    nunfilt_edge_chunk_dims = 0; /* Number of dimensions on an edge */
     const H5O_storage_chunk_t *sc = &(layout->storage.u.chunk);
+    hbool_t     bulk_insert = FALSE;    /* Whether the index is loading the chunks in bulk */
+    void        *run_buf = NULL;        /* Fill values for a run of chunks next to each other */
+    size_t      run_buf_size = 0;       /* Size of the run buffer */
+    haddr_t     run_addr = HADDR_UNDEF; /* Address of the run of chunks being filled */
+    size_t      run_nbytes = 0;         /* Size of the run of chunks being filled */
     herr_t	ret_value = SUCCEED;	/* Return value */
 
     FUNC_ENTER_PACKAGE_TAG(dset->oloc.addr)
@@ -4100,6 +6970,102 @@ H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_
     idx_info.layout = &dset->shared->layout.u.chunk;
     idx_info.storage = &dset->shared->layout.storage.u.chunk;
 
+    /* The chunks of a dataset with an implicit index are all in the block
+     * allocated when the index was created, at addresses computed from
+     * their offsets, so there's nothing to insert into an index and they
+     * only need visiting if fill values are written to them.
+     */
+    if(H5D_CHUNK_IDX_NONE == sc->idx_type) {
+        hbool_t lazy = !should_fill;    /* Whether the chunks can be left alone */
+
+        /* Chunks filled with zeros can be left alone too when the dataset's
+         * space is allocated for the first time and nothing has been
+         * written at or past its block: every file driver reads zeros
+         * where the file was never written.  (Not done in parallel, where
+         * each process knows only of its own writes.)
+         */
+        if(!lazy && !fb_info.has_vlen_fill_type
+#ifdef H5_HAVE_PARALLEL
+                && !using_mpi
+#endif /* H5_HAVE_PARALLEL */
+                ) {
+            const uint8_t *p = (const uint8_t *)fb_info.fill_buf;
+            htri_t unwritten;           /* Whether the block is unwritten */
+            size_t u;                   /* Local index variable */
+
+            lazy = TRUE;
+            for(op_dim = 0; op_dim < space_ndims; op_dim++)
+                if(old_dim[op_dim] > 0) {
+                    lazy = FALSE;
+                    break;
+                } /* end if */
+            for(u = 0; lazy && u < orig_chunk_size; u++)
+                if(p[u])
+                    lazy = FALSE;
+            if(lazy) {
+                if((unwritten = H5F_is_unwritten_addr(dset->oloc.file, sc->idx_addr)) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunks were written")
+                lazy = (hbool_t)unwritten;
+            } /* end if */
+        } /* end if */
+
+        if(lazy) {
+            /* Reset any cached chunk info for this dataset */
+            H5D__chunk_cinfo_cache_reset(&dset->shared->cache.chunk.last);
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+
+        /* Otherwise chunks that are next to each other in the file are
+         * filled together, with copies of the fill buffer */
+        if(!fb_info.has_vlen_fill_type
+#ifdef H5_HAVE_PARALLEL
+                && !using_mpi
+#endif /* H5_HAVE_PARALLEL */
+                && orig_chunk_size <= H5D_CHUNK_FILL_RUN_NBYTES / 2) {
+            size_t u;                   /* Local index variable */
+
+            run_buf_size = (H5D_CHUNK_FILL_RUN_NBYTES / orig_chunk_size) * orig_chunk_size;
+            if(NULL == (run_buf = H5MM_malloc(run_buf_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for fill values")
+            for(u = 0; u < run_buf_size; u += orig_chunk_size)
+                HDmemcpy((uint8_t *)run_buf + u, fb_info.fill_buf, orig_chunk_size);
+        } /* end if */
+    } /* end if */
+
+    /* If no chunks existed before, they are all allocated in one pass, in
+     * index order, so the index can load them in bulk.  Chunks in the
+     * cache are skipped below, so they aren't announced. */
+    if(ops->bulk_begin && ops->insert) {
+        hsize_t nchunks = 1;    /* Number of chunks to allocate */
+
+        for(op_dim = 0; op_dim < space_ndims; op_dim++) {
+            if(min_unalloc[op_dim] > 0) {
+                nchunks = 0;
+                break;
+            } /* end if */
+            nchunks *= max_unalloc[op_dim] + 1;
+        } /* end for */
+        if(nchunks > 0) {
+            const H5D_rdcc_ent_t *ent;  /* Cache entry */
+
+            for(ent = dset->shared->cache.chunk.head; ent; ent = ent->next) {
+                for(op_dim = 0; op_dim < space_ndims; op_dim++)
+                    if(ent->scaled[op_dim] > max_unalloc[op_dim])
+                        break;
+                if(op_dim == space_ndims) {
+                    HDassert(nchunks > 0);
+                    nchunks--;
+                } /* end if */
+            } /* end for */
+        } /* end if */
+
+        if(nchunks > 1) {
+            if((ops->bulk_begin)(&idx_info, nchunks) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to start bulk insert into index")
+            bulk_insert = TRUE;
+        } /* end if */
+    } /* end if */
+
     /* Loop over all chunks */
     /* The algorithm is:
      *  For each dimension:
@@ -4187,111 +7153,131 @@ H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_
             } /* end block */
 #endif /* NDEBUG */
 
-            /* Check for VL datatype & non-default fill value */
-            if(fb_info_init && fb_info.has_vlen_fill_type) {
-                /* Sanity check */
-                HDassert(should_fill);
-                HDassert(!unfilt_fill_buf);
+            /* Chunks in the cache haven't been allocated yet (they are
+             * allocated and inserted into the index when they are
+             * flushed), and don't need filling */
+            if(UINT_MAX == udata.idx_hint || H5D_CHUNK_IDX_NONE == sc->idx_type) {
+                /* Check for VL datatype & non-default fill value */
+                if(fb_info_init && fb_info.has_vlen_fill_type) {
+                    /* Sanity check */
+                    HDassert(should_fill);
+                    HDassert(!unfilt_fill_buf);
 #ifdef H5_HAVE_PARALLEL
-                HDassert(!using_mpi);   /* Can't write VL datatypes in parallel currently */
+                    HDassert(!using_mpi);   /* Can't write VL datatypes in parallel currently */
 #endif
 
-                /* Check to make sure the buffer is large enough.  It is
-                 * possible (though ill-advised) for the filter to shrink the
-                 * buffer. */
-                if(fb_info.fill_buf_size < orig_chunk_size) {
-                    if(NULL == (fb_info.fill_buf = H5D__chunk_mem_realloc(fb_info.fill_buf, orig_chunk_size, pline)))
-                        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory reallocation failed for raw data chunk")
-                    fb_info.fill_buf_size = orig_chunk_size;
-                } /* end if */
+                    /* Check to make sure the buffer is large enough.  It is
+                     * possible (though ill-advised) for the filter to shrink the
+                     * buffer. */
+                    if(fb_info.fill_buf_size < orig_chunk_size) {
+                        if(NULL == (fb_info.fill_buf = H5D__chunk_mem_realloc(fb_info.fill_buf, orig_chunk_size, pline)))
+                            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory reallocation failed for raw data chunk")
+                        fb_info.fill_buf_size = orig_chunk_size;
+                    } /* end if */
 
-                /* Fill the buffer with VL datatype fill values */
-                if(H5D__fill_refill_vl(&fb_info, fb_info.elmts_per_buf) < 0)
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTCONVERT, FAIL, "can't refill fill value buffer")
+                    /* Fill the buffer with VL datatype fill values */
+                    if(H5D__fill_refill_vl(&fb_info, fb_info.elmts_per_buf) < 0)
+                        HGOTO_ERROR(H5E_DATASET, H5E_CANTCONVERT, FAIL, "can't refill fill value buffer")
 
-                /* Check if there are filters which need to be applied to the chunk */
-                if((pline->nused > 0) && !nunfilt_edge_chunk_dims) {
-                    H5Z_EDC_t err_detect;       /* Error detection info */
-                    H5Z_cb_t filter_cb;         /* I/O filter callback function */
-                    size_t nbytes = orig_chunk_size;
+                    /* Check if there are filters which need to be applied to the chunk */
+                    if((pline->nused > 0) && !nunfilt_edge_chunk_dims) {
+                        H5Z_EDC_t err_detect;       /* Error detection info */
+                        H5Z_cb_t filter_cb;         /* I/O filter callback function */
+                        size_t nbytes = orig_chunk_size;
 
-                    /* Retrieve filter settings from API context */
-                    if(H5CX_get_err_detect(&err_detect) < 0)
-                        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
-                    if(H5CX_get_filter_cb(&filter_cb) < 0)
-                        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+                        /* Retrieve filter settings from API context */
+                        if(H5CX_get_err_detect(&err_detect) < 0)
+                            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+                        if(H5CX_get_filter_cb(&filter_cb) < 0)
+                            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
 
-                    /* Push the chunk through the filters */
-                    if(H5Z_pipeline(pline, 0, &filter_mask, err_detect, filter_cb, &nbytes, &fb_info.fill_buf_size, &fb_info.fill_buf) < 0)
-                        HGOTO_ERROR(H5E_PLINE, H5E_WRITEERROR, FAIL, "output pipeline failed")
+                        /* Push the chunk through the filters */
+                        if(H5Z_pipeline(pline, 0, &filter_mask, err_detect, filter_cb, &nbytes, &fb_info.fill_buf_size, &fb_info.fill_buf) < 0)
+                            HGOTO_ERROR(H5E_PLINE, H5E_WRITEERROR, FAIL, "output pipeline failed")
 
 #if H5_SIZEOF_SIZE_T > 4
-                    /* Check for the chunk expanding too much to encode in a 32-bit value */
-                    if(nbytes > ((size_t)0xffffffff))
-                        HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+                        /* Check for the chunk expanding too much to encode in a 32-bit value */
+                        if(nbytes > ((size_t)0xffffffff))
+                            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
 #endif /* H5_SIZEOF_SIZE_T > 4 */
 
-                    /* Keep the number of bytes the chunk turned in to */
-                    chunk_size = nbytes;
-                } /* end if */
-                else
-                    chunk_size = layout->u.chunk.size;
+                        /* Keep the number of bytes the chunk turned in to */
+                        chunk_size = nbytes;
+                    } /* end if */
+                    else
+                        chunk_size = layout->u.chunk.size;
 
-                HDassert(*fill_buf == fb_info.fill_buf);
-            } /* end if */
+                    HDassert(*fill_buf == fb_info.fill_buf);
+                } /* end if */
 
-            /* Initialize the chunk information */
-            udata.common.layout = &layout->u.chunk;
-            udata.common.storage = &layout->storage.u.chunk;
-            udata.common.scaled = scaled;
-            udata.chunk_block.offset = HADDR_UNDEF;
-            H5_CHECKED_ASSIGN(udata.chunk_block.length, uint32_t, chunk_size, size_t);
-            udata.filter_mask = filter_mask;
+                /* Initialize the chunk information */
+                udata.common.layout = &layout->u.chunk;
+                udata.common.storage = &layout->storage.u.chunk;
+                udata.common.scaled = scaled;
+                udata.chunk_block.offset = HADDR_UNDEF;
+                H5_CHECKED_ASSIGN(udata.chunk_block.length, uint32_t, chunk_size, size_t);
+                udata.filter_mask = filter_mask;
 
-            /* Allocate the chunk (with all processes) */
-	    if(H5D__chunk_file_alloc(&idx_info, NULL, &udata.chunk_block, &need_insert, scaled) < 0)
-		HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
-            HDassert(H5F_addr_defined(udata.chunk_block.offset));
+                /* Allocate the chunk (with all processes) */
+		if(H5D__chunk_file_alloc(&idx_info, NULL, &udata.chunk_block, &need_insert, scaled) < 0)
+		    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+                HDassert(H5F_addr_defined(udata.chunk_block.offset));
 
-            /* Check if fill values should be written to chunks */
-            if(should_fill) {
-                /* Sanity check */
-                HDassert(fb_info_init);
-                HDassert(udata.chunk_block.length == chunk_size);
+                /* Check if fill values should be written to chunks */
+                if(should_fill) {
+                    /* Sanity check */
+                    HDassert(fb_info_init);
+                    HDassert(udata.chunk_block.length == chunk_size);
 
 #ifdef H5_HAVE_PARALLEL
-                /* Check if this file is accessed with an MPI-capable file driver */
-                if(using_mpi) {
-                    /* collect all chunk addresses to be written to
-                       write collectively at the end */
-                    /* allocate/resize address array if no more space left */
-                    /* Note that if we add support for parallel filters we must
-                     * also store an array of chunk sizes and pass it to the
-                     * apporpriate collective write function */
-                    if(0 == chunk_info.num_io % 1024)
-                        if(NULL == (chunk_info.addr = (haddr_t *)H5MM_realloc(chunk_info.addr, (chunk_info.num_io + 1024) * sizeof(haddr_t))))
-                            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "memory allocation failed for chunk addresses")
-
-                    /* Store the chunk's address for later */
-                    chunk_info.addr[chunk_info.num_io] = udata.chunk_block.offset;
-                    chunk_info.num_io++;
-
-                    /* Indicate that blocks will be written */
-                    blocks_written = TRUE;
-                } /* end if */
-                else {
+                    /* Check if this file is accessed with an MPI-capable file driver */
+                    if(using_mpi) {
+                        /* collect all chunk addresses to be written to
+                           write collectively at the end */
+                        /* allocate/resize address array if no more space left */
+                        /* Note that if we add support for parallel filters we must
+                         * also store an array of chunk sizes and pass it to the
+                         * apporpriate collective write function */
+                        if(0 == chunk_info.num_io % 1024)
+                            if(NULL == (chunk_info.addr = (haddr_t *)H5MM_realloc(chunk_info.addr, (chunk_info.num_io + 1024) * sizeof(haddr_t))))
+                                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "memory allocation failed for chunk addresses")
+
+                        /* Store the chunk's address for later */
+                        chunk_info.addr[chunk_info.num_io] = udata.chunk_block.offset;
+                        chunk_info.num_io++;
+
+                        /* Indicate that blocks will be written */
+                        blocks_written = TRUE;
+                    } /* end if */
+                    else {
 #endif /* H5_HAVE_PARALLEL */
-                    if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, chunk_size, *fill_buf) < 0)
-                        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+                        if(run_buf) {
+                            /* Write out the run of chunks being filled if this
+                             * chunk doesn't continue it or it's full */
+                            if(run_nbytes > 0 && (!H5F_addr_eq(run_addr + run_nbytes, udata.chunk_block.offset)
+                                    || run_nbytes + chunk_size > run_buf_size)) {
+                                if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, run_addr, run_nbytes, run_buf) < 0)
+                                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+                                run_nbytes = 0;
+                            } /* end if */
+
+                            /* Add the chunk to the run */
+                            if(run_nbytes == 0)
+                                run_addr = udata.chunk_block.offset;
+                            run_nbytes += chunk_size;
+                        } /* end if */
+                        else if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, chunk_size, *fill_buf) < 0)
+                            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
 #ifdef H5_HAVE_PARALLEL
-                } /* end else */
+                    } /* end else */
 #endif /* H5_HAVE_PARALLEL */
-            } /* end if */
+                } /* end if */
 
-            /* Insert the chunk record into the index */
-	    if(need_insert && ops->insert)
-                if((ops->insert)(&idx_info, &udata, dset) < 0)
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+                /* Insert the chunk record into the index */
+		if(need_insert && ops->insert)
+                    if((ops->insert)(&idx_info, &udata, dset) < 0)
+                        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+            } /* end if */
 
             /* Increment indices and adjust the edge chunk state */
             carry = TRUE;
@@ -4342,6 +7328,18 @@ H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_
             max_unalloc[op_dim] = min_unalloc[op_dim] - 1;
     } /* end for(op_dim=0...) */
 
+    /* Write out the last run of chunks being filled */
+    if(run_nbytes > 0)
+        if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, run_addr, run_nbytes, run_buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+
+    /* Finish loading the index */
+    if(bulk_insert) {
+        bulk_insert = FALSE;
+        if((ops->bulk_end)(&idx_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to finish bulk insert into index")
+    } /* end if */
+
 #ifdef H5_HAVE_PARALLEL
     /* do final collective I/O */
     if(using_mpi && blocks_written)
@@ -4353,6 +7351,10 @@ H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_
     H5D__chunk_cinfo_cache_reset(&dset->shared->cache.chunk.last);
 
 done:
+    /* Release the index's bulk insert state, on error */
+    if(bulk_insert && (ops->bulk_end)(&idx_info) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to finish bulk insert into index")
+
     /* Release the fill buffer info, if it's been initialized */
     if(fb_info_init && H5D__fill_term(&fb_info) < 0)
         HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "Can't release fill buffer info")
@@ -4360,6 +7362,9 @@ done:
     /* Free the unfiltered fill value buffer */
     unfilt_fill_buf = H5D__chunk_mem_xfree(unfilt_fill_buf, &def_pline);
 
+    /* Free the fill values for runs of chunks */
+    run_buf = H5MM_xfree(run_buf);
+
 #ifdef H5_HAVE_PARALLEL
     if(using_mpi && chunk_info.addr)
         H5MM_free(chunk_info.addr);
@@ -4502,7 +7507,7 @@ H5D__chunk_update_old_edge_chunks(H5D_t *dset, hsize_t old_dim[])
                     || (UINT_MAX != chk_udata.idx_hint)) {
                 /* Lock the chunk into cache.  H5D__chunk_lock will take care of
                 * updating the chunk to no longer be an edge chunk. */
-                if(NULL == (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_udata, FALSE, TRUE)))
+                if(NULL == (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_udata, FALSE, TRUE, NULL)))
                     HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
                 /* Unlock the chunk */
@@ -4763,7 +7768,7 @@ H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "unable to select hyperslab")
 
     /* Lock the chunk into the cache, to get a pointer to the chunk buffer */
-    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE, FALSE)))
+    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE, FALSE, NULL)))
         HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
 
@@ -5418,9 +8423,6 @@ herr_t
 H5D__chunk_update_cache(H5D_t *dset)
 {
     H5D_rdcc_t         *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
-    H5D_rdcc_ent_t     *ent, *next;	/*cache entry  */
-    H5D_rdcc_ent_t     tmp_head;        /* Sentinel entry for temporary entry list */
-    H5D_rdcc_ent_t     *tmp_tail;       /* Tail pointer for temporary entry list */
     herr_t              ret_value = SUCCEED;      /* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -5432,83 +8434,13 @@ H5D__chunk_update_cache(H5D_t *dset)
     /* Check the rank */
     HDassert((dset->shared->layout.u.chunk.ndims - 1) > 1);
 
-    /* Add temporary entry list to rdcc */
-    (void)HDmemset(&tmp_head, 0, sizeof(tmp_head));
-    rdcc->tmp_head = &tmp_head;
-    tmp_tail = &tmp_head;
-
-    /* Recompute the index for each cached chunk that is in a dataset */
-    for(ent = rdcc->head; ent; ent = next) {
-        unsigned	    old_idx;	/* Previous index number	*/
-
-        /* Get the pointer to the next cache entry */
-        next = ent->next;
-
-        /* Compute the index for the chunk entry */
-        old_idx = ent->idx;   /* Save for later */
-        ent->idx = H5D__chunk_hash_val(dset->shared, ent->scaled);
-
-        if(old_idx != ent->idx) {
-            H5D_rdcc_ent_t     *old_ent;	/* Old cache entry  */
-
-            /* Check if there is already a chunk at this chunk's new location */
-            old_ent = rdcc->slot[ent->idx];
-            if(old_ent != NULL) {
-                HDassert(old_ent->locked == FALSE);
-                HDassert(old_ent->deleted == FALSE);
-
-                /* Insert the old entry into the temporary list, but do not
-                 * evict (yet).  Make sure we do not make any calls to the index
-                 * until all chunks have updated indices! */
-                HDassert(!old_ent->tmp_next);
-                HDassert(!old_ent->tmp_prev);
-                tmp_tail->tmp_next = old_ent;
-                old_ent->tmp_prev = tmp_tail;
-                tmp_tail = old_ent;
-            } /* end if */
-
-            /* Insert this chunk into correct location in hash table */
-            rdcc->slot[ent->idx] = ent;
-
-            /* If this chunk was previously on the temporary list and therefore
-             * not in the hash table, remove it from the temporary list.
-             * Otherwise clear the old hash table slot. */
-            if(ent->tmp_prev) {
-                HDassert(tmp_head.tmp_next);
-                HDassert(tmp_tail != &tmp_head);
-                ent->tmp_prev->tmp_next = ent->tmp_next;
-                if(ent->tmp_next) {
-                    ent->tmp_next->tmp_prev = ent->tmp_prev;
-                    ent->tmp_next = NULL;
-                } /* end if */
-                else {
-                    HDassert(tmp_tail == ent);
-                    tmp_tail = ent->tmp_prev;
-                } /* end else */
-                ent->tmp_prev = NULL;
-            } /* end if */
-            else
-                rdcc->slot[old_idx] = NULL;
-        } /* end if */
-    } /* end for */
-
-    /* tmp_tail is no longer needed, and will be invalidated by
-     * H5D_chunk_cache_evict anyways. */
-    tmp_tail = NULL;
-
-    /* Evict chunks that are still on the temporary list */
-    while(tmp_head.tmp_next) {
-        ent = tmp_head.tmp_next;
-
-        /* Remove the old entry from the cache */
-        if(H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
-            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
-    } /* end while */
+    /* Reinsert each cached chunk at its new hash value.  The hash table
+     * keeps chunks whose values collide, so none have to be evicted. */
+    if(rdcc->nslots_alloc > 0)
+        if(H5D__chunk_cache_rehash(dset->shared, rdcc->nslots_alloc) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to update chunk cache hash table")
 
 done:
-    /* Remove temporary list from rdcc */
-    rdcc->tmp_head = NULL;
-
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_update_cache() */
 
@@ -5606,26 +8538,17 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
     else {
         H5D_rdcc_ent_t *ent = NULL;    /* Cache entry */
         unsigned idx;                   /* Index of chunk in cache, if present */
-        unsigned u;                     /* Counter */
         H5D_shared_t *shared_fo = (H5D_shared_t *)udata->cpy_info->shared_fo;
 
         /* See if the written chunk is in the chunk cache */
         if(shared_fo && shared_fo->cache.chunk.nslots > 0) {
             /* Determine the chunk's location in the hash table */
-            idx = H5D__chunk_hash_val(shared_fo, chunk_rec->scaled);
+            idx = H5D__chunk_cache_find(shared_fo, chunk_rec->scaled, NULL);
 
             /* Get the chunk cache entry for that location */
-            ent = shared_fo->cache.chunk.slot[idx];
-            if(ent) {
-                /* Speculatively set the 'found' flag */
+            if(UINT_MAX != idx) {
+                ent = shared_fo->cache.chunk.slot[idx];
                 udata->chunk_in_cache = TRUE;
-
-                /* Verify that the cache entry is the correct chunk */
-                for(u = 0; u < shared_fo->ndims; u++)
-                    if(chunk_rec->scaled[u] != ent->scaled[u]) {
-                        udata->chunk_in_cache = FALSE;
-                        break;
-                    } /* end if */
             } /* end if */
         } /* end if */
 
@@ -5726,17 +8649,18 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
     udata_dst.chunk_idx = H5VM_array_offset_pre(udata_dst.common.layout->ndims - 1, 
 	udata_dst.common.layout->max_down_chunks, udata_dst.common.scaled);
 
+    /* Set metadata tag in API context (allocating a chunk in a sharded
+     * index can create metadata too) */
+    H5_BEGIN_TAG(H5AC__COPIED_TAG);
+
     /* Allocate chunk in the file */
     if(H5D__chunk_file_alloc(udata->idx_info_dst, NULL, &udata_dst.chunk_block, &need_insert, udata_dst.common.scaled) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+        HGOTO_ERROR_TAG(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
 
     /* Write chunk data to destination file */
     HDassert(H5F_addr_defined(udata_dst.chunk_block.offset));
     if(H5F_block_write(udata->idx_info_dst->f, H5FD_MEM_DRAW, udata_dst.chunk_block.offset, nbytes, buf) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, H5_ITER_ERROR, "unable to write raw data to file")
-
-    /* Set metadata tag in API context */
-    H5_BEGIN_TAG(H5AC__COPIED_TAG);
+        HGOTO_ERROR_TAG(H5E_DATASET, H5E_WRITEERROR, H5_ITER_ERROR, "unable to write raw data to file")
 
     /* Insert chunk record into index */
     if(need_insert && udata->idx_info_dst->storage->ops->insert)
@@ -6270,9 +9194,9 @@ H5D__chunk_stats(const H5D_t *dset, hbool_t headers)
             sprintf(ascii, "%7.2f%%", miss_rate);
         }
 
-        fprintf(H5DEBUG(AC), "   %-18s %8u %8u %7s %8d+%-9ld\n",
+        HDfprintf(H5DEBUG(AC), "   %-18s %8Hu %8Hu %7s %8Hu+%-9Hd\n",
             "raw data chunks", rdcc->stats.nhits, rdcc->stats.nmisses, ascii,
-            rdcc->stats.ninits, (long)(rdcc->stats.nflushes)-(long)(rdcc->stats.ninits));
+            rdcc->stats.ninits, (hssize_t)rdcc->stats.nflushes - (hssize_t)rdcc->stats.ninits);
     }
 
 done:
@@ -6491,9 +9415,12 @@ H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info, const H5F_block_t *old
 		/* Release previous chunk */
 		/* Only free the old location if not doing SWMR writes - otherwise
                  * we must keep the old chunk around in case a reader has an
-                 * outdated version of the B-tree node
+                 * outdated version of the B-tree node.  A sharded index
+                 * reuses or frees the old location itself, when the chunk
+                 * is allocated below.
                  */
-		if(!(H5F_INTENT(idx_info->f) & H5F_ACC_SWMR_WRITE))
+		if(!(H5F_INTENT(idx_info->f) & H5F_ACC_SWMR_WRITE)
+                        && H5D_CHUNK_IDX_SHARD != idx_info->storage->idx_type)
 		    if(H5MF_xfree(idx_info->f, H5FD_MEM_DRAW, old_chunk->offset, old_chunk->length) < 0)
 			HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
 		alloc_chunk = TRUE;
@@ -6543,6 +9470,13 @@ H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info, const H5F_block_t *old
                 *need_insert = TRUE;
                 break;
 
+            case H5D_CHUNK_IDX_SHARD:
+                HDassert(new_chunk->length > 0);
+                if(H5D__shard_alloc_chunk(idx_info, scaled, new_chunk) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "unable to allocate chunk in shard")
+                *need_insert = TRUE;
+                break;
+
             case H5D_CHUNK_IDX_NTYPES:
             default:
                 HDassert(0 && "This should never be executed!");
@@ -40,6 +40,7 @@
 #include "H5FLprivate.h"    /* Free Lists                   */
 #include "H5Iprivate.h"     /* IDs                          */
 #include "H5MFprivate.h"    /* File memory management       */
+#include "H5MMprivate.h"    /* Memory management            */
 #include "H5FOprivate.h"    /* File objects                 */
 #include "H5Oprivate.h"     /* Object headers               */
 #include "H5Pprivate.h"     /* Property lists               */
@@ -63,12 +64,6 @@ typedef struct H5D_contig_readvv_sieve_ud_t {
     unsigned char *rbuf;        /* Pointer to buffer to fill */
 } H5D_contig_readvv_sieve_ud_t;
 
-/* Callback info for [plain] readvv operation */
-typedef struct H5D_contig_readvv_ud_t {
-    H5F_t *file;                /* File for dataset */
-    haddr_t dset_addr;          /* Address of dataset */
-    unsigned char *rbuf;        /* Pointer to buffer to fill */
-} H5D_contig_readvv_ud_t;
 
 /* Callback info for sieve buffer writevv operation */
 typedef struct H5D_contig_writevv_sieve_ud_t {
@@ -78,12 +73,16 @@ typedef struct H5D_contig_writevv_sieve_ud_t {
     const unsigned char *wbuf;  /* Pointer to buffer to write */
 } H5D_contig_writevv_sieve_ud_t;
 
-/* Callback info for [plain] writevv operation */
-typedef struct H5D_contig_writevv_ud_t {
-    H5F_t *file;                /* File for dataset */
+/* Callback info for [plain] vector readvv/writevv operation */
+typedef struct H5D_contig_vector_ud_t {
     haddr_t dset_addr;          /* Address of dataset */
-    const unsigned char *wbuf;  /* Pointer to buffer to write */
-} H5D_contig_writevv_ud_t;
+    H5D_io_op_type_t op_type;   /* Whether this is a read or a write */
+    union {
+        unsigned char *rbuf;        /* Pointer to buffer to fill */
+        const unsigned char *wbuf;  /* Pointer to buffer to write */
+    } buf;
+    H5D_io_vec_t *vec;          /* Vectors to append the pieces to */
+} H5D_contig_vector_ud_t;
 
 
 /********************/
@@ -107,6 +106,10 @@ static herr_t H5D__contig_flush(H5D_t *dset);
 /* Helper routines */
 static herr_t H5D__contig_write_one(H5D_io_info_t *io_info, hsize_t offset,
     size_t size);
+static ssize_t H5D__contig_vectorvv(const H5D_io_info_t *io_info,
+    H5D_io_op_type_t op_type,
+    size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_offset_arr[],
+    size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_offset_arr[]);
 
 
 /*********************/
@@ -849,33 +852,111 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__contig_readvv_cb
+ * Function:	H5D__contig_vector_cb
  *
- * Purpose:	Callback operator for H5D__contig_readvv() without sieve buffer.
+ * Purpose:	Callback operator for H5D__contig_vectorvv(), which appends
+ *		each piece of the I/O operation to the I/O vectors.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Quincey Koziol
- *              Thursday, Sept 30, 2010
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__contig_readvv_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata)
+H5D__contig_vector_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata)
 {
-    H5D_contig_readvv_ud_t *udata = (H5D_contig_readvv_ud_t *)_udata; /* User data for H5VM_opvv() operator */
-    herr_t ret_value = SUCCEED;         /* Return value */
+    H5D_contig_vector_ud_t *udata = (H5D_contig_vector_ud_t *)_udata; /* User data for H5VM_opvv() operator */
+    H5D_io_vec_t *vec = udata->vec;     /* Vectors to append to */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(vec->count < vec->alloc);
+
+    /* Append this piece to the vectors */
+    vec->types[vec->count] = H5FD_MEM_DRAW;
+    vec->addrs[vec->count] = udata->dset_addr + dst_off;
+    vec->sizes[vec->count] = len;
+    if(H5D_IO_OP_READ == udata->op_type)
+        vec->bufs.rbufs[vec->count] = udata->buf.rbuf + src_off;
+    else
+        vec->bufs.wbufs[vec->count] = udata->buf.wbuf + src_off;
+    vec->count++;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+}   /* end H5D__contig_vector_cb() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_vectorvv
+ *
+ * Purpose:	Reads or writes some data vectors between a dataset and a
+ *		buffer, without using the sieve buffer.  All the pieces of
+ *		the operation are gathered into I/O vectors, which are
+ *		handed to the file layer in a single call so that file
+ *		drivers with vector I/O support can issue fewer system
+ *		calls.  If the operation gathers its I/O (IO_INFO->vec is
+ *		set), the pieces are only appended to its vectors.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static ssize_t
+H5D__contig_vectorvv(const H5D_io_info_t *io_info, H5D_io_op_type_t op_type,
+    size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
+    size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[])
+{
+    H5D_contig_vector_ud_t udata;       /* User data for H5VM_opvv() operator */
+    H5D_io_vec_t local_vec;             /* Vectors for this call alone */
+    size_t nentries;                    /* Most entries this call can add */
+    ssize_t ret_value = -1;             /* Return value (Size of sequence in bytes) */
 
     FUNC_ENTER_STATIC
 
-    /* Write data */
-    if(H5F_block_read(udata->file, H5FD_MEM_DRAW, (udata->dset_addr + dst_off),
-            len, (udata->rbuf + src_off)) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+    /* Set up the vectors for this call, in case the operation doesn't
+     * gather its I/O */
+    HDmemset(&local_vec, 0, sizeof(local_vec));
+    local_vec.file = io_info->dset->oloc.file;
+    local_vec.op_type = op_type;
+
+    /* Set up user data for H5VM_opvv() */
+    udata.dset_addr = io_info->store->contig.dset_addr;
+    udata.op_type = op_type;
+    if(H5D_IO_OP_READ == op_type)
+        udata.buf.rbuf = (unsigned char *)io_info->u.rbuf;
+    else
+        udata.buf.wbuf = (const unsigned char *)io_info->u.wbuf;
+    udata.vec = io_info->vec ? io_info->vec : &local_vec;
+    HDassert(udata.vec->op_type == op_type);
+
+    /* Each piece ends a dataset or a memory sequence, so there can't be
+     * more pieces than the sum of the remaining sequences.
+     */
+    nentries = (dset_max_nseq - *dset_curr_seq) + (mem_max_nseq - *mem_curr_seq);
+    if(0 == nentries)
+        HGOTO_DONE(0)
+    if(H5D__io_vec_reserve(udata.vec, nentries) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O vectors")
+
+    /* Call generic sequence operation routine to build the vectors */
+    if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
+            mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
+            H5D__contig_vector_cb, &udata)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't build I/O vectors")
+
+    /* Perform the I/O, unless the operation does it later */
+    if(NULL == io_info->vec)
+        if(H5D__io_vec_flush(&local_vec) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "vector I/O failed")
 
 done:
+    H5D__io_vec_free(&local_vec);
+
     FUNC_LEAVE_NOAPI(ret_value)
-}   /* end H5D__contig_readvv_cb() */
+}   /* end H5D__contig_vectorvv() */
+
+
 
 
 /*-------------------------------------------------------------------------
@@ -901,7 +982,8 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
     size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
     size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[])
 {
-    ssize_t ret_value = -1;     /* Return value */
+    const void *dset_ptr = NULL;        /* Dataset storage, if mapped in memory */
+    ssize_t ret_value = -1;             /* Return value */
 
     FUNC_ENTER_STATIC
 
@@ -914,8 +996,28 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
-    /* Check if data sieving is enabled */
-    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
+    /* Check if the file driver can expose the dataset's storage directly in
+     * memory (e.g. the mmap driver), so the data can be copied straight into
+     * the destination buffer, bypassing the sieve buffer and the driver's
+     * read callback.  (A dirty sieve buffer holds newer data than the file.)
+     */
+    if(!io_info->dset->shared->cache.contig.sieve_dirty
+            && io_info->store->contig.dset_size == (hsize_t)((size_t)io_info->store->contig.dset_size))
+        if(H5F_block_get_ptr(io_info->dset->oloc.file, H5FD_MEM_DRAW, io_info->store->contig.dset_addr,
+                (size_t)io_info->store->contig.dset_size, &dset_ptr) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get pointer to dataset storage")
+
+    if(dset_ptr) {
+        /* Copy the sequences directly from the file's memory */
+        if((ret_value = H5VM_memcpyvv(io_info->u.rbuf, mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
+                dset_ptr, dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't copy from mapped dataset storage")
+    } /* end if */
+    /* Check if data sieving is enabled (Operations which gather their I/O
+     * across datasets bypass the sieve buffer.) */
+    else if(NULL == io_info->vec
+            && H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)
+            && io_info->dset->shared->cache.contig.sieve_buf_size > 0) {
         H5D_contig_readvv_sieve_ud_t udata;     /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
@@ -931,17 +1033,10 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized sieve buffer read")
     } /* end if */
     else {
-        H5D_contig_readvv_ud_t udata;     /* User data for H5VM_opvv() operator */
-
-        /* Set up user data for H5VM_opvv() */
-        udata.file = io_info->dset->oloc.file;
-        udata.dset_addr = io_info->store->contig.dset_addr;
-        udata.rbuf = (unsigned char *)io_info->u.rbuf;
-
-        /* Call generic sequence operation routine */
-        if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
-                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
-                H5D__contig_readvv_cb, &udata)) < 0)
+        /* Gather the sequences into a single vector read */
+        if((ret_value = H5D__contig_vectorvv(io_info, H5D_IO_OP_READ,
+                dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
+                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr)) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized read")
     } /* end else */
 
@@ -1173,35 +1268,7 @@ done:
 }   /* end H5D__contig_writevv_sieve_cb() */
 
 
-/*-------------------------------------------------------------------------
- * Function:	H5D__contig_writevv_cb
- *
- * Purpose:	Callback operator for H5D__contig_writevv().
- *
- * Return:	Non-negative on success/Negative on failure
- *
- * Programmer:	Quincey Koziol
- *              Thursday, Sept 30, 2010
- *
- *-------------------------------------------------------------------------
- */
-static herr_t
-H5D__contig_writevv_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata)
-{
-    H5D_contig_writevv_ud_t *udata = (H5D_contig_writevv_ud_t *)_udata; /* User data for H5VM_opvv() operator */
-    herr_t ret_value = SUCCEED; /* Return value */
-
-    FUNC_ENTER_STATIC
-
-    /* Write data */
-    if(H5F_block_write(udata->file, H5FD_MEM_DRAW, (udata->dset_addr + dst_off), len, (udata->wbuf + src_off)) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
-
-done:
-    FUNC_LEAVE_NOAPI(ret_value)
-}   /* end H5D__contig_writevv_cb() */
 
-
 /*-------------------------------------------------------------------------
  * Function:	H5D__contig_writevv
  *
@@ -1238,8 +1305,11 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
-    /* Check if data sieving is enabled */
-    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
+    /* Check if data sieving is enabled (Operations which gather their I/O
+     * across datasets bypass the sieve buffer.) */
+    if(NULL == io_info->vec
+            && H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)
+            && io_info->dset->shared->cache.contig.sieve_buf_size > 0) {
         H5D_contig_writevv_sieve_ud_t udata;    /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
@@ -1255,18 +1325,11 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized sieve buffer write")
     } /* end if */
     else {
-        H5D_contig_writevv_ud_t udata;     /* User data for H5VM_opvv() operator */
-
-        /* Set up user data for H5VM_opvv() */
-        udata.file = io_info->dset->oloc.file;
-        udata.dset_addr = io_info->store->contig.dset_addr;
-        udata.wbuf = (const unsigned char *)io_info->u.wbuf;
-
-        /* Call generic sequence operation routine */
-        if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
-                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
-                H5D__contig_writevv_cb, &udata)) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized read")
+        /* Gather the sequences into a single vector write */
+        if((ret_value = H5D__contig_vectorvv(io_info, H5D_IO_OP_WRITE,
+                dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
+                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized write")
     } /* end else */
 
 done:
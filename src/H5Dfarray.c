@@ -151,6 +151,8 @@ const H5D_chunk_ops_t H5D_COPS_FARRAY[1] = {{
     H5D__farray_idx_create,             /* create */
     H5D__farray_idx_is_space_alloc,     /* is_space_alloc */
     H5D__farray_idx_insert,             /* insert */
+    NULL,                               /* bulk_begin */
+    NULL,                               /* bulk_end */
     H5D__farray_idx_get_addr,           /* get_addr */
     NULL,                               /* resize */
     H5D__farray_idx_iterate,            /* iterate */
@@ -1805,6 +1805,12 @@ H5D_close(H5D_t *dataset)
         dataset->shared = H5FL_FREE(H5D_shared_t, dataset->shared);
     } /* end if */
     else {
+        /* The file's shared chunk cache budget can't flush this dataset's
+         * chunks through this handle any more, so write them out now */
+        if(H5D_CHUNKED == dataset->shared->layout.type
+                && H5D__chunk_pool_detach(dataset) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush cached chunks of closed handle")
+
         /* Decrement the ref. count for this object in the top file */
         if(H5FO_top_decr(dataset->oloc.file, dataset->oloc.addr) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't decrement count for object")
@@ -2510,7 +2516,7 @@ H5D__vlen_get_buf_size(void H5_ATTR_UNUSED *elem, hid_t type_id,
         HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't select point")
 
     /* Read in the point (with the custom VL memory allocator) */
-    if(H5D__read(vlen_bufsize->dset, type_id, vlen_bufsize->mspace, vlen_bufsize->fspace, vlen_bufsize->fl_tbuf) < 0)
+    if(H5D__read(vlen_bufsize->dset, type_id, vlen_bufsize->mspace, vlen_bufsize->fspace, vlen_bufsize->fl_tbuf, NULL) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read point")
 
 done:
@@ -2757,7 +2763,7 @@ done:
  *-------------------------------------------------------------------------
  */
 herr_t
-H5D__flush_sieve_buf(H5D_t *dataset)
+H5D__flush_sieve_buf(const H5D_t *dataset)
 {
     herr_t ret_value = SUCCEED;         /* Return value */
 
@@ -3372,6 +3378,10 @@ H5D_get_access_plist(const H5D_t *dset)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache byte size")
         if(H5P_set(new_plist, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, &(dset->shared->cache.chunk.w0)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set preempt read chunks")
+        if(H5P_set(new_plist, H5D_ACS_CHUNK_READ_AHEAD_NAME, &(dset->shared->cache.chunk.read_ahead)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set # of chunks to read ahead")
+        if(H5P_set(new_plist, H5D_ACS_CHUNK_CACHE_AUTO_NAME, &(dset->shared->cache.chunk.autosize.max_nbytes)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set largest automatic chunk cache size")
         if(H5P_set(new_plist, H5D_ACS_APPEND_FLUSH_NAME, &dset->shared->append_flush) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set append flush property")
     } /* end if */
@@ -25,9 +25,11 @@
 #include "H5CXprivate.h"        /* API Contexts                         */
 #include "H5Dpkg.h"		/* Dataset functions			*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5ESprivate.h"        /* Event Sets                           */
 #include "H5FLprivate.h"	/* Free Lists                           */
 #include "H5Iprivate.h"		/* IDs			  		*/
 #include "H5MMprivate.h"        /* Memory management                    */
+#include "H5Pprivate.h"         /* Property lists                       */
 #include "H5Sprivate.h"		/* Dataspace			  	*/
 
 #ifdef H5_HAVE_PARALLEL
@@ -40,11 +42,32 @@
 /* Local Macros */
 /****************/
 
+/* Number of entries a gathered I/O vector may hold before it is flushed */
+#define H5D_IO_VEC_MAX_ENTRIES  (64 * 1024)
+
 
 /******************/
 /* Local Typedefs */
 /******************/
 
+/* Information about a dataset read or write queued in an event set */
+typedef struct H5D_async_io_t {
+    hbool_t do_write;           /* Whether the operation is a write */
+    hid_t dset_id;              /* Dataset (reference held) */
+    hid_t mem_type_id;          /* Memory datatype (reference held) */
+    H5S_t *mem_space;           /* Copy of memory dataspace, NULL for H5S_ALL */
+    H5S_t *file_space;          /* Copy of file dataspace, NULL for H5S_ALL */
+    hid_t dxpl_id;              /* Copy of the dataset transfer property list */
+    void *rbuf;                 /* Application buffer for a read */
+    const void *wbuf;           /* Application buffer for a write */
+} H5D_async_io_t;
+
+/* Entry of a gathered I/O vector, for sorting by file address */
+typedef struct H5D_io_vec_sort_t {
+    haddr_t addr;               /* File address of the entry */
+    size_t idx;                 /* Position of the entry in the vectors */
+} H5D_io_vec_sort_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -61,6 +84,20 @@ static herr_t H5D__ioinfo_adjust(H5D_io_info_t *io_info, const H5D_t *dset,
 #endif /* H5_HAVE_PARALLEL */
 static herr_t H5D__typeinfo_term(const H5D_type_info_t *type_info);
 
+/* Asynchronous I/O routines */
+static herr_t H5D__io_async(H5ES_t *es, hbool_t do_write, hid_t dset_id,
+    hid_t mem_type_id, const H5S_t *mem_space, const H5S_t *file_space,
+    hid_t dxpl_id, void *rbuf, const void *wbuf);
+static herr_t H5D__io_async_exec(void *op_data);
+static herr_t H5D__io_async_release(void *op_data);
+
+/* Multiple dataset I/O routines */
+static herr_t H5D__multi_args(size_t count, const hid_t dset_id[],
+    const hid_t mem_space_id[], const hid_t file_space_id[], H5D_t ***dsets,
+    const H5S_t ***mem_spaces, const H5S_t ***file_spaces);
+static int H5D__multi_cmp_shared(const void *_dset1, const void *_dset2);
+static int H5D__io_vec_cmp(const void *_ent1, const void *_ent2);
+
 
 /*********************/
 /* Package Variables */
@@ -77,6 +114,9 @@ H5FL_BLK_DEFINE(type_conv);
 /* Declare a free list to manage the H5D_chunk_map_t struct */
 H5FL_DEFINE(H5D_chunk_map_t);
 
+/* Declare a free list to manage the H5D_async_io_t struct */
+H5FL_DEFINE_STATIC(H5D_async_io_t);
+
 
 
 /*-------------------------------------------------------------------------
@@ -164,8 +204,337 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
     if(H5CX_get_dcr_flag(&direct_read) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting flag for direct chunk read")
 
+    if(H5D__pre_read(dset, direct_read, mem_type_id, mem_space, file_space, buf) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dread() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dwrite
+ *
+ * Purpose:	Writes (part of) a DSET from application memory BUF to the
+ *		file.  The part of the dataset to write is defined with the
+ *		MEM_SPACE_ID and FILE_SPACE_ID arguments. The data points
+ *		are converted from their current type (MEM_TYPE_ID) to their
+ *		file datatype.	 Additional miscellaneous data transfer
+ *		properties can be passed to this function with the
+ *		PLIST_ID argument.
+ *
+ *		The FILE_SPACE_ID can be the constant H5S_ALL which indicates
+ *		that the entire file dataspace is to be referenced.
+ *
+ *		The MEM_SPACE_ID can be the constant H5S_ALL in which case
+ *		the memory dataspace is the same as the file dataspace
+ *		defined when the dataset was created.
+ *
+ *		The number of elements in the memory dataspace must match
+ *		the number of elements in the file dataspace.
+ *
+ *		The PLIST_ID can be the constant H5P_DEFAULT in which
+ *		case the default data transfer properties are used.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *		Thursday, December  4, 1997
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
+    hid_t file_space_id, hid_t dxpl_id, const void *buf)
+{
+    H5D_t		   *dset = NULL;
+    const H5S_t            *mem_space = NULL;
+    const H5S_t            *file_space = NULL;
+    hbool_t                 direct_write = FALSE;
+    herr_t                  ret_value = SUCCEED;  /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE6("e", "iiiii*x", dset_id, mem_type_id, mem_space_id, file_space_id,
+             dxpl_id, buf);
+
+    /* check arguments */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(NULL == dset->oloc.file)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    /* Set DXPL for operation */
+    H5CX_set_dxpl(dxpl_id);
+
+    /* Retrieve the 'direct write' flag */
+    if(H5CX_get_dcw_flag(&direct_write) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting flag for direct chunk read")
+
+    /* Check dataspace selections if this is not a direct write */
+    if(!direct_write) {
+        if(mem_space_id < 0 || file_space_id < 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+        if(H5S_ALL != mem_space_id) {
+            if(NULL == (mem_space = (const H5S_t *)H5I_object_verify(mem_space_id, H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+            /* Check for valid selection */
+            if(H5S_SELECT_VALID(mem_space) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "memory selection+offset not within extent")
+        } /* end if */
+        if(H5S_ALL != file_space_id) {
+            if(NULL == (file_space = (const H5S_t *)H5I_object_verify(file_space_id, H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+	    /* Check for valid selection */
+	    if(H5S_SELECT_VALID(file_space) != TRUE)
+		HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "file selection+offset not within extent")
+	} /* end if */
+    } /* end if */
+
+    if(H5D__pre_write(dset, direct_write, mem_type_id, mem_space, file_space, buf) < 0) 
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't prepare for writing data")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dwrite() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dread_multi
+ *
+ * Purpose:	Reads (part of) several datasets into application memory
+ *		in one call.  COUNT is the number of datasets; entry I of
+ *		DSET_ID, MEM_TYPE_ID, MEM_SPACE_ID, FILE_SPACE_ID and BUF
+ *		holds the arguments H5Dread() would take for dataset I.
+ *		All the datasets are read with the same data transfer
+ *		property list, DXPL_ID.
+ *
+ *		Reads of contiguous raw data that need no datatype
+ *		conversion are gathered across the datasets of each file,
+ *		sorted by file address and handed to the file driver
+ *		together, so that drivers with vector I/O support can merge
+ *		them into fewer requests.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dread_multi(size_t count, const hid_t dset_id[], const hid_t mem_type_id[],
+    const hid_t mem_space_id[], const hid_t file_space_id[], hid_t dxpl_id,
+    void *buf[]/*out*/)
+{
+    H5D_t **dsets = NULL;               /* Datasets to read */
+    const H5S_t **mem_spaces = NULL;    /* Memory dataspaces */
+    const H5S_t **file_spaces = NULL;   /* File dataspaces */
+    hbool_t direct_read = FALSE;        /* Whether direct chunk reads are set */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "z*i*i*i*ii**x", count, dset_id, mem_type_id, mem_space_id,
+             file_space_id, dxpl_id, buf);
+
+    /* Check arguments */
+    if(0 == count)
+        HGOTO_DONE(SUCCEED)
+    if(!dset_id || !mem_type_id || !mem_space_id || !file_space_id || !buf)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL argument array")
+    if(H5D__multi_args(count, dset_id, mem_space_id, file_space_id, &dsets, &mem_spaces, &file_spaces) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid arguments")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    /* Set DXPL for operation */
+    H5CX_set_dxpl(dxpl_id);
+
+    /* Direct chunk reads are for one dataset at a time */
+    if(H5CX_get_dcr_flag(&direct_read) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting flag for direct chunk read")
+    if(direct_read)
+        HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "direct chunk read not supported for several datasets")
+
+    /* Read raw data */
+    if(H5D__read_multi(count, dsets, mem_type_id, mem_spaces, file_spaces, buf) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+
+done:
+    H5MM_xfree(dsets);
+    H5MM_xfree(mem_spaces);
+    H5MM_xfree(file_spaces);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dread_multi() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dwrite_multi
+ *
+ * Purpose:	Writes (part of) several datasets from application memory
+ *		in one call.  COUNT is the number of datasets; entry I of
+ *		DSET_ID, MEM_TYPE_ID, MEM_SPACE_ID, FILE_SPACE_ID and BUF
+ *		holds the arguments H5Dwrite() would take for dataset I.
+ *		All the datasets are written with the same data transfer
+ *		property list, DXPL_ID.
+ *
+ *		Writes of contiguous raw data that need no datatype
+ *		conversion are gathered as for H5Dread_multi().  A dataset
+ *		may appear more than once; where its selections overlap,
+ *		the later entry's data is the one stored.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dwrite_multi(size_t count, const hid_t dset_id[], const hid_t mem_type_id[],
+    const hid_t mem_space_id[], const hid_t file_space_id[], hid_t dxpl_id,
+    const void *buf[])
+{
+    H5D_t **dsets = NULL;               /* Datasets to write */
+    const H5S_t **mem_spaces = NULL;    /* Memory dataspaces */
+    const H5S_t **file_spaces = NULL;   /* File dataspaces */
+    hbool_t direct_write = FALSE;       /* Whether direct chunk writes are set */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "z*i*i*i*ii**x", count, dset_id, mem_type_id, mem_space_id,
+             file_space_id, dxpl_id, buf);
+
+    /* Check arguments */
+    if(0 == count)
+        HGOTO_DONE(SUCCEED)
+    if(!dset_id || !mem_type_id || !mem_space_id || !file_space_id || !buf)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL argument array")
+    if(H5D__multi_args(count, dset_id, mem_space_id, file_space_id, &dsets, &mem_spaces, &file_spaces) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid arguments")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    /* Set DXPL for operation */
+    H5CX_set_dxpl(dxpl_id);
+
+    /* Direct chunk writes are for one dataset at a time */
+    if(H5CX_get_dcw_flag(&direct_write) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting flag for direct chunk write")
+    if(direct_write)
+        HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "direct chunk write not supported for several datasets")
+
+    /* Write raw data */
+    if(H5D__write_multi(count, dsets, mem_type_id, mem_spaces, file_spaces, buf) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
+
+done:
+    H5MM_xfree(dsets);
+    H5MM_xfree(mem_spaces);
+    H5MM_xfree(file_spaces);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dwrite_multi() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_args
+ *
+ * Purpose:	Checks the dataset and dataspace IDs given to
+ *		H5Dread_multi() or H5Dwrite_multi(), and returns arrays of
+ *		the objects they refer to, which the caller must free.
+ *		H5S_ALL dataspaces are returned as NULL.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_args(size_t count, const hid_t dset_id[], const hid_t mem_space_id[],
+    const hid_t file_space_id[], H5D_t ***dsets, const H5S_t ***mem_spaces,
+    const H5S_t ***file_spaces)
+{
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Allocate the arrays */
+    if(NULL == (*dsets = (H5D_t **)H5MM_calloc(count * sizeof(H5D_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for datasets")
+    if(NULL == (*mem_spaces = (const H5S_t **)H5MM_calloc(count * sizeof(H5S_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for dataspaces")
+    if(NULL == (*file_spaces = (const H5S_t **)H5MM_calloc(count * sizeof(H5S_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for dataspaces")
+
+    for(u = 0; u < count; u++) {
+        if(NULL == ((*dsets)[u] = (H5D_t *)H5I_object_verify(dset_id[u], H5I_DATASET)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+        if(NULL == (*dsets)[u]->oloc.file)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+        if(mem_space_id[u] < 0 || file_space_id[u] < 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+        if(H5S_ALL != mem_space_id[u]) {
+            if(NULL == ((*mem_spaces)[u] = (const H5S_t *)H5I_object_verify(mem_space_id[u], H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+            /* Check for valid selection */
+            if(H5S_SELECT_VALID((*mem_spaces)[u]) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "memory selection+offset not within extent")
+        } /* end if */
+        if(H5S_ALL != file_space_id[u]) {
+            if(NULL == ((*file_spaces)[u] = (const H5S_t *)H5I_object_verify(file_space_id[u], H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+            /* Check for valid selection */
+            if(H5S_SELECT_VALID((*file_spaces)[u]) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "file selection+offset not within extent")
+        } /* end if */
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_args() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__pre_read
+ *
+ * Purpose:     Preparation for reading data.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__pre_read(H5D_t *dset, hbool_t direct_read, hid_t mem_type_id,
+    const H5S_t *mem_space, const H5S_t *file_space, void *buf/*out*/)
+{
+    herr_t          ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE_VOL
+
     /* Set up for direct read of chunk, bypassing filters, etc. */
     if(direct_read) {
+        H5D_direct_chunk_batch_t *batch; /* Batch of chunks from calling routine */
         hsize_t *direct_offset;         /* Chunk offset from calling routine */
         hsize_t internal_offset[H5O_LAYOUT_NDIMS];      /* Internal copy of chunk offset */
         uint32_t direct_filters = 0;    /* Filters for chunk */
@@ -175,6 +544,15 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
         if(H5D_CHUNKED != dset->shared->layout.type)
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
 
+        /* Read a batch of raw chunks, if one was given */
+        if(H5CX_get_dc_batch(&batch) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting batch for direct chunk read")
+        if(batch) {
+            if(H5D__chunk_direct_read_batch(dset, batch) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read chunks directly")
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+
         /* Get the direct chunk offset */
         if(H5CX_get_dcr_offset(&direct_offset) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting offset for direct chunk read")
@@ -205,59 +583,223 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
         H5CX_set_dcr_filters(direct_filters);
     } /* end if */
     else
-        /* Read raw data */
-        if(H5D__read(dset, mem_type_id, mem_space, file_space, buf/*out*/) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+        /* Read raw data (H5D__read() reports its own errors, so the
+         * caller's error stack doesn't get the same frame twice) */
+        if(H5D__read(dset, mem_type_id, mem_space, file_space, buf/*out*/, NULL) < 0)
+            HGOTO_DONE(FAIL)
 
 done:
-    FUNC_LEAVE_API(ret_value)
-} /* end H5Dread() */
+    FUNC_LEAVE_NOAPI_VOL(ret_value)
+} /* end H5D__pre_read() */
+
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5Dwrite
+ * Function:    H5D__pre_write
  *
- * Purpose:	Writes (part of) a DSET from application memory BUF to the
- *		file.  The part of the dataset to write is defined with the
- *		MEM_SPACE_ID and FILE_SPACE_ID arguments. The data points
- *		are converted from their current type (MEM_TYPE_ID) to their
- *		file datatype.	 Additional miscellaneous data transfer
- *		properties can be passed to this function with the
- *		PLIST_ID argument.
+ * Purpose:     Preparation for writing data.
  *
- *		The FILE_SPACE_ID can be the constant H5S_ALL which indicates
- *		that the entire file dataspace is to be referenced.
+ * Return:      SUCCEED/FAIL
  *
- *		The MEM_SPACE_ID can be the constant H5S_ALL in which case
- *		the memory dataspace is the same as the file dataspace
- *		defined when the dataset was created.
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id, 
+    const H5S_t *mem_space, const H5S_t *file_space, const void *buf)
+{
+    herr_t                  ret_value = SUCCEED;  /* Return value */
+
+    FUNC_ENTER_PACKAGE_VOL
+
+    /* Direct chunk write */
+    if(direct_write) {
+        H5D_direct_chunk_batch_t *batch;
+        uint32_t direct_filters;
+        hsize_t *direct_offset;
+        uint32_t direct_datasize;
+        hsize_t  internal_offset[H5O_LAYOUT_NDIMS];
+        unsigned u;                 /* Local index variable */
+
+        if(H5D_CHUNKED != dset->shared->layout.type)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+        /* Write a batch of raw chunks, if one was given */
+        if(H5CX_get_dc_batch(&batch) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting batch for direct chunk write")
+        if(batch) {
+            if(H5D__chunk_direct_write_batch(dset, batch) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write chunks directly")
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+
+        /* Retrieve parameters for direct chunk write */
+        if(H5CX_get_dcw_filters(&direct_filters) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting filter info for direct chunk write")
+        if(H5CX_get_dcw_offset(&direct_offset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting offset info for direct chunk write")
+        if(H5CX_get_dcw_datasize(&direct_datasize) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting data size for direct chunk write")
+
+        /* The library's chunking code requires the offset terminates with a zero. So transfer the 
+         * offset array to an internal offset array */ 
+        for(u = 0; u < dset->shared->ndims; u++) {
+            /* Make sure the offset doesn't exceed the dataset's dimensions */
+            if(direct_offset[u] > dset->shared->curr_dims[u])
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset exceeds dimensions of dataset")
+
+            /* Make sure the offset fall right on a chunk's boundary */
+            if(direct_offset[u] % dset->shared->layout.u.chunk.dim[u])
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset doesn't fall on chunks's boundary")
+
+            internal_offset[u] = direct_offset[u]; 
+        } /* end for */
+	   
+	/* Terminate the offset with a zero */ 
+	internal_offset[dset->shared->ndims] = 0;
+
+	/* write raw data */
+	if(H5D__chunk_direct_write(dset, direct_filters, internal_offset, direct_datasize, buf) < 0)
+	    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write chunk directly")
+    } /* end if */
+    else
+        /* Normal write of raw data */
+        if(H5D__write(dset, mem_type_id, mem_space, file_space, buf, NULL) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
+
+done:
+    FUNC_LEAVE_NOAPI_VOL(ret_value)
+} /* end H5D__pre_write() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dread_async
  *
- *		The number of elements in the memory dataspace must match
- *		the number of elements in the file dataspace.
+ * Purpose:	Asynchronous version of H5Dread.  The read is queued in
+ *		the event set ES_ID and may still be in progress when this
+ *		call returns; BUF must not be used until H5ESwait reports
+ *		the operation complete.  The dataspaces and transfer
+ *		property list are copied, so they may be modified or
+ *		closed right away, as may the dataset.
+ *
+ *		If ES_ID is H5ES_NONE the read is performed synchronously,
+ *		as with H5Dread.
+ *
+ * Return:	Non-negative on success/Negative on failure.  Errors
+ *		raised while the queued read runs are recorded in the
+ *		event set instead.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dread_async(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
+    hid_t file_space_id, hid_t dxpl_id, void *buf/*out*/, hid_t es_id)
+{
+    H5D_t	    *dset = NULL;
+    const H5S_t	    *mem_space = NULL;
+    const H5S_t	    *file_space = NULL;
+    H5ES_t          *es = NULL;
+    hbool_t         direct_read = FALSE;
+    herr_t          ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "iiiiixi", dset_id, mem_type_id, mem_space_id,
+             file_space_id, dxpl_id, buf, es_id);
+
+    /* check arguments */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(NULL == dset->oloc.file)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+    if(mem_space_id < 0 || file_space_id < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+    if(H5S_ALL != mem_space_id) {
+	if(NULL == (mem_space = (const H5S_t *)H5I_object_verify(mem_space_id, H5I_DATASPACE)))
+	    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+        /* Check for valid selection */
+        if(H5S_SELECT_VALID(mem_space) != TRUE)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "selection+offset not within extent")
+    } /* end if */
+
+    if(H5S_ALL != file_space_id) {
+	if(NULL == (file_space = (const H5S_t *)H5I_object_verify(file_space_id, H5I_DATASPACE)))
+	    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+        /* Check for valid selection */
+        if(H5S_SELECT_VALID(file_space) != TRUE)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "selection+offset not within extent")
+    } /* end if */
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    if(H5ES_NONE != es_id)
+        if(NULL == (es = (H5ES_t *)H5I_object_verify(es_id, H5I_EVENTSET)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an event set")
+
+    if(es) {
+        /* Queue the read in the event set */
+        if(H5D__io_async(es, FALSE, dset_id, mem_type_id, mem_space, file_space, dxpl_id, buf, NULL) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't queue read in event set")
+    } /* end if */
+    else {
+        /* Set DXPL for operation */
+        H5CX_set_dxpl(dxpl_id);
+
+        /* Retrieve the 'direct read' flag */
+        if(H5CX_get_dcr_flag(&direct_read) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting flag for direct chunk read")
+
+        if(H5D__pre_read(dset, direct_read, mem_type_id, mem_space, file_space, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+    } /* end else */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dread_async() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dwrite_async
  *
- *		The PLIST_ID can be the constant H5P_DEFAULT in which
- *		case the default data transfer properties are used.
+ * Purpose:	Asynchronous version of H5Dwrite.  The write is queued in
+ *		the event set ES_ID and may still be in progress when this
+ *		call returns; BUF must not be modified or freed until
+ *		H5ESwait reports the operation complete.  The dataspaces
+ *		and transfer property list are copied, so they may be
+ *		modified or closed right away, as may the dataset.
  *
- * Return:	Non-negative on success/Negative on failure
+ *		If ES_ID is H5ES_NONE the write is performed synchronously,
+ *		as with H5Dwrite.
  *
- * Programmer:	Robb Matzke
- *		Thursday, December  4, 1997
+ * Return:	Non-negative on success/Negative on failure.  Errors
+ *		raised while the queued write runs are recorded in the
+ *		event set instead.
  *
  *-------------------------------------------------------------------------
  */
 herr_t
-H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
-    hid_t file_space_id, hid_t dxpl_id, const void *buf)
+H5Dwrite_async(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
+    hid_t file_space_id, hid_t dxpl_id, const void *buf, hid_t es_id)
 {
     H5D_t		   *dset = NULL;
     const H5S_t            *mem_space = NULL;
     const H5S_t            *file_space = NULL;
+    H5ES_t                 *es = NULL;
     hbool_t                 direct_write = FALSE;
     herr_t                  ret_value = SUCCEED;  /* Return value */
 
     FUNC_ENTER_API(FAIL)
-    H5TRACE6("e", "iiiii*x", dset_id, mem_type_id, mem_space_id, file_space_id,
-             dxpl_id, buf);
+    H5TRACE7("e", "iiiii*xi", dset_id, mem_type_id, mem_space_id,
+             file_space_id, dxpl_id, buf, es_id);
 
     /* check arguments */
     if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
@@ -272,6 +814,10 @@ H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
         if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
 
+    if(H5ES_NONE != es_id)
+        if(NULL == (es = (H5ES_t *)H5I_object_verify(es_id, H5I_EVENTSET)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an event set")
+
     /* Set DXPL for operation */
     H5CX_set_dxpl(dxpl_id);
 
@@ -296,85 +842,186 @@ H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
             if(NULL == (file_space = (const H5S_t *)H5I_object_verify(file_space_id, H5I_DATASPACE)))
                 HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
 
-	    /* Check for valid selection */
-	    if(H5S_SELECT_VALID(file_space) != TRUE)
-		HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "file selection+offset not within extent")
-	} /* end if */
+            /* Check for valid selection */
+            if(H5S_SELECT_VALID(file_space) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "file selection+offset not within extent")
+        } /* end if */
     } /* end if */
 
-    if(H5D__pre_write(dset, direct_write, mem_type_id, mem_space, file_space, buf) < 0) 
-        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't prepare for writing data")
+    if(es) {
+        /* Queue the write in the event set */
+        if(H5D__io_async(es, TRUE, dset_id, mem_type_id, mem_space, file_space, dxpl_id, NULL, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't queue write in event set")
+    } /* end if */
+    else
+        if(H5D__pre_write(dset, direct_write, mem_type_id, mem_space, file_space, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't prepare for writing data")
 
 done:
     FUNC_LEAVE_API(ret_value)
-} /* end H5Dwrite() */
+} /* end H5Dwrite_async() */
+
 
 
 /*-------------------------------------------------------------------------
- * Function:    H5D__pre_write
+ * Function:	H5D__io_async
  *
- * Purpose:     Preparation for writing data.
+ * Purpose:	Capture the arguments of a dataset read or write and queue
+ *		it in an event set.  References are held on the dataset
+ *		and memory datatype IDs, and the dataspaces and transfer
+ *		property list are copied, so the application may release
+ *		all of them before the operation runs.
  *
- * Return:      SUCCEED/FAIL
+ * Return:	Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
-herr_t
-H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id, 
-    const H5S_t *mem_space, const H5S_t *file_space, const void *buf)
+static herr_t
+H5D__io_async(H5ES_t *es, hbool_t do_write, hid_t dset_id, hid_t mem_type_id,
+    const H5S_t *mem_space, const H5S_t *file_space, hid_t dxpl_id,
+    void *rbuf, const void *wbuf)
 {
-    herr_t                  ret_value = SUCCEED;  /* Return value */
+    H5D_async_io_t *op = NULL;          /* Queued operation */
+    H5P_genplist_t *plist;              /* Transfer property list */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-    FUNC_ENTER_PACKAGE_VOL
+    FUNC_ENTER_STATIC
 
-    /* Direct chunk write */
-    if(direct_write) {
-        uint32_t direct_filters;
-        hsize_t *direct_offset;
-        uint32_t direct_datasize;
-        hsize_t  internal_offset[H5O_LAYOUT_NDIMS];
-        unsigned u;                 /* Local index variable */
+    /* Sanity checks */
+    HDassert(es);
+
+    /* Allocate the operation; IDs start out invalid so a partially set up
+     * operation can be released */
+    if(NULL == (op = H5FL_CALLOC(H5D_async_io_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for asynchronous I/O")
+    op->do_write = do_write;
+    op->dset_id = H5I_INVALID_HID;
+    op->mem_type_id = H5I_INVALID_HID;
+    op->dxpl_id = H5I_INVALID_HID;
+    op->rbuf = rbuf;
+    op->wbuf = wbuf;
+
+    /* Hold the dataset and memory datatype open until the operation runs */
+    if(H5I_inc_ref(dset_id, FALSE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINC, FAIL, "can't increment dataset ID reference count")
+    op->dset_id = dset_id;
+    if(H5I_inc_ref(mem_type_id, FALSE) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINC, FAIL, "can't increment datatype ID reference count")
+    op->mem_type_id = mem_type_id;
+
+    /* Copy the dataspaces, which the application may change right away */
+    if(mem_space && NULL == (op->mem_space = H5S_copy(mem_space, FALSE, TRUE)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "can't copy memory dataspace")
+    if(file_space && NULL == (op->file_space = H5S_copy(file_space, FALSE, TRUE)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "can't copy file dataspace")
+
+    /* Copy the transfer property list */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a property list")
+    if((op->dxpl_id = H5P_copy_plist(plist, FALSE)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTCOPY, FAIL, "can't copy transfer property list")
+
+    /* Queue the operation; the event set owns it from here on */
+    if(H5ES_insert(es, H5D__io_async_exec, H5D__io_async_release, op) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't insert operation in event set")
+    op = NULL;
 
-        if(H5D_CHUNKED != dset->shared->layout.type)
-            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+done:
+    if(op && H5D__io_async_release(op) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't release asynchronous I/O operation")
 
-        /* Retrieve parameters for direct chunk write */
-        if(H5CX_get_dcw_filters(&direct_filters) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting filter info for direct chunk write")
-        if(H5CX_get_dcw_offset(&direct_offset) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting offset info for direct chunk write")
-        if(H5CX_get_dcw_datasize(&direct_datasize) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting data size for direct chunk write")
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_async() */
 
-        /* The library's chunking code requires the offset terminates with a zero. So transfer the 
-         * offset array to an internal offset array */ 
-        for(u = 0; u < dset->shared->ndims; u++) {
-            /* Make sure the offset doesn't exceed the dataset's dimensions */
-            if(direct_offset[u] > dset->shared->curr_dims[u])
-                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset exceeds dimensions of dataset")
 
-            /* Make sure the offset fall right on a chunk's boundary */
-            if(direct_offset[u] % dset->shared->layout.u.chunk.dim[u])
-                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset doesn't fall on chunks's boundary")
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_async_exec
+ *
+ * Purpose:	Event set callback that performs a queued dataset read or
+ *		write.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__io_async_exec(void *op_data)
+{
+    H5D_async_io_t *op = (H5D_async_io_t *)op_data;    /* Queued operation */
+    H5D_t *dset;                        /* Dataset */
+    hbool_t direct = FALSE;             /* Whether the I/O is a direct chunk operation */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-            internal_offset[u] = direct_offset[u]; 
-        } /* end for */
-	   
-	/* Terminate the offset with a zero */ 
-	internal_offset[dset->shared->ndims] = 0;
+    FUNC_ENTER_STATIC
 
-	/* write raw data */
-	if(H5D__chunk_direct_write(dset, direct_filters, internal_offset, direct_datasize, buf) < 0)
-	    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write chunk directly")
-    } /* end if */
-    else
-        /* Normal write of raw data */
-        if(H5D__write(dset, mem_type_id, mem_space, file_space, buf) < 0)
+    /* Sanity check */
+    HDassert(op);
+
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(op->dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+    /* Set DXPL for operation */
+    H5CX_set_dxpl(op->dxpl_id);
+
+    if(op->do_write) {
+        /* Retrieve the 'direct write' flag */
+        if(H5CX_get_dcw_flag(&direct) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting flag for direct chunk write")
+
+        if(H5D__pre_write(dset, direct, op->mem_type_id, op->mem_space, op->file_space, op->wbuf) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
+    } /* end if */
+    else {
+        /* Retrieve the 'direct read' flag */
+        if(H5CX_get_dcr_flag(&direct) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error getting flag for direct chunk read")
+
+        if(H5D__pre_read(dset, direct, op->mem_type_id, op->mem_space, op->file_space, op->rbuf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+    } /* end else */
 
 done:
-    FUNC_LEAVE_NOAPI_VOL(ret_value)
-} /* end H5D__pre_write() */
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_async_exec() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_async_release
+ *
+ * Purpose:	Event set callback that releases the copies and references
+ *		held by a queued dataset read or write.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__io_async_release(void *op_data)
+{
+    H5D_async_io_t *op = (H5D_async_io_t *)op_data;    /* Queued operation */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(op);
+
+    if(op->mem_space && H5S_close(op->mem_space) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "can't close memory dataspace")
+    if(op->file_space && H5S_close(op->file_space) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "can't close file dataspace")
+    if(op->dxpl_id >= 0 && H5I_dec_ref(op->dxpl_id) < 0)
+        HDONE_ERROR(H5E_PLIST, H5E_CANTDEC, FAIL, "can't close transfer property list")
+    if(op->mem_type_id >= 0 && H5I_dec_ref(op->mem_type_id) < 0)
+        HDONE_ERROR(H5E_DATATYPE, H5E_CANTDEC, FAIL, "can't decrement datatype ID reference count")
+    if(op->dset_id >= 0 && H5I_dec_ref(op->dset_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't decrement dataset ID reference count")
+    op = H5FL_FREE(H5D_async_io_t, op);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_async_release() */
 
 
 /*-------------------------------------------------------------------------
@@ -383,6 +1030,10 @@ done:
  * Purpose:	Reads (part of) a DATASET into application memory BUF. See
  *		H5Dread() for complete details.
  *
+ *		If VEC is not NULL, reads of contiguous raw data which go
+ *		straight into BUF are only added to VEC, and are performed
+ *		when the caller flushes it.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Robb Matzke
@@ -392,7 +1043,7 @@ done:
  */
 herr_t
 H5D__read(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
-    const H5S_t *file_space, void *buf/*out*/)
+    const H5S_t *file_space, void *buf/*out*/, H5D_io_vec_t *vec)
 {
     H5D_chunk_map_t *fm = NULL;         /* Chunk file<->memory mapping */
     H5D_io_info_t io_info;              /* Dataset I/O info     */
@@ -544,6 +1195,17 @@ H5D__read(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
     if(H5D__ioinfo_init(dataset, &type_info, &store, &io_info) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "unable to set up I/O operation")
 
+    /* Gather the reads into the caller's vector, if there's no data to
+     * convert on the way.  (A dirty sieve buffer holds newer data than
+     * the file, so write it out first.)
+     */
+    if(vec && type_info.is_conv_noop && type_info.is_xform_noop
+            && !H5F_HAS_FEATURE(dataset->oloc.file, H5FD_FEAT_HAS_MPI)) {
+        if(H5D__flush_sieve_buf(dataset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush sieve buffer")
+        io_info.vec = vec;
+    } /* end if */
+
     /* Sanity check that space is allocated, if there are elements */
     if(nelmts > 0)
         HDassert((*dataset->shared->layout.ops->is_space_alloc)(&dataset->shared->layout.storage)
@@ -595,6 +1257,10 @@ done:
  * Purpose:	Writes (part of) a DATASET to a file from application memory
  *		BUF. See H5Dwrite() for complete details.
  *
+ *		If VEC is not NULL, writes of contiguous raw data which come
+ *		straight from BUF are only added to VEC, and are performed
+ *		when the caller flushes it.  BUF must stay valid until then.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Robb Matzke
@@ -604,7 +1270,7 @@ done:
  */
 herr_t
 H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
-    const H5S_t *file_space, const void *buf)
+    const H5S_t *file_space, const void *buf, H5D_io_vec_t *vec)
 {
     H5D_chunk_map_t *fm = NULL;         /* Chunk file<->memory mapping */
     H5D_io_info_t io_info;              /* Dataset I/O info     */
@@ -756,6 +1422,19 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
     if(H5D__ioinfo_init(dataset, &type_info, &store, &io_info) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up I/O operation")
 
+    /* Gather the writes into the caller's vector, if there's no data to
+     * convert on the way.  (The sieve buffer may hold data the writes
+     * replace, so write it out and drop it first.)
+     */
+    if(vec && type_info.is_conv_noop && type_info.is_xform_noop
+            && !H5F_HAS_FEATURE(dataset->oloc.file, H5FD_FEAT_HAS_MPI)) {
+        if(H5D__flush_sieve_buf(dataset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush sieve buffer")
+        dataset->shared->cache.contig.sieve_loc = HADDR_UNDEF;
+        dataset->shared->cache.contig.sieve_size = 0;
+        io_info.vec = vec;
+    } /* end if */
+
     /* Allocate dataspace and initialize it if it hasn't been. */
     if(nelmts > 0 && dataset->shared->dcpl_cache.efl.nused == 0 &&
             !(*dataset->shared->layout.ops->is_space_alloc)(&dataset->shared->layout.storage)) {
@@ -833,6 +1512,352 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value)
 } /* end H5D__write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__read_multi
+ *
+ * Purpose:	Reads (part of) several datasets into application memory.
+ *		See H5Dread_multi() for complete details.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__read_multi(size_t count, H5D_t *dsets[], const hid_t mem_type_ids[],
+    const H5S_t *mem_spaces[], const H5S_t *file_spaces[], void *bufs[])
+{
+    H5D_io_vec_t vec;                   /* Reads gathered across datasets */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_VOL
+
+    HDmemset(&vec, 0, sizeof(vec));
+    vec.op_type = H5D_IO_OP_READ;
+
+    for(u = 0; u < count; u++) {
+        /* Each file's reads are gathered separately */
+        if(vec.file && !H5F_SAME_SHARED(vec.file, dsets[u]->oloc.file))
+            if(H5D__io_vec_flush(&vec) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read gathered data")
+        vec.file = dsets[u]->oloc.file;
+
+        if(H5D__read(dsets[u], mem_type_ids[u], mem_spaces[u], file_spaces[u], bufs[u], &vec) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+    } /* end for */
+
+    /* Read the gathered data */
+    if(H5D__io_vec_flush(&vec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read gathered data")
+
+done:
+    H5D__io_vec_free(&vec);
+
+    FUNC_LEAVE_NOAPI_VOL(ret_value)
+} /* end H5D__read_multi() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_cmp_shared
+ *
+ * Purpose:	Compare two datasets by their shared information, for
+ *		HDqsort().
+ *
+ * Return:	An integer less than, equal to or greater than zero
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__multi_cmp_shared(const void *_dset1, const void *_dset2)
+{
+    const H5D_shared_t *shared1 = (*(const H5D_t * const *)_dset1)->shared;
+    const H5D_shared_t *shared2 = (*(const H5D_t * const *)_dset2)->shared;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    FUNC_LEAVE_NOAPI((shared1 > shared2) - (shared1 < shared2))
+} /* end H5D__multi_cmp_shared() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__write_multi
+ *
+ * Purpose:	Writes (part of) several datasets from application memory.
+ *		See H5Dwrite_multi() for complete details.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__write_multi(size_t count, H5D_t *dsets[], const hid_t mem_type_ids[],
+    const H5S_t *mem_spaces[], const H5S_t *file_spaces[], const void *bufs[])
+{
+    H5D_io_vec_t vec;                   /* Writes gathered across datasets */
+    H5D_t **sorted = NULL;              /* Datasets, sorted to find repeats */
+    hbool_t repeats = FALSE;            /* Whether a dataset appears more than once */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_VOL
+
+    HDmemset(&vec, 0, sizeof(vec));
+    vec.op_type = H5D_IO_OP_WRITE;
+
+    /* Check whether any dataset is written more than once.  The gathered
+     * writes are reordered, so if one is, each dataset's writes are
+     * performed before the next dataset's, to keep the last write of an
+     * element the one which is stored.
+     */
+    if(count > 1) {
+        if(NULL == (sorted = (H5D_t **)H5MM_malloc(count * sizeof(H5D_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for datasets")
+        HDmemcpy(sorted, dsets, count * sizeof(H5D_t *));
+        HDqsort(sorted, count, sizeof(H5D_t *), H5D__multi_cmp_shared);
+        for(u = 1; u < count; u++)
+            if(sorted[u]->shared == sorted[u - 1]->shared) {
+                repeats = TRUE;
+                break;
+            } /* end if */
+    } /* end if */
+
+    for(u = 0; u < count; u++) {
+        /* Each file's writes are gathered separately */
+        if(vec.file && (repeats || !H5F_SAME_SHARED(vec.file, dsets[u]->oloc.file)))
+            if(H5D__io_vec_flush(&vec) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write gathered data")
+        vec.file = dsets[u]->oloc.file;
+
+        if(H5D__write(dsets[u], mem_type_ids[u], mem_spaces[u], file_spaces[u], bufs[u], &vec) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
+    } /* end for */
+
+    /* Write the gathered data */
+    if(H5D__io_vec_flush(&vec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write gathered data")
+
+done:
+    H5D__io_vec_free(&vec);
+    H5MM_xfree(sorted);
+
+    FUNC_LEAVE_NOAPI_VOL(ret_value)
+} /* end H5D__write_multi() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_reserve
+ *
+ * Purpose:	Makes room for NENTRIES more entries in a gathered I/O
+ *		vector.  A vector which has grown large is flushed first.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__io_vec_reserve(H5D_io_vec_t *vec, size_t nentries)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(vec);
+
+    /* Flush the vector if it's full enough */
+    if(vec->count > 0 && (vec->count + nentries) > H5D_IO_VEC_MAX_ENTRIES)
+        if(H5D__io_vec_flush(vec) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "can't flush I/O vector")
+
+    /* Extend the vector, if needed */
+    if((vec->count + nentries) > vec->alloc) {
+        size_t new_alloc = MAX(vec->count + nentries, 2 * vec->alloc);  /* New # of entries */
+        void *tmp;                      /* Reallocated array */
+
+        if(NULL == (tmp = H5MM_realloc(vec->types, new_alloc * sizeof(H5FD_mem_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        vec->types = (H5FD_mem_t *)tmp;
+        if(NULL == (tmp = H5MM_realloc(vec->addrs, new_alloc * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        vec->addrs = (haddr_t *)tmp;
+        if(NULL == (tmp = H5MM_realloc(vec->sizes, new_alloc * sizeof(size_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        vec->sizes = (size_t *)tmp;
+        if(NULL == (tmp = H5MM_realloc(vec->bufs.rbufs, new_alloc * sizeof(void *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        vec->bufs.rbufs = (void **)tmp;
+        vec->alloc = new_alloc;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_vec_reserve() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_cmp
+ *
+ * Purpose:	Compare two entries of a gathered I/O vector by file
+ *		address, and then by position in the vector, for HDqsort().
+ *
+ * Return:	An integer less than, equal to or greater than zero
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__io_vec_cmp(const void *_ent1, const void *_ent2)
+{
+    const H5D_io_vec_sort_t *ent1 = (const H5D_io_vec_sort_t *)_ent1;
+    const H5D_io_vec_sort_t *ent2 = (const H5D_io_vec_sort_t *)_ent2;
+    int ret_value;                      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(H5F_addr_lt(ent1->addr, ent2->addr))
+        ret_value = -1;
+    else if(H5F_addr_gt(ent1->addr, ent2->addr))
+        ret_value = 1;
+    else
+        ret_value = (ent1->idx > ent2->idx) - (ent1->idx < ent2->idx);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_vec_cmp() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_flush
+ *
+ * Purpose:	Performs the I/O gathered in a vector, in file address
+ *		order, and empties the vector.  Entries at the same address
+ *		are performed in the order they were added.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__io_vec_flush(H5D_io_vec_t *vec)
+{
+    H5D_io_vec_sort_t *order = NULL;    /* Entries, sorted by address */
+    H5FD_mem_t *types = NULL;           /* Sorted memory types */
+    haddr_t *addrs = NULL;              /* Sorted file addresses */
+    size_t *sizes = NULL;               /* Sorted sizes */
+    void **bufs = NULL;                 /* Sorted buffers */
+    uint32_t count;                     /* # of entries in the vector */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(vec);
+
+    if(0 == vec->count)
+        HGOTO_DONE(SUCCEED)
+    HDassert(vec->file);
+
+    /* Sort the entries by address, if they aren't in order already */
+    for(u = 1; u < vec->count; u++)
+        if(H5F_addr_lt(vec->addrs[u], vec->addrs[u - 1]))
+            break;
+    if(u < vec->count) {
+        if(NULL == (order = (H5D_io_vec_sort_t *)H5MM_malloc(vec->count * sizeof(H5D_io_vec_sort_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (types = (H5FD_mem_t *)H5MM_malloc(vec->alloc * sizeof(H5FD_mem_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (addrs = (haddr_t *)H5MM_malloc(vec->alloc * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (sizes = (size_t *)H5MM_malloc(vec->alloc * sizeof(size_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (bufs = (void **)H5MM_malloc(vec->alloc * sizeof(void *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+
+        for(u = 0; u < vec->count; u++) {
+            order[u].addr = vec->addrs[u];
+            order[u].idx = u;
+        } /* end for */
+        HDqsort(order, vec->count, sizeof(H5D_io_vec_sort_t), H5D__io_vec_cmp);
+        for(u = 0; u < vec->count; u++) {
+            types[u] = vec->types[order[u].idx];
+            addrs[u] = vec->addrs[order[u].idx];
+            sizes[u] = vec->sizes[order[u].idx];
+            bufs[u] = vec->bufs.rbufs[order[u].idx];
+        } /* end for */
+
+        /* Swap the sorted arrays into the vector */
+        H5MM_xfree(vec->types);
+        vec->types = types;
+        types = NULL;
+        H5MM_xfree(vec->addrs);
+        vec->addrs = addrs;
+        addrs = NULL;
+        H5MM_xfree(vec->sizes);
+        vec->sizes = sizes;
+        sizes = NULL;
+        H5MM_xfree(vec->bufs.rbufs);
+        vec->bufs.rbufs = bufs;
+        bufs = NULL;
+    } /* end if */
+
+    /* Perform the I/O */
+    H5_CHECKED_ASSIGN(count, uint32_t, vec->count, size_t);
+    if(H5D_IO_OP_READ == vec->op_type) {
+        if(H5F_block_read_vector(vec->file, count, vec->types, vec->addrs, vec->sizes, vec->bufs.rbufs) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "vector read failed")
+    } /* end if */
+    else {
+        if(H5F_block_write_vector(vec->file, count, vec->types, vec->addrs, vec->sizes, vec->bufs.wbufs) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "vector write failed")
+    } /* end else */
+
+done:
+    /* The entries have been dealt with, even if the I/O failed */
+    vec->count = 0;
+
+    H5MM_xfree(order);
+    H5MM_xfree(types);
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_vec_flush() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_free
+ *
+ * Purpose:	Releases the memory of a gathered I/O vector, without
+ *		performing any I/O left in it.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5D__io_vec_free(H5D_io_vec_t *vec)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity check */
+    HDassert(vec);
+
+    vec->types = (H5FD_mem_t *)H5MM_xfree(vec->types);
+    vec->addrs = (haddr_t *)H5MM_xfree(vec->addrs);
+    vec->sizes = (size_t *)H5MM_xfree(vec->sizes);
+    vec->bufs.rbufs = (void **)H5MM_xfree(vec->bufs.rbufs);
+    vec->alloc = vec->count = 0;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__io_vec_free() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__ioinfo_init
@@ -863,6 +1888,7 @@ H5D__ioinfo_init(H5D_t *dset, const H5D_type_info_t *type_info,
     /* Set up "normal" I/O fields */
     io_info->dset = dset;
     io_info->store = store;
+    io_info->vec = NULL;
 
     /* Set I/O operations to initial values */
     io_info->layout_ops = *dset->shared->layout.ops;
@@ -127,6 +127,10 @@ H5D__layout_set_io_ops(const H5D_t *dataset)
                     dataset->shared->layout.storage.u.chunk.ops = H5D_COPS_BT2;
                     break;
 
+                case H5D_CHUNK_IDX_SHARD:
+                    dataset->shared->layout.storage.u.chunk.ops = H5D_COPS_SHARD;
+                    break;
+
                 case H5D_CHUNK_IDX_NTYPES:
                 default:
                     HDassert(0 && "Unknown chunk index method!");
@@ -258,6 +262,11 @@ H5D__layout_meta_size(const H5F_t *f, const H5O_layout_t *layout, hbool_t includ
                         ret_value += H5D_BT2_CREATE_PARAM_SIZE;
                         break;
 
+                    case H5D_CHUNK_IDX_SHARD:
+                        /* v2 B-tree creation parameters & shard dimensions */
+                        ret_value += H5D_SHARD_CREATE_PARAM_SIZE(layout->u.chunk.ndims - 1);
+                        break;
+
                     case H5D_CHUNK_IDX_NTYPES:
                     default:
                         HGOTO_ERROR(H5E_OHDR, H5E_CANTENCODE, 0, "Invalid chunk index type")
@@ -311,7 +320,7 @@ H5D__layout_set_version(H5F_t *f, H5O_layout_t *layout)
     version = MAX(layout->version, H5O_layout_ver_bounds[H5F_LOW_BOUND(f)]);
 
     /* Version bounds check */
-    if(version > H5O_layout_ver_bounds[H5F_HIGH_BOUND(f)])
+    if(version > H5D_LAYOUT_MAX_VERSION(f))
         HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "layout version out of bounds")
 
     /* Set the message version */
@@ -377,8 +386,27 @@ H5D__layout_set_latest_indexing(H5O_layout_t *layout, const H5S_t *space,
                     single = FALSE;
             } /* end for */
 
+            /* Sharded datasets keep the index requested for them */
+            if(H5D_CHUNK_IDX_SHARD == layout->u.chunk.idx_type) {
+                layout->storage.u.chunk.idx_type = H5D_CHUNK_IDX_SHARD;
+                layout->storage.u.chunk.ops = H5D_COPS_SHARD;
+
+                /* Set the creation parameters for the v2 B-tree of shards */
+                layout->u.chunk.u.shard.btree2.cparam.node_size = H5D_BT2_NODE_SIZE;
+                layout->u.chunk.u.shard.btree2.cparam.split_percent = H5D_BT2_SPLIT_PERC;
+                layout->u.chunk.u.shard.btree2.cparam.merge_percent = H5D_BT2_MERGE_PERC;
+            } /* end if */
+            /* Datasets asking for an implicit index get it when they can
+             * have one: their chunks must all fit in a block of fixed size,
+             * allocated when they're created */
+            else if(H5D_CHUNK_IDX_NONE == layout->u.chunk.idx_type && !unlim_count
+                    && !dcpl_cache->pline.nused
+                    && dcpl_cache->fill.alloc_time == H5D_ALLOC_TIME_EARLY) {
+                layout->storage.u.chunk.idx_type = H5D_CHUNK_IDX_NONE;
+                layout->storage.u.chunk.ops = H5D_COPS_NONE;
+            } /* end else-if */
             /* Chunked datasets with unlimited dimension(s) */
-            if(unlim_count) { /* dataset with unlimited dimension(s) must be chunked */
+            else if(unlim_count) { /* dataset with unlimited dimension(s) must be chunked */
                 if(1 == unlim_count) { /* Chunked dataset with only 1 unlimited dimension */
                     /* Set the chunk index type to an extensible array */
                     layout->u.chunk.idx_type = H5D_CHUNK_IDX_EARRAY;
@@ -49,11 +49,13 @@
     (io_info)->dset = ds;                                               \
     (io_info)->store = str;                                             \
     (io_info)->op_type = H5D_IO_OP_WRITE;                               \
+    (io_info)->vec = NULL;                                              \
     (io_info)->u.wbuf = buf
 #define H5D_BUILD_IO_INFO_RD(io_info, ds, str, buf)                     \
     (io_info)->dset = ds;                                               \
     (io_info)->store = str;                                             \
     (io_info)->op_type = H5D_IO_OP_READ;                                \
+    (io_info)->vec = NULL;                                              \
     (io_info)->u.rbuf = buf
 
 /* Flags for marking aspects of a dataset dirty */
@@ -81,6 +83,15 @@
 #define H5D_BT2_SPLIT_PERC          100
 #define H5D_BT2_MERGE_PERC          40
 
+/* Sharded index creation values */
+#define H5D_SHARD_CREATE_PARAM_SIZE(ndims) (H5D_BT2_CREATE_PARAM_SIZE + 4 * (ndims)) /* v2 B-tree parameters + shard dims */
+
+/* Highest layout message version allowed by a file's high bound (the
+ * sharded index's version is beyond the latest version of the format
+ * chosen by the bounds, and only allowed with a high bound of "latest") */
+#define H5D_LAYOUT_MAX_VERSION(f) (H5F_LIBVER_LATEST == H5F_HIGH_BOUND(f) ? \
+        H5O_LAYOUT_VERSION_5 : H5O_layout_ver_bounds[H5F_HIGH_BOUND(f)])
+
 
 /****************************/
 /* Package Private Typedefs */
@@ -202,6 +213,21 @@ typedef enum H5D_io_op_type_t {
     H5D_IO_OP_WRITE         /* Write operation */
 } H5D_io_op_type_t;
 
+/* Raw data I/O requests gathered into vectors for the file layer */
+typedef struct H5D_io_vec_t {
+    H5F_t *file;                /* File the requests are for */
+    H5D_io_op_type_t op_type;   /* Whether the requests are reads or writes */
+    size_t alloc;               /* # of entries allocated in the vectors */
+    size_t count;               /* # of entries used in the vectors */
+    H5FD_mem_t *types;          /* Memory type for each entry */
+    haddr_t *addrs;             /* File address for each entry */
+    size_t *sizes;              /* Size of each entry */
+    union {
+        void **rbufs;           /* Buffer to fill for each entry */
+        const void **wbufs;     /* Buffer to write for each entry */
+    } bufs;
+} H5D_io_vec_t;
+
 typedef struct H5D_io_info_t {
     const H5D_t *dset;          /* Pointer to dataset being operated on */
 #ifdef H5_HAVE_PARALLEL
@@ -212,6 +238,7 @@ typedef struct H5D_io_info_t {
     H5D_layout_ops_t layout_ops;    /* Dataset layout I/O operation function pointers */
     H5D_io_ops_t io_ops;        /* I/O operation function pointers */
     H5D_io_op_type_t op_type;
+    H5D_io_vec_t *vec;          /* Vector to gather contiguous raw data I/O into, or NULL to perform it at once */
     union {
         void *rbuf;             /* Pointer to buffer for read */
         const void *wbuf;       /* Pointer to buffer to write */
@@ -284,6 +311,9 @@ typedef herr_t (*H5D_chunk_create_func_t)(const H5D_chk_idx_info_t *idx_info);
 typedef hbool_t (*H5D_chunk_is_space_alloc_func_t)(const H5O_storage_chunk_t *storage);
 typedef herr_t (*H5D_chunk_insert_func_t)(const H5D_chk_idx_info_t *idx_info,
     H5D_chunk_ud_t *udata, const H5D_t *dset);
+typedef herr_t (*H5D_chunk_bulk_begin_func_t)(const H5D_chk_idx_info_t *idx_info,
+    hsize_t nchunks);
+typedef herr_t (*H5D_chunk_bulk_end_func_t)(const H5D_chk_idx_info_t *idx_info);
 typedef herr_t (*H5D_chunk_get_addr_func_t)(const H5D_chk_idx_info_t *idx_info,
     H5D_chunk_ud_t *udata);
 typedef herr_t (*H5D_chunk_resize_func_t)(H5O_layout_chunk_t *layout);
@@ -310,6 +340,8 @@ typedef struct H5D_chunk_ops_t {
     H5D_chunk_create_func_t create;         /* Routine to create chunk index */
     H5D_chunk_is_space_alloc_func_t is_space_alloc;    /* Query routine to determine if storage/index is allocated */
     H5D_chunk_insert_func_t insert;         /* Routine to insert a chunk into an index */
+    H5D_chunk_bulk_begin_func_t bulk_begin; /* Routine to announce new chunks about to be inserted in index order (optional) */
+    H5D_chunk_bulk_end_func_t bulk_end;     /* Routine to finish inserting the announced chunks (optional) */
     H5D_chunk_get_addr_func_t get_addr;     /* Routine to retrieve address of chunk in file */
     H5D_chunk_resize_func_t resize;         /* Routine to update chunk index info after resizing dataset */
     H5D_chunk_iterate_func_t iterate;       /* Routine to iterate over chunks */
@@ -387,23 +419,47 @@ typedef struct H5D_virtual_held_file_t {
 
 /* The raw data chunk cache */
 struct H5D_rdcc_ent_t;  /* Forward declaration of struct used below */
+struct H5D_rdcc_pool_t; /* Forward declaration of struct used below */
 typedef struct H5D_rdcc_t {
     struct {
-        unsigned    ninits;    /* Number of chunk creations        */
-        unsigned    nhits;     /* Number of cache hits            */
-        unsigned    nmisses;   /* Number of cache misses        */
-        unsigned    nflushes;  /* Number of cache flushes        */
+        hsize_t     ninits;    /* Number of chunk creations        */
+        hsize_t     nhits;     /* Number of cache hits            */
+        hsize_t     nmisses;   /* Number of cache misses        */
+        hsize_t     nflushes;  /* Number of cache flushes        */
+        hsize_t     nevict_clean; /* Number of clean chunks preempted */
+        hsize_t     nevict_dirty; /* Number of dirty chunks preempted */
+        hsize_t     nbytes_read; /* Bytes of chunks read from the file */
+        hsize_t     nbytes_unfiltered; /* Bytes of chunks produced by the reverse filter pipeline */
+        double      filter_time; /* Seconds spent in the filter pipeline */
     } stats;
     size_t        nbytes_max;  /* Maximum cached raw data in bytes    */
-    size_t        nslots;      /* Number of chunk slots allocated    */
+    size_t        nslots;      /* Number of chunk slots requested    */
     double        w0;          /* Chunk preemption policy          */
     struct H5D_rdcc_ent_t *head; /* Head of doubly linked list        */
     struct H5D_rdcc_ent_t *tail; /* Tail of doubly linked list        */
-    struct H5D_rdcc_ent_t *tmp_head; /* Head of temporary doubly linked list.  Chunks on this list are not in the hash table (slot).  The head entry is a sentinel (does not refer to an actual chunk). */
     size_t        nbytes_used;  /* Current cached raw data in bytes */
     int           nused;        /* Number of chunk slots in use        */
     H5D_chunk_cached_t last;    /* Cached copy of last chunk information */
     struct H5D_rdcc_ent_t **slot; /* Chunk slots, each points to a chunk*/
+    size_t        nslots_alloc; /* Number of chunk slots allocated (open addressed hash table, grows past nslots as needed) */
+    size_t        nslots_deleted; /* Number of slots marked as deleted */
+    struct H5D_rdcc_pool_t *pool; /* Byte budget shared with the file's other chunk caches, or NULL */
+    const H5D_t   *pool_dset;   /* Dataset to flush entries through when the pool preempts them, or NULL */
+    unsigned      read_ahead;   /* Max. # of chunks to read ahead of sequential or strided reads */
+    hsize_t       ra_last_idx;  /* Index of the chunk read last, or HSIZE_UNDEF */
+    hssize_t      ra_stride;    /* Distance to the chunk read last from the one read before it */
+    struct {
+        size_t    max_nbytes;   /* Largest size the cache may grow to, or 0 if its size is fixed */
+        size_t    min_nbytes;   /* Smallest size it may shrink to */
+        unsigned  epoch;        /* Current epoch (entries remember the last one they were used in) */
+        unsigned  naccesses;    /* # of chunk accesses so far in the epoch */
+        hsize_t   nhits;        /* stats.nhits at the start of the epoch */
+        unsigned  nghost_hits;  /* # of misses in the epoch on chunks in GHOSTS */
+        size_t    nbytes_touched; /* Bytes of the entries used in the epoch */
+        hsize_t   *ghosts;      /* Ring of the indices of the chunks preempted last */
+        unsigned  nghosts;      /* # of chunks in GHOSTS */
+        unsigned  ghost_next;   /* Position in GHOSTS for the next chunk preempted */
+    } autosize;
     H5SL_t        *sel_chunks;    /* Skip list containing information for each chunk selected */
     H5S_t         *single_space;  /* Dataspace for single element I/O on chunks */
     H5D_chunk_info_t    *single_chunk_info;  /* Pointer to single chunk's info */
@@ -537,6 +593,7 @@ H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_SINGLE[1];
 H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_EARRAY[1];
 H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_FARRAY[1];
 H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_BT2[1];
+H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_SHARD[1];
 
 /* The v2 B-tree class for indexing chunked datasets with >1 unlimited dimensions */
 H5_DLLVAR const H5B2_class_t H5D_BT2[1];
@@ -566,13 +623,18 @@ H5_DLL herr_t H5D__alloc_storage(const H5D_io_info_t *io_info, H5D_time_alloc_t
 H5_DLL herr_t H5D__get_storage_size(const H5D_t *dset, hsize_t *storage_size);
 H5_DLL herr_t H5D__get_chunk_storage_size(H5D_t *dset, const hsize_t *offset,
     hsize_t *storage_size);
+H5_DLL herr_t H5D__get_num_chunks(H5D_t *dset, H5S_t *space, hsize_t *nchunks);
+H5_DLL herr_t H5D__get_chunk_cache_stats(const H5D_t *dset, H5D_chunk_cache_stats_t *stats);
+H5_DLL herr_t H5D__get_chunk_info(H5D_t *dset, H5S_t *space, hsize_t chk_idx,
+    hsize_t *offset, unsigned *filter_mask, haddr_t *addr, hsize_t *size);
+H5_DLL herr_t H5D__chunk_iter(H5D_t *dset, H5D_chunk_iter_op_t op, void *op_data);
 H5_DLL haddr_t H5D__get_offset(const H5D_t *dset);
 H5_DLL void *H5D__vlen_get_buf_size_alloc(size_t size, void *info);
 H5_DLL herr_t H5D__vlen_get_buf_size(void *elem, hid_t type_id, unsigned ndim,
     const hsize_t *point, void *op_data);
 H5_DLL herr_t H5D__check_filters(H5D_t *dataset);
 H5_DLL herr_t H5D__set_extent(H5D_t *dataset, const hsize_t *size);
-H5_DLL herr_t H5D__flush_sieve_buf(H5D_t *dataset);
+H5_DLL herr_t H5D__flush_sieve_buf(const H5D_t *dataset);
 H5_DLL herr_t H5D__flush_real(H5D_t *dataset);
 H5_DLL herr_t H5D__flush(H5D_t *dset, hid_t dset_id);
 H5_DLL hid_t H5D__get_create_plist(const H5D_t *dset);
@@ -583,12 +645,25 @@ H5_DLL herr_t H5D__refresh(hid_t dset_id, H5D_t *dataset);
 H5_DLL herr_t H5D__format_convert(H5D_t *dataset);
 
 /* Internal I/O routines */
+H5_DLL herr_t H5D__pre_read(H5D_t *dset, hbool_t direct_read, hid_t mem_type_id,
+    const H5S_t *mem_space, const H5S_t *file_space, void *buf/*out*/);
 H5_DLL herr_t H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id,
     const H5S_t *mem_space, const H5S_t *file_space, const void *buf);
 H5_DLL herr_t H5D__read(H5D_t *dataset, hid_t mem_type_id,
-    const H5S_t *mem_space, const H5S_t *file_space, void *buf/*out*/);
+    const H5S_t *mem_space, const H5S_t *file_space, void *buf/*out*/,
+    H5D_io_vec_t *vec);
 H5_DLL herr_t H5D__write(H5D_t *dataset, hid_t mem_type_id,
-    const H5S_t *mem_space, const H5S_t *file_space, const void *buf);
+    const H5S_t *mem_space, const H5S_t *file_space, const void *buf,
+    H5D_io_vec_t *vec);
+H5_DLL herr_t H5D__read_multi(size_t count, H5D_t *dsets[],
+    const hid_t mem_type_ids[], const H5S_t *mem_spaces[],
+    const H5S_t *file_spaces[], void *bufs[]/*out*/);
+H5_DLL herr_t H5D__write_multi(size_t count, H5D_t *dsets[],
+    const hid_t mem_type_ids[], const H5S_t *mem_spaces[],
+    const H5S_t *file_spaces[], const void *bufs[]);
+H5_DLL herr_t H5D__io_vec_reserve(H5D_io_vec_t *vec, size_t nentries);
+H5_DLL herr_t H5D__io_vec_flush(H5D_io_vec_t *vec);
+H5_DLL void H5D__io_vec_free(H5D_io_vec_t *vec);
 
 /* Functions that perform direct serial I/O operations */
 H5_DLL herr_t H5D__select_read(const H5D_io_info_t *io_info,
@@ -657,6 +732,7 @@ H5_DLL herr_t H5D__chunk_set_sizes(H5D_t *dset);
 H5_DLL herr_t H5D__chunk_addrmap(const H5D_io_info_t *io_info, haddr_t chunk_addr[]);
 #endif /* H5_HAVE_PARALLEL */
 H5_DLL herr_t H5D__chunk_update_cache(H5D_t *dset);
+H5_DLL herr_t H5D__chunk_pool_detach(H5D_t *dset);
 H5_DLL herr_t H5D__chunk_copy(H5F_t *f_src, H5O_storage_chunk_t *storage_src,
     H5O_layout_chunk_t *layout_src, H5F_t *f_dst, H5O_storage_chunk_t *storage_dst,
     const H5S_extent_t *ds_extent_src, const H5T_t *dt_src,
@@ -669,10 +745,18 @@ H5_DLL herr_t H5D__chunk_direct_write(const H5D_t *dset, uint32_t filters,
          hsize_t *offset, uint32_t data_size, const void *buf);
 H5_DLL herr_t H5D__chunk_direct_read(const H5D_t *dset, hsize_t *offset,
          uint32_t *filters, void *buf);
+H5_DLL herr_t H5D__chunk_direct_write_batch(const H5D_t *dset,
+         const H5D_direct_chunk_batch_t *batch);
+H5_DLL herr_t H5D__chunk_direct_read_batch(const H5D_t *dset,
+         const H5D_direct_chunk_batch_t *batch);
 #ifdef H5D_CHUNK_DEBUG
 H5_DLL herr_t H5D__chunk_stats(const H5D_t *dset, hbool_t headers);
 #endif /* H5D_CHUNK_DEBUG */
 
+/* Function that places chunks inside the shards of a sharded index */
+H5_DLL herr_t H5D__shard_alloc_chunk(const H5D_chk_idx_info_t *idx_info,
+    const hsize_t scaled[], H5F_block_t *new_chunk);
+
 /* format convert */
 H5_DLL herr_t H5D__chunk_format_convert(H5D_t *dset, H5D_chk_idx_info_t *idx_info, H5D_chk_idx_info_t *new_idx_info);
 
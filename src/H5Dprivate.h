@@ -55,6 +55,8 @@
 #define H5D_ACS_VDS_PREFIX_NAME             "vds_prefix"     /* VDS file prefix */
 #define H5D_ACS_APPEND_FLUSH_NAME           "append_flush"   /* Append flush actions */
 #define H5D_ACS_EFILE_PREFIX_NAME           "external file prefix" /* External file prefix */
+#define H5D_ACS_CHUNK_READ_AHEAD_NAME       "chunk_read_ahead" /* # of chunks to read ahead of sequential access */
+#define H5D_ACS_CHUNK_CACHE_AUTO_NAME       "chunk_cache_auto" /* Largest size the chunk cache may grow to automatically */
 
 /* ======== Data transfer properties ======== */
 #define H5D_XFER_MAX_TEMP_BUF_NAME      "max_temp_buf"  /* Maximum temp buffer size */
@@ -69,6 +71,8 @@
 #define H5D_XFER_VFL_ID_NAME            "vfl_id"        /* File driver ID */
 #define H5D_XFER_VFL_INFO_NAME          "vfl_info"      /* File driver info */
 #define H5D_XFER_HYPER_VECTOR_SIZE_NAME "vec_size"      /* Hyperslab vector size */
+#define H5D_XFER_FILTER_THREADS_NAME    "filter_threads" /* # of threads for the filter pipeline */
+#define H5D_XFER_CHUNK_CACHE_BYPASS_NAME "chunk_cache_bypass" /* Whether reads of whole chunks bypass the chunk cache */
 #define H5D_XFER_IO_XFER_MODE_NAME      "io_xfer_mode"  /* I/O transfer mode */
 #define H5D_XFER_MPIO_COLLECTIVE_OPT_NAME "mpio_collective_opt" /* Optimization of MPI-IO transfer mode */
 #define H5D_XFER_MPIO_CHUNK_OPT_HARD_NAME "mpio_chunk_opt_hard"
@@ -45,6 +45,9 @@
 #define H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME        "direct_chunk_read_flag"
 #define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME      "direct_chunk_read_offset"
 #define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME     "direct_chunk_read_filters"
+
+/* Property name for H5DOwrite_chunks and H5DOread_chunks */
+#define H5D_XFER_DIRECT_CHUNK_BATCH_NAME            "direct_chunk_batch"
  
 /*******************/
 /* Public Typedefs */
@@ -69,6 +72,7 @@ typedef enum H5D_chunk_index_t {
     H5D_CHUNK_IDX_FARRAY = 3,   /* Fixed array (for 0 unlimited dims)       */
     H5D_CHUNK_IDX_EARRAY = 4,   /* Extensible array (for 1 unlimited dim)   */
     H5D_CHUNK_IDX_BT2 = 5,      /* v2 B-tree index (for >1 unlimited dims)  */
+    H5D_CHUNK_IDX_SHARD = 6,    /* v2 B-tree of shards, each holding many chunks */
     H5D_CHUNK_IDX_NTYPES        /* This one must be last!                   */
 } H5D_chunk_index_t;
 
@@ -115,6 +119,28 @@ typedef enum H5D_vds_view_t {
 /* Callback for H5Pset_append_flush() in a dataset access property list */
 typedef herr_t (*H5D_append_cb_t)(hid_t dataset_id, hsize_t *cur_dims, void *op_data);
 
+/* Batch of chunks for H5DOwrite_chunks and H5DOread_chunks */
+typedef struct H5D_direct_chunk_batch_t {
+    size_t nchunks;             /* Number of chunks in the batch */
+    const hsize_t *offsets;     /* Logical offsets of the chunks (nchunks * rank values) */
+    const uint32_t *filters;    /* Filter masks of the chunks to write (may be NULL) */
+    const size_t *sizes;        /* Sizes of the chunks to write, in bytes */
+    const void * const *wbufs;  /* Data for the chunks to write */
+    uint32_t *filters_out;      /* Filter masks of the chunks read */
+    void * const *rbufs;        /* Buffers for the chunks read */
+} H5D_direct_chunk_batch_t;
+
+/* Statistics of a dataset's chunk cache, for H5Dget_chunk_cache_stats */
+typedef struct H5D_chunk_cache_stats_t {
+    hsize_t hits;               /* Chunk accesses found in the cache */
+    hsize_t misses;             /* Chunks read into the cache from the file */
+    hsize_t evictions_clean;    /* Clean chunks preempted from the cache */
+    hsize_t evictions_dirty;    /* Dirty chunks written out and preempted from the cache */
+    hsize_t bytes_read;         /* Bytes of chunks read from the file */
+    hsize_t bytes_decompressed; /* Bytes of chunks produced by unfiltering */
+    double filter_time;         /* Seconds spent in the filter pipeline, both ways */
+} H5D_chunk_cache_stats_t;
+
 /********************/
 /* Public Variables */
 /********************/
@@ -139,6 +165,10 @@ typedef herr_t (*H5D_scatter_func_t)(const void **src_buf/*out*/,
 typedef herr_t (*H5D_gather_func_t)(const void *dst_buf,
                                     size_t dst_buf_bytes_used, void *op_data);
 
+/* Define the operator function pointer for H5Dchunk_iter() */
+typedef int (*H5D_chunk_iter_op_t)(const hsize_t *offset, unsigned filter_mask,
+                                   haddr_t addr, hsize_t size, void *op_data);
+
 H5_DLL hid_t H5Dcreate2(hid_t loc_id, const char *name, hid_t type_id,
     hid_t space_id, hid_t lcpl_id, hid_t dcpl_id, hid_t dapl_id);
 H5_DLL hid_t H5Dcreate_anon(hid_t file_id, hid_t type_id, hid_t space_id,
@@ -152,11 +182,27 @@ H5_DLL hid_t H5Dget_create_plist(hid_t dset_id);
 H5_DLL hid_t H5Dget_access_plist(hid_t dset_id);
 H5_DLL hsize_t H5Dget_storage_size(hid_t dset_id);
 H5_DLL herr_t H5Dget_chunk_storage_size(hid_t dset_id, const hsize_t *offset, hsize_t *chunk_bytes);
+H5_DLL herr_t H5Dget_num_chunks(hid_t dset_id, hid_t fspace_id, hsize_t *nchunks);
+H5_DLL herr_t H5Dget_chunk_info(hid_t dset_id, hid_t fspace_id, hsize_t chk_idx,
+    hsize_t *offset, unsigned *filter_mask, haddr_t *addr, hsize_t *size);
+H5_DLL herr_t H5Dget_chunk_cache_stats(hid_t dset_id, H5D_chunk_cache_stats_t *stats);
+H5_DLL herr_t H5Dchunk_iter(hid_t dset_id, hid_t dxpl_id, H5D_chunk_iter_op_t op,
+    void *op_data);
 H5_DLL haddr_t H5Dget_offset(hid_t dset_id);
 H5_DLL herr_t H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			hid_t file_space_id, hid_t plist_id, void *buf/*out*/);
 H5_DLL herr_t H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			 hid_t file_space_id, hid_t plist_id, const void *buf);
+H5_DLL herr_t H5Dread_multi(size_t count, const hid_t dset_id[],
+    const hid_t mem_type_id[], const hid_t mem_space_id[],
+    const hid_t file_space_id[], hid_t dxpl_id, void *buf[]/*out*/);
+H5_DLL herr_t H5Dwrite_multi(size_t count, const hid_t dset_id[],
+    const hid_t mem_type_id[], const hid_t mem_space_id[],
+    const hid_t file_space_id[], hid_t dxpl_id, const void *buf[]);
+H5_DLL herr_t H5Dread_async(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
+    hid_t file_space_id, hid_t plist_id, void *buf/*out*/, hid_t es_id);
+H5_DLL herr_t H5Dwrite_async(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
+    hid_t file_space_id, hid_t plist_id, const void *buf, hid_t es_id);
 H5_DLL herr_t H5Diterate(void *buf, hid_t type_id, hid_t space_id,
             H5D_operator_t op, void *operator_data);
 H5_DLL herr_t H5Dvlen_reclaim(hid_t type_id, hid_t space_id, hid_t plist_id, void *buf);
@@ -0,0 +1,1720 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Sharded chunked I/O functions.
+ *		Neighboring chunks are grouped into "shards".  Each shard
+ *		has an offset table (address, size and filter mask of every
+ *		chunk in the shard), which is a checksummed metadata cache
+ *		entry.  The unfiltered chunks of a shard share one block
+ *		in the file, with a slot for each chunk.  Filtered chunks
+ *		are allocated at their actual size and keep their location
+ *		when they are rewritten no larger.
+ *		The shards themselves are indexed with a v2 B-tree, so the
+ *		index only holds one record per shard instead of one per
+ *		chunk.
+ *
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5Dmodule.h"          /* This source code file is part of the H5D module */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Dpkg.h"		/* Datasets				*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5FLprivate.h"	/* Free Lists                           */
+#include "H5MFprivate.h"	/* File space management		*/
+#include "H5VMprivate.h"        /* Vector functions			*/
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Version of the shard offset table */
+#define H5D_SHARD_TABLE_VERSION     0
+
+/* Size of an encoded offset table entry */
+#define H5D_SHARD_ENTRY_SIZE(f)     ((size_t)H5F_SIZEOF_ADDR(f) + 4 + 4)
+
+/* Size of an encoded offset table */
+#define H5D_SHARD_TABLE_SIZE(f, nchunks) (                                    \
+    /* General metadata fields */                                            \
+    H5_SIZEOF_MAGIC     /* Signature */                                       \
+    + 1                 /* Version */                                         \
+    + H5_SIZEOF_CHKSUM  /* Checksum */                                        \
+                                                                              \
+    /* Offset table specific fields */                                        \
+    + (size_t)H5F_SIZEOF_ADDR(f) /* Address of block of unfiltered chunks */  \
+    + (size_t)(nchunks) * H5D_SHARD_ENTRY_SIZE(f) /* Chunk entries */         \
+    )
+
+/* Number of shard addresses remembered for each dataset */
+#define H5D_SHARD_CACHE_NSLOTS      4
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/* Shape of the shards of a dataset */
+typedef struct H5D_shard_geom_t {
+    unsigned    ndims;                  /* Rank of the dataset */
+    hsize_t     nchunks;                /* # of chunks in a shard */
+    size_t      table_size;             /* Size of the offset table of a shard */
+    hsize_t     down[H5O_LAYOUT_NDIMS]; /* "down" size of # of chunks in each shard dimension */
+} H5D_shard_geom_t;
+
+/* Decoded offset table entry */
+typedef struct H5D_shard_rec_t {
+    haddr_t     addr;                   /* Address of chunk (undefined if not allocated) */
+    uint32_t    nbytes;                 /* Size of chunk in the file */
+    uint32_t    filter_mask;            /* Excluded filters */
+} H5D_shard_rec_t;
+
+/* Offset table of a shard, as held in the metadata cache */
+typedef struct H5D_shard_table_t {
+    /* Information for H5AC cache functions, _must_ be first field in structure */
+    H5AC_info_t cache_info;
+
+    hsize_t     nchunks;                /* # of chunks in the shard */
+    size_t      size;                   /* Size of the table on disk */
+    haddr_t     data_addr;              /* Address of block of unfiltered chunks (undefined if none) */
+    H5D_shard_rec_t *recs;              /* Offset table entries */
+} H5D_shard_table_t;
+
+/* Callback info for loading a shard offset table into the cache */
+typedef struct H5D_shard_table_ud_t {
+    H5F_t      *f;                      /* File that offset table is within */
+    hsize_t     nchunks;                /* # of chunks in the shard */
+} H5D_shard_table_ud_t;
+
+/* Address of a shard's offset table, remembered for a dataset */
+typedef struct H5D_shard_ent_t {
+    hsize_t     scaled[H5O_LAYOUT_NDIMS]; /* Scaled coordinates of the shard */
+    haddr_t     addr;                   /* Address of the offset table */
+} H5D_shard_ent_t;
+
+/* Recently used shards, most recently used first */
+struct H5D_shard_cache_t {
+    unsigned    nused;                  /* # of shards in cache */
+    H5D_shard_ent_t ent[H5D_SHARD_CACHE_NSLOTS]; /* Shards */
+};
+typedef struct H5D_shard_cache_t H5D_shard_cache_t;
+
+/* Index information for the v2 B-tree of shards */
+typedef struct H5D_shard_inner_t {
+    H5D_chk_idx_info_t idx_info;        /* Index info for the v2 B-tree */
+    H5O_pline_t pline;                  /* Empty pipeline (shards are never filtered) */
+    H5O_layout_chunk_t layout;          /* "Chunk" layout of a shard */
+    H5O_storage_chunk_t storage;        /* v2 B-tree storage */
+} H5D_shard_inner_t;
+
+/* User data for iterating over the chunks in all shards */
+typedef struct H5D_shard_it_ud_t {
+    H5F_t *f;                           /* File pointer for operation */
+    const H5O_layout_chunk_t *layout;   /* Chunk layout description */
+    const H5D_shard_geom_t *geom;       /* Shape of the shards */
+    H5D_shard_rec_t *recs;              /* Copy of offset table */
+    H5D_chunk_cb_func_t cb;             /* Chunk callback routine */
+    void *udata;                        /* User data for chunk callback routine */
+    hbool_t delete_shards;              /* Whether to delete the shards instead */
+    hsize_t nshards;                    /* # of shards visited */
+} H5D_shard_it_ud_t;
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Sharded chunking I/O ops */
+static herr_t H5D__shard_idx_init(const H5D_chk_idx_info_t *idx_info,
+    const H5S_t *space, haddr_t dset_ohdr_addr);
+static herr_t H5D__shard_idx_create(const H5D_chk_idx_info_t *idx_info);
+static hbool_t H5D__shard_idx_is_space_alloc(const H5O_storage_chunk_t *storage);
+static herr_t H5D__shard_idx_insert(const H5D_chk_idx_info_t *idx_info,
+    H5D_chunk_ud_t *udata, const H5D_t *dset);
+static herr_t H5D__shard_idx_get_addr(const H5D_chk_idx_info_t *idx_info,
+    H5D_chunk_ud_t *udata);
+static int H5D__shard_idx_iterate(const H5D_chk_idx_info_t *idx_info,
+    H5D_chunk_cb_func_t chunk_cb, void *chunk_udata);
+static herr_t H5D__shard_idx_remove(const H5D_chk_idx_info_t *idx_info,
+    H5D_chunk_common_ud_t *udata);
+static herr_t H5D__shard_idx_delete(const H5D_chk_idx_info_t *idx_info);
+static herr_t H5D__shard_idx_copy_setup(const H5D_chk_idx_info_t *idx_info_src,
+    const H5D_chk_idx_info_t *idx_info_dst);
+static herr_t H5D__shard_idx_copy_shutdown(H5O_storage_chunk_t *storage_src,
+    H5O_storage_chunk_t *storage_dst);
+static herr_t H5D__shard_idx_size(const H5D_chk_idx_info_t *idx_info,
+    hsize_t *size);
+static herr_t H5D__shard_idx_reset(H5O_storage_chunk_t *storage, hbool_t reset_addr);
+static herr_t H5D__shard_idx_dump(const H5O_storage_chunk_t *storage, FILE *stream);
+static herr_t H5D__shard_idx_dest(const H5D_chk_idx_info_t *idx_info);
+
+/* Metadata cache (H5AC) callbacks for shard offset tables */
+static herr_t H5D__shard_table_get_initial_load_size(void *udata, size_t *image_len);
+static htri_t H5D__shard_table_verify_chksum(const void *image_ptr, size_t len,
+    void *udata_ptr);
+static void *H5D__shard_table_deserialize(const void *image, size_t len,
+    void *udata, hbool_t *dirty);
+static herr_t H5D__shard_table_image_len(const void *thing, size_t *image_len);
+static herr_t H5D__shard_table_serialize(const H5F_t *f, void *image,
+    size_t len, void *thing);
+static herr_t H5D__shard_table_free_icr(void *thing);
+
+/* Helper routines */
+static void H5D__shard_geom(const H5F_t *f, const H5O_layout_chunk_t *layout,
+    H5D_shard_geom_t *geom);
+static hsize_t H5D__shard_locate(const H5O_layout_chunk_t *layout,
+    const H5D_shard_geom_t *geom, const hsize_t scaled[], hsize_t shard_scaled[]);
+static void H5D__shard_inner_storage(const H5O_storage_chunk_t *storage,
+    H5O_storage_chunk_t *inner_storage);
+static void H5D__shard_inner_init(const H5D_chk_idx_info_t *idx_info,
+    const H5D_shard_geom_t *geom, H5D_shard_inner_t *inner);
+static void H5D__shard_inner_sync(const H5O_storage_chunk_t *inner_storage,
+    H5O_storage_chunk_t *storage);
+static H5D_shard_table_t *H5D__shard_table_new(hsize_t nchunks, size_t size);
+static H5D_shard_table_t *H5D__shard_table_protect(H5F_t *f,
+    const H5D_shard_geom_t *geom, haddr_t addr, unsigned flags);
+static herr_t H5D__shard_lookup(const H5D_chk_idx_info_t *idx_info,
+    const H5D_shard_geom_t *geom, const hsize_t shard_scaled[], hbool_t create,
+    unsigned flags, H5D_shard_table_t **table);
+static herr_t H5D__shard_table_free_chunks(H5F_t *f,
+    const H5O_layout_chunk_t *layout, const H5D_shard_table_t *table);
+static void H5D__shard_cache_dest(H5O_storage_chunk_t *storage);
+static int H5D__shard_iterate_cb(const H5D_chunk_rec_t *shard_rec, void *_udata);
+
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+/* Sharded chunk I/O ops */
+const H5D_chunk_ops_t H5D_COPS_SHARD[1] = {{
+    FALSE,                              /* Sharded indices don't currently support SWMR access */
+    H5D__shard_idx_init,                /* init */
+    H5D__shard_idx_create,              /* create */
+    H5D__shard_idx_is_space_alloc,      /* is_space_alloc */
+    H5D__shard_idx_insert,              /* insert */
+    NULL,                               /* bulk_begin */
+    NULL,                               /* bulk_end */
+    H5D__shard_idx_get_addr,            /* get_addr */
+    NULL,                               /* resize */
+    H5D__shard_idx_iterate,             /* iterate */
+    H5D__shard_idx_remove,              /* remove */
+    H5D__shard_idx_delete,              /* delete */
+    H5D__shard_idx_copy_setup,          /* copy_setup */
+    H5D__shard_idx_copy_shutdown,       /* copy_shutdown */
+    H5D__shard_idx_size,                /* size */
+    H5D__shard_idx_reset,               /* reset */
+    H5D__shard_idx_dump,                /* dump */
+    H5D__shard_idx_dest                 /* destroy */
+}};
+
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+/* H5D shard offset table inherits cache-like properties from H5AC */
+const H5AC_class_t H5AC_DSHARD[1] = {{
+    H5AC_DSHARD_ID,                     /* Metadata client ID */
+    "dataset shard offset table",       /* Metadata client name (for debugging) */
+    H5FD_MEM_BTREE,                     /* File space memory type for client */
+    H5AC__CLASS_NO_FLAGS_SET,           /* Client class behavior flags */
+    H5D__shard_table_get_initial_load_size, /* 'get_initial_load_size' callback */
+    NULL,                               /* 'get_final_load_size' callback */
+    H5D__shard_table_verify_chksum,     /* 'verify_chksum' callback */
+    H5D__shard_table_deserialize,       /* 'deserialize' callback */
+    H5D__shard_table_image_len,         /* 'image_len' callback */
+    NULL,                               /* 'pre_serialize' callback */
+    H5D__shard_table_serialize,         /* 'serialize' callback */
+    NULL,                               /* 'notify' callback */
+    H5D__shard_table_free_icr,          /* 'free_icr' callback */
+    NULL,                               /* 'fsf_size' callback */
+}};
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Declare a free list to manage the H5D_shard_cache_t struct */
+H5FL_DEFINE_STATIC(H5D_shard_cache_t);
+
+/* Declare a free list to manage the H5D_shard_table_t struct */
+H5FL_DEFINE_STATIC(H5D_shard_table_t);
+
+/* Declare a free list to manage sequences of H5D_shard_rec_t */
+H5FL_SEQ_DEFINE_STATIC(H5D_shard_rec_t);
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_table_get_initial_load_size
+ *
+ * Purpose:	Compute the size of the data structure on disk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_table_get_initial_load_size(void *_udata, size_t *image_len)
+{
+    const H5D_shard_table_ud_t *udata = (const H5D_shard_table_ud_t *)_udata; /* User data for callback */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check arguments */
+    HDassert(udata);
+    HDassert(udata->f);
+    HDassert(udata->nchunks > 0);
+    HDassert(image_len);
+
+    /* Set the image length size */
+    *image_len = H5D_SHARD_TABLE_SIZE(udata->f, udata->nchunks);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__shard_table_get_initial_load_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_table_verify_chksum
+ *
+ * Purpose:	Verify the computed checksum of the data structure is the
+ *		same as the stored chksum.
+ *
+ * Return:	Success:        TRUE/FALSE
+ *		Failure:        Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__shard_table_verify_chksum(const void *_image, size_t len, void H5_ATTR_UNUSED *_udata)
+{
+    const uint8_t *image = (const uint8_t *)_image; /* Pointer into raw data buffer */
+    uint32_t stored_chksum;             /* Stored metadata checksum value */
+    uint32_t computed_chksum;           /* Computed metadata checksum value */
+    htri_t ret_value = TRUE;            /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check arguments */
+    HDassert(image);
+
+    /* Get stored and computed checksums */
+    H5F_get_checksums(image, len, &stored_chksum, &computed_chksum);
+
+    if(stored_chksum != computed_chksum)
+        ret_value = FALSE;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_table_verify_chksum() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_table_deserialize
+ *
+ * Purpose:	Loads a shard offset table from the disk.
+ *
+ * Return:	Success:	Pointer to a new shard offset table
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__shard_table_deserialize(const void *_image, size_t len,
+    void *_udata, hbool_t H5_ATTR_UNUSED *dirty)
+{
+    H5D_shard_table_t *table = NULL;    /* Shard offset table */
+    H5D_shard_table_ud_t *udata = (H5D_shard_table_ud_t *)_udata; /* User data for callback */
+    const uint8_t *image = (const uint8_t *)_image; /* Pointer into raw data buffer */
+    hsize_t u;                          /* Local index variable */
+    void *ret_value = NULL;             /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check arguments */
+    HDassert(image);
+    HDassert(udata);
+    HDassert(udata->f);
+    HDassert(len == H5D_SHARD_TABLE_SIZE(udata->f, udata->nchunks));
+    HDassert(dirty);
+
+    /* Allocate the offset table */
+    if(NULL == (table = H5D__shard_table_new(udata->nchunks, len)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate shard offset table")
+
+    /* Magic number */
+    if(HDmemcmp(image, H5D_SHARD_MAGIC, (size_t)H5_SIZEOF_MAGIC))
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, NULL, "wrong shard offset table signature")
+    image += H5_SIZEOF_MAGIC;
+
+    /* Version */
+    if(*image++ != H5D_SHARD_TABLE_VERSION)
+        HGOTO_ERROR(H5E_DATASET, H5E_VERSION, NULL, "wrong shard offset table version")
+
+    /* Address of block of unfiltered chunks */
+    H5F_addr_decode(udata->f, &image, &table->data_addr);
+
+    /* Chunk entries */
+    for(u = 0; u < table->nchunks; u++) {
+        H5F_addr_decode(udata->f, &image, &table->recs[u].addr);
+        UINT32DECODE(image, table->recs[u].nbytes);
+        UINT32DECODE(image, table->recs[u].filter_mask);
+    } /* end for */
+
+    /* checksum verification already done in verify_chksum cb */
+
+    /* Sanity check */
+    HDassert((size_t)(image - (const uint8_t *)_image) + H5_SIZEOF_CHKSUM == len);
+
+    /* Set return value */
+    ret_value = table;
+
+done:
+    if(!ret_value && table)
+        if(H5D__shard_table_free_icr(table) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, NULL, "unable to destroy shard offset table")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_table_deserialize() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_table_image_len
+ *
+ * Purpose:	Compute the size of the data structure on disk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_table_image_len(const void *_thing, size_t *image_len)
+{
+    const H5D_shard_table_t *table = (const H5D_shard_table_t *)_thing; /* Shard offset table */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check arguments */
+    HDassert(table);
+    HDassert(table->cache_info.type == H5AC_DSHARD);
+    HDassert(image_len);
+
+    *image_len = table->size;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__shard_table_image_len() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_table_serialize
+ *
+ * Purpose:	Flush a shard offset table to the image buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_table_serialize(const H5F_t *f, void *_image, size_t len,
+    void *_thing)
+{
+    H5D_shard_table_t *table = (H5D_shard_table_t *)_thing; /* Shard offset table */
+    uint8_t *image = (uint8_t *)_image; /* Pointer into raw data buffer */
+    uint32_t metadata_chksum;           /* Computed metadata checksum value */
+    hsize_t u;                          /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check arguments */
+    HDassert(f);
+    HDassert(image);
+    HDassert(table);
+    HDassert(len == H5D_SHARD_TABLE_SIZE(f, table->nchunks));
+
+    /* Magic number */
+    HDmemcpy(image, H5D_SHARD_MAGIC, (size_t)H5_SIZEOF_MAGIC);
+    image += H5_SIZEOF_MAGIC;
+
+    /* Version # */
+    *image++ = H5D_SHARD_TABLE_VERSION;
+
+    /* Address of block of unfiltered chunks */
+    H5F_addr_encode(f, &image, table->data_addr);
+
+    /* Chunk entries */
+    for(u = 0; u < table->nchunks; u++) {
+        H5F_addr_encode(f, &image, table->recs[u].addr);
+        UINT32ENCODE(image, table->recs[u].nbytes);
+        UINT32ENCODE(image, table->recs[u].filter_mask);
+    } /* end for */
+
+    /* Compute metadata checksum */
+    metadata_chksum = H5_checksum_metadata(_image, (size_t)(image - (uint8_t *)_image), 0);
+
+    /* Metadata checksum */
+    UINT32ENCODE(image, metadata_chksum);
+
+    /* Sanity check */
+    HDassert((size_t)(image - (uint8_t *)_image) == len);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__shard_table_serialize() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_table_free_icr
+ *
+ * Purpose:	Destroy/release an "in core representation" of a shard
+ *		offset table.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_table_free_icr(void *_thing)
+{
+    H5D_shard_table_t *table = (H5D_shard_table_t *)_thing; /* Shard offset table */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check arguments */
+    HDassert(table);
+
+    if(table->recs)
+        table->recs = H5FL_SEQ_FREE(H5D_shard_rec_t, table->recs);
+    table = H5FL_FREE(H5D_shard_table_t, table);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__shard_table_free_icr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_geom
+ *
+ * Purpose:	Compute the shape of the shards of a dataset.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__shard_geom(const H5F_t *f, const H5O_layout_chunk_t *layout,
+    H5D_shard_geom_t *geom)
+{
+    unsigned u;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(layout);
+    HDassert(layout->ndims > 1);
+    HDassert(geom);
+
+    geom->ndims = layout->ndims - 1;
+
+    /* Chunks in a shard are stored in row-major order */
+    geom->nchunks = 1;
+    for(u = geom->ndims; u > 0; u--) {
+        geom->down[u - 1] = geom->nchunks;
+        geom->nchunks *= layout->u.shard.shard_dim[u - 1];
+    } /* end for */
+
+    geom->table_size = H5D_SHARD_TABLE_SIZE(f, geom->nchunks);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__shard_geom() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_locate
+ *
+ * Purpose:	Compute the scaled coordinates of the shard holding a chunk.
+ *
+ * Return:	Index of the chunk within its shard
+ *
+ *-------------------------------------------------------------------------
+ */
+static hsize_t
+H5D__shard_locate(const H5O_layout_chunk_t *layout, const H5D_shard_geom_t *geom,
+    const hsize_t scaled[], hsize_t shard_scaled[])
+{
+    hsize_t local = 0;                  /* Index of chunk in shard */
+    unsigned u;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < geom->ndims; u++) {
+        shard_scaled[u] = scaled[u] / layout->u.shard.shard_dim[u];
+        local += (scaled[u] % layout->u.shard.shard_dim[u]) * geom->down[u];
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(local)
+} /* end H5D__shard_locate() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_inner_storage
+ *
+ * Purpose:	Set up the storage description of the v2 B-tree indexing
+ *		the shards of a dataset.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__shard_inner_storage(const H5O_storage_chunk_t *storage,
+    H5O_storage_chunk_t *inner_storage)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    inner_storage->idx_type = H5D_CHUNK_IDX_BT2;
+    inner_storage->idx_addr = storage->idx_addr;
+    inner_storage->ops = H5D_COPS_BT2;
+    inner_storage->u.btree2 = storage->u.shard.btree2;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__shard_inner_storage() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_inner_init
+ *
+ * Purpose:	Set up the index information of the v2 B-tree indexing the
+ *		shards of a dataset.  To the v2 B-tree, each shard is an
+ *		unfiltered "chunk" at the address of the shard's offset
+ *		table.  The "chunks" have no size, so that the v2 B-tree
+ *		never releases any file space itself: the offset tables
+ *		and chunks are released here.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__shard_inner_init(const H5D_chk_idx_info_t *idx_info,
+    const H5D_shard_geom_t *geom, H5D_shard_inner_t *inner)
+{
+    unsigned u;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDmemset(&inner->pline, 0, sizeof(inner->pline));
+
+    HDmemcpy(&inner->layout, idx_info->layout, sizeof(inner->layout));
+    inner->layout.idx_type = H5D_CHUNK_IDX_BT2;
+    for(u = 0; u < geom->ndims; u++)
+        inner->layout.dim[u] = idx_info->layout->dim[u] * idx_info->layout->u.shard.shard_dim[u];
+    inner->layout.size = 0;
+    inner->layout.u.btree2 = idx_info->layout->u.shard.btree2;
+
+    H5D__shard_inner_storage(idx_info->storage, &inner->storage);
+
+    inner->idx_info.f = idx_info->f;
+    inner->idx_info.pline = &inner->pline;
+    inner->idx_info.layout = &inner->layout;
+    inner->idx_info.storage = &inner->storage;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__shard_inner_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_inner_sync
+ *
+ * Purpose:	Copy the state of the v2 B-tree indexing the shards back
+ *		into the storage description of a dataset.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__shard_inner_sync(const H5O_storage_chunk_t *inner_storage,
+    H5O_storage_chunk_t *storage)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    storage->idx_addr = inner_storage->idx_addr;
+    storage->u.shard.btree2 = inner_storage->u.btree2;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__shard_inner_sync() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_table_new
+ *
+ * Purpose:	Allocate an empty shard offset table of NCHUNKS entries,
+ *		SIZE bytes long on disk, in memory.
+ *
+ * Return:	Success:	Pointer to the new offset table
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5D_shard_table_t *
+H5D__shard_table_new(hsize_t nchunks, size_t size)
+{
+    H5D_shard_table_t *table = NULL;    /* Shard offset table */
+    hsize_t u;                          /* Local index variable */
+    H5D_shard_table_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(NULL == (table = H5FL_CALLOC(H5D_shard_table_t)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate shard offset table")
+    if(NULL == (table->recs = H5FL_SEQ_MALLOC(H5D_shard_rec_t, (size_t)nchunks)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate shard offset table")
+
+    table->nchunks = nchunks;
+    table->size = size;
+    table->data_addr = HADDR_UNDEF;
+    for(u = 0; u < nchunks; u++) {
+        table->recs[u].addr = HADDR_UNDEF;
+        table->recs[u].nbytes = 0;
+        table->recs[u].filter_mask = 0;
+    } /* end for */
+
+    ret_value = table;
+
+done:
+    if(!ret_value && table)
+        table = H5FL_FREE(H5D_shard_table_t, table);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_table_new() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_table_protect
+ *
+ * Purpose:	Protect the offset table of a shard in the metadata cache.
+ *
+ * Return:	Success:	Pointer to the offset table
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5D_shard_table_t *
+H5D__shard_table_protect(H5F_t *f, const H5D_shard_geom_t *geom, haddr_t addr,
+    unsigned flags)
+{
+    H5D_shard_table_ud_t udata;         /* User data for cache callbacks */
+    H5D_shard_table_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(geom);
+    HDassert(H5F_addr_defined(addr));
+
+    udata.f = f;
+    udata.nchunks = geom->nchunks;
+    if(NULL == (ret_value = (H5D_shard_table_t *)H5AC_protect(f, H5AC_DSHARD, addr, &udata, flags)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTPROTECT, NULL, "unable to protect shard offset table, address = %llu", (unsigned long long)addr)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_table_protect() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_lookup
+ *
+ * Purpose:	Find the offset table of a shard and protect it in the
+ *		metadata cache with FLAGS.  When CREATE is set, a shard
+ *		which doesn't exist yet is created and added to the index;
+ *		otherwise *TABLE is set to NULL for it.
+ *
+ *		The addresses of recently used shards are remembered for
+ *		the dataset, to avoid searching the index for them again.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_lookup(const H5D_chk_idx_info_t *idx_info, const H5D_shard_geom_t *geom,
+    const hsize_t shard_scaled[], hbool_t create, unsigned flags,
+    H5D_shard_table_t **table)
+{
+    H5D_shard_cache_t *cache;           /* Recently used shards */
+    H5D_shard_table_t *new_table = NULL; /* Offset table created */
+    haddr_t addr = HADDR_UNDEF;         /* Address of offset table */
+    unsigned u;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(idx_info);
+    HDassert(idx_info->storage);
+    HDassert(table);
+
+    *table = NULL;
+
+    /* Allocate the cache the first time it's needed */
+    if(NULL == (cache = idx_info->storage->u.shard.cache)) {
+        if(NULL == (cache = H5FL_CALLOC(H5D_shard_cache_t)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate shard cache")
+        idx_info->storage->u.shard.cache = cache;
+    } /* end if */
+
+    /* Look for the shard in the cache */
+    for(u = 0; u < cache->nused; u++)
+        if(!HDmemcmp(cache->ent[u].scaled, shard_scaled, geom->ndims * sizeof(hsize_t)))
+            break;
+    if(u < cache->nused) {
+        H5D_shard_ent_t hit_ent = cache->ent[u];
+
+        /* Move the shard to the front */
+        HDmemmove(&cache->ent[1], &cache->ent[0], u * sizeof(H5D_shard_ent_t));
+        cache->ent[0] = hit_ent;
+        addr = hit_ent.addr;
+    } /* end if */
+    else {
+        H5D_shard_inner_t inner;        /* Index info for the v2 B-tree */
+        H5D_chunk_ud_t udata;           /* Shard information */
+
+        /* Look for the shard in the index */
+        H5D__shard_inner_init(idx_info, geom, &inner);
+        if(H5F_addr_defined(inner.storage.idx_addr)) {
+            udata.common.layout = &inner.layout;
+            udata.common.storage = &inner.storage;
+            udata.common.scaled = shard_scaled;
+            if((H5D_COPS_BT2->get_addr)(&inner.idx_info, &udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't query shard address")
+            H5D__shard_inner_sync(&inner.storage, idx_info->storage);
+            addr = udata.chunk_block.offset;
+        } /* end if */
+        if(!H5F_addr_defined(addr)) {
+            if(!create)
+                HGOTO_DONE(SUCCEED)
+
+            /* Create an empty offset table in the cache */
+            if(NULL == (new_table = H5D__shard_table_new(geom->nchunks, geom->table_size)))
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate shard offset table")
+            if(HADDR_UNDEF == (addr = H5MF_alloc(idx_info->f, H5FD_MEM_BTREE, (hsize_t)geom->table_size)))
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "file allocation failed for shard offset table")
+            if(H5AC_insert_entry(idx_info->f, H5AC_DSHARD, addr, new_table, H5AC__NO_FLAGS_SET) < 0) {
+                if(H5MF_xfree(idx_info->f, H5FD_MEM_BTREE, addr, (hsize_t)geom->table_size) < 0)
+                    HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release shard offset table")
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't add shard offset table to cache")
+            } /* end if */
+            new_table = NULL;
+
+            /* Add the shard to the index */
+            if(!H5F_addr_defined(inner.storage.idx_addr)) {
+                if((H5D_COPS_BT2->create)(&inner.idx_info) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't create shard index")
+                H5D__shard_inner_sync(&inner.storage, idx_info->storage);
+            } /* end if */
+            udata.common.layout = &inner.layout;
+            udata.common.storage = &inner.storage;
+            udata.common.scaled = shard_scaled;
+            udata.chunk_block.offset = addr;
+            udata.chunk_block.length = 0;
+            udata.filter_mask = 0;
+            if((H5D_COPS_BT2->insert)(&inner.idx_info, &udata, NULL) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't insert shard into index")
+            H5D__shard_inner_sync(&inner.storage, idx_info->storage);
+        } /* end if */
+
+        /* Add the shard to the front of the cache, forgetting the least
+         * recently used one if the cache is full */
+        if(cache->nused == H5D_SHARD_CACHE_NSLOTS)
+            cache->nused--;
+        HDmemmove(&cache->ent[1], &cache->ent[0], cache->nused * sizeof(H5D_shard_ent_t));
+        HDmemcpy(cache->ent[0].scaled, shard_scaled, geom->ndims * sizeof(hsize_t));
+        cache->ent[0].addr = addr;
+        cache->nused++;
+    } /* end else */
+
+    if(NULL == (*table = H5D__shard_table_protect(idx_info->f, geom, addr, flags)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTPROTECT, FAIL, "unable to protect shard offset table")
+
+done:
+    if(new_table)
+        if(H5D__shard_table_free_icr(new_table) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to destroy shard offset table")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_lookup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_table_free_chunks
+ *
+ * Purpose:	Release the file space of all the chunks of a shard.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_table_free_chunks(H5F_t *f, const H5O_layout_chunk_t *layout,
+    const H5D_shard_table_t *table)
+{
+    hsize_t u;                          /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Unfiltered chunks are released with the block holding them */
+    if(H5F_addr_defined(table->data_addr)) {
+        if(H5MF_xfree(f, H5FD_MEM_DRAW, table->data_addr, table->nchunks * (hsize_t)layout->size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunks")
+    } /* end if */
+    else
+        for(u = 0; u < table->nchunks; u++)
+            if(H5F_addr_defined(table->recs[u].addr))
+                if(H5MF_xfree(f, H5FD_MEM_DRAW, table->recs[u].addr, (hsize_t)table->recs[u].nbytes) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_table_free_chunks() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_cache_dest
+ *
+ * Purpose:	Forget the recently used shards of a dataset.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__shard_cache_dest(H5O_storage_chunk_t *storage)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    if(storage->u.shard.cache)
+        storage->u.shard.cache = H5FL_FREE(H5D_shard_cache_t, storage->u.shard.cache);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__shard_cache_dest() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_init
+ *
+ * Purpose:	Check that the shards of a dataset can be indexed and set
+ *		up the indexing information.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_init(const H5D_chk_idx_info_t *idx_info,
+    const H5S_t H5_ATTR_UNUSED *space, haddr_t dset_ohdr_addr)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    unsigned u;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check args */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->layout);
+    HDassert(idx_info->storage);
+    HDassert(H5F_addr_defined(dset_ohdr_addr));
+
+    if(H5F_INTENT(idx_info->f) & H5F_ACC_SWMR_WRITE)
+        HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "sharded chunk index doesn't support SWMR writes")
+    if(H5F_HAS_FEATURE(idx_info->f, H5FD_FEAT_HAS_MPI))
+        HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "sharded chunk index doesn't support parallel I/O")
+
+    /* The offset table of a shard is a single metadata cache entry and the
+     * v2 B-tree of shards stores shard extents as 32-bit values */
+    H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+    if(geom.table_size > (size_t)0xffffffff)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "shard offset table must be < 4GB")
+    for(u = 0; u < geom.ndims; u++)
+        if((hsize_t)idx_info->layout->dim[u] * idx_info->layout->u.shard.shard_dim[u] > (hsize_t)0xffffffff)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "shard dimensions must be less than 2^32 elements")
+
+    idx_info->storage->u.shard.btree2.dset_ohdr_addr = dset_ohdr_addr;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_create
+ *
+ * Purpose:	Create the v2 B-tree indexing the shards of a dataset.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_create(const H5D_chk_idx_info_t *idx_info)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    H5D_shard_inner_t inner;            /* Index info for the v2 B-tree */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check args */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->layout);
+    HDassert(idx_info->storage);
+    HDassert(!H5F_addr_defined(idx_info->storage->idx_addr));
+
+    H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+    H5D__shard_inner_init(idx_info, &geom, &inner);
+    if((H5D_COPS_BT2->create)(&inner.idx_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't create shard index")
+    H5D__shard_inner_sync(&inner.storage, idx_info->storage);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_is_space_alloc
+ *
+ * Purpose:	Query if space is allocated for index method
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__shard_idx_is_space_alloc(const H5O_storage_chunk_t *storage)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check args */
+    HDassert(storage);
+
+    FUNC_LEAVE_NOAPI((hbool_t)H5F_addr_defined(storage->idx_addr))
+} /* end H5D__shard_idx_is_space_alloc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_alloc_chunk
+ *
+ * Purpose:	Allocate file space for a chunk of a sharded dataset,
+ *		creating the chunk's shard if needed.
+ *
+ *		An unfiltered chunk goes in its slot in the shard's block
+ *		of unfiltered chunks, which is allocated for the first
+ *		one.  A filtered chunk which was already stored is kept in
+ *		place when it's no larger now, releasing the space it no
+ *		longer needs; otherwise it's moved to new space of its
+ *		actual size.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__shard_alloc_chunk(const H5D_chk_idx_info_t *idx_info, const hsize_t scaled[],
+    H5F_block_t *new_chunk)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    H5D_shard_table_t *table = NULL;    /* Offset table of shard */
+    H5D_shard_rec_t *rec;               /* Offset table entry of chunk */
+    hsize_t shard_scaled[H5O_LAYOUT_NDIMS]; /* Scaled coordinates of shard */
+    hsize_t local;                      /* Index of chunk in shard */
+    unsigned table_flags = H5AC__NO_FLAGS_SET; /* Flags for unprotecting offset table */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(idx_info);
+    HDassert(idx_info->pline);
+    HDassert(idx_info->layout);
+    HDassert(H5D_CHUNK_IDX_SHARD == idx_info->layout->idx_type);
+    HDassert(scaled);
+    HDassert(new_chunk);
+    HDassert(new_chunk->length > 0);
+
+    H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+    local = H5D__shard_locate(idx_info->layout, &geom, scaled, shard_scaled);
+    if(H5D__shard_lookup(idx_info, &geom, shard_scaled, TRUE, H5AC__NO_FLAGS_SET, &table) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't look up shard")
+    HDassert(table);
+    rec = &table->recs[local];
+
+    if(0 == idx_info->pline->nused) {
+        HDassert(new_chunk->length == idx_info->layout->size);
+
+        if(!H5F_addr_defined(table->data_addr)) {
+            if(HADDR_UNDEF == (table->data_addr = H5MF_alloc(idx_info->f, H5FD_MEM_DRAW, geom.nchunks * (hsize_t)idx_info->layout->size)))
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "file allocation failed")
+            table_flags |= H5AC__DIRTIED_FLAG;
+        } /* end if */
+        new_chunk->offset = table->data_addr + local * idx_info->layout->size;
+    } /* end if */
+    else {
+        H5_CHECK_OVERFLOW(new_chunk->length, /*From: */uint32_t, /*To: */hsize_t);
+
+        if(H5F_addr_defined(rec->addr) && new_chunk->length <= rec->nbytes) {
+            if(new_chunk->length < rec->nbytes)
+                if(H5MF_xfree(idx_info->f, H5FD_MEM_DRAW, rec->addr + new_chunk->length, (hsize_t)(rec->nbytes - new_chunk->length)) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+            new_chunk->offset = rec->addr;
+        } /* end if */
+        else {
+            if(H5F_addr_defined(rec->addr)) {
+                if(H5MF_xfree(idx_info->f, H5FD_MEM_DRAW, rec->addr, (hsize_t)rec->nbytes) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+                rec->addr = HADDR_UNDEF;
+                rec->nbytes = 0;
+                table_flags |= H5AC__DIRTIED_FLAG;
+            } /* end if */
+            new_chunk->offset = H5MF_alloc(idx_info->f, H5FD_MEM_DRAW, (hsize_t)new_chunk->length);
+            if(!H5F_addr_defined(new_chunk->offset))
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "file allocation failed")
+        } /* end else */
+    } /* end else */
+
+    /* Record the chunk's new location right away, so that the space
+     * released above is never released twice */
+    rec->addr = new_chunk->offset;
+    rec->nbytes = (uint32_t)new_chunk->length;
+    table_flags |= H5AC__DIRTIED_FLAG;
+
+done:
+    if(table && H5AC_unprotect(idx_info->f, H5AC_DSHARD, table->cache_info.addr, table, table_flags) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTUNPROTECT, FAIL, "unable to release shard offset table")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_alloc_chunk() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_insert
+ *
+ * Purpose:	Record the location of a chunk in its shard's offset table.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_insert(const H5D_chk_idx_info_t *idx_info, H5D_chunk_ud_t *udata,
+    const H5D_t H5_ATTR_UNUSED *dset)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    H5D_shard_table_t *table = NULL;    /* Offset table of shard */
+    hsize_t shard_scaled[H5O_LAYOUT_NDIMS]; /* Scaled coordinates of shard */
+    hsize_t local;                      /* Index of chunk in shard */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->pline);
+    HDassert(idx_info->layout);
+    HDassert(idx_info->storage);
+    HDassert(udata);
+    HDassert(H5F_addr_defined(udata->chunk_block.offset));
+
+    H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+    local = H5D__shard_locate(idx_info->layout, &geom, udata->common.scaled, shard_scaled);
+    if(H5D__shard_lookup(idx_info, &geom, shard_scaled, TRUE, H5AC__NO_FLAGS_SET, &table) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't look up shard")
+    HDassert(table);
+
+    table->recs[local].addr = udata->chunk_block.offset;
+    H5_CHECKED_ASSIGN(table->recs[local].nbytes, uint32_t, udata->chunk_block.length, hsize_t);
+    table->recs[local].filter_mask = udata->filter_mask;
+
+done:
+    if(table && H5AC_unprotect(idx_info->f, H5AC_DSHARD, table->cache_info.addr, table, H5AC__DIRTIED_FLAG) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTUNPROTECT, FAIL, "unable to release shard offset table")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_get_addr
+ *
+ * Purpose:	Get the file address of a chunk from its shard's offset
+ *		table.  Save the retrieved information in the udata
+ *		supplied.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_get_addr(const H5D_chk_idx_info_t *idx_info, H5D_chunk_ud_t *udata)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    H5D_shard_table_t *table = NULL;    /* Offset table of shard */
+    hsize_t shard_scaled[H5O_LAYOUT_NDIMS]; /* Scaled coordinates of shard */
+    hsize_t local;                      /* Index of chunk in shard */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->pline);
+    HDassert(idx_info->layout);
+    HDassert(idx_info->storage);
+    HDassert(udata);
+
+    H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+    local = H5D__shard_locate(idx_info->layout, &geom, udata->common.scaled, shard_scaled);
+    if(H5D__shard_lookup(idx_info, &geom, shard_scaled, FALSE, H5AC__READ_ONLY_FLAG, &table) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't look up shard")
+
+    if(table && H5F_addr_defined(table->recs[local].addr)) {
+        udata->chunk_block.offset = table->recs[local].addr;
+        udata->chunk_block.length = table->recs[local].nbytes;
+        udata->filter_mask = table->recs[local].filter_mask;
+    } /* end if */
+    else {
+        udata->chunk_block.offset = HADDR_UNDEF;
+        udata->chunk_block.length = 0;
+        udata->filter_mask = 0;
+    } /* end else */
+
+done:
+    if(table && H5AC_unprotect(idx_info->f, H5AC_DSHARD, table->cache_info.addr, table, H5AC__NO_FLAGS_SET) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTUNPROTECT, FAIL, "unable to release shard offset table")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_get_addr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_iterate_cb
+ *
+ * Purpose:	Make the generic chunk callback for each chunk in a shard,
+ *		or delete the shard with its chunks when the index is
+ *		deleted.  This is the callback for iterating over the v2
+ *		B-tree of shards.
+ *
+ * Return:	H5_ITER_CONT/H5_ITER_STOP on success, H5_ITER_ERROR on
+ *		failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__shard_iterate_cb(const H5D_chunk_rec_t *shard_rec, void *_udata)
+{
+    H5D_shard_it_ud_t *udata = (H5D_shard_it_ud_t *)_udata; /* User data */
+    H5D_shard_table_t *table = NULL;    /* Offset table of shard */
+    unsigned table_flags = H5AC__NO_FLAGS_SET; /* Flags for unprotecting offset table */
+    H5D_chunk_rec_t chunk_rec;          /* Generic chunk record */
+    hsize_t local;                      /* Index of chunk in shard */
+    int ret_value = H5_ITER_CONT;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    udata->nshards++;
+    if(NULL == udata->cb && !udata->delete_shards)
+        HGOTO_DONE(H5_ITER_CONT)
+
+    if(NULL == (table = H5D__shard_table_protect(udata->f, udata->geom, shard_rec->chunk_addr,
+            udata->delete_shards ? H5AC__NO_FLAGS_SET : H5AC__READ_ONLY_FLAG)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTPROTECT, H5_ITER_ERROR, "unable to protect shard offset table")
+
+    if(udata->delete_shards) {
+        if(H5D__shard_table_free_chunks(udata->f, udata->layout, table) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, H5_ITER_ERROR, "unable to free chunks")
+        table_flags = H5AC__DIRTIED_FLAG | H5AC__DELETED_FLAG | H5AC__FREE_FILE_SPACE_FLAG;
+        HGOTO_DONE(H5_ITER_CONT)
+    } /* end if */
+
+    /* Make the callbacks with a copy of the table, which isn't kept
+     * protected while the callbacks run */
+    HDmemcpy(udata->recs, table->recs, (size_t)udata->geom->nchunks * sizeof(H5D_shard_rec_t));
+    if(H5AC_unprotect(udata->f, H5AC_DSHARD, shard_rec->chunk_addr, table, H5AC__NO_FLAGS_SET) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTUNPROTECT, H5_ITER_ERROR, "unable to release shard offset table")
+    table = NULL;
+
+    HDmemset(&chunk_rec, 0, sizeof(chunk_rec));
+    for(local = 0; local < udata->geom->nchunks; local++)
+        if(H5F_addr_defined(udata->recs[local].addr)) {
+            hsize_t idx = local;        /* Remaining index of chunk in shard */
+            unsigned u;                 /* Local index variable */
+
+            for(u = udata->geom->ndims; u > 0; u--) {
+                chunk_rec.scaled[u - 1] = shard_rec->scaled[u - 1] * udata->layout->u.shard.shard_dim[u - 1]
+                        + idx % udata->layout->u.shard.shard_dim[u - 1];
+                idx /= udata->layout->u.shard.shard_dim[u - 1];
+            } /* end for */
+            chunk_rec.chunk_addr = udata->recs[local].addr;
+            chunk_rec.nbytes = udata->recs[local].nbytes;
+            chunk_rec.filter_mask = udata->recs[local].filter_mask;
+
+            if((ret_value = (udata->cb)(&chunk_rec, udata->udata)) < 0)
+                HERROR(H5E_DATASET, H5E_CALLBACK, "failure in generic chunk iterator callback");
+            if(ret_value != H5_ITER_CONT)
+                break;
+        } /* end if */
+
+done:
+    if(table && H5AC_unprotect(udata->f, H5AC_DSHARD, shard_rec->chunk_addr, table, table_flags) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTUNPROTECT, H5_ITER_ERROR, "unable to release shard offset table")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_iterate_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_iterate
+ *
+ * Purpose:	Iterate over the chunks in an index, making a callback
+ *              for each one.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__shard_idx_iterate(const H5D_chk_idx_info_t *idx_info,
+    H5D_chunk_cb_func_t chunk_cb, void *chunk_udata)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    H5D_shard_inner_t inner;            /* Index info for the v2 B-tree */
+    H5D_shard_it_ud_t udata;            /* User data for shard callback */
+    int ret_value = FAIL;               /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->pline);
+    HDassert(idx_info->layout);
+    HDassert(idx_info->storage);
+    HDassert(H5F_addr_defined(idx_info->storage->idx_addr));
+    HDassert(chunk_cb);
+    HDassert(chunk_udata);
+
+    H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+
+    HDmemset(&udata, 0, sizeof(udata));
+    udata.f = idx_info->f;
+    udata.layout = idx_info->layout;
+    udata.geom = &geom;
+    udata.cb = chunk_cb;
+    udata.udata = chunk_udata;
+    if(NULL == (udata.recs = H5FL_SEQ_MALLOC(H5D_shard_rec_t, (size_t)geom.nchunks)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate shard offset table")
+
+    /* Iterate over the shards */
+    H5D__shard_inner_init(idx_info, &geom, &inner);
+    if((ret_value = (H5D_COPS_BT2->iterate)(&inner.idx_info, H5D__shard_iterate_cb, &udata)) < 0)
+        HERROR(H5E_DATASET, H5E_BADITER, "unable to iterate over shards");
+    H5D__shard_inner_sync(&inner.storage, idx_info->storage);
+
+done:
+    if(udata.recs)
+        udata.recs = H5FL_SEQ_FREE(H5D_shard_rec_t, udata.recs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_iterate() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_remove
+ *
+ * Purpose:	Remove a chunk from its shard, removing the shard itself
+ *		once it holds no more chunks.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_remove(const H5D_chk_idx_info_t *idx_info, H5D_chunk_common_ud_t *udata)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    H5D_shard_table_t *table = NULL;    /* Offset table of shard */
+    unsigned table_flags = H5AC__NO_FLAGS_SET; /* Flags for unprotecting offset table */
+    hsize_t shard_scaled[H5O_LAYOUT_NDIMS]; /* Scaled coordinates of shard */
+    hsize_t local;                      /* Index of chunk in shard */
+    hsize_t u;                          /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->pline);
+    HDassert(idx_info->layout);
+    HDassert(idx_info->storage);
+    HDassert(udata);
+
+    H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+    local = H5D__shard_locate(idx_info->layout, &geom, udata->scaled, shard_scaled);
+    if(H5D__shard_lookup(idx_info, &geom, shard_scaled, FALSE, H5AC__NO_FLAGS_SET, &table) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't look up shard")
+    if(!table || !H5F_addr_defined(table->recs[local].addr))
+        HGOTO_DONE(SUCCEED)
+
+    /* Free the chunk, unless it's in the block of unfiltered chunks */
+    if(!H5F_addr_defined(table->data_addr))
+        if(H5MF_xfree(idx_info->f, H5FD_MEM_DRAW, table->recs[local].addr, (hsize_t)table->recs[local].nbytes) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+
+    table->recs[local].addr = HADDR_UNDEF;
+    table->recs[local].nbytes = 0;
+    table->recs[local].filter_mask = 0;
+    table_flags |= H5AC__DIRTIED_FLAG;
+
+    /* Check for any chunks left in the shard */
+    for(u = 0; u < geom.nchunks; u++)
+        if(H5F_addr_defined(table->recs[u].addr))
+            break;
+
+    if(u == geom.nchunks) {
+        H5D_shard_cache_t *cache = idx_info->storage->u.shard.cache; /* Recently used shards */
+        H5D_shard_inner_t inner;        /* Index info for the v2 B-tree */
+        H5D_chunk_common_ud_t inner_udata; /* Shard information */
+
+        /* Release the block of unfiltered chunks */
+        if(H5D__shard_table_free_chunks(idx_info->f, idx_info->layout, table) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunks")
+        table->data_addr = HADDR_UNDEF;
+
+        /* Remove the shard from the index and delete its offset table */
+        H5D__shard_inner_init(idx_info, &geom, &inner);
+        inner_udata.layout = &inner.layout;
+        inner_udata.storage = &inner.storage;
+        inner_udata.scaled = shard_scaled;
+        if((H5D_COPS_BT2->remove)(&inner.idx_info, &inner_udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "can't remove shard from index")
+        H5D__shard_inner_sync(&inner.storage, idx_info->storage);
+        table_flags |= H5AC__DELETED_FLAG | H5AC__FREE_FILE_SPACE_FLAG;
+
+        /* Forget the shard, which is at the front of the cache */
+        HDassert(cache && cache->nused > 0);
+        HDassert(H5F_addr_eq(cache->ent[0].addr, table->cache_info.addr));
+        cache->nused--;
+        HDmemmove(&cache->ent[0], &cache->ent[1], cache->nused * sizeof(H5D_shard_ent_t));
+    } /* end if */
+
+done:
+    if(table && H5AC_unprotect(idx_info->f, H5AC_DSHARD, table->cache_info.addr, table, table_flags) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTUNPROTECT, FAIL, "unable to release shard offset table")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_delete
+ *
+ * Purpose:	Delete index and raw data storage for entire dataset
+ *              (i.e. all chunks and shards)
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_delete(const H5D_chk_idx_info_t *idx_info)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    H5D_shard_inner_t inner;            /* Index info for the v2 B-tree */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->pline);
+    HDassert(idx_info->layout);
+    HDassert(idx_info->storage);
+
+    if(H5F_addr_defined(idx_info->storage->idx_addr)) {
+        H5D_shard_it_ud_t udata;        /* User data for shard callback */
+
+        H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+        H5D__shard_inner_init(idx_info, &geom, &inner);
+
+        /* Delete the shards, along with their chunks */
+        HDmemset(&udata, 0, sizeof(udata));
+        udata.f = idx_info->f;
+        udata.layout = idx_info->layout;
+        udata.geom = &geom;
+        udata.delete_shards = TRUE;
+        if((H5D_COPS_BT2->iterate)(&inner.idx_info, H5D__shard_iterate_cb, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to iterate over shards")
+
+        /* Delete the v2 B-tree */
+        if((H5D_COPS_BT2->dest)(&inner.idx_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "can't close shard index")
+        if((H5D_COPS_BT2->idx_delete)(&inner.idx_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTDELETE, FAIL, "can't delete shard index")
+        H5D__shard_inner_sync(&inner.storage, idx_info->storage);
+    } /* end if */
+
+    H5D__shard_cache_dest(idx_info->storage);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_delete() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_copy_setup
+ *
+ * Purpose:	Set up any necessary information for copying chunks
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_copy_setup(const H5D_chk_idx_info_t *idx_info_src,
+    const H5D_chk_idx_info_t *idx_info_dst)
+{
+    H5D_shard_geom_t geom_src;          /* Shape of the source shards */
+    H5D_shard_geom_t geom_dst;          /* Shape of the destination shards */
+    H5D_shard_inner_t inner_src;        /* Index info for the source v2 B-tree */
+    H5D_shard_inner_t inner_dst;        /* Index info for the destination v2 B-tree */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check args */
+    HDassert(idx_info_src);
+    HDassert(idx_info_src->storage);
+    HDassert(idx_info_dst);
+    HDassert(idx_info_dst->storage);
+    HDassert(!H5F_addr_defined(idx_info_dst->storage->idx_addr));
+
+    idx_info_dst->storage->u.shard.cache = NULL;
+
+    H5D__shard_geom(idx_info_src->f, idx_info_src->layout, &geom_src);
+    H5D__shard_inner_init(idx_info_src, &geom_src, &inner_src);
+    H5D__shard_geom(idx_info_dst->f, idx_info_dst->layout, &geom_dst);
+    H5D__shard_inner_init(idx_info_dst, &geom_dst, &inner_dst);
+    if((H5D_COPS_BT2->copy_setup)(&inner_src.idx_info, &inner_dst.idx_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up shard index copy")
+    H5D__shard_inner_sync(&inner_src.storage, idx_info_src->storage);
+    H5D__shard_inner_sync(&inner_dst.storage, idx_info_dst->storage);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_copy_setup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_copy_shutdown
+ *
+ * Purpose:	Shutdown any information from copying chunks
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_copy_shutdown(H5O_storage_chunk_t *storage_src,
+    H5O_storage_chunk_t *storage_dst)
+{
+    H5O_storage_chunk_t inner_src;      /* Source v2 B-tree storage */
+    H5O_storage_chunk_t inner_dst;      /* Destination v2 B-tree storage */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check args */
+    HDassert(storage_src);
+    HDassert(storage_dst);
+
+    H5D__shard_cache_dest(storage_src);
+    H5D__shard_cache_dest(storage_dst);
+
+    H5D__shard_inner_storage(storage_src, &inner_src);
+    H5D__shard_inner_storage(storage_dst, &inner_dst);
+    if((H5D_COPS_BT2->copy_shutdown)(&inner_src, &inner_dst) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to shut down shard index copy")
+    H5D__shard_inner_sync(&inner_src, storage_src);
+    H5D__shard_inner_sync(&inner_dst, storage_dst);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_copy_shutdown() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__shard_idx_size
+ *
+ * Purpose:     Retrieve the amount of index storage for chunked dataset:
+ *		the v2 B-tree of shards and the shards' offset tables.
+ *
+ * Return:      Success:        Non-negative
+ *              Failure:        negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_size(const H5D_chk_idx_info_t *idx_info, hsize_t *index_size)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    H5D_shard_inner_t inner;            /* Index info for the v2 B-tree */
+    H5D_shard_it_ud_t udata;            /* User data for shard callback */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check args */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->layout);
+    HDassert(idx_info->storage);
+    HDassert(H5F_addr_defined(idx_info->storage->idx_addr));
+    HDassert(index_size);
+
+    H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+    H5D__shard_inner_init(idx_info, &geom, &inner);
+
+    /* Count the shards */
+    HDmemset(&udata, 0, sizeof(udata));
+    if((H5D_COPS_BT2->iterate)(&inner.idx_info, H5D__shard_iterate_cb, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to iterate over shards")
+    if((H5D_COPS_BT2->dest)(&inner.idx_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "can't close shard index")
+
+    /* Get the size of the v2 B-tree */
+    if((H5D_COPS_BT2->size)(&inner.idx_info, index_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve shard index size")
+    *index_size += udata.nshards * geom.table_size;
+
+done:
+    H5D__shard_inner_sync(&inner.storage, idx_info->storage);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_reset
+ *
+ * Purpose:	Reset indexing information.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_reset(H5O_storage_chunk_t *storage, hbool_t reset_addr)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(storage);
+
+    /* Reset index info */
+    if(reset_addr)
+        storage->idx_addr = HADDR_UNDEF;
+    storage->u.shard.btree2.bt2 = NULL;
+    storage->u.shard.cache = NULL;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__shard_idx_reset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_dump
+ *
+ * Purpose:	Dump indexing information to a stream.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_dump(const H5O_storage_chunk_t *storage, FILE *stream)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(storage);
+    HDassert(stream);
+
+    HDfprintf(stream, "    Address: %a\n", storage->idx_addr);
+    HDfprintf(stream, "    Recently used shards: %u\n",
+            storage->u.shard.cache ? storage->u.shard.cache->nused : 0);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__shard_idx_dump() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__shard_idx_dest
+ *
+ * Purpose:	Release indexing information in memory.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__shard_idx_dest(const H5D_chk_idx_info_t *idx_info)
+{
+    H5D_shard_geom_t geom;              /* Shape of the shards */
+    H5D_shard_inner_t inner;            /* Index info for the v2 B-tree */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check args */
+    HDassert(idx_info);
+    HDassert(idx_info->f);
+    HDassert(idx_info->storage);
+
+    H5D__shard_cache_dest(idx_info->storage);
+
+    H5D__shard_geom(idx_info->f, idx_info->layout, &geom);
+    H5D__shard_inner_init(idx_info, &geom, &inner);
+    if((H5D_COPS_BT2->dest)(&inner.idx_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "can't close shard index")
+    H5D__shard_inner_sync(&inner.storage, idx_info->storage);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__shard_idx_dest() */
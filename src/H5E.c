@@ -377,6 +377,7 @@ H5E_get_stack(void)
 
         /* Set the thread-specific info */
         estack->nused = 0;
+        estack->helper = FALSE;
         H5E_set_default_auto(estack);
 
         /* (It's not necessary to release this in this API, it is
@@ -983,10 +983,11 @@ END_FUNC(PRIV)  /* end H5EA_delete() */
 /*-------------------------------------------------------------------------
  * Function:    H5EA_iterate
  *
- * Purpose:	Iterate over the elements of an extensible array
+ * Purpose:	Iterate over the elements of an extensible array,
+ *		stopping early when the callback returns a positive value
  *		(copied and modified from FA_iterate() in H5FA.c)
  *
- * Return:      SUCCEED/FAIL
+ * Return:      SUCCEED/FAIL, or the callback's positive value
  *
  * Programmer:  Vailin Choi; Feb 2015
  *
@@ -1024,6 +1025,10 @@ H5EA_iterate(H5EA_t *ea, H5EA_operator_t op, void *udata))
             H5E_PRINTF(H5E_BADITER, "iterator function failed");
             H5_LEAVE(cb_ret)
         } /* end if */
+
+        /* Stop early if the callback asks to */
+        if(cb_ret > 0)
+            H5_LEAVE(cb_ret)
     } /* end for */
 
 CATCH
@@ -187,7 +187,7 @@ const H5AC_class_t H5AC_EARRAY_DBLOCK[1] = {{
     H5AC_EARRAY_DBLOCK_ID,              /* Metadata client ID */
     "Extensible Array Data Block",      /* Metadata client name (for debugging) */
     H5FD_MEM_EARRAY_DBLOCK,             /* File space memory type for client */
-    H5AC__CLASS_NO_FLAGS_SET,           /* Client class behavior flags */
+    H5AC__CLASS_THREADED_SERIALIZE_FLAG, /* Client class behavior flags */
     H5EA__cache_dblock_get_initial_load_size,   /* 'get_initial_load_size' callback */
     NULL,				/* 'get_final_load_size' callback */
     H5EA__cache_dblock_verify_chksum,	/* 'verify_chksum' callback */
@@ -205,7 +205,7 @@ const H5AC_class_t H5AC_EARRAY_DBLK_PAGE[1] = {{
     H5AC_EARRAY_DBLK_PAGE_ID,           /* Metadata client ID */
     "Extensible Array Data Block Page", /* Metadata client name (for debugging) */
     H5FD_MEM_EARRAY_DBLK_PAGE,          /* File space memory type for client */
-    H5AC__CLASS_NO_FLAGS_SET,           /* Client class behavior flags */
+    H5AC__CLASS_THREADED_SERIALIZE_FLAG, /* Client class behavior flags */
     H5EA__cache_dblk_page_get_initial_load_size, /* 'get_initial_load_size' callback */
     NULL,				/* 'get_final_load_size' callback */
     H5EA__cache_dblk_page_verify_chksum, /* 'verify_chksum' callback */
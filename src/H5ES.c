@@ -0,0 +1,293 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Public routines for event sets.  An event set collects the
+ *          operations started by the *_async routines (e.g.
+ *          H5Dwrite_async), so that the application can wait for them
+ *          and check whether any of them failed.
+ *
+ */
+
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5ESmodule.h"         /* This source code file is part of the H5ES module */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"          /* Generic Functions                    */
+#include "H5Eprivate.h"         /* Error handling                       */
+#include "H5ESpkg.h"            /* Event sets                           */
+#include "H5Iprivate.h"         /* IDs                                  */
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5EScreate
+ *
+ * Purpose:     Creates an event set, to pass to the *_async routines.
+ *
+ *              With a thread-safe library, the operations inserted into
+ *              an event set are run on a background thread, in the order
+ *              they were inserted, while the application continues.
+ *              Otherwise each operation is run before the routine that
+ *              inserts it returns.
+ *
+ * Return:      Success:    An ID for the event set
+ *              Failure:    H5I_INVALID_HID
+ *
+ *-------------------------------------------------------------------------
+ */
+hid_t
+H5EScreate(void)
+{
+    H5ES_t      *es = NULL;             /* New event set */
+    hid_t       ret_value = H5I_INVALID_HID;    /* Return value */
+
+    FUNC_ENTER_API(H5I_INVALID_HID)
+    H5TRACE0("i","");
+
+    /* Create the new event set */
+    if(NULL == (es = H5ES__create()))
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTCREATE, H5I_INVALID_HID, "can't create event set")
+
+    /* Register the new event set to get an ID for it */
+    if((ret_value = H5I_register(H5I_EVENTSET, es, TRUE)) < 0)
+        HGOTO_ERROR(H5E_ATOM, H5E_CANTREGISTER, H5I_INVALID_HID, "can't register event set")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5EScreate() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ESwait
+ *
+ * Purpose:     Waits up to TIMEOUT nanoseconds for the operations in an
+ *              event set to complete.  H5ES_WAIT_FOREVER waits until they
+ *              have all completed and H5ES_WAIT_NONE only checks on them.
+ *
+ *              The number of operations still in progress is returned in
+ *              NUM_IN_PROGRESS and whether any operation in the event set
+ *              has failed is returned in OP_FAILED.
+ *
+ *              The buffers passed to an operation mustn't be touched by
+ *              the application until it has completed.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5ESwait(hid_t es_id, uint64_t timeout, size_t *num_in_progress,
+    hbool_t *op_failed)
+{
+    H5ES_t      *es;                    /* Event set */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "iUL*z*b", es_id, timeout, num_in_progress, op_failed);
+
+    /* Check arguments */
+    if(NULL == (es = (H5ES_t *)H5I_object_verify(es_id, H5I_EVENTSET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an event set")
+    if(NULL == num_in_progress)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL num_in_progress pointer")
+    if(NULL == op_failed)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL op_failed pointer")
+
+    /* Wait for the operations */
+    if(H5ES__wait(es, timeout, num_in_progress, op_failed) < 0)
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTGET, FAIL, "can't wait on event set operations")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5ESwait() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ESget_count
+ *
+ * Purpose:     Retrieves the number of operations in an event set that
+ *              haven't completed yet.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5ESget_count(hid_t es_id, size_t *count /*out*/)
+{
+    H5ES_t      *es;                    /* Event set */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", es_id, count);
+
+    /* Check arguments */
+    if(NULL == (es = (H5ES_t *)H5I_object_verify(es_id, H5I_EVENTSET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an event set")
+
+    /* Retrieve the count */
+    if(count && H5ES__get_counts(es, count, NULL) < 0)
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTGET, FAIL, "can't get # of operations in progress")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5ESget_count() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ESget_err_status
+ *
+ * Purpose:     Checks whether any operation in an event set has failed.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5ESget_err_status(hid_t es_id, hbool_t *op_failed /*out*/)
+{
+    H5ES_t      *es;                    /* Event set */
+    size_t      num_errs = 0;           /* # of failed operations */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", es_id, op_failed);
+
+    /* Check arguments */
+    if(NULL == (es = (H5ES_t *)H5I_object_verify(es_id, H5I_EVENTSET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an event set")
+
+    /* Retrieve the error status */
+    if(op_failed) {
+        if(H5ES__get_counts(es, NULL, &num_errs) < 0)
+            HGOTO_ERROR(H5E_EVENTSET, H5E_CANTGET, FAIL, "can't get # of failed operations")
+        *op_failed = (hbool_t)(num_errs > 0);
+    } /* end if */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5ESget_err_status() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ESget_err_count
+ *
+ * Purpose:     Retrieves the number of operations in an event set that
+ *              have failed.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5ESget_err_count(hid_t es_id, size_t *num_errs /*out*/)
+{
+    H5ES_t      *es;                    /* Event set */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", es_id, num_errs);
+
+    /* Check arguments */
+    if(NULL == (es = (H5ES_t *)H5I_object_verify(es_id, H5I_EVENTSET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an event set")
+
+    /* Retrieve the count */
+    if(num_errs && H5ES__get_counts(es, NULL, num_errs) < 0)
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTGET, FAIL, "can't get # of failed operations")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5ESget_err_count() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ESclose
+ *
+ * Purpose:     Closes an event set, after waiting for the operations in
+ *              it to complete.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5ESclose(hid_t es_id)
+{
+    H5ES_t      *es;                    /* Event set */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", es_id);
+
+    /* Check arguments */
+    if(NULL == (es = (H5ES_t *)H5I_object_verify(es_id, H5I_EVENTSET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an event set")
+
+    /* Wait for the operations in progress, before the ID is released */
+    if(H5ES__wait(es, H5ES_WAIT_FOREVER, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTGET, FAIL, "can't wait on event set operations")
+
+    /* Decrement the counter on the event set ID.  It will be freed if the
+     * count reaches zero.
+     */
+    if(H5I_dec_app_ref(es_id) < 0)
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTDEC, FAIL, "unable to decrement ref count on event set")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5ESclose() */
+
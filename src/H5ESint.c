@@ -0,0 +1,671 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Internal routines for managing event sets.
+ *
+ */
+
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5ESmodule.h"         /* This source code file is part of the H5ES module */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"          /* Generic Functions                    */
+#include "H5CXprivate.h"        /* API Contexts                         */
+#include "H5Eprivate.h"         /* Error handling                       */
+#include "H5ESpkg.h"            /* Event sets                           */
+#include "H5FLprivate.h"        /* Free Lists                           */
+#include "H5Iprivate.h"         /* IDs                                  */
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+static herr_t H5ES__close_cb(H5ES_t *es);
+#ifdef H5ES_HAVE_WORKER
+static void *H5ES__worker(void *_es);
+static herr_t H5ES__discard(H5ES_t *es, hbool_t *detached);
+static void H5ES__free(H5ES_t *es);
+#endif /* H5ES_HAVE_WORKER */
+
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+/* Package initialization variable */
+hbool_t H5_PKG_INIT_VAR = FALSE;
+
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Event set ID class */
+static const H5I_class_t H5I_EVENTSET_CLS[1] = {{
+    H5I_EVENTSET,               /* ID class value */
+    0,                          /* Class flags */
+    0,                          /* # of reserved IDs for class */
+    (H5I_free_t)H5ES__close_cb  /* Callback routine for closing objects of this class */
+}};
+
+/* Declare a free list to manage the H5ES_op_t struct */
+H5FL_DEFINE_STATIC(H5ES_op_t);
+
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES__init_package
+ *
+ * Purpose:     Initializes any interface-specific data or routines.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5ES__init_package(void)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Initialize the atom group for the event set IDs */
+    if(H5I_register_type(H5I_EVENTSET_CLS) < 0)
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTINIT, FAIL, "unable to initialize interface")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5ES__init_package() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES_term_package
+ *
+ * Purpose:     Terminate this interface.  Open event sets are closed
+ *              first, discarding the operations that haven't started.
+ *
+ * Return:      Success:    Positive if anything was done that might
+ *                          affect other interfaces; zero otherwise.
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+H5ES_term_package(void)
+{
+    int         n = 0;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(H5_PKG_INIT_VAR) {
+        if(H5I_nmembers(H5I_EVENTSET) > 0) {
+            (void)H5I_clear_type(H5I_EVENTSET, FALSE, FALSE);
+            n++; /*H5I*/
+        } /* end if */
+        else {
+            /* Destroy the event set ID group */
+            n += (H5I_dec_type_ref(H5I_EVENTSET) > 0);
+
+            /* Mark closed */
+            if(0 == n)
+                H5_PKG_INIT_VAR = FALSE;
+        } /* end else */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(n)
+} /* end H5ES_term_package() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES__create
+ *
+ * Purpose:     Creates a new, empty event set.
+ *
+ * Return:      Success:    Pointer to the new event set
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+H5ES_t *
+H5ES__create(void)
+{
+    H5ES_t      *es = NULL;             /* New event set */
+    H5ES_t      *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Not on a free list, since a detached worker thread may release the
+     * event set after the library has shut down (see H5ES__close_cb)
+     */
+    if(NULL == (es = (H5ES_t *)HDcalloc(1, sizeof(H5ES_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "can't allocate event set")
+
+#ifdef H5ES_HAVE_WORKER
+    if(pthread_mutex_init(&es->mutex, NULL))
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTINIT, NULL, "can't initialize event set mutex")
+    if(pthread_cond_init(&es->work_cond, NULL)) {
+        pthread_mutex_destroy(&es->mutex);
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTINIT, NULL, "can't initialize event set condition")
+    } /* end if */
+    if(pthread_cond_init(&es->done_cond, NULL)) {
+        pthread_cond_destroy(&es->work_cond);
+        pthread_mutex_destroy(&es->mutex);
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTINIT, NULL, "can't initialize event set condition")
+    } /* end if */
+#endif /* H5ES_HAVE_WORKER */
+
+    /* Set return value */
+    ret_value = es;
+
+done:
+    if(NULL == ret_value && es)
+        HDfree(es);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5ES__create() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES_insert
+ *
+ * Purpose:     Inserts an operation into an event set.  EXEC_FUNC runs
+ *              the operation and RELEASE_FUNC then releases the resources
+ *              held by OP_DATA; RELEASE_FUNC is called whether or not the
+ *              operation succeeds.
+ *
+ *              With a thread-safe library, the operation is queued and
+ *              run on the event set's worker thread after the operations
+ *              inserted before it.  Otherwise it is run before this
+ *              routine returns.  Either way, its failure is recorded in
+ *              the event set instead of being returned here.
+ *
+ * Return:      SUCCEED/FAIL (the operation couldn't be inserted, and
+ *              OP_DATA is still owned by the caller)
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5ES_insert(H5ES_t *es, H5ES_op_func_t exec_func, H5ES_op_func_t release_func,
+    void *op_data)
+{
+#ifdef H5ES_HAVE_WORKER
+    H5ES_op_t   *op = NULL;             /* New operation */
+#else /* H5ES_HAVE_WORKER */
+    hbool_t     failed = FALSE;         /* Whether the operation failed */
+#endif /* H5ES_HAVE_WORKER */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(es);
+    HDassert(exec_func);
+    HDassert(release_func);
+
+#ifdef H5ES_HAVE_WORKER
+    if(NULL == (op = H5FL_MALLOC(H5ES_op_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate event set operation")
+    op->exec_func = exec_func;
+    op->release_func = release_func;
+    op->op_data = op_data;
+    op->next = NULL;
+
+    if(pthread_mutex_lock(&es->mutex))
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTLOCK, FAIL, "can't lock event set")
+
+    /* Start the worker thread with the first operation */
+    if(!es->worker_started) {
+        if(pthread_create(&es->worker, NULL, H5ES__worker, es)) {
+            pthread_mutex_unlock(&es->mutex);
+            HGOTO_ERROR(H5E_EVENTSET, H5E_CANTINIT, FAIL, "can't create event set worker thread")
+        } /* end if */
+        es->worker_started = TRUE;
+    } /* end if */
+
+    /* Queue the operation */
+    if(es->tail)
+        es->tail->next = op;
+    else
+        es->head = op;
+    es->tail = op;
+    es->num_pending++;
+    op = NULL;
+
+    pthread_cond_signal(&es->work_cond);
+    pthread_mutex_unlock(&es->mutex);
+#else /* H5ES_HAVE_WORKER */
+    /* Run the operation now */
+    if((exec_func)(op_data) < 0)
+        failed = TRUE;
+    if((release_func)(op_data) < 0)
+        failed = TRUE;
+
+    /* Record the failure in the event set, instead of on the error stack */
+    if(failed) {
+        es->num_errs++;
+        H5E_clear_stack(NULL);
+    } /* end if */
+#endif /* H5ES_HAVE_WORKER */
+
+done:
+#ifdef H5ES_HAVE_WORKER
+    if(op)
+        op = H5FL_FREE(H5ES_op_t, op);
+#endif /* H5ES_HAVE_WORKER */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5ES_insert() */
+
+#ifdef H5ES_HAVE_WORKER
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES__worker
+ *
+ * Purpose:     Start routine for an event set's worker thread.  Runs the
+ *              operations queued in the event set, in order, until the
+ *              event set is closed.
+ *
+ *              Each operation is run the way an API routine would run
+ *              it: holding the library's API lock, with its own API
+ *              context, and starting from an empty error stack.  An
+ *              operation is only taken off the queue once the API lock
+ *              is held, so that closing the event set while the library
+ *              shuts down can discard everything that hasn't started.
+ *
+ * Return:      NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5ES__worker(void *_es)
+{
+    H5ES_t *es = (H5ES_t *)_es;         /* Event set to work on */
+
+    while(1) {
+        H5ES_op_t   *op;                /* Operation to run */
+        hbool_t     detached;           /* Whether the event set was closed without us */
+        hbool_t     pushed = FALSE;     /* Whether an API context was pushed */
+        hbool_t     failed = FALSE;     /* Whether the operation failed */
+
+        /* Wait for an operation, or for the event set to be closed */
+        pthread_mutex_lock(&es->mutex);
+        while(NULL == es->head && !es->shutdown)
+            pthread_cond_wait(&es->work_cond, &es->mutex);
+        if(NULL == es->head) {
+            pthread_mutex_unlock(&es->mutex);
+            break;
+        } /* end if */
+        es->worker_busy = TRUE;
+        pthread_mutex_unlock(&es->mutex);
+
+        /* Take the next operation, once it can run */
+        H5_API_LOCK
+        pthread_mutex_lock(&es->mutex);
+        if(!(detached = es->detached)) {
+            op = es->head;
+            if(NULL == (es->head = op->next))
+                es->tail = NULL;
+        } /* end if */
+        pthread_mutex_unlock(&es->mutex);
+
+        /* The library shut down while we waited for the API lock, and
+         * left the event set for us to release
+         */
+        if(detached) {
+            H5_API_UNLOCK
+            H5ES__free(es);
+            break;
+        } /* end if */
+
+        /* Run the operation */
+        if(H5CX_push() < 0)
+            failed = TRUE;
+        else {
+            pushed = TRUE;
+            H5E_clear_stack(NULL);
+            if((op->exec_func)(op->op_data) < 0)
+                failed = TRUE;
+        } /* end else */
+        if((op->release_func)(op->op_data) < 0)
+            failed = TRUE;
+        if(pushed && H5CX_pop() < 0)
+            failed = TRUE;
+        H5E_clear_stack(NULL);
+        op = H5FL_FREE(H5ES_op_t, op);
+        H5_API_UNLOCK
+
+        /* Record the completion */
+        pthread_mutex_lock(&es->mutex);
+        es->num_pending--;
+        if(failed)
+            es->num_errs++;
+        es->worker_busy = FALSE;
+        pthread_cond_broadcast(&es->done_cond);
+        pthread_mutex_unlock(&es->mutex);
+    } /* end while */
+
+    return NULL;
+} /* end H5ES__worker() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES__discard
+ *
+ * Purpose:     Stops an event set's worker thread without waiting for the
+ *              API lock, for closing the event set while the library
+ *              shuts down.  The operations that haven't started are
+ *              released without being run.
+ *
+ *              A worker that is already waiting for the API lock can't
+ *              be joined while the lock is held, so it is detached
+ *              instead, and releases the event set itself once it gets
+ *              the lock.  DETACHED is set when that happens, and the
+ *              event set must not be touched afterwards.
+ *
+ * Return:      SUCCEED/FAIL (an operation's resources couldn't be
+ *              released)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5ES__discard(H5ES_t *es, hbool_t *detached)
+{
+    H5ES_op_t   *op;                    /* Operation being discarded */
+    hbool_t     release_failed = FALSE; /* Whether releasing an operation failed */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(es);
+    HDassert(detached);
+
+    if(pthread_mutex_lock(&es->mutex))
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTLOCK, FAIL, "can't lock event set")
+
+    /* Release the queued operations.  None of them has started, since the
+     * worker only takes an operation while holding the API lock.
+     */
+    while(NULL != (op = es->head)) {
+        es->head = op->next;
+        if((op->release_func)(op->op_data) < 0)
+            release_failed = TRUE;
+        op = H5FL_FREE(H5ES_op_t, op);
+        es->num_pending--;
+        es->num_errs++;
+    } /* end while */
+    es->tail = NULL;
+
+    /* Stop the worker, or leave the event set to it */
+    es->shutdown = TRUE;
+    if(es->worker_busy) {
+        es->detached = TRUE;
+        pthread_detach(es->worker);
+    } /* end if */
+    else
+        pthread_cond_signal(&es->work_cond);
+    *detached = es->detached;
+    pthread_mutex_unlock(&es->mutex);
+
+    if(!*detached && es->worker_started && pthread_join(es->worker, NULL))
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTCLOSEOBJ, FAIL, "can't join event set worker thread")
+    if(release_failed)
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTRELEASE, FAIL, "can't release event set operation")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5ES__discard() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES__free
+ *
+ * Purpose:     Releases an event set whose worker thread has stopped.
+ *              Doesn't call into the rest of the library, since a
+ *              detached worker thread calls it after the library has
+ *              shut down.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5ES__free(H5ES_t *es)
+{
+    pthread_cond_destroy(&es->done_cond);
+    pthread_cond_destroy(&es->work_cond);
+    pthread_mutex_destroy(&es->mutex);
+    HDfree(es);
+} /* end H5ES__free() */
+#endif /* H5ES_HAVE_WORKER */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES__wait
+ *
+ * Purpose:     Waits up to TIMEOUT nanoseconds for the operations in an
+ *              event set to complete.  The number of operations still in
+ *              progress and whether any operation has failed are returned
+ *              in NUM_IN_PROGRESS and OP_FAILED, when those are
+ *              non-NULL.
+ *
+ *              The library's API lock is released while waiting, so that
+ *              the worker thread can run the operations.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5ES__wait(H5ES_t *es, uint64_t timeout, size_t *num_in_progress,
+    hbool_t *op_failed)
+{
+#ifdef H5ES_HAVE_WORKER
+    unsigned int lock_count = 0;        /* API lock acquisitions released */
+    hbool_t     api_lock_released = FALSE;  /* Whether the API lock was released */
+#endif /* H5ES_HAVE_WORKER */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(es);
+
+#ifdef H5ES_HAVE_WORKER
+    if(pthread_mutex_lock(&es->mutex))
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTLOCK, FAIL, "can't lock event set")
+
+    if(es->num_pending > 0 && timeout > 0) {
+        struct timespec deadline;           /* When to stop waiting */
+
+        /* Compute the deadline for a finite timeout */
+        if(H5ES_WAIT_FOREVER != timeout) {
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += (time_t)(timeout / 1000000000);
+            deadline.tv_nsec += (long)(timeout % 1000000000);
+            if(deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+            } /* end if */
+        } /* end if */
+
+        /* Let the worker thread take the API lock */
+        if(H5TS_mutex_release(&H5_g.init_lock, &lock_count)) {
+            pthread_mutex_unlock(&es->mutex);
+            HGOTO_ERROR(H5E_EVENTSET, H5E_CANTUNLOCK, FAIL, "can't release API lock")
+        } /* end if */
+        api_lock_released = TRUE;
+
+        while(es->num_pending > 0) {
+            if(H5ES_WAIT_FOREVER == timeout)
+                pthread_cond_wait(&es->done_cond, &es->mutex);
+            else if(ETIMEDOUT == pthread_cond_timedwait(&es->done_cond, &es->mutex, &deadline))
+                break;
+        } /* end while */
+    } /* end if */
+
+    if(num_in_progress)
+        *num_in_progress = es->num_pending;
+    if(op_failed)
+        *op_failed = (hbool_t)(es->num_errs > 0);
+    pthread_mutex_unlock(&es->mutex);
+#else /* H5ES_HAVE_WORKER */
+    /* Operations complete as they're inserted */
+    if(num_in_progress)
+        *num_in_progress = es->num_pending;
+    if(op_failed)
+        *op_failed = (hbool_t)(es->num_errs > 0);
+#endif /* H5ES_HAVE_WORKER */
+
+done:
+#ifdef H5ES_HAVE_WORKER
+    /* Take the API lock back */
+    if(api_lock_released && H5TS_mutex_reacquire(&H5_g.init_lock, lock_count))
+        HDONE_ERROR(H5E_EVENTSET, H5E_CANTLOCK, FAIL, "can't reacquire API lock")
+#endif /* H5ES_HAVE_WORKER */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5ES__wait() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES__get_counts
+ *
+ * Purpose:     Retrieves the number of operations in an event set that
+ *              are still in progress and the number that have failed.
+ *              Either of NUM_IN_PROGRESS and NUM_ERRS may be NULL.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5ES__get_counts(H5ES_t *es, size_t *num_in_progress, size_t *num_errs)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(es);
+
+#ifdef H5ES_HAVE_WORKER
+    if(pthread_mutex_lock(&es->mutex))
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTLOCK, FAIL, "can't lock event set")
+#endif /* H5ES_HAVE_WORKER */
+    if(num_in_progress)
+        *num_in_progress = es->num_pending;
+    if(num_errs)
+        *num_errs = es->num_errs;
+#ifdef H5ES_HAVE_WORKER
+    pthread_mutex_unlock(&es->mutex);
+#endif /* H5ES_HAVE_WORKER */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5ES__get_counts() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5ES__close_cb
+ *
+ * Purpose:     Called when the reference count for an event set ID drops
+ *              to zero.  Waits for the event set's operations to complete,
+ *              stops its worker thread and releases it.
+ *
+ *              While the library shuts down, the API lock is held for
+ *              the whole shutdown and can't be given up to the worker
+ *              thread, so the operations that haven't started are
+ *              discarded instead of waited for.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5ES__close_cb(H5ES_t *es)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(es);
+
+#ifdef H5ES_HAVE_WORKER
+    if(H5_TERM_GLOBAL) {
+        hbool_t detached = FALSE;       /* Whether the worker releases the event set */
+
+        /* Discard the operations that haven't started */
+        if(H5ES__discard(es, &detached) < 0)
+            HDONE_ERROR(H5E_EVENTSET, H5E_CANTCLOSEOBJ, FAIL, "can't discard event set operations")
+        if(!detached)
+            H5ES__free(es);
+        HGOTO_DONE(ret_value)
+    } /* end if */
+#endif /* H5ES_HAVE_WORKER */
+
+    /* Wait for the operations in progress */
+    if(H5ES__wait(es, H5ES_WAIT_FOREVER, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_EVENTSET, H5E_CANTCLOSEOBJ, FAIL, "can't wait for event set operations")
+
+#ifdef H5ES_HAVE_WORKER
+    /* Stop the worker thread */
+    if(es->worker_started) {
+        pthread_mutex_lock(&es->mutex);
+        es->shutdown = TRUE;
+        pthread_cond_signal(&es->work_cond);
+        pthread_mutex_unlock(&es->mutex);
+        if(pthread_join(es->worker, NULL))
+            HGOTO_ERROR(H5E_EVENTSET, H5E_CANTCLOSEOBJ, FAIL, "can't join event set worker thread")
+    } /* end if */
+
+    H5ES__free(es);
+#else /* H5ES_HAVE_WORKER */
+    HDfree(es);
+#endif /* H5ES_HAVE_WORKER */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5ES__close_cb() */
+
@@ -0,0 +1,92 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: This file contains declarations which are visible only within
+ *          the H5ES package.  Source files outside the H5ES package should
+ *          include H5ESprivate.h instead.
+ */
+
+#if !(defined H5ES_FRIEND || defined H5ES_MODULE)
+#error "Do not include this file outside the H5ES package!"
+#endif
+
+#ifndef _H5ESpkg_H
+#define _H5ESpkg_H
+
+/* Include private header file */
+#include "H5ESprivate.h"        /* Event sets                           */
+
+/* Other private headers needed by this file */
+
+
+/**************************/
+/* Package Private Macros */
+/**************************/
+
+/* Operations are run on a background thread when the library is
+ * thread-safe, since the thread has to hold the library's API lock while
+ * it runs them.  Otherwise they are run as they are inserted.
+ */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5_HAVE_WIN_THREADS)
+#define H5ES_HAVE_WORKER
+#endif /* defined(H5_HAVE_THREADSAFE) && !defined(H5_HAVE_WIN_THREADS) */
+
+
+/****************************/
+/* Package Private Typedefs */
+/****************************/
+
+/* An operation waiting in an event set */
+typedef struct H5ES_op_t {
+    H5ES_op_func_t exec_func;           /* Callback that runs the operation */
+    H5ES_op_func_t release_func;        /* Callback that releases the operation's resources */
+    void *op_data;                      /* Data for the callbacks */
+    struct H5ES_op_t *next;             /* Next operation in the set */
+} H5ES_op_t;
+
+/* An event set: a queue of operations, which are run in the order they
+ * were inserted, and a record of how many have completed with an error.
+ */
+struct H5ES_t {
+    size_t num_pending;                 /* # of operations not yet completed */
+    size_t num_errs;                    /* # of operations that failed */
+#ifdef H5ES_HAVE_WORKER
+    pthread_mutex_t mutex;              /* Protects the fields below and the counts above */
+    pthread_cond_t work_cond;           /* Signals the worker about new operations or shutdown */
+    pthread_cond_t done_cond;           /* Signals waiters about completed operations */
+    H5ES_op_t *head;                    /* First operation waiting to run */
+    H5ES_op_t *tail;                    /* Last operation waiting to run */
+    hbool_t worker_started;             /* Whether the worker thread is running */
+    hbool_t worker_busy;                /* Whether the worker is about to take or is running an operation */
+    hbool_t shutdown;                   /* Whether the worker thread should exit */
+    hbool_t detached;                   /* Whether the worker thread releases the event set */
+    pthread_t worker;                   /* Thread that runs the operations */
+#endif /* H5ES_HAVE_WORKER */
+};
+
+
+/*****************************/
+/* Package Private Variables */
+/*****************************/
+
+
+/******************************/
+/* Package Private Prototypes */
+/******************************/
+H5_DLL H5ES_t *H5ES__create(void);
+H5_DLL herr_t H5ES__wait(H5ES_t *es, uint64_t timeout, size_t *num_in_progress,
+    hbool_t *op_failed);
+H5_DLL herr_t H5ES__get_counts(H5ES_t *es, size_t *num_in_progress, size_t *num_errs);
+
+#endif /* _H5ESpkg_H */
+
@@ -0,0 +1,58 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * This file contains private information about the H5ES module
+ */
+
+#ifndef _H5ESprivate_H
+#define _H5ESprivate_H
+
+/* Include package's public header */
+#include "H5ESpublic.h"
+
+/* Private headers needed by this file */
+#include "H5private.h"          /* Generic Functions                    */
+
+
+/**************************/
+/* Library Private Macros */
+/**************************/
+
+
+/****************************/
+/* Library Private Typedefs */
+/****************************/
+
+/* Event set */
+typedef struct H5ES_t H5ES_t;
+
+/* Callback for running, or releasing the resources of, an operation in an
+ * event set.  Both are called with the library's API context set up.
+ */
+typedef herr_t (*H5ES_op_func_t)(void *op_data);
+
+
+/*****************************/
+/* Library-private Variables */
+/*****************************/
+
+
+/***************************************/
+/* Library-private Function Prototypes */
+/***************************************/
+
+H5_DLL herr_t H5ES_insert(H5ES_t *es, H5ES_op_func_t exec_func,
+    H5ES_op_func_t release_func, void *op_data);
+
+#endif /* _H5ESprivate_H */
+
@@ -0,0 +1,67 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * This file contains public declarations for the H5ES module.
+ */
+
+#ifndef _H5ESpublic_H
+#define _H5ESpublic_H
+
+/* Public headers needed by this file */
+#include "H5public.h"           /* Generic Functions                    */
+#include "H5Ipublic.h"          /* IDs                                  */
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/* Event set ID for operations that should be performed synchronously */
+#define H5ES_NONE               0
+
+/* Special timeout values for H5ESwait(), in nanoseconds */
+#define H5ES_WAIT_FOREVER       (UINT64_MAX)
+#define H5ES_WAIT_NONE          (0)
+
+
+/*******************/
+/* Public Typedefs */
+/*******************/
+
+
+/********************/
+/* Public Variables */
+/********************/
+
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+H5_DLL hid_t H5EScreate(void);
+H5_DLL herr_t H5ESwait(hid_t es_id, uint64_t timeout, size_t *num_in_progress,
+    hbool_t *op_failed);
+H5_DLL herr_t H5ESget_count(hid_t es_id, size_t *count);
+H5_DLL herr_t H5ESget_err_status(hid_t es_id, hbool_t *op_failed);
+H5_DLL herr_t H5ESget_err_count(hid_t es_id, size_t *num_errs);
+H5_DLL herr_t H5ESclose(hid_t es_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _H5ESpublic_H */
+
@@ -820,14 +820,17 @@ H5E__push_stack(H5E_t *estack, const char *file, const char *func, unsigned line
 
     if(estack->nused < H5E_NSLOTS) {
         /* Increment the IDs to indicate that they are used in this stack */
-        if(H5I_inc_ref(cls_id, FALSE) < 0)
-            HGOTO_DONE(FAIL)
+        /* (Not from a helper thread, which mustn't touch the ID tables) */
+        if(!estack->helper) {
+            if(H5I_inc_ref(cls_id, FALSE) < 0)
+                HGOTO_DONE(FAIL)
+            if(H5I_inc_ref(maj_id, FALSE) < 0)
+                HGOTO_DONE(FAIL)
+            if(H5I_inc_ref(min_id, FALSE) < 0)
+                HGOTO_DONE(FAIL)
+        } /* end if */
 	estack->slot[estack->nused].cls_id = cls_id;
-        if(H5I_inc_ref(maj_id, FALSE) < 0)
-            HGOTO_DONE(FAIL)
 	estack->slot[estack->nused].maj_num = maj_id;
-        if(H5I_inc_ref(min_id, FALSE) < 0)
-            HGOTO_DONE(FAIL)
 	estack->slot[estack->nused].min_num = min_id;
 	if(NULL == (estack->slot[estack->nused].func_name = H5MM_xstrdup(func)))
             HGOTO_DONE(FAIL)
@@ -876,12 +879,14 @@ H5E_clear_entries(H5E_t *estack, size_t nentries)
 
         /* Decrement the IDs to indicate that they are no longer used by this stack */
         /* (In reverse order that they were incremented, so that reference counts work well) */
-        if(H5I_dec_ref(error->min_num) < 0)
-            HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
-        if(H5I_dec_ref(error->maj_num) < 0)
-            HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
-        if(H5I_dec_ref(error->cls_id) < 0)
-            HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error class")
+        if(!estack->helper) {
+            if(H5I_dec_ref(error->min_num) < 0)
+                HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
+            if(H5I_dec_ref(error->maj_num) < 0)
+                HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
+            if(H5I_dec_ref(error->cls_id) < 0)
+                HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error class")
+        } /* end if */
 
         /* Release strings */
         if(error->func_name)
@@ -1015,3 +1020,142 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5E_dump_api_stack() */
 
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5E_stack_empty
+ *
+ * Purpose:	Checks whether the current thread's error stack is empty,
+ *              without pushing to or clearing it.  API routines with a
+ *              shared read path use this to decide whether they may
+ *              return without the error stack being reset.
+ *
+ * Return:	TRUE if the stack is empty, FALSE otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5E_stack_empty(void)
+{
+    H5E_t *estack = H5E_get_my_stack();
+    hbool_t ret_value = TRUE;   /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(estack)
+        ret_value = (hbool_t)(estack->nused == 0);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5E_stack_empty() */
+
+#ifdef H5_HAVE_THREADSAFE
+
+/*-------------------------------------------------------------------------
+ * Function:	H5E_init_helper_stack
+ *
+ * Purpose:	Marks the error stack of the calling thread as the stack of
+ *              a thread the library started to help with API calls made
+ *              by other threads (e.g. to run the I/O filter pipeline).
+ *              Errors pushed on such a stack don't take references to
+ *              their class and message IDs, since the ID tables belong
+ *              to the thread holding the API lock.  The thread being
+ *              helped takes the errors with H5E_take_helper_errors() and
+ *              reports them with H5E_push_helper_errors().
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5E_init_helper_stack(void)
+{
+    H5E_t *estack = H5E_get_my_stack();
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(estack);
+    HDassert(0 == estack->nused);
+
+    estack->helper = TRUE;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5E_init_helper_stack() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5E_take_helper_errors
+ *
+ * Purpose:	Moves the errors on a helper thread's error stack (see
+ *              H5E_init_helper_stack()) into a new stack, leaving the
+ *              helper's stack empty.  The new stack is passed to
+ *              H5E_push_helper_errors() by the thread being helped.
+ *
+ * Return:	Success:	The errors, or NULL if there weren't any
+ *		Failure:	NULL (the errors are dropped)
+ *
+ *-------------------------------------------------------------------------
+ */
+H5E_t *
+H5E_take_helper_errors(void)
+{
+    H5E_t *estack = H5E_get_my_stack();
+    H5E_t *ret_value = NULL;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(estack);
+    HDassert(estack->helper);
+
+    if(estack->nused > 0) {
+        /* Use HDmalloc, since the free lists aren't safe to use from a
+         * helper thread */
+        if(NULL != (ret_value = (H5E_t *)HDmalloc(sizeof(H5E_t)))) {
+            HDmemcpy(ret_value, estack, sizeof(H5E_t));
+            estack->nused = 0;
+        } /* end if */
+        else
+            (void)H5E_clear_entries(estack, estack->nused);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5E_take_helper_errors() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5E_push_helper_errors
+ *
+ * Purpose:	Pushes the errors taken from a helper thread with
+ *              H5E_take_helper_errors() onto the calling thread's error
+ *              stack, in the order they were pushed on the helper's, and
+ *              releases them.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5E_push_helper_errors(H5E_t *errors)
+{
+    size_t u;                   /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(errors);
+    HDassert(errors->helper);
+
+    for(u = 0; u < errors->nused; u++) {
+        H5E_error2_t *error = &errors->slot[u];
+
+        if(H5E__push_stack(NULL, error->file_name, error->func_name, error->line,
+                error->cls_id, error->maj_num, error->min_num, error->desc) < 0)
+            ret_value = FAIL;
+    } /* end for */
+    (void)H5E_clear_entries(errors, errors->nused);
+    HDfree(errors);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5E_push_helper_errors() */
+#endif /* H5_HAVE_THREADSAFE */
+
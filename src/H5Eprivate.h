@@ -183,6 +183,12 @@ H5_DLL herr_t H5E_printf_stack(H5E_t *estack, const char *file, const char *func
     unsigned line, hid_t cls_id, hid_t maj_id, hid_t min_id, const char *fmt, ...)H5_ATTR_FORMAT(printf, 8, 9);
 H5_DLL herr_t H5E_clear_stack(H5E_t *estack);
 H5_DLL herr_t H5E_dump_api_stack(hbool_t is_api);
+H5_DLL hbool_t H5E_stack_empty(void);
+#ifdef H5_HAVE_THREADSAFE
+H5_DLL void H5E_init_helper_stack(void);
+H5_DLL H5E_t *H5E_take_helper_errors(void);
+H5_DLL herr_t H5E_push_helper_errors(H5E_t *errors);
+#endif /* H5_HAVE_THREADSAFE */
 
 #endif /* _H5Eprivate_H */
 
@@ -27,6 +27,7 @@
 #include "H5CXprivate.h"        /* API Contexts                         */
 #include "H5Dprivate.h"         /* Datasets                             */
 #include "H5Eprivate.h"         /* Error handling                       */
+#include "H5ESprivate.h"        /* Event sets                           */
 #include "H5Fpkg.h"             /* File access                          */
 #include "H5FDprivate.h"        /* File drivers                         */
 #include "H5Gprivate.h"         /* Groups                               */
@@ -45,6 +46,12 @@
 /* Local Typedefs */
 /******************/
 
+/* Information about a file flush queued in an event set */
+typedef struct H5F_async_flush_t {
+    hid_t       object_id;      /* File or object in the file (reference held) */
+    H5F_scope_t scope;          /* Scope of the flush */
+} H5F_async_flush_t;
+
 
 /********************/
 /* Package Typedefs */
@@ -55,6 +62,11 @@
 /* Local Prototypes */
 /********************/
 
+static H5F_t *H5F__get_flush_file(hid_t object_id);
+static herr_t H5F__flush_object(hid_t object_id, H5F_scope_t scope);
+static herr_t H5F__flush_async_exec(void *op_data);
+static herr_t H5F__flush_async_release(void *op_data);
+
 
 /*********************/
 /* Package Variables */
@@ -524,29 +536,28 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function: H5Fflush
+ * Function: H5F__get_flush_file
  *
- * Purpose:  Flushes all outstanding buffers of a file to disk but does
- *           not remove them from the cache.  The OBJECT_ID can be a file,
- *           dataset, group, attribute, or named data type.
+ * Purpose:  Look up the file that a file, dataset, group, attribute or
+ *           named datatype ID belongs to, for flushing.
  *
- * Return:   Non-negative on success/Negative on failure
+ * Return:   Success:    Pointer to the file
+ *           Failure:    NULL
  *-------------------------------------------------------------------------
  */
-herr_t
-H5Fflush(hid_t object_id, H5F_scope_t scope)
+static H5F_t *
+H5F__get_flush_file(hid_t object_id)
 {
     H5F_t      *f = NULL;              /* File to flush */
     H5O_loc_t  *oloc = NULL;           /* Object location for ID */
-    herr_t      ret_value = SUCCEED;   /* Return value */
+    H5F_t      *ret_value = NULL;      /* Return value */
 
-    FUNC_ENTER_API(FAIL)
-    H5TRACE2("e", "iFs", object_id, scope);
+    FUNC_ENTER_STATIC
 
     switch(H5I_get_type(object_id)) {
         case H5I_FILE:
             if(NULL == (f = (H5F_t *)H5I_object(object_id)))
-                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid file identifier")
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "invalid file identifier")
             break;
 
         case H5I_GROUP:
@@ -554,7 +565,7 @@ H5Fflush(hid_t object_id, H5F_scope_t scope)
                 H5G_t    *grp;
 
                 if(NULL == (grp = (H5G_t *)H5I_object(object_id)))
-                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid group identifier")
+                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "invalid group identifier")
                 oloc = H5G_oloc(grp);
             }
             break;
@@ -564,7 +575,7 @@ H5Fflush(hid_t object_id, H5F_scope_t scope)
                 H5T_t    *type;
 
                 if(NULL == (type = (H5T_t *)H5I_object(object_id)))
-                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid type identifier")
+                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "invalid type identifier")
                 oloc = H5T_oloc(type);
             }
             break;
@@ -574,7 +585,7 @@ H5Fflush(hid_t object_id, H5F_scope_t scope)
                 H5D_t    *dset;
 
                 if(NULL == (dset = (H5D_t *)H5I_object(object_id)))
-                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid dataset identifier")
+                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "invalid dataset identifier")
                 oloc = H5D_oloc(dset);
             }
             break;
@@ -584,7 +595,7 @@ H5Fflush(hid_t object_id, H5F_scope_t scope)
                 H5A_t    *attr;
 
                 if(NULL == (attr = (H5A_t *)H5I_object(object_id)))
-                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid attribute identifier")
+                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "invalid attribute identifier")
                 oloc = H5A_oloc(attr);
             }
             break;
@@ -599,18 +610,48 @@ H5Fflush(hid_t object_id, H5F_scope_t scope)
         case H5I_ERROR_CLASS:
         case H5I_ERROR_MSG:
         case H5I_ERROR_STACK:
+        case H5I_EVENTSET:
         case H5I_NTYPES:
         default:
-            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file or file object")
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "not a file or file object")
     } /* end switch */
 
     if(!f) {
         if(!oloc)
-            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "object is not assocated with a file")
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "object is not assocated with a file")
         f = oloc->file;
     } /* end if */
     if(!f)
-        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "object is not associated with a file")
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "object is not associated with a file")
+
+    /* Set return value */
+    ret_value = f;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__get_flush_file() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5F__flush_object
+ *
+ * Purpose:  Flush the file that OBJECT_ID belongs to.  Common code for
+ *           H5Fflush and H5Fflush_async.
+ *
+ * Return:   Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__flush_object(hid_t object_id, H5F_scope_t scope)
+{
+    H5F_t      *f;                     /* File to flush */
+    herr_t      ret_value = SUCCEED;   /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(NULL == (f = H5F__get_flush_file(object_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file or file object")
 
     /* Flush the file */
     /*
@@ -632,10 +673,150 @@ H5Fflush(hid_t object_id, H5F_scope_t scope)
             HGOTO_ERROR(H5E_FILE, H5E_CANTFLUSH, FAIL, "unable to flush file's cached information")
     } /* end if */
 
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__flush_object() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5F__flush_async_exec
+ *
+ * Purpose:  Event set callback that performs a queued file flush.
+ *
+ * Return:   Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__flush_async_exec(void *op_data)
+{
+    H5F_async_flush_t *op = (H5F_async_flush_t *)op_data;  /* Queued flush */
+    herr_t      ret_value = SUCCEED;   /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(H5F__flush_object(op->object_id, op->scope) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTFLUSH, FAIL, "unable to flush file")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__flush_async_exec() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5F__flush_async_release
+ *
+ * Purpose:  Event set callback that drops the reference held by a queued
+ *           file flush.
+ *
+ * Return:   Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__flush_async_release(void *op_data)
+{
+    H5F_async_flush_t *op = (H5F_async_flush_t *)op_data;  /* Queued flush */
+    herr_t      ret_value = SUCCEED;   /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(H5I_dec_ref(op->object_id) < 0)
+        HDONE_ERROR(H5E_ATOM, H5E_CANTDEC, FAIL, "can't decrement ID reference count")
+    op = (H5F_async_flush_t *)H5MM_xfree(op);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__flush_async_release() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5Fflush
+ *
+ * Purpose:  Flushes all outstanding buffers of a file to disk but does
+ *           not remove them from the cache.  The OBJECT_ID can be a file,
+ *           dataset, group, attribute, or named data type.
+ *
+ * Return:   Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Fflush(hid_t object_id, H5F_scope_t scope)
+{
+    herr_t      ret_value = SUCCEED;   /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iFs", object_id, scope);
+
+    if(H5F__flush_object(object_id, scope) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTFLUSH, FAIL, "unable to flush file")
+
 done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Fflush() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5Fflush_async
+ *
+ * Purpose:  Asynchronous version of H5Fflush.  The flush is queued in the
+ *           event set ES_ID behind any I/O already queued there, so
+ *           waiting on the event set guarantees that data written with
+ *           H5Dwrite_async has reached the file.  OBJECT_ID may be
+ *           closed as soon as this call returns.
+ *
+ *           If ES_ID is H5ES_NONE the flush is performed synchronously.
+ *
+ * Return:   Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Fflush_async(hid_t object_id, H5F_scope_t scope, hid_t es_id)
+{
+    H5ES_t     *es;                    /* Event set */
+    H5F_async_flush_t *op = NULL;      /* Queued flush */
+    herr_t      ret_value = SUCCEED;   /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "iFsi", object_id, scope, es_id);
+
+    if(H5ES_NONE == es_id) {
+        if(H5F__flush_object(object_id, scope) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_CANTFLUSH, FAIL, "unable to flush file")
+    } /* end if */
+    else {
+        /* Check arguments */
+        if(NULL == (es = (H5ES_t *)H5I_object_verify(es_id, H5I_EVENTSET)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an event set")
+        if(NULL == H5F__get_flush_file(object_id))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file or file object")
+
+        /* Hold the object open until the flush runs */
+        if(NULL == (op = (H5F_async_flush_t *)H5MM_malloc(sizeof(H5F_async_flush_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for flush operation")
+        if(H5I_inc_ref(object_id, FALSE) < 0)
+            HGOTO_ERROR(H5E_ATOM, H5E_CANTINC, FAIL, "can't increment ID reference count")
+        op->object_id = object_id;
+        op->scope = scope;
+
+        /* Queue the flush; the event set owns the operation from here on */
+        if(H5ES_insert(es, H5F__flush_async_exec, H5F__flush_async_release, op) < 0) {
+            if(H5F__flush_async_release(op) < 0)
+                HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "can't release flush operation")
+            op = NULL;
+            HGOTO_ERROR(H5E_FILE, H5E_CANTINSERT, FAIL, "can't queue flush in event set")
+        } /* end if */
+        op = NULL;
+    } /* end else */
+
+done:
+    if(op)
+        op = (H5F_async_flush_t *)H5MM_xfree(op);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Fflush_async() */
+
 
 /*-------------------------------------------------------------------------
  * Function: H5Fclose
@@ -933,7 +1114,8 @@ H5Fget_mdc_config(hid_t file_id, H5AC_cache_config_t *config_ptr)
     /* Check args */
     if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
-    if((NULL == config_ptr) || (config_ptr->version != H5AC__CURR_CACHE_CONFIG_VERSION))
+    if((NULL == config_ptr) || (config_ptr->version < H5AC__MIN_CACHE_CONFIG_VERSION)
+            || (config_ptr->version > H5AC__CURR_CACHE_CONFIG_VERSION))
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Bad config_ptr")
 
     /* Go get the resize configuration */
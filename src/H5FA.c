@@ -680,12 +680,13 @@ END_FUNC(PRIV)  /* end H5FA_delete() */
 /*-------------------------------------------------------------------------
  * Function:    H5FA_iterate
  *
- * Purpose:     Iterate over the elements of a fixed array
+ * Purpose:     Iterate over the elements of a fixed array, stopping
+ *              early when the callback returns a positive value
  *
  * Note:        This is not very efficient, we should be iterating directly
  *              over the fixed array's direct block [pages].
  *
- * Return:      SUCCEED/FAIL
+ * Return:      SUCCEED/FAIL, or the callback's positive value
  *
  * Programmer:  Vailin Choi
  *              Thursday, April 30, 2009
@@ -724,6 +725,10 @@ H5FA_iterate(H5FA_t *fa, H5FA_operator_t op, void *udata))
             H5E_PRINTF(H5E_BADITER, "iterator function failed");
             H5_LEAVE(cb_ret)
         } /* end if */
+
+        /* Stop early if the callback asks to */
+        if(cb_ret > 0)
+            H5_LEAVE(cb_ret)
     } /* end for */
 
 CATCH
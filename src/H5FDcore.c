@@ -174,7 +174,10 @@ static const H5FD_class_t H5FD_core_g = {
     H5FD__core_truncate,        /* truncate             */
     H5FD_core_lock,             /* lock                 */
     H5FD_core_unlock,           /* unlock               */
-    H5FD_FLMAP_DICHOTOMY        /* fl_map               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    NULL,                       /* read_vector          */
+    NULL,                       /* write_vector         */
+    NULL                        /* get_ptr              */
 };
 
 /* Define a free list to manage the region type */
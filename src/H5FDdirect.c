@@ -171,7 +171,10 @@ static const H5FD_class_t H5FD_direct_g = {
     H5FD_direct_truncate,      	/*truncate    */
     H5FD_direct_lock,          	/*lock                  */
     H5FD_direct_unlock,        	/*unlock                */
-    H5FD_FLMAP_DICHOTOMY       	/*fl_map                */
+    H5FD_FLMAP_DICHOTOMY,      	/*fl_map                */
+    NULL,                     /*read_vector  */
+    NULL,                     /*write_vector */
+    NULL                      /*get_ptr */
 };
 
 /* Declare a free list to manage the H5FD_direct_t struct */
@@ -139,7 +139,10 @@ static const H5FD_class_t H5FD_family_g = {
     H5FD_family_truncate,			/*truncate		*/
     H5FD_family_lock,                           /*lock                  */
     H5FD_family_unlock,                         /*unlock                */
-    H5FD_FLMAP_DICHOTOMY                        /*fl_map                */
+    H5FD_FLMAP_DICHOTOMY,                       /*fl_map                */
+    NULL,                                       /*read_vector           */
+    NULL,                                       /*write_vector          */
+    NULL                                        /*get_ptr               */
 };
 
 
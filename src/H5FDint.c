@@ -38,6 +38,7 @@
 #include "H5Fprivate.h"         /* File access				*/
 #include "H5FDpkg.h"		/* File Drivers				*/
 #include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 
 
 /****************/
@@ -261,6 +262,233 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_read_vector
+ *
+ * Purpose:	Read COUNT blocks of data from the file in a single
+ *              operation.  Block U has memory type TYPES[U], is SIZES[U]
+ *              bytes long, starts at (relative) address ADDRS[U] and is
+ *              read into BUFS[U].
+ *
+ *              If the driver provides a 'read_vector' callback the whole
+ *              vector is passed to the driver at once, otherwise the
+ *              blocks are read with individual 'read' callbacks.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_read_vector(H5FD_t *file, uint32_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/)
+{
+    hid_t dxpl_id;                      /* DXPL for operation */
+    haddr_t *abs_addrs = NULL;          /* Absolute addresses for driver */
+    uint32_t u;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(file && file->cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* Get proper DXPL for I/O */
+    dxpl_id = H5CX_get_dxpl();
+
+    /* Check each block against the EOA, as H5FD_read() does */
+    if(!(file->access_flags & H5F_ACC_SWMR_READ))
+        for(u = 0; u < count; u++) {
+            haddr_t     eoa;
+
+            HDassert(bufs[u]);
+
+            if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, types[u])))
+                HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+            if((addrs[u] + file->base_addr + sizes[u]) > eoa)
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu, eoa = %llu", (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u], (unsigned long long)eoa)
+        } /* end for */
+
+    /* Dispatch to driver */
+    if(file->cls->read_vector) {
+        const haddr_t *drvr_addrs = addrs;      /* Addresses to pass to driver */
+
+        /* Convert to absolute addresses, if there's a base address */
+        if(file->base_addr > 0) {
+            if(NULL == (abs_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for address vector")
+            for(u = 0; u < count; u++)
+                abs_addrs[u] = addrs[u] + file->base_addr;
+            drvr_addrs = abs_addrs;
+        } /* end if */
+
+        if((file->cls->read_vector)(file, dxpl_id, count, types, drvr_addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read vector request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++) {
+#ifndef H5_HAVE_PARALLEL
+            /* The no-op case */
+            if(0 == sizes[u])
+                continue;
+#endif /* H5_HAVE_PARALLEL */
+
+            if((file->cls->read)(file, types[u], dxpl_id, addrs[u] + file->base_addr, sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read request failed")
+        } /* end for */
+
+done:
+    if(abs_addrs)
+        abs_addrs = (haddr_t *)H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_read_vector() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_write_vector
+ *
+ * Purpose:	Write COUNT blocks of data to the file in a single
+ *              operation.  Block U has memory type TYPES[U], is SIZES[U]
+ *              bytes long, starts at (relative) address ADDRS[U] and is
+ *              written from BUFS[U].
+ *
+ *              If the driver provides a 'write_vector' callback the whole
+ *              vector is passed to the driver at once, otherwise the
+ *              blocks are written with individual 'write' callbacks.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_write_vector(H5FD_t *file, uint32_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    hid_t dxpl_id;                      /* DXPL for operation */
+    haddr_t *abs_addrs = NULL;          /* Absolute addresses for driver */
+    uint32_t u;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(file && file->cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* Get proper DXPL for I/O */
+    dxpl_id = H5CX_get_dxpl();
+
+    /* Check each block against the EOA, as H5FD_write() does */
+    for(u = 0; u < count; u++) {
+        haddr_t     eoa;
+
+        HDassert(bufs[u]);
+
+        if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, types[u])))
+            HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+        if((addrs[u] + file->base_addr + sizes[u]) > eoa)
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size=%llu, eoa=%llu",
+                        (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u], (unsigned long long)eoa)
+    } /* end for */
+
+    /* Dispatch to driver */
+    if(file->cls->write_vector) {
+        const haddr_t *drvr_addrs = addrs;      /* Addresses to pass to driver */
+
+        /* Convert to absolute addresses, if there's a base address */
+        if(file->base_addr > 0) {
+            if(NULL == (abs_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for address vector")
+            for(u = 0; u < count; u++)
+                abs_addrs[u] = addrs[u] + file->base_addr;
+            drvr_addrs = abs_addrs;
+        } /* end if */
+
+        if((file->cls->write_vector)(file, dxpl_id, count, types, drvr_addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver write vector request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++) {
+#ifndef H5_HAVE_PARALLEL
+            /* The no-op case */
+            if(0 == sizes[u])
+                continue;
+#endif /* H5_HAVE_PARALLEL */
+
+            if((file->cls->write)(file, types[u], dxpl_id, addrs[u] + file->base_addr, sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver write request failed")
+        } /* end for */
+
+done:
+    if(abs_addrs)
+        abs_addrs = (haddr_t *)H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_write_vector() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_get_ptr
+ *
+ * Purpose:	Retrieve a pointer to SIZE bytes of the file starting at
+ *              (relative) address ADDR, for drivers that keep the file's
+ *              contents addressable in memory.  The pointer is only valid
+ *              until the file is closed and must not be written through.
+ *
+ *              If the driver doesn't provide a 'get_ptr' callback, or
+ *              can't expose the requested range, *PTR is set to NULL and
+ *              the caller should fall back to reading the data.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_get_ptr(H5FD_t *file, H5FD_mem_t type, haddr_t addr, size_t size,
+    const void **ptr/*out*/)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(file && file->cls);
+    HDassert(ptr);
+
+    /* Default to no pointer */
+    *ptr = NULL;
+
+    /* Check for driver support */
+    if(NULL == file->cls->get_ptr || 0 == size)
+        HGOTO_DONE(SUCCEED)
+
+    /* The range must lie entirely within the allocated space */
+    if(!(file->access_flags & H5F_ACC_SWMR_READ)) {
+        haddr_t     eoa;
+
+        if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, type)))
+            HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+
+        if((addr + file->base_addr + size) > eoa)
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu, eoa = %llu", (unsigned long long)(addr + file->base_addr), (unsigned long long)size, (unsigned long long)eoa)
+    } /* end if */
+
+    /* Dispatch to driver */
+    if((file->cls->get_ptr)(file, type, addr + file->base_addr, size, ptr) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTGET, FAIL, "driver get_ptr request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_get_ptr() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5FD_set_eoa
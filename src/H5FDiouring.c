@@ -0,0 +1,1373 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: A Linux file driver based on io_uring.  Single blocks are read
+ *          and written with pread() and pwrite(), as in the sec2 driver,
+ *          but vector requests (see the 'read_vector' and 'write_vector'
+ *          callbacks) are queued on an io_uring instance as one batch of
+ *          up to 'queue_depth' requests and their completions are reaped
+ *          together, so the device sees many requests in flight at once.
+ *
+ *          The ring is driven with the raw system calls, so no external
+ *          library is required.  When the kernel doesn't allow io_uring
+ *          to be set up (e.g. it is disabled by a seccomp policy) the
+ *          driver falls back to issuing the requests one at a time.
+ */
+
+#include "H5FDdrvr_module.h" /* This source code file is part of the H5FD driver module */
+
+
+#include "H5private.h"      /* Generic Functions        */
+#include "H5Eprivate.h"     /* Error handling           */
+#include "H5Fprivate.h"     /* File access              */
+#include "H5FDprivate.h"    /* File drivers             */
+#include "H5FDiouring.h"    /* io_uring file driver     */
+#include "H5FLprivate.h"    /* Free Lists               */
+#include "H5Iprivate.h"     /* IDs                      */
+#include "H5MMprivate.h"    /* Memory management        */
+#include "H5Pprivate.h"     /* Property lists           */
+
+#ifdef H5_HAVE_IOURING
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+
+/* The driver identification number, initialized at runtime */
+static hid_t H5FD_IOURING_g = 0;
+
+/* Wrappers for the io_uring system calls */
+#define H5FD_IOURING_SETUP(E, P)            ((int)syscall(__NR_io_uring_setup, (E), (P)))
+#define H5FD_IOURING_ENTER(F, S, C, FL)     ((int)syscall(__NR_io_uring_enter, (F), (S), (C), (FL), NULL, 0))
+
+/* Ring head and tail indices are shared with the kernel */
+#define H5FD_IOURING_LOAD_ACQUIRE(P)        __atomic_load_n((P), __ATOMIC_ACQUIRE)
+#define H5FD_IOURING_STORE_RELEASE(P, V)    __atomic_store_n((P), (V), __ATOMIC_RELEASE)
+
+/* Driver-specific file access properties */
+typedef struct H5FD_iouring_fapl_t {
+    unsigned    queue_depth;    /* Maximum number of requests in flight */
+} H5FD_iouring_fapl_t;
+
+/* An io_uring instance, with its submission and completion queues mapped
+ * into memory.  The submission queue entries are filled in by the driver
+ * and the completion queue entries by the kernel; each side publishes its
+ * progress by updating the queue's tail.  When the kernel can't set up a
+ * ring, 'fd' is -1 and the rest of the struct is unused.
+ */
+typedef struct H5FD_iouring_ring_t {
+    int                 fd;             /* io_uring instance descriptor     */
+    unsigned            entries;        /* # of submission queue entries    */
+    void               *sq_ring;        /* submission queue ring mapping    */
+    size_t              sq_ring_size;   /* size of submission queue mapping */
+    void               *cq_ring;        /* completion queue ring mapping    */
+    size_t              cq_ring_size;   /* size of completion queue mapping */
+    struct io_uring_sqe *sqes;          /* submission queue entries         */
+    size_t              sqes_size;      /* size of submission entry mapping */
+    unsigned           *sq_head;        /* submission queue head (kernel)   */
+    unsigned           *sq_tail;        /* submission queue tail (driver)   */
+    unsigned           *sq_mask;        /* submission queue index mask      */
+    unsigned           *sq_array;       /* submission queue index array     */
+    unsigned           *cq_head;        /* completion queue head (driver)   */
+    unsigned           *cq_tail;        /* completion queue tail (kernel)   */
+    unsigned           *cq_mask;        /* completion queue index mask      */
+    struct io_uring_cqe *cqes;          /* completion queue entries         */
+    struct iovec       *iov;            /* I/O vectors for queued requests  */
+} H5FD_iouring_ring_t;
+
+/* The description of a file belonging to this driver. The 'eoa' and 'eof'
+ * determine the amount of hdf5 address space in use and the high-water mark
+ * of the file (the current size of the underlying filesystem file).  All
+ * I/O is positional, so the driver never changes the file position.
+ */
+typedef struct H5FD_iouring_t {
+    H5FD_t              pub;    /* public stuff, must be first      */
+    int                 fd;     /* the filesystem file descriptor   */
+    haddr_t             eoa;    /* end of allocated region          */
+    haddr_t             eof;    /* end of file; current file size   */
+    H5FD_iouring_fapl_t fa;     /* file access properties           */
+    H5FD_iouring_ring_t ring;   /* io_uring instance for the file   */
+    char                filename[H5FD_MAX_FILENAME_LEN];    /* Copy of file name from open operation */
+
+    /* On most systems the combination of device and i-node number uniquely
+     * identify a file.
+     */
+    dev_t               device;     /* file device number   */
+    ino_t               inode;      /* file i-node number   */
+} H5FD_iouring_t;
+
+/*
+ * These macros check for overflow of various quantities.  These macros
+ * assume that HDoff_t is signed and haddr_t and size_t are unsigned.
+ *
+ * ADDR_OVERFLOW:   Checks whether a file address of type `haddr_t'
+ *                  is too large to be represented by the second argument
+ *                  of the file seek function.
+ *
+ * SIZE_OVERFLOW:   Checks whether a buffer size of type `hsize_t' is too
+ *                  large to be represented by the `size_t' type.
+ *
+ * REGION_OVERFLOW: Checks whether an address and size pair describe data
+ *                  which can be addressed entirely by the second
+ *                  argument of the file seek function.
+ */
+#define MAXADDR (((haddr_t)1<<(8*sizeof(HDoff_t)-1))-1)
+#define ADDR_OVERFLOW(A)    (HADDR_UNDEF==(A) || ((A) & ~(haddr_t)MAXADDR))
+#define SIZE_OVERFLOW(Z)    ((Z) & ~(hsize_t)MAXADDR)
+#define REGION_OVERFLOW(A,Z)    (ADDR_OVERFLOW(A) || SIZE_OVERFLOW(Z) ||    \
+                                 HADDR_UNDEF==(A)+(Z) ||                    \
+                                (HDoff_t)((A)+(Z))<(HDoff_t)(A))
+
+/* Prototypes */
+static herr_t H5FD_iouring_term(void);
+static void *H5FD_iouring_fapl_get(H5FD_t *_file);
+static void *H5FD_iouring_fapl_copy(const void *_old_fa);
+static H5FD_t *H5FD_iouring_open(const char *name, unsigned flags, hid_t fapl_id,
+            haddr_t maxaddr);
+static herr_t H5FD_iouring_close(H5FD_t *_file);
+static int H5FD_iouring_cmp(const H5FD_t *_f1, const H5FD_t *_f2);
+static herr_t H5FD_iouring_query(const H5FD_t *_f1, unsigned long *flags);
+static haddr_t H5FD_iouring_get_eoa(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t H5FD_iouring_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr);
+static haddr_t H5FD_iouring_get_eof(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t H5FD_iouring_get_handle(H5FD_t *_file, hid_t fapl, void** file_handle);
+static herr_t H5FD_iouring_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, void *buf);
+static herr_t H5FD_iouring_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, const void *buf);
+static herr_t H5FD_iouring_read_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            void *bufs[]);
+static herr_t H5FD_iouring_write_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            const void *bufs[]);
+static herr_t H5FD_iouring_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
+static herr_t H5FD_iouring_lock(H5FD_t *_file, hbool_t rw);
+static herr_t H5FD_iouring_unlock(H5FD_t *_file);
+static herr_t H5FD__iouring_ring_init(H5FD_iouring_ring_t *ring, unsigned entries);
+static herr_t H5FD__iouring_ring_term(H5FD_iouring_ring_t *ring);
+static herr_t H5FD__iouring_vector(H5FD_iouring_t *file, hbool_t do_write,
+            hid_t dxpl_id, uint32_t count, const H5FD_mem_t types[],
+            const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+
+static const H5FD_class_t H5FD_iouring_g = {
+    "iouring",                  /* name                 */
+    MAXADDR,                    /* maxaddr              */
+    H5F_CLOSE_WEAK,             /* fc_degree            */
+    H5FD_iouring_term,          /* terminate            */
+    NULL,                       /* sb_size              */
+    NULL,                       /* sb_encode            */
+    NULL,                       /* sb_decode            */
+    sizeof(H5FD_iouring_fapl_t), /* fapl_size           */
+    H5FD_iouring_fapl_get,      /* fapl_get             */
+    H5FD_iouring_fapl_copy,     /* fapl_copy            */
+    NULL,                       /* fapl_free            */
+    0,                          /* dxpl_size            */
+    NULL,                       /* dxpl_copy            */
+    NULL,                       /* dxpl_free            */
+    H5FD_iouring_open,          /* open                 */
+    H5FD_iouring_close,         /* close                */
+    H5FD_iouring_cmp,           /* cmp                  */
+    H5FD_iouring_query,         /* query                */
+    NULL,                       /* get_type_map         */
+    NULL,                       /* alloc                */
+    NULL,                       /* free                 */
+    H5FD_iouring_get_eoa,       /* get_eoa              */
+    H5FD_iouring_set_eoa,       /* set_eoa              */
+    H5FD_iouring_get_eof,       /* get_eof              */
+    H5FD_iouring_get_handle,    /* get_handle           */
+    H5FD_iouring_read,          /* read                 */
+    H5FD_iouring_write,         /* write                */
+    NULL,                       /* flush                */
+    H5FD_iouring_truncate,      /* truncate             */
+    H5FD_iouring_lock,          /* lock                 */
+    H5FD_iouring_unlock,        /* unlock               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD_iouring_read_vector,   /* read_vector          */
+    H5FD_iouring_write_vector,  /* write_vector         */
+    NULL                        /* get_ptr              */
+};
+
+/* Declare a free list to manage the H5FD_iouring_t struct */
+H5FL_DEFINE_STATIC(H5FD_iouring_t);
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__init_package
+ *
+ * Purpose:     Initializes any interface-specific data or routines.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__init_package(void)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if(H5FD_iouring_init() < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to initialize io_uring VFD")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5FD__init_package() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_init
+ *
+ * Purpose:     Initialize this driver by registering the driver with the
+ *              library.
+ *
+ * Return:      Success:    The driver ID for the io_uring driver.
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+hid_t
+H5FD_iouring_init(void)
+{
+    hid_t ret_value = H5I_INVALID_HID;          /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if(H5I_VFL != H5I_get_type(H5FD_IOURING_g))
+        H5FD_IOURING_g = H5FD_register(&H5FD_iouring_g, sizeof(H5FD_class_t), FALSE);
+
+    /* Set return value */
+    ret_value = H5FD_IOURING_g;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_init() */
+
+
+
+/*---------------------------------------------------------------------------
+ * Function:    H5FD_iouring_term
+ *
+ * Purpose:     Shut down the VFD
+ *
+ * Returns:     SUCCEED (Can't fail)
+ *
+ *---------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_term(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Reset VFL ID */
+    H5FD_IOURING_g = 0;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_iouring_term() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_fapl_iouring
+ *
+ * Purpose:     Modify the file access property list to use the
+ *              H5FD_IOURING driver defined in this source file.
+ *              QUEUE_DEPTH is the maximum number of requests submitted
+ *              to the kernel at once; zero selects the default.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_fapl_iouring(hid_t fapl_id, unsigned queue_depth)
+{
+    H5P_genplist_t      *plist;      /* Property list pointer */
+    H5FD_iouring_fapl_t fa;         /* io_uring VFD properties */
+    herr_t ret_value;
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", fapl_id, queue_depth);
+
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access property list")
+
+    fa.queue_depth = (queue_depth > 0) ? queue_depth : H5FD_IOURING_QUEUE_DEPTH_DEF;
+
+    ret_value = H5P_set_driver(plist, H5FD_IOURING, &fa);
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_fapl_iouring() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_fapl_iouring
+ *
+ * Purpose:     Returns information about the io_uring file access property
+ *              list through the function arguments.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_fapl_iouring(hid_t fapl_id, unsigned *queue_depth /*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    const H5FD_iouring_fapl_t *fa;  /* io_uring VFD properties */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", fapl_id, queue_depth);
+
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access list")
+    if(H5FD_IOURING != H5P_peek_driver(plist))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "incorrect VFL driver")
+    if(NULL == (fa = (const H5FD_iouring_fapl_t *)H5P_peek_driver_info(plist)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "bad VFL driver info")
+    if(queue_depth)
+        *queue_depth = fa->queue_depth;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_fapl_iouring() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_fapl_get
+ *
+ * Purpose:     Returns a file access property list which indicates how the
+ *              specified file is being accessed. The return list could be
+ *              used to access another file the same way.
+ *
+ * Return:      Success:    Ptr to new file access property list with all
+ *                          members copied from the file struct.
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD_iouring_fapl_get(H5FD_t *_file)
+{
+    H5FD_iouring_t  *file = (H5FD_iouring_t *)_file;
+    void *ret_value;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Set return value */
+    ret_value = H5FD_iouring_fapl_copy(&(file->fa));
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_fapl_get() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_fapl_copy
+ *
+ * Purpose:     Copies the io_uring-specific file access properties.
+ *
+ * Return:      Success:    Ptr to a new property list
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD_iouring_fapl_copy(const void *_old_fa)
+{
+    const H5FD_iouring_fapl_t *old_fa = (const H5FD_iouring_fapl_t *)_old_fa;
+    H5FD_iouring_fapl_t *new_fa = NULL;     /* New fapl info */
+    void *ret_value = NULL;                 /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(NULL == (new_fa = (H5FD_iouring_fapl_t *)H5MM_malloc(sizeof(H5FD_iouring_fapl_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
+
+    /* Copy the general information */
+    HDmemcpy(new_fa, old_fa, sizeof(H5FD_iouring_fapl_t));
+
+    /* Set return value */
+    ret_value = new_fa;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_fapl_copy() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_ring_init
+ *
+ * Purpose:     Sets up an io_uring instance with ENTRIES submission queue
+ *              entries and maps its queues into memory.
+ *
+ *              If the kernel refuses to set up the ring, RING's 'fd' is
+ *              set to -1 and the driver issues requests one at a time;
+ *              that isn't treated as an error.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_ring_init(H5FD_iouring_ring_t *ring, unsigned entries)
+{
+    struct io_uring_params params;      /* Parameters for the ring */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(ring);
+    HDassert(entries > 0);
+
+    HDmemset(ring, 0, sizeof(*ring));
+    HDmemset(&params, 0, sizeof(params));
+
+    /* Set up the ring, falling back to synchronous I/O if io_uring isn't available */
+    if((ring->fd = H5FD_IOURING_SETUP(entries, &params)) < 0) {
+        ring->fd = -1;
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+    ring->entries = params.sq_entries;
+
+    /* Map the submission and completion queue rings, which share one mapping
+     * on kernels with IORING_FEAT_SINGLE_MMAP.
+     */
+    ring->sq_ring_size = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+    ring->cq_ring_size = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+    if(params.features & IORING_FEAT_SINGLE_MMAP)
+        ring->sq_ring_size = ring->cq_ring_size = MAX(ring->sq_ring_size, ring->cq_ring_size);
+    if(MAP_FAILED == (ring->sq_ring = HDmmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring->fd, (HDoff_t)IORING_OFF_SQ_RING))) {
+        ring->sq_ring = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission queue")
+    } /* end if */
+    if(params.features & IORING_FEAT_SINGLE_MMAP)
+        ring->cq_ring = ring->sq_ring;
+    else if(MAP_FAILED == (ring->cq_ring = HDmmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring->fd, (HDoff_t)IORING_OFF_CQ_RING))) {
+        ring->cq_ring = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring completion queue")
+    } /* end if */
+
+    /* Map the submission queue entries */
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    if(MAP_FAILED == (ring->sqes = (struct io_uring_sqe *)HDmmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring->fd, (HDoff_t)IORING_OFF_SQES))) {
+        ring->sqes = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission queue entries")
+    } /* end if */
+
+    /* Locate the queue fields within the mappings */
+    ring->sq_head = (unsigned *)((unsigned char *)ring->sq_ring + params.sq_off.head);
+    ring->sq_tail = (unsigned *)((unsigned char *)ring->sq_ring + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)((unsigned char *)ring->sq_ring + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)((unsigned char *)ring->sq_ring + params.sq_off.array);
+    ring->cq_head = (unsigned *)((unsigned char *)ring->cq_ring + params.cq_off.head);
+    ring->cq_tail = (unsigned *)((unsigned char *)ring->cq_ring + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)((unsigned char *)ring->cq_ring + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)((unsigned char *)ring->cq_ring + params.cq_off.cqes);
+
+    /* Allocate an I/O vector for each submission queue entry */
+    if(NULL == (ring->iov = (struct iovec *)H5MM_malloc(ring->entries * sizeof(struct iovec))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vectors")
+
+done:
+    if(ret_value < 0)
+        H5FD__iouring_ring_term(ring);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_ring_init() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_ring_term
+ *
+ * Purpose:     Unmaps the queues of an io_uring instance and closes it.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_ring_term(H5FD_iouring_ring_t *ring)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(ring);
+
+    if(ring->iov)
+        ring->iov = (struct iovec *)H5MM_xfree(ring->iov);
+    if(ring->sqes && HDmunmap(ring->sqes, ring->sqes_size) < 0)
+        HSYS_DONE_ERROR(H5E_VFL, H5E_CANTFREE, FAIL, "unable to unmap io_uring submission queue entries")
+    if(ring->cq_ring && ring->cq_ring != ring->sq_ring && HDmunmap(ring->cq_ring, ring->cq_ring_size) < 0)
+        HSYS_DONE_ERROR(H5E_VFL, H5E_CANTFREE, FAIL, "unable to unmap io_uring completion queue")
+    if(ring->sq_ring && HDmunmap(ring->sq_ring, ring->sq_ring_size) < 0)
+        HSYS_DONE_ERROR(H5E_VFL, H5E_CANTFREE, FAIL, "unable to unmap io_uring submission queue")
+    if(ring->fd >= 0 && HDclose(ring->fd) < 0)
+        HSYS_DONE_ERROR(H5E_VFL, H5E_CANTCLOSEFILE, FAIL, "unable to close io_uring instance")
+
+    ring->sqes = NULL;
+    ring->cq_ring = NULL;
+    ring->sq_ring = NULL;
+    ring->fd = -1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_ring_term() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_open
+ *
+ * Purpose:     Create and/or opens a file as an HDF5 file.
+ *
+ * Return:      Success:    A pointer to a new file data structure. The
+ *                          public fields will be initialized by the
+ *                          caller, which is always H5FD_open().
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5FD_t *
+H5FD_iouring_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
+{
+    H5FD_iouring_t  *file       = NULL;     /* io_uring VFD info        */
+    const H5FD_iouring_fapl_t *fa = NULL;   /* io_uring VFD properties  */
+    H5P_genplist_t  *plist;                 /* Property list            */
+    int             fd          = -1;       /* File descriptor          */
+    int             o_flags;                /* Flags for open() call    */
+    h5_stat_t       sb;
+    H5FD_t          *ret_value = NULL;          /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check on file offsets */
+    HDcompile_assert(sizeof(HDoff_t) >= sizeof(size_t));
+
+    /* Check arguments */
+    if(!name || !*name)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "invalid file name")
+    if(0 == maxaddr || HADDR_UNDEF == maxaddr)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, NULL, "bogus maxaddr")
+    if(ADDR_OVERFLOW(maxaddr))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, NULL, "bogus maxaddr")
+
+    /* Get the driver specific information */
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "not a file access property list")
+    fa = (const H5FD_iouring_fapl_t *)H5P_peek_driver_info(plist);
+
+    /* Build the open flags */
+    o_flags = (H5F_ACC_RDWR & flags) ? O_RDWR : O_RDONLY;
+    if(H5F_ACC_TRUNC & flags)
+        o_flags |= O_TRUNC;
+    if(H5F_ACC_CREAT & flags)
+        o_flags |= O_CREAT;
+    if(H5F_ACC_EXCL & flags)
+        o_flags |= O_EXCL;
+
+    /* Open the file */
+    if((fd = HDopen(name, o_flags, H5_POSIX_CREATE_MODE_RW)) < 0) {
+        int myerrno = errno;
+        HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to open file: name = '%s', errno = %d, error message = '%s', flags = %x, o_flags = %x", name, myerrno, HDstrerror(myerrno), flags, (unsigned)o_flags);
+    } /* end if */
+
+    if(HDfstat(fd, &sb) < 0)
+        HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, NULL, "unable to fstat file")
+
+    /* Create the new file struct */
+    if(NULL == (file = H5FL_CALLOC(H5FD_iouring_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate file struct")
+
+    file->fd = fd;
+    file->ring.fd = -1;
+    H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
+    file->device = sb.st_dev;
+    file->inode = sb.st_ino;
+    file->fa.queue_depth = fa ? fa->queue_depth : H5FD_IOURING_QUEUE_DEPTH_DEF;
+
+    /* Retain a copy of the name used to open the file, for possible error reporting */
+    HDstrncpy(file->filename, name, sizeof(file->filename));
+    file->filename[sizeof(file->filename) - 1] = '\0';
+
+    /* Set up the file's io_uring instance */
+    if(H5FD__iouring_ring_init(&file->ring, file->fa.queue_depth) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, NULL, "unable to set up io_uring instance")
+
+    /* Set return value */
+    ret_value = (H5FD_t*)file;
+
+done:
+    if(NULL == ret_value) {
+        if(fd >= 0)
+            HDclose(fd);
+        if(file)
+            file = H5FL_FREE(H5FD_iouring_t, file);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_open() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_close
+ *
+ * Purpose:     Closes an HDF5 file.
+ *
+ * Return:      Success:    SUCCEED
+ *              Failure:    FAIL, file not closed.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_close(H5FD_t *_file)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file;
+    herr_t      ret_value = SUCCEED;                /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check */
+    HDassert(file);
+
+    /* Release the io_uring instance */
+    if(H5FD__iouring_ring_term(&file->ring) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTRELEASE, FAIL, "unable to release io_uring instance")
+
+    /* Close the underlying file */
+    if(HDclose(file->fd) < 0)
+        HSYS_GOTO_ERROR(H5E_IO, H5E_CANTCLOSEFILE, FAIL, "unable to close file")
+
+    /* Release the file info */
+    file = H5FL_FREE(H5FD_iouring_t, file);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_close() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_cmp
+ *
+ * Purpose:     Compares two files belonging to this driver using an
+ *              arbitrary (but consistent) ordering.
+ *
+ * Return:      Success:    A value like strcmp()
+ *              Failure:    never fails (arguments were checked by the
+ *                          caller).
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5FD_iouring_cmp(const H5FD_t *_f1, const H5FD_t *_f2)
+{
+    const H5FD_iouring_t    *f1 = (const H5FD_iouring_t *)_f1;
+    const H5FD_iouring_t    *f2 = (const H5FD_iouring_t *)_f2;
+    int ret_value = 0;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5_DEV_T_IS_SCALAR
+    if(f1->device < f2->device) HGOTO_DONE(-1)
+    if(f1->device > f2->device) HGOTO_DONE(1)
+#else /* H5_DEV_T_IS_SCALAR */
+    /* If dev_t isn't a scalar value on this system, just use memcmp to
+     * determine if the values are the same or not.  The actual return value
+     * shouldn't really matter...
+     */
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) < 0) HGOTO_DONE(-1)
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) > 0) HGOTO_DONE(1)
+#endif /* H5_DEV_T_IS_SCALAR */
+    if(f1->inode < f2->inode) HGOTO_DONE(-1)
+    if(f1->inode > f2->inode) HGOTO_DONE(1)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_cmp() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_query
+ *
+ * Purpose:     Set the flags that this VFL driver is capable of supporting.
+ *              (listed in H5FDpublic.h)
+ *
+ *              Data sieving isn't advertised: the sieve buffer would
+ *              turn batched raw data requests back into single reads
+ *              and writes, bypassing the vector callbacks.
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_query(const H5FD_t H5_ATTR_UNUSED *_file, unsigned long *flags /* out */)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Set the VFL feature flags that this driver supports */
+    if(flags) {
+        *flags = 0;
+        *flags |= H5FD_FEAT_AGGREGATE_METADATA;     /* OK to aggregate metadata allocations                             */
+        *flags |= H5FD_FEAT_ACCUMULATE_METADATA;    /* OK to accumulate metadata for faster writes                      */
+        *flags |= H5FD_FEAT_AGGREGATE_SMALLDATA;    /* OK to aggregate "small" raw data allocations                     */
+        *flags |= H5FD_FEAT_POSIX_COMPAT_HANDLE;    /* get_handle callback returns a POSIX file descriptor              */
+        *flags |= H5FD_FEAT_SUPPORTS_SWMR_IO;       /* VFD supports the single-writer/multiple-readers (SWMR) pattern   */
+        *flags |= H5FD_FEAT_DEFAULT_VFD_COMPATIBLE; /* VFD creates a file which can be opened with the default VFD      */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_iouring_query() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_get_eoa
+ *
+ * Purpose:     Gets the end-of-address marker for the file. The EOA marker
+ *              is the first address past the last byte allocated in the
+ *              format address space.
+ *
+ * Return:      The end-of-address marker.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_iouring_get_eoa(const H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type)
+{
+    const H5FD_iouring_t	*file = (const H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eoa)
+} /* end H5FD_iouring_get_eoa() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_set_eoa
+ *
+ * Purpose:     Set the end-of-address marker for the file. This function is
+ *              called shortly after an existing HDF5 file is opened in order
+ *              to tell the driver where the end of the HDF5 data is located.
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_set_eoa(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, haddr_t addr)
+{
+    H5FD_iouring_t	*file = (H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    file->eoa = addr;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_iouring_set_eoa() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_get_eof
+ *
+ * Purpose:     Returns the end-of-file marker, which is the greater of
+ *              either the filesystem end-of-file or the HDF5 end-of-address
+ *              markers.
+ *
+ * Return:      End of file address, the first address past the end of the
+ *              "file", either the filesystem file or the HDF5 file.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_iouring_get_eof(const H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type)
+{
+    const H5FD_iouring_t    *file = (const H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eof)
+} /* end H5FD_iouring_get_eof() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:       H5FD_iouring_get_handle
+ *
+ * Purpose:        Returns the file handle of io_uring file driver.
+ *
+ * Returns:        SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_get_handle(H5FD_t *_file, hid_t H5_ATTR_UNUSED fapl, void **file_handle)
+{
+    H5FD_iouring_t      *file = (H5FD_iouring_t *)_file;
+    herr_t              ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(!file_handle)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "file handle not valid")
+
+    *file_handle = &(file->fd);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_get_handle() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_read
+ *
+ * Purpose:     Reads SIZE bytes of data from FILE beginning at address ADDR
+ *              into buffer BUF according to data transfer properties in
+ *              DXPL_ID.
+ *
+ * Return:      Success:    SUCCEED. Result is stored in caller-supplied
+ *                          buffer BUF.
+ *              Failure:    FAIL, Contents of buffer BUF are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUSED dxpl_id,
+    haddr_t addr, size_t size, void *buf /*out*/)
+{
+    H5FD_iouring_t  *file       = (H5FD_iouring_t *)_file;
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(buf);
+
+    /* Check for overflow conditions */
+    if(!H5F_addr_defined(addr))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+    if(REGION_OVERFLOW(addr, size))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
+
+    /* Read data, being careful of interrupted system calls, partial results,
+     * and the end of the file.
+     */
+    while(size > 0) {
+        h5_posix_io_t       bytes_in        = 0;    /* # of bytes to read       */
+        h5_posix_io_ret_t   bytes_read      = -1;   /* # of bytes actually read */
+
+        /* Trying to read more bytes than the return type can handle is
+         * undefined behavior in POSIX.
+         */
+        if(size > H5_POSIX_MAX_IO_BYTES)
+            bytes_in = H5_POSIX_MAX_IO_BYTES;
+        else
+            bytes_in = (h5_posix_io_t)size;
+
+        do {
+            bytes_read = HDpread(file->fd, buf, bytes_in, (HDoff_t)addr);
+        } while(-1 == bytes_read && EINTR == errno);
+
+        if(-1 == bytes_read) { /* error */
+            int myerrno = errno;
+            time_t mytime = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total read size = %llu, bytes this sub-read = %llu, bytes actually read = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_read, (unsigned long long)addr);
+        } /* end if */
+
+        if(0 == bytes_read) {
+            /* end of file but not end of format address space */
+            HDmemset(buf, 0, size);
+            break;
+        } /* end if */
+
+        HDassert(bytes_read >= 0);
+        HDassert((size_t)bytes_read <= size);
+
+        size -= (size_t)bytes_read;
+        addr += (haddr_t)bytes_read;
+        buf = (char *)buf + bytes_read;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_read() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_write
+ *
+ * Purpose:     Writes SIZE bytes of data to FILE beginning at address ADDR
+ *              from buffer BUF according to data transfer properties in
+ *              DXPL_ID.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUSED dxpl_id,
+    haddr_t addr, size_t size, const void *buf)
+{
+    H5FD_iouring_t  *file       = (H5FD_iouring_t *)_file;
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(buf);
+
+    /* Check for overflow conditions */
+    if(!H5F_addr_defined(addr))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+    if(REGION_OVERFLOW(addr, size))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addr, (unsigned long long)size)
+
+    /* Write the data, being careful of interrupted system calls and partial
+     * results
+     */
+    while(size > 0) {
+        h5_posix_io_t       bytes_in        = 0;    /* # of bytes to write  */
+        h5_posix_io_ret_t   bytes_wrote     = -1;   /* # of bytes written   */
+
+        /* Trying to write more bytes than the return type can handle is
+         * undefined behavior in POSIX.
+         */
+        if(size > H5_POSIX_MAX_IO_BYTES)
+            bytes_in = H5_POSIX_MAX_IO_BYTES;
+        else
+            bytes_in = (h5_posix_io_t)size;
+
+        do {
+            bytes_wrote = HDpwrite(file->fd, buf, bytes_in, (HDoff_t)addr);
+        } while(-1 == bytes_wrote && EINTR == errno);
+
+        if(-1 == bytes_wrote) { /* error */
+            int myerrno = errno;
+            time_t mytime = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total write size = %llu, bytes this sub-write = %llu, bytes actually written = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_wrote, (unsigned long long)addr);
+        } /* end if */
+
+        HDassert(bytes_wrote > 0);
+        HDassert((size_t)bytes_wrote <= size);
+
+        size -= (size_t)bytes_wrote;
+        addr += (haddr_t)bytes_wrote;
+        buf = (const char *)buf + bytes_wrote;
+    } /* end while */
+
+    /* Update eof */
+    if(addr > file->eof)
+        file->eof = addr;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_write() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_vector
+ *
+ * Purpose:     Reads (or writes, when DO_WRITE is TRUE) COUNT blocks of
+ *              data through the file's io_uring instance.  The blocks are
+ *              queued in batches of up to the ring's number of entries;
+ *              each batch is submitted with one system call and all of
+ *              its completions are reaped before the next batch is
+ *              queued.
+ *
+ *              A request that completes short (at the end of the file, or
+ *              for very large blocks) is finished with the synchronous
+ *              read or write callback, which also zero-fills reads past
+ *              the end of the file.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_vector(H5FD_iouring_t *file, hbool_t do_write, hid_t dxpl_id,
+    uint32_t count, const H5FD_mem_t types[], const haddr_t addrs[],
+    const size_t sizes[], void *bufs[])
+{
+    H5FD_iouring_ring_t *ring = &file->ring;    /* File's io_uring instance */
+    hbool_t     io_failed = FALSE;      /* Whether any request failed */
+    int         first_errno = 0;        /* Error from first failed request */
+    int         wait_errno = 0;         /* Error from waiting for completions */
+    uint32_t    u = 0;                  /* Index of next block to queue */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(file);
+    HDassert(ring->fd >= 0);
+
+    while(u < count && !io_failed) {
+        unsigned    tail;               /* Submission queue tail */
+        unsigned    nqueued = 0;        /* # of requests queued in this batch */
+        unsigned    nsubmit;            /* # of requests not yet submitted */
+        unsigned    ndone = 0;          /* # of completions reaped */
+
+        /* Queue as many blocks as the ring holds */
+        tail = *ring->sq_tail;
+        while(u < count && nqueued < ring->entries) {
+            unsigned            idx = tail & *ring->sq_mask;
+            struct io_uring_sqe *sqe = &ring->sqes[idx];
+
+            /* Check for overflow conditions */
+            if(!H5F_addr_defined(addrs[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+            if(REGION_OVERFLOW(addrs[u], sizes[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addrs[u], (unsigned long long)sizes[u])
+
+            /* Nothing to transfer for empty blocks */
+            if(0 == sizes[u]) {
+                u++;
+                continue;
+            } /* end if */
+
+            ring->iov[idx].iov_base = bufs[u];
+            ring->iov[idx].iov_len = sizes[u];
+
+            HDmemset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = (uint8_t)(do_write ? IORING_OP_WRITEV : IORING_OP_READV);
+            sqe->fd = file->fd;
+            sqe->off = (uint64_t)addrs[u];
+            sqe->addr = (uint64_t)(uintptr_t)&ring->iov[idx];
+            sqe->len = 1;
+            sqe->user_data = (uint64_t)u;
+            ring->sq_array[idx] = idx;
+
+            tail++;
+            nqueued++;
+            u++;
+        } /* end while */
+        if(0 == nqueued)
+            break;
+
+        /* Publish the new entries to the kernel */
+        H5FD_IOURING_STORE_RELEASE(ring->sq_tail, tail);
+
+        /* Submit the batch */
+        nsubmit = nqueued;
+        while(nsubmit > 0) {
+            int nsubmitted = H5FD_IOURING_ENTER(ring->fd, nsubmit, 0, 0);
+
+            if(nsubmitted < 0) {
+                if(EINTR == errno || EAGAIN == errno)
+                    continue;
+
+                /* Withdraw the requests the kernel didn't accept, then reap
+                 * the ones it did before reporting the error.
+                 */
+                first_errno = errno;
+                io_failed = TRUE;
+                H5FD_IOURING_STORE_RELEASE(ring->sq_tail, H5FD_IOURING_LOAD_ACQUIRE(ring->sq_head));
+                nqueued -= nsubmit;
+                break;
+            } /* end if */
+            nsubmit -= (unsigned)nsubmitted;
+        } /* end while */
+
+        /* Reap the batch's completions */
+        while(ndone < nqueued) {
+            unsigned head = *ring->cq_head;
+
+            if(head == H5FD_IOURING_LOAD_ACQUIRE(ring->cq_tail)) {
+                /* Wait for more completions.  If the kernel won't let us
+                 * wait, the submitted requests still own their buffers,
+                 * so poll for their completions rather than returning
+                 * while they are in flight.
+                 */
+                if(wait_errno)
+                    H5_nanosleep((uint64_t)1000);
+                else if(H5FD_IOURING_ENTER(ring->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && EINTR != errno) {
+                    wait_errno = errno;
+                    io_failed = TRUE;
+                } /* end if */
+                continue;
+            } /* end if */
+
+            do {
+                const struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+                uint32_t    v = (uint32_t)cqe->user_data;
+                int         res = cqe->res;
+
+                head++;
+                ndone++;
+
+                if(res < 0) {
+                    /* Retry interrupted requests synchronously */
+                    if(-EINTR == res || -EAGAIN == res)
+                        res = 0;
+                    else {
+                        if(!io_failed)
+                            first_errno = -res;
+                        io_failed = TRUE;
+                        continue;
+                    } /* end else */
+                } /* end if */
+
+                /* Finish short transfers synchronously */
+                if((size_t)res < sizes[v]) {
+                    herr_t status;
+
+                    if(do_write)
+                        status = H5FD_iouring_write((H5FD_t *)file, types[v], dxpl_id, addrs[v] + (haddr_t)res,
+                                sizes[v] - (size_t)res, (const unsigned char *)bufs[v] + res);
+                    else
+                        status = H5FD_iouring_read((H5FD_t *)file, types[v], dxpl_id, addrs[v] + (haddr_t)res,
+                                sizes[v] - (size_t)res, (unsigned char *)bufs[v] + res);
+                    if(status < 0)
+                        io_failed = TRUE;
+                } /* end if */
+                else if(do_write && (addrs[v] + sizes[v]) > file->eof)
+                    file->eof = addrs[v] + sizes[v];
+            } while(ndone < nqueued && head != H5FD_IOURING_LOAD_ACQUIRE(ring->cq_tail));
+
+            /* Release the reaped entries to the kernel */
+            H5FD_IOURING_STORE_RELEASE(ring->cq_head, head);
+        } /* end while */
+    } /* end while */
+
+    if(wait_errno)
+        HGOTO_ERROR(H5E_IO, H5E_SYSERRSTR, FAIL, "unable to wait for io_uring completions, errno = %d, error message = '%s'", wait_errno, HDstrerror(wait_errno))
+    if(io_failed) {
+        if(first_errno)
+            HGOTO_ERROR(H5E_IO, (do_write ? H5E_WRITEERROR : H5E_READERROR), FAIL, "io_uring %s failed: filename = '%s', errno = %d, error message = '%s'", (do_write ? "write" : "read"), file->filename, first_errno, HDstrerror(first_errno))
+        else
+            HGOTO_ERROR(H5E_IO, (do_write ? H5E_WRITEERROR : H5E_READERROR), FAIL, "io_uring %s failed", (do_write ? "write" : "read"))
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_vector() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_read_vector
+ *
+ * Purpose:     Reads COUNT blocks of data from FILE.  Block U is SIZES[U]
+ *              bytes long, starts at address ADDRS[U] and is read into
+ *              BUFS[U].  The blocks are submitted to the kernel in
+ *              batches through the file's io_uring instance.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_read_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[] /*out*/)
+{
+    H5FD_iouring_t  *file       = (H5FD_iouring_t *)_file;
+    uint32_t        u;                                      /* Local index variable */
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* Batch the requests when there's more than one and a ring to batch them on */
+    if(count > 1 && file->ring.fd >= 0) {
+        if(H5FD__iouring_vector(file, FALSE, dxpl_id, count, types, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "vector read failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(H5FD_iouring_read(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_read_vector() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_write_vector
+ *
+ * Purpose:     Writes COUNT blocks of data to FILE.  Block U is SIZES[U]
+ *              bytes long, starts at address ADDRS[U] and is written from
+ *              BUFS[U].  The blocks are submitted to the kernel in
+ *              batches through the file's io_uring instance.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_write_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    H5FD_iouring_t  *file       = (H5FD_iouring_t *)_file;
+    uint32_t        u;                                      /* Local index variable */
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* Batch the requests when there's more than one and a ring to batch them on */
+    if(count > 1 && file->ring.fd >= 0) {
+        /* (The buffers are only read from for writes, so casting away
+         *  const is safe here.)
+         */
+        H5_GCC_DIAG_OFF(cast-qual)
+        if(H5FD__iouring_vector(file, TRUE, dxpl_id, count, types, addrs, sizes, (void **)bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "vector write failed")
+        H5_GCC_DIAG_ON(cast-qual)
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(H5FD_iouring_write(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_write_vector() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_truncate
+ *
+ * Purpose:     Makes sure that the true file size is the same (or larger)
+ *              than the end-of-address.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_truncate(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATTR_UNUSED closing)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file;
+    herr_t ret_value = SUCCEED;                 /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    /* Extend the file to make sure it's large enough */
+    if(!H5F_addr_eq(file->eoa, file->eof)) {
+        if(-1 == HDftruncate(file->fd, (HDoff_t)file->eoa))
+            HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to extend file properly")
+
+        /* Update the eof value */
+        file->eof = file->eoa;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_truncate() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_lock
+ *
+ * Purpose:     To place an advisory lock on a file.
+ *		The lock type to apply depends on the parameter "rw":
+ *			TRUE--opens for write: an exclusive lock
+ *			FALSE--opens for read: a shared lock
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_lock(H5FD_t *_file, hbool_t rw)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file; /* VFD file struct      */
+    int lock_flags;                             /* file locking flags       */
+    herr_t ret_value = SUCCEED;                 /* Return value             */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    /* Set exclusive or shared lock based on rw status */
+    lock_flags = rw ? LOCK_EX : LOCK_SH;
+
+    /* Place a non-blocking lock on the file */
+    if(HDflock(file->fd, lock_flags | LOCK_NB) < 0) {
+        if(ENOSYS == errno)
+            HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "file locking disabled on this file system (use HDF5_USE_FILE_LOCKING environment variable to override)")
+        else
+            HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "unable to lock file")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_lock() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_unlock
+ *
+ * Purpose:     To remove the existing lock on the file
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_unlock(H5FD_t *_file)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file; /* VFD file struct      */
+    herr_t ret_value = SUCCEED;                 /* Return value             */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    if(HDflock(file->fd, LOCK_UN) < 0) {
+        if(ENOSYS == errno)
+            HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "file locking disabled on this file system (use HDF5_USE_FILE_LOCKING environment variable to override)")
+        else
+            HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "unable to unlock file")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_unlock() */
+
+#endif /* H5_HAVE_IOURING */
+
@@ -147,6 +147,14 @@ H5_DLL herr_t H5FD_read(H5FD_t *file, H5FD_mem_t type, haddr_t addr,
     size_t size, void *buf/*out*/);
 H5_DLL herr_t H5FD_write(H5FD_t *file, H5FD_mem_t type, haddr_t addr,
     size_t size, const void *buf);
+H5_DLL herr_t H5FD_read_vector(H5FD_t *file, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]/*out*/);
+H5_DLL herr_t H5FD_write_vector(H5FD_t *file, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[]);
+H5_DLL herr_t H5FD_get_ptr(H5FD_t *file, H5FD_mem_t type, haddr_t addr,
+    size_t size, const void **ptr/*out*/);
 H5_DLL herr_t H5FD_flush(H5FD_t *file, hbool_t closing);
 H5_DLL herr_t H5FD_truncate(H5FD_t *file, hbool_t closing);
 H5_DLL herr_t H5FD_lock(H5FD_t *file, hbool_t rw);
@@ -301,6 +301,17 @@ typedef struct H5FD_class_t {
     herr_t  (*lock)(H5FD_t *file, hbool_t rw);
     herr_t  (*unlock)(H5FD_t *file);
     H5FD_mem_t fl_map[H5FD_MEM_NTYPES];
+
+    /* Optional callbacks, after the original ones so that drivers which
+     * initialize this struct positionally don't need to change */
+    herr_t  (*read_vector)(H5FD_t *file, hid_t dxpl, uint32_t count,
+                    const H5FD_mem_t types[], const haddr_t addrs[],
+                    const size_t sizes[], void *bufs[]);
+    herr_t  (*write_vector)(H5FD_t *file, hid_t dxpl, uint32_t count,
+                    const H5FD_mem_t types[], const haddr_t addrs[],
+                    const size_t sizes[], const void *bufs[]);
+    herr_t  (*get_ptr)(H5FD_t *file, H5FD_mem_t type, haddr_t addr,
+                    size_t size, const void **ptr);
 } H5FD_class_t;
 
 /* A free list is a singly-linked list of address/size pairs. */
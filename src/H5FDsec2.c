@@ -16,7 +16,9 @@
  *              Thursday, July 29, 1999
  *
  * Purpose: The POSIX unbuffered file driver using only the HDF5 public
- *          API and with a few optimizations: the lseek() call is made
+ *          API and with a few optimizations: where pread() and pwrite()
+ *          are available all I/O is positional, so the driver never
+ *          changes the file position.  Otherwise the lseek() call is made
  *          only when the current file position is unknown or needs to be
  *          changed based on previous I/O through this driver (don't mix
  *          I/O from this driver with I/O from other parts of the
@@ -39,24 +41,34 @@
 /* The driver identification number, initialized at runtime */
 static hid_t H5FD_SEC2_g = 0;
 
+/* Whether to use positional I/O (pread() and pwrite()), which leaves the
+ * file position of the descriptor untouched.
+ */
+#if defined(H5_HAVE_PREAD) && defined(H5_HAVE_PWRITE)
+#define H5FD_SEC2_USE_PREADWRITE
+#endif /* H5_HAVE_PREAD && H5_HAVE_PWRITE */
+
 /* The description of a file belonging to this driver. The 'eoa' and 'eof'
  * determine the amount of hdf5 address space in use and the high-water mark
- * of the file (the current size of the underlying filesystem file). The
- * 'pos' value is used to eliminate file position updates when they would be a
- * no-op. Unfortunately we've found systems that use separate file position
- * indicators for reading and writing so the lseek can only be eliminated if
- * the current operation is the same as the previous operation.  When opening
- * a file the 'eof' will be set to the current file size, `eoa' will be set
- * to zero, 'pos' will be set to H5F_ADDR_UNDEF (as it is when an error
- * occurs), and 'op' will be set to H5F_OP_UNKNOWN.
+ * of the file (the current size of the underlying filesystem file). When
+ * positional I/O isn't available, the 'pos' value is used to eliminate file
+ * position updates when they would be a no-op. Unfortunately we've found
+ * systems that use separate file position indicators for reading and writing
+ * so the lseek can only be eliminated if the current operation is the same
+ * as the previous operation.  When opening a file the 'eof' will be set to
+ * the current file size, `eoa' will be set to zero, 'pos' will be set to
+ * H5F_ADDR_UNDEF (as it is when an error occurs), and 'op' will be set to
+ * H5F_OP_UNKNOWN.
  */
 typedef struct H5FD_sec2_t {
     H5FD_t          pub;    /* public stuff, must be first      */
     int             fd;     /* the filesystem file descriptor   */
     haddr_t         eoa;    /* end of allocated region          */
     haddr_t         eof;    /* end of file; current file size   */
+#ifndef H5FD_SEC2_USE_PREADWRITE
     haddr_t         pos;    /* current file I/O position        */
     H5FD_file_op_t  op;     /* last operation                   */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
     char            filename[H5FD_MAX_FILENAME_LEN];    /* Copy of file name from open operation */
 #ifndef H5_HAVE_WIN32_API
     /* On most systems the combination of device and i-node number uniquely
@@ -98,6 +110,15 @@ typedef struct H5FD_sec2_t {
 
 } H5FD_sec2_t;
 
+/* Maximum number of I/O vector elements passed to a single preadv() or
+ * pwritev() call.
+ */
+#if defined(IOV_MAX) && IOV_MAX < 1024
+#define H5FD_SEC2_MAX_IOV   IOV_MAX
+#else
+#define H5FD_SEC2_MAX_IOV   1024
+#endif
+
 /*
  * These macros check for overflow of various quantities.  These macros
  * assume that HDoff_t is signed and haddr_t and size_t are unsigned.
@@ -135,6 +156,18 @@ static herr_t H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, hadd
             size_t size, void *buf);
 static herr_t H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
             size_t size, const void *buf);
+static herr_t H5FD_sec2_read_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            void *bufs[]);
+static herr_t H5FD_sec2_write_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            const void *bufs[]);
+#if defined(H5_HAVE_PREADV) && defined(H5_HAVE_PWRITEV)
+static herr_t H5FD__sec2_readv(H5FD_sec2_t *file, struct iovec *iov, int iovcnt,
+            haddr_t addr);
+static herr_t H5FD__sec2_writev(H5FD_sec2_t *file, struct iovec *iov, int iovcnt,
+            haddr_t addr);
+#endif /* H5_HAVE_PREADV && H5_HAVE_PWRITEV */
 static herr_t H5FD_sec2_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t H5FD_sec2_lock(H5FD_t *_file, hbool_t rw);
 static herr_t H5FD_sec2_unlock(H5FD_t *_file);
@@ -171,7 +204,10 @@ static const H5FD_class_t H5FD_sec2_g = {
     H5FD_sec2_truncate,         /* truncate             */
     H5FD_sec2_lock,             /* lock                 */
     H5FD_sec2_unlock,           /* unlock               */
-    H5FD_FLMAP_DICHOTOMY        /* fl_map               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD_sec2_read_vector,      /* read_vector          */
+    H5FD_sec2_write_vector,     /* write_vector         */
+    NULL                        /* get_ptr              */
 };
 
 /* Declare a free list to manage the H5FD_sec2_t struct */
@@ -355,8 +391,10 @@ H5FD_sec2_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
 
     file->fd = fd;
     H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
+#ifndef H5FD_SEC2_USE_PREADWRITE
     file->pos = HADDR_UNDEF;
     file->op = OP_UNKNOWN;
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 #ifdef H5_HAVE_WIN32_API
     file->hFile = (HANDLE)_get_osfhandle(fd);
     if(INVALID_HANDLE_VALUE == file->hFile)
@@ -682,11 +720,13 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
     if(REGION_OVERFLOW(addr, size))
         HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
 
+#ifndef H5FD_SEC2_USE_PREADWRITE
     /* Seek to the correct location */
     if(addr != file->pos || OP_READ != file->op) {
         if(HDlseek(file->fd, (HDoff_t)addr, SEEK_SET) < 0)
             HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
     } /* end if */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
     /* Read data, being careful of interrupted system calls, partial results,
      * and the end of the file.
@@ -705,13 +745,21 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
             bytes_in = (h5_posix_io_t)size;
 
         do {
+#ifdef H5FD_SEC2_USE_PREADWRITE
+            bytes_read = HDpread(file->fd, buf, bytes_in, (HDoff_t)addr);
+#else /* H5FD_SEC2_USE_PREADWRITE */
             bytes_read = HDread(file->fd, buf, bytes_in);
+#endif /* H5FD_SEC2_USE_PREADWRITE */
         } while(-1 == bytes_read && EINTR == errno);
         
         if(-1 == bytes_read) { /* error */
             int myerrno = errno;
             time_t mytime = HDtime(NULL);
+#ifdef H5FD_SEC2_USE_PREADWRITE
+            HDoff_t myoffset = (HDoff_t)addr;
+#else /* H5FD_SEC2_USE_PREADWRITE */
             HDoff_t myoffset = HDlseek(file->fd, (HDoff_t)0, SEEK_CUR);
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
             HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total read size = %llu, bytes this sub-read = %llu, bytes actually read = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_read, (unsigned long long)myoffset);
         } /* end if */
@@ -730,16 +778,20 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
         buf = (char *)buf + bytes_read;
     } /* end while */
 
+#ifndef H5FD_SEC2_USE_PREADWRITE
     /* Update current position */
     file->pos = addr;
     file->op = OP_READ;
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
 done:
+#ifndef H5FD_SEC2_USE_PREADWRITE
     if(ret_value < 0) {
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
     } /* end if */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_read() */
@@ -777,11 +829,13 @@ H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNU
     if(REGION_OVERFLOW(addr, size))
         HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addr, (unsigned long long)size)
 
+#ifndef H5FD_SEC2_USE_PREADWRITE
     /* Seek to the correct location */
     if(addr != file->pos || OP_WRITE != file->op) {
         if(HDlseek(file->fd, (HDoff_t)addr, SEEK_SET) < 0)
             HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
     } /* end if */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
     /* Write the data, being careful of interrupted system calls and partial
      * results
@@ -800,13 +854,21 @@ H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNU
             bytes_in = (h5_posix_io_t)size;
 
         do {
+#ifdef H5FD_SEC2_USE_PREADWRITE
+            bytes_wrote = HDpwrite(file->fd, buf, bytes_in, (HDoff_t)addr);
+#else /* H5FD_SEC2_USE_PREADWRITE */
             bytes_wrote = HDwrite(file->fd, buf, bytes_in);
+#endif /* H5FD_SEC2_USE_PREADWRITE */
         } while(-1 == bytes_wrote && EINTR == errno);
         
         if(-1 == bytes_wrote) { /* error */
             int myerrno = errno;
             time_t mytime = HDtime(NULL);
+#ifdef H5FD_SEC2_USE_PREADWRITE
+            HDoff_t myoffset = (HDoff_t)addr;
+#else /* H5FD_SEC2_USE_PREADWRITE */
             HDoff_t myoffset = HDlseek(file->fd, (HDoff_t)0, SEEK_CUR);
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total write size = %llu, bytes this sub-write = %llu, bytes actually written = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_wrote, (unsigned long long)myoffset);
         } /* end if */
@@ -820,21 +882,330 @@ H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNU
     } /* end while */
 
     /* Update current position and eof */
+#ifndef H5FD_SEC2_USE_PREADWRITE
     file->pos = addr;
     file->op = OP_WRITE;
-    if(file->pos > file->eof)
-        file->eof = file->pos;
+#endif /* H5FD_SEC2_USE_PREADWRITE */
+    if(addr > file->eof)
+        file->eof = addr;
 
 done:
+#ifndef H5FD_SEC2_USE_PREADWRITE
     if(ret_value < 0) {
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
     } /* end if */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_write() */
 
+
+#if defined(H5_HAVE_PREADV) && defined(H5_HAVE_PWRITEV)
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_readv
+ *
+ * Purpose:     Reads a block of the file beginning at address ADDR into
+ *              the IOVCNT buffers described by IOV, with preadv().  The
+ *              elements of IOV are modified.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__sec2_readv(H5FD_sec2_t *file, struct iovec *iov, int iovcnt, haddr_t addr)
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(file);
+    HDassert(iov);
+
+    /* Read data, being careful of interrupted system calls, partial results,
+     * and the end of the file.
+     */
+    while(iovcnt > 0) {
+        ssize_t     bytes_read      = -1;   /* # of bytes actually read */
+
+        do {
+            bytes_read = HDpreadv(file->fd, iov, iovcnt, (HDoff_t)addr);
+        } while(-1 == bytes_read && EINTR == errno);
+
+        if(-1 == bytes_read) { /* error */
+            int myerrno = errno;
+            time_t mytime = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file vector read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', vector length = %d, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), iovcnt, (unsigned long long)addr);
+        } /* end if */
+
+        if(0 == bytes_read) {
+            /* end of file but not end of format address space */
+            while(iovcnt > 0) {
+                HDmemset(iov->iov_base, 0, iov->iov_len);
+                iov++;
+                iovcnt--;
+            } /* end while */
+            break;
+        } /* end if */
+
+        addr += (haddr_t)bytes_read;
+
+        /* Skip the buffers that were completely filled and advance into
+         * a partially filled one.
+         */
+        while(iovcnt > 0 && (size_t)bytes_read >= iov->iov_len) {
+            bytes_read -= (ssize_t)iov->iov_len;
+            iov++;
+            iovcnt--;
+        } /* end while */
+        if(bytes_read > 0) {
+            iov->iov_base = (char *)iov->iov_base + bytes_read;
+            iov->iov_len -= (size_t)bytes_read;
+        } /* end if */
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_readv() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_writev
+ *
+ * Purpose:     Writes the IOVCNT buffers described by IOV to the file as a
+ *              single block beginning at address ADDR, with pwritev().
+ *              The elements of IOV are modified.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__sec2_writev(H5FD_sec2_t *file, struct iovec *iov, int iovcnt, haddr_t addr)
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(file);
+    HDassert(iov);
+
+    /* Write the data, being careful of interrupted system calls and partial
+     * results
+     */
+    while(iovcnt > 0) {
+        ssize_t     bytes_wrote     = -1;   /* # of bytes written   */
+
+        do {
+            bytes_wrote = HDpwritev(file->fd, iov, iovcnt, (HDoff_t)addr);
+        } while(-1 == bytes_wrote && EINTR == errno);
+
+        if(-1 == bytes_wrote) { /* error */
+            int myerrno = errno;
+            time_t mytime = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', vector length = %d, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), iovcnt, (unsigned long long)addr);
+        } /* end if */
+
+        HDassert(bytes_wrote > 0);
+
+        addr += (haddr_t)bytes_wrote;
+
+        /* Skip the buffers that were completely written and advance into
+         * a partially written one.
+         */
+        while(iovcnt > 0 && (size_t)bytes_wrote >= iov->iov_len) {
+            bytes_wrote -= (ssize_t)iov->iov_len;
+            iov++;
+            iovcnt--;
+        } /* end while */
+        if(bytes_wrote > 0) {
+            iov->iov_base = (char *)iov->iov_base + bytes_wrote;
+            iov->iov_len -= (size_t)bytes_wrote;
+        } /* end if */
+    } /* end while */
+
+    /* Update eof */
+    if(addr > file->eof)
+        file->eof = addr;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_writev() */
+#endif /* H5_HAVE_PREADV && H5_HAVE_PWRITEV */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_read_vector
+ *
+ * Purpose:     Reads COUNT blocks of data from FILE.  Block U starts at
+ *              address ADDRS[U], is SIZES[U] bytes long and is read into
+ *              buffer BUFS[U].
+ *
+ *              Runs of blocks that are adjacent in the file are read
+ *              with a single preadv() call, where it is available.
+ *              Other blocks are read individually.
+ *
+ * Return:      Success:    SUCCEED. Results are stored in the caller-
+ *                          supplied buffers.
+ *              Failure:    FAIL, Contents of the buffers are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_read_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[] /*out*/)
+{
+    H5FD_sec2_t     *file       = (H5FD_sec2_t *)_file;
+#if defined(H5_HAVE_PREADV) && defined(H5_HAVE_PWRITEV)
+    struct iovec    iov[H5FD_SEC2_MAX_IOV];             /* I/O vector for preadv() */
+#endif /* H5_HAVE_PREADV && H5_HAVE_PWRITEV */
+    uint32_t        u;                                  /* Local index variable */
+    herr_t          ret_value   = SUCCEED;              /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    u = 0;
+    while(u < count) {
+#if defined(H5_HAVE_PREADV) && defined(H5_HAVE_PWRITEV)
+        size_t      total = sizes[u];   /* Size of this run of blocks */
+        int         n = 1;              /* # of blocks in this run */
+
+        /* Find the blocks that follow this one directly in the file */
+        while((u + (uint32_t)n) < count && n < H5FD_SEC2_MAX_IOV
+                && H5F_addr_eq(addrs[u + (uint32_t)n - 1] + sizes[u + (uint32_t)n - 1], addrs[u + (uint32_t)n])
+                && sizes[u + (uint32_t)n] <= (H5_POSIX_MAX_IO_BYTES - total)) {
+            total += sizes[u + (uint32_t)n];
+            n++;
+        } /* end while */
+
+        if(n > 1) {
+            int     i;                  /* Local index variable */
+
+            /* Check for overflow conditions */
+            if(!H5F_addr_defined(addrs[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+            if(REGION_OVERFLOW(addrs[u], total))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addrs[u])
+
+            /* Read the whole run with one call */
+            for(i = 0; i < n; i++) {
+                iov[i].iov_base = bufs[u + (uint32_t)i];
+                iov[i].iov_len = sizes[u + (uint32_t)i];
+            } /* end for */
+            if(H5FD__sec2_readv(file, iov, n, addrs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "vector read failed")
+
+            u += (uint32_t)n;
+            continue;
+        } /* end if */
+#endif /* H5_HAVE_PREADV && H5_HAVE_PWRITEV */
+
+        /* Read a single block */
+        if(H5FD_sec2_read(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read failed")
+        u++;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_read_vector() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_write_vector
+ *
+ * Purpose:     Writes COUNT blocks of data to FILE.  Block U starts at
+ *              address ADDRS[U], is SIZES[U] bytes long and is written
+ *              from buffer BUFS[U].
+ *
+ *              Runs of blocks that are adjacent in the file are written
+ *              with a single pwritev() call, where it is available.
+ *              Other blocks are written individually.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_write_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    H5FD_sec2_t     *file       = (H5FD_sec2_t *)_file;
+#if defined(H5_HAVE_PREADV) && defined(H5_HAVE_PWRITEV)
+    struct iovec    iov[H5FD_SEC2_MAX_IOV];             /* I/O vector for pwritev() */
+#endif /* H5_HAVE_PREADV && H5_HAVE_PWRITEV */
+    uint32_t        u;                                  /* Local index variable */
+    herr_t          ret_value   = SUCCEED;              /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    u = 0;
+    while(u < count) {
+#if defined(H5_HAVE_PREADV) && defined(H5_HAVE_PWRITEV)
+        size_t      total = sizes[u];   /* Size of this run of blocks */
+        int         n = 1;              /* # of blocks in this run */
+
+        /* Find the blocks that follow this one directly in the file */
+        while((u + (uint32_t)n) < count && n < H5FD_SEC2_MAX_IOV
+                && H5F_addr_eq(addrs[u + (uint32_t)n - 1] + sizes[u + (uint32_t)n - 1], addrs[u + (uint32_t)n])
+                && sizes[u + (uint32_t)n] <= (H5_POSIX_MAX_IO_BYTES - total)) {
+            total += sizes[u + (uint32_t)n];
+            n++;
+        } /* end while */
+
+        if(n > 1) {
+            int     i;                  /* Local index variable */
+
+            /* Check for overflow conditions */
+            if(!H5F_addr_defined(addrs[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+            if(REGION_OVERFLOW(addrs[u], total))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addrs[u], (unsigned long long)total)
+
+            /* Write the whole run with one call */
+            for(i = 0; i < n; i++) {
+                /* (pwritev() doesn't modify the buffers, so casting away
+                 *  const is safe here.)
+                 */
+                iov[i].iov_base = (void *)bufs[u + (uint32_t)i];
+                iov[i].iov_len = sizes[u + (uint32_t)i];
+            } /* end for */
+            if(H5FD__sec2_writev(file, iov, n, addrs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "vector write failed")
+
+            u += (uint32_t)n;
+            continue;
+        } /* end if */
+#endif /* H5_HAVE_PREADV && H5_HAVE_PWRITEV */
+
+        /* Write a single block */
+        if(H5FD_sec2_write(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write failed")
+        u++;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_write_vector() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5FD_sec2_truncate
@@ -895,9 +1266,11 @@ H5FD_sec2_truncate(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATTR_
         /* Update the eof value */
         file->eof = file->eoa;
 
+#ifndef H5FD_SEC2_USE_PREADWRITE
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
+#endif /* H5FD_SEC2_USE_PREADWRITE */
     } /* end if */
 
 done:
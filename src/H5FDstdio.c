@@ -209,7 +209,10 @@ static const H5FD_class_t H5FD_stdio_g = {
     H5FD_stdio_truncate,        /* truncate     */
     H5FD_stdio_lock,            /* lock         */
     H5FD_stdio_unlock,          /* unlock       */
-    H5FD_FLMAP_DICHOTOMY	/* fl_map       */
+    H5FD_FLMAP_DICHOTOMY,	/* fl_map       */
+    NULL,                       /* read_vector  */
+    NULL,                       /* write_vector */
+    NULL                        /* get_ptr */
 };
 
 
@@ -58,6 +58,8 @@
 /********************/
 /* Local Prototypes */
 /********************/
+static hbool_t H5F__vector_overlaps_accum(const H5F_t *f, uint32_t count,
+    const haddr_t addrs[], const size_t sizes[]);
 
 
 /*********************/
@@ -113,8 +115,13 @@ H5F_block_read(H5F_t *f, H5FD_mem_t type, haddr_t addr, size_t size,
     /* Treat global heap as raw data */
     map_type = (type == H5FD_MEM_GHEAP) ? H5FD_MEM_DRAW : type;
 
+    /* Read metadata through the prefetcher, when it's in use */
+    if(f->shared->prefetch.block_size && map_type != H5FD_MEM_DRAW) {
+        if(H5F__prefetch_read(f, map_type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through metadata prefetcher failed")
+    } /* end if */
     /* Pass through page buffer layer */
-    if(H5PB_read(f, map_type, addr, size, buf) < 0)
+    else if(H5PB_read(f, map_type, addr, size, buf) < 0)
         HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through page buffer failed")
 
 done:
@@ -168,6 +175,211 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F_block_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_read_vector
+ *
+ * Purpose:	Reads COUNT blocks of data from a file/server/etc into
+ *		buffers.  Each block is contiguous and its address is
+ *		relative to the base address for the file.
+ *
+ *		Raw data vectors are handed to the file driver as a whole,
+ *		so that drivers with vector I/O support can service them
+ *		with fewer calls.  When the page buffer is enabled, when
+ *		any block is metadata, or when any block overlaps the
+ *		metadata accumulator (e.g. freed metadata space reused for
+ *		raw data), each block is read with H5F_block_read().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_read_vector(H5F_t *f, uint32_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/)
+{
+    hbool_t     raw_only = TRUE;        /* Whether all blocks are raw data */
+    uint32_t    u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    for(u = 0; u < count; u++) {
+        HDassert(bufs[u]);
+        HDassert(H5F_addr_defined(addrs[u]));
+
+        /* Check for attempting I/O on 'temporary' file address */
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+
+        if(H5FD_MEM_DRAW != types[u])
+            raw_only = FALSE;
+    } /* end for */
+
+    if(raw_only && NULL == f->shared->page_buf &&
+            !H5F__vector_overlaps_accum(f, count, addrs, sizes)) {
+        /* Dispatch the whole vector to the file driver */
+        if(H5FD_read_vector(f->shared->lf, count, types, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read vector request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(H5F_block_read(f, types[u], addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_read_vector() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_write_vector
+ *
+ * Purpose:	Writes COUNT blocks of data from memory to a
+ *		file/server/etc.  Each block is contiguous and its address
+ *		is relative to the base address for the file.
+ *
+ *		See H5F_block_read_vector() for when the vector is passed
+ *		to the file driver as a whole.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_write_vector(H5F_t *f, uint32_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    hbool_t     raw_only = TRUE;        /* Whether all blocks are raw data */
+    uint32_t    u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(H5F_INTENT(f) & H5F_ACC_RDWR);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    for(u = 0; u < count; u++) {
+        HDassert(bufs[u]);
+        HDassert(H5F_addr_defined(addrs[u]));
+
+        /* Check for attempting I/O on 'temporary' file address */
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+
+        if(H5FD_MEM_DRAW != types[u])
+            raw_only = FALSE;
+    } /* end for */
+
+    if(raw_only && NULL == f->shared->page_buf &&
+            !H5F__vector_overlaps_accum(f, count, addrs, sizes)) {
+        /* Dispatch the whole vector to the file driver */
+        if(H5FD_write_vector(f->shared->lf, count, types, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver write vector request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(H5F_block_write(f, types[u], addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "block write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_write_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__vector_overlaps_accum
+ *
+ * Purpose:	Checks whether any of COUNT blocks overlaps the data held
+ *		in the metadata accumulator, in which case the blocks must
+ *		go through H5F__accum_read() / H5F__accum_write() so that
+ *		they are reconciled with the accumulator's contents.
+ *
+ * Return:	TRUE if a block overlaps the accumulator, FALSE otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5F__vector_overlaps_accum(const H5F_t *f, uint32_t count,
+    const haddr_t addrs[], const size_t sizes[])
+{
+    const H5F_meta_accum_t *accum = &f->shared->accum;  /* Alias for file's metadata accumulator */
+    uint32_t    u;                      /* Local index variable */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(accum->size > 0)
+        for(u = 0; u < count; u++)
+            if(H5F_addr_overlap(addrs[u], sizes[u], accum->loc, accum->size))
+                HGOTO_DONE(TRUE)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__vector_overlaps_accum() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_get_ptr
+ *
+ * Purpose:	Retrieves a pointer to SIZE bytes of raw data in the file
+ *		starting at address ADDR, when the file driver keeps the
+ *		file addressable in memory (e.g. the mmap driver).
+ *
+ *		*PTR is set to NULL when the driver can't provide such a
+ *		pointer, or when the data might not be current in the file
+ *		(i.e. the file is open for writing, so the page buffer or
+ *		metadata accumulator could hold newer data).  Callers should
+ *		then fall back to H5F_block_read().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_get_ptr(H5F_t *f, H5FD_mem_t type, haddr_t addr, size_t size,
+    const void **ptr/*out*/)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(ptr);
+
+    /* Default to no pointer */
+    *ptr = NULL;
+
+    /* Only raw data in files that can't change underneath us qualifies */
+    if(H5FD_MEM_DRAW != type || (H5F_INTENT(f) & H5F_ACC_RDWR) ||
+            NULL != f->shared->page_buf || !H5F_addr_defined(addr))
+        HGOTO_DONE(SUCCEED)
+
+    /* Check for attempting I/O on 'temporary' file address */
+    if(H5F_addr_le(f->shared->tmp_addr, (addr + size)))
+        HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+
+    /* Query the file driver */
+    if(H5FD_get_ptr(f->shared->lf, type, addr, size, ptr) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "driver get_ptr request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_get_ptr() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5F_flush_tagged_metadata
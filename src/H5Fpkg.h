@@ -74,6 +74,9 @@
 #define H5F_MAX_DRVINFOBLOCK_SIZE  1024         /* Maximum size of superblock driver info buffer */
 #define H5F_DRVINFOBLOCK_HDR_SIZE 16            /* Size of superblock driver info header */
 
+/* Number of blocks of metadata kept by a file's metadata prefetcher */
+#define H5F_PREFETCH_NBLOCKS    16
+
 /* Superblock sizes for various versions */
 #define H5F_SIZEOF_CHKSUM 4     /* Checksum size in the file */
 
@@ -199,6 +202,21 @@ typedef struct H5F_meta_accum_t {
     hbool_t             dirty;          /* Flag to indicate that the accumulated metadata is dirty */
 } H5F_meta_accum_t;
 
+/* Structure for a block of metadata read ahead of its use */
+typedef struct H5F_meta_prefetch_block_t {
+    unsigned char      *buf;            /* Buffer holding the block */
+    haddr_t             loc;            /* File location (offset) of the block */
+    size_t              size;           /* Size of the block read (in bytes, 0 if unused) */
+    uint64_t            last_used;      /* When the block was last read from */
+} H5F_meta_prefetch_block_t;
+
+/* Structure for metadata prefetcher fields (see H5Fprefetch.c) */
+typedef struct H5F_meta_prefetch_t {
+    size_t              block_size;     /* Size of the blocks read (0 if not prefetching) */
+    uint64_t            clock;          /* Number of reads from the blocks */
+    H5F_meta_prefetch_block_t blocks[H5F_PREFETCH_NBLOCKS]; /* Blocks read */
+} H5F_meta_prefetch_t;
+
 /* A record of the mount table */
 typedef struct H5F_mount_t {
     struct H5G_t	*group;	/* Mount point group held open		*/
@@ -293,10 +311,14 @@ struct H5F_file_t {
     hid_t       fcpl_id;	/* File creation property list ID 	*/
     H5F_close_degree_t fc_degree;   /* File close behavior degree	*/
     hbool_t evict_on_close; /* If the file's objects should be evicted from the metadata cache on close */
+    unsigned    mdc_flush_threads; /* # of threads which may serialize metadata cache entries on flush */
     size_t	rdcc_nslots;	/* Size of raw data chunk cache (slots)	*/
     size_t	rdcc_nbytes;	/* Size of raw data chunk cache	(bytes)	*/
     double	rdcc_w0;	/* Preempt read chunks first? [0.0..1.0]*/
+    size_t	rdcc_pool_nbytes; /* Size of raw data chunk cache shared by all datasets (bytes), 0 if none */
+    struct H5D_rdcc_pool_t *rdcc_pool; /* Raw data chunk cache byte budget shared by all datasets */
     size_t      sieve_buf_size; /* Size of the data sieve buffer allocated (in bytes) */
+    size_t      meta_prefetch_size; /* Size of metadata prefetch blocks requested (in bytes) */
     hsize_t	threshold;	/* Threshold for alignment		*/
     hsize_t	alignment;	/* Alignment				*/
     unsigned	gc_ref;		/* Garbage-collect references?		*/
@@ -346,6 +368,9 @@ struct H5F_file_t {
     /* Metadata accumulator information */
     H5F_meta_accum_t accum;                 /* Metadata accumulator info */
 
+    /* Metadata prefetcher information */
+    H5F_meta_prefetch_t prefetch;           /* Metadata prefetcher info */
+
     /* Metadata retry info */
     unsigned 		read_attempts;	    /* The # of reads to try when reading metadata with checksum */
     unsigned		retries_nbins;	    /* # of bins for each retries[] */
@@ -445,6 +470,12 @@ H5_DLL herr_t H5F__accum_free(H5F_t *f, H5FD_mem_t type, haddr_t addr,
 H5_DLL herr_t H5F__accum_flush(H5F_t *f);
 H5_DLL herr_t H5F__accum_reset(H5F_t *f, hbool_t flush);
 
+/* Metadata prefetcher routines */
+H5_DLL herr_t H5F__prefetch_init(H5F_t *f);
+H5_DLL herr_t H5F__prefetch_read(H5F_t *f, H5FD_mem_t type, haddr_t addr,
+    size_t size, void *buf);
+H5_DLL herr_t H5F__prefetch_reset(H5F_t *f);
+
 /* Shared file list related routines */
 H5_DLL herr_t H5F_sfile_add(H5F_file_t *shared);
 H5_DLL H5F_file_t * H5F_sfile_search(H5FD_t *lf);
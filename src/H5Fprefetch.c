@@ -0,0 +1,241 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*-------------------------------------------------------------------------
+ *
+ * Created:             H5Fprefetch.c
+ *
+ * Purpose:             File metadata "prefetcher" routines.  (Used to read
+ *                      the metadata around each small metadata read in a
+ *                      single larger I/O, for files opened read-only, so
+ *                      metadata written close together is read together)
+ *
+ *-------------------------------------------------------------------------
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5Fmodule.h"          /* This source code file is part of the H5F module */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Fpkg.h"             /* File access				*/
+#include "H5FDprivate.h"	/* File drivers				*/
+#include "H5PBprivate.h"	/* Page Buffer				*/
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+
+/********************/
+/* Package Typedefs */
+/********************/
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Declare a PQ free list to manage the metadata prefetch blocks */
+H5FL_BLK_DEFINE_STATIC(meta_prefetch);
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__prefetch_init
+ *
+ * Purpose:	Starts prefetching metadata for a file, if it was asked
+ *		for and the file can be prefetched from: it must be opened
+ *		read-only, so what's read ahead can't change, and not for
+ *		SWMR reading, where it changes underneath.  Files with a
+ *		page buffer already read whole pages, and the multi and
+ *		split drivers keep each type of metadata in its own file,
+ *		so a block read around one type of metadata may not exist.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__prefetch_init(H5F_t *f)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(0 == f->shared->prefetch.block_size);
+
+    if(f->shared->meta_prefetch_size > 0
+            && !(H5F_INTENT(f) & (H5F_ACC_RDWR | H5F_ACC_SWMR_READ))
+            && NULL == f->shared->page_buf
+            && !H5F_HAS_FEATURE(f, H5FD_FEAT_PAGED_AGGR))
+        f->shared->prefetch.block_size = f->shared->meta_prefetch_size;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5F__prefetch_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__prefetch_read
+ *
+ * Purpose:	Reads some metadata through the file's prefetcher.  Reads
+ *		that fall in a block read earlier are copied from it.
+ *		Otherwise the block around the read (aligned to the block
+ *		size, or starting with the read if it would straddle two
+ *		blocks) is read from the file, replacing the least recently
+ *		used block.  Reads larger than half a block go straight to
+ *		the file.
+ *
+ * Note:	The blocks may hold raw data and free space as well as
+ *		metadata, which is fine since nothing in the file changes
+ *		while it's opened read-only.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__prefetch_read(H5F_t *f, H5FD_mem_t type, haddr_t addr, size_t size,
+    void *buf/*out*/)
+{
+    H5F_meta_prefetch_t *prefetch;      /* Alias for file's metadata prefetcher */
+    H5F_meta_prefetch_block_t *block;   /* Block read from or into */
+    haddr_t     loc;                    /* File location of block to read */
+    haddr_t     eoa;                    /* End of allocated space in the file */
+    size_t      nbytes;                 /* Size of block to read */
+    unsigned    u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(f->shared->prefetch.block_size > 0);
+    HDassert(type != H5FD_MEM_DRAW);
+    HDassert(buf);
+
+    /* Set up alias for file's metadata prefetcher */
+    prefetch = &f->shared->prefetch;
+
+    /* Look for a block holding all of the metadata */
+    for(u = 0; u < H5F_PREFETCH_NBLOCKS; u++) {
+        block = &prefetch->blocks[u];
+        if(block->size > 0 && H5F_addr_le(block->loc, addr)
+                && H5F_addr_le(addr + size, block->loc + block->size)) {
+            HDmemcpy(buf, block->buf + (addr - block->loc), size);
+            block->last_used = ++prefetch->clock;
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+    } /* end for */
+
+    /* Large reads aren't worth holding on to */
+    if(size > prefetch->block_size / 2) {
+        if(H5PB_read(f, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through page buffer failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Work out the block to read, staying within the file */
+    loc = addr - (addr % prefetch->block_size);
+    if(H5F_addr_gt(addr + size, loc + prefetch->block_size))
+        loc = addr;
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(f->shared->lf, type)))
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "unable to get end of allocated space")
+    nbytes = prefetch->block_size;
+    if(H5F_addr_gt(loc + nbytes, eoa) && H5F_addr_lt(loc, eoa))
+        nbytes = (size_t)(eoa - loc);
+
+    /* Pick the least recently used block to replace */
+    block = &prefetch->blocks[0];
+    for(u = 1; u < H5F_PREFETCH_NBLOCKS && block->size > 0; u++)
+        if(prefetch->blocks[u].size == 0 || prefetch->blocks[u].last_used < block->last_used)
+            block = &prefetch->blocks[u];
+
+    /* Read the block */
+    if(NULL == block->buf)
+        if(NULL == (block->buf = H5FL_BLK_MALLOC(meta_prefetch, prefetch->block_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate metadata prefetch block")
+    block->size = 0;
+    if(H5FD_read(f->shared->lf, type, loc, nbytes, block->buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
+    block->loc = loc;
+    block->size = nbytes;
+    block->last_used = ++prefetch->clock;
+
+    /* Copy the metadata out of the block */
+    HDassert(H5F_addr_le(addr + size, block->loc + block->size));
+    HDmemcpy(buf, block->buf + (addr - block->loc), size);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__prefetch_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__prefetch_reset
+ *
+ * Purpose:	Stops prefetching metadata for a file and releases the
+ *		blocks read.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__prefetch_reset(H5F_t *f)
+{
+    unsigned    u;                      /* Local index variable */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+
+    for(u = 0; u < H5F_PREFETCH_NBLOCKS; u++)
+        if(f->shared->prefetch.blocks[u].buf)
+            f->shared->prefetch.blocks[u].buf = H5FL_BLK_FREE(meta_prefetch, f->shared->prefetch.blocks[u].buf);
+    HDmemset(&f->shared->prefetch, 0, sizeof(f->shared->prefetch));
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5F__prefetch_reset() */
@@ -311,6 +311,9 @@ typedef struct H5F_t H5F_t;
 #define H5F_RDCC_NSLOTS(F)      ((F)->shared->rdcc_nslots)
 #define H5F_RDCC_NBYTES(F)      ((F)->shared->rdcc_nbytes)
 #define H5F_RDCC_W0(F)          ((F)->shared->rdcc_w0)
+#define H5F_RDCC_POOL_NBYTES(F) ((F)->shared->rdcc_pool_nbytes)
+#define H5F_RDCC_POOL(F)        ((F)->shared->rdcc_pool)
+#define H5F_SET_RDCC_POOL(F, P) ((F)->shared->rdcc_pool = (P))
 #define H5F_SIEVE_BUF_SIZE(F)   ((F)->shared->sieve_buf_size)
 #define H5F_GC_REF(F)           ((F)->shared->gc_ref)
 #define H5F_STORE_MSG_CRT_IDX(F)    ((F)->shared->store_msg_crt_idx)
@@ -368,6 +371,9 @@ typedef struct H5F_t H5F_t;
 #define H5F_RDCC_NSLOTS(F)      (H5F_rdcc_nslots(F))
 #define H5F_RDCC_NBYTES(F)      (H5F_rdcc_nbytes(F))
 #define H5F_RDCC_W0(F)          (H5F_rdcc_w0(F))
+#define H5F_RDCC_POOL_NBYTES(F) (H5F_rdcc_pool_nbytes(F))
+#define H5F_RDCC_POOL(F)        (H5F_rdcc_pool(F))
+#define H5F_SET_RDCC_POOL(F, P) (H5F_set_rdcc_pool((F), (P)))
 #define H5F_SIEVE_BUF_SIZE(F)   (H5F_sieve_buf_size(F))
 #define H5F_GC_REF(F)           (H5F_gc_ref(F))
 #define H5F_STORE_MSG_CRT_IDX(F) (H5F_store_msg_crt_idx(F))
@@ -472,10 +478,12 @@ typedef struct H5F_t H5F_t;
 #define H5F_ACS_DATA_CACHE_NUM_SLOTS_NAME       "rdcc_nslots"   /* Size of raw data chunk cache(slots) */
 #define H5F_ACS_DATA_CACHE_BYTE_SIZE_NAME       "rdcc_nbytes"   /* Size of raw data chunk cache(bytes) */
 #define H5F_ACS_PREEMPT_READ_CHUNKS_NAME        "rdcc_w0"       /* Preemption read chunks first */
+#define H5F_ACS_DATA_CACHE_POOL_SIZE_NAME       "rdcc_pool_nbytes" /* Size of raw data chunk cache shared by all datasets(bytes) */
 #define H5F_ACS_ALIGN_THRHD_NAME                "threshold"     /* Threshold for alignment */
 #define H5F_ACS_ALIGN_NAME                      "align"         /* Alignment */
 #define H5F_ACS_META_BLOCK_SIZE_NAME            "meta_block_size" /* Minimum metadata allocation block size (when aggregating metadata allocations) */
 #define H5F_ACS_SIEVE_BUF_SIZE_NAME             "sieve_buf_size" /* Maximum sieve buffer size (when data sieving is allowed by file driver) */
+#define H5F_ACS_META_PREFETCH_SIZE_NAME         "meta_prefetch_size" /* Size of blocks of metadata read ahead of their use (files opened read-only) */
 #define H5F_ACS_SDATA_BLOCK_SIZE_NAME           "sdata_block_size" /* Minimum "small data" allocation block size (when aggregating "small" raw data allocations) */
 #define H5F_ACS_GARBG_COLCT_REF_NAME            "gc_ref"        /* Garbage-collect references */
 #define H5F_ACS_FILE_DRV_NAME                   "vfd_info" /* File driver ID & info */
@@ -501,6 +509,7 @@ typedef struct H5F_t H5F_t;
 #define H5F_ACS_START_MDC_LOG_ON_ACCESS_NAME    "start_mdc_log_on_access" /* Whether logging starts on file create/open */
 #define H5F_ACS_CORE_WRITE_TRACKING_FLAG_NAME   "core_write_tracking_flag" /* Whether or not core VFD backing store write tracking is enabled */
 #define H5F_ACS_EVICT_ON_CLOSE_FLAG_NAME        "evict_on_close_flag" /* Whether or not the metadata cache will evict objects on close */
+#define H5F_ACS_MDC_FLUSH_THREADS_NAME          "mdc_flush_threads" /* # of threads serializing metadata cache entries on flush */
 #define H5F_ACS_CORE_WRITE_TRACKING_PAGE_SIZE_NAME "core_write_tracking_page_size" /* The page size in kiB when core VFD write tracking is enabled */
 #define H5F_ACS_COLL_MD_WRITE_FLAG_NAME         "collective_metadata_write" /* property indicating whether metadata writes are done collectively or not */
 #define H5F_ACS_META_CACHE_INIT_IMAGE_CONFIG_NAME "mdc_initCacheImageCfg" /* Initial metadata cache image creation configuration */
@@ -598,6 +607,9 @@ typedef struct H5F_t H5F_t;
 #define H5B2_INT_MAGIC                  "BTIN"          /* Internal node */
 #define H5B2_LEAF_MAGIC                 "BTLF"          /* Leaf node */
 
+/* Sharded chunk index signature */
+#define H5D_SHARD_MAGIC                 "SHRD"          /* Shard offset table */
+
 /* Extensible array signatures */
 #define H5EA_HDR_MAGIC                  "EAHD"          /* Header */
 #define H5EA_IBLOCK_MAGIC               "EAIB"          /* Index block */
@@ -645,6 +657,7 @@ struct H5O_loc_t;
 struct H5HG_heap_t;
 struct H5VL_class_t;
 struct H5P_genplist_t;
+struct H5D_rdcc_pool_t;
 
 /* Forward declarations for anonymous H5F objects */
 
@@ -759,9 +772,13 @@ H5_DLL herr_t H5F_set_sohm_nindexes(H5F_t *f, unsigned nindexes);
 H5_DLL hid_t H5F_get_fcpl(const H5F_t *f);
 H5_DLL H5F_close_degree_t H5F_get_fc_degree(const H5F_t *f);
 H5_DLL hbool_t H5F_get_evict_on_close(const H5F_t *f);
+H5_DLL unsigned H5F_get_mdc_flush_threads(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nbytes(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nslots(const H5F_t *f);
 H5_DLL double H5F_rdcc_w0(const H5F_t *f);
+H5_DLL size_t H5F_rdcc_pool_nbytes(const H5F_t *f);
+H5_DLL struct H5D_rdcc_pool_t *H5F_rdcc_pool(const H5F_t *f);
+H5_DLL void H5F_set_rdcc_pool(H5F_t *f, struct H5D_rdcc_pool_t *pool);
 H5_DLL size_t H5F_sieve_buf_size(const H5F_t *f);
 H5_DLL unsigned H5F_gc_ref(const H5F_t *f);
 H5_DLL unsigned H5F_use_latest_flags(const H5F_t *f, unsigned fl);
@@ -786,6 +803,7 @@ H5_DLL hid_t H5F_get_driver_id(const H5F_t *f);
 H5_DLL herr_t H5F_get_fileno(const H5F_t *f, unsigned long *filenum);
 H5_DLL hbool_t H5F_has_feature(const H5F_t *f, unsigned feature);
 H5_DLL haddr_t H5F_get_eoa(const H5F_t *f, H5FD_mem_t type);
+H5_DLL htri_t H5F_is_unwritten_addr(const H5F_t *f, haddr_t addr);
 H5_DLL herr_t H5F_get_vfd_handle(const H5F_t *file, hid_t fapl, void **file_handle);
 
 /* Functions that check file mounting information */
@@ -799,6 +817,14 @@ H5_DLL herr_t H5F_block_read(H5F_t *f, H5FD_mem_t type, haddr_t addr,
     size_t size, void *buf/*out*/);
 H5_DLL herr_t H5F_block_write(H5F_t *f, H5FD_mem_t type, haddr_t addr,
     size_t size, const void *buf);
+H5_DLL herr_t H5F_block_read_vector(H5F_t *f, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]/*out*/);
+H5_DLL herr_t H5F_block_write_vector(H5F_t *f, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[]);
+H5_DLL herr_t H5F_block_get_ptr(H5F_t *f, H5FD_mem_t type, haddr_t addr,
+    size_t size, const void **ptr/*out*/);
 
 /* Functions that flush or evict */
 H5_DLL herr_t H5F_flush_tagged_metadata(H5F_t *f, haddr_t tag);
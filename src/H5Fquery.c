@@ -635,6 +635,51 @@ H5F_rdcc_w0(const H5F_t *f)
     FUNC_LEAVE_NOAPI(f->shared->rdcc_w0)
 } /* end H5F_rdcc_w0() */
 
+
+/*-------------------------------------------------------------------------
+ * Function: H5F_rdcc_pool_nbytes
+ *
+ * Purpose:  Retrieve the number of bytes of raw data chunk cache shared
+ *           by all the datasets in the file.
+ *
+ * Return:   The size of the shared chunk cache in bytes (0 if the
+ *           datasets' chunk caches aren't limited together)
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5F_rdcc_pool_nbytes(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_pool_nbytes)
+} /* end H5F_rdcc_pool_nbytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5F_rdcc_pool
+ *
+ * Purpose:  Retrieve the raw data chunk cache byte budget shared by the
+ *           file's datasets.
+ *
+ * Return:   Pointer to the shared budget, or NULL if none is in use
+ *-------------------------------------------------------------------------
+ */
+struct H5D_rdcc_pool_t *
+H5F_rdcc_pool(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_pool)
+} /* end H5F_rdcc_pool() */
+
 
 /*-------------------------------------------------------------------------
  * Function: H5F_get_base_addr
@@ -784,6 +829,29 @@ H5F_get_evict_on_close(const H5F_t *f)
     FUNC_LEAVE_NOAPI(f->shared->evict_on_close)
 } /* end H5F_get_evict_on_close() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F_get_mdc_flush_threads
+ *
+ * Purpose:     Retrieve the # of threads which may serialize the file's
+ *              metadata cache entries on flush.
+ *
+ * Return:      Success:    The # of threads (at least 1)
+ *              Failure:    (can't happen)
+ *-------------------------------------------------------------------------
+ */
+unsigned
+H5F_get_mdc_flush_threads(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->mdc_flush_threads)
+} /* end H5F_get_mdc_flush_threads() */
+
 
 /*-------------------------------------------------------------------------
  * Function: H5F_store_msg_crt_idx
@@ -910,6 +978,42 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F_get_eoa() */
 
+
+/*-------------------------------------------------------------------------
+ * Function: H5F_is_unwritten_addr
+ *
+ * Purpose:  Check whether nothing at or past ADDR has been written to the
+ *           file's raw data, so the file reads as zeros there.  Not known
+ *           with paged aggregation, where the page buffer can hold pages
+ *           that haven't been written yet.
+ *
+ * Return:   TRUE/FALSE/FAIL
+ *-------------------------------------------------------------------------
+ */
+htri_t
+H5F_is_unwritten_addr(const H5F_t *f, haddr_t addr)
+{
+    haddr_t    eof;                     /* End of what's written to the file */
+    htri_t     ret_value = FAIL;        /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    if(H5F_PAGED_AGGR(f))
+        HGOTO_DONE(FALSE)
+
+    /* Dispatch to driver */
+    if(HADDR_UNDEF == (eof = H5FD_get_eof(f->shared->lf, H5FD_MEM_DRAW)))
+        HGOTO_ERROR(H5E_VFL, H5E_CANTGET, FAIL, "driver get_eof request failed")
+
+    ret_value = (htri_t)H5F_addr_le(eof, addr);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_is_unwritten_addr() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5F_get_vfd_handle
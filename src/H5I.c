@@ -2197,6 +2197,7 @@ H5I__debug_cb(void *_item, void H5_ATTR_UNUSED *_key, void *_udata)
         case H5I_ERROR_CLASS:
         case H5I_ERROR_MSG:
         case H5I_ERROR_STACK:
+        case H5I_EVENTSET:
         case H5I_NTYPES:
         default:
             break;   /* Other types of IDs are not stored in files */
@@ -117,7 +117,7 @@ H5O__layout_decode(H5F_t *f, H5O_t H5_ATTR_UNUSED *open_oh,
     mesg->storage.type = H5D_LAYOUT_ERROR;
 
     mesg->version = *p++;
-    if(mesg->version < H5O_LAYOUT_VERSION_1 || mesg->version > H5O_LAYOUT_VERSION_4)
+    if(mesg->version < H5O_LAYOUT_VERSION_1 || mesg->version > H5O_LAYOUT_VERSION_5)
         HGOTO_ERROR(H5E_OHDR, H5E_CANTLOAD, NULL, "bad version number for layout message")
 
     if(mesg->version < H5O_LAYOUT_VERSION_3) {
@@ -350,6 +350,27 @@ H5O__layout_decode(H5F_t *f, H5O_t H5_ATTR_UNUSED *open_oh,
                             mesg->storage.u.chunk.ops = H5D_COPS_BT2;
                             break;
 
+                        case H5D_CHUNK_IDX_SHARD:     /* Sharded index */
+                            if(mesg->version < H5O_LAYOUT_VERSION_5)
+                                HGOTO_ERROR(H5E_OHDR, H5E_VERSION, NULL, "invalid layout version with sharded index")
+
+                            /* v2 B-tree creation parameters */
+                            UINT32DECODE(p, mesg->u.chunk.u.shard.btree2.cparam.node_size);
+                            mesg->u.chunk.u.shard.btree2.cparam.split_percent = *p++;
+                            mesg->u.chunk.u.shard.btree2.cparam.merge_percent = *p++;
+
+                            /* # of chunks in a shard in each dimension */
+                            for(u = 0; u < (mesg->u.chunk.ndims - 1); u++) {
+                                UINT32DECODE(p, mesg->u.chunk.u.shard.shard_dim[u]);
+                                if(0 == mesg->u.chunk.u.shard.shard_dim[u])
+                                    HGOTO_ERROR(H5E_OHDR, H5E_CANTLOAD, NULL, "invalid shard dimension")
+                            } /* end for */
+                            mesg->u.chunk.u.shard.shard_dim[mesg->u.chunk.ndims - 1] = 1;
+
+                            /* Set the chunk operations */
+                            mesg->storage.u.chunk.ops = H5D_COPS_SHARD;
+                            break;
+
                         case H5D_CHUNK_IDX_NTYPES:
                         default:
                             HGOTO_ERROR(H5E_OHDR, H5E_BADVALUE, NULL, "Invalid chunk index type")
@@ -658,6 +679,14 @@ H5O__layout_encode(H5F_t *f, hbool_t H5_ATTR_UNUSED disable_shared, uint8_t *p,
                         *p++ = mesg->u.chunk.u.btree2.cparam.merge_percent;
                         break;
 
+                    case H5D_CHUNK_IDX_SHARD:     /* Sharded index */
+                        UINT32ENCODE(p, mesg->u.chunk.u.shard.btree2.cparam.node_size);
+                        *p++ = mesg->u.chunk.u.shard.btree2.cparam.split_percent;
+                        *p++ = mesg->u.chunk.u.shard.btree2.cparam.merge_percent;
+                        for(u = 0; u < (mesg->u.chunk.ndims - 1); u++)
+                            UINT32ENCODE(p, mesg->u.chunk.u.shard.shard_dim[u]);
+                        break;
+
                     case H5D_CHUNK_IDX_NTYPES:
                     default:
                         HGOTO_ERROR(H5E_OHDR, H5E_CANTENCODE, FAIL, "Invalid chunk index type")
@@ -969,7 +998,7 @@ H5O__layout_pre_copy_file(H5F_t H5_ATTR_UNUSED *file_src, const void *mesg_src,
 
     /* Check to ensure that the version of the message to be copied does not exceed
        the message version allowed by the destination file's high bound */
-    if(layout_src->version > H5O_layout_ver_bounds[H5F_HIGH_BOUND(cpy_info->file_dst)])
+    if(layout_src->version > H5D_LAYOUT_MAX_VERSION(cpy_info->file_dst))
         HGOTO_ERROR(H5E_OHDR, H5E_BADRANGE, FAIL, "layout message version out of bounds")
 
 done:
@@ -1158,6 +1187,15 @@ H5O__layout_debug(H5F_t H5_ATTR_UNUSED *f, const void *_mesg, FILE *stream,
                     /* (Should print the v2-Btree creation parameters) */
                     break;
 
+                case H5D_CHUNK_IDX_SHARD:
+                    HDfprintf(stream, "%*s%-*s %s\n", indent, "", fwidth,
+                              "Index Type:", "Sharded");
+                    HDfprintf(stream, "%*s%-*s {", indent, "", fwidth, "Shard size (chunks):");
+                    for(u = 0; u < (size_t)(mesg->u.chunk.ndims - 1); u++)
+                        HDfprintf(stream, "%s%lu", u ? ", " : "", (unsigned long)(mesg->u.chunk.u.shard.shard_dim[u]));
+                    HDfprintf(stream, "}\n");
+                    break;
+
                 case H5D_CHUNK_IDX_NTYPES:
                 default:
                     HDfprintf(stream, "%*s%-*s %s (%u)\n", indent, "", fwidth,
@@ -418,6 +418,12 @@ typedef struct H5O_efl_t {
  */
 #define H5O_LAYOUT_VERSION_4	4
 
+/* This version adds the sharded chunk index.  It's only used for datasets
+ *      with that index, when the file's format bounds allow the latest
+ *      format (see H5D_LAYOUT_MAX_VERSION).
+ */
+#define H5O_LAYOUT_VERSION_5	5
+
 /* The default version of the format.  (Earlier versions had bugs) */
 #define H5O_LAYOUT_VERSION_DEFAULT H5O_LAYOUT_VERSION_3
 
@@ -469,6 +475,14 @@ typedef struct H5O_storage_chunk_bt2_t {
     struct H5B2_t *bt2;                 /* Pointer to b-tree 2 struct */
 } H5O_storage_chunk_bt2_t;
 
+/* Forward declaration of structs used below */
+struct H5D_shard_cache_t;               /* Defined in H5Dshard.c          */
+
+typedef struct H5O_storage_chunk_shard_t {
+    H5O_storage_chunk_bt2_t btree2;     /* v2 B-tree indexing the shards */
+    struct H5D_shard_cache_t *cache;    /* Recently used shard offset tables */
+} H5O_storage_chunk_shard_t;
+
 typedef struct H5O_storage_chunk_t {
     H5D_chunk_index_t idx_type;		/* Type of chunk index               */
     haddr_t	idx_addr;		/* File address of chunk index       */
@@ -479,6 +493,7 @@ typedef struct H5O_storage_chunk_t {
         H5O_storage_chunk_earray_t earray; /* Information for extensible array index   */
         H5O_storage_chunk_farray_t farray; /* Information for fixed array index   */
         H5O_storage_chunk_single_filt_t single; /* Information for single chunk w/ filters index */
+        H5O_storage_chunk_shard_t shard;   /* Information for sharded index */
     } u;
 } H5O_storage_chunk_t;
 
@@ -607,6 +622,11 @@ typedef struct H5O_layout_chunk_bt2_t {
     } cparam;
 } H5O_layout_chunk_bt2_t;
 
+typedef struct H5O_layout_chunk_shard_t {
+    H5O_layout_chunk_bt2_t btree2;      /* Creation parameters for v2 B-tree of shards */
+    uint32_t    shard_dim[H5O_LAYOUT_NDIMS]; /* # of chunks in a shard in each dimension */
+} H5O_layout_chunk_shard_t;
+
 typedef struct H5O_layout_chunk_t {
     H5D_chunk_index_t idx_type;		/* Type of chunk index               */
     uint8_t     flags;                  /* Chunk layout flags                */
@@ -624,6 +644,7 @@ typedef struct H5O_layout_chunk_t {
         H5O_layout_chunk_farray_t farray; /* Information for fixed array index */
         H5O_layout_chunk_earray_t earray; /* Information for extensible array index */
         H5O_layout_chunk_bt2_t btree2; /* Information for v2 B-tree index */
+        H5O_layout_chunk_shard_t shard; /* Information for sharded index */
     } u;
 } H5O_layout_chunk_t;
 
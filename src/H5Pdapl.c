@@ -96,6 +96,16 @@
 #define H5D_ACS_EFILE_PREFIX_COPY               H5P__dapl_efile_pref_copy
 #define H5D_ACS_EFILE_PREFIX_CMP                H5P__dapl_efile_pref_cmp
 #define H5D_ACS_EFILE_PREFIX_CLOSE              H5P__dapl_efile_pref_close
+/* Definitions for # of chunks to read ahead of sequential access */
+#define H5D_ACS_CHUNK_READ_AHEAD_SIZE           sizeof(unsigned)
+#define H5D_ACS_CHUNK_READ_AHEAD_DEF            0
+#define H5D_ACS_CHUNK_READ_AHEAD_ENC            H5P__encode_unsigned
+#define H5D_ACS_CHUNK_READ_AHEAD_DEC            H5P__decode_unsigned
+/* Definitions for automatic sizing of the chunk cache */
+#define H5D_ACS_CHUNK_CACHE_AUTO_SIZE           sizeof(size_t)
+#define H5D_ACS_CHUNK_CACHE_AUTO_DEF            0
+#define H5D_ACS_CHUNK_CACHE_AUTO_ENC            H5P__encode_size_t
+#define H5D_ACS_CHUNK_CACHE_AUTO_DEC            H5P__decode_size_t
 
 /******************/
 /* Local Typedefs */
@@ -199,6 +209,8 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
     double rdcc_w0 = H5D_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
     H5D_vds_view_t virtual_view = H5D_ACS_VDS_VIEW_DEF;         /* Default VDS view option */
     hsize_t printf_gap = H5D_ACS_VDS_PRINTF_GAP_DEF;            /* Default VDS printf gap */
+    unsigned read_ahead = H5D_ACS_CHUNK_READ_AHEAD_DEF;         /* Default # of chunks to read ahead */
+    size_t cache_auto = H5D_ACS_CHUNK_CACHE_AUTO_DEF;           /* Default largest automatic chunk cache size */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
@@ -248,6 +260,16 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
             H5D_ACS_EFILE_PREFIX_DEL, H5D_ACS_EFILE_PREFIX_COPY, H5D_ACS_EFILE_PREFIX_CMP, H5D_ACS_EFILE_PREFIX_CLOSE) < 0)
          HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the # of chunks to read ahead of sequential access */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_READ_AHEAD_NAME, H5D_ACS_CHUNK_READ_AHEAD_SIZE, &read_ahead,
+             NULL, NULL, NULL, H5D_ACS_CHUNK_READ_AHEAD_ENC, H5D_ACS_CHUNK_READ_AHEAD_DEC, NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the largest size the chunk cache may grow to automatically */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_CACHE_AUTO_NAME, H5D_ACS_CHUNK_CACHE_AUTO_SIZE, &cache_auto,
+             NULL, NULL, NULL, H5D_ACS_CHUNK_CACHE_AUTO_ENC, H5D_ACS_CHUNK_CACHE_AUTO_DEC, NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dacc_reg_prop() */
@@ -864,6 +886,145 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_chunk_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_read_ahead
+ *
+ * Purpose:     Sets the number of chunks the chunk cache reads ahead of
+ *              a sequential or strided scan of a chunked dataset.  When
+ *              the last three chunks read are equally far apart (in the
+ *              dataset's linear chunk order) and the next chunk along
+ *              that stride isn't cached, up to NCHUNKS chunks along it
+ *              are read and unfiltered together and put in the chunk
+ *              cache, ahead of the reads which will need them.  Zero,
+ *              the default, turns reading ahead off.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_read_ahead(hid_t dapl_id, unsigned nchunks)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_READ_AHEAD_NAME, &nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_read_ahead
+ *
+ * Purpose:     Gets the number of chunks the chunk cache reads ahead of
+ *              a sequential or strided scan of a chunked dataset.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_read_ahead(hid_t dapl_id, unsigned *nchunks/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(nchunks)
+        if(H5P_get(plist, H5D_ACS_CHUNK_READ_AHEAD_NAME, nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_cache_auto
+ *
+ * Purpose:     Lets a chunked dataset's chunk cache resize itself as it
+ *              is used, between the size set with H5Pset_chunk_cache (or
+ *              H5Pset_cache), raised to hold at least one chunk, and
+ *              MAX_NBYTES.  The cache doubles when its hit rate is low
+ *              and many of its misses are on chunks it preempted
+ *              recently, and halves when most of it hasn't been used for
+ *              a while.  The byte budget the file's chunk caches share
+ *              (H5Pset_chunk_cache_pool) still caps them all together.
+ *              Zero, the default, keeps the cache's size fixed.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_auto(hid_t dapl_id, size_t max_nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", dapl_id, max_nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_CACHE_AUTO_NAME, &max_nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_auto() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_cache_auto
+ *
+ * Purpose:     Gets the largest size a chunked dataset's chunk cache may
+ *              grow to automatically, or zero if its size is fixed.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_auto(hid_t dapl_id, size_t *max_nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, max_nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(max_nbytes)
+        if(H5P_get(plist, H5D_ACS_CHUNK_CACHE_AUTO_NAME, max_nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_auto() */
+
 
 /*-------------------------------------------------------------------------
  * Function:       H5P__encode_chunk_cache_nslots
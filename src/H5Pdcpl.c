@@ -1934,6 +1934,13 @@ H5Pget_layout(hid_t plist_id)
     H5O_layout_t layout;        /* Layout property */
     H5D_layout_t ret_value;     /* Return value */
 
+    /* Try the shared read path first */
+    H5_API_READ_BEGIN
+        if(NULL != (plist = H5P_object_lookup(plist_id, H5P_DATASET_CREATE))
+                && H5P_peek_lookup(plist, H5D_CRT_LAYOUT_NAME, &layout))
+            H5_API_READ_RETURN(layout.type)
+    H5_API_READ_END
+
     FUNC_ENTER_API(H5D_LAYOUT_ERROR)
     H5TRACE1("Dl", "i", plist_id);
 
@@ -2066,6 +2073,20 @@ H5Pget_chunk(hid_t plist_id, int max_ndims, hsize_t dim[]/*out*/)
     H5O_layout_t layout;        /* Layout information */
     int ret_value;              /* Return value */
 
+    /* Try the shared read path first */
+    H5_API_READ_BEGIN
+        if(NULL != (plist = H5P_object_lookup(plist_id, H5P_DATASET_CREATE))
+                && H5P_peek_lookup(plist, H5D_CRT_LAYOUT_NAME, &layout)
+                && H5D_CHUNKED == layout.type) {
+            unsigned	u;      /* Local index variable */
+
+            if(dim)
+                for(u = 0; u < layout.u.chunk.ndims && u < (unsigned)max_ndims; u++)
+                    dim[u] = layout.u.chunk.dim[u];
+            H5_API_READ_RETURN((int)layout.u.chunk.ndims)
+        } /* end if */
+    H5_API_READ_END
+
     FUNC_ENTER_API(FAIL)
     H5TRACE3("Is", "iIsx", plist_id, max_ndims, dim);
 
@@ -2722,6 +2743,236 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_chunk_opts() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_shard
+ *
+ * Purpose:	Groups the chunks of a dataset into shards of DIM chunks
+ *		in each dimension.  Each shard is stored as one block in
+ *		the file, holding an offset table and the shard's chunks,
+ *		and the chunk index only has an entry for each shard.
+ *
+ *		Must be called after H5Pset_chunk(), since that resets the
+ *		chunk index information.  Datasets using shards need the
+ *		1.10 or later file format and can't be used with SWMR
+ *		writes or parallel I/O.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_shard(hid_t plist_id, int ndims, const hsize_t dim[/*ndims*/])
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    H5O_layout_t        layout;         /* Layout information for setting chunk info */
+    uint64_t            shard_nchunks = 1; /* Number of chunks in a shard */
+    unsigned            u;              /* Local index variable */
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "iIs*[a1]h", plist_id, ndims, dim);
+
+    /* Check arguments */
+    if(ndims <= 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "shard dimensionality must be positive")
+    if(!dim)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no shard dimensions specified")
+
+#ifndef H5_HAVE_C99_DESIGNATED_INITIALIZER
+    /* If the compiler doesn't support C99 designated initializers, check if
+     *  the default layout structs have been initialized yet or not.  *ick* -QAK
+     */
+    if(!H5P_dcrt_def_layout_init_g)
+        if(H5P__init_def_layout() < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTINIT, FAIL, "can't initialize default layout info")
+#endif /* H5_HAVE_C99_DESIGNATED_INITIALIZER */
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Retrieve the layout property */
+    if(H5P_peek(plist, H5D_CRT_LAYOUT_NAME, &layout) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "can't get layout")
+    if(H5D_CHUNKED != layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a chunked storage layout")
+    if((unsigned)ndims != layout.u.chunk.ndims)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "shard dimensionality must match chunk dimensionality")
+
+    /* Set the shard dimensions */
+    HDmemset(&layout.u.chunk.u, 0, sizeof(layout.u.chunk.u));
+    for(u = 0; u < (unsigned)ndims; u++) {
+        if(dim[u] == 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "all shard dimensions must be positive")
+        if(dim[u] != (dim[u] & 0xffffffff))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "all shard dimensions must be less than 2^32")
+        shard_nchunks *= dim[u];
+        if(shard_nchunks > (uint64_t)0xffffffff)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "number of chunks in shard must be < 4G")
+        layout.u.chunk.u.shard.shard_dim[u] = (uint32_t)dim[u];
+    } /* end for */
+
+    /* Update the layout message, including the version (if necessary) */
+    layout.u.chunk.idx_type = H5D_CHUNK_IDX_SHARD;
+    layout.version = H5O_LAYOUT_VERSION_5;
+
+    /* Set layout value */
+    if(H5P_poke(plist, H5D_CRT_LAYOUT_NAME, &layout) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINIT, FAIL, "can't set layout")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_shard() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_shard
+ *
+ * Purpose:	Retrieves the number of chunks in a shard in each
+ *		dimension.  At most MAX_NDIMS elements of DIM are set.
+ *
+ * Return:	Success:	Shard dimensionality, or 0 if the chunks
+ *				aren't grouped into shards
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+H5Pget_chunk_shard(hid_t plist_id, int max_ndims, hsize_t dim[]/*out*/)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    H5O_layout_t        layout;         /* Layout information */
+    int                 ret_value = 0;  /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("Is", "iIsx", plist_id, max_ndims, dim);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Peek at the layout property */
+    if(H5P_peek(plist, H5D_CRT_LAYOUT_NAME, &layout) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "can't get layout")
+    if(H5D_CHUNKED != layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a chunked storage layout")
+
+    if(H5D_CHUNK_IDX_SHARD == layout.u.chunk.idx_type) {
+        if(dim) {
+            unsigned u;         /* Local index variable */
+
+            for(u = 0; u < layout.u.chunk.ndims && u < (unsigned)max_ndims; u++)
+                dim[u] = layout.u.chunk.u.shard.shard_dim[u];
+        } /* end if */
+
+        ret_value = (int)layout.u.chunk.ndims;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_shard() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_implicit
+ *
+ * Purpose:	Requests an implicit chunk index: space for all the chunks
+ *		of the dataset is allocated in one block when the dataset
+ *		is created and a chunk's address is computed from its
+ *		offset, with no index records.  Chunks are only filled
+ *		with fill values when the fill values have to be written.
+ *
+ *		Sets the space allocation time to H5D_ALLOC_TIME_EARLY.
+ *		Datasets with filters or unlimited dimensions get the
+ *		chunk index they'd have without this call.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_implicit(hid_t plist_id)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    H5O_layout_t        layout;         /* Layout information for setting chunk info */
+    H5O_fill_t          fill;           /* Fill value property to modify */
+    unsigned            alloc_time_state = 0; /* State of allocation time property */
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", plist_id);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Retrieve the layout property */
+    if(H5P_peek(plist, H5D_CRT_LAYOUT_NAME, &layout) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "can't get layout")
+    if(H5D_CHUNKED != layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a chunked storage layout")
+
+    /* Update the layout message, including the version (if necessary) */
+    HDmemset(&layout.u.chunk.u, 0, sizeof(layout.u.chunk.u));
+    layout.u.chunk.idx_type = H5D_CHUNK_IDX_NONE;
+    layout.version = H5O_LAYOUT_VERSION_4;      /* (Also drops a sharded index's version) */
+
+    /* Set layout value */
+    if(H5P_poke(plist, H5D_CRT_LAYOUT_NAME, &layout) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINIT, FAIL, "can't set layout")
+
+    /* Allocate the dataset's space when it's created */
+    if(H5P_peek(plist, H5D_CRT_FILL_VALUE_NAME, &fill) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get fill value")
+    fill.alloc_time = H5D_ALLOC_TIME_EARLY;
+    if(H5P_poke(plist, H5D_CRT_FILL_VALUE_NAME, &fill) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set fill value")
+    if(H5P_set(plist, H5D_CRT_ALLOC_TIME_STATE_NAME, &alloc_time_state) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set space allocation time")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_implicit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_implicit
+ *
+ * Purpose:	Queries whether an implicit chunk index is requested (or,
+ *		for a dataset's creation property list, used).
+ *
+ * Return:	Success:	TRUE/FALSE
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+htri_t
+H5Pget_chunk_implicit(hid_t plist_id)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    H5O_layout_t        layout;         /* Layout information */
+    htri_t              ret_value = FAIL; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("t", "i", plist_id);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Peek at the layout property */
+    if(H5P_peek(plist, H5D_CRT_LAYOUT_NAME, &layout) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "can't get layout")
+    if(H5D_CHUNKED != layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a chunked storage layout")
+
+    ret_value = (htri_t)(H5D_CHUNK_IDX_NONE == layout.u.chunk.idx_type);
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_implicit() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_external
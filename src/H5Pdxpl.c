@@ -91,6 +91,16 @@
 #define H5D_XFER_HYPER_VECTOR_SIZE_DEF  H5D_IO_VECTOR_SIZE
 #define H5D_XFER_HYPER_VECTOR_SIZE_ENC  H5P__encode_size_t
 #define H5D_XFER_HYPER_VECTOR_SIZE_DEC  H5P__decode_size_t
+/* Definitions for filter pipeline threads property */
+#define H5D_XFER_FILTER_THREADS_SIZE    sizeof(unsigned)
+#define H5D_XFER_FILTER_THREADS_DEF     1
+#define H5D_XFER_FILTER_THREADS_ENC     H5P__encode_unsigned
+#define H5D_XFER_FILTER_THREADS_DEC     H5P__decode_unsigned
+/* Definitions for chunk cache bypass property */
+#define H5D_XFER_CHUNK_CACHE_BYPASS_SIZE sizeof(hbool_t)
+#define H5D_XFER_CHUNK_CACHE_BYPASS_DEF FALSE
+#define H5D_XFER_CHUNK_CACHE_BYPASS_ENC H5P__encode_hbool_t
+#define H5D_XFER_CHUNK_CACHE_BYPASS_DEC H5P__decode_hbool_t
 
 /* Parallel I/O properties */
 /* Note: Some of these are registered with the DXPL class even when parallel
@@ -168,6 +178,9 @@
 #define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_DEF      0
 #define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_SIZE      sizeof(hsize_t *)
 #define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_DEF       NULL
+/* Definitions for batch of chunks for direct chunk I/O */
+#define H5D_XFER_DIRECT_CHUNK_BATCH_SIZE            sizeof(H5D_direct_chunk_batch_t *)
+#define H5D_XFER_DIRECT_CHUNK_BATCH_DEF             NULL
 
 
 /******************/
@@ -254,6 +267,8 @@ static const void *H5D_def_vlen_alloc_info_g = H5D_XFER_VLEN_ALLOC_INFO_DEF;   /
 static const H5MM_free_t H5D_def_vlen_free_g = H5D_XFER_VLEN_FREE_DEF;         /* Default value for vlen free function */
 static const void *H5D_def_vlen_free_info_g = H5D_XFER_VLEN_FREE_INFO_DEF;     /* Default value for vlen free information */
 static const size_t H5D_def_hyp_vec_size_g = H5D_XFER_HYPER_VECTOR_SIZE_DEF;   /* Default value for vector size */
+static const unsigned H5D_def_filter_threads_g = H5D_XFER_FILTER_THREADS_DEF;  /* Default value for # of filter pipeline threads */
+static const hbool_t H5D_def_chunk_cache_bypass_g = H5D_XFER_CHUNK_CACHE_BYPASS_DEF;  /* Default value for chunk cache bypass flag */
 static const H5FD_mpio_xfer_t H5D_def_io_xfer_mode_g = H5D_XFER_IO_XFER_MODE_DEF;      /* Default value for I/O transfer mode */
 static const H5FD_mpio_chunk_opt_t H5D_def_mpio_chunk_opt_mode_g = H5D_XFER_MPIO_CHUNK_OPT_HARD_DEF;
 static const H5FD_mpio_collective_opt_t H5D_def_mpio_collective_opt_mode_g = H5D_XFER_MPIO_COLLECTIVE_OPT_DEF;
@@ -273,6 +288,7 @@ static const uint32_t H5D_def_direct_chunk_datasize_g = H5D_XFER_DIRECT_CHUNK_WR
 static const hbool_t direct_chunk_read_flag = H5D_XFER_DIRECT_CHUNK_READ_FLAG_DEF;         /* Default value for the flag of direct chunk read */
 static const hsize_t *direct_chunk_read_offset = H5D_XFER_DIRECT_CHUNK_READ_OFFSET_DEF;    /* Default value for the offset of direct chunk read */
 static const uint32_t direct_chunk_read_filters = H5D_XFER_DIRECT_CHUNK_READ_FILTERS_DEF;    /* Default value for the filters of direct chunk read */
+static const H5D_direct_chunk_batch_t *direct_chunk_batch = H5D_XFER_DIRECT_CHUNK_BATCH_DEF;  /* Default value for the batch of chunks for direct chunk I/O */
 
 
 /*-------------------------------------------------------------------------
@@ -353,6 +369,18 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the filter pipeline threads property */
+    if(H5P_register_real(pclass, H5D_XFER_FILTER_THREADS_NAME, H5D_XFER_FILTER_THREADS_SIZE, &H5D_def_filter_threads_g, 
+            NULL, NULL, NULL, H5D_XFER_FILTER_THREADS_ENC, H5D_XFER_FILTER_THREADS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the chunk cache bypass property */
+    if(H5P_register_real(pclass, H5D_XFER_CHUNK_CACHE_BYPASS_NAME, H5D_XFER_CHUNK_CACHE_BYPASS_SIZE, &H5D_def_chunk_cache_bypass_g, 
+            NULL, NULL, NULL, H5D_XFER_CHUNK_CACHE_BYPASS_ENC, H5D_XFER_CHUNK_CACHE_BYPASS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the I/O transfer mode properties */
     if(H5P_register_real(pclass, H5D_XFER_IO_XFER_MODE_NAME, H5D_XFER_IO_XFER_MODE_SIZE, &H5D_def_io_xfer_mode_g, 
             NULL, NULL, NULL, H5D_XFER_IO_XFER_MODE_ENC, H5D_XFER_IO_XFER_MODE_DEC,
@@ -465,6 +493,12 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the property of the batch of chunks for direct chunk I/O */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_BATCH_NAME, H5D_XFER_DIRECT_CHUNK_BATCH_SIZE, &direct_chunk_batch,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dxfr_reg_prop() */
@@ -1791,6 +1825,164 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_hyper_vector_size() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_filter_threads
+ *
+ * Purpose:	Given a dataset transfer property list, set the number of
+ *              threads which may run the I/O filter pipeline for the chunks
+ *              of a filtered dataset at once.  When a read or write covers
+ *              many chunks, their data is compressed or decompressed on a
+ *              pool of that many threads, while reading and writing the
+ *              file is still done by the calling thread, in chunk order.
+ *              The filters and any filter callback function set with
+ *              H5Pset_filter_callback() must be safe to call from several
+ *              threads at once.
+ *
+ *		The default is 1, which runs the pipeline on the calling
+ *              thread.  Larger values only have an effect when the library
+ *              is built thread-safe with pthreads.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_filter_threads(hid_t plist_id, unsigned num_threads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, num_threads);
+
+    /* Check arguments */
+    if(num_threads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads must be positive")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_FILTER_THREADS_NAME, &num_threads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_filter_threads() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_filter_threads
+ *
+ * Purpose:	Reads values previously set with H5Pset_filter_threads().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_filter_threads(hid_t plist_id, unsigned *num_threads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, num_threads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if(num_threads)
+        if(H5P_get(plist, H5D_XFER_FILTER_THREADS_NAME, num_threads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_filter_threads() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_cache_bypass
+ *
+ * Purpose:	Given a dataset transfer property list, set whether reads
+ *              which select all of a chunk, in the chunk's element order,
+ *              into one contiguous part of the buffer, and need no
+ *              datatype conversion or data transform, read the chunk from
+ *              the file straight into the application's buffer without
+ *              putting it in the dataset's chunk cache.  Filtered chunks
+ *              are unfiltered and copied into the buffer.  This suits
+ *              reads which visit each chunk once, which would otherwise
+ *              copy every chunk out of the cache and preempt chunks that
+ *              are used again.  Chunks which are in the cache already are
+ *              still read from it.
+ *
+ *		The default is FALSE, which caches these chunks as well.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_bypass(hid_t plist_id, hbool_t bypass)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", plist_id, bypass);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_CHUNK_CACHE_BYPASS_NAME, &bypass) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_bypass() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_cache_bypass
+ *
+ * Purpose:	Reads values previously set with H5Pset_chunk_cache_bypass().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_bypass(hid_t plist_id, hbool_t *bypass/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, bypass);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if(bypass)
+        if(H5P_get(plist, H5D_XFER_CHUNK_CACHE_BYPASS_NAME, bypass) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_bypass() */
+
 
 /*-------------------------------------------------------------------------
  * Function:       H5P__dxfr_io_xfer_mode_enc
@@ -74,6 +74,11 @@
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEF         0.75f
 #define H5F_ACS_PREEMPT_READ_CHUNKS_ENC         H5P__encode_double
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEC         H5P__decode_double
+/* Definition for size of raw data chunk cache shared by all datasets(bytes) */
+#define H5F_ACS_DATA_CACHE_POOL_SIZE_SIZE       sizeof(size_t)
+#define H5F_ACS_DATA_CACHE_POOL_SIZE_DEF        0
+#define H5F_ACS_DATA_CACHE_POOL_SIZE_ENC        H5P__encode_size_t
+#define H5F_ACS_DATA_CACHE_POOL_SIZE_DEC        H5P__decode_size_t
 /* Definition for threshold for alignment */
 #define H5F_ACS_ALIGN_THRHD_SIZE                sizeof(hsize_t)
 #define H5F_ACS_ALIGN_THRHD_DEF                 H5F_ALIGN_THRHD_DEF
@@ -96,6 +101,11 @@
 #define H5F_ACS_SIEVE_BUF_SIZE_DEF              (64*1024)
 #define H5F_ACS_SIEVE_BUF_SIZE_ENC              H5P__encode_size_t
 #define H5F_ACS_SIEVE_BUF_SIZE_DEC              H5P__decode_size_t
+/* Definition for size of metadata prefetch blocks */
+#define H5F_ACS_META_PREFETCH_SIZE_SIZE         sizeof(size_t)
+#define H5F_ACS_META_PREFETCH_SIZE_DEF          0
+#define H5F_ACS_META_PREFETCH_SIZE_ENC          H5P__encode_size_t
+#define H5F_ACS_META_PREFETCH_SIZE_DEC          H5P__decode_size_t
 /* Definition for minimum "small data" allocation block size (when
    aggregating "small" raw data allocations. */
 #define H5F_ACS_SDATA_BLOCK_SIZE_SIZE           sizeof(hsize_t)
@@ -225,6 +235,11 @@
 #define H5F_ACS_EVICT_ON_CLOSE_FLAG_DEF                 FALSE
 #define H5F_ACS_EVICT_ON_CLOSE_FLAG_ENC                 H5P__encode_hbool_t
 #define H5F_ACS_EVICT_ON_CLOSE_FLAG_DEC                 H5P__decode_hbool_t
+/* Definition for # of threads serializing metadata cache entries on flush */
+#define H5F_ACS_MDC_FLUSH_THREADS_SIZE          sizeof(unsigned)
+#define H5F_ACS_MDC_FLUSH_THREADS_DEF           1
+#define H5F_ACS_MDC_FLUSH_THREADS_ENC           H5P__encode_unsigned
+#define H5F_ACS_MDC_FLUSH_THREADS_DEC           H5P__decode_unsigned
 #ifdef H5_HAVE_PARALLEL
 /* Definition of collective metadata read mode flag */
 #define H5F_ACS_COLL_MD_READ_FLAG_SIZE   sizeof(H5P_coll_md_read_flag_t)
@@ -359,10 +374,12 @@ static const H5AC_cache_config_t H5F_def_mdc_initCacheCfg_g = H5F_ACS_META_CACHE
 static const size_t H5F_def_rdcc_nslots_g = H5F_ACS_DATA_CACHE_NUM_SLOTS_DEF;      /* Default raw data chunk cache # of slots */
 static const size_t H5F_def_rdcc_nbytes_g = H5F_ACS_DATA_CACHE_BYTE_SIZE_DEF;      /* Default raw data chunk cache # of bytes */
 static const double H5F_def_rdcc_w0_g = H5F_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
+static const size_t H5F_def_rdcc_pool_nbytes_g = H5F_ACS_DATA_CACHE_POOL_SIZE_DEF; /* Default raw data chunk cache # of bytes shared by all datasets */
 static const hsize_t H5F_def_threshold_g = H5F_ACS_ALIGN_THRHD_DEF;                /* Default allocation alignment threshold */
 static const hsize_t H5F_def_alignment_g = H5F_ACS_ALIGN_DEF;                      /* Default allocation alignment value */
 static const hsize_t H5F_def_meta_block_size_g = H5F_ACS_META_BLOCK_SIZE_DEF;      /* Default metadata allocation block size */
 static const size_t H5F_def_sieve_buf_size_g = H5F_ACS_SIEVE_BUF_SIZE_DEF;         /* Default raw data I/O sieve buffer size */
+static const size_t H5F_def_meta_prefetch_size_g = H5F_ACS_META_PREFETCH_SIZE_DEF;   /* Default metadata prefetch block size */
 static const hsize_t H5F_def_sdata_block_size_g = H5F_ACS_SDATA_BLOCK_SIZE_DEF;    /* Default small data allocation block size */
 static const unsigned H5F_def_gc_ref_g = H5F_ACS_GARBG_COLCT_REF_DEF;              /* Default garbage collection for references setting */
 static const H5F_close_degree_t H5F_def_close_degree_g = H5F_CLOSE_DEGREE_DEF;     /* Default file close degree */
@@ -389,6 +406,7 @@ static const hbool_t H5F_def_use_mdc_logging_g = H5F_ACS_USE_MDC_LOGGING_DEF;
 static const char *H5F_def_mdc_log_location_g = H5F_ACS_MDC_LOG_LOCATION_DEF;                 /* Default mdc log location */
 static const hbool_t H5F_def_start_mdc_log_on_access_g = H5F_ACS_START_MDC_LOG_ON_ACCESS_DEF; /* Default mdc log start on access flag */
 static const hbool_t H5F_def_evict_on_close_flag_g = H5F_ACS_EVICT_ON_CLOSE_FLAG_DEF;         /* Default setting for evict on close property */
+static const unsigned H5F_def_mdc_flush_threads_g = H5F_ACS_MDC_FLUSH_THREADS_DEF;           /* Default # of metadata cache flush threads */
 #ifdef H5_HAVE_PARALLEL
 static const H5P_coll_md_read_flag_t H5F_def_coll_md_read_flag_g = H5F_ACS_COLL_MD_READ_FLAG_DEF;  /* Default setting for the collective metedata read flag */
 static const hbool_t H5F_def_coll_md_write_flag_g = H5F_ACS_COLL_MD_WRITE_FLAG_DEF;  /* Default setting for the collective metedata write flag */
@@ -442,6 +460,12 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the size of raw data chunk cache shared by all datasets(bytes) */
+    if(H5P_register_real(pclass, H5F_ACS_DATA_CACHE_POOL_SIZE_NAME, H5F_ACS_DATA_CACHE_POOL_SIZE_SIZE, &H5F_def_rdcc_pool_nbytes_g,
+            NULL, NULL, NULL, H5F_ACS_DATA_CACHE_POOL_SIZE_ENC, H5F_ACS_DATA_CACHE_POOL_SIZE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the threshold for alignment */
     if(H5P_register_real(pclass, H5F_ACS_ALIGN_THRHD_NAME, H5F_ACS_ALIGN_THRHD_SIZE, &H5F_def_threshold_g,
             NULL, NULL, NULL, H5F_ACS_ALIGN_THRHD_ENC, H5F_ACS_ALIGN_THRHD_DEC,
@@ -466,6 +490,12 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the size of metadata prefetch blocks */
+    if(H5P_register_real(pclass, H5F_ACS_META_PREFETCH_SIZE_NAME, H5F_ACS_META_PREFETCH_SIZE_SIZE, &H5F_def_meta_prefetch_size_g,
+            NULL, NULL, NULL, H5F_ACS_META_PREFETCH_SIZE_ENC, H5F_ACS_META_PREFETCH_SIZE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the minimum "small data" allocation block size */
     if(H5P_register_real(pclass, H5F_ACS_SDATA_BLOCK_SIZE_NAME, H5F_ACS_SDATA_BLOCK_SIZE_SIZE, &H5F_def_sdata_block_size_g,
             NULL, NULL, NULL, H5F_ACS_SDATA_BLOCK_SIZE_ENC, H5F_ACS_SDATA_BLOCK_SIZE_DEC,
@@ -608,6 +638,12 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the # of metadata cache flush threads */
+    if(H5P_register_real(pclass, H5F_ACS_MDC_FLUSH_THREADS_NAME, H5F_ACS_MDC_FLUSH_THREADS_SIZE, &H5F_def_mdc_flush_threads_g,
+            NULL, NULL, NULL, H5F_ACS_MDC_FLUSH_THREADS_ENC, H5F_ACS_MDC_FLUSH_THREADS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 #ifdef H5_HAVE_PARALLEL
     /* Register the metadata collective read flag */
     if(H5P_register_real(pclass, H5_COLL_MD_READ_FLAG_NAME, H5F_ACS_COLL_MD_READ_FLAG_SIZE, &H5F_def_coll_md_read_flag_g,
@@ -1631,6 +1667,79 @@ done:
 } /* end H5Pget_cache() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_cache_pool
+ *
+ * Purpose:     Set the number of bytes of raw data chunk cache that all
+ *              the datasets open in a file share.
+ *
+ *              Each dataset's chunk cache is still limited by its own
+ *              RDCC_NBYTES (see H5Pset_cache and H5Pset_chunk_cache), but
+ *              when the chunks cached by all of the file's datasets
+ *              together would exceed NBYTES, chunks are preempted from
+ *              whichever datasets used them least recently, following
+ *              the file's RDCC_W0 policy.  A value of zero (the default)
+ *              leaves each dataset's cache limited only by its own size.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_pool(hid_t plist_id, size_t nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set size */
+    if(H5P_set(plist, H5F_ACS_DATA_CACHE_POOL_SIZE_NAME, &nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set shared data cache byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_pool() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_cache_pool
+ *
+ * Purpose:     Retrieves the number of bytes of raw data chunk cache that
+ *              all the datasets open in a file share.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_pool(hid_t plist_id, size_t *nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get size */
+    if(nbytes)
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_POOL_SIZE_NAME, nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get shared data cache byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_pool() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_mdc_image_config
  *
@@ -1743,6 +1852,7 @@ herr_t
 H5Pset_mdc_config(hid_t plist_id, H5AC_cache_config_t *config_ptr)
 {
     H5P_genplist_t *plist;      /* Property list pointer */
+    H5AC_cache_config_t config; /* Configuration to set */
     herr_t ret_value = SUCCEED;   /* return value */
 
     FUNC_ENTER_API(FAIL)
@@ -1756,13 +1866,13 @@ H5Pset_mdc_config(hid_t plist_id, H5AC_cache_config_t *config_ptr)
     if(H5AC_validate_config(config_ptr) < 0)
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid metadata cache configuration")
 
-    /* set the modified config */
-
-    /* If we ever support multiple versions of H5AC_cache_config_t, we
-     * will have to test the version and do translation here.
+    /* set the modified config, with the modified LRU policy for
+     * versions of H5AC_cache_config_t which lack the replacement policy
      */
+    config.replacement_policy = H5C_rp__lru;
+    HDmemcpy(&config, config_ptr, H5AC__CACHE_CONFIG_SIZE(config_ptr->version));
 
-    if(H5P_set(plist, H5F_ACS_META_CACHE_INIT_CONFIG_NAME, config_ptr) < 0)
+    if(H5P_set(plist, H5F_ACS_META_CACHE_INIT_CONFIG_NAME, &config) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata cache initial config")
 
 done:
@@ -1791,6 +1901,8 @@ herr_t
 H5Pget_mdc_config(hid_t plist_id, H5AC_cache_config_t *config_ptr)
 {
     H5P_genplist_t *plist;      /* Property list pointer */
+    H5AC_cache_config_t config; /* Configuration in the property list */
+    int version;                /* Version of H5AC_cache_config_t supplied */
     herr_t ret_value = SUCCEED;   /* return value */
 
     FUNC_ENTER_API(FAIL)
@@ -1804,17 +1916,18 @@ H5Pget_mdc_config(hid_t plist_id, H5AC_cache_config_t *config_ptr)
     if(config_ptr == NULL)
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL config_ptr on entry.")
 
-    if(config_ptr->version != H5AC__CURR_CACHE_CONFIG_VERSION)
+    version = config_ptr->version;
+    if((version < H5AC__MIN_CACHE_CONFIG_VERSION) ||
+            (version > H5AC__CURR_CACHE_CONFIG_VERSION))
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unknown config version.")
 
-    /* If we ever support multiple versions of H5AC_cache_config_t, we
-     * will have to get the cannonical version here, and then translate
-     * to the version of the structure supplied.
+    /* Get the current initial metadata cache resize configuration, and
+     * translate it to the version of the structure supplied
      */
-
-    /* Get the current initial metadata cache resize configuration */
-    if(H5P_get(plist, H5F_ACS_META_CACHE_INIT_CONFIG_NAME, config_ptr) < 0)
+    if(H5P_get(plist, H5F_ACS_META_CACHE_INIT_CONFIG_NAME, &config) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get metadata cache initial resize config")
+    HDmemcpy(config_ptr, &config, H5AC__CACHE_CONFIG_SIZE(version));
+    config_ptr->version = version;
 
 done:
     FUNC_LEAVE_API(ret_value)
@@ -2177,6 +2290,98 @@ done:
 } /* end H5Pget_sieve_buf_size() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_meta_prefetch
+ *
+ * Purpose:     Sets the size of the blocks of metadata read ahead of their
+ *              use in files opened read-only.
+ *
+ *              A metadata read that isn't already held in memory reads
+ *              the whole block of SIZE bytes around it (aligned to SIZE)
+ *              from the file, and the most recently used of these blocks
+ *              are kept, so the many small reads needed to open a file
+ *              and walk its groups become a few large ones.  Metadata
+ *              written close together, as the metadata aggregator does
+ *              (see H5Pset_meta_block_size), is read together.
+ *              Prefetching is off unless this is called; SIZE must be
+ *              positive, and small enough to allocate a block of.
+ *
+ *              Files opened for writing, or for SWMR reading, and files
+ *              using page buffering or the multi or split drivers aren't
+ *              prefetched from.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_meta_prefetch(hid_t plist_id, hsize_t size)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    size_t prefetch_size;       /* Size of the prefetch blocks */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ih", plist_id, size);
+
+    /* Check arguments */
+    if(0 == size)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "metadata prefetch size must be positive")
+    prefetch_size = (size_t)size;
+    if((hsize_t)prefetch_size != size)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "metadata prefetch size is too large")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set size */
+    if(H5P_set(plist, H5F_ACS_META_PREFETCH_SIZE_NAME, &prefetch_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata prefetch size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_meta_prefetch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_meta_prefetch
+ *
+ * Purpose:     Retrieves the size of the blocks of metadata read ahead of
+ *              their use in files opened read-only (zero when
+ *              prefetching is off).
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_meta_prefetch(hid_t plist_id, hsize_t *size/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, size);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get size */
+    if(size) {
+        size_t prefetch_size;       /* Size of the prefetch blocks */
+
+        if(H5P_get(plist, H5F_ACS_META_PREFETCH_SIZE_NAME, &prefetch_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata prefetch size")
+        *size = (hsize_t)prefetch_size;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_meta_prefetch() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_small_data_block_size
  *
@@ -3412,6 +3617,9 @@ H5P__facc_cache_config_cmp(const void *_config1, const void *_config2, size_t H5
     if(config1->epochs_before_eviction < config2->epochs_before_eviction) HGOTO_DONE(-1);
     if(config1->epochs_before_eviction > config2->epochs_before_eviction) HGOTO_DONE(1);
 
+    if(config1->replacement_policy < config2->replacement_policy) HGOTO_DONE(-1);
+    if(config1->replacement_policy > config2->replacement_policy) HGOTO_DONE(1);
+
     if(config1->apply_empty_reserve < config2->apply_empty_reserve) HGOTO_DONE(-1);
     if(config1->apply_empty_reserve > config2->apply_empty_reserve) HGOTO_DONE(1);
 
@@ -3551,6 +3759,11 @@ H5P__facc_cache_config_enc(const void *value, void **_pp, size_t *size)
 
         /* int */
         INT32ENCODE(*pp, (int32_t)config->metadata_write_strategy);
+
+        if(config->version >= H5AC__CACHE_CONFIG_RP_VERSION) {
+            /* enum */
+            *(*pp)++ = (uint8_t)config->replacement_policy;
+        } /* end if */
     } /* end if */
 
     /* Compute encoded size of variably-encoded values */
@@ -3569,6 +3782,8 @@ H5P__facc_cache_config_enc(const void *value, void **_pp, size_t *size)
     *size += (5 + (sizeof(unsigned) * 8) + (sizeof(double) * 8) +
             (sizeof(int32_t) * 4) + sizeof(int64_t) +
             H5AC__MAX_TRACE_FILE_NAME_LEN + 1);
+    if(config->version >= H5AC__CACHE_CONFIG_RP_VERSION)
+        *size += 1;
 
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* end H5P__facc_cache_config_enc() */
@@ -3704,6 +3919,16 @@ H5P__facc_cache_config_dec(const void **_pp, void *_value)
     /* int */
     INT32DECODE(*pp, config->metadata_write_strategy);
 
+    /* Version 1 configurations have no replacement policy, and use the
+     * modified LRU policy
+     */
+    if(config->version >= H5AC__CACHE_CONFIG_RP_VERSION) {
+        /* enum */
+        config->replacement_policy = (enum H5C_cache_rp_mode)*(*pp)++;
+    } /* end if */
+    else
+        config->replacement_policy = H5C_rp__lru;
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__facc_cache_config_dec() */
@@ -4582,6 +4807,85 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_evict_on_close() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_mdc_flush_threads
+ *
+ * Purpose:     Sets the number of threads which may serialize the file's
+ *              dirty metadata cache entries at once when the cache is
+ *              flushed.  Entries of the kinds of metadata whose images
+ *              only encode the entry (B-tree nodes, symbol table nodes,
+ *              and extensible and fixed array data blocks) which don't
+ *              wait on others in flush dependencies are encoded and
+ *              checksummed on a pool of that many threads, while the
+ *              file is still written by the calling thread, in address
+ *              order.
+ *
+ *              The default is 1, which serializes every entry on the
+ *              calling thread.  Larger values only have an effect when
+ *              the library is built thread-safe with pthreads.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_mdc_flush_threads(hid_t fapl_id, unsigned num_threads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", fapl_id, num_threads);
+
+    /* Check arguments */
+    if(num_threads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads must be positive")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5F_ACS_MDC_FLUSH_THREADS_NAME, &num_threads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata cache flush threads")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_mdc_flush_threads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_mdc_flush_threads
+ *
+ * Purpose:     Reads the value set with H5Pset_mdc_flush_threads().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_mdc_flush_threads(hid_t fapl_id, unsigned *num_threads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", fapl_id, num_threads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return value */
+    if(num_threads)
+        if(H5P_get(plist, H5F_ACS_MDC_FLUSH_THREADS_NAME, num_threads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata cache flush threads")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_mdc_flush_threads() */
+
 #ifdef H5_HAVE_PARALLEL
 
 /*-------------------------------------------------------------------------
@@ -3829,6 +3829,53 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* H5P_object_verify() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5P_object_lookup
+ PURPOSE
+    Internal routine to retrieve the property list object for an ID, if the
+        property list is a member of a certain class, without pushing errors.
+ USAGE
+    H5P_genplist_t *H5P_object_lookup(plist_id, pclass_id)
+        hid_t plist_id;         IN: Property list to query
+        hid_t pclass_id;        IN: Property class to query
+ RETURNS
+    Success: valid pointer to a property list object
+    Failure: NULL
+ DESCRIPTION
+    This routine is the same as H5P_object_verify(), except that it doesn't
+    modify the error stack, so that it can be used by the shared read path
+    of API routines (see H5_API_READ_BEGIN).  The caller is responsible for
+    reporting any error.
+
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+H5P_genplist_t *
+H5P_object_lookup(hid_t plist_id, hid_t pclass_id)
+{
+    H5P_genplist_t *plist;              /* Property list to query */
+    H5P_genclass_t *pclass;             /* Property list class */
+    const H5P_genclass_t *tclass;       /* Temporary class pointer */
+    H5P_genplist_t *ret_value = NULL;   /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(NULL != (plist = (H5P_genplist_t *)H5I_object_verify(plist_id, H5I_GENPROP_LST))
+            && NULL != (pclass = (H5P_genclass_t *)H5I_object_verify(pclass_id, H5I_GENPROP_CLS)))
+        /* Walk up the class hierarchy, as H5P_class_isa() does */
+        for(tclass = plist->pclass; tclass != NULL; tclass = tclass->parent)
+            if(0 == H5P_cmp_class(tclass, pclass)) {
+                ret_value = plist;
+                break;
+            } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5P_object_lookup() */
+
 
 /*--------------------------------------------------------------------------
  NAME
@@ -4275,6 +4322,64 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5P_peek() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5P_peek_lookup
+ PURPOSE
+    Internal routine to look at the value of a property in a property list,
+        without pushing errors.
+ USAGE
+    hbool_t H5P_peek_lookup(plist, name, value)
+        const H5P_genplist_t *plist;  IN: Property list to check
+        const char *name;       IN: Name of property to query
+        void *value;            OUT: Pointer to the buffer for the property value
+ RETURNS
+    TRUE if the value was copied, FALSE otherwise.
+ DESCRIPTION
+    This routine is the same as H5P_peek(), except that it doesn't modify
+    the error stack, so that it can be used by the shared read path of API
+    routines (see H5_API_READ_BEGIN).  When it returns FALSE, the caller
+    takes the exclusive path, which reports the error.
+
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+hbool_t
+H5P_peek_lookup(const H5P_genplist_t *plist, const char *name, void *value)
+{
+    const H5P_genprop_t *prop;          /* Property to copy */
+    hbool_t ret_value = FALSE;          /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(plist);
+    HDassert(name);
+    HDassert(value);
+
+    /* Look for the property the way H5P__do_prop() does */
+    if(NULL == H5SL_search(plist->del, name)) {
+        if(NULL == (prop = (const H5P_genprop_t *)H5SL_search(plist->props, name))) {
+            const H5P_genclass_t *tclass;       /* Temporary class pointer */
+
+            for(tclass = plist->pclass; tclass != NULL; tclass = tclass->parent)
+                if(tclass->nprops > 0 && NULL != (prop = (const H5P_genprop_t *)H5SL_search(tclass->props, name)))
+                    break;
+        } /* end if */
+
+        /* Make a (shallow) copy of the value */
+        if(prop && prop->size > 0) {
+            HDmemcpy(value, prop->value, prop->size);
+            ret_value = TRUE;
+        } /* end if */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5P_peek_lookup() */
+
 
 /*--------------------------------------------------------------------------
  NAME
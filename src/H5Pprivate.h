@@ -199,6 +199,9 @@ H5_DLL H5P_genclass_t *H5P_get_class(const H5P_genplist_t *plist);
 /* *SPECIAL* Don't make more of these! -QAK */
 H5_DLL htri_t H5P_isa_class(hid_t plist_id, hid_t pclass_id);
 H5_DLL H5P_genplist_t *H5P_object_verify(hid_t plist_id, hid_t pclass_id);
+H5_DLL H5P_genplist_t *H5P_object_lookup(hid_t plist_id, hid_t pclass_id);
+H5_DLL hbool_t H5P_peek_lookup(const H5P_genplist_t *plist, const char *name,
+    void *value);
 
 /* Private DCPL routines */
 H5_DLL herr_t H5P_fill_value_defined(H5P_genplist_t *plist,
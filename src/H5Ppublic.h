@@ -323,6 +323,8 @@ H5_DLL herr_t H5Pget_cache(hid_t plist_id,
        int *mdc_nelmts, /* out */
        size_t *rdcc_nslots/*out*/,
        size_t *rdcc_nbytes/*out*/, double *rdcc_w0);
+H5_DLL herr_t H5Pset_chunk_cache_pool(hid_t plist_id, size_t nbytes);
+H5_DLL herr_t H5Pget_chunk_cache_pool(hid_t plist_id, size_t *nbytes/*out*/);
 H5_DLL herr_t H5Pset_mdc_config(hid_t    plist_id,
        H5AC_cache_config_t * config_ptr);
 H5_DLL herr_t H5Pget_mdc_config(hid_t     plist_id,
@@ -335,6 +337,8 @@ H5_DLL herr_t H5Pset_meta_block_size(hid_t fapl_id, hsize_t size);
 H5_DLL herr_t H5Pget_meta_block_size(hid_t fapl_id, hsize_t *size/*out*/);
 H5_DLL herr_t H5Pset_sieve_buf_size(hid_t fapl_id, size_t size);
 H5_DLL herr_t H5Pget_sieve_buf_size(hid_t fapl_id, size_t *size/*out*/);
+H5_DLL herr_t H5Pset_meta_prefetch(hid_t fapl_id, hsize_t size);
+H5_DLL herr_t H5Pget_meta_prefetch(hid_t fapl_id, hsize_t *size/*out*/);
 H5_DLL herr_t H5Pset_small_data_block_size(hid_t fapl_id, hsize_t size);
 H5_DLL herr_t H5Pget_small_data_block_size(hid_t fapl_id, hsize_t *size/*out*/);
 H5_DLL herr_t H5Pset_libver_bounds(hid_t plist_id, H5F_libver_t low,
@@ -359,6 +363,8 @@ H5_DLL herr_t H5Pset_mdc_log_options(hid_t plist_id, hbool_t is_enabled, const c
 H5_DLL herr_t H5Pget_mdc_log_options(hid_t plist_id, hbool_t *is_enabled, char *location, size_t *location_size, hbool_t *start_on_access);
 H5_DLL herr_t H5Pset_evict_on_close(hid_t fapl_id, hbool_t evict_on_close);
 H5_DLL herr_t H5Pget_evict_on_close(hid_t fapl_id, hbool_t *evict_on_close);
+H5_DLL herr_t H5Pset_mdc_flush_threads(hid_t fapl_id, unsigned num_threads);
+H5_DLL herr_t H5Pget_mdc_flush_threads(hid_t fapl_id, unsigned *num_threads/*out*/);
 #ifdef H5_HAVE_PARALLEL
 H5_DLL herr_t H5Pset_all_coll_metadata_ops(hid_t plist_id, hbool_t is_collective);
 H5_DLL herr_t H5Pget_all_coll_metadata_ops(hid_t plist_id, hbool_t *is_collective);
@@ -388,6 +394,10 @@ H5_DLL herr_t H5Pset_external(hid_t plist_id, const char *name, off_t offset,
           hsize_t size);
 H5_DLL herr_t H5Pset_chunk_opts(hid_t plist_id, unsigned opts);
 H5_DLL herr_t H5Pget_chunk_opts(hid_t plist_id, unsigned *opts);
+H5_DLL herr_t H5Pset_chunk_shard(hid_t plist_id, int ndims, const hsize_t dim[/*ndims*/]);
+H5_DLL int H5Pget_chunk_shard(hid_t plist_id, int max_ndims, hsize_t dim[]/*out*/);
+H5_DLL herr_t H5Pset_chunk_implicit(hid_t plist_id);
+H5_DLL htri_t H5Pget_chunk_implicit(hid_t plist_id);
 H5_DLL int H5Pget_external_count(hid_t plist_id);
 H5_DLL herr_t H5Pget_external(hid_t plist_id, unsigned idx, size_t name_size,
           char *name/*out*/, off_t *offset/*out*/,
@@ -416,6 +426,10 @@ H5_DLL herr_t H5Pget_chunk_cache(hid_t dapl_id,
        size_t *rdcc_nslots/*out*/,
        size_t *rdcc_nbytes/*out*/,
        double *rdcc_w0/*out*/);
+H5_DLL herr_t H5Pset_chunk_read_ahead(hid_t dapl_id, unsigned nchunks);
+H5_DLL herr_t H5Pget_chunk_read_ahead(hid_t dapl_id, unsigned *nchunks/*out*/);
+H5_DLL herr_t H5Pset_chunk_cache_auto(hid_t dapl_id, size_t max_nbytes);
+H5_DLL herr_t H5Pget_chunk_cache_auto(hid_t dapl_id, size_t *max_nbytes/*out*/);
 H5_DLL herr_t H5Pset_virtual_view(hid_t plist_id, H5D_vds_view_t view);
 H5_DLL herr_t H5Pget_virtual_view(hid_t plist_id, H5D_vds_view_t *view);
 H5_DLL herr_t H5Pset_virtual_printf_gap(hid_t plist_id, hsize_t gap_size);
@@ -458,6 +472,10 @@ H5_DLL herr_t H5Pget_vlen_mem_manager(hid_t plist_id,
                                        void **free_info);
 H5_DLL herr_t H5Pset_hyper_vector_size(hid_t fapl_id, size_t size);
 H5_DLL herr_t H5Pget_hyper_vector_size(hid_t fapl_id, size_t *size/*out*/);
+H5_DLL herr_t H5Pset_filter_threads(hid_t plist_id, unsigned num_threads);
+H5_DLL herr_t H5Pget_filter_threads(hid_t plist_id, unsigned *num_threads/*out*/);
+H5_DLL herr_t H5Pset_chunk_cache_bypass(hid_t plist_id, hbool_t bypass);
+H5_DLL herr_t H5Pget_chunk_cache_bypass(hid_t plist_id, hbool_t *bypass/*out*/);
 H5_DLL herr_t H5Pset_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t op, void* operate_data);
 H5_DLL herr_t H5Pget_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t *op, void** operate_data);
 #ifdef H5_HAVE_PARALLEL
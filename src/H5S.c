@@ -757,6 +757,12 @@ H5Sget_simple_extent_npoints(hid_t space_id)
     H5S_t		   *ds;
     hssize_t		    ret_value;
 
+    /* Try the shared read path first */
+    H5_API_READ_BEGIN
+        if(NULL != (ds = (H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE)))
+            H5_API_READ_RETURN((hssize_t)H5S_GET_EXTENT_NPOINTS(ds))
+    H5_API_READ_END
+
     FUNC_ENTER_API(FAIL)
     H5TRACE1("Hs", "i", space_id);
 
@@ -862,6 +868,12 @@ H5Sget_simple_extent_ndims(hid_t space_id)
     H5S_t		   *ds;
     int		   ret_value;
 
+    /* Try the shared read path first */
+    H5_API_READ_BEGIN
+        if(NULL != (ds = (H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE)))
+            H5_API_READ_RETURN((int)H5S_GET_EXTENT_NDIMS(ds))
+    H5_API_READ_END
+
     FUNC_ENTER_API(FAIL)
     H5TRACE1("Is", "i", space_id);
 
@@ -954,6 +966,15 @@ H5Sget_simple_extent_dims(hid_t space_id, hsize_t dims[]/*out*/,
     H5S_t		   *ds;
     int		   ret_value;
 
+    /* Try the shared read path first (only for extents which can't fail) */
+    H5_API_READ_BEGIN
+        if(NULL != (ds = (H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE))
+                && (H5S_GET_EXTENT_TYPE(ds) == H5S_SIMPLE
+                    || H5S_GET_EXTENT_TYPE(ds) == H5S_SCALAR
+                    || H5S_GET_EXTENT_TYPE(ds) == H5S_NULL))
+            H5_API_READ_RETURN(H5S_extent_get_dims(&ds->extent, dims, maxdims))
+    H5_API_READ_END
+
     FUNC_ENTER_API(FAIL)
     H5TRACE3("Is", "ixx", space_id, dims, maxdims);
 
@@ -1707,6 +1707,7 @@ H5Tcopy(hid_t type_id)
         case H5I_ERROR_CLASS:
         case H5I_ERROR_MSG:
         case H5I_ERROR_STACK:
+        case H5I_EVENTSET:
         case H5I_NTYPES:
         default:
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, H5I_INVALID_HID, "not a datatype or dataset")
@@ -1868,6 +1869,12 @@ H5Tget_class(hid_t type_id)
     H5T_t       *dt;            /* Pointer to datatype */
     H5T_class_t ret_value;      /* Return value */
 
+    /* Try the shared read path first */
+    H5_API_READ_BEGIN
+        if(NULL != (dt = (H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+            H5_API_READ_RETURN(H5T_IS_VL_STRING(dt->shared) ? H5T_STRING : dt->shared->type)
+    H5_API_READ_END
+
     FUNC_ENTER_API(H5T_NO_CLASS)
     H5TRACE1("Tt", "i", type_id);
 
@@ -2123,6 +2130,12 @@ H5Tget_size(hid_t type_id)
     H5T_t     *dt;            /* Datatype to query */
     size_t    ret_value;      /* Return value */
 
+    /* Try the shared read path first */
+    H5_API_READ_BEGIN
+        if(NULL != (dt = (H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+            H5_API_READ_RETURN(H5T_GET_SIZE(dt))
+    H5_API_READ_END
+
     FUNC_ENTER_API(0)
     H5TRACE1("z", "i", type_id);
 
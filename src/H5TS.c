@@ -103,6 +103,10 @@ H5TS_pthread_first_thread_init(void)
     pthread_mutex_init(&H5_g.init_lock.atomic_lock, NULL);
     pthread_cond_init(&H5_g.init_lock.cond_var, NULL);
     H5_g.init_lock.lock_count = 0;
+    pthread_cond_init(&H5_g.init_lock.shared_cond_var, NULL);
+    H5_g.init_lock.shared_count = 0;
+    H5_g.init_lock.shared_waiting = 0;
+    H5_g.init_lock.excl_waiting = 0;
 
     /* initialize key for thread-specific error stacks */
     pthread_key_create(&H5TS_errstk_key_g, H5TS_key_destructor);
@@ -116,6 +120,35 @@ H5TS_pthread_first_thread_init(void)
     /* initialize key for thread cancellability mechanism */
     pthread_key_create(&H5TS_cancel_key_g, H5TS_key_destructor);
 }
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_mutex_wake
+ *
+ * USAGE
+ *    H5TS_mutex_wake(&mutex_var)
+ *
+ * RETURNS
+ *    0 on success and non-zero on error.
+ *
+ * DESCRIPTION
+ *    Wakes the threads that can take a recursive lock that has just been
+ *    released by its owner: one thread waiting to own it if there is
+ *    one, otherwise all of the threads waiting to hold it shared.  Must
+ *    be called with the mutex's atomic_lock held.
+ *
+ *--------------------------------------------------------------------------
+ */
+static herr_t
+H5TS_mutex_wake(H5TS_mutex_t *mutex)
+{
+    if(mutex->excl_waiting)
+        return pthread_cond_signal(&mutex->cond_var);
+    if(mutex->shared_waiting)
+        return pthread_cond_broadcast(&mutex->shared_cond_var);
+    return 0;
+} /* H5TS_mutex_wake */
 #endif /* H5_HAVE_WIN_THREADS */
 
 
@@ -155,9 +188,11 @@ H5TS_mutex_lock(H5TS_mutex_t *mutex)
         /* already owned by self - increment count */
         mutex->lock_count++;
     } else {
-        /* if owned by other thread, wait for condition signal */
-        while(mutex->lock_count)
+        /* if owned by other thread or held shared, wait for condition signal */
+        mutex->excl_waiting++;
+        while(mutex->lock_count || mutex->shared_count)
             pthread_cond_wait(&mutex->cond_var, &mutex->atomic_lock);
+        mutex->excl_waiting--;
 
         /* After we've received the signal, take ownership of the mutex */
         mutex->owner_thread = HDpthread_self();
@@ -204,20 +239,189 @@ H5TS_mutex_unlock(H5TS_mutex_t *mutex)
 
     mutex->lock_count--;
 
-    ret_value = pthread_mutex_unlock(&mutex->atomic_lock);
+    if(mutex->lock_count == 0)
+        ret_value = H5TS_mutex_wake(mutex);
 
-    if(mutex->lock_count == 0) {
-        int err;
-
-        err = pthread_cond_signal(&mutex->cond_var);
-        if(err != 0)
-            ret_value = err;
-    } /* end if */
+    if(ret_value == 0)
+        ret_value = pthread_mutex_unlock(&mutex->atomic_lock);
+    else
+        (void)pthread_mutex_unlock(&mutex->atomic_lock);
 
     return ret_value; 
 #endif /* H5_HAVE_WIN_THREADS */
 } /* H5TS_mutex_unlock */
 
+#ifndef H5_HAVE_WIN_THREADS
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_mutex_lock_shared
+ *
+ * USAGE
+ *    H5TS_mutex_lock_shared(&mutex_var)
+ *
+ * RETURNS
+ *    0 on success and non-zero if the lock wasn't acquired.
+ *
+ * DESCRIPTION
+ *    Acquires a recursive lock in shared mode: any number of threads may
+ *    hold it shared at once, but not while a thread owns it.  Threads
+ *    waiting to own the lock are given preference, so a steady stream of
+ *    shared holders can't starve them.
+ *
+ *    If the calling thread already owns the lock, it isn't acquired
+ *    again and non-zero is returned; the caller should take the lock
+ *    with H5TS_mutex_lock() instead.  A thread holding the lock shared
+ *    mustn't try to own it.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_mutex_lock_shared(H5TS_mutex_t *mutex)
+{
+    herr_t ret_value = pthread_mutex_lock(&mutex->atomic_lock);
+
+    if(ret_value)
+        return ret_value;
+
+    if(mutex->lock_count && pthread_equal(HDpthread_self(), mutex->owner_thread)) {
+        (void)pthread_mutex_unlock(&mutex->atomic_lock);
+        return -1;
+    } /* end if */
+
+    /* Wait for the owner, and any thread waiting to become one, to finish */
+    mutex->shared_waiting++;
+    while(mutex->lock_count || mutex->excl_waiting)
+        pthread_cond_wait(&mutex->shared_cond_var, &mutex->atomic_lock);
+    mutex->shared_waiting--;
+
+    mutex->shared_count++;
+
+    return pthread_mutex_unlock(&mutex->atomic_lock);
+} /* H5TS_mutex_lock_shared */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_mutex_unlock_shared
+ *
+ * USAGE
+ *    H5TS_mutex_unlock_shared(&mutex_var)
+ *
+ * RETURNS
+ *    0 on success and non-zero on error.
+ *
+ * DESCRIPTION
+ *    Releases a lock acquired with H5TS_mutex_lock_shared().
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_mutex_unlock_shared(H5TS_mutex_t *mutex)
+{
+    herr_t ret_value = pthread_mutex_lock(&mutex->atomic_lock);
+
+    if(ret_value)
+        return ret_value;
+
+    HDassert(mutex->shared_count > 0);
+    mutex->shared_count--;
+
+    /* The last shared holder hands the lock to a waiting owner */
+    if(mutex->shared_count == 0 && mutex->excl_waiting)
+        ret_value = pthread_cond_signal(&mutex->cond_var);
+
+    if(ret_value == 0)
+        ret_value = pthread_mutex_unlock(&mutex->atomic_lock);
+    else
+        (void)pthread_mutex_unlock(&mutex->atomic_lock);
+
+    return ret_value;
+} /* H5TS_mutex_unlock_shared */
+#endif /* H5_HAVE_WIN_THREADS */
+
+#ifndef H5_HAVE_WIN_THREADS
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_mutex_release
+ *
+ * USAGE
+ *    H5TS_mutex_release(&mutex_var, &lock_count)
+ *
+ * RETURNS
+ *    0 on success and non-zero on error.
+ *
+ * DESCRIPTION
+ *    Releases all of the calling thread's acquisitions of a recursive
+ *    lock at once, so that another thread can take it while this one
+ *    blocks.  The number of acquisitions released is returned in
+ *    LOCK_COUNT, to be passed to H5TS_mutex_reacquire() afterwards.
+ *    The lock must be held by the calling thread.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_mutex_release(H5TS_mutex_t *mutex, unsigned int *lock_count)
+{
+    herr_t ret_value = pthread_mutex_lock(&mutex->atomic_lock);
+
+    if(ret_value)
+        return ret_value;
+
+    HDassert(mutex->lock_count && pthread_equal(HDpthread_self(), mutex->owner_thread));
+
+    *lock_count = mutex->lock_count;
+    mutex->lock_count = 0;
+
+    ret_value = H5TS_mutex_wake(mutex);
+
+    if(ret_value == 0)
+        ret_value = pthread_mutex_unlock(&mutex->atomic_lock);
+    else
+        (void)pthread_mutex_unlock(&mutex->atomic_lock);
+
+    return ret_value;
+} /* H5TS_mutex_release */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_mutex_reacquire
+ *
+ * USAGE
+ *    H5TS_mutex_reacquire(&mutex_var, lock_count)
+ *
+ * RETURNS
+ *    0 on success and non-zero on error.
+ *
+ * DESCRIPTION
+ *    Takes a recursive lock that was released with H5TS_mutex_release()
+ *    back, restoring the calling thread's LOCK_COUNT acquisitions of it.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_mutex_reacquire(H5TS_mutex_t *mutex, unsigned int lock_count)
+{
+    herr_t ret_value = pthread_mutex_lock(&mutex->atomic_lock);
+
+    if(ret_value)
+        return ret_value;
+
+    /* Wait for the lock to be free, then take ownership of it */
+    mutex->excl_waiting++;
+    while(mutex->lock_count || mutex->shared_count)
+        pthread_cond_wait(&mutex->cond_var, &mutex->atomic_lock);
+    mutex->excl_waiting--;
+
+    mutex->owner_thread = HDpthread_self();
+    mutex->lock_count = lock_count;
+
+    return pthread_mutex_unlock(&mutex->atomic_lock);
+} /* H5TS_mutex_reacquire */
+#endif /* H5_HAVE_WIN_THREADS */
+
 
 /*--------------------------------------------------------------------------
  * NAME
@@ -80,6 +80,10 @@ typedef struct H5TS_mutex_struct {
     pthread_mutex_t atomic_lock;	/* lock for atomicity of new mechanism */
     pthread_cond_t cond_var;		/* condition variable */
     unsigned int lock_count;
+    pthread_cond_t shared_cond_var;	/* condition variable for shared holders */
+    unsigned int shared_count;		/* # of threads holding the lock shared */
+    unsigned int shared_waiting;	/* # of threads waiting to hold it shared */
+    unsigned int excl_waiting;		/* # of threads waiting to own it */
 } H5TS_mutex_t;
 typedef pthread_t      H5TS_thread_t;
 typedef pthread_attr_t H5TS_attr_t;
@@ -119,6 +123,12 @@ extern      "C"
 H5_DLL void   H5TS_pthread_first_thread_init(void);
 H5_DLL herr_t H5TS_mutex_lock(H5TS_mutex_t *mutex);
 H5_DLL herr_t H5TS_mutex_unlock(H5TS_mutex_t *mutex);
+#ifndef H5_HAVE_WIN_THREADS
+H5_DLL herr_t H5TS_mutex_lock_shared(H5TS_mutex_t *mutex);
+H5_DLL herr_t H5TS_mutex_unlock_shared(H5TS_mutex_t *mutex);
+H5_DLL herr_t H5TS_mutex_release(H5TS_mutex_t *mutex, unsigned int *lock_count);
+H5_DLL herr_t H5TS_mutex_reacquire(H5TS_mutex_t *mutex, unsigned int lock_count);
+#endif /* H5_HAVE_WIN_THREADS */
 H5_DLL herr_t H5TS_cancel_count_inc(void);
 H5_DLL herr_t H5TS_cancel_count_dec(void);
 H5_DLL H5TS_thread_t H5TS_create_thread(void *(*func)(void *), H5TS_attr_t * attr, void *udata);
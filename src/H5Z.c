@@ -56,6 +56,34 @@ typedef enum {
     H5Z_PRELUDE_SET_LOCAL       /* Call "set local" callback */
 } H5Z_prelude_type_t;
 
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+/* Work shared by the threads running H5Z_pipeline_threads() */
+typedef struct H5Z_pipeline_work_t {
+    const H5O_pline_t *pline;   /* Filter pipeline to run */
+    unsigned    flags;          /* Filter invocation flags */
+    H5Z_EDC_t   edc_read;       /* Error detection setting */
+    H5Z_cb_t    cb_struct;      /* Filter failure callback */
+    size_t      njobs;          /* # of buffers to filter */
+    H5Z_pipeline_job_t *jobs;   /* Buffers to filter */
+    size_t      next;           /* Next buffer to filter */
+    unsigned    nhelpers;       /* # of helper threads which may still join */
+    unsigned    nactive;        /* # of helper threads working on it */
+} H5Z_pipeline_work_t;
+
+/* Helper threads for H5Z_pipeline_threads(), kept until the library is
+ * closed.  Only one thread at a time hands them work, since the caller
+ * holds the API lock. */
+typedef struct H5Z_pipeline_pool_t {
+    pthread_mutex_t lock;       /* Protects the fields below and the work */
+    pthread_cond_t work_cond;   /* Signals the helpers about work or shutdown */
+    pthread_cond_t done_cond;   /* Signals the caller that the helpers are done */
+    pthread_t   *threads;       /* Helper threads */
+    unsigned    nthreads;       /* # of helper threads */
+    H5Z_pipeline_work_t *work;  /* Work for the helpers, or NULL */
+    hbool_t     shutdown;       /* Whether the helpers should exit */
+} H5Z_pipeline_pool_t;
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
 /* Package initialization variable */
 hbool_t H5_PKG_INIT_VAR = FALSE;
 
@@ -66,12 +94,22 @@ static H5Z_class2_t         *H5Z_table_g = NULL;
 #ifdef H5Z_DEBUG
 static H5Z_stats_t          *H5Z_stat_table_g = NULL;
 #endif /* H5Z_DEBUG */
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+static H5Z_pipeline_pool_t   H5Z_pipeline_pool_g = {PTHREAD_MUTEX_INITIALIZER,
+        PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, 0, NULL, FALSE};
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
 
 /* Local functions */
 static int H5Z_find_idx(H5Z_filter_t id);
 static int H5Z__check_unregister_dset_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__check_unregister_group_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__flush_file_cb(void *obj_ptr, hid_t obj_id, void *key);
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+static void H5Z__pipeline_run(H5Z_pipeline_work_t *work, hbool_t helper);
+static void *H5Z__pipeline_helper(void *_pool);
+static void H5Z__pipeline_pool_grow(unsigned nthreads);
+static void H5Z__pipeline_pool_stop(void);
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
 
 
 /*-------------------------------------------------------------------------
@@ -183,6 +221,11 @@ H5Z_term_package(void)
             } /* end for */
         } /* end if */
 #endif /* H5Z_DEBUG */
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+        /* Stop the filter pipeline's helper threads */
+        H5Z__pipeline_pool_stop();
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
         /* Free the table of filters */
         if (H5Z_table_g) {
             H5Z_table_g = (H5Z_class2_t *)H5MM_xfree(H5Z_table_g);
@@ -1383,7 +1426,348 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function: H5Z_pipeline_into
+ *
+ * Purpose:  Process data read from the file through the filter pipeline,
+ *           as H5Z_pipeline does with H5Z_FLAG_REVERSE, leaving the
+ *           result in DST, which is DST_SIZE bytes, when that can be
+ *           done without copying it.  That's the case when the last
+ *           filter run, the first in the pipeline, is the library's
+ *           deflate filter: it uncompresses straight into DST.
+ *           Otherwise the result is left in BUF, as with H5Z_pipeline.
+ *
+ * Return:   TRUE if the result is in DST, FALSE if it is in BUF,
+ *           Negative on failure
+ *-------------------------------------------------------------------------
+ */
+htri_t
+H5Z_pipeline_into(const H5O_pline_t *pline, unsigned *filter_mask/*in,out*/,
+        H5Z_EDC_t edc_read, H5Z_cb_t cb_struct, size_t *nbytes/*in,out*/,
+        size_t *buf_size/*in,out*/, void **buf/*in,out*/, void *dst,
+        size_t dst_size)
+{
+#ifdef H5_HAVE_FILTER_DEFLATE
+    int         fclass_idx;             /* Index of filter class in global table */
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    htri_t      ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(pline);
+    HDassert(filter_mask);
+    HDassert(nbytes && *nbytes > 0);
+    HDassert(buf_size && *buf_size > 0);
+    HDassert(buf && *buf);
+    HDassert(dst && dst_size > 0);
+
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(pline->nused > 0 && !(*filter_mask & 1u)
+            && H5Z_FILTER_DEFLATE == pline->filter[0].id
+            && (fclass_idx = H5Z_find_idx(H5Z_FILTER_DEFLATE)) >= 0
+            && H5Z_table_g[fclass_idx].filter == H5Z_DEFLATE->filter) {
+        unsigned    failed = 0;         /* Filters that failed */
+        size_t      new_nbytes;         /* Size of the uncompressed data */
+
+        /* Run the rest of the pipeline, as a pipeline of its own */
+        if(pline->nused > 1) {
+            H5O_pline_t rest = *pline;  /* Filters after the first */
+
+            rest.nused--;
+            rest.filter = pline->filter + 1;
+            failed = *filter_mask >> 1;
+            if(H5Z_pipeline(&rest, H5Z_FLAG_REVERSE, &failed, edc_read, cb_struct, nbytes, buf_size, buf) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_READERROR, FAIL, "filter pipeline failed")
+            failed <<= 1;
+        } /* end if */
+
+        /* Uncompress into the destination */
+        if(0 == (new_nbytes = H5Z__inflate_into(pline->filter[0].cd_nelmts,
+                pline->filter[0].cd_values, *buf, *nbytes, dst, dst_size))) {
+            if((cb_struct.func && (H5Z_CB_FAIL == cb_struct.func(pline->filter[0].id, *buf, *buf_size, cb_struct.op_data))) || !cb_struct.func)
+                HGOTO_ERROR(H5E_PLINE, H5E_READERROR, FAIL, "filter returned failure during read")
+
+            /* Leave the data in BUF, as H5Z_pipeline would */
+            *nbytes = *buf_size;
+            *filter_mask = failed | 1u;
+            H5E_clear_stack(NULL);
+            HGOTO_DONE(FALSE)
+        } /* end if */
+
+        *nbytes = new_nbytes;
+        *filter_mask = failed;
+        HGOTO_DONE(TRUE)
+    } /* end if */
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+    if(H5Z_pipeline(pline, H5Z_FLAG_REVERSE, filter_mask, edc_read, cb_struct, nbytes, buf_size, buf) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_READERROR, FAIL, "filter pipeline failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_into() */
+
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+
 
+/*-------------------------------------------------------------------------
+ * Function: H5Z__pipeline_run
+ *
+ * Purpose:  Takes buffers from the work shared by the threads of
+ *           H5Z_pipeline_threads() and passes them through the pipeline
+ *           until none are left.  A helper thread hands the errors of a
+ *           failed buffer back in the buffer's job, for the calling
+ *           thread to report.
+ *
+ * Return:   void
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__pipeline_run(H5Z_pipeline_work_t *work, hbool_t helper)
+{
+    H5Z_pipeline_job_t *job;    /* Buffer to filter */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for (;;) {
+        /* Take the next buffer */
+        pthread_mutex_lock(&H5Z_pipeline_pool_g.lock);
+        job = work->next < work->njobs ? &work->jobs[work->next++] : NULL;
+        pthread_mutex_unlock(&H5Z_pipeline_pool_g.lock);
+        if (NULL == job)
+            break;
+
+        job->status = H5Z_pipeline(work->pline, work->flags, &job->filter_mask,
+                work->edc_read, work->cb_struct, &job->nbytes, &job->buf_size,
+                &job->buf);
+        if (job->status < 0 && helper)
+            job->errors = H5E_take_helper_errors();
+    }
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__pipeline_run() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5Z__pipeline_helper
+ *
+ * Purpose:  Entry point of the helper threads of H5Z_pipeline_threads().
+ *           Waits for work and helps with it, until the pool of helper
+ *           threads is stopped.  A helper never touches the API context
+ *           or the ID tables, which belong to the thread holding the API
+ *           lock.
+ *
+ * Return:   NULL
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5Z__pipeline_helper(void *_pool)
+{
+    H5Z_pipeline_pool_t *pool = (H5Z_pipeline_pool_t *)_pool;
+
+    /* Keep errors for the calling thread to report */
+    H5E_init_helper_stack();
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        H5Z_pipeline_work_t *work;  /* Work to help with */
+
+        while (!pool->shutdown && (NULL == pool->work || 0 == pool->work->nhelpers))
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+        if (pool->shutdown)
+            break;
+
+        /* Join the work */
+        work = pool->work;
+        work->nhelpers--;
+        work->nactive++;
+        pthread_mutex_unlock(&pool->lock);
+
+        H5Z__pipeline_run(work, TRUE);
+
+        pthread_mutex_lock(&pool->lock);
+        if (0 == --work->nactive)
+            pthread_cond_signal(&pool->done_cond);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+} /* end H5Z__pipeline_helper() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5Z__pipeline_pool_grow
+ *
+ * Purpose:  Starts helper threads for H5Z_pipeline_threads() until there
+ *           are NTHREADS of them.  When threads can't be started, the
+ *           ones already started are used.
+ *
+ * Return:   void
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__pipeline_pool_grow(unsigned nthreads)
+{
+    H5Z_pipeline_pool_t *pool = &H5Z_pipeline_pool_g;
+    pthread_t  *threads;        /* Reallocated array of threads */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if (nthreads > pool->nthreads
+            && NULL != (threads = (pthread_t *)H5MM_realloc(pool->threads, sizeof(pthread_t) * nthreads))) {
+        pool->threads = threads;
+        while (pool->nthreads < nthreads
+                && 0 == pthread_create(&pool->threads[pool->nthreads], NULL, H5Z__pipeline_helper, pool))
+            pool->nthreads++;
+    }
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__pipeline_pool_grow() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5Z__pipeline_pool_stop
+ *
+ * Purpose:  Stops the helper threads of H5Z_pipeline_threads().  They're
+ *           started again the next time they're needed.
+ *
+ * Return:   void
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__pipeline_pool_stop(void)
+{
+    H5Z_pipeline_pool_t *pool = &H5Z_pipeline_pool_g;
+    unsigned    u;              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if (pool->nthreads > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pool->shutdown = TRUE;
+        pthread_cond_broadcast(&pool->work_cond);
+        pthread_mutex_unlock(&pool->lock);
+        for (u = 0; u < pool->nthreads; u++)
+            pthread_join(pool->threads[u], NULL);
+        pool->nthreads = 0;
+        pool->shutdown = FALSE;
+    }
+    pool->threads = (pthread_t *)H5MM_xfree(pool->threads);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__pipeline_pool_stop() */
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5Z_pipeline_threads
+ *
+ * Purpose:  Passes each of NJOBS independent buffers through the filter
+ *           pipeline, as H5Z_pipeline() does, using up to NTHREADS
+ *           threads (including the calling thread) at once.  The
+ *           filters must all be registered already, since registering
+ *           a filter from a helper thread isn't safe, and they (and the
+ *           callback in CB_STRUCT) must be safe to call from several
+ *           threads.  The result for each buffer is returned in its
+ *           STATUS field and the buffers which failed must still be
+ *           freed by the caller.
+ *
+ *           The helper threads are kept for later calls.  Errors from
+ *           buffers which failed on a helper thread are pushed on the
+ *           calling thread's error stack, and when the library can't
+ *           start threads the buffers are all filtered by the calling
+ *           thread.
+ *
+ * Return:   Non-negative if all buffers were filtered
+ *           Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z_pipeline_threads(const H5O_pline_t *pline, unsigned flags,
+        H5Z_EDC_t edc_read, H5Z_cb_t cb_struct, unsigned nthreads,
+        size_t njobs, H5Z_pipeline_job_t *jobs)
+{
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+    H5Z_pipeline_pool_t *pool = &H5Z_pipeline_pool_g;
+    H5Z_pipeline_work_t work;   /* Work shared by the threads */
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+    hbool_t     failed = FALSE; /* Whether any buffer failed */
+    size_t      u;              /* Local index variable */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(pline);
+    HDassert(jobs || 0 == njobs);
+    HDassert(nthreads > 0);
+
+    for (u = 0; u < njobs; u++)
+        jobs[u].errors = NULL;
+
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+    if (nthreads > 1 && njobs > 1) {
+        /* Don't use more threads than there are buffers */
+        if ((size_t)nthreads > njobs)
+            nthreads = (unsigned)njobs;
+        H5Z__pipeline_pool_grow(nthreads - 1);
+
+        work.pline = pline;
+        work.flags = flags;
+        work.edc_read = edc_read;
+        work.cb_struct = cb_struct;
+        work.njobs = njobs;
+        work.jobs = jobs;
+        work.next = 0;
+        work.nhelpers = MIN(nthreads - 1, pool->nthreads);
+        work.nactive = 0;
+
+        /* Hand the work to the helpers, filter buffers on this thread
+         * too, then wait for the helpers which joined */
+        pthread_mutex_lock(&pool->lock);
+        pool->work = &work;
+        pthread_cond_broadcast(&pool->work_cond);
+        pthread_mutex_unlock(&pool->lock);
+
+        H5Z__pipeline_run(&work, FALSE);
+
+        pthread_mutex_lock(&pool->lock);
+        pool->work = NULL;
+        while (work.nactive > 0)
+            pthread_cond_wait(&pool->done_cond, &pool->lock);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    else
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+        for (u = 0; u < njobs; u++)
+            jobs[u].status = H5Z_pipeline(pline, flags, &jobs[u].filter_mask,
+                    edc_read, cb_struct, &jobs[u].nbytes, &jobs[u].buf_size,
+                    &jobs[u].buf);
+
+    /* Check for buffers which failed, reporting the errors of the ones
+     * which failed on helper threads */
+    for (u = 0; u < njobs; u++)
+        if (jobs[u].status < 0) {
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+            if (jobs[u].errors) {
+                (void)H5E_push_helper_errors(jobs[u].errors);
+                jobs[u].errors = NULL;
+            }
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+            failed = TRUE;
+        }
+    if (failed)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_threads() */
+
+
 /*-------------------------------------------------------------------------
  * Function: H5Z_filter_info
  *
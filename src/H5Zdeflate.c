@@ -202,5 +202,52 @@ done:
         H5MM_xfree(outbuf);
     FUNC_LEAVE_NOAPI(ret_value)
 }
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__inflate_into
+ *
+ * Purpose:	Uncompress NBYTES of data at SRC, compressed by the
+ *		'deflate' filter, straight into DST, which is DST_SIZE
+ *		bytes, instead of into a buffer of the filter's own.
+ *
+ * Return:	Success: Number of bytes uncompressed into DST
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5Z__inflate_into(size_t cd_nelmts, const unsigned cd_values[],
+    const void *src, size_t nbytes, void *dst, size_t dst_size)
+{
+    uLongf      z_dst_nbytes = (uLongf)dst_size;        /* Size of the uncompressed data */
+    int		status;                 /* Status from zlib operation */
+    size_t	ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(src);
+    HDassert(dst);
+    HDassert(dst_size > 0);
+
+    /* Check arguments */
+    if(cd_nelmts != 1 || cd_values[0] > 9)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid deflate aggression level")
+
+    /* Uncompress the whole stream at once */
+    status = uncompress((Bytef *)dst, &z_dst_nbytes, (const Bytef *)src, (uLong)nbytes);
+    if(Z_BUF_ERROR == status)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "uncompressed data doesn't fit in buffer")
+    else if(Z_MEM_ERROR == status)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflate memory error")
+    else if(Z_OK != status)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflate() failed")
+
+    ret_value = (size_t)z_dst_nbytes;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__inflate_into() */
 #endif /* H5_HAVE_FILTER_DEFLATE */
 
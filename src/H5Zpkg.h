@@ -44,6 +44,8 @@ H5_DLLVAR H5Z_class2_t H5Z_SCALEOFFSET[1];
 /* Deflate filter */
 #ifdef H5_HAVE_FILTER_DEFLATE
 H5_DLLVAR const H5Z_class2_t H5Z_DEFLATE[1];
+H5_DLL size_t H5Z__inflate_into(size_t cd_nelmts, const unsigned cd_values[],
+    const void *src, size_t nbytes, void *dst, size_t dst_size);
 #endif /* H5_HAVE_FILTER_DEFLATE */
 
 /* szip filter */
@@ -47,6 +47,12 @@ typedef struct H5Z_filter_info_t H5Z_filter_info_t;
 /* (avoids dynamic memory allocation in most cases) */
 #define H5Z_COMMON_NAME_LEN    12
 
+/* Whether H5Z_pipeline_threads() can run the pipeline on several threads */
+/* (the filter statistics kept for debugging aren't protected from threads) */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5_HAVE_WIN_THREADS) && !defined(H5Z_DEBUG)
+#define H5Z_HAVE_PIPELINE_THREADS
+#endif
+
 /****************************/
 /* Library Private Typedefs */
 /****************************/
@@ -62,6 +68,16 @@ struct H5Z_filter_info_t {
     unsigned		*cd_values;	/*client data values		     */
 };
 
+/* A buffer to pass through the filter pipeline with H5Z_pipeline_threads() */
+typedef struct H5Z_pipeline_job_t {
+    unsigned    filter_mask;    /* Filters to skip on input, failed filters on output */
+    size_t      nbytes;         /* # of bytes of data in the buffer */
+    size_t      buf_size;       /* Allocated size of the buffer */
+    void        *buf;           /* The buffer, which may be replaced */
+    herr_t      status;         /* Result of filtering the buffer */
+    struct H5E_t *errors;       /* Errors of a buffer which failed on a helper thread */
+} H5Z_pipeline_job_t;
+
 /*****************************/
 /* Library-private Variables */
 /*****************************/
@@ -84,6 +100,14 @@ H5_DLL herr_t H5Z_pipeline(const struct H5O_pline_t *pline,
  			    H5Z_EDC_t edc_read, H5Z_cb_t cb_struct,
 			    size_t *nbytes/*in,out*/, size_t *buf_size/*in,out*/,
                             void **buf/*in,out*/);
+H5_DLL htri_t H5Z_pipeline_into(const struct H5O_pline_t *pline,
+                            unsigned *filter_mask/*in,out*/,
+                            H5Z_EDC_t edc_read, H5Z_cb_t cb_struct,
+                            size_t *nbytes/*in,out*/, size_t *buf_size/*in,out*/,
+                            void **buf/*in,out*/, void *dst, size_t dst_size);
+H5_DLL herr_t H5Z_pipeline_threads(const struct H5O_pline_t *pline,
+                            unsigned flags, H5Z_EDC_t edc_read, H5Z_cb_t cb_struct,
+                            unsigned nthreads, size_t njobs, H5Z_pipeline_job_t *jobs);
 H5_DLL H5Z_class2_t *H5Z_find(H5Z_filter_t id);
 H5_DLL herr_t H5Z_can_apply(hid_t dcpl_id, hid_t type_id);
 H5_DLL herr_t H5Z_set_local(hid_t dcpl_id, hid_t type_id);
@@ -1361,7 +1361,7 @@ bit.\n";
  *-------------------------------------------------------------------------
  */
 static void
-detect_C89_integers(void) HDF_NO_UBSAN
+detect_C89_integers(void)
 {
     DETECT_BYTE(signed char,      SCHAR,        d_g[nd_g]); nd_g++;
     DETECT_BYTE(unsigned char,      UCHAR,        d_g[nd_g]); nd_g++;
@@ -1389,7 +1389,7 @@ detect_C89_integers(void) HDF_NO_UBSAN
  *-------------------------------------------------------------------------
  */
 static void
-detect_C89_floats(void) HDF_NO_UBSAN
+detect_C89_floats(void)
 {
     DETECT_F(float,     FLOAT,      d_g[nd_g]); nd_g++;
     DETECT_F(double,    DOUBLE,     d_g[nd_g]); nd_g++;
@@ -1411,7 +1411,7 @@ detect_C89_floats(void) HDF_NO_UBSAN
  *-------------------------------------------------------------------------
  */
 static void
-detect_C99_integers8(void) HDF_NO_UBSAN
+detect_C99_integers8(void)
 {
 #if H5_SIZEOF_INT8_T>0
   #if H5_SIZEOF_INT8_T==1
@@ -1473,7 +1473,7 @@ detect_C99_integers8(void) HDF_NO_UBSAN
  *-------------------------------------------------------------------------
  */
 static void
-detect_C99_integers16(void) HDF_NO_UBSAN
+detect_C99_integers16(void)
 {
 #if H5_SIZEOF_INT16_T>0
     DETECT_I(int16_t,           INT16,        d_g[nd_g]); nd_g++;
@@ -1511,7 +1511,7 @@ detect_C99_integers16(void) HDF_NO_UBSAN
  *-------------------------------------------------------------------------
  */
 static void
-detect_C99_integers32(void) HDF_NO_UBSAN
+detect_C99_integers32(void)
 {
 #if H5_SIZEOF_INT32_T>0
     DETECT_I(int32_t,           INT32,        d_g[nd_g]); nd_g++;
@@ -1549,7 +1549,7 @@ detect_C99_integers32(void) HDF_NO_UBSAN
  *-------------------------------------------------------------------------
  */
 static void
-detect_C99_integers64(void) HDF_NO_UBSAN
+detect_C99_integers64(void)
 {
 #if H5_SIZEOF_INT64_T>0
     DETECT_I(int64_t,           INT64,        d_g[nd_g]); nd_g++;
@@ -1600,7 +1600,7 @@ detect_C99_integers64(void) HDF_NO_UBSAN
  *-------------------------------------------------------------------------
  */
 static void
-detect_C99_integers(void) HDF_NO_UBSAN
+detect_C99_integers(void)
 {
     /* break it down to more subroutines so that each module subroutine */
     /* is smaller and takes less time to compile with optimization on.  */
@@ -1626,7 +1626,7 @@ detect_C99_integers(void) HDF_NO_UBSAN
  *-------------------------------------------------------------------------
  */
 static void
-detect_C99_floats(void) HDF_NO_UBSAN
+detect_C99_floats(void)
 {
 #if H5_SIZEOF_DOUBLE == H5_SIZEOF_LONG_DOUBLE
     /*
@@ -1657,7 +1657,7 @@ detect_C99_floats(void) HDF_NO_UBSAN
  *-------------------------------------------------------------------------
  */
 static void
-detect_alignments(void) HDF_NO_UBSAN
+detect_alignments(void)
 {
     /* Detect structure alignment for pointers, hvl_t, hobj_ref_t, hdset_reg_ref_t */
     DETECT_M(void *,              POINTER,      m_g[na_g]); na_g++;
@@ -1745,7 +1745,7 @@ static int verify_signal_handlers(int signum, void (*handler)(int))
  *-------------------------------------------------------------------------
  */
 int
-main(void) HDF_NO_UBSAN
+main(void)
 {
 
 #if defined(H5_HAVE_SETSYSINFO) && defined(SSI_NVPAIRS)
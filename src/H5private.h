@@ -122,6 +122,21 @@
 #   include <sys/file.h>
 #endif
 
+/*
+ * Memory-mapped file I/O is used by the mmap driver.
+ */
+#ifdef H5_HAVE_SYS_MMAN_H
+#   include <sys/mman.h>
+#endif
+
+/*
+ * Scatter/gather I/O (preadv() and pwritev()) is used by the sec2 driver's
+ * vector I/O callbacks.
+ */
+#ifdef H5_HAVE_SYS_UIO_H
+#   include <sys/uio.h>
+#endif
+
 /*
  * Resource usage is not Posix.1 but HDF5 uses it anyway for some performance
  * and debugging code if available.
@@ -1118,9 +1133,15 @@ typedef off_t               h5_stat_size_t;
 #ifndef HDmktime
     #define HDmktime(T)    mktime(T)
 #endif /* HDmktime */
+#ifndef HDmmap
+    #define HDmmap(A,L,P,F,D,O)    mmap(A,L,P,F,D,O)
+#endif /* HDmmap */
 #ifndef HDmodf
     #define HDmodf(X,Y)    modf(X,Y)
 #endif /* HDmodf */
+#ifndef HDmunmap
+    #define HDmunmap(A,L)    munmap(A,L)
+#endif /* HDmunmap */
 #ifndef HDnanosleep
     #define HDnanosleep(N, O)    nanosleep(N, O)
 #endif /* HDnanosleep */
@@ -1148,6 +1169,12 @@ typedef off_t               h5_stat_size_t;
 #ifndef HDpowf
     #define HDpowf(X,Y)   powf(X,Y)
 #endif /* HDpowf */
+#ifndef HDpread
+    #define HDpread(F,B,S,O)    pread(F,B,S,O)
+#endif /* HDpread */
+#ifndef HDpreadv
+    #define HDpreadv(F,V,C,O)    preadv(F,V,C,O)
+#endif /* HDpreadv */
 #ifndef HDprintf
     #define HDprintf(...)   HDfprintf(stdout, __VA_ARGS__)
 #endif /* HDprintf */
@@ -1160,6 +1187,12 @@ typedef off_t               h5_stat_size_t;
 #ifndef HDputs
     #define HDputs(S)    puts(S)
 #endif /* HDputs */
+#ifndef HDpwrite
+    #define HDpwrite(F,B,S,O)    pwrite(F,B,S,O)
+#endif /* HDpwrite */
+#ifndef HDpwritev
+    #define HDpwritev(F,V,C,O)    pwritev(F,V,C,O)
+#endif /* HDpwritev */
 #ifndef HDqsort
     #define HDqsort(M,N,Z,F)  qsort(M,N,Z,F)
 #endif /* HDqsort*/
@@ -1919,6 +1952,46 @@ typedef struct H5_api_struct {
 #define H5_API_SET_CANCEL                                                     \
     H5TS_cancel_count_dec();
 
+/*
+ * Macros for the shared read path of API routines.  Routines which only
+ * look up IDs and read fields of objects that are never modified except
+ * under the (exclusive) API lock may bracket that code with
+ * H5_API_READ_BEGIN and H5_API_READ_END, before FUNC_ENTER_API.  The code
+ * between them runs with the API lock held shared, so any number of
+ * threads may run it at once.  It must not push errors, use free lists,
+ * allocate IDs or call other API routines; when it can't produce a
+ * result that way, it falls through to the normal, exclusive path, which
+ * reports any error.  A result is returned with H5_API_READ_RETURN.
+ *
+ * The shared path is only taken when the library is initialized and the
+ * thread's error stack is already empty, since it doesn't clear the stack
+ * the way FUNC_ENTER_API does, and never while API calls are traced.
+ */
+#ifndef H5_HAVE_WIN_THREADS
+#ifdef H5_DEBUG_API
+#define H5_API_READ_OK  (NULL == H5_debug_g.trace)
+#else /* H5_DEBUG_API */
+#define H5_API_READ_OK  TRUE
+#endif /* H5_DEBUG_API */
+
+#define H5_API_READ_BEGIN                                                     \
+    H5_FIRST_THREAD_INIT                                                      \
+    H5_API_UNSET_CANCEL                                                       \
+    if(0 == H5TS_mutex_lock_shared(&H5_g.init_lock)) {                        \
+        if(H5_INIT_GLOBAL && !H5_TERM_GLOBAL && H5_API_READ_OK                \
+                && H5E_stack_empty()) {
+#define H5_API_READ_RETURN(V) {                                               \
+            H5TS_mutex_unlock_shared(&H5_g.init_lock);                        \
+            H5_API_SET_CANCEL                                                 \
+            return(V);                                                        \
+        }
+#define H5_API_READ_END                                                       \
+        }                                                                     \
+        H5TS_mutex_unlock_shared(&H5_g.init_lock);                            \
+    }                                                                         \
+    H5_API_SET_CANCEL
+#endif /* H5_HAVE_WIN_THREADS */
+
 extern H5_api_t H5_g;
 
 #else /* H5_HAVE_THREADSAFE */
@@ -1944,6 +2017,13 @@ extern hbool_t H5_libterm_g;    /* Is the library being shutdown? */
 
 #endif /* H5_HAVE_THREADSAFE */
 
+#ifndef H5_API_READ_BEGIN
+/* No shared read path (sequential or Windows version) */
+#define H5_API_READ_BEGIN       if(0) {{
+#define H5_API_READ_RETURN(V)   return(V);
+#define H5_API_READ_END         }}
+#endif /* H5_API_READ_BEGIN */
+
 #ifdef H5_HAVE_CODESTACK
 
 /* Include required function stack header */
@@ -2654,6 +2734,7 @@ H5_DLL int H5CX_term_package(void);
 H5_DLL int H5D_term_package(void);
 H5_DLL int H5D_top_term_package(void);
 H5_DLL int H5E_term_package(void);
+H5_DLL int H5ES_term_package(void);
 H5_DLL int H5F_term_package(void);
 H5_DLL int H5FD_term_package(void);
 H5_DLL int H5FL_term_package(void);
@@ -528,6 +528,10 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                                    HDfprintf(out, "H5D_CHUNK_IDX_SINGLE");
                                     break;
 
+                                case H5D_CHUNK_IDX_SHARD:
+                                   HDfprintf(out, "H5D_CHUNK_IDX_SHARD");
+                                    break;
+
                                 case H5D_CHUNK_IDX_NTYPES:
                                    HDfprintf(out, "ERROR: H5D_CHUNK_IDX_NTYPES (invalid value)");
                                     break;
@@ -1351,6 +1355,10 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                                 HDfprintf(out, "%ld (err stack)", (long)obj);
                                 break;
 
+                            case H5I_EVENTSET:
+                                HDfprintf(out, "%ld (event set)", (long)obj);
+                                break;
+
                             case H5I_NTYPES:
                                 HDfprintf (out, "%ld (ntypes - error)", (long)obj);
                                 break;
@@ -1532,6 +1540,10 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                                     HDfprintf(out, "H5I_ERROR_STACK");
                                     break;
 
+                                case H5I_EVENTSET:
+                                    HDfprintf(out, "H5I_EVENTSET");
+                                    break;
+
                                 case H5I_NTYPES:
                                     HDfprintf(out, "H5I_NTYPES");
                                     break;
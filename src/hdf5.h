@@ -24,6 +24,7 @@
 #include "H5ACpublic.h"         /* Metadata cache                           */
 #include "H5Dpublic.h"          /* Datasets                                 */
 #include "H5Epublic.h"          /* Errors                                   */
+#include "H5ESpublic.h"         /* Event sets                               */
 #include "H5Fpublic.h"          /* Files                                    */
 #include "H5FDpublic.h"         /* File drivers                             */
 #include "H5Gpublic.h"          /* Groups                                   */
@@ -42,7 +43,9 @@
 #include "H5FDcore.h"           /* Files stored entirely in memory              */
 #include "H5FDdirect.h"         /* Linux direct I/O                             */
 #include "H5FDfamily.h"         /* File families                                */
+#include "H5FDiouring.h"        /* Linux io_uring batched I/O                   */
 #include "H5FDlog.h"            /* sec2 driver with I/O logging (for debugging) */
+#include "H5FDmmap.h"           /* Read-only memory-mapped file I/O             */
 #include "H5FDmpi.h"            /* MPI-based file drivers                       */
 #include "H5FDmulti.h"          /* Usage-partitioned file family                */
 #include "H5FDsec2.h"           /* POSIX unbuffered file I/O                    */
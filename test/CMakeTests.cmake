@@ -474,6 +474,7 @@ set (test_CLEANFILES
     new_move_b.h5
     ntypes.h5
     dangle.h5
+    event_set.h5
     error_test.h5
     err_compat.h5
     dtransform.h5
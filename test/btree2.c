@@ -40,6 +40,7 @@ const char *FILENAME[] = {
 #define INSERT_MANY_REC         (2700 * 1000)
 #define FIND_MANY               (INSERT_MANY / 100)
 #define FIND_MANY_REC           (INSERT_MANY_REC / 100)
+#define INSERT_BULK             (10 * 1000)
 #define FIND_NEIGHBOR           2000
 #define DELETE_SMALL            20
 #define DELETE_MEDIUM           200
@@ -3176,6 +3177,148 @@ error:
     return 1;
 } /* test_insert_lots() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	test_insert_bulk
+ *
+ * Purpose:	Basic tests for loading a v2 B-tree in bulk
+ *
+ * Return:	Success:	0
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_insert_bulk(hid_t fapl, const H5B2_create_t *cparam,
+    const bt2_test_param_t *tparam)
+{
+    hid_t	file = -1;              /* File ID */
+    H5F_t	*f = NULL;              /* Internal file object pointer */
+    H5B2_t      *bt2 = NULL;            /* v2 B-tree wrapper */
+    haddr_t     bt2_addr;               /* Address of B-tree created */
+    hsize_t     record;                 /* Record to insert into tree */
+    hsize_t     idx;                    /* Index within B-tree, for iterator */
+    hsize_t     nrec;                   /* Number of records in B-tree */
+    unsigned    u;                      /* Local index variable */
+    herr_t      ret;                    /* Generic error return value */
+
+    TESTING("B-tree insert: load B-tree in bulk");
+
+    /* Create the file to work on */
+    if(create_file(&file, &f, fapl) < 0)
+        TEST_ERROR
+
+    /* Create the v2 B-tree & get its address */
+    if(create_btree(f, cparam, &bt2, &bt2_addr) < 0)
+        TEST_ERROR
+
+    /* Insert the first half of the announced records, in order */
+    if(H5B2_bulk_begin(bt2, (hsize_t)INSERT_BULK) < 0)
+        FAIL_STACK_ERROR
+    for(u = 0; u < INSERT_BULK / 2; u++) {
+        record = u;
+        if(H5B2_insert(bt2, &record) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+
+    /* The B-tree can't be used until the load is finished */
+    idx = 0;
+    H5E_BEGIN_TRY {
+        ret = H5B2_iterate(bt2, iter_cb, &idx);
+    } H5E_END_TRY;
+    if(ret != FAIL)
+        TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5B2_index(bt2, H5_ITER_INC, (hsize_t)0, find_cb, NULL);
+    } H5E_END_TRY;
+    if(ret != FAIL)
+        TEST_ERROR
+    record = 0;
+    H5E_BEGIN_TRY {
+        ret = H5B2_remove(bt2, &record, NULL, NULL);
+    } H5E_END_TRY;
+    if(ret != FAIL)
+        TEST_ERROR
+
+    /* Insert the rest of the records and finish the load */
+    for(u = INSERT_BULK / 2; u < INSERT_BULK; u++) {
+        record = u;
+        if(H5B2_insert(bt2, &record) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    if(H5B2_bulk_end(bt2) < 0)
+        FAIL_STACK_ERROR
+
+    /* Check for closing & re-opening the B-tree */
+    if(reopen_btree(f, &bt2, bt2_addr, tparam) < 0)
+        TEST_ERROR
+
+    /* Check the records */
+    if(H5B2_get_nrec(bt2, &nrec) < 0)
+        FAIL_STACK_ERROR
+    if(nrec != INSERT_BULK)
+        TEST_ERROR
+    idx = 0;
+    if(H5B2_iterate(bt2, iter_cb, &idx) < 0)
+        FAIL_STACK_ERROR
+    if(idx != INSERT_BULK)
+        TEST_ERROR
+    for(u = 0; u < INSERT_BULK; u += 97) {
+        idx = u;
+        if(H5B2_index(bt2, H5_ITER_INC, idx, find_cb, &idx) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Close the v2 B-tree */
+    if(H5B2_close(bt2) < 0)
+        FAIL_STACK_ERROR
+    bt2 = NULL;
+
+    /* A load with fewer records than announced fails, as does closing
+     * the B-tree during a load */
+    if(create_btree(f, cparam, &bt2, &bt2_addr) < 0)
+        TEST_ERROR
+    if(H5B2_bulk_begin(bt2, (hsize_t)INSERT_BULK) < 0)
+        FAIL_STACK_ERROR
+    record = 0;
+    if(H5B2_insert(bt2, &record) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5B2_bulk_end(bt2);
+    } H5E_END_TRY;
+    if(ret != FAIL)
+        TEST_ERROR
+    if(H5B2_close(bt2) < 0)
+        FAIL_STACK_ERROR
+    bt2 = NULL;
+    if(create_btree(f, cparam, &bt2, &bt2_addr) < 0)
+        TEST_ERROR
+    if(H5B2_bulk_begin(bt2, (hsize_t)INSERT_BULK) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5B2_close(bt2);
+    } H5E_END_TRY;
+    bt2 = NULL;
+    if(ret != FAIL)
+        TEST_ERROR
+
+    /* Close file */
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(bt2)
+            H5B2_close(bt2);
+	H5Fclose(file);
+    } H5E_END_TRY;
+    return 1;
+} /* test_insert_bulk() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	test_update_basic
@@ -9997,6 +10140,7 @@ main(void)
             printf("***Express test mode on.  test_insert_lots skipped\n");
         else
             nerrors += test_insert_lots(fapl, &cparam, &tparam);
+        nerrors += test_insert_bulk(fapl, &cparam, &tparam);
 
         /* Test B-tree record update (ie. insert/modify) */
         /* (Iteration, find & index routines exercised in these routines as well) */
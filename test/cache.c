@@ -19,6 +19,10 @@
  */
 #include "cache_common.h"
 
+#if defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_THREADSAFE)
+#include <pthread.h>
+#endif /* defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_THREADSAFE) */
+
 
 /* private typedef declarations: */
 
@@ -195,6 +199,9 @@ static unsigned check_flush_deps_order(unsigned paged);
 static unsigned check_notify_cb(unsigned paged);
 static unsigned check_metadata_cork(hbool_t fill_via_insertion, unsigned paged);
 static unsigned check_entry_deletions_during_scans(unsigned paged);
+static unsigned check_replacement_policy(unsigned paged);
+static unsigned check_deferred_lru(unsigned paged);
+static unsigned check_deferred_lru_threads(unsigned paged);
 static void cedds__expunge_dirty_entry_in_flush_test(H5F_t * file_ptr);
 static void cedds__H5C_make_space_in_cache(H5F_t * file_ptr);
 static void cedds__H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t * file_ptr);
@@ -35909,6 +35916,689 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 } /* cedds__H5C_flush_invalidate_cache__bucket_scan() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	check_replacement_policy()
+ *
+ * Purpose:	Verify that H5C_get_replacement_policy() and
+ *		H5C_set_replacement_policy() perform as expected, and that
+ *		the 2Q policy keeps a working set of entries in the cache
+ *		across a scan of many entries, while the modified LRU
+ *		policy does not.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_replacement_policy(unsigned paged)
+{
+    enum H5C_cache_rp_mode policy;
+    herr_t         result;
+    int 	   i;
+    H5F_t *        file_ptr = NULL;
+    H5C_t *        cache_ptr = NULL;
+
+    if(paged)
+        TESTING("2Q replacement policy (paged aggregation)")
+    else
+        TESTING("2Q replacement policy")
+
+    /* Setup a cache with room for 16 monster entries, and verify that
+     * it uses the modified LRU policy.  Switch it to the 2Q policy.
+     *
+     * Load monster entries 0 - 19, so that entries 0 - 3 are evicted
+     * from the cold segment, and their addresses remembered.  Load
+     * entries 0 - 3 again -- they should now be hot.
+     *
+     * Scan monster entries 100 - 163.  Entries 0 - 3 should stay in
+     * the cache.
+     *
+     * Switch the cache back to the modified LRU policy, and scan monster
+     * entries 200 - 263.  Entries 0 - 3 should be evicted.
+     */
+
+    pass = TRUE;
+
+    if(pass) {
+
+        reset_entries();
+
+        file_ptr = setup_cache((size_t)(1 * 1024 * 1024), (size_t)(512 * 1024), paged);
+
+        if(file_ptr == NULL) {
+
+            pass = FALSE;
+            failure_mssg = "file_ptr NULL from setup_cache.";
+
+        } else {
+
+            cache_ptr = file_ptr->shared->cache;
+        }
+    }
+
+    if(pass) {
+
+        result = H5C_get_replacement_policy(cache_ptr, &policy);
+
+        if((result != SUCCEED) || (policy != H5C_rp__lru)) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected initial replacement policy.";
+        }
+    }
+
+    if(pass) {
+
+        result = H5C_set_replacement_policy(cache_ptr, H5C_rp__2q);
+
+        if(result == SUCCEED)
+            result = H5C_get_replacement_policy(cache_ptr, &policy);
+
+        if((result != SUCCEED) || (policy != H5C_rp__2q)) {
+
+            pass = FALSE;
+            failure_mssg = "Can't set 2Q replacement policy.";
+        }
+    }
+
+    for(i = 0; pass && (i < 20); i++) {
+
+        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    if(pass) {
+
+        if((cache_ptr->index_len != 16) ||
+             (cache_ptr->rp_hot_size != 0) ||
+             (cache_ptr->rp_ghost_len != 4) ||
+             (entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, 0)) ||
+             (entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, 3)) ||
+             (!entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, 4))) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected cache status after initial loads.";
+        }
+    }
+
+    for(i = 0; pass && (i < 4); i++) {
+
+        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    if(pass) {
+
+        if((cache_ptr->rp_hot_size != 4 * MONSTER_ENTRY_SIZE) ||
+             (entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, 4))) {
+
+            pass = FALSE;
+            failure_mssg = "Reloaded entries not hot.";
+        }
+    }
+
+    for(i = 100; pass && (i < 164); i++) {
+
+        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    for(i = 0; pass && (i < 4); i++) {
+
+        if(!entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, i)) {
+
+            pass = FALSE;
+            failure_mssg = "Hot entry evicted by scan under 2Q policy.";
+        }
+    }
+
+    if(pass) {
+
+        if((cache_ptr->index_len != 16) ||
+             (cache_ptr->rp_ghost_len > cache_ptr->index_len) ||
+             (cache_ptr->rp_ghost_size > (cache_ptr->max_cache_size / 2))) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected cache status after 2Q scan.";
+        }
+    }
+
+    if(pass) {
+
+        result = H5C_set_replacement_policy(cache_ptr, H5C_rp__lru);
+
+        if((result != SUCCEED) ||
+             (cache_ptr->rp_ghost_len != 0) ||
+             (cache_ptr->rp_ghost_slist_ptr != NULL)) {
+
+            pass = FALSE;
+            failure_mssg = "Can't set modified LRU replacement policy.";
+        }
+    }
+
+    for(i = 200; pass && (i < 264); i++) {
+
+        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    for(i = 0; pass && (i < 4); i++) {
+
+        if(entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, i)) {
+
+            pass = FALSE;
+            failure_mssg = "Entry survived scan under modified LRU policy.";
+        }
+    }
+
+    if(pass) {
+
+        takedown_cache(file_ptr, FALSE, FALSE);
+    }
+
+    if(pass) { PASSED(); } else { H5_FAILED(); }
+
+    if(!pass) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n",
+                  FUNC, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_replacement_policy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	check_deferred_lru()
+ *
+ * Purpose:	Verify that H5C_get_deferred_lru() and
+ *		H5C_set_deferred_lru() perform as expected, that read only
+ *		protects of clean entries leave them on the LRU list when
+ *		deferred LRU updates are enabled, and that such entries
+ *		are given a second chance by H5C__make_space_in_cache().
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_deferred_lru(unsigned paged)
+{
+    hbool_t        deferred_lru;
+    herr_t         result;
+    int 	   i;
+    H5F_t *        file_ptr = NULL;
+    H5C_t *        cache_ptr = NULL;
+    test_entry_t * base_addr;
+    test_entry_t * entry_ptr;
+
+    if(paged)
+        TESTING("deferred LRU updates (paged aggregation)")
+    else
+        TESTING("deferred LRU updates")
+
+    /* Setup a cache with room for 16 monster entries, enable deferred
+     * LRU updates, and load monster entries 0 - 15.
+     *
+     * Protect entries 0 - 3 read only and unprotect them.  They should
+     * stay at the tail of the LRU list, with their reference bits set.
+     *
+     * Load entries 16 - 19.  Entries 0 - 3 should be moved to the head
+     * of the LRU list instead of being evicted, so entries 4 - 7 are
+     * evicted in their place.
+     *
+     * Protect entry 8 (now at the tail of the LRU list) read only, and
+     * load entry 20.  Entry 8 should be skipped, and entry 9 evicted.
+     * Pin entry 8 while it is protected -- it should move to the
+     * protected list.  Unprotect and unpin it.
+     *
+     * Finally, disable deferred LRU updates, and verify that read only
+     * protects use the protected list again.
+     */
+
+    pass = TRUE;
+
+    base_addr = entries[MONSTER_ENTRY_TYPE];
+
+    if(pass) {
+
+        reset_entries();
+
+        file_ptr = setup_cache((size_t)(1 * 1024 * 1024), (size_t)(512 * 1024), paged);
+
+        if(file_ptr == NULL) {
+
+            pass = FALSE;
+            failure_mssg = "file_ptr NULL from setup_cache.";
+
+        } else {
+
+            cache_ptr = file_ptr->shared->cache;
+        }
+    }
+
+    if(pass) {
+
+        result = H5C_get_deferred_lru(cache_ptr, &deferred_lru);
+
+        if((result != SUCCEED) || (deferred_lru != FALSE)) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected initial deferred LRU setting.";
+        }
+    }
+
+    if(pass) {
+
+        result = H5C_set_deferred_lru(cache_ptr, TRUE);
+
+        if(result == SUCCEED)
+            result = H5C_get_deferred_lru(cache_ptr, &deferred_lru);
+
+        if((result != SUCCEED) || (deferred_lru != TRUE)) {
+
+            pass = FALSE;
+            failure_mssg = "Can't enable deferred LRU updates.";
+        }
+    }
+
+    for(i = 0; pass && (i < 16); i++) {
+
+        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    for(i = 0; pass && (i < 4); i++) {
+
+        protect_entry_ro(file_ptr, MONSTER_ENTRY_TYPE, i);
+
+        if(pass && ((cache_ptr->pl_len != 0) ||
+                     (!(base_addr[i].header.ro_in_lru)))) {
+
+            pass = FALSE;
+            failure_mssg = "Read only protect moved entry to protected list.";
+        }
+
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    if(pass) {
+
+        if((cache_ptr->LRU_tail_ptr != &(base_addr[0].header)) ||
+             (cache_ptr->LRU_list_len != 16)) {
+
+            pass = FALSE;
+            failure_mssg = "Read only protect updated the LRU list.";
+        }
+    }
+
+    for(i = 0; pass && (i < 4); i++) {
+
+        if((base_addr[i].header.ro_in_lru) ||
+             (!(base_addr[i].header.lru_ref_bit))) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected entry status after read only unprotect.";
+        }
+    }
+
+    for(i = 16; pass && (i < 20); i++) {
+
+        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    for(i = 0; pass && (i < 8); i++) {
+
+        if((i < 4) && ((!entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, i)) ||
+                        (base_addr[i].header.lru_ref_bit))) {
+
+            pass = FALSE;
+            failure_mssg = "Referenced entry evicted.";
+
+        } else if((i >= 4) && (entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, i))) {
+
+            pass = FALSE;
+            failure_mssg = "Unreferenced entry not evicted.";
+        }
+    }
+
+    if(pass) {
+
+        if(cache_ptr->LRU_tail_ptr != &(base_addr[8].header)) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected LRU list tail.";
+        }
+    }
+
+    protect_entry_ro(file_ptr, MONSTER_ENTRY_TYPE, 8);
+
+    protect_entry(file_ptr, MONSTER_ENTRY_TYPE, 20);
+    unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, 20, H5C__NO_FLAGS_SET);
+
+    if(pass) {
+
+        if((!entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, 8)) ||
+             (entry_in_cache(cache_ptr, MONSTER_ENTRY_TYPE, 9)) ||
+             (!(base_addr[8].header.ro_in_lru))) {
+
+            pass = FALSE;
+            failure_mssg = "Protected entry not skipped by make space.";
+        }
+    }
+
+    if(pass) {
+
+        entry_ptr = &(base_addr[8]);
+
+        if(H5C_pin_protected_entry((void *)entry_ptr) < 0) {
+
+            pass = FALSE;
+            failure_mssg = "H5C_pin_protected_entry() failed.";
+
+        } else if((!(entry_ptr->header.is_pinned)) ||
+                    (entry_ptr->header.ro_in_lru) ||
+                    (cache_ptr->pl_len != 1)) {
+
+            pass = FALSE;
+            failure_mssg = "Pinned entry not moved to protected list.";
+
+        } else {
+
+            /* keep test bed sanity checks happy */
+            entry_ptr->is_pinned = TRUE;
+        }
+    }
+
+    unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, 8, H5C__UNPIN_ENTRY_FLAG);
+
+    if(pass) {
+
+        if((cache_ptr->pl_len != 0) || (cache_ptr->pel_len != 0) ||
+             (cache_ptr->LRU_head_ptr != &(base_addr[8].header))) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected cache status after unpin.";
+        }
+    }
+
+    if(pass) {
+
+        result = H5C_set_deferred_lru(cache_ptr, FALSE);
+
+        if(result == SUCCEED)
+            result = H5C_get_deferred_lru(cache_ptr, &deferred_lru);
+
+        if((result != SUCCEED) || (deferred_lru != FALSE)) {
+
+            pass = FALSE;
+            failure_mssg = "Can't disable deferred LRU updates.";
+        }
+    }
+
+    protect_entry_ro(file_ptr, MONSTER_ENTRY_TYPE, 0);
+
+    if(pass) {
+
+        if((cache_ptr->pl_len != 1) || (base_addr[0].header.ro_in_lru)) {
+
+            pass = FALSE;
+            failure_mssg = "Read only protect didn't use the protected list.";
+        }
+    }
+
+    unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, 0, H5C__NO_FLAGS_SET);
+
+    if(pass) {
+
+        takedown_cache(file_ptr, FALSE, FALSE);
+    }
+
+    if(pass) { PASSED(); } else { H5_FAILED(); }
+
+    if(!pass) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n",
+                  FUNC, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_deferred_lru() */
+
+
+/* Threads, protect / unprotect rounds per thread, and entries used by
+ * check_deferred_lru_threads()
+ */
+#define DEFERRED_LRU_NTHREADS   4
+#define DEFERRED_LRU_NROUNDS    20000
+#define DEFERRED_LRU_NENTRIES   4
+
+#if defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_THREADSAFE)
+
+/*-------------------------------------------------------------------------
+ * Function:	check_deferred_lru_threads__reader()
+ *
+ * Purpose:	Protect and unprotect entries 0 - (DEFERRED_LRU_NENTRIES
+ *		- 1) read only DEFERRED_LRU_NROUNDS times, holding two
+ *		protects of each entry at once.
+ *
+ *		This talks to H5C directly, and must not touch the test
+ *		bed's own bookkeeping, which is not thread safe.
+ *
+ * Return:	NULL on success, and an error message on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+check_deferred_lru_threads__reader(void *_file_ptr)
+{
+    H5F_t *        file_ptr = (H5F_t *)_file_ptr;
+    test_entry_t * base_addr = entries[MONSTER_ENTRY_TYPE];
+    test_entry_t * entry_ptr;
+    void *         thing1;
+    void *         thing2;
+    int            i;
+
+    for(i = 0; i < DEFERRED_LRU_NROUNDS; i++) {
+
+        entry_ptr = &(base_addr[i % DEFERRED_LRU_NENTRIES]);
+
+        thing1 = H5C_protect(file_ptr, types[MONSTER_ENTRY_TYPE],
+                             entry_ptr->addr, &entry_ptr->addr,
+                             H5C__READ_ONLY_FLAG);
+        thing2 = H5C_protect(file_ptr, types[MONSTER_ENTRY_TYPE],
+                             entry_ptr->addr, &entry_ptr->addr,
+                             H5C__READ_ONLY_FLAG);
+
+        if((thing1 != (void *)entry_ptr) || (thing2 != (void *)entry_ptr))
+            return (void *)"read only H5C_protect() failed.";
+
+        if((H5C_unprotect(file_ptr, entry_ptr->addr, thing2,
+                          H5C__NO_FLAGS_SET) < 0) ||
+             (H5C_unprotect(file_ptr, entry_ptr->addr, thing1,
+                            H5C__NO_FLAGS_SET) < 0))
+            return (void *)"read only H5C_unprotect() failed.";
+    }
+
+    return NULL;
+
+} /* check_deferred_lru_threads__reader() */
+
+#endif /* defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_THREADSAFE) */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	check_deferred_lru_threads()
+ *
+ * Purpose:	Verify that read only protects and unprotects of entries
+ *		that stay on the LRU list with deferred LRU updates can
+ *		run on several threads at once -- that the entries'
+ *		protect counts and the cache hit rate statistics come out
+ *		right, and that the index and the LRU list are left alone.
+ *
+ *		Only the hit path is safe to run concurrently, so the
+ *		entries are loaded beforehand.  Skipped in thread safe
+ *		builds, where the reader threads would have no API context.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_deferred_lru_threads(unsigned paged)
+{
+#if defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_THREADSAFE)
+    pthread_t      threads[DEFERRED_LRU_NTHREADS];
+    void *         thread_ret;
+    int 	   nthreads = 0;
+    int 	   i;
+    int64_t        cache_hits = 0;
+    int64_t        cache_accesses = 0;
+    H5F_t *        file_ptr = NULL;
+    H5C_t *        cache_ptr = NULL;
+    H5C_cache_entry_t * lru_head_ptr = NULL;
+    test_entry_t * base_addr;
+#endif /* defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_THREADSAFE) */
+
+    if(paged)
+        TESTING("concurrent read only protects (paged aggregation)")
+    else
+        TESTING("concurrent read only protects")
+
+#if defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_THREADSAFE)
+
+    pass = TRUE;
+
+    base_addr = entries[MONSTER_ENTRY_TYPE];
+
+    if(pass) {
+
+        reset_entries();
+
+        file_ptr = setup_cache((size_t)(1 * 1024 * 1024), (size_t)(512 * 1024), paged);
+
+        if(file_ptr == NULL) {
+
+            pass = FALSE;
+            failure_mssg = "file_ptr NULL from setup_cache.";
+
+        } else {
+
+            cache_ptr = file_ptr->shared->cache;
+        }
+    }
+
+    for(i = 0; pass && (i < DEFERRED_LRU_NENTRIES); i++) {
+
+        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    if(pass) {
+
+        if(H5C_set_deferred_lru(cache_ptr, TRUE) < 0) {
+
+            pass = FALSE;
+            failure_mssg = "Can't enable deferred LRU updates.";
+
+        } else {
+
+            cache_hits = cache_ptr->cache_hits;
+            cache_accesses = cache_ptr->cache_accesses;
+            lru_head_ptr = cache_ptr->LRU_head_ptr;
+        }
+    }
+
+    for(nthreads = 0; pass && (nthreads < DEFERRED_LRU_NTHREADS); nthreads++) {
+
+        if(pthread_create(&(threads[nthreads]), NULL,
+                          check_deferred_lru_threads__reader,
+                          (void *)file_ptr) != 0) {
+
+            pass = FALSE;
+            failure_mssg = "pthread_create() failed.";
+            break;
+        }
+    }
+
+    for(i = 0; i < nthreads; i++) {
+
+        if(pthread_join(threads[i], &thread_ret) != 0) {
+
+            pass = FALSE;
+            failure_mssg = "pthread_join() failed.";
+
+        } else if(thread_ret != NULL) {
+
+            pass = FALSE;
+            failure_mssg = (const char *)thread_ret;
+        }
+    }
+
+    for(i = 0; pass && (i < DEFERRED_LRU_NENTRIES); i++) {
+
+        if((base_addr[i].header.is_protected) ||
+             (base_addr[i].header.is_read_only) ||
+             (base_addr[i].header.ro_ref_count != 0) ||
+             (base_addr[i].header.ro_in_lru) ||
+             (!(base_addr[i].header.lru_ref_bit))) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected entry status after concurrent read only protects.";
+        }
+    }
+
+    if(pass) {
+
+        if((cache_ptr->pl_len != 0) ||
+             (cache_ptr->LRU_list_len != DEFERRED_LRU_NENTRIES) ||
+             (cache_ptr->LRU_head_ptr != lru_head_ptr)) {
+
+            pass = FALSE;
+            failure_mssg = "Concurrent read only protects updated the LRU list.";
+
+        } else if((cache_ptr->cache_hits - cache_hits !=
+                   (int64_t)2 * DEFERRED_LRU_NTHREADS * DEFERRED_LRU_NROUNDS) ||
+                  (cache_ptr->cache_accesses - cache_accesses !=
+                   (int64_t)2 * DEFERRED_LRU_NTHREADS * DEFERRED_LRU_NROUNDS)) {
+
+            pass = FALSE;
+            failure_mssg = "Concurrent read only protects lost cache hits.";
+        }
+    }
+
+    if(pass) {
+
+        takedown_cache(file_ptr, FALSE, FALSE);
+    }
+
+    if(pass) { PASSED(); } else { H5_FAILED(); }
+
+    if(!pass) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n",
+                  FUNC, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+#else /* defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_THREADSAFE) */
+
+    SKIPPED();
+
+    return 0;
+
+#endif /* defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_THREADSAFE) */
+
+} /* check_deferred_lru_threads() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	check_stats()
  *
@@ -36517,6 +37207,9 @@ main(void)
         nerrs += check_metadata_cork(TRUE, paged);
         nerrs += check_metadata_cork(FALSE, paged);
         nerrs += check_entry_deletions_during_scans(paged);
+        nerrs += check_replacement_policy(paged);
+        nerrs += check_deferred_lru(paged);
+        nerrs += check_deferred_lru_threads(paged);
         nerrs += check_stats(paged);
     } /* end for */
 
@@ -34,6 +34,7 @@ static hbool_t mdc_api_call_smoke_check(int express_test, unsigned paged, hid_t
 static H5AC_cache_config_t * init_invalid_configs(void);
 static hbool_t check_fapl_mdc_api_errs(void);
 static hbool_t check_file_mdc_api_errs(unsigned paged, hid_t fcpl_id);
+static hbool_t check_mdc_config_versions(void);
 
 
 
@@ -2259,6 +2260,282 @@ check_file_mdc_api_errs(unsigned paged, hid_t fcpl_id)
 
 } /* check_file_mdc_api_errs() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    check_mdc_config_versions()
+ *
+ * Purpose:     Verify that the MDC API calls accept both versions of
+ *              H5AC_cache_config_t: that version 2 configurations
+ *              select the replacement policy, both in FAPLs (including
+ *              encoded ones) and in open files, and that the
+ *              replacement_policy field of version 1 configurations is
+ *              neither read nor written, the modified LRU policy being
+ *              used for them.
+ *
+ * Return:      Test pass status (TRUE/FALSE)
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+check_mdc_config_versions(void)
+{
+    char filename[512];
+    hid_t fapl_id = -1;
+    hid_t fapl2_id = -1;
+    hid_t file_id = -1;
+    void *buf = NULL;
+    size_t buf_size = 0;
+    herr_t result;
+    H5AC_cache_config_t config_2q = H5AC__DEFAULT_CACHE_CONFIG;
+    H5AC_cache_config_t config_v1 = H5AC__DEFAULT_CACHE_CONFIG;
+    H5AC_cache_config_t scratch;
+
+    TESTING("MDC config versions and replacement policies");
+
+    pass = TRUE;
+
+    /* A version 2 configuration selecting the 2Q policy, and a version 1
+     * configuration whose replacement_policy field would be invalid if
+     * it were read.
+     */
+    config_2q.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    config_2q.replacement_policy = H5C_rp__2q;
+    config_v1.version = H5AC__MIN_CACHE_CONFIG_VERSION;
+    config_v1.replacement_policy = (enum H5C_cache_rp_mode)-1;
+
+    /* Set the 2Q configuration in a FAPL, and check that it reads back
+     * with either version.
+     */
+    if ( pass ) {
+
+        fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+
+        if ( ( fapl_id < 0 ) || ( H5Pset_mdc_config(fapl_id, &config_2q) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't set version 2 config in FAPL.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
+        if ( ( H5Pget_mdc_config(fapl_id, &scratch) < 0 ) ||
+             ( !CACHE_CONFIGS_EQUAL(config_2q, scratch, TRUE, TRUE) ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected version 2 config from FAPL.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        scratch.version = H5AC__MIN_CACHE_CONFIG_VERSION;
+        scratch.replacement_policy = (enum H5C_cache_rp_mode)-1;
+
+        if ( ( H5Pget_mdc_config(fapl_id, &scratch) < 0 ) ||
+             ( scratch.version != H5AC__MIN_CACHE_CONFIG_VERSION ) ||
+             ( scratch.max_size != config_2q.max_size ) ||
+             ( scratch.replacement_policy != (enum H5C_cache_rp_mode)-1 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected version 1 config from FAPL.\n";
+        }
+    }
+
+    /* Check that the policy survives encoding the FAPL */
+    if ( pass ) {
+
+        if ( ( H5Pencode(fapl_id, NULL, &buf_size) < 0 ) ||
+             ( NULL == (buf = HDmalloc(buf_size)) ) ||
+             ( H5Pencode(fapl_id, buf, &buf_size) < 0 ) ||
+             ( (fapl2_id = H5Pdecode(buf)) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't encode and decode FAPL.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
+        if ( ( H5Pget_mdc_config(fapl2_id, &scratch) < 0 ) ||
+             ( scratch.replacement_policy != H5C_rp__2q ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Decoded FAPL lost the replacement policy.\n";
+        }
+    }
+
+    /* Versions 0 and 3 are unknown, and so is the policy -1 in version 2 */
+    if ( pass ) {
+
+        H5E_BEGIN_TRY {
+            scratch = config_2q;
+            scratch.version = 0;
+            result = H5Pset_mdc_config(fapl_id, &scratch);
+            if ( result < 0 ) {
+                scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION + 1;
+                result = H5Pget_mdc_config(fapl_id, &scratch);
+            }
+            if ( result < 0 ) {
+                scratch = config_2q;
+                scratch.replacement_policy = (enum H5C_cache_rp_mode)-1;
+                result = H5Pset_mdc_config(fapl_id, &scratch);
+            }
+        } H5E_END_TRY;
+
+        if ( result >= 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "Bad config version or policy accepted.\n";
+        }
+    }
+
+    /* Setting the version 1 configuration selects the LRU policy */
+    if ( pass ) {
+
+        if ( H5Pset_mdc_config(fapl_id, &config_v1) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't set version 1 config in FAPL.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
+        if ( ( H5Pget_mdc_config(fapl_id, &scratch) < 0 ) ||
+             ( scratch.replacement_policy != H5C_rp__lru ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Version 1 config in FAPL didn't select LRU.\n";
+        }
+    }
+
+    /* Open a file with the 2Q configuration, and switch its policy with
+     * configurations of both versions.
+     */
+    if ( pass ) {
+
+        if ( ( h5_fixname(FILENAME[1], H5P_DEFAULT, filename, sizeof(filename)) == NULL ) ||
+             ( (file_id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl2_id)) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't create file.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
+        if ( ( H5Fget_mdc_config(file_id, &scratch) < 0 ) ||
+             ( scratch.replacement_policy != H5C_rp__2q ) ) {
+
+            pass = FALSE;
+            failure_mssg = "File doesn't use the 2Q policy from its FAPL.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        scratch.version = H5AC__MIN_CACHE_CONFIG_VERSION;
+        scratch.replacement_policy = (enum H5C_cache_rp_mode)-1;
+
+        if ( ( H5Fget_mdc_config(file_id, &scratch) < 0 ) ||
+             ( scratch.version != H5AC__MIN_CACHE_CONFIG_VERSION ) ||
+             ( scratch.replacement_policy != (enum H5C_cache_rp_mode)-1 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected version 1 config from file.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
+        if ( ( H5Fset_mdc_config(file_id, &config_v1) < 0 ) ||
+             ( H5Fget_mdc_config(file_id, &scratch) < 0 ) ||
+             ( scratch.replacement_policy != H5C_rp__lru ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Version 1 config in file didn't select LRU.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
+        if ( ( H5Fset_mdc_config(file_id, &config_2q) < 0 ) ||
+             ( H5Fget_mdc_config(file_id, &scratch) < 0 ) ||
+             ( scratch.replacement_policy != H5C_rp__2q ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Version 2 config in file didn't select 2Q.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        H5E_BEGIN_TRY {
+            scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION + 1;
+            result = H5Fget_mdc_config(file_id, &scratch);
+        } H5E_END_TRY;
+
+        if ( result >= 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fget_mdc_config() accepted bad config version.\n";
+        }
+    }
+
+    if ( file_id >= 0 && H5Fclose(file_id) < 0 ) {
+
+        pass = FALSE;
+        failure_mssg = "H5Fclose() failed.\n";
+    }
+
+    if ( fapl2_id >= 0 && H5Pclose(fapl2_id) < 0 ) {
+
+        pass = FALSE;
+        failure_mssg = "H5Pclose() failed.\n";
+    }
+
+    if ( fapl_id >= 0 && H5Pclose(fapl_id) < 0 ) {
+
+        pass = FALSE;
+        failure_mssg = "H5Pclose() failed.\n";
+    }
+
+    if ( buf )
+        HDfree(buf);
+
+    if ( pass ) {
+
+        PASSED();
+
+    } else {
+
+        H5_FAILED();
+    }
+
+    if ( ! pass ) {
+
+        HDfprintf(stdout, "%s: failure_mssg = \"%s\".\n", FUNC, failure_mssg);
+    }
+
+    return pass;
+
+} /* check_mdc_config_versions() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:    main
@@ -2343,6 +2620,9 @@ main(void)
     if(!check_fapl_mdc_api_errs())
         nerrs += 1;
 
+    if(!check_mdc_config_versions())
+        nerrs += 1;
+
     if(invalid_configs)
         HDfree(invalid_configs);
 
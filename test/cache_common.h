@@ -442,9 +442,11 @@ if ( ( (cache_ptr) == NULL ) ||                                        \
 
 /* Macros used in H5AC level tests */
 
+/* Configurations of different versions are equal if the fields they have
+ * in common are: version 1 configurations have no replacement policy.
+ */
 #define CACHE_CONFIGS_EQUAL(a, b, cmp_set_init, cmp_init_size)        \
-  ( ( (a).version                 == (b).version ) &&                 \
-    ( (a).rpt_fcn_enabled         == (b).rpt_fcn_enabled ) &&         \
+  ( ( (a).rpt_fcn_enabled         == (b).rpt_fcn_enabled ) &&         \
     ( (a).open_trace_file         == (b).open_trace_file ) &&         \
     ( (a).close_trace_file        == (b).close_trace_file ) &&        \
     ( ( (a).open_trace_file == FALSE ) ||                             \
@@ -475,7 +477,10 @@ if ( ( (cache_ptr) == NULL ) ||                                        \
     ( (a).apply_empty_reserve     == (b).apply_empty_reserve ) &&     \
     ( H5_DBL_ABS_EQUAL((a).empty_reserve, (b).empty_reserve) ) && \
     ( (a).dirty_bytes_threshold   == (b).dirty_bytes_threshold ) &&   \
-    ( (a).metadata_write_strategy == (b).metadata_write_strategy ) )
+    ( (a).metadata_write_strategy == (b).metadata_write_strategy ) && \
+    ( ( (a).version < H5AC__CACHE_CONFIG_RP_VERSION ) ||             \
+      ( (b).version < H5AC__CACHE_CONFIG_RP_VERSION ) ||             \
+      ( (a).replacement_policy    == (b).replacement_policy ) ) )
 
 #define XLATE_EXT_TO_INT_MDC_CONFIG(i, e)                           \
 {                                                                   \
@@ -2223,6 +2223,7 @@ check_dataset_write_tags(void)
     hid_t sid = -1;                         /* Dataspace Identifier */
     int verbose = FALSE;                    /* verbose file outout */
     hid_t dcpl = -1;                        /* dataset creation pl */
+    hid_t dapl = -1;                        /* dataset access pl */
     hsize_t cdims[2] = {1,1};               /* chunk dimensions */
     int fillval = 0;
     haddr_t root_tag = 0;
@@ -2271,7 +2272,13 @@ check_dataset_write_tags(void)
     if ( H5Dclose(did) < 0 ) TEST_ERROR;
     if ( H5Fclose(fid) < 0 ) TEST_ERROR;
     if ( (fid = H5Fopen(FILENAME, H5F_ACC_RDWR, H5P_DEFAULT)) < 0 ) TEST_ERROR;
-    if (( did = H5Dopen2(fid, DATASETNAME, H5P_DEFAULT)) < 0 ) TEST_ERROR;
+
+    /* Turn off the chunk cache, so the chunks are inserted in the chunk
+     * index during the write */
+    if ( (dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0 ) TEST_ERROR;
+    if ( H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, (size_t)0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0 ) TEST_ERROR;
+    if (( did = H5Dopen2(fid, DATASETNAME, dapl)) < 0 ) TEST_ERROR;
+    if ( H5Pclose(dapl) < 0 ) TEST_ERROR;
 
     /* Evict as much as we can from the cache so we can track full tag path */
     if ( evict_entries(fid) < 0 ) TEST_ERROR;
@@ -2300,8 +2307,8 @@ check_dataset_write_tags(void)
     if ( verbose ) dump_cache(fid);
 #endif /* NDEBUG */ /* end debugging functions */
  
-    /* Verify 10 b-tree nodes belonging to dataset  */
-    for (i=0; i<10; i++)
+    /* Verify 19 b-tree nodes belonging to dataset  */
+    for (i=0; i<19; i++)
         if ( verify_tag(fid, H5AC_BT_ID, d_tag) < 0 ) TEST_ERROR;
 
     /* Verify object header for dataset */
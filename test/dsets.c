@@ -84,6 +84,20 @@ const char *FILENAME[] = {
     "dls_01_strings",   /* 23 */
     "power2up",         /* 24 */
     "version_bounds",   /* 25 */
+    "filter_threads",   /* 26 */
+    "chunk_info",       /* 27 */
+    "multi_dset",       /* 28 */
+    "multi_dset2",      /* 29 */
+    "chunk_cache_pool", /* 30 */
+    "chunk_read_ahead", /* 31 */
+    "chunk_flush_batch", /* 32 */
+    "chunk_index_bulk", /* 33 */
+    "chunk_cache_stats", /* 34 */
+    "chunk_cache_auto", /* 35 */
+    "chunk_read_direct", /* 36 */
+    "chunk_read_direct_filtered", /* 37 */
+    "chunk_shard",      /* 38 */
+    "chunk_implicit",   /* 39 */
     NULL
 };
 
@@ -179,6 +193,7 @@ const char *FILENAME[] = {
 #define H5Z_FILTER_EXPAND            310
 #define H5Z_FILTER_CAN_APPLY_TEST2   311
 #define H5Z_FILTER_COUNT             312
+#define H5Z_FILTER_HELPER_FAIL       313
 
 /* Flags for testing filters */
 #define DISABLE_FLETCHER32      0
@@ -10170,6 +10185,2875 @@ error:
 } /* test_unfiltered_edge_chunks */
 
 
+/*-------------------------------------------------------------------------
+ * Function: test_filter_threads
+ *
+ * Purpose: Tests reading and writing a filtered dataset with the filter
+ *          pipeline allowed to run on several threads, checking that the
+ *          data matches what's read and written with a single thread.
+ *          The dataset mixes chunks written whole and in part, filtered
+ *          and unfiltered edge chunks, and is read with and without a
+ *          chunk cache.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define FILTER_THREADS_DIM0     65
+#define FILTER_THREADS_DIM1     83
+static herr_t
+test_filter_threads(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       dxpl = -1;      /* Dataset transfer property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       did = -1;       /* Dataset ID */
+    hsize_t     dim[2] = {FILTER_THREADS_DIM0, FILTER_THREADS_DIM1}; /* Dataset dimensions */
+    hsize_t     cdim[2] = {8, 10};              /* Chunk dimensions */
+    hsize_t     start[2] = {4, 15};             /* Start of rewritten hyperslab */
+    hsize_t     count[2] = {40, 50};            /* Size of rewritten hyperslab */
+    int         *wbuf = NULL;   /* Data written */
+    int         *rbuf = NULL;   /* Data read */
+    unsigned    opts;           /* Chunk options */
+    unsigned    nthreads;       /* # of filter threads */
+    herr_t      ret;            /* Generic return value */
+    int         use_cache;      /* Whether the dataset has a chunk cache */
+    size_t      u, v;           /* Local index variables */
+
+    TESTING("filter pipeline on several threads");
+
+    h5_fixname(FILENAME[26], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * FILTER_THREADS_DIM0 * FILTER_THREADS_DIM1)))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(sizeof(int) * FILTER_THREADS_DIM0 * FILTER_THREADS_DIM1)))
+        TEST_ERROR
+    for(u = 0; u < FILTER_THREADS_DIM0 * FILTER_THREADS_DIM1; u++)
+        wbuf[u] = (int)(u % 37) * (int)(u / 300);
+
+    /* Check the property */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        TEST_ERROR
+    if(H5Pget_filter_threads(dxpl, &nthreads) < 0)
+        TEST_ERROR
+    if(nthreads != 1)
+        TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_filter_threads(dxpl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        TEST_ERROR
+    if(H5Pset_filter_threads(dxpl, 4) < 0)
+        TEST_ERROR
+    if(H5Pget_filter_threads(dxpl, &nthreads) < 0)
+        TEST_ERROR
+    if(nthreads != 4)
+        TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    if((sid = H5Screate_simple(2, dim, NULL)) < 0)
+        TEST_ERROR
+
+    /* Create the dataset, without filtering its partial edge chunks */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR
+    if(H5Pset_chunk(dcpl, 2, cdim) < 0)
+        TEST_ERROR
+    if(H5Pset_shuffle(dcpl) < 0)
+        TEST_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0)
+        TEST_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0)
+        TEST_ERROR
+    if(H5Pget_chunk_opts(dcpl, &opts) < 0)
+        TEST_ERROR
+    if(H5Pset_chunk_opts(dcpl, opts | H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS) < 0)
+        TEST_ERROR
+    if((did = H5Dcreate2(fid, DSET_CHUNKED_NAME, H5T_NATIVE_INT, sid,
+            H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+
+    /* Write the whole dataset with several threads */
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf) < 0)
+        TEST_ERROR
+    if(H5Dclose(did) < 0)
+        TEST_ERROR
+
+    /* Rewrite part of it, so some chunks are only partly written */
+    for(u = 0; u < count[0]; u++)
+        for(v = 0; v < count[1]; v++)
+            wbuf[(start[0] + u) * FILTER_THREADS_DIM1 + start[1] + v] = -(int)(u * v);
+    if((did = H5Dopen2(fid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+        TEST_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, sid, sid, dxpl, wbuf) < 0)
+        TEST_ERROR
+    if(H5Dclose(did) < 0)
+        TEST_ERROR
+
+    /* Read the dataset back with and without a chunk cache, and with one
+     * and with several threads */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        TEST_ERROR
+    for(use_cache = 0; use_cache < 2; use_cache++) {
+        if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(use_cache ? 1024 * 1024 : 0), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+            TEST_ERROR
+        for(nthreads = 1; nthreads <= 4; nthreads += 3) {
+            if(H5Pset_filter_threads(dxpl, nthreads) < 0)
+                TEST_ERROR
+            if((did = H5Dopen2(fid, DSET_CHUNKED_NAME, dapl)) < 0)
+                TEST_ERROR
+            HDmemset(rbuf, 0, sizeof(int) * FILTER_THREADS_DIM0 * FILTER_THREADS_DIM1);
+            if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+                TEST_ERROR
+            for(u = 0; u < FILTER_THREADS_DIM0 * FILTER_THREADS_DIM1; u++)
+                if(rbuf[u] != wbuf[u]) {
+                    H5_FAILED();
+                    printf("    Read different values than written.\n");
+                    printf("    At index %lu, nthreads=%u, use_cache=%d\n", (unsigned long)u, nthreads, use_cache);
+                    goto error;
+                } /* end if */
+
+            /* Read the dataset a second time, now partly from the cache */
+            HDmemset(rbuf, 0, sizeof(int) * FILTER_THREADS_DIM0 * FILTER_THREADS_DIM1);
+            if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+                TEST_ERROR
+            if(HDmemcmp(rbuf, wbuf, sizeof(int) * FILTER_THREADS_DIM0 * FILTER_THREADS_DIM1))
+                TEST_ERROR
+            if(H5Dclose(did) < 0)
+                TEST_ERROR
+        } /* end for */
+    } /* end for */
+
+    if(H5Pclose(dapl) < 0)
+        TEST_ERROR
+    if(H5Pclose(dxpl) < 0)
+        TEST_ERROR
+    if(H5Pclose(dcpl) < 0)
+        TEST_ERROR
+    if(H5Sclose(sid) < 0)
+        TEST_ERROR
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* test_filter_threads */
+
+
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+/* Thread which the "helper_fail" filter doesn't fail on */
+static pthread_t filter_helper_fail_thread_g;
+
+/*-------------------------------------------------------------------------
+ * Function: filter_helper_fail
+ *
+ * Purpose: A filter which fails on every thread except the one set in
+ *          filter_helper_fail_thread_g, where it passes the data through
+ *          slowly, so that the filter pipeline's helper threads get
+ *          chunks to filter.
+ *
+ * Return:  Success: Data chunk size
+ *          Failure: 0
+ *-------------------------------------------------------------------------
+ */
+static size_t
+filter_helper_fail(unsigned int H5_ATTR_UNUSED flags, size_t H5_ATTR_UNUSED cd_nelmts,
+      const unsigned int H5_ATTR_UNUSED *cd_values, size_t nbytes,
+      size_t H5_ATTR_UNUSED *buf_size, void H5_ATTR_UNUSED **buf)
+{
+    if(!pthread_equal(pthread_self(), filter_helper_fail_thread_g))
+        return 0;
+
+    H5_nanosleep((uint64_t)1000000);
+    return nbytes;
+} /* end filter_helper_fail() */
+
+const H5Z_class2_t H5Z_HELPER_FAIL[1] = {{
+    H5Z_CLASS_T_VERS,           /* H5Z_class_t version */
+    H5Z_FILTER_HELPER_FAIL,     /* Filter id number */
+    1, 1,                       /* Encoding and decoding enabled */
+    "helper_fail",              /* Filter name for debugging */
+    NULL,                       /* The "can apply" callback */
+    NULL,                       /* The "set local" callback */
+    filter_helper_fail,         /* The actual filter function */
+}};
+
+/*-------------------------------------------------------------------------
+ * Function: filter_threads_error_cb
+ *
+ * Purpose: H5Ewalk2 callback which counts the errors a failing filter
+ *          pipeline reports.
+ *
+ * Return:  0
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+filter_threads_error_cb(unsigned H5_ATTR_UNUSED n, const H5E_error2_t *err_desc, void *_counts)
+{
+    unsigned *counts = (unsigned *)_counts;
+
+    if(err_desc->desc && !HDstrcmp(err_desc->desc, "filter returned failure"))
+        counts[0]++;
+    if(err_desc->desc && !HDstrcmp(err_desc->desc, "filter pipeline failed"))
+        counts[1]++;
+
+    return 0;
+} /* end filter_threads_error_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_filter_threads_error
+ *
+ * Purpose: Tests that a filter failing on one of the filter pipeline's
+ *          helper threads makes the write fail, and that the errors it
+ *          pushed there are reported on the calling thread's stack.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define FILTER_THREADS_ERROR_NCHUNKS    32
+#define FILTER_THREADS_ERROR_CHUNK      64
+static herr_t
+test_filter_threads_error(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dxpl = -1;      /* Dataset transfer property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       did = -1;       /* Dataset ID */
+    hsize_t     dim[1] = {FILTER_THREADS_ERROR_NCHUNKS * FILTER_THREADS_ERROR_CHUNK};
+    hsize_t     cdim[1] = {FILTER_THREADS_ERROR_CHUNK};
+    int         wbuf[FILTER_THREADS_ERROR_NCHUNKS * FILTER_THREADS_ERROR_CHUNK];
+    int         rbuf[FILTER_THREADS_ERROR_NCHUNKS * FILTER_THREADS_ERROR_CHUNK];
+    unsigned    counts[2] = {0, 0}; /* Errors found on the stack */
+    herr_t      ret;            /* Generic return value */
+    size_t      u;              /* Local index variable */
+
+    TESTING("filter failing on a filter pipeline thread");
+
+    h5_fixname(FILENAME[26], fapl, filename, sizeof filename);
+
+    for(u = 0; u < FILTER_THREADS_ERROR_NCHUNKS * FILTER_THREADS_ERROR_CHUNK; u++)
+        wbuf[u] = (int)u;
+    filter_helper_fail_thread_g = pthread_self();
+    if(H5Zregister(H5Z_HELPER_FAIL) < 0)
+        TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    if((sid = H5Screate_simple(1, dim, NULL)) < 0)
+        TEST_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR
+    if(H5Pset_chunk(dcpl, 1, cdim) < 0)
+        TEST_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_HELPER_FAIL, 0, (size_t)0, NULL) < 0)
+        TEST_ERROR
+    if((did = H5Dcreate2(fid, DSET_CHUNKED_NAME, H5T_NATIVE_INT, sid,
+            H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        TEST_ERROR
+
+    /* Writing with several threads fails on the helper threads */
+    if(H5Pset_filter_threads(dxpl, 4) < 0)
+        TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("    write didn't fail on the helper threads")
+    if(H5Ewalk2(H5E_DEFAULT, H5E_WALK_UPWARD, filter_threads_error_cb, counts) < 0)
+        TEST_ERROR
+    if(counts[0] == 0)
+        FAIL_PUTS_ERROR("    helper thread's error wasn't reported")
+    if(counts[1] != 1)
+        FAIL_PUTS_ERROR("    filter pipeline failure wasn't reported once")
+
+    /* The dataset can still be written on this thread alone */
+    if(H5Pset_filter_threads(dxpl, 1) < 0)
+        TEST_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf) < 0)
+        TEST_ERROR
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+        TEST_ERROR
+    if(HDmemcmp(rbuf, wbuf, sizeof(wbuf)))
+        FAIL_PUTS_ERROR("    wrong data read")
+
+    if(H5Dclose(did) < 0)
+        TEST_ERROR
+    if(H5Pclose(dxpl) < 0)
+        TEST_ERROR
+    if(H5Pclose(dcpl) < 0)
+        TEST_ERROR
+    if(H5Sclose(sid) < 0)
+        TEST_ERROR
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR
+    if(H5Zunregister(H5Z_FILTER_HELPER_FAIL) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Pclose(dxpl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+        H5Zunregister(H5Z_FILTER_HELPER_FAIL);
+    } H5E_END_TRY;
+    return -1;
+} /* test_filter_threads_error */
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_info
+ *
+ * Purpose: Tests querying a dataset's chunks in bulk, with
+ *          H5Dget_num_chunks, H5Dget_chunk_info and H5Dchunk_iter, on
+ *          each kind of chunk index the file format allows, including
+ *          a chunk which is still dirty in the chunk cache.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define CHUNK_INFO_DIM0         20
+#define CHUNK_INFO_DIM1         30
+#define CHUNK_INFO_CDIM0        5
+#define CHUNK_INFO_CDIM1        10
+#define CHUNK_INFO_MAX_CHUNKS   ((CHUNK_INFO_DIM0 / CHUNK_INFO_CDIM0) * (CHUNK_INFO_DIM1 / CHUNK_INFO_CDIM1))
+
+/* Chunks seen by the chunk iteration callback */
+typedef struct chunk_info_iter_t {
+    unsigned    nchunks;                        /* # of chunks seen */
+    unsigned    stop_after;                     /* Stop after this many chunks (0 to visit all) */
+    int         fail;                           /* Whether to fail on the first chunk */
+    hsize_t     offset[CHUNK_INFO_MAX_CHUNKS][2];   /* Offsets of the chunks */
+    unsigned    filter_mask[CHUNK_INFO_MAX_CHUNKS]; /* Filter masks of the chunks */
+    haddr_t     addr[CHUNK_INFO_MAX_CHUNKS];    /* Addresses of the chunks */
+    hsize_t     size[CHUNK_INFO_MAX_CHUNKS];    /* Sizes of the chunks */
+} chunk_info_iter_t;
+
+static int
+chunk_info_iter_cb(const hsize_t *offset, unsigned filter_mask, haddr_t addr,
+    hsize_t size, void *op_data)
+{
+    chunk_info_iter_t *iter = (chunk_info_iter_t *)op_data;
+
+    if(iter->fail)
+        return -1;
+    if(iter->nchunks >= CHUNK_INFO_MAX_CHUNKS)
+        return -1;
+
+    iter->offset[iter->nchunks][0] = offset[0];
+    iter->offset[iter->nchunks][1] = offset[1];
+    iter->filter_mask[iter->nchunks] = filter_mask;
+    iter->addr[iter->nchunks] = addr;
+    iter->size[iter->nchunks] = size;
+    iter->nchunks++;
+
+    return (iter->stop_after && iter->nchunks == iter->stop_after) ? 1 : 0;
+} /* chunk_info_iter_cb() */
+
+static herr_t
+test_chunk_info(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       msid = -1;      /* Memory dataspace ID */
+    hid_t       did = -1;       /* Dataset ID */
+    hsize_t     dim[2] = {CHUNK_INFO_DIM0, CHUNK_INFO_DIM1};    /* Dataset dimensions */
+    hsize_t     max_dim[2];     /* Dataset maximum dimensions */
+    hsize_t     cdim[2] = {CHUNK_INFO_CDIM0, CHUNK_INFO_CDIM1}; /* Chunk dimensions */
+    hsize_t     start[2];       /* Start of hyperslab */
+    hsize_t     count[2];       /* Size of hyperslab */
+    hsize_t     coord[3][2] = {{0, 0}, {6, 15}, {6, 5}};        /* Points selected */
+    hsize_t     nchunks;        /* # of chunks */
+    hsize_t     offset[2];      /* Chunk offset */
+    hsize_t     size;           /* Chunk size */
+    hsize_t     storage_size;   /* Chunk size from H5Dget_chunk_storage_size */
+    haddr_t     addr;           /* Chunk address */
+    unsigned    filter_mask;    /* Chunk filter mask */
+    chunk_info_iter_t *iter = NULL;     /* Chunks seen by the iteration callback */
+    int         buf[CHUNK_INFO_CDIM0 * CHUNK_INFO_CDIM1];   /* Data for one chunk */
+    int         ndset;          /* Which dataset */
+    unsigned    nwritten;       /* # of chunks written */
+    unsigned    u, v, w;        /* Local index variables */
+    herr_t      ret;            /* Generic return value */
+
+    TESTING("querying chunks in bulk");
+
+    h5_fixname(FILENAME[27], fapl, filename, sizeof filename);
+
+    if(NULL == (iter = (chunk_info_iter_t *)HDcalloc((size_t)1, sizeof(chunk_info_iter_t))))
+        TEST_ERROR
+    for(u = 0; u < CHUNK_INFO_CDIM0 * CHUNK_INFO_CDIM1; u++)
+        buf[u] = (int)u;
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    if((msid = H5Screate_simple(2, cdim, NULL)) < 0)
+        TEST_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR
+    if(H5Pset_chunk(dcpl, 2, cdim) < 0)
+        TEST_ERROR
+    if(H5Pset_shuffle(dcpl) < 0)
+        TEST_ERROR
+    if(H5Pset_fletcher32(dcpl) < 0)
+        TEST_ERROR
+
+    /* Fixed size (fixed array index) and extendible (extensible array
+     * index) datasets, each with a checkerboard of chunks written */
+    for(ndset = 0; ndset < 2; ndset++) {
+        char dset_name[16];
+
+        max_dim[0] = ndset ? H5S_UNLIMITED : CHUNK_INFO_DIM0;
+        max_dim[1] = CHUNK_INFO_DIM1;
+        if((sid = H5Screate_simple(2, dim, max_dim)) < 0)
+            TEST_ERROR
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%d", ndset);
+        if((did = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            TEST_ERROR
+
+        /* Nothing is stored yet */
+        if(H5Dget_num_chunks(did, H5S_ALL, &nchunks) < 0)
+            TEST_ERROR
+        if(nchunks != 0)
+            TEST_ERROR
+        H5E_BEGIN_TRY {
+            ret = H5Dget_chunk_info(did, H5S_ALL, (hsize_t)0, offset, &filter_mask, &addr, &size);
+        } H5E_END_TRY;
+        if(ret >= 0)
+            TEST_ERROR
+
+        /* Write every other chunk, leaving the last one in the chunk cache */
+        nwritten = 0;
+        for(u = 0; u < CHUNK_INFO_DIM0 / CHUNK_INFO_CDIM0; u++)
+            for(v = 0; v < CHUNK_INFO_DIM1 / CHUNK_INFO_CDIM1; v++)
+                if((u + v) % 2 == 0) {
+                    start[0] = u * CHUNK_INFO_CDIM0;
+                    start[1] = v * CHUNK_INFO_CDIM1;
+                    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, cdim, NULL) < 0)
+                        TEST_ERROR
+                    if(H5Dwrite(did, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, buf) < 0)
+                        TEST_ERROR
+                    nwritten++;
+                } /* end if */
+
+        if(H5Dget_num_chunks(did, H5S_ALL, &nchunks) < 0)
+            TEST_ERROR
+        if(nchunks != nwritten)
+            TEST_ERROR
+
+        /* Visit the chunks in one pass and check them against the other
+         * query routines */
+        HDmemset(iter, 0, sizeof(chunk_info_iter_t));
+        if(H5Dchunk_iter(did, H5P_DEFAULT, chunk_info_iter_cb, iter) != 0)
+            TEST_ERROR
+        if(iter->nchunks != nwritten)
+            TEST_ERROR
+        for(u = 0; u < iter->nchunks; u++) {
+            if(iter->offset[u][0] % CHUNK_INFO_CDIM0 || iter->offset[u][1] % CHUNK_INFO_CDIM1)
+                TEST_ERROR
+            if(((iter->offset[u][0] / CHUNK_INFO_CDIM0) + (iter->offset[u][1] / CHUNK_INFO_CDIM1)) % 2)
+                TEST_ERROR
+            if(iter->filter_mask[u] != 0 || !H5F_addr_defined(iter->addr[u]))
+                TEST_ERROR
+            if(H5Dget_chunk_storage_size(did, iter->offset[u], &storage_size) < 0)
+                TEST_ERROR
+            if(iter->size[u] != storage_size)
+                TEST_ERROR
+            for(w = 0; w < u; w++)
+                if(iter->addr[w] == iter->addr[u])
+                    TEST_ERROR
+
+            if(H5Dget_chunk_info(did, H5S_ALL, (hsize_t)u, offset, &filter_mask, &addr, &size) < 0)
+                TEST_ERROR
+            if(offset[0] != iter->offset[u][0] || offset[1] != iter->offset[u][1]
+                    || filter_mask != iter->filter_mask[u] || addr != iter->addr[u]
+                    || size != iter->size[u])
+                TEST_ERROR
+        } /* end for */
+        H5E_BEGIN_TRY {
+            ret = H5Dget_chunk_info(did, H5S_ALL, (hsize_t)nwritten, offset, &filter_mask, &addr, &size);
+        } H5E_END_TRY;
+        if(ret >= 0)
+            TEST_ERROR
+
+        /* Only count the chunks in the first row of chunks */
+        start[0] = 0;
+        start[1] = 0;
+        count[0] = CHUNK_INFO_CDIM0;
+        count[1] = CHUNK_INFO_DIM1;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+            TEST_ERROR
+        if(H5Dget_num_chunks(did, sid, &nchunks) < 0)
+            TEST_ERROR
+        if(nchunks != 2)
+            TEST_ERROR
+        if(H5Dget_chunk_info(did, sid, (hsize_t)1, offset, NULL, NULL, NULL) < 0)
+            TEST_ERROR
+        if(offset[0] != 0 || offset[1] != 2 * CHUNK_INFO_CDIM1)
+            TEST_ERROR
+
+        /* Only count the chunks with points selected, one of which
+         * isn't stored */
+        if(H5Sselect_elements(sid, H5S_SELECT_SET, (size_t)3, (const hsize_t *)coord) < 0)
+            TEST_ERROR
+        if(H5Dget_num_chunks(did, sid, &nchunks) < 0)
+            TEST_ERROR
+        if(nchunks != 2)
+            TEST_ERROR
+
+        if(H5Sselect_none(sid) < 0)
+            TEST_ERROR
+        if(H5Dget_num_chunks(did, sid, &nchunks) < 0)
+            TEST_ERROR
+        if(nchunks != 0)
+            TEST_ERROR
+
+        /* Stop the iteration early */
+        HDmemset(iter, 0, sizeof(chunk_info_iter_t));
+        iter->stop_after = 2;
+        if(H5Dchunk_iter(did, H5P_DEFAULT, chunk_info_iter_cb, iter) != 1)
+            TEST_ERROR
+        if(iter->nchunks != 2)
+            TEST_ERROR
+
+        /* Fail the iteration */
+        HDmemset(iter, 0, sizeof(chunk_info_iter_t));
+        iter->fail = 1;
+        H5E_BEGIN_TRY {
+            ret = H5Dchunk_iter(did, H5P_DEFAULT, chunk_info_iter_cb, iter);
+        } H5E_END_TRY;
+        if(ret >= 0)
+            TEST_ERROR
+
+        if(H5Dclose(did) < 0)
+            TEST_ERROR
+        if(H5Sclose(sid) < 0)
+            TEST_ERROR
+    } /* end for */
+
+    /* A dataset which is a single chunk */
+    if((sid = H5Screate_simple(2, cdim, NULL)) < 0)
+        TEST_ERROR
+    if((did = H5Dcreate2(fid, "single", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+        TEST_ERROR
+    HDmemset(iter, 0, sizeof(chunk_info_iter_t));
+    if(H5Dchunk_iter(did, H5P_DEFAULT, chunk_info_iter_cb, iter) < 0)
+        TEST_ERROR
+    if(iter->nchunks != 1 || iter->offset[0][0] != 0 || iter->offset[0][1] != 0)
+        TEST_ERROR
+    if(H5Dget_chunk_storage_size(did, iter->offset[0], &storage_size) < 0)
+        TEST_ERROR
+    if(iter->size[0] != storage_size)
+        TEST_ERROR
+    if(H5Dclose(did) < 0)
+        TEST_ERROR
+    if(H5Sclose(sid) < 0)
+        TEST_ERROR
+
+    /* The routines only work on chunked datasets */
+    if((sid = H5Screate_simple(2, dim, NULL)) < 0)
+        TEST_ERROR
+    if((did = H5Dcreate2(fid, "contig", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dget_num_chunks(did, H5S_ALL, &nchunks);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dchunk_iter(did, H5P_DEFAULT, chunk_info_iter_cb, iter);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        TEST_ERROR
+    if(H5Dclose(did) < 0)
+        TEST_ERROR
+    if(H5Sclose(sid) < 0)
+        TEST_ERROR
+
+    if(H5Sclose(msid) < 0)
+        TEST_ERROR
+    if(H5Pclose(dcpl) < 0)
+        TEST_ERROR
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR
+    HDfree(iter);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Sclose(msid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(iter)
+        HDfree(iter);
+    return -1;
+} /* test_chunk_info */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_multi_dset_io
+ *
+ * Purpose: Tests reading and writing several datasets in one call with
+ *          H5Dread_multi and H5Dwrite_multi, for datasets with each
+ *          storage layout, with and without datatype conversion, in
+ *          two files, and with a dataset given more than once.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define MULTI_DSET_DIM          100
+#define MULTI_DSET_NDSETS       6
+
+static herr_t
+test_multi_dset_io(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    char        filename2[FILENAME_BUF_SIZE];
+    hid_t       fid = -1, fid2 = -1;    /* File IDs */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       hs_sid = -1;    /* Dataspace ID with a hyperslab selected */
+    hid_t       msid = -1;      /* Memory dataspace ID */
+    hid_t       dids[MULTI_DSET_NDSETS];        /* Dataset IDs */
+    hid_t       mem_tids[MULTI_DSET_NDSETS];    /* Memory datatypes */
+    hid_t       mem_sids[MULTI_DSET_NDSETS];    /* Memory dataspaces */
+    hid_t       file_sids[MULTI_DSET_NDSETS];   /* File dataspaces */
+    const void *wbufs[MULTI_DSET_NDSETS];       /* Buffers to write */
+    void       *rbufs[MULTI_DSET_NDSETS];       /* Buffers to read */
+    hsize_t     dim = MULTI_DSET_DIM;           /* Dataset dimensions */
+    hsize_t     cdim = 10;      /* Chunk dimensions */
+    hsize_t     start = 10;     /* Start of hyperslab */
+    hsize_t     count = 10;     /* Size of hyperslab */
+    int         wdata[MULTI_DSET_NDSETS][MULTI_DSET_DIM];   /* Data to write */
+    int         rdata[MULTI_DSET_NDSETS][MULTI_DSET_DIM];   /* Data read */
+    int         expect[MULTI_DSET_NDSETS][MULTI_DSET_DIM];  /* Data expected */
+    short       wshort[MULTI_DSET_DIM];         /* Data to write with conversion */
+    short       rshort[MULTI_DSET_DIM];         /* Data read with conversion */
+    int         i, j;           /* Local index variables */
+    herr_t      ret;            /* Generic return value */
+
+    TESTING("reading and writing several datasets at once");
+
+    h5_fixname(FILENAME[28], fapl, filename, sizeof filename);
+    h5_fixname(FILENAME[29], fapl, filename2, sizeof filename2);
+
+    for(i = 0; i < MULTI_DSET_NDSETS; i++)
+        dids[i] = -1;
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((fid2 = H5Fcreate(filename2, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((hs_sid = H5Scopy(sid)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sselect_hyperslab(hs_sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0)
+        FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &count, NULL)) < 0)
+        FAIL_STACK_ERROR
+
+    /* Two contiguous datasets, a chunked one and a compact one in the
+     * first file, and a contiguous one in the second file */
+    if((dids[0] = H5Dcreate2(fid, "contig1", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if((dids[1] = H5Dcreate2(fid, "contig2", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &cdim) < 0)
+        FAIL_STACK_ERROR
+    if((dids[2] = H5Dcreate2(fid, "chunked", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_layout(dcpl, H5D_COMPACT) < 0)
+        FAIL_STACK_ERROR
+    if((dids[3] = H5Dcreate2(fid, "compact", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if((dids[4] = H5Dcreate2(fid2, "contig", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+
+    /* Write all the datasets in one call.  The second file's dataset is
+     * written from shorts, and the first dataset is given again, to
+     * overwrite part of what its first entry writes. */
+    for(i = 0; i < MULTI_DSET_NDSETS; i++) {
+        for(j = 0; j < MULTI_DSET_DIM; j++) {
+            wdata[i][j] = (i + 1) * 1000 + j;
+            expect[i][j] = wdata[i][j];
+        } /* end for */
+        mem_tids[i] = H5T_NATIVE_INT;
+        mem_sids[i] = H5S_ALL;
+        file_sids[i] = H5S_ALL;
+        wbufs[i] = wdata[i];
+    } /* end for */
+    for(j = 0; j < MULTI_DSET_DIM; j++) {
+        wshort[j] = (short)(-j);
+        expect[4][j] = -j;
+    } /* end for */
+    mem_tids[4] = H5T_NATIVE_SHORT;
+    wbufs[4] = wshort;
+    dids[5] = dids[0];
+    mem_sids[5] = msid;
+    file_sids[5] = hs_sid;
+    for(j = 0; j < (int)count; j++)
+        expect[0][start + (hsize_t)j] = wdata[5][j];
+
+    if(H5Dwrite_multi((size_t)MULTI_DSET_NDSETS, dids, mem_tids, mem_sids, file_sids, H5P_DEFAULT, wbufs) < 0)
+        FAIL_STACK_ERROR
+
+    /* Check the data with H5Dread */
+    for(i = 0; i < MULTI_DSET_NDSETS - 1; i++) {
+        HDmemset(rdata[i], 0, sizeof(rdata[i]));
+        if(H5Dread(dids[i], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata[i]) < 0)
+            FAIL_STACK_ERROR
+        for(j = 0; j < MULTI_DSET_DIM; j++)
+            if(rdata[i][j] != expect[i][j]) {
+                HDprintf("    dataset %d, element %d: read %d, expected %d\n", i, j, rdata[i][j], expect[i][j]);
+                TEST_ERROR
+            } /* end if */
+    } /* end for */
+
+    /* Read them back in one call, the second file's dataset into shorts
+     * and part of the first dataset again */
+    HDmemset(rdata, 0, sizeof(rdata));
+    HDmemset(rshort, 0, sizeof(rshort));
+    for(i = 0; i < MULTI_DSET_NDSETS; i++)
+        rbufs[i] = rdata[i];
+    rbufs[4] = rshort;
+    if(H5Dread_multi((size_t)MULTI_DSET_NDSETS, dids, mem_tids, mem_sids, file_sids, H5P_DEFAULT, rbufs) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < MULTI_DSET_NDSETS - 1; i++)
+        for(j = 0; j < MULTI_DSET_DIM; j++)
+            if((4 == i ? (int)rshort[j] : rdata[i][j]) != expect[i][j])
+                TEST_ERROR
+    for(j = 0; j < (int)count; j++)
+        if(rdata[5][j] != expect[0][start + (hsize_t)j])
+            TEST_ERROR
+
+    /* Selections with different numbers of elements should fail */
+    mem_sids[0] = msid;
+    H5E_BEGIN_TRY {
+        ret = H5Dwrite_multi((size_t)MULTI_DSET_NDSETS, dids, mem_tids, mem_sids, file_sids, H5P_DEFAULT, wbufs);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        TEST_ERROR
+
+    /* So should an invalid dataset ID */
+    mem_sids[0] = H5S_ALL;
+    dids[5] = sid;
+    H5E_BEGIN_TRY {
+        ret = H5Dread_multi((size_t)MULTI_DSET_NDSETS, dids, mem_tids, mem_sids, file_sids, H5P_DEFAULT, rbufs);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        TEST_ERROR
+
+    for(i = 0; i < MULTI_DSET_NDSETS - 1; i++)
+        if(H5Dclose(dids[i]) < 0)
+            FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(hs_sid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Fclose(fid2) < 0)
+        FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        for(i = 0; i < MULTI_DSET_NDSETS - 1; i++)
+            H5Dclose(dids[i]);
+        H5Pclose(dcpl);
+        H5Sclose(msid);
+        H5Sclose(hs_sid);
+        H5Sclose(sid);
+        H5Fclose(fid2);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_multi_dset_io */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_pool
+ *
+ * Purpose: Tests that chunks whose hash values collide stay in the chunk
+ *          cache together, and that the chunk caches of a file's datasets
+ *          share the byte budget set with H5Pset_chunk_cache_pool,
+ *          preempting the least recently used chunks of any dataset.
+ *          Counts the bytes passing through a filter to tell which
+ *          chunks are read from the file.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define POOL_DIM        40
+#define POOL_CHUNK_DIM  10
+#define POOL_CHUNK_SIZE (POOL_CHUNK_DIM * sizeof(int))
+
+/* Reads chunk CHUNK of dataset DID, checking its values */
+static herr_t
+test_chunk_cache_pool_read(hid_t did, hsize_t chunk, int dset_no)
+{
+    hid_t       fsid = -1, msid = -1;   /* Dataspace IDs */
+    hsize_t     start = chunk * POOL_CHUNK_DIM;
+    hsize_t     count = POOL_CHUNK_DIM;
+    int         rbuf[POOL_CHUNK_DIM];
+    int         i;
+
+    if((fsid = H5Dget_space(did)) < 0)
+        goto error;
+    if(H5Sselect_hyperslab(fsid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0)
+        goto error;
+    if((msid = H5Screate_simple(1, &count, NULL)) < 0)
+        goto error;
+    if(H5Dread(did, H5T_NATIVE_INT, msid, fsid, H5P_DEFAULT, rbuf) < 0)
+        goto error;
+    for(i = 0; i < POOL_CHUNK_DIM; i++)
+        if(rbuf[i] != dset_no * 1000 + (int)start + i)
+            goto error;
+    if(H5Sclose(msid) < 0 || H5Sclose(fsid) < 0)
+        goto error;
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Sclose(msid);
+        H5Sclose(fsid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_cache_pool_read */
+
+static herr_t
+test_chunk_cache_pool(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fapl_pool = -1;         /* File access property list with a shared budget */
+    hid_t       fapl2 = -1;             /* File access property list retrieved */
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       dids[2] = {-1, -1};     /* Dataset IDs */
+    hid_t       did2 = -1;              /* Second handle for the first dataset */
+    hsize_t     dim = POOL_DIM;         /* Dataset dimensions */
+    hsize_t     cdim = POOL_CHUNK_DIM;  /* Chunk dimensions */
+    int         wbuf[POOL_DIM];         /* Write buffer */
+    size_t      nbytes;                 /* Size of shared budget */
+    int         i, j;                   /* Local index variables */
+
+    TESTING("sharing the chunk cache budget of a file");
+
+    h5_fixname(FILENAME[30], fapl, filename, sizeof filename);
+
+    /* Register byte-counting filter */
+    if(H5Zregister(H5Z_COUNT) < 0)
+        TEST_ERROR
+
+    /* Room for two chunks, across all datasets (the chunk caches
+     * themselves are turned on again, with room for many more) */
+    if((fapl_pool = H5Pcopy(fapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_pool(fapl_pool, &nbytes) < 0)
+        FAIL_STACK_ERROR
+    if(nbytes != 0)
+        TEST_ERROR
+    if(H5Pset_chunk_cache_pool(fapl_pool, 2 * POOL_CHUNK_SIZE + POOL_CHUNK_SIZE / 2) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_cache(fapl_pool, 0, (size_t)521, (size_t)(1024 * 1024), 0.75F) < 0)
+        FAIL_STACK_ERROR
+
+    /* Create two filtered, chunked datasets, written with their chunk
+     * caches sharing the budget */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_pool)) < 0)
+        FAIL_STACK_ERROR
+    if((fapl2 = H5Fget_access_plist(fid)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_pool(fapl2, &nbytes) < 0)
+        FAIL_STACK_ERROR
+    if(nbytes != 2 * POOL_CHUNK_SIZE + POOL_CHUNK_SIZE / 2)
+        TEST_ERROR
+    if(H5Pclose(fapl2) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &cdim) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0u, (size_t)0, NULL) < 0)
+        FAIL_STACK_ERROR
+    for(j = 0; j < 2; j++) {
+        if((dids[j] = H5Dcreate2(fid, (j ? "pool2" : "pool1"), H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        for(i = 0; i < POOL_DIM; i++)
+            wbuf[i] = (j + 1) * 1000 + i;
+        if(H5Dwrite(dids[j], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    for(j = 0; j < 2; j++)
+        if(H5Dclose(dids[j]) < 0)
+            FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+
+    /* With a single hash table slot, two chunks read twice are each read
+     * from the file once */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)1, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((dids[0] = H5Dopen2(fid, "pool1", dapl)) < 0)
+        FAIL_STACK_ERROR
+    count_nbytes_read = (size_t)0;
+    for(i = 0; i < 2; i++) {
+        if(test_chunk_cache_pool_read(dids[0], (hsize_t)0, 1) < 0)
+            TEST_ERROR
+        if(test_chunk_cache_pool_read(dids[0], (hsize_t)1, 1) < 0)
+            TEST_ERROR
+    } /* end for */
+    if(count_nbytes_read != 2 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+    if(H5Dclose(dids[0]) < 0)
+        FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+
+    /* With the shared budget, the two datasets' caches hold two chunks
+     * together, and the least recently used one is preempted */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl_pool)) < 0)
+        FAIL_STACK_ERROR
+    for(j = 0; j < 2; j++)
+        if((dids[j] = H5Dopen2(fid, (j ? "pool2" : "pool1"), H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+    count_nbytes_read = (size_t)0;
+    if(test_chunk_cache_pool_read(dids[0], (hsize_t)0, 1) < 0)
+        TEST_ERROR
+    if(test_chunk_cache_pool_read(dids[0], (hsize_t)1, 1) < 0)
+        TEST_ERROR
+    if(test_chunk_cache_pool_read(dids[1], (hsize_t)0, 2) < 0)
+        TEST_ERROR
+    if(count_nbytes_read != 3 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+
+    /* The first dataset's second chunk is still cached, its first isn't */
+    if(test_chunk_cache_pool_read(dids[0], (hsize_t)1, 1) < 0)
+        TEST_ERROR
+    if(count_nbytes_read != 3 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+    if(test_chunk_cache_pool_read(dids[0], (hsize_t)0, 1) < 0)
+        TEST_ERROR
+    if(count_nbytes_read != 4 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+
+    /* Closing the handle the shared budget flushes a dataset's chunks
+     * through writes them out, leaving the dataset usable through its
+     * other handle */
+    if((did2 = H5Dopen2(fid, "pool1", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(test_chunk_cache_pool_read(did2, (hsize_t)2, 1) < 0)
+        TEST_ERROR
+    if(count_nbytes_read != 5 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+    if(H5Dclose(did2) < 0)
+        FAIL_STACK_ERROR
+    if(test_chunk_cache_pool_read(dids[0], (hsize_t)2, 1) < 0)
+        TEST_ERROR
+    if(count_nbytes_read != 6 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+    for(i = 0; i < POOL_DIM / POOL_CHUNK_DIM; i++) {
+        if(test_chunk_cache_pool_read(dids[1], (hsize_t)i, 2) < 0)
+            TEST_ERROR
+        if(test_chunk_cache_pool_read(dids[0], (hsize_t)i, 1) < 0)
+            TEST_ERROR
+    } /* end for */
+
+    for(j = 0; j < 2; j++)
+        if(H5Dclose(dids[j]) < 0)
+            FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(fapl_pool) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did2);
+        H5Dclose(dids[0]);
+        H5Dclose(dids[1]);
+        H5Fclose(fid);
+        H5Pclose(fapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Pclose(fapl_pool);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_cache_pool */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_read_ahead
+ *
+ * Purpose: Tests that reading a dataset's chunks one at a time along a
+ *          stride, forwards or backwards, reads the chunks ahead of the
+ *          scan into the chunk cache, up to the number set with
+ *          H5Pset_chunk_read_ahead and the end of the dataset.  Counts
+ *          the bytes passing through a filter to tell which chunks are
+ *          read from the file.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define READ_AHEAD_NCHUNKS      10
+
+static herr_t
+test_chunk_read_ahead(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dapl2 = -1;             /* Dataset access property list retrieved */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim = READ_AHEAD_NCHUNKS * POOL_CHUNK_DIM;  /* Dataset dimensions */
+    hsize_t     cdim = POOL_CHUNK_DIM;  /* Chunk dimensions */
+    int         wbuf[READ_AHEAD_NCHUNKS * POOL_CHUNK_DIM];  /* Write buffer */
+    unsigned    nchunks;                /* # of chunks to read ahead */
+    /* # of chunks read from the file after reading each chunk in order */
+    const size_t fwd_nread[READ_AHEAD_NCHUNKS] = {1, 2, 6, 6, 6, 9, 9, 9, 10, 10};
+    /* Chunks read backwards every other chunk, and # of chunks read after each */
+    const hsize_t bwd_chunks[5] = {9, 7, 5, 3, 1};
+    const size_t bwd_nread[5] = {1, 2, 5, 5, 5};
+    int         i;                      /* Local index variable */
+
+    TESTING("reading chunks ahead of sequential access");
+
+    h5_fixname(FILENAME[31], fapl, filename, sizeof filename);
+
+    /* Register byte-counting filter */
+    if(H5Zregister(H5Z_COUNT) < 0)
+        TEST_ERROR
+
+    /* Set up a chunk cache which reads up to 3 chunks ahead */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_ahead(dapl, &nchunks) < 0)
+        FAIL_STACK_ERROR
+    if(nchunks != 0)
+        TEST_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_read_ahead(dapl, 3u) < 0)
+        FAIL_STACK_ERROR
+
+    /* Create a filtered, chunked dataset */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &cdim) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0u, (size_t)0, NULL) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "read_ahead", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < (int)dim; i++)
+        wbuf[i] = 1000 + i;
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+    /* Read the chunks in order.  The third chunk read shows the pattern
+     * and reads the next three, and so on up to the end of the dataset */
+    if((did = H5Dopen2(fid, "read_ahead", dapl)) < 0)
+        FAIL_STACK_ERROR
+    if((dapl2 = H5Dget_access_plist(did)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_ahead(dapl2, &nchunks) < 0)
+        FAIL_STACK_ERROR
+    if(nchunks != 3)
+        TEST_ERROR
+    if(H5Pclose(dapl2) < 0)
+        FAIL_STACK_ERROR
+    count_nbytes_read = (size_t)0;
+    for(i = 0; i < READ_AHEAD_NCHUNKS; i++) {
+        if(test_chunk_cache_pool_read(did, (hsize_t)i, 1) < 0)
+            TEST_ERROR
+        if(count_nbytes_read != fwd_nread[i] * POOL_CHUNK_SIZE)
+            TEST_ERROR
+    } /* end for */
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+    /* Read every other chunk backwards, which reads ahead as far as the
+     * start of the dataset */
+    if((did = H5Dopen2(fid, "read_ahead", dapl)) < 0)
+        FAIL_STACK_ERROR
+    count_nbytes_read = (size_t)0;
+    for(i = 0; i < 5; i++) {
+        if(test_chunk_cache_pool_read(did, bwd_chunks[i], 1) < 0)
+            TEST_ERROR
+        if(count_nbytes_read != bwd_nread[i] * POOL_CHUNK_SIZE)
+            TEST_ERROR
+    } /* end for */
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Fclose(fid);
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_read_ahead */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_flush_batch
+ *
+ * Purpose: Tests that the dirty chunks in the chunk cache are written
+ *          out together, in chunk index order: chunks written backwards
+ *          (in two halves each, so they go through the cache) are laid
+ *          out forwards in the file, with or without filters.  Also
+ *          checks the data written with a cache which has to preempt
+ *          dirty chunks.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define FLUSH_BATCH_NCHUNKS     10
+
+static herr_t
+test_chunk_flush_batch(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim = FLUSH_BATCH_NCHUNKS * POOL_CHUNK_DIM;  /* Dataset dimensions */
+    hsize_t     cdim = POOL_CHUNK_DIM;  /* Chunk dimensions */
+    hsize_t     start;                  /* Start of the half chunk written */
+    hsize_t     count = POOL_CHUNK_DIM / 2;     /* Size of a half chunk */
+    hsize_t     offset;                 /* Offset of a chunk */
+    haddr_t     addrs[FLUSH_BATCH_NCHUNKS];     /* Addresses of the chunks */
+    hsize_t     nchunks;                /* # of chunks written */
+    int         wbuf[POOL_CHUNK_DIM / 2];       /* Write buffer */
+    const char  *dset_names[2] = {"unfiltered", "filtered"};
+    int         i, j, n;                /* Local index variables */
+
+    TESTING("writing out dirty chunks together");
+
+    h5_fixname(FILENAME[32], fapl, filename, sizeof filename);
+
+    /* Register byte-counting filter */
+    if(H5Zregister(H5Z_COUNT) < 0)
+        TEST_ERROR
+
+    /* Set up a chunk cache which holds all the chunks */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &count, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &cdim) < 0)
+        FAIL_STACK_ERROR
+
+    for(n = 0; n < 2; n++) {
+        /* The second dataset is filtered */
+        if(n == 1 && H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0u, (size_t)0, NULL) < 0)
+            FAIL_STACK_ERROR
+        if((did = H5Dcreate2(fid, dset_names[n], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+
+        /* Write the chunks backwards, in halves */
+        for(i = FLUSH_BATCH_NCHUNKS * 2 - 1; i >= 0; i--) {
+            start = (hsize_t)i * count;
+            for(j = 0; j < (int)count; j++)
+                wbuf[j] = 1000 + (int)start + j;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0)
+                FAIL_STACK_ERROR
+            if(H5Dwrite(did, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf) < 0)
+                FAIL_STACK_ERROR
+        } /* end for */
+        if(H5Sselect_all(sid) < 0)
+            FAIL_STACK_ERROR
+
+        /* Write the chunks out */
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+
+        /* The chunks are laid out in the file in chunk index order */
+        if((did = H5Dopen2(fid, dset_names[n], H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dget_num_chunks(did, H5S_ALL, &nchunks) < 0)
+            FAIL_STACK_ERROR
+        if(nchunks != FLUSH_BATCH_NCHUNKS)
+            TEST_ERROR
+        for(i = 0; i < FLUSH_BATCH_NCHUNKS; i++) {
+            haddr_t addr;
+
+            if(H5Dget_chunk_info(did, H5S_ALL, (hsize_t)i, &offset, NULL, &addr, NULL) < 0)
+                FAIL_STACK_ERROR
+            addrs[offset / POOL_CHUNK_DIM] = addr;
+        } /* end for */
+        for(i = 1; i < FLUSH_BATCH_NCHUNKS; i++)
+            if(addrs[i] <= addrs[i - 1])
+                TEST_ERROR
+        for(i = 0; i < FLUSH_BATCH_NCHUNKS; i++)
+            if(test_chunk_cache_pool_read(did, (hsize_t)i, 1) < 0)
+                TEST_ERROR
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Overwrite the filtered chunks through a cache which holds 3 chunks */
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(3 * POOL_CHUNK_SIZE), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dopen2(fid, dset_names[1], dapl)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < FLUSH_BATCH_NCHUNKS * 2; i++) {
+        start = (hsize_t)i * count;
+        for(j = 0; j < (int)count; j++)
+            wbuf[j] = 2000 + (int)start + j;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dopen2(fid, dset_names[1], H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < FLUSH_BATCH_NCHUNKS; i++)
+        if(test_chunk_cache_pool_read(did, (hsize_t)i, 2) < 0)
+            TEST_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Fclose(fid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(msid);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_flush_batch */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_index_bulk_check
+ *
+ * Purpose: Helper for test_chunk_index_bulk: checks that a dataset with
+ *          NROWS rows has every chunk allocated, and the data written
+ *          by test_chunk_index_bulk.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define BULK_DIM0       128
+#define BULK_DIM1       128
+#define BULK_CDIM1      2
+#define BULK_NCHUNKS(NROWS)     ((hsize_t)(NROWS) * (BULK_DIM1 / BULK_CDIM1))
+
+static herr_t
+test_chunk_index_bulk_check(hid_t did, int nrows, int *rbuf)
+{
+    hid_t       sid = -1;               /* Dataspace ID */
+    hsize_t     dims[2];                /* Dataset dimensions */
+    hsize_t     offset[2];              /* Offset of a chunk */
+    hsize_t     nchunks;                /* # of chunks allocated */
+    hsize_t     size;                   /* Size of a chunk */
+    int         i, j;                   /* Local index variables */
+
+    if((sid = H5Dget_space(did)) < 0)
+        TEST_ERROR
+    if(H5Sget_simple_extent_dims(sid, dims, NULL) < 0)
+        TEST_ERROR
+    if(dims[0] != (hsize_t)nrows || dims[1] != BULK_DIM1)
+        TEST_ERROR
+
+    /* Every chunk is stored */
+    if(H5Dget_num_chunks(did, sid, &nchunks) < 0)
+        TEST_ERROR
+    if(nchunks != BULK_NCHUNKS(nrows))
+        TEST_ERROR
+    for(i = 0; i < nrows; i++)
+        for(j = 0; j < BULK_DIM1; j += BULK_CDIM1) {
+            offset[0] = (hsize_t)i;
+            offset[1] = (hsize_t)j;
+            if(H5Dget_chunk_storage_size(did, offset, &size) < 0)
+                TEST_ERROR
+            if(size != BULK_CDIM1 * sizeof(int))
+                TEST_ERROR
+        } /* end for */
+
+    /* The data is all there */
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        TEST_ERROR
+    for(i = 0; i < nrows; i++)
+        for(j = 0; j < BULK_DIM1; j++)
+            if(rbuf[i * BULK_DIM1 + j] != i * BULK_DIM1 + j)
+                TEST_ERROR
+
+    if(H5Sclose(sid) < 0)
+        TEST_ERROR
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_index_bulk_check */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_index_bulk
+ *
+ * Purpose: Tests chunk indices loaded in bulk: when a dataset's chunks
+ *          are allocated early, and when a dataset's chunks are all
+ *          written out of the chunk cache at once.  With the latest
+ *          format, the datasets are indexed with v2 B-trees deep
+ *          enough to have internal nodes, which are then grown and
+ *          shrunk with H5Dset_extent.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_index_bulk(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dims[2] = {BULK_DIM0, BULK_DIM1};       /* Dataset dimensions */
+    hsize_t     max_dims[2] = {H5S_UNLIMITED, H5S_UNLIMITED};   /* Maximum dataset dimensions */
+    hsize_t     cdims[2] = {1, BULK_CDIM1};     /* Chunk dimensions */
+    H5F_libver_t low;                   /* File format low bound */
+    H5D_chunk_index_t idx_type;         /* Dataset chunk index type */
+    int         *buf = NULL;            /* Data buffer */
+    const char  *dset_names[2] = {"early", "late"};
+    int         i, n;                   /* Local index variables */
+
+    TESTING("loading chunk indices in bulk");
+
+    h5_fixname(FILENAME[33], fapl, filename, sizeof filename);
+
+    if(H5Pget_libver_bounds(fapl, &low, NULL) < 0)
+        FAIL_STACK_ERROR
+
+    if(NULL == (buf = (int *)HDmalloc((BULK_DIM0 + 2) * BULK_DIM1 * sizeof(int))))
+        TEST_ERROR
+    for(i = 0; i < (BULK_DIM0 + 2) * BULK_DIM1; i++)
+        buf[i] = i;
+
+    /* Set up a chunk cache which holds all the chunks */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)10007, (size_t)(2 * BULK_DIM0 * BULK_DIM1 * sizeof(int)), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, cdims) < 0)
+        FAIL_STACK_ERROR
+
+    for(n = 0; n < 2; n++) {
+        /* The first dataset's chunks are all allocated when it's created,
+         * the second's when they're flushed from the chunk cache */
+        if(H5Pset_alloc_time(dcpl, n == 0 ? H5D_ALLOC_TIME_EARLY : H5D_ALLOC_TIME_INCR) < 0)
+            FAIL_STACK_ERROR
+        if((did = H5Dcreate2(fid, dset_names[n], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+        if(low == H5F_LIBVER_LATEST) {
+            if(H5D__layout_idx_type_test(did, &idx_type) < 0)
+                FAIL_STACK_ERROR
+            if(idx_type != H5D_CHUNK_IDX_BT2)
+                FAIL_PUTS_ERROR("should be using v2 B-tree as index");
+        } /* end if */
+        if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+
+        /* Check the index and data */
+        if((did = H5Dopen2(fid, dset_names[n], H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(test_chunk_index_bulk_check(did, BULK_DIM0, buf) < 0)
+            TEST_ERROR
+
+        /* Insert more chunks into the index, then remove most of them */
+        dims[0] = BULK_DIM0 + 2;
+        if(H5Dset_extent(did, dims) < 0)
+            FAIL_STACK_ERROR
+        for(i = 0; i < (BULK_DIM0 + 2) * BULK_DIM1; i++)
+            buf[i] = i;
+        if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+            FAIL_STACK_ERROR
+        if(test_chunk_index_bulk_check(did, BULK_DIM0 + 2, buf) < 0)
+            TEST_ERROR
+        dims[0] = BULK_DIM0 / 4;
+        if(H5Dset_extent(did, dims) < 0)
+            FAIL_STACK_ERROR
+        if(test_chunk_index_bulk_check(did, BULK_DIM0 / 4, buf) < 0)
+            TEST_ERROR
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+
+        /* Restore the buffer and dimensions for the next dataset */
+        for(i = 0; i < (BULK_DIM0 + 2) * BULK_DIM1; i++)
+            buf[i] = i;
+        dims[0] = BULK_DIM0;
+    } /* end for */
+
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+    HDfree(buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Fclose(fid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    return -1;
+} /* test_chunk_index_bulk */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_stats
+ *
+ * Purpose: Tests H5Dget_chunk_cache_stats, with a chunk cache holding two
+ *          chunks of a filtered dataset: hits, misses, preempted clean
+ *          and dirty chunks, and the bytes read and unfiltered, which
+ *          are checked against the bytes counted by the filter.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_stats(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hid_t       did2 = -1;              /* Contiguous dataset ID */
+    hsize_t     dim = POOL_DIM;         /* Dataset dimensions */
+    hsize_t     cdim = POOL_CHUNK_DIM;  /* Chunk dimensions */
+    hsize_t     start = POOL_CHUNK_DIM; /* Selection of the second chunk */
+    hsize_t     count = POOL_CHUNK_DIM;
+    int         wbuf[POOL_DIM];         /* Write buffer */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    herr_t      ret;                    /* Generic return value */
+    int         i;                      /* Local index variable */
+
+    TESTING("chunk cache statistics");
+
+    h5_fixname(FILENAME[34], fapl, filename, sizeof filename);
+
+    /* Register byte-counting filter */
+    if(H5Zregister(H5Z_COUNT) < 0)
+        TEST_ERROR
+
+    /* Create a filtered, chunked dataset and a contiguous one */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &cdim) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0u, (size_t)0, NULL) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "stats", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < POOL_DIM; i++)
+        wbuf[i] = 1000 + i;
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+    if((did2 = H5Dcreate2(fid, "contig", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+
+    /* Only chunked datasets have statistics */
+    H5E_BEGIN_TRY {
+        ret = H5Dget_chunk_cache_stats(did2, &stats);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("getting chunk cache statistics of a contiguous dataset should fail");
+    if(H5Dclose(did2) < 0)
+        FAIL_STACK_ERROR
+
+    /* Reopen the chunked dataset with room for two and a half chunks */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, 2 * POOL_CHUNK_SIZE + POOL_CHUNK_SIZE / 2, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dopen2(fid, "stats", dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 0 || stats.misses != 0 || stats.evictions_clean != 0
+            || stats.evictions_dirty != 0 || stats.bytes_read != 0
+            || stats.bytes_decompressed != 0 || stats.filter_time != 0.0F)
+        FAIL_PUTS_ERROR("statistics of a newly opened dataset should be zero");
+
+    /* Read the first chunk twice, then the second and third, preempting
+     * the first */
+    count_nbytes_read = (size_t)0;
+    if(test_chunk_cache_pool_read(did, (hsize_t)0, 1) < 0)
+        TEST_ERROR
+    if(test_chunk_cache_pool_read(did, (hsize_t)0, 1) < 0)
+        TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 1 || stats.misses != 1 || stats.evictions_clean != 0)
+        FAIL_PUTS_ERROR("wrong hit/miss counts");
+    if(test_chunk_cache_pool_read(did, (hsize_t)1, 1) < 0)
+        TEST_ERROR
+    if(test_chunk_cache_pool_read(did, (hsize_t)2, 1) < 0)
+        TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 1 || stats.misses != 3 || stats.evictions_clean != 1
+            || stats.evictions_dirty != 0)
+        FAIL_PUTS_ERROR("wrong hit/miss/eviction counts");
+
+    /* Rewrite the second chunk, then read the fourth chunk (preempting
+     * the third) and the first (preempting the second) */
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0)
+        FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &count, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, &wbuf[POOL_CHUNK_DIM]) < 0)
+        FAIL_STACK_ERROR
+    if(test_chunk_cache_pool_read(did, (hsize_t)3, 1) < 0)
+        TEST_ERROR
+    if(test_chunk_cache_pool_read(did, (hsize_t)0, 1) < 0)
+        TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 2 || stats.misses != 5 || stats.evictions_clean != 2
+            || stats.evictions_dirty != 1)
+        FAIL_PUTS_ERROR("wrong hit/miss/eviction counts");
+
+    /* Every miss read and unfiltered a whole chunk */
+    if(count_nbytes_read != 5 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+    if(stats.bytes_read != 5 * POOL_CHUNK_SIZE || stats.bytes_decompressed != 5 * POOL_CHUNK_SIZE)
+        FAIL_PUTS_ERROR("wrong byte counts");
+    if(stats.filter_time < 0.0F)
+        FAIL_PUTS_ERROR("negative filter time");
+
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Dclose(did2);
+        H5Fclose(fid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(msid);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_cache_stats */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_auto
+ *
+ * Purpose: Tests H5Pset_chunk_cache_auto: a chunk cache too small for a
+ *          chunk is enlarged to hold one, streaming through a dataset
+ *          leaves the cache's size alone, cycling through more chunks
+ *          than it holds makes it grow until they all fit, and using
+ *          only a few of them makes it shrink again.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define AUTO_NCHUNKS    64
+#define AUTO_NCYCLED    16
+
+/* Gets the current size of the chunk cache of dataset DID */
+static herr_t
+test_chunk_cache_auto_size(hid_t did, size_t *nbytes)
+{
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+
+    if((dapl = H5Dget_access_plist(did)) < 0)
+        goto error;
+    if(H5Pget_chunk_cache(dapl, NULL, nbytes, NULL) < 0)
+        goto error;
+    if(H5Pclose(dapl) < 0)
+        goto error;
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_cache_auto_size */
+
+static herr_t
+test_chunk_cache_auto(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dapl2 = -1;             /* Dataset access property list retrieved */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim = AUTO_NCHUNKS * POOL_CHUNK_DIM;    /* Dataset dimensions */
+    hsize_t     cdim = POOL_CHUNK_DIM;  /* Chunk dimensions */
+    int         wbuf[AUTO_NCHUNKS * POOL_CHUNK_DIM];    /* Write buffer */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    hsize_t     nmisses;                /* # of cache misses */
+    size_t      nbytes;                 /* Size of chunk cache */
+    size_t      grown;                  /* Size the chunk cache grew to */
+    int         i, j;                   /* Local index variables */
+
+    TESTING("automatic chunk cache sizing");
+
+    h5_fixname(FILENAME[35], fapl, filename, sizeof filename);
+
+    /* Create a chunked dataset */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &cdim) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "auto", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < AUTO_NCHUNKS * POOL_CHUNK_DIM; i++)
+        wbuf[i] = 1000 + i;
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+    /* A cache smaller than a chunk is enlarged to hold one */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_auto(dapl, &nbytes) < 0)
+        FAIL_STACK_ERROR
+    if(nbytes != 0)
+        TEST_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, POOL_CHUNK_SIZE / 2, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache_auto(dapl, 32 * POOL_CHUNK_SIZE) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dopen2(fid, "auto", dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(test_chunk_cache_auto_size(did, &nbytes) < 0)
+        TEST_ERROR
+    if(nbytes != POOL_CHUNK_SIZE)
+        TEST_ERROR
+    if((dapl2 = H5Dget_access_plist(did)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_auto(dapl2, &nbytes) < 0)
+        FAIL_STACK_ERROR
+    if(nbytes != 32 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+    if(H5Pclose(dapl2) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+    /* Start with room for two chunks */
+    if(H5Pset_chunk_cache(dapl, (size_t)521, 2 * POOL_CHUNK_SIZE, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dopen2(fid, "auto", dapl)) < 0)
+        FAIL_STACK_ERROR
+
+    /* Reading each chunk once doesn't make the cache grow */
+    for(i = 0; i < AUTO_NCHUNKS; i++)
+        if(test_chunk_cache_pool_read(did, (hsize_t)i, 1) < 0)
+            TEST_ERROR
+    if(test_chunk_cache_auto_size(did, &nbytes) < 0)
+        TEST_ERROR
+    if(nbytes != 2 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+
+    /* Reading the same few chunks over and over does, until they fit */
+    for(j = 0; j < 32; j++)
+        for(i = 0; i < AUTO_NCYCLED; i++)
+            if(test_chunk_cache_pool_read(did, (hsize_t)i, 1) < 0)
+                TEST_ERROR
+    if(test_chunk_cache_auto_size(did, &grown) < 0)
+        TEST_ERROR
+    if(grown < AUTO_NCYCLED * POOL_CHUNK_SIZE || grown > 32 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    nmisses = stats.misses;
+    for(j = 0; j < 4; j++)
+        for(i = 0; i < AUTO_NCYCLED; i++)
+            if(test_chunk_cache_pool_read(did, (hsize_t)i, 1) < 0)
+                TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.misses != nmisses)
+        FAIL_PUTS_ERROR("chunks cycled through should all be cached");
+
+    /* Using a single chunk makes it shrink, but not below its initial size */
+    for(j = 0; j < 8 * AUTO_NCHUNKS; j++)
+        if(test_chunk_cache_pool_read(did, (hsize_t)0, 1) < 0)
+            TEST_ERROR
+    if(test_chunk_cache_auto_size(did, &nbytes) < 0)
+        TEST_ERROR
+    if(nbytes >= grown || nbytes < 2 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Fclose(fid);
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_cache_auto */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_read_direct
+ *
+ * Purpose: Tests H5Pset_chunk_cache_bypass: reads of whole, unfiltered
+ *          chunks which need no conversion go straight into the
+ *          application's buffer without passing through the chunk cache,
+ *          while converted reads, scattered reads, reads of chunks which
+ *          are cached and reads without the property still use the cache.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_read_direct(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dxpl = -1;              /* Dataset transfer property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim = POOL_DIM;         /* Dataset dimensions */
+    hsize_t     cdim = POOL_CHUNK_DIM;  /* Chunk dimensions */
+    hsize_t     mdim = 2 * POOL_CHUNK_DIM;  /* Memory dataspace dimensions */
+    hsize_t     start, stride, count;   /* Selections */
+    int         wbuf[POOL_DIM];         /* Write buffer */
+    int         rbuf[POOL_DIM];         /* Read buffer */
+    float       fbuf[POOL_CHUNK_DIM];   /* Read buffer for converted values */
+    int         val = -1;               /* Value written to one element */
+    hbool_t     bypass = TRUE;          /* Chunk cache bypass flag */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    int         i;                      /* Local index variable */
+
+    TESTING("reading whole chunks directly");
+
+    h5_fixname(FILENAME[36], fapl, filename, sizeof filename);
+
+    /* Create an unfiltered, chunked dataset */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &cdim) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "direct", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < POOL_DIM; i++)
+        wbuf[i] = 1000 + i;
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+    /* Reopen it with room for all its chunks */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)POOL_DIM * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dopen2(fid, "direct", dapl)) < 0)
+        FAIL_STACK_ERROR
+
+    /* The cache isn't bypassed by default */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_bypass(dxpl, &bypass) < 0)
+        FAIL_STACK_ERROR
+    if(bypass)
+        TEST_ERROR
+    if(H5Pset_chunk_cache_bypass(dxpl, TRUE) < 0)
+        FAIL_STACK_ERROR
+
+    /* Reading the whole dataset doesn't touch the cache */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < POOL_DIM; i++)
+        if(rbuf[i] != wbuf[i])
+            FAIL_PUTS_ERROR("wrong data read");
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 0 || stats.misses != 0 || stats.bytes_read != POOL_DIM * sizeof(int))
+        FAIL_PUTS_ERROR("whole chunks should be read directly");
+
+    /* Nor does reading one chunk into the middle of a buffer */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    start = POOL_CHUNK_DIM / 2;
+    count = POOL_CHUNK_DIM;
+    if((msid = H5Screate_simple(1, &mdim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sselect_hyperslab(msid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0)
+        FAIL_STACK_ERROR
+    start = POOL_CHUNK_DIM;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dread(did, H5T_NATIVE_INT, msid, sid, dxpl, rbuf) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < POOL_CHUNK_DIM; i++)
+        if(rbuf[POOL_CHUNK_DIM / 2 + i] != 1000 + POOL_CHUNK_DIM + i)
+            FAIL_PUTS_ERROR("wrong data read");
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 0 || stats.misses != 0)
+        FAIL_PUTS_ERROR("whole chunk should be read directly");
+
+    /* Scattering a chunk through memory goes through the cache */
+    start = 0;
+    stride = 2;
+    if(H5Sselect_hyperslab(msid, H5S_SELECT_SET, &start, &stride, &count, NULL) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dread(did, H5T_NATIVE_INT, msid, sid, dxpl, rbuf) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < POOL_CHUNK_DIM; i++)
+        if(rbuf[2 * i] != 1000 + POOL_CHUNK_DIM + i)
+            FAIL_PUTS_ERROR("wrong data read");
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 0 || stats.misses != 1)
+        FAIL_PUTS_ERROR("scattered read should use the cache");
+
+    /* Once cached, the chunk is read from the cache */
+    if(test_chunk_cache_pool_read(did, (hsize_t)1, 1) < 0)
+        TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 1 || stats.misses != 1)
+        FAIL_PUTS_ERROR("cached chunk should be read from the cache");
+
+    /* So are converted reads */
+    start = 2 * POOL_CHUNK_DIM;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0)
+        FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &count, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dread(did, H5T_NATIVE_FLOAT, msid, sid, dxpl, fbuf) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < POOL_CHUNK_DIM; i++)
+        if(!H5_FLT_ABS_EQUAL(fbuf[i], (float)(1000 + 2 * POOL_CHUNK_DIM + i)))
+            FAIL_PUTS_ERROR("wrong data read");
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 1 || stats.misses != 2)
+        FAIL_PUTS_ERROR("converted read should use the cache");
+
+    /* So are reads without the property */
+    if(test_chunk_cache_pool_read(did, (hsize_t)0, 1) < 0)
+        TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 1 || stats.misses != 3)
+        FAIL_PUTS_ERROR("read without the property should use the cache");
+
+    /* A whole chunk read after part of it was written sees the write */
+    start = 3 * POOL_CHUNK_DIM + 1;
+    count = 1;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0)
+        FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &count, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, &val) < 0)
+        FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < POOL_DIM; i++)
+        if(rbuf[i] != (i == 3 * POOL_CHUNK_DIM + 1 ? val : wbuf[i]))
+            FAIL_PUTS_ERROR("wrong data read");
+
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Fclose(fid);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Pclose(dcpl);
+        H5Sclose(msid);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_read_direct */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_read_direct_filtered
+ *
+ * Purpose: Tests H5Pset_chunk_cache_bypass with a filtered dataset: whole
+ *          chunks are unfiltered into the application's buffer without
+ *          being cached, with one and with several filter threads, while
+ *          the unfiltered partial edge chunk goes through the cache.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define DIRECT_FILTERED_DIM     (POOL_DIM + POOL_CHUNK_DIM / 2)
+static herr_t
+test_chunk_read_direct_filtered(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dxpl = -1;              /* Dataset transfer property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim = DIRECT_FILTERED_DIM;  /* Dataset dimensions */
+    hsize_t     cdim = POOL_CHUNK_DIM;  /* Chunk dimensions */
+    int         wbuf[DIRECT_FILTERED_DIM];  /* Write buffer */
+    int         rbuf[DIRECT_FILTERED_DIM];  /* Read buffer */
+    unsigned    opts;                   /* Chunk options */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    int         i;                      /* Local index variable */
+
+    TESTING("reading whole filtered chunks directly");
+
+    h5_fixname(FILENAME[37], fapl, filename, sizeof filename);
+
+    /* Register byte-counting filter */
+    if(H5Zregister(H5Z_COUNT) < 0)
+        TEST_ERROR
+
+    /* Create a filtered dataset, without filtering its partial edge chunk */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &cdim) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0u, (size_t)0, NULL) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_opts(dcpl, &opts) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_opts(dcpl, opts | H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "direct", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < DIRECT_FILTERED_DIM; i++)
+        wbuf[i] = 1000 + i;
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+    /* Reopen it with room for all its chunks */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)DIRECT_FILTERED_DIM * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dopen2(fid, "direct", dapl)) < 0)
+        FAIL_STACK_ERROR
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache_bypass(dxpl, TRUE) < 0)
+        FAIL_STACK_ERROR
+
+    /* Only the edge chunk is cached */
+    count_nbytes_read = (size_t)0;
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < DIRECT_FILTERED_DIM; i++)
+        if(rbuf[i] != wbuf[i])
+            FAIL_PUTS_ERROR("wrong data read");
+    if(count_nbytes_read != 4 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 0 || stats.misses != 1 || stats.bytes_decompressed != 4 * POOL_CHUNK_SIZE)
+        FAIL_PUTS_ERROR("whole filtered chunks should bypass the cache");
+
+    /* Again, unfiltering on several threads */
+    if(H5Pset_filter_threads(dxpl, 4) < 0)
+        FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < DIRECT_FILTERED_DIM; i++)
+        if(rbuf[i] != wbuf[i])
+            FAIL_PUTS_ERROR("wrong data read");
+    if(count_nbytes_read != 8 * POOL_CHUNK_SIZE)
+        TEST_ERROR
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 1 || stats.misses != 1 || stats.bytes_decompressed != 8 * POOL_CHUNK_SIZE)
+        FAIL_PUTS_ERROR("whole filtered chunks should bypass the cache");
+
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+#ifdef H5_HAVE_FILTER_DEFLATE
+    /* Chunks compressed last with deflate are uncompressed straight into
+     * the application's buffer, after the rest of the pipeline */
+    if(H5Premove_filter(dcpl, H5Z_FILTER_ALL) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_deflate(dcpl, 6) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0u, (size_t)0, NULL) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "direct_deflate", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dopen2(fid, "direct_deflate", dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_filter_threads(dxpl, 1) < 0)
+        FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < DIRECT_FILTERED_DIM; i++)
+        if(rbuf[i] != wbuf[i])
+            FAIL_PUTS_ERROR("wrong data read");
+    if(H5Dget_chunk_cache_stats(did, &stats) < 0)
+        FAIL_STACK_ERROR
+    if(stats.hits != 0 || stats.misses != 1 || stats.bytes_decompressed != 4 * POOL_CHUNK_SIZE)
+        FAIL_PUTS_ERROR("whole compressed chunks should bypass the cache");
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Fclose(fid);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_read_direct_filtered */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_shard_check
+ *
+ * Purpose: Helper for test_chunk_shard: reads a sharded dataset back and
+ *          checks that the chunks of its first shard are stored next to
+ *          each other when they fit in their slot.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define SHARD_DIM               40
+#define SHARD_CHUNK_DIM         10
+#define SHARD_NCHUNKS           2
+#define SHARD_CHUNK_SIZE        (SHARD_CHUNK_DIM * SHARD_CHUNK_DIM * sizeof(int))
+static herr_t
+test_chunk_shard_check(hid_t did, hsize_t nrows, hbool_t slotted)
+{
+    int         rbuf[SHARD_DIM][SHARD_DIM]; /* Read buffer */
+    hsize_t     nchunks;                /* # of chunks written */
+    hsize_t     offset[2];              /* Offset of chunk */
+    haddr_t     addr, addr00 = HADDR_UNDEF, addr01 = HADDR_UNDEF, addr10 = HADDR_UNDEF;
+    hsize_t     u, i, j;                /* Local index variables */
+
+    HDmemset(rbuf, 0xff, sizeof(rbuf));
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < nrows; i++)
+        for(j = 0; j < nrows; j++)
+            if(rbuf[i][j] != (int)(i * SHARD_DIM + j))
+                FAIL_PUTS_ERROR("wrong data read");
+
+    /* Every chunk is found again by iterating over the shards */
+    if(H5Dget_num_chunks(did, H5S_ALL, &nchunks) < 0)
+        FAIL_STACK_ERROR
+    if(nchunks != (nrows / SHARD_CHUNK_DIM) * (nrows / SHARD_CHUNK_DIM))
+        FAIL_PUTS_ERROR("wrong number of chunks");
+    for(u = 0; u < nchunks; u++) {
+        if(H5Dget_chunk_info(did, H5S_ALL, u, offset, NULL, &addr, NULL) < 0)
+            FAIL_STACK_ERROR
+        if(offset[0] == 0 && offset[1] == 0)
+            addr00 = addr;
+        else if(offset[0] == 0 && offset[1] == SHARD_CHUNK_DIM)
+            addr01 = addr;
+        else if(offset[0] == SHARD_CHUNK_DIM && offset[1] == 0)
+            addr10 = addr;
+    } /* end for */
+    if(addr00 == HADDR_UNDEF || addr01 == HADDR_UNDEF || addr10 == HADDR_UNDEF)
+        FAIL_PUTS_ERROR("chunks of the first shard not found");
+    if(slotted && (addr01 != addr00 + SHARD_CHUNK_SIZE || addr10 != addr00 + 2 * SHARD_CHUNK_SIZE))
+        FAIL_PUTS_ERROR("chunks of a shard should be stored together");
+
+    return 0;
+
+error:
+    return -1;
+} /* test_chunk_shard_check */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_shard
+ *
+ * Purpose: Tests H5Pset_chunk_shard: chunks are grouped into shards of
+ *          2x2 chunks, read back after reopening and copying, and removed
+ *          when the dataset shrinks.  Filtered chunks take only the file
+ *          space they need and keep their location when rewritten, the
+ *          chunks of a shard are read with one I/O request each when
+ *          they're stored together, and the layout message version the
+ *          sharded index needs is only used when the file's library
+ *          version bounds allow it.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define SHARD_NSHARDS           (((SHARD_DIM / SHARD_CHUNK_DIM) / SHARD_NCHUNKS) * ((SHARD_DIM / SHARD_CHUNK_DIM) / SHARD_NCHUNKS))
+#define SHARD_TOTAL_CHUNKS      ((SHARD_DIM / SHARD_CHUNK_DIM) * (SHARD_DIM / SHARD_CHUNK_DIM))
+#define SHARD_META_SLACK        4096    /* File space metadata may take besides the chunks */
+static herr_t
+test_chunk_shard(const char *env_h5_drvr, hid_t fapl)
+{
+    const char *names[] = {"unfiltered", "fletcher32", "deflate"};
+    char        filename[FILENAME_BUF_SIZE];
+    char        copy_name[32];          /* Name of dataset's copy */
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       fdcpl = -1;             /* Filtered dataset creation property list ID */
+    hid_t       dcpl2 = -1;             /* Dataset's creation property list ID */
+    hid_t       fapl2 = -1;             /* File access property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim[2] = {SHARD_DIM, SHARD_DIM};  /* Dataset dimensions */
+    hsize_t     max_dim[2] = {H5S_UNLIMITED, H5S_UNLIMITED};  /* Maximum dataset dimensions */
+    hsize_t     small_dim[2] = {SHARD_DIM / 2, SHARD_DIM / 2}; /* Shrunk dataset dimensions */
+    hsize_t     cdim[2] = {SHARD_CHUNK_DIM, SHARD_CHUNK_DIM}; /* Chunk dimensions */
+    hsize_t     shard_dim[2] = {SHARD_NCHUNKS, SHARD_NCHUNKS}; /* Shard dimensions */
+    hsize_t     shard_dim_out[2];       /* Shard dimensions retrieved */
+    hsize_t     fsize0, fsize1, fsize2; /* File sizes */
+    hsize_t     storage;                /* Dataset's storage size */
+    h5_io_counts_t counts;              /* I/O requests made */
+    unsigned    version;                /* Layout message version */
+    int         wbuf[SHARD_DIM][SHARD_DIM]; /* Write buffer */
+    int         rbuf[SHARD_DIM][SHARD_DIM]; /* Read buffer */
+    int         nfilters = 2;           /* # of filter cases to test */
+    int         filter;                 /* Filter case */
+    int         i, j;                   /* Local index variables */
+
+    TESTING("grouping chunks into shards");
+
+    h5_fixname(FILENAME[38], fapl, filename, sizeof filename);
+
+    for(i = 0; i < SHARD_DIM; i++)
+        for(j = 0; j < SHARD_DIM; j++)
+            wbuf[i][j] = i * SHARD_DIM + j;
+
+#ifdef H5_HAVE_FILTER_DEFLATE
+    nfilters++;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+    if((sid = H5Screate_simple(2, dim, max_dim)) < 0)
+        FAIL_STACK_ERROR
+
+    /* Shards need a chunked layout of the same rank */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        if(H5Pset_chunk_shard(dcpl, 2, shard_dim) >= 0)
+            FAIL_PUTS_ERROR("shards set without chunks");
+    } H5E_END_TRY;
+    if(H5Pset_chunk(dcpl, 2, cdim) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        if(H5Pset_chunk_shard(dcpl, 1, shard_dim) >= 0)
+            FAIL_PUTS_ERROR("shards set with wrong rank");
+    } H5E_END_TRY;
+    if(H5Pget_chunk_shard(dcpl, 2, shard_dim_out) != 0)
+        FAIL_PUTS_ERROR("chunks shouldn't be sharded yet");
+    if(H5Pset_chunk_shard(dcpl, 2, shard_dim) < 0)
+        FAIL_STACK_ERROR
+
+    for(filter = 0; filter < nfilters; filter++) {
+        const char *name = names[filter];
+
+        /* Fletcher32 makes every chunk larger than its slot, deflate smaller */
+        if((fdcpl = H5Pcopy(dcpl)) < 0)
+            FAIL_STACK_ERROR
+        if(1 == filter && H5Pset_fletcher32(fdcpl) < 0)
+            FAIL_STACK_ERROR
+        if(2 == filter && H5Pset_deflate(fdcpl, 6) < 0)
+            FAIL_STACK_ERROR
+        HDsnprintf(copy_name, sizeof(copy_name), "%s_copy", name);
+
+        if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Fget_filesize(fid, &fsize0) < 0)
+            FAIL_STACK_ERROR
+        if((did = H5Dcreate2(fid, name, H5T_NATIVE_INT, sid, H5P_DEFAULT, fdcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+            FAIL_STACK_ERROR
+        if(H5Fflush(fid, H5F_SCOPE_LOCAL) < 0)
+            FAIL_STACK_ERROR
+
+        /* The sharded index needs the latest layout message version */
+        if(H5D__layout_version_test(did, &version) < 0)
+            FAIL_STACK_ERROR
+        if(version != H5O_LAYOUT_VERSION_5)
+            FAIL_PUTS_ERROR("wrong layout message version");
+
+        /* The chunks take the space they need, and little more is allocated */
+        if((storage = H5Dget_storage_size(did)) == 0)
+            FAIL_STACK_ERROR
+        if(0 == filter && storage != sizeof(wbuf))
+            FAIL_PUTS_ERROR("wrong storage size for unfiltered chunks");
+        if(1 == filter && storage != sizeof(wbuf) + SHARD_TOTAL_CHUNKS * 4)
+            FAIL_PUTS_ERROR("wrong storage size for checksummed chunks");
+        if(2 == filter && storage >= sizeof(wbuf))
+            FAIL_PUTS_ERROR("compressed chunks should be smaller");
+        if(H5Fget_filesize(fid, &fsize1) < 0)
+            FAIL_STACK_ERROR
+        if(fsize1 - fsize0 > storage + SHARD_META_SLACK)
+            FAIL_PUTS_ERROR("too much file space allocated");
+
+        /* Rewriting the chunks reuses their file space */
+        if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+            FAIL_STACK_ERROR
+        if(H5Fflush(fid, H5F_SCOPE_LOCAL) < 0)
+            FAIL_STACK_ERROR
+        if(H5Fget_filesize(fid, &fsize2) < 0)
+            FAIL_STACK_ERROR
+        if(fsize2 != fsize1)
+            FAIL_PUTS_ERROR("rewritten chunks should keep their file space");
+
+        /* The shard dimensions are part of the dataset's creation properties */
+        if((dcpl2 = H5Dget_create_plist(did)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Pget_chunk_shard(dcpl2, 2, shard_dim_out) != 2)
+            FAIL_PUTS_ERROR("chunks should be sharded");
+        if(shard_dim_out[0] != SHARD_NCHUNKS || shard_dim_out[1] != SHARD_NCHUNKS)
+            FAIL_PUTS_ERROR("wrong shard dimensions");
+        if(H5Pclose(dcpl2) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+
+        /* Read back after reopening the file */
+        if(H5Fclose(fid) < 0)
+            FAIL_STACK_ERROR
+        if((fid = H5Fopen(filename, H5F_ACC_RDWR, fapl)) < 0)
+            FAIL_STACK_ERROR
+        if((did = H5Dopen2(fid, name, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(test_chunk_shard_check(did, (hsize_t)SHARD_DIM, 0 == filter) < 0)
+            TEST_ERROR
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+
+        /* The chunks of a shard are read together (when the chunk cache
+         * holds them), with one request when they're stored next to each
+         * other */
+        if(!HDstrcmp(env_h5_drvr, "nomatch") || !HDstrcmp(env_h5_drvr, "sec2")) {
+            if(H5Fclose(fid) < 0)
+                FAIL_STACK_ERROR
+            if((fapl2 = H5Pcopy(fapl)) < 0)
+                FAIL_STACK_ERROR
+            if(h5_set_fapl_count(fapl2, &counts, 0) < 0)
+                TEST_ERROR
+            if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+                FAIL_STACK_ERROR
+            if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+                FAIL_STACK_ERROR
+            if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl2)) < 0)
+                FAIL_STACK_ERROR
+            if((did = H5Dopen2(fid, name, dapl)) < 0)
+                FAIL_STACK_ERROR
+            counts.raw_reads = 0;
+            if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+                FAIL_STACK_ERROR
+            if(HDmemcmp(rbuf, wbuf, sizeof(wbuf)))
+                FAIL_PUTS_ERROR("wrong data read");
+            if(0 == filter && counts.raw_reads != SHARD_NSHARDS)
+                FAIL_PUTS_ERROR("unfiltered shards should be read with one request each");
+            if(counts.raw_reads >= SHARD_TOTAL_CHUNKS)
+                FAIL_PUTS_ERROR("chunks of a shard should be read together");
+            if(H5Dclose(did) < 0)
+                FAIL_STACK_ERROR
+            if(H5Fclose(fid) < 0)
+                FAIL_STACK_ERROR
+            if(H5Pclose(dapl) < 0)
+                FAIL_STACK_ERROR
+            if(H5Pclose(fapl2) < 0)
+                FAIL_STACK_ERROR
+            if((fid = H5Fopen(filename, H5F_ACC_RDWR, fapl)) < 0)
+                FAIL_STACK_ERROR
+        } /* end if */
+
+        /* Read back a copy */
+        if(H5Ocopy(fid, name, fid, copy_name, H5P_DEFAULT, H5P_DEFAULT) < 0)
+            FAIL_STACK_ERROR
+        if((did = H5Dopen2(fid, copy_name, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(test_chunk_shard_check(did, (hsize_t)SHARD_DIM, 0 == filter) < 0)
+            TEST_ERROR
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+
+        /* Shrinking removes chunks, and shards once they're empty */
+        if((did = H5Dopen2(fid, name, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dset_extent(did, small_dim) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dset_extent(did, dim) < 0)
+            FAIL_STACK_ERROR
+        if(test_chunk_shard_check(did, (hsize_t)(SHARD_DIM / 2), 0 == filter) < 0)
+            TEST_ERROR
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+
+        /* Deleting the datasets releases their chunks and shards */
+        if(H5Ldelete(fid, name, H5P_DEFAULT) < 0)
+            FAIL_STACK_ERROR
+        if(H5Ldelete(fid, copy_name, H5P_DEFAULT) < 0)
+            FAIL_STACK_ERROR
+        if(H5Fclose(fid) < 0)
+            FAIL_STACK_ERROR
+        if(H5Pclose(fdcpl) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Files whose library version bounds exclude the latest layout message
+     * version can't hold a sharded index */
+    if((fapl2 = H5Pcopy(fapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_libver_bounds(fapl2, H5F_LIBVER_EARLIEST, H5F_LIBVER_V18) < 0)
+        FAIL_STACK_ERROR
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl2)) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        did = H5Dcreate2(fid, names[0], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if(did >= 0)
+        FAIL_PUTS_ERROR("sharded dataset created with earlier library version bounds");
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(fapl2) < 0)
+        FAIL_STACK_ERROR
+
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Fclose(fid);
+        H5Pclose(dapl);
+        H5Pclose(fapl2);
+        H5Pclose(dcpl2);
+        H5Pclose(fdcpl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_shard */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_implicit
+ *
+ * Purpose: Tests H5Pset_chunk_implicit: the chunks of a fixed-size
+ *          dataset are put at addresses computed from their offsets in a
+ *          block allocated when the dataset is created, and read as fill
+ *          values until they're written, whether the fill value is zero
+ *          or not.  A zero fill value isn't written at all, and a
+ *          non-zero one is written to adjacent chunks with one request.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define IMPLICIT_DIM            40
+#define IMPLICIT_CHUNK_DIM      10
+#define IMPLICIT_CHUNK_SIZE     (IMPLICIT_CHUNK_DIM * IMPLICIT_CHUNK_DIM * sizeof(int))
+#define IMPLICIT_STORAGE_SIZE   (IMPLICIT_DIM * IMPLICIT_DIM * sizeof(int))
+static herr_t
+test_chunk_implicit(const char *env_h5_drvr, hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       fapl2 = -1;             /* File access property list ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dcpl2 = -1;             /* Dataset's creation property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       sid2 = -1;              /* Dataspace ID with unlimited dimensions */
+    hid_t       did = -1;               /* Dataset ID */
+    hsize_t     dim[2] = {IMPLICIT_DIM, IMPLICIT_DIM};  /* Dataset dimensions */
+    hsize_t     max_dim[2] = {H5S_UNLIMITED, H5S_UNLIMITED};  /* Maximum dataset dimensions */
+    hsize_t     cdim[2] = {IMPLICIT_CHUNK_DIM, IMPLICIT_CHUNK_DIM}; /* Chunk dimensions */
+    hsize_t     start[2] = {IMPLICIT_CHUNK_DIM, IMPLICIT_CHUNK_DIM}; /* Start of the block written */
+    hsize_t     count[2] = {IMPLICIT_CHUNK_DIM, 2 * IMPLICIT_CHUNK_DIM}; /* Size of the block written */
+    hsize_t     offset[2];              /* Offset of chunk */
+    hsize_t     nchunks;                /* # of chunks */
+    hsize_t     fsize0, fsize1;         /* File sizes */
+    h5_io_counts_t counts;              /* I/O requests made */
+    hbool_t     counted;                /* Whether the I/O requests are counted */
+    haddr_t     addr, addr00 = HADDR_UNDEF; /* Chunk addresses */
+    H5D_alloc_time_t alloc_time;        /* Space allocation time */
+    H5D_space_status_t status;          /* Space allocation status */
+    int         wbuf[IMPLICIT_CHUNK_DIM][2 * IMPLICIT_CHUNK_DIM]; /* Write buffer */
+    int         rbuf[IMPLICIT_DIM][IMPLICIT_DIM]; /* Read buffer */
+    int         fill;                   /* Fill value */
+    hsize_t     u, i, j;                /* Local index variables */
+
+    TESTING("implicit chunk index");
+
+    h5_fixname(FILENAME[39], fapl, filename, sizeof filename);
+
+    for(i = 0; i < IMPLICIT_CHUNK_DIM; i++)
+        for(j = 0; j < 2 * IMPLICIT_CHUNK_DIM; j++)
+            wbuf[i][j] = (int)(i * IMPLICIT_DIM + j + 1);
+
+    /* Count the fill value writes, with drivers the counting VFD can
+     * stand in for */
+    if((fapl2 = H5Pcopy(fapl)) < 0)
+        FAIL_STACK_ERROR
+    counted = (hbool_t)(!HDstrcmp(env_h5_drvr, "nomatch") || !HDstrcmp(env_h5_drvr, "sec2"));
+    if(counted && h5_set_fapl_count(fapl2, &counts, 0) < 0)
+        TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl2)) < 0)
+        FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dim, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(2, count, NULL)) < 0)
+        FAIL_STACK_ERROR
+
+    /* An implicit index needs a chunked layout */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        if(H5Pset_chunk_implicit(dcpl) >= 0)
+            FAIL_PUTS_ERROR("implicit index set without chunks");
+    } H5E_END_TRY;
+    if(H5Pset_chunk(dcpl, 2, cdim) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_implicit(dcpl) != FALSE)
+        FAIL_PUTS_ERROR("implicit index shouldn't be requested yet");
+    if(H5Pset_chunk_implicit(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_implicit(dcpl) != TRUE)
+        FAIL_PUTS_ERROR("implicit index should be requested");
+    if(H5Pget_alloc_time(dcpl, &alloc_time) < 0)
+        FAIL_STACK_ERROR
+    if(alloc_time != H5D_ALLOC_TIME_EARLY)
+        FAIL_PUTS_ERROR("space should be allocated early");
+
+    /* Default (zero) fill value first, then a non-zero one */
+    for(fill = 0; fill < 2; fill++) {
+        const char *name = fill ? "fill" : "zero";
+
+        if(fill && H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0)
+            FAIL_STACK_ERROR
+
+        if(H5Fget_filesize(fid, &fsize0) < 0)
+            FAIL_STACK_ERROR
+        if(counted)
+            HDmemset(&counts, 0, sizeof(counts));
+        if((did = H5Dcreate2(fid, name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+
+        /* All the space for the chunks is allocated, in one block */
+        if(H5Dget_space_status(did, &status) < 0)
+            FAIL_STACK_ERROR
+        if(status != H5D_SPACE_STATUS_ALLOCATED)
+            FAIL_PUTS_ERROR("space should be allocated");
+        if(H5Dget_storage_size(did) != IMPLICIT_STORAGE_SIZE)
+            FAIL_PUTS_ERROR("wrong storage size");
+        if(H5Fget_filesize(fid, &fsize1) < 0)
+            FAIL_STACK_ERROR
+        if(fsize1 < fsize0 + IMPLICIT_STORAGE_SIZE)
+            FAIL_PUTS_ERROR("space for the chunks should be reserved in the file");
+
+        /* Only a non-zero fill value is written, all at once */
+        if(counted && !fill && counts.raw_writes != 0)
+            FAIL_PUTS_ERROR("zero fill values shouldn't be written");
+        if(counted && fill && counts.raw_writes != 1)
+            FAIL_PUTS_ERROR("fill values should be written with one request");
+
+        /* Chunks are stored in order, next to each other */
+        if(H5Dget_num_chunks(did, H5S_ALL, &nchunks) < 0)
+            FAIL_STACK_ERROR
+        if(nchunks != (IMPLICIT_DIM / IMPLICIT_CHUNK_DIM) * (IMPLICIT_DIM / IMPLICIT_CHUNK_DIM))
+            FAIL_PUTS_ERROR("wrong number of chunks");
+        for(u = 0; u < nchunks; u++) {
+            if(H5Dget_chunk_info(did, H5S_ALL, u, offset, NULL, &addr, NULL) < 0)
+                FAIL_STACK_ERROR
+            if(u == 0)
+                addr00 = addr;
+            if(addr != addr00 + ((offset[0] / IMPLICIT_CHUNK_DIM) * (IMPLICIT_DIM / IMPLICIT_CHUNK_DIM)
+                    + offset[1] / IMPLICIT_CHUNK_DIM) * IMPLICIT_CHUNK_SIZE)
+                FAIL_PUTS_ERROR("chunk not at its implicit address");
+        } /* end for */
+
+        /* Write part of the dataset, then read it all after reopening the file */
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+        if(H5Fclose(fid) < 0)
+            FAIL_STACK_ERROR
+        if((fid = H5Fopen(filename, H5F_ACC_RDWR, fapl2)) < 0)
+            FAIL_STACK_ERROR
+        if((did = H5Dopen2(fid, name, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if((dcpl2 = H5Dget_create_plist(did)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Pget_chunk_implicit(dcpl2) != TRUE)
+            FAIL_PUTS_ERROR("implicit index should be used");
+        if(H5Pclose(dcpl2) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+            FAIL_STACK_ERROR
+        for(i = 0; i < IMPLICIT_DIM; i++)
+            for(j = 0; j < IMPLICIT_DIM; j++) {
+                int expect = fill;
+
+                if(i >= start[0] && i < start[0] + count[0] && j >= start[1] && j < start[1] + count[1])
+                    expect = wbuf[i - start[0]][j - start[1]];
+                if(rbuf[i][j] != expect)
+                    FAIL_PUTS_ERROR("wrong data read");
+            } /* end for */
+        if(H5Dclose(did) < 0)
+            FAIL_STACK_ERROR
+        if(H5Sselect_all(sid) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Datasets with unlimited dimensions get their usual index */
+    if((sid2 = H5Screate_simple(2, dim, max_dim)) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "unlimited", H5T_NATIVE_INT, sid2, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl2)) < 0)
+        FAIL_STACK_ERROR
+    if((did = H5Dopen2(fid, "unlimited", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if((dcpl2 = H5Dget_create_plist(did)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_implicit(dcpl2) != FALSE)
+        FAIL_PUTS_ERROR("implicit index shouldn't be used");
+    if(H5Pclose(dcpl2) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(did) < 0)
+        FAIL_STACK_ERROR
+
+    if(H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(fapl2) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(sid2) < 0)
+        FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Fclose(fid);
+        H5Pclose(fapl2);
+        H5Pclose(dcpl2);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Sclose(msid);
+        H5Sclose(sid2);
+    } H5E_END_TRY;
+    return -1;
+} /* test_chunk_implicit */
+
+
 /*-------------------------------------------------------------------------
  * Function: test_large_chunk_shrink
  *
@@ -13204,6 +16088,22 @@ main(void)
             nerrors += (test_fixed_array(my_fapl) < 0        ? 1 : 0);
             nerrors += (test_idx_compatible() < 0            ? 1 : 0);
             nerrors += (test_unfiltered_edge_chunks(my_fapl) < 0    ? 1 : 0);
+            nerrors += (test_filter_threads(my_fapl) < 0            ? 1 : 0);
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+            nerrors += (test_filter_threads_error(my_fapl) < 0      ? 1 : 0);
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+            nerrors += (test_chunk_info(my_fapl) < 0                ? 1 : 0);
+            nerrors += (test_multi_dset_io(my_fapl) < 0             ? 1 : 0);
+            nerrors += (test_chunk_cache_pool(my_fapl) < 0          ? 1 : 0);
+            nerrors += (test_chunk_read_ahead(my_fapl) < 0          ? 1 : 0);
+            nerrors += (test_chunk_flush_batch(my_fapl) < 0         ? 1 : 0);
+            nerrors += (test_chunk_index_bulk(my_fapl) < 0          ? 1 : 0);
+            nerrors += (test_chunk_cache_stats(my_fapl) < 0         ? 1 : 0);
+            nerrors += (test_chunk_cache_auto(my_fapl) < 0          ? 1 : 0);
+            nerrors += (test_chunk_read_direct(my_fapl) < 0         ? 1 : 0);
+            nerrors += (test_chunk_read_direct_filtered(my_fapl) < 0 ? 1 : 0);
+            nerrors += (test_chunk_shard(envval, my_fapl) < 0       ? 1 : 0);
+            nerrors += (test_chunk_implicit(envval, my_fapl) < 0    ? 1 : 0);
             nerrors += (test_single_chunk(my_fapl) < 0              ? 1 : 0);
             nerrors += (test_large_chunk_shrink(my_fapl) < 0        ? 1 : 0);
             nerrors += (test_zero_dim_dset(my_fapl) < 0             ? 1 : 0);
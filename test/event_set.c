@@ -0,0 +1,563 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:    Tests event sets and the asynchronous dataset and file
+ *             routines that use them.
+ */
+#include "h5test.h"
+
+const char *FILENAME[] = {
+    "event_set",
+    NULL
+};
+
+#define DSETNAME        "Dataset"
+#define DSET_SIZE          1000
+#define NSLABS          10
+#define SLAB_SIZE       (DSET_SIZE / NSLABS)
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_event_set
+ *
+ * Purpose:     Tests creating, querying and closing an empty event set.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *-------------------------------------------------------------------------
+ */
+static int
+test_event_set(void)
+{
+    hid_t       es_id = -1;
+    size_t      count;
+    size_t      num_errs;
+    hbool_t     op_failed;
+    herr_t      ret;
+
+    TESTING("event set create/close");
+
+    if((es_id = H5EScreate()) < 0)
+        TEST_ERROR
+
+    /* A new event set is empty */
+    count = 1;
+    if(H5ESget_count(es_id, &count) < 0)
+        TEST_ERROR
+    if(count != 0)
+        FAIL_PUTS_ERROR("new event set isn't empty")
+    op_failed = TRUE;
+    if(H5ESget_err_status(es_id, &op_failed) < 0)
+        TEST_ERROR
+    if(op_failed)
+        FAIL_PUTS_ERROR("new event set has an error")
+    num_errs = 1;
+    if(H5ESget_err_count(es_id, &num_errs) < 0)
+        TEST_ERROR
+    if(num_errs != 0)
+        FAIL_PUTS_ERROR("new event set has errors")
+
+    /* Waiting on it finishes right away */
+    count = 1;
+    op_failed = TRUE;
+    if(H5ESwait(es_id, H5ES_WAIT_NONE, &count, &op_failed) < 0)
+        TEST_ERROR
+    if(count != 0 || op_failed)
+        FAIL_PUTS_ERROR("wrong status from waiting on an empty event set")
+
+    if(H5ESclose(es_id) < 0)
+        TEST_ERROR
+
+    /* The ID is gone once closed */
+    H5E_BEGIN_TRY {
+        ret = H5ESclose(es_id);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("closed event set twice")
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5ESclose(es_id);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_event_set() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_async_io
+ *
+ * Purpose:     Tests writing a dataset with H5Dwrite_async, flushing it
+ *              with H5Fflush_async and reading it back with
+ *              H5Dread_async.  The dataspaces, dataset and file are
+ *              changed or closed before the event set is waited on, which
+ *              the queued operations must not notice.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *-------------------------------------------------------------------------
+ */
+static int
+test_async_io(hid_t fapl)
+{
+    char        filename[1024];
+    hid_t       file = -1, dset = -1, fspace = -1, mspace = -1, es_id = -1;
+    hsize_t     dims[1] = {DSET_SIZE};
+    hsize_t     slab_dims[1] = {SLAB_SIZE};
+    hsize_t     start[1], count[1];
+    int        *wbuf = NULL, *rbuf = NULL;
+    size_t      num_in_progress;
+    hbool_t     op_failed;
+    unsigned    u;
+
+    TESTING("asynchronous dataset write, flush and read");
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(DSET_SIZE * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDcalloc(DSET_SIZE, sizeof(int))))
+        TEST_ERROR
+    for(u = 0; u < DSET_SIZE; u++)
+        wbuf[u] = (int)(u * 3 + 1);
+
+    if((es_id = H5EScreate()) < 0)
+        TEST_ERROR
+
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    if((fspace = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    if((mspace = H5Screate_simple(1, slab_dims, NULL)) < 0)
+        TEST_ERROR
+    if((dset = H5Dcreate2(file, DSETNAME, H5T_NATIVE_INT, fspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+
+    /* Queue one write per slab, moving the file selection after each */
+    count[0] = SLAB_SIZE;
+    for(u = 0; u < NSLABS; u++) {
+        start[0] = u * SLAB_SIZE;
+        if(H5Sselect_hyperslab(fspace, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+            TEST_ERROR
+        if(H5Dwrite_async(dset, H5T_NATIVE_INT, mspace, fspace, H5P_DEFAULT, wbuf + start[0], es_id) < 0)
+            TEST_ERROR
+    } /* end for */
+    if(H5Fflush_async(file, H5F_SCOPE_GLOBAL, es_id) < 0)
+        TEST_ERROR
+
+    /* Close everything while the operations may still be queued */
+    if(H5Sclose(mspace) < 0)
+        TEST_ERROR
+    if(H5Sclose(fspace) < 0)
+        TEST_ERROR
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    if(H5ESwait(es_id, H5ES_WAIT_FOREVER, &num_in_progress, &op_failed) < 0)
+        TEST_ERROR
+    if(num_in_progress != 0 || op_failed)
+        FAIL_PUTS_ERROR("asynchronous writes didn't complete cleanly")
+
+    /* Read the data back, synchronously and then asynchronously */
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR
+    if((dset = H5Dopen2(file, DSETNAME, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        TEST_ERROR
+    for(u = 0; u < DSET_SIZE; u++)
+        if(rbuf[u] != wbuf[u])
+            FAIL_PUTS_ERROR("wrong data written asynchronously")
+
+    HDmemset(rbuf, 0, DSET_SIZE * sizeof(int));
+    if(H5Dread_async(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf, es_id) < 0)
+        TEST_ERROR
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+    if(H5ESwait(es_id, H5ES_WAIT_FOREVER, &num_in_progress, &op_failed) < 0)
+        TEST_ERROR
+    if(num_in_progress != 0 || op_failed)
+        FAIL_PUTS_ERROR("asynchronous read didn't complete cleanly")
+    for(u = 0; u < DSET_SIZE; u++)
+        if(rbuf[u] != wbuf[u])
+            FAIL_PUTS_ERROR("wrong data read asynchronously")
+
+    if(H5ESclose(es_id) < 0)
+        TEST_ERROR
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5ESclose(es_id);
+        H5Sclose(mspace);
+        H5Sclose(fspace);
+        H5Dclose(dset);
+        H5Fclose(file);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return 1;
+} /* end test_async_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_async_sync
+ *
+ * Purpose:     Tests that the asynchronous routines perform the operation
+ *              synchronously when passed H5ES_NONE.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *-------------------------------------------------------------------------
+ */
+static int
+test_async_sync(hid_t fapl)
+{
+    char        filename[1024];
+    hid_t       file = -1, dset = -1, space = -1;
+    hsize_t     dims[1] = {DSET_SIZE};
+    int        *wbuf = NULL, *rbuf = NULL;
+    unsigned    u;
+
+    TESTING("asynchronous routines without an event set");
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(DSET_SIZE * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDcalloc(DSET_SIZE, sizeof(int))))
+        TEST_ERROR
+    for(u = 0; u < DSET_SIZE; u++)
+        wbuf[u] = (int)(DSET_SIZE - u);
+
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    if((space = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    if((dset = H5Dcreate2(file, DSETNAME, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+
+    /* The data is in place as soon as each call returns */
+    if(H5Dwrite_async(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf, H5ES_NONE) < 0)
+        TEST_ERROR
+    if(H5Fflush_async(dset, H5F_SCOPE_LOCAL, H5ES_NONE) < 0)
+        TEST_ERROR
+    if(H5Dread_async(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf, H5ES_NONE) < 0)
+        TEST_ERROR
+    for(u = 0; u < DSET_SIZE; u++)
+        if(rbuf[u] != wbuf[u])
+            FAIL_PUTS_ERROR("wrong data read")
+
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+    if(H5Sclose(space) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Sclose(space);
+        H5Dclose(dset);
+        H5Fclose(file);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return 1;
+} /* end test_async_sync() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_async_errors
+ *
+ * Purpose:     Tests that invalid arguments are rejected when an
+ *              operation is inserted, and that an operation failing
+ *              after it was inserted is recorded in the event set.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *-------------------------------------------------------------------------
+ */
+static int
+test_async_errors(hid_t fapl)
+{
+    char        filename[1024];
+    hid_t       file = -1, dset = -1, space = -1, str_type = -1, es_id = -1;
+    hsize_t     dims[1] = {DSET_SIZE};
+    int        *buf = NULL;
+    size_t      num_in_progress;
+    size_t      num_errs;
+    hbool_t     op_failed;
+    herr_t      ret;
+
+    TESTING("asynchronous operation errors");
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof filename);
+
+    if(NULL == (buf = (int *)HDcalloc(DSET_SIZE, sizeof(int))))
+        TEST_ERROR
+
+    if((es_id = H5EScreate()) < 0)
+        TEST_ERROR
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    if((space = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    if((dset = H5Dcreate2(file, DSETNAME, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+
+    /* Bad arguments fail right away and aren't inserted */
+    H5E_BEGIN_TRY {
+        ret = H5Dwrite_async(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf, space);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("used a dataspace as an event set")
+    H5E_BEGIN_TRY {
+        ret = H5Dread_async(space, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf, es_id);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("read from a dataspace")
+    H5E_BEGIN_TRY {
+        ret = H5Fflush_async(space, H5F_SCOPE_LOCAL, es_id);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("flushed a dataspace")
+
+    /* There's no conversion between strings and integers, which is only
+     * found out when the write runs */
+    if((str_type = H5Tcopy(H5T_C_S1)) < 0)
+        TEST_ERROR
+    if(H5Tset_size(str_type, sizeof(int)) < 0)
+        TEST_ERROR
+    if(H5Dwrite_async(dset, str_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf, es_id) < 0)
+        TEST_ERROR
+    if(H5Tclose(str_type) < 0)
+        TEST_ERROR
+
+    /* A good write after the bad one still runs */
+    if(H5Dwrite_async(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf, es_id) < 0)
+        TEST_ERROR
+
+    if(H5ESwait(es_id, H5ES_WAIT_FOREVER, &num_in_progress, &op_failed) < 0)
+        TEST_ERROR
+    if(num_in_progress != 0)
+        FAIL_PUTS_ERROR("operations still in progress")
+    if(!op_failed)
+        FAIL_PUTS_ERROR("failed write wasn't reported by H5ESwait")
+    op_failed = FALSE;
+    if(H5ESget_err_status(es_id, &op_failed) < 0)
+        TEST_ERROR
+    if(!op_failed)
+        FAIL_PUTS_ERROR("failed write wasn't reported by H5ESget_err_status")
+    if(H5ESget_err_count(es_id, &num_errs) < 0)
+        TEST_ERROR
+    if(num_errs != 1)
+        FAIL_PUTS_ERROR("wrong number of failed operations")
+
+    if(H5ESclose(es_id) < 0)
+        TEST_ERROR
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+    if(H5Sclose(space) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    HDfree(buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5ESclose(es_id);
+        H5Tclose(str_type);
+        H5Sclose(space);
+        H5Dclose(dset);
+        H5Fclose(file);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    return 1;
+} /* end test_async_errors() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_async_library_close
+ *
+ * Purpose:     Tests that shutting the library down with operations still
+ *              queued in an open event set discards them, instead of
+ *              hanging while it holds the API lock, and leaves the file
+ *              closed cleanly.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *-------------------------------------------------------------------------
+ */
+static int
+test_async_library_close(void)
+{
+    char        filename[1024];
+    hid_t       fapl = -1, file = -1, dset = -1, fspace = -1, mspace = -1, es_id = -1;
+    hsize_t     dims[1] = {DSET_SIZE};
+    hsize_t     slab_dims[1] = {SLAB_SIZE};
+    hsize_t     start[1], count[1];
+    int        *wbuf = NULL;
+    unsigned    u;
+
+    TESTING("closing the library with queued operations");
+
+    if((fapl = h5_fileaccess()) < 0)
+        TEST_ERROR
+    h5_fixname(FILENAME[0], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(DSET_SIZE * sizeof(int))))
+        TEST_ERROR
+    for(u = 0; u < DSET_SIZE; u++)
+        wbuf[u] = (int)u;
+
+    if((es_id = H5EScreate()) < 0)
+        TEST_ERROR
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    if((fspace = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    if((mspace = H5Screate_simple(1, slab_dims, NULL)) < 0)
+        TEST_ERROR
+    if((dset = H5Dcreate2(file, DSETNAME, H5T_NATIVE_INT, fspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+
+    count[0] = SLAB_SIZE;
+    for(u = 0; u < NSLABS; u++) {
+        start[0] = u * SLAB_SIZE;
+        if(H5Sselect_hyperslab(fspace, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+            TEST_ERROR
+        if(H5Dwrite_async(dset, H5T_NATIVE_INT, mspace, fspace, H5P_DEFAULT, wbuf + start[0], es_id) < 0)
+            TEST_ERROR
+    } /* end for */
+    if(H5Fflush_async(file, H5F_SCOPE_GLOBAL, es_id) < 0)
+        TEST_ERROR
+
+    if(H5Sclose(mspace) < 0)
+        TEST_ERROR
+    if(H5Sclose(fspace) < 0)
+        TEST_ERROR
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    /* Shut the library down without waiting for the event set, which
+     * closes the event set and the objects its operations refer to
+     */
+    if(H5close() < 0)
+        TEST_ERROR
+    HDfree(wbuf);
+    wbuf = NULL;
+
+    /* The file was closed cleanly, whichever operations ran */
+    if((fapl = h5_fileaccess()) < 0)
+        TEST_ERROR
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR
+    if((dset = H5Dopen2(file, DSETNAME, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    if(GetTestCleanup())
+        h5_delete_test_file(FILENAME[0], fapl);
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5ESclose(es_id);
+        H5Sclose(mspace);
+        H5Sclose(fspace);
+        H5Dclose(dset);
+        H5Fclose(file);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    return 1;
+} /* end test_async_library_close() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    main
+ *
+ * Purpose:     Tests event sets and asynchronous I/O
+ *
+ * Return:      Success:        EXIT_SUCCESS
+ *              Failure:        EXIT_FAILURE
+ *-------------------------------------------------------------------------
+ */
+int
+main(void)
+{
+    hid_t       fapl = -1;
+    int         nerrors = 0;
+
+    h5_reset();
+    fapl = h5_fileaccess();
+
+    nerrors += test_event_set();
+    nerrors += test_async_io(fapl);
+    nerrors += test_async_sync(fapl);
+    nerrors += test_async_errors(fapl);
+    if(nerrors)
+        goto error;
+    h5_cleanup(FILENAME, fapl);
+
+    /* Shuts the library down, so it runs last */
+    nerrors += test_async_library_close();
+
+    if(nerrors)
+        goto error;
+    HDputs("All event set tests passed.");
+
+    return EXIT_SUCCESS;
+
+error:
+    HDputs("***** EVENT SET TESTS FAILED *****");
+    return EXIT_FAILURE;
+} /* end main() */
+
@@ -1905,3 +1905,281 @@ error:
     return NULL;
 } /* h5_get_dummy_vfd_class */
 
+
+/* The counting VFD (see h5_set_fapl_count() below).
+ *
+ * Passes every request on to a sec2 file and counts the ones which reach
+ * it, so that tests can check how many I/O requests an operation makes.
+ * A vector request counts once for each run of blocks adjacent in the
+ * file, which is how the sec2 driver issues it.
+ */
+#define COUNT_VFD_MAXADDR   (((haddr_t)1 << (8 * sizeof(HDoff_t) - 1)) - 1)
+
+typedef struct count_vfd_fapl_t {
+    h5_io_counts_t *counts;             /* Where to count the requests */
+    unsigned long drop_features;        /* sec2 feature flags to hide */
+} count_vfd_fapl_t;
+
+typedef struct count_vfd_t {
+    H5FD_t pub;                         /* Public information, must be first */
+    H5FD_t *sec2;                       /* Underlying sec2 file */
+    count_vfd_fapl_t fa;                /* Counters and hidden features */
+} count_vfd_t;
+
+static hid_t count_vfd_id_g = -1;
+
+static void
+count_vfd_add(count_vfd_t *file, H5FD_mem_t type, hbool_t write)
+{
+    if(H5FD_MEM_DRAW == type) {
+        if(write)
+            file->fa.counts->raw_writes++;
+        else
+            file->fa.counts->raw_reads++;
+    } /* end if */
+    else {
+        if(write)
+            file->fa.counts->meta_writes++;
+        else
+            file->fa.counts->meta_reads++;
+    } /* end else */
+} /* count_vfd_add */
+
+static void
+count_vfd_add_vector(count_vfd_t *file, uint32_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], hbool_t write)
+{
+    uint32_t u;
+
+    for(u = 0; u < count; u++)
+        if(0 == u || addrs[u - 1] + sizes[u - 1] != addrs[u])
+            count_vfd_add(file, types[u], write);
+} /* count_vfd_add_vector */
+
+static H5FD_t *
+count_vfd_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
+{
+    const count_vfd_fapl_t *fa;
+    count_vfd_t *file = NULL;
+    hid_t sec2_fapl = -1;
+
+    if(NULL == (fa = (const count_vfd_fapl_t *)H5Pget_driver_info(fapl_id)))
+        goto error;
+    if(NULL == (file = (count_vfd_t *)HDcalloc((size_t)1, sizeof(count_vfd_t))))
+        goto error;
+    file->fa = *fa;
+    if((sec2_fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        goto error;
+    if(H5Pset_fapl_sec2(sec2_fapl) < 0)
+        goto error;
+    /* (The library tries opening files which may not exist, and reports
+     * its own errors) */
+    H5E_BEGIN_TRY {
+        file->sec2 = H5FDopen(name, flags, sec2_fapl, maxaddr);
+    } H5E_END_TRY;
+    if(NULL == file->sec2)
+        goto error;
+    if(H5Pclose(sec2_fapl) < 0)
+        goto error;
+
+    return (H5FD_t *)file;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(sec2_fapl);
+    } H5E_END_TRY;
+    if(file)
+        HDfree(file);
+    return NULL;
+} /* count_vfd_open */
+
+static herr_t
+count_vfd_close(H5FD_t *_file)
+{
+    count_vfd_t *file = (count_vfd_t *)_file;
+    herr_t ret_value = H5FDclose(file->sec2);
+
+    HDfree(file);
+    return ret_value;
+} /* count_vfd_close */
+
+static int
+count_vfd_cmp(const H5FD_t *f1, const H5FD_t *f2)
+{
+    return H5FDcmp(((const count_vfd_t *)f1)->sec2, ((const count_vfd_t *)f2)->sec2);
+} /* count_vfd_cmp */
+
+static herr_t
+count_vfd_query(const H5FD_t *_file, unsigned long *flags)
+{
+    const count_vfd_t *file = (const count_vfd_t *)_file;
+
+    if(file) {
+        if(H5FDquery(file->sec2, flags) < 0)
+            return FAIL;
+        *flags &= ~file->fa.drop_features;
+    } /* end if */
+    else
+        *flags = 0;
+    return SUCCEED;
+} /* count_vfd_query */
+
+static haddr_t
+count_vfd_get_eoa(const H5FD_t *_file, H5FD_mem_t type)
+{
+    return H5FDget_eoa(((const count_vfd_t *)_file)->sec2, type);
+} /* count_vfd_get_eoa */
+
+static herr_t
+count_vfd_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr)
+{
+    return H5FDset_eoa(((count_vfd_t *)_file)->sec2, type, addr);
+} /* count_vfd_set_eoa */
+
+static haddr_t
+count_vfd_get_eof(const H5FD_t *_file, H5FD_mem_t type)
+{
+    return H5FDget_eof(((const count_vfd_t *)_file)->sec2, type);
+} /* count_vfd_get_eof */
+
+static herr_t
+count_vfd_get_handle(H5FD_t *_file, hid_t fapl, void **file_handle)
+{
+    return H5FDget_vfd_handle(((count_vfd_t *)_file)->sec2, fapl, file_handle);
+} /* count_vfd_get_handle */
+
+static herr_t
+count_vfd_read(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, haddr_t addr,
+    size_t size, void *buf)
+{
+    count_vfd_t *file = (count_vfd_t *)_file;
+
+    count_vfd_add(file, type, FALSE);
+    return H5FDread(file->sec2, type, dxpl_id, addr, size, buf);
+} /* count_vfd_read */
+
+static herr_t
+count_vfd_write(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, haddr_t addr,
+    size_t size, const void *buf)
+{
+    count_vfd_t *file = (count_vfd_t *)_file;
+
+    count_vfd_add(file, type, TRUE);
+    return H5FDwrite(file->sec2, type, dxpl_id, addr, size, buf);
+} /* count_vfd_write */
+
+static herr_t
+count_vfd_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing)
+{
+    return H5FDtruncate(((count_vfd_t *)_file)->sec2, dxpl_id, closing);
+} /* count_vfd_truncate */
+
+static herr_t
+count_vfd_lock(H5FD_t *_file, hbool_t rw)
+{
+    return H5FDlock(((count_vfd_t *)_file)->sec2, rw);
+} /* count_vfd_lock */
+
+static herr_t
+count_vfd_unlock(H5FD_t *_file)
+{
+    return H5FDunlock(((count_vfd_t *)_file)->sec2);
+} /* count_vfd_unlock */
+
+static herr_t
+count_vfd_read_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[])
+{
+    count_vfd_t *file = (count_vfd_t *)_file;
+
+    count_vfd_add_vector(file, count, types, addrs, sizes, FALSE);
+    return (file->sec2->cls->read_vector)(file->sec2, dxpl_id, count, types, addrs, sizes, bufs);
+} /* count_vfd_read_vector */
+
+static herr_t
+count_vfd_write_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    count_vfd_t *file = (count_vfd_t *)_file;
+
+    count_vfd_add_vector(file, count, types, addrs, sizes, TRUE);
+    return (file->sec2->cls->write_vector)(file->sec2, dxpl_id, count, types, addrs, sizes, bufs);
+} /* count_vfd_write_vector */
+
+static const H5FD_class_t count_vfd_g = {
+    "count",                    /* name                 */
+    COUNT_VFD_MAXADDR,          /* maxaddr              */
+    H5F_CLOSE_WEAK,             /* fc_degree            */
+    NULL,                       /* terminate            */
+    NULL,                       /* sb_size              */
+    NULL,                       /* sb_encode            */
+    NULL,                       /* sb_decode            */
+    sizeof(count_vfd_fapl_t),   /* fapl_size            */
+    NULL,                       /* fapl_get             */
+    NULL,                       /* fapl_copy            */
+    NULL,                       /* fapl_free            */
+    0,                          /* dxpl_size            */
+    NULL,                       /* dxpl_copy            */
+    NULL,                       /* dxpl_free            */
+    count_vfd_open,             /* open                 */
+    count_vfd_close,            /* close                */
+    count_vfd_cmp,              /* cmp                  */
+    count_vfd_query,            /* query                */
+    NULL,                       /* get_type_map         */
+    NULL,                       /* alloc                */
+    NULL,                       /* free                 */
+    count_vfd_get_eoa,          /* get_eoa              */
+    count_vfd_set_eoa,          /* set_eoa              */
+    count_vfd_get_eof,          /* get_eof              */
+    count_vfd_get_handle,       /* get_handle           */
+    count_vfd_read,             /* read                 */
+    count_vfd_write,            /* write                */
+    NULL,                       /* flush                */
+    count_vfd_truncate,         /* truncate             */
+    count_vfd_lock,             /* lock                 */
+    count_vfd_unlock,           /* unlock               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    count_vfd_read_vector,      /* read_vector          */
+    count_vfd_write_vector,     /* write_vector         */
+    NULL                        /* get_ptr              */
+};
+
+
+/*-------------------------------------------------------------------------
+ * Function:    h5_set_fapl_count()
+ *
+ * Purpose:     Sets FAPL_ID to use the counting VFD, which passes every
+ *              request on to the sec2 driver and counts the metadata and
+ *              raw data reads and writes which reach it in *COUNTS.  A
+ *              vector request counts once for each run of blocks which
+ *              are adjacent in the file.  The feature flags in
+ *              DROP_FEATURES are hidden from the library.
+ *
+ *              COUNTS must stay valid while files opened with FAPL_ID
+ *              are open; the caller resets it as needed.
+ *
+ * Return:      Success:    SUCCEED
+ *              Failure:    FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+h5_set_fapl_count(hid_t fapl_id, h5_io_counts_t *counts, unsigned long drop_features)
+{
+    count_vfd_fapl_t fa;                /* Driver info */
+    htri_t is_valid = FALSE;            /* Whether the driver is registered */
+
+    if(count_vfd_id_g >= 0)
+        H5E_BEGIN_TRY {
+            is_valid = H5Iis_valid(count_vfd_id_g);
+        } H5E_END_TRY;
+    if(is_valid <= 0 && (count_vfd_id_g = H5FDregister(&count_vfd_g)) < 0)
+        return FAIL;
+
+    HDmemset(counts, 0, sizeof(*counts));
+    fa.counts = counts;
+    fa.drop_features = drop_features;
+    return H5Pset_driver(fapl_id, count_vfd_id_g, &fa);
+} /* h5_set_fapl_count */
@@ -114,6 +114,16 @@ H5TEST_DLLVAR MPI_Info h5_io_info_g;         /* MPI INFO object for IO */
     goto error;}
 #define FAIL_PUTS_ERROR(s) {H5_FAILED(); AT(); puts(s); goto error;}
 
+/*
+ * Requests counted by the counting VFD (see h5_set_fapl_count()).
+ */
+typedef struct h5_io_counts_t {
+    unsigned long long meta_reads;      /* Metadata reads */
+    unsigned long long meta_writes;     /* Metadata writes */
+    unsigned long long raw_reads;       /* Raw data reads */
+    unsigned long long raw_writes;      /* Raw data writes */
+} h5_io_counts_t;
+
 /*
  * Alarm definitions to wait up (terminate) a test that runs too long.
  */
@@ -142,6 +152,8 @@ H5TEST_DLL int print_func(const char *format, ...);
 H5TEST_DLL int h5_make_local_copy(const char *origfilename, const char *local_copy_name);
 H5TEST_DLL herr_t h5_verify_cached_stabs(const char *base_name[], hid_t fapl);
 H5TEST_DLL H5FD_class_t *h5_get_dummy_vfd_class(void);
+H5TEST_DLL herr_t h5_set_fapl_count(hid_t fapl_id, h5_io_counts_t *counts,
+    unsigned long drop_features);
 
 /* Functions that will replace VFD-dependent functions that violate
  * the single responsibility principle. Unlike their predecessors,
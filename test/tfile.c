@@ -137,6 +137,25 @@
 /* Declaration for test_incr_filesize() */
 #define FILE8            "tfile8.h5"    /* Test file */
 
+/* Declaration for test_meta_prefetch() */
+#define FILE9            "tfile9.h5"    /* Test file */
+#define PREFETCH_NGROUPS    8
+#define PREFETCH_NDSETS     8
+#define PREFETCH_SIZE       (64 * 1024)
+
+/* Declaration for test_mdc_flush_threads() */
+#define FILE10           "tfile10.h5"   /* Test file */
+#define FILE10_SERIAL    "tfile10s.h5"  /* Test file flushed on one thread */
+#define FLUSH_THREADS       4
+#define FLUSH_NROUNDS       4
+#define FLUSH_NGROUPS       2000
+#define FLUSH_NCHUNKS       4000
+
+/* Declaration for test_gathered_writes() */
+#define FILE11           "tfile11"      /* Test file (suffixes added per driver) */
+#define GATHER_NGROUPS      500
+#define GATHER_WRITES_RATIO 4           /* Groups per metadata write, at least */
+
 /* Files created under 1.6 branch and 1.8 branch--used in test_filespace_compatible() */
 const char *OLD_FILENAME[] = {
     "filespace_1_6.h5",    /* 1.6 HDF5 file */
@@ -1436,6 +1455,7 @@ test_obj_count_and_id(hid_t fid1, hid_t fid2, hid_t did, hid_t gid1,
                     case H5I_ERROR_CLASS:
                     case H5I_ERROR_MSG:
                     case H5I_ERROR_STACK:
+                    case H5I_EVENTSET:
                     case H5I_NTYPES:
                     default:
                         ERROR("H5Fget_obj_ids");
@@ -7049,6 +7069,580 @@ test_incr_filesize(void)
     }
 } /* end test_incr_filesize() */
 
+/****************************************************************
+**
+**  test_meta_prefetch():
+**    Verify that H5Pset_meta_prefetch() checks its size and is
+**    kept with the file, that the objects in a file read with
+**    metadata prefetching enabled are the ones written, and that
+**    reading them read-only (prefetching) takes fewer metadata
+**    reads than read-write (not prefetching).
+**
+****************************************************************/
+static void
+test_meta_prefetch(const char *env_h5_drvr)
+{
+    unsigned intents[2] = {H5F_ACC_RDONLY, H5F_ACC_RDWR}; /* File access flags to open with */
+    unsigned long long meta_reads[2];   /* Metadata reads made with each */
+    h5_io_counts_t counts;              /* I/O requests made */
+    hbool_t  counted;                   /* Whether the I/O requests are counted */
+    hid_t    fid;                       /* File ID */
+    hid_t    fapl;                      /* File access property list */
+    hid_t    fapl2;                     /* File access property list from file */
+    hid_t    gid;                       /* Group ID */
+    hid_t    dspace;                    /* Dataspace ID */
+    hid_t    dset;                      /* Dataset ID */
+    hsize_t  dims[1] = {PREFETCH_NDSETS}; /* Dataset dimensions */
+    int      wdata[PREFETCH_NDSETS];    /* Data written */
+    int      rdata[PREFETCH_NDSETS];    /* Data read */
+    hsize_t  prefetch_size;             /* Metadata prefetch size */
+    unsigned u, v, w, i;                /* Local index variables */
+    char     filename[FILENAME_LEN];    /* Filename to use */
+    char     name[32];                  /* Object name */
+    herr_t   ret;                       /* Return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing metadata prefetching\n"));
+
+    fapl = h5_fileaccess();
+    h5_fixname(FILE9, fapl, filename, sizeof filename);
+
+    /* Check the default prefetch size, and that it can't be set to 0 or
+     * to more than a size_t holds */
+    ret = H5Pget_meta_prefetch(fapl, &prefetch_size);
+    CHECK(ret, FAIL, "H5Pget_meta_prefetch");
+    VERIFY(prefetch_size, 0, "H5Pget_meta_prefetch");
+
+    H5E_BEGIN_TRY {
+        ret = H5Pset_meta_prefetch(fapl, (hsize_t)0);
+    } H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Pset_meta_prefetch");
+
+    if(sizeof(size_t) < sizeof(hsize_t)) {
+        H5E_BEGIN_TRY {
+            ret = H5Pset_meta_prefetch(fapl, (hsize_t)SIZE_MAX + 1);
+        } H5E_END_TRY;
+        VERIFY(ret, FAIL, "H5Pset_meta_prefetch");
+    } /* end if */
+
+    /* Create the test file, with groups of small datasets */
+    fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    CHECK(fid, FAIL, "H5Fcreate");
+
+    dspace = H5Screate_simple(1, dims, NULL);
+    CHECK(dspace, FAIL, "H5Screate_simple");
+
+    for(u = 0; u < PREFETCH_NGROUPS; u++) {
+        sprintf(name, "Group %u", u);
+        gid = H5Gcreate2(fid, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        CHECK(gid, FAIL, "H5Gcreate2");
+
+        for(v = 0; v < PREFETCH_NDSETS; v++) {
+            for(w = 0; w < PREFETCH_NDSETS; w++)
+                wdata[w] = (int)((u * PREFETCH_NDSETS + v) * PREFETCH_NDSETS + w);
+
+            sprintf(name, "Dataset %u", v);
+            dset = H5Dcreate2(gid, name, H5T_NATIVE_INT, dspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            CHECK(dset, FAIL, "H5Dcreate2");
+
+            ret = H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata);
+            CHECK(ret, FAIL, "H5Dwrite");
+
+            ret = H5Dclose(dset);
+            CHECK(ret, FAIL, "H5Dclose");
+        } /* end for */
+
+        ret = H5Gclose(gid);
+        CHECK(ret, FAIL, "H5Gclose");
+    } /* end for */
+
+    ret = H5Sclose(dspace);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    /* Enable metadata prefetching */
+    ret = H5Pset_meta_prefetch(fapl, (hsize_t)PREFETCH_SIZE);
+    CHECK(ret, FAIL, "H5Pset_meta_prefetch");
+
+    /* Count the reads, with drivers the counting VFD can stand in for */
+    counted = (hbool_t)(!HDstrcmp(env_h5_drvr, "nomatch") || !HDstrcmp(env_h5_drvr, "sec2"));
+    if(counted) {
+        ret = h5_set_fapl_count(fapl, &counts, 0);
+        CHECK(ret, FAIL, "h5_set_fapl_count");
+    } /* end if */
+
+    /* Read the file back, read-only (prefetching) and read-write (not) */
+    for(i = 0; i < 2; i++) {
+        if(counted)
+            HDmemset(&counts, 0, sizeof(counts));
+
+        fid = H5Fopen(filename, intents[i], fapl);
+        CHECK(fid, FAIL, "H5Fopen");
+
+        /* Check the prefetch size is kept with the file */
+        fapl2 = H5Fget_access_plist(fid);
+        CHECK(fapl2, FAIL, "H5Fget_access_plist");
+
+        ret = H5Pget_meta_prefetch(fapl2, &prefetch_size);
+        CHECK(ret, FAIL, "H5Pget_meta_prefetch");
+        VERIFY(prefetch_size, PREFETCH_SIZE, "H5Pget_meta_prefetch");
+
+        ret = H5Pclose(fapl2);
+        CHECK(ret, FAIL, "H5Pclose");
+
+        /* Read the datasets, in reverse order */
+        for(u = PREFETCH_NGROUPS; u > 0; u--)
+            for(v = PREFETCH_NDSETS; v > 0; v--) {
+                sprintf(name, "Group %u/Dataset %u", u - 1, v - 1);
+                dset = H5Dopen2(fid, name, H5P_DEFAULT);
+                CHECK(dset, FAIL, "H5Dopen2");
+
+                ret = H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
+                CHECK(ret, FAIL, "H5Dread");
+
+                for(w = 0; w < PREFETCH_NDSETS; w++)
+                    VERIFY(rdata[w], (int)(((u - 1) * PREFETCH_NDSETS + (v - 1)) * PREFETCH_NDSETS + w), "H5Dread");
+
+                ret = H5Dclose(dset);
+                CHECK(ret, FAIL, "H5Dclose");
+            } /* end for */
+
+        ret = H5Fclose(fid);
+        CHECK(ret, FAIL, "H5Fclose");
+
+        if(counted)
+            meta_reads[i] = counts.meta_reads;
+    } /* end for */
+
+    /* Prefetching reads the metadata in a few large blocks, rather than
+     * in many small reads */
+    if(counted && meta_reads[0] * 4 > meta_reads[1])
+        TestErrPrintf("%d: metadata reads with prefetching (%llu) should be fewer than without (%llu)\n", __LINE__, meta_reads[0], meta_reads[1]);
+
+    ret = H5Pclose(fapl);
+    CHECK(ret, FAIL, "H5Pclose");
+} /* end test_meta_prefetch() */
+
+/****************************************************************
+**
+**  test_mdc_flush_threads_write():
+**    Creates a file with a group of many groups (whose links are
+**    kept in symbol table nodes or a v2 B-tree) and a dataset of
+**    many chunks (indexed by a v1 B-tree or an extensible array),
+**    in FLUSH_NROUNDS rounds, flushing the file after each round.
+**    Each round dirties enough of those entries to serialize them
+**    on several threads, so later flushes reuse the threads
+**    started by the first.
+**
+****************************************************************/
+static void
+test_mdc_flush_threads_write(const char *filename, hid_t fapl)
+{
+    hid_t    fid;                       /* File ID */
+    hid_t    fcpl;                      /* File creation property list */
+    hid_t    gcpl;                      /* Group creation property list */
+    hid_t    gid;                       /* Group ID */
+    hid_t    dcpl;                      /* Dataset creation property list */
+    hid_t    dspace;                    /* Dataspace ID */
+    hid_t    mspace;                    /* Memory dataspace ID */
+    hid_t    dset;                      /* Dataset ID */
+    hsize_t  dims[1] = {0};             /* Dataset dimensions */
+    hsize_t  max_dims[1] = {H5S_UNLIMITED}; /* Dataset maximum dimensions */
+    hsize_t  chunk_dims[1] = {1};       /* Chunk dimensions */
+    hsize_t  start[1];                  /* Start of the elements written */
+    hsize_t  count[1] = {FLUSH_NCHUNKS / FLUSH_NROUNDS}; /* # of elements written */
+    int      wdata[FLUSH_NCHUNKS / FLUSH_NROUNDS]; /* Data written */
+    unsigned r;                         /* Round of changes */
+    unsigned u;                         /* Local index variable */
+    char     name[32];                  /* Object name */
+    herr_t   ret;                       /* Return value */
+
+    /* Don't keep object times, so files written with different # of
+     * threads can be compared (the root group's are set with the file
+     * creation properties) */
+    fcpl = H5Pcreate(H5P_FILE_CREATE);
+    CHECK(fcpl, FAIL, "H5Pcreate");
+
+    ret = H5Pset_obj_track_times(fcpl, FALSE);
+    CHECK(ret, FAIL, "H5Pset_obj_track_times");
+
+    gcpl = H5Pcreate(H5P_GROUP_CREATE);
+    CHECK(gcpl, FAIL, "H5Pcreate");
+
+    ret = H5Pset_obj_track_times(gcpl, FALSE);
+    CHECK(ret, FAIL, "H5Pset_obj_track_times");
+
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    CHECK(dcpl, FAIL, "H5Pcreate");
+
+    ret = H5Pset_obj_track_times(dcpl, FALSE);
+    CHECK(ret, FAIL, "H5Pset_obj_track_times");
+
+    ret = H5Pset_chunk(dcpl, 1, chunk_dims);
+    CHECK(ret, FAIL, "H5Pset_chunk");
+
+    fid = H5Fcreate(filename, H5F_ACC_TRUNC, fcpl, fapl);
+    CHECK(fid, FAIL, "H5Fcreate");
+
+    gid = H5Gcreate2(fid, "Group", H5P_DEFAULT, gcpl, H5P_DEFAULT);
+    CHECK(gid, FAIL, "H5Gcreate2");
+
+    dspace = H5Screate_simple(1, dims, max_dims);
+    CHECK(dspace, FAIL, "H5Screate_simple");
+
+    dset = H5Dcreate2(fid, "Dataset", H5T_NATIVE_INT, dspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    CHECK(dset, FAIL, "H5Dcreate2");
+
+    ret = H5Sclose(dspace);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    mspace = H5Screate_simple(1, count, NULL);
+    CHECK(mspace, FAIL, "H5Screate_simple");
+
+    for(r = 0; r < FLUSH_NROUNDS; r++) {
+        for(u = r * (FLUSH_NGROUPS / FLUSH_NROUNDS); u < (r + 1) * (FLUSH_NGROUPS / FLUSH_NROUNDS); u++) {
+            hid_t    gid2;                  /* Group ID */
+
+            sprintf(name, "Group %u", u);
+            gid2 = H5Gcreate2(gid, name, H5P_DEFAULT, gcpl, H5P_DEFAULT);
+            CHECK(gid2, FAIL, "H5Gcreate2");
+
+            ret = H5Gclose(gid2);
+            CHECK(ret, FAIL, "H5Gclose");
+        } /* end for */
+
+        /* Extend the dataset and write its new chunks */
+        start[0] = dims[0];
+        dims[0] += count[0];
+        ret = H5Dset_extent(dset, dims);
+        CHECK(ret, FAIL, "H5Dset_extent");
+
+        dspace = H5Dget_space(dset);
+        CHECK(dspace, FAIL, "H5Dget_space");
+
+        ret = H5Sselect_hyperslab(dspace, H5S_SELECT_SET, start, NULL, count, NULL);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab");
+
+        for(u = 0; u < count[0]; u++)
+            wdata[u] = (int)(start[0] + u);
+
+        ret = H5Dwrite(dset, H5T_NATIVE_INT, mspace, dspace, H5P_DEFAULT, wdata);
+        CHECK(ret, FAIL, "H5Dwrite");
+
+        ret = H5Sclose(dspace);
+        CHECK(ret, FAIL, "H5Sclose");
+
+        ret = H5Fflush(fid, H5F_SCOPE_GLOBAL);
+        CHECK(ret, FAIL, "H5Fflush");
+    } /* end for */
+
+    ret = H5Sclose(mspace);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    ret = H5Dclose(dset);
+    CHECK(ret, FAIL, "H5Dclose");
+
+    ret = H5Gclose(gid);
+    CHECK(ret, FAIL, "H5Gclose");
+
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    ret = H5Pclose(dcpl);
+    CHECK(ret, FAIL, "H5Pclose");
+
+    ret = H5Pclose(gcpl);
+    CHECK(ret, FAIL, "H5Pclose");
+
+    ret = H5Pclose(fcpl);
+    CHECK(ret, FAIL, "H5Pclose");
+} /* end test_mdc_flush_threads_write() */
+
+/****************************************************************
+**
+**  test_mdc_flush_threads():
+**    Verify that H5Pset_mdc_flush_threads() is kept with the
+**    file, and that files whose metadata is serialized on several
+**    threads over several flushes read back correctly and (with
+**    drivers writing a single file) are the same as files written
+**    on one thread, with both the earliest and the latest file
+**    format.
+**
+****************************************************************/
+static void
+test_mdc_flush_threads(const char *env_h5_drvr)
+{
+    hid_t    fid;                       /* File ID */
+    hid_t    fapl;                      /* File access property list */
+    hid_t    fapl2;                     /* File access property list from file */
+    hid_t    gid;                       /* Group ID */
+    hid_t    dset;                      /* Dataset ID */
+    int      rdata[FLUSH_NCHUNKS];      /* Data read */
+    H5G_info_t ginfo;                   /* Group info */
+    hbool_t  compared;                  /* Whether the files are compared */
+    unsigned nthreads;                  /* # of flush threads */
+    unsigned latest;                    /* Whether to use the latest format */
+    unsigned u;                         /* Local index variable */
+    char     filename[FILENAME_LEN];    /* Filename to use */
+    char     filename2[FILENAME_LEN];   /* Filename of the file written on one thread */
+    char     name[32];                  /* Object name */
+    herr_t   ret;                       /* Return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing serializing metadata on several threads\n"));
+
+    fapl = h5_fileaccess();
+    h5_fixname(FILE10, fapl, filename, sizeof filename);
+    h5_fixname(FILE10_SERIAL, fapl, filename2, sizeof filename2);
+
+    /* Check the default # of threads, and that it can't be 0 */
+    ret = H5Pget_mdc_flush_threads(fapl, &nthreads);
+    CHECK(ret, FAIL, "H5Pget_mdc_flush_threads");
+    VERIFY(nthreads, 1, "H5Pget_mdc_flush_threads");
+
+    H5E_BEGIN_TRY {
+        ret = H5Pset_mdc_flush_threads(fapl, 0);
+    } H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Pset_mdc_flush_threads");
+
+    /* Only compare files with drivers which write the file as is */
+    compared = (hbool_t)(!HDstrcmp(env_h5_drvr, "nomatch") || !HDstrcmp(env_h5_drvr, "sec2"));
+
+    for(latest = 0; latest < 2; latest++) {
+        if(latest) {
+            ret = H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+            CHECK(ret, FAIL, "H5Pset_libver_bounds");
+        } /* end if */
+
+        /* Write the file on one thread, then on several */
+        ret = H5Pset_mdc_flush_threads(fapl, 1);
+        CHECK(ret, FAIL, "H5Pset_mdc_flush_threads");
+
+        test_mdc_flush_threads_write(filename2, fapl);
+
+        ret = H5Pset_mdc_flush_threads(fapl, FLUSH_THREADS);
+        CHECK(ret, FAIL, "H5Pset_mdc_flush_threads");
+
+        test_mdc_flush_threads_write(filename, fapl);
+
+        if(compared) {
+            FILE    *fp, *fp2;              /* Files compared */
+            char     buf[1024], buf2[1024]; /* Blocks of the files */
+            size_t   nread, nread2;         /* # of bytes read */
+
+            fp = HDfopen(filename, "rb");
+            CHECK_PTR(fp, "HDfopen");
+            fp2 = HDfopen(filename2, "rb");
+            CHECK_PTR(fp2, "HDfopen");
+
+            if(fp && fp2)
+                do {
+                    nread = HDfread(buf, 1, sizeof(buf), fp);
+                    nread2 = HDfread(buf2, 1, sizeof(buf2), fp2);
+                    if(nread != nread2 || HDmemcmp(buf, buf2, nread)) {
+                        TestErrPrintf("%d: file flushed on %u threads differs from file flushed on one\n", __LINE__, (unsigned)FLUSH_THREADS);
+                        break;
+                    } /* end if */
+                } while(nread > 0);
+
+            if(fp)
+                HDfclose(fp);
+            if(fp2)
+                HDfclose(fp2);
+        } /* end if */
+
+        /* Check the # of threads is kept with the file, and read it back */
+        fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl);
+        CHECK(fid, FAIL, "H5Fopen");
+
+        fapl2 = H5Fget_access_plist(fid);
+        CHECK(fapl2, FAIL, "H5Fget_access_plist");
+
+        ret = H5Pget_mdc_flush_threads(fapl2, &nthreads);
+        CHECK(ret, FAIL, "H5Pget_mdc_flush_threads");
+        VERIFY(nthreads, FLUSH_THREADS, "H5Pget_mdc_flush_threads");
+
+        ret = H5Pclose(fapl2);
+        CHECK(ret, FAIL, "H5Pclose");
+
+        gid = H5Gopen2(fid, "Group", H5P_DEFAULT);
+        CHECK(gid, FAIL, "H5Gopen2");
+
+        ret = H5Gget_info(gid, &ginfo);
+        CHECK(ret, FAIL, "H5Gget_info");
+        VERIFY(ginfo.nlinks, FLUSH_NGROUPS, "H5Gget_info");
+
+        for(u = 0; u < FLUSH_NGROUPS; u++) {
+            sprintf(name, "Group %u", u);
+            ret = H5Lexists(gid, name, H5P_DEFAULT);
+            VERIFY(ret, TRUE, "H5Lexists");
+        } /* end for */
+
+        ret = H5Gclose(gid);
+        CHECK(ret, FAIL, "H5Gclose");
+
+        dset = H5Dopen2(fid, "Dataset", H5P_DEFAULT);
+        CHECK(dset, FAIL, "H5Dopen2");
+
+        HDmemset(rdata, 0, sizeof(rdata));
+        ret = H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
+        CHECK(ret, FAIL, "H5Dread");
+
+        for(u = 0; u < FLUSH_NCHUNKS; u++)
+            VERIFY(rdata[u], (int)u, "H5Dread");
+
+        ret = H5Dclose(dset);
+        CHECK(ret, FAIL, "H5Dclose");
+
+        ret = H5Fclose(fid);
+        CHECK(ret, FAIL, "H5Fclose");
+    } /* end for */
+
+    ret = H5Pclose(fapl);
+    CHECK(ret, FAIL, "H5Pclose");
+} /* end test_mdc_flush_threads() */
+
+/****************************************************************
+**
+**  test_gathered_writes():
+**    Verify that files whose adjacent dirty metadata is written
+**    together when flushed read back correctly, with both the
+**    earliest and the latest file format.  Writes are gathered with
+**    the split driver, which doesn't accumulate metadata, and with
+**    the counting driver when it hides that it does, which also
+**    checks that a latest format file (whose groups' object headers
+**    are next to each other) is written with far fewer writes than
+**    it has groups.  Drivers which accumulate metadata merge the
+**    writes themselves.
+**
+****************************************************************/
+static void
+test_gathered_writes(void)
+{
+    hid_t    fid;                       /* File ID */
+    hid_t    fapl;                      /* File access property list */
+    hid_t    gid;                       /* Group ID */
+    H5G_info_t ginfo;                   /* Group info */
+    h5_io_counts_t counts;              /* I/O requests counted */
+    unsigned long long meta_writes;     /* Metadata writes counted */
+    unsigned driver;                    /* Driver to use: the test's, split or counting */
+    unsigned latest;                    /* Whether to use the latest format */
+    unsigned u;                         /* Local index variable */
+    char     filename[FILENAME_LEN];    /* Filename to use */
+    char     name[32];                  /* Object name */
+    htri_t   exists;                    /* Whether a link exists */
+    herr_t   ret;                       /* Return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing writing adjacent metadata together\n"));
+
+    for(driver = 0; driver < 3; driver++)
+        for(latest = 0; latest < 2; latest++) {
+            if(1 == driver) {
+                fapl = H5Pcreate(H5P_FILE_ACCESS);
+                CHECK(fapl, FAIL, "H5Pcreate");
+
+                ret = H5Pset_fapl_split(fapl, "-m.h5", H5P_DEFAULT, "-r.h5", H5P_DEFAULT);
+                CHECK(ret, FAIL, "H5Pset_fapl_split");
+
+                HDstrcpy(filename, FILE11);
+            } /* end if */
+            else if(2 == driver) {
+                fapl = H5Pcreate(H5P_FILE_ACCESS);
+                CHECK(fapl, FAIL, "H5Pcreate");
+
+                ret = h5_set_fapl_count(fapl, &counts, H5FD_FEAT_ACCUMULATE_METADATA);
+                CHECK(ret, FAIL, "h5_set_fapl_count");
+
+                HDstrcpy(filename, FILE11 ".h5");
+            } /* end if */
+            else {
+                fapl = h5_fileaccess();
+                h5_fixname(FILE11, fapl, filename, sizeof filename);
+            } /* end else */
+            if(latest) {
+                ret = H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+                CHECK(ret, FAIL, "H5Pset_libver_bounds");
+            } /* end if */
+
+            /* Create the test file, with a group of many groups */
+            fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+            CHECK(fid, FAIL, "H5Fcreate");
+
+            gid = H5Gcreate2(fid, "Group", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            CHECK(gid, FAIL, "H5Gcreate2");
+
+            for(u = 0; u < GATHER_NGROUPS; u++) {
+                hid_t    gid2;                  /* Group ID */
+
+                sprintf(name, "Group %u", u);
+                gid2 = H5Gcreate2(gid, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+                CHECK(gid2, FAIL, "H5Gcreate2");
+
+                ret = H5Gclose(gid2);
+                CHECK(ret, FAIL, "H5Gclose");
+            } /* end for */
+
+            ret = H5Gclose(gid);
+            CHECK(ret, FAIL, "H5Gclose");
+
+            ret = H5Fclose(fid);
+            CHECK(ret, FAIL, "H5Fclose");
+
+            /* Reopen the file and remove every other group, dirtying
+             * metadata which isn't all adjacent
+             */
+            fid = H5Fopen(filename, H5F_ACC_RDWR, fapl);
+            CHECK(fid, FAIL, "H5Fopen");
+
+            for(u = 0; u < GATHER_NGROUPS; u += 2) {
+                sprintf(name, "Group/Group %u", u);
+                ret = H5Ldelete(fid, name, H5P_DEFAULT);
+                CHECK(ret, FAIL, "H5Ldelete");
+            } /* end for */
+
+            ret = H5Fclose(fid);
+            CHECK(ret, FAIL, "H5Fclose");
+
+            /* Without gathering, each group would take at least one
+             * write of its own.  In the earliest format the groups'
+             * metadata is of different types, so isn't gathered. */
+            if(2 == driver && latest) {
+                meta_writes = counts.meta_writes;
+                if(meta_writes * GATHER_WRITES_RATIO > GATHER_NGROUPS)
+                    TestErrPrintf("%d: %llu metadata writes for %u groups, expected fewer than %u\n", __LINE__, meta_writes, (unsigned)GATHER_NGROUPS, (unsigned)(GATHER_NGROUPS / GATHER_WRITES_RATIO));
+            } /* end if */
+
+            /* Read the file back */
+            fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl);
+            CHECK(fid, FAIL, "H5Fopen");
+
+            gid = H5Gopen2(fid, "Group", H5P_DEFAULT);
+            CHECK(gid, FAIL, "H5Gopen2");
+
+            ret = H5Gget_info(gid, &ginfo);
+            CHECK(ret, FAIL, "H5Gget_info");
+            VERIFY(ginfo.nlinks, GATHER_NGROUPS / 2, "H5Gget_info");
+
+            for(u = 0; u < GATHER_NGROUPS; u++) {
+                sprintf(name, "Group %u", u);
+                exists = H5Lexists(gid, name, H5P_DEFAULT);
+                VERIFY(exists, (u % 2) ? TRUE : FALSE, "H5Lexists");
+            } /* end for */
+
+            ret = H5Gclose(gid);
+            CHECK(ret, FAIL, "H5Gclose");
+
+            ret = H5Fclose(fid);
+            CHECK(ret, FAIL, "H5Fclose");
+
+            ret = H5Pclose(fapl);
+            CHECK(ret, FAIL, "H5Pclose");
+        } /* end for */
+} /* end test_gathered_writes() */
+
 /****************************************************************
 **
 **  test_deprec():
@@ -7336,6 +7930,9 @@ test_file(void)
     test_libver_macros();                       /* Test the macros for library version comparison */
     test_libver_macros2();                      /* Test the macros for library version comparison */
     test_incr_filesize();                       /* Test H5Fincrement_filesize() and H5Fget_eoa() */
+    test_meta_prefetch(env_h5_drvr);            /* Test H5Pset_meta_prefetch() and reading with it */
+    test_mdc_flush_threads(env_h5_drvr);        /* Test H5Pset_mdc_flush_threads() and flushing with it */
+    test_gathered_writes();                     /* Test writing adjacent metadata together */
 #ifndef H5_NO_DEPRECATED_SYMBOLS
     test_deprec();                              /* Test deprecated routines */
 #endif /* H5_NO_DEPRECATED_SYMBOLS */
@@ -7367,5 +7964,11 @@ cleanup_file(void)
     HDremove(FILE5);
     HDremove(FILE6);
     HDremove(FILE7);
+    HDremove(FILE9);
+    HDremove(FILE10);
+    HDremove(FILE10_SERIAL);
+    HDremove(FILE11 ".h5");
+    HDremove(FILE11 "-m.h5");
+    HDremove(FILE11 "-r.h5");
 }
 
@@ -3027,6 +3027,7 @@ test_misc19(void)
     hid_t ecid = -1;                /* Error Class ID           */
     hid_t emid = -1;                /* Error Message ID         */
     hid_t esid = -1;                /* Error Stack ID           */
+    hid_t evsid = -1;               /* Event Set ID             */
     hid_t vfdid = -1;               /* Virtual File Driver ID   */
     H5FD_class_t *vfd_cls = NULL;   /* VFD class                */
     int rc;                         /* Reference count          */
@@ -3440,6 +3441,38 @@ test_misc19(void)
     } H5E_END_TRY;
     VERIFY(ret, FAIL, "H5Eclose_stack");
 
+/* Check H5I operations on event sets */
+
+    /* Create an event set */
+    evsid = H5EScreate();
+    CHECK(evsid, FAIL, "H5EScreate");
+
+    /* Check the reference count */
+    rc = H5Iget_ref(evsid);
+    VERIFY(rc, 1, "H5Iget_ref");
+
+    /* Inc the reference count */
+    rc = H5Iinc_ref(evsid);
+    VERIFY(rc, 2, "H5Iinc_ref");
+
+    /* Close the event set normally */
+    ret = H5ESclose(evsid);
+    CHECK(ret, FAIL, "H5ESclose");
+
+    /* Check the reference count */
+    rc = H5Iget_ref(evsid);
+    VERIFY(rc, 1, "H5Iget_ref");
+
+    /* Close the event set by decrementing the reference count */
+    rc = H5Idec_ref(evsid);
+    VERIFY(rc, 0, "H5Idec_ref");
+
+    /* Try closing the event set again (should fail) */
+    H5E_BEGIN_TRY {
+        ret = H5ESclose(evsid);
+    } H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5ESclose");
+
 
 /* Check H5I operations on virtual file drivers */
 
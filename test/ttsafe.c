@@ -117,6 +117,10 @@ int main(int argc, char *argv[])
     AddTest("cancel", tts_cancel, cleanup_cancel, "thread cancellation safety test", NULL);
 #endif /* H5_HAVE_PTHREAD_H */
     AddTest("acreate", tts_acreate, cleanup_acreate, "multi-attribute creation", NULL);
+#ifdef H5_HAVE_PTHREAD_H
+    /* The shared read path is only available with pthreads ... */
+    AddTest("rdlock", tts_rdlock, NULL, "concurrent queries on a shared API lock", NULL);
+#endif /* H5_HAVE_PTHREAD_H */
 
 #else /* H5_HAVE_THREADSAFE */
 
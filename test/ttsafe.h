@@ -35,6 +35,7 @@ void                    tts_dcreate(void);
 void                    tts_error(void);
 void                    tts_cancel(void);
 void                    tts_acreate(void);
+void                    tts_rdlock(void);
 
 /* Prototypes for the cleanup routines */
 void                    cleanup_dcreate(void);
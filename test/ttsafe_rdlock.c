@@ -0,0 +1,178 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/********************************************************************
+ *
+ * Testing for thread safety of the shared read path of query API
+ * routines. -- Threaded program --
+ * ------------------------------------------------------------------
+ *
+ * Plan: Have many threads query the same datatype, dataspace and
+ *       dataset creation property list at once, while other threads
+ *       create and close objects of the same kinds, and some of the
+ *       queries are given IDs which aren't valid.
+ *
+ * Claim: Queries which run with the API lock held shared always see
+ *        consistent objects and ID tables, return the same values as
+ *        they do with the lock held exclusively, and still report
+ *        errors on the thread's own error stack.
+ *
+ * HDF5 APIs exercised in thread:
+ * H5Tget_class, H5Tget_size, H5Sget_simple_extent_ndims,
+ * H5Sget_simple_extent_npoints, H5Sget_simple_extent_dims,
+ * H5Pget_layout, H5Pget_chunk, H5Screate_simple, H5Tcopy, H5Pcreate,
+ * H5Pset_chunk, H5Sclose, H5Tclose, H5Pclose, H5Eget_num.
+ *
+ ********************************************************************/
+
+#include "ttsafe.h"
+
+#ifdef H5_HAVE_THREADSAFE
+
+#define NUM_READERS     8
+#define NUM_WRITERS     2
+#define NUM_ITERS       2000
+#define RANK            2
+#define DIM0            16
+#define DIM1            32
+#define CHUNK0          4
+#define CHUNK1          8
+
+void *tts_rdlock_reader(void *);
+void *tts_rdlock_writer(void *);
+
+typedef struct rdlock_data_struct {
+    hid_t type;                 /* Datatype to query */
+    hid_t space;                /* Dataspace to query */
+    hid_t dcpl;                 /* Dataset creation property list to query */
+} ttsafe_rdlock_data_t;
+
+void tts_rdlock(void)
+{
+    H5TS_thread_t threads[NUM_READERS + NUM_WRITERS];
+    ttsafe_rdlock_data_t data;
+    hsize_t dims[RANK] = {DIM0, DIM1};
+    hsize_t chunk_dims[RANK] = {CHUNK0, CHUNK1};
+    herr_t ret;
+    int i;
+
+    data.type = H5Tcopy(H5T_NATIVE_INT);
+    CHECK(data.type, FAIL, "H5Tcopy");
+    data.space = H5Screate_simple(RANK, dims, NULL);
+    CHECK(data.space, FAIL, "H5Screate_simple");
+    data.dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    CHECK(data.dcpl, FAIL, "H5Pcreate");
+    ret = H5Pset_chunk(data.dcpl, RANK, chunk_dims);
+    CHECK(ret, FAIL, "H5Pset_chunk");
+
+    for(i = 0; i < NUM_READERS; i++)
+        threads[i] = H5TS_create_thread(tts_rdlock_reader, NULL, &data);
+    for(i = NUM_READERS; i < NUM_READERS + NUM_WRITERS; i++)
+        threads[i] = H5TS_create_thread(tts_rdlock_writer, NULL, NULL);
+
+    for(i = 0; i < NUM_READERS + NUM_WRITERS; i++)
+        H5TS_wait_for_thread(threads[i]);
+
+    ret = H5Pclose(data.dcpl);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Sclose(data.space);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Tclose(data.type);
+    CHECK(ret, FAIL, "H5Tclose");
+}
+
+void *tts_rdlock_reader(void *client_data)
+{
+    ttsafe_rdlock_data_t *data = (ttsafe_rdlock_data_t *)client_data;
+    hsize_t dims[RANK], maxdims[RANK];
+    hsize_t chunk_dims[RANK];
+    int i;
+
+    for(i = 0; i < NUM_ITERS; i++) {
+        if(H5Tget_class(data->type) != H5T_INTEGER)
+            TestErrPrintf("wrong datatype class.  Test failed!\n");
+        if(H5Tget_size(data->type) != sizeof(int))
+            TestErrPrintf("wrong datatype size.  Test failed!\n");
+
+        if(H5Sget_simple_extent_ndims(data->space) != RANK)
+            TestErrPrintf("wrong dataspace rank.  Test failed!\n");
+        if(H5Sget_simple_extent_npoints(data->space) != DIM0 * DIM1)
+            TestErrPrintf("wrong number of elements.  Test failed!\n");
+        if(H5Sget_simple_extent_dims(data->space, dims, maxdims) != RANK
+                || dims[0] != DIM0 || dims[1] != DIM1
+                || maxdims[0] != DIM0 || maxdims[1] != DIM1)
+            TestErrPrintf("wrong dataspace dimensions.  Test failed!\n");
+
+        if(H5Pget_layout(data->dcpl) != H5D_CHUNKED)
+            TestErrPrintf("wrong layout.  Test failed!\n");
+        if(H5Pget_chunk(data->dcpl, RANK, chunk_dims) != RANK
+                || chunk_dims[0] != CHUNK0 || chunk_dims[1] != CHUNK1)
+            TestErrPrintf("wrong chunk dimensions.  Test failed!\n");
+
+        /* Every so often, check that errors are still reported on the
+         * thread's own stack and that the read path resumes afterwards.
+         */
+        if(i % 100 == 0) {
+            size_t size;
+            H5D_layout_t layout;
+
+            H5E_BEGIN_TRY {
+                size = H5Tget_size(data->space);
+            } H5E_END_TRY;
+            if(size != 0 || H5Eget_num(H5E_DEFAULT) <= 0)
+                TestErrPrintf("error not reported.  Test failed!\n");
+            if(H5Tget_size(data->type) != sizeof(int) || H5Eget_num(H5E_DEFAULT) != 0)
+                TestErrPrintf("error stack not cleared.  Test failed!\n");
+
+            /* A property list of the wrong class is only reported once
+             * the exclusive path has taken over
+             */
+            H5E_BEGIN_TRY {
+                layout = H5Pget_layout(H5P_FILE_ACCESS_DEFAULT);
+            } H5E_END_TRY;
+            if(layout != H5D_LAYOUT_ERROR || H5Eget_num(H5E_DEFAULT) <= 0)
+                TestErrPrintf("property list error not reported.  Test failed!\n");
+            if(H5Pget_layout(data->dcpl) != H5D_CHUNKED || H5Eget_num(H5E_DEFAULT) != 0)
+                TestErrPrintf("error stack not cleared.  Test failed!\n");
+        } /* end if */
+    } /* end for */
+
+    return NULL;
+}
+
+void *tts_rdlock_writer(void H5_ATTR_UNUSED *client_data)
+{
+    hsize_t dims[RANK] = {DIM0, DIM1};
+    hsize_t chunk_dims[RANK] = {CHUNK0, CHUNK1};
+    hid_t type, space, dcpl;
+    int i;
+
+    /* Churn the ID tables the readers look their objects up in */
+    for(i = 0; i < NUM_ITERS; i++) {
+        type = H5Tcopy(H5T_NATIVE_INT);
+        space = H5Screate_simple(RANK, dims, NULL);
+        dcpl = H5Pcreate(H5P_DATASET_CREATE);
+        if(type < 0 || space < 0 || dcpl < 0 || H5Pset_chunk(dcpl, RANK, chunk_dims) < 0)
+            TestErrPrintf("unable to create objects.  Test failed!\n");
+        if(H5Tset_size(type, (size_t)(i % 8) + 1) < 0)
+            TestErrPrintf("unable to resize datatype.  Test failed!\n");
+
+        H5Pclose(dcpl);
+        H5Sclose(space);
+        H5Tclose(type);
+    } /* end for */
+
+    return NULL;
+}
+
+#endif /*H5_HAVE_THREADSAFE*/
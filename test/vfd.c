@@ -37,6 +37,19 @@
 #define DSET1_DIM2   32
 #define DSET3_NAME   "dset3"
 
+/* Macros for vector I/O test */
+#define VECTOR_DSET_NAME    "vector dset"
+#define VECTOR_DIM1         64
+#define VECTOR_DIM2         64
+#define VECTOR_CHUNK_DIM    16
+
+/* Macros for mmap VFD test */
+#define MMAP_CONTIG_NAME    "mmap contig"
+#define MMAP_CHUNKED_NAME   "mmap chunked"
+#define MMAP_DIM1           64
+#define MMAP_DIM2           64
+#define MMAP_CHUNK_DIM      16
+
 /* Macros for Direct VFD */
 #ifdef H5_HAVE_DIRECT
 #define MBOUNDARY    512
@@ -58,6 +71,9 @@ const char *FILENAME[] = {
     "stdio_file",        /*7*/
     "windows_file",      /*8*/
     "new_multi_file_v16",/*9*/
+    "vector_file",       /*10*/
+    "mmap_file",         /*11*/
+    "iouring_file",      /*12*/
     NULL
 };
 
@@ -1888,6 +1904,491 @@ error:
 } /* end test_windows() */
 
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io_dset
+ *
+ * Purpose:     Helper for test_vector_io().  Writes and reads back
+ *              strided selections of a dataset in a file opened with
+ *              FAPL_ID, which either has the data sieve buffer disabled
+ *              or uses a driver that doesn't sieve raw data, so that the
+ *              raw data I/O is performed with vector I/O requests.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io_dset(hid_t fapl_id, hbool_t chunked)
+{
+    hid_t       fid = -1;                   /* file ID                      */
+    hid_t       dcpl_id = -1;               /* dataset creation plist ID    */
+    hid_t       dapl_id = -1;               /* dataset access plist ID      */
+    hid_t       did = -1;                   /* dataset ID                   */
+    hid_t       fsid = -1;                  /* file dataspace ID            */
+    hid_t       msid = -1;                  /* memory dataspace ID          */
+    char        filename[1024];             /* filename                     */
+    int         *data_w = NULL;             /* data written to the dataset  */
+    int         *data_r = NULL;             /* data read from the dataset   */
+    hsize_t     dims[2] = {VECTOR_DIM1, VECTOR_DIM2};   /* dataspace dims   */
+    hsize_t     chunk_dims[2] = {VECTOR_CHUNK_DIM, VECTOR_CHUNK_DIM};   /* chunk dims */
+    hsize_t     start[2], stride[2], count[2];          /* hyperslab info   */
+    int         i, j;                       /* iterators                    */
+
+    h5_fixname(FILENAME[10], fapl_id, filename, sizeof(filename));
+
+    if(NULL == (data_w = (int *)HDmalloc(VECTOR_DIM1 * VECTOR_DIM2 * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (data_r = (int *)HDmalloc(VECTOR_DIM1 * VECTOR_DIM2 * sizeof(int))))
+        TEST_ERROR
+    for(i = 0; i < VECTOR_DIM1 * VECTOR_DIM2; i++)
+        data_w[i] = i;
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) < 0)
+        TEST_ERROR
+    if((fsid = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR
+    if((msid = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR
+    if((dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR
+    if((dapl_id = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        TEST_ERROR
+    if(chunked) {
+        if(H5Pset_chunk(dcpl_id, 2, chunk_dims) < 0)
+            TEST_ERROR
+        /* Disable the chunk cache, so chunks are accessed in the file */
+        if(H5Pset_chunk_cache(dapl_id, (size_t)0, (size_t)0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+            TEST_ERROR
+    } /* end if */
+    if((did = H5Dcreate2(fid, VECTOR_DSET_NAME, H5T_NATIVE_INT, fsid, H5P_DEFAULT, dcpl_id, dapl_id)) < 0)
+        TEST_ERROR
+
+    /* Write the whole dataset */
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data_w) < 0)
+        TEST_ERROR
+
+    /* Read every other column into the same positions in memory */
+    start[0] = 0; start[1] = 1;
+    stride[0] = 1; stride[1] = 2;
+    count[0] = VECTOR_DIM1; count[1] = VECTOR_DIM2 / 2;
+    if(H5Sselect_hyperslab(fsid, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+        TEST_ERROR
+    if(H5Sselect_hyperslab(msid, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+        TEST_ERROR
+    HDmemset(data_r, 0, VECTOR_DIM1 * VECTOR_DIM2 * sizeof(int));
+    if(H5Dread(did, H5T_NATIVE_INT, msid, fsid, H5P_DEFAULT, data_r) < 0)
+        TEST_ERROR
+    for(i = 0; i < VECTOR_DIM1; i++)
+        for(j = 0; j < VECTOR_DIM2; j++)
+            if(data_r[(i * VECTOR_DIM2) + j] != ((j % 2) ? data_w[(i * VECTOR_DIM2) + j] : 0))
+                FAIL_PUTS_ERROR("incorrect data read with strided selection");
+
+    /* Overwrite every other column, with the data packed in memory */
+    for(i = 0; i < VECTOR_DIM1 * VECTOR_DIM2; i++)
+        data_w[i] = -i;
+    if(H5Sselect_all(msid) < 0)
+        TEST_ERROR
+    count[0] = VECTOR_DIM1; count[1] = VECTOR_DIM2 / 2;
+    start[0] = 0; start[1] = 0;
+    if(H5Sselect_hyperslab(msid, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+        TEST_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, msid, fsid, H5P_DEFAULT, data_w) < 0)
+        TEST_ERROR
+
+    /* Read the whole dataset back and verify it */
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data_r) < 0)
+        TEST_ERROR
+    for(i = 0; i < VECTOR_DIM1; i++)
+        for(j = 0; j < VECTOR_DIM2; j++) {
+            int expected = (j % 2) ? data_w[(i * VECTOR_DIM2) + (j / 2)] : ((i * VECTOR_DIM2) + j);
+
+            if(data_r[(i * VECTOR_DIM2) + j] != expected)
+                FAIL_PUTS_ERROR("incorrect data read after strided write");
+        } /* end for */
+
+    if(H5Dclose(did) < 0)
+        TEST_ERROR
+    if(H5Sclose(msid) < 0)
+        TEST_ERROR
+    if(H5Sclose(fsid) < 0)
+        TEST_ERROR
+    if(H5Pclose(dapl_id) < 0)
+        TEST_ERROR
+    if(H5Pclose(dcpl_id) < 0)
+        TEST_ERROR
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR
+    h5_delete_test_file(FILENAME[10], fapl_id);
+
+    HDfree(data_w);
+    HDfree(data_r);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Sclose(msid);
+        H5Sclose(fsid);
+        H5Pclose(dapl_id);
+        H5Pclose(dcpl_id);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+
+    HDfree(data_w);
+    HDfree(data_r);
+
+    return -1;
+} /* end test_vector_io_dset() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io
+ *
+ * Purpose:     Tests raw data vector I/O, with a driver that implements
+ *              the vector I/O callbacks (sec2) and one that doesn't (core)
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io(void)
+{
+    hid_t       fapl_id = -1;               /* file access property list ID */
+
+    TESTING("vector I/O");
+
+    if((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR
+    if(H5Pset_sieve_buf_size(fapl_id, (size_t)0) < 0)
+        TEST_ERROR
+
+    /* Driver with vector I/O callbacks */
+    if(H5Pset_fapl_sec2(fapl_id) < 0)
+        TEST_ERROR
+    if(test_vector_io_dset(fapl_id, FALSE) < 0)
+        TEST_ERROR
+    if(test_vector_io_dset(fapl_id, TRUE) < 0)
+        TEST_ERROR
+
+    /* Driver without vector I/O callbacks */
+    if(H5Pset_fapl_core(fapl_id, (size_t)CORE_INCREMENT, FALSE) < 0)
+        TEST_ERROR
+    if(test_vector_io_dset(fapl_id, FALSE) < 0)
+        TEST_ERROR
+    if(test_vector_io_dset(fapl_id, TRUE) < 0)
+        TEST_ERROR
+
+    if(H5Pclose(fapl_id) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl_id);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_vector_io() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_mmap
+ *
+ * Purpose:     Tests the read-only MMAP driver, by reading back a file
+ *              written with the SEC2 driver
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_mmap(void)
+{
+#ifdef H5_HAVE_MMAP
+    hid_t       fid = -1;                   /* file ID                      */
+    hid_t       fapl_id = -1;               /* file access property list ID */
+    hid_t       fapl_id_out = -1;           /* from H5Fget_access_plist     */
+    hid_t       sec2_fapl_id = -1;          /* fapl for writing the file    */
+    hid_t       dcpl_id = -1;               /* dataset creation plist ID    */
+    hid_t       did = -1;                   /* dataset ID                   */
+    hid_t       fsid = -1;                  /* file dataspace ID            */
+    hid_t       msid = -1;                  /* memory dataspace ID          */
+    hid_t       driver_id = -1;             /* ID for this VFD              */
+    unsigned long driver_flags = 0;         /* VFD feature flags            */
+    char        filename[1024];             /* filename                     */
+    void        *os_file_handle = NULL;     /* OS file handle               */
+    int         *data_w = NULL;             /* data written to the datasets */
+    int         *data_r = NULL;             /* data read from the datasets  */
+    hsize_t     dims[2] = {MMAP_DIM1, MMAP_DIM2};   /* dataspace dims       */
+    hsize_t     chunk_dims[2] = {MMAP_CHUNK_DIM, MMAP_CHUNK_DIM};   /* chunk dims */
+    hsize_t     start[2], stride[2], count[2];      /* hyperslab info       */
+    const char  *dset_names[2] = {MMAP_CONTIG_NAME, MMAP_CHUNKED_NAME};
+    int         i, j, u;                    /* iterators                    */
+#endif /* H5_HAVE_MMAP */
+
+    TESTING("MMAP file driver");
+
+#ifndef H5_HAVE_MMAP
+    SKIPPED();
+    return 0;
+#else /* H5_HAVE_MMAP */
+
+    /* Write the file with the SEC2 driver */
+    if((sec2_fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR
+    if(H5Pset_fapl_sec2(sec2_fapl_id) < 0)
+        TEST_ERROR
+    h5_fixname(FILENAME[11], sec2_fapl_id, filename, sizeof(filename));
+
+    if(NULL == (data_w = (int *)HDmalloc(MMAP_DIM1 * MMAP_DIM2 * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (data_r = (int *)HDmalloc(MMAP_DIM1 * MMAP_DIM2 * sizeof(int))))
+        TEST_ERROR
+    for(i = 0; i < MMAP_DIM1 * MMAP_DIM2; i++)
+        data_w[i] = i;
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, sec2_fapl_id)) < 0)
+        TEST_ERROR
+    if((fsid = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR
+    if((did = H5Dcreate2(fid, MMAP_CONTIG_NAME, H5T_NATIVE_INT, fsid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data_w) < 0)
+        TEST_ERROR
+    if(H5Dclose(did) < 0)
+        TEST_ERROR
+    if((dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR
+    if(H5Pset_chunk(dcpl_id, 2, chunk_dims) < 0)
+        TEST_ERROR
+    if((did = H5Dcreate2(fid, MMAP_CHUNKED_NAME, H5T_NATIVE_INT, fsid, H5P_DEFAULT, dcpl_id, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data_w) < 0)
+        TEST_ERROR
+    if(H5Dclose(did) < 0)
+        TEST_ERROR
+    if(H5Pclose(dcpl_id) < 0)
+        TEST_ERROR
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR
+
+    /* Set property list for MMAP driver */
+    if((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR
+    if(H5Pset_fapl_mmap(fapl_id) < 0)
+        TEST_ERROR
+
+    /* Check that the VFD feature flags are correct */
+    if((driver_id = H5Pget_driver(fapl_id)) < 0)
+        TEST_ERROR
+    if(H5FDdriver_query(driver_id, &driver_flags) < 0)
+        TEST_ERROR
+    if(driver_flags != (H5FD_FEAT_POSIX_COMPAT_HANDLE
+                        | H5FD_FEAT_DEFAULT_VFD_COMPATIBLE))
+        TEST_ERROR
+
+    /* The driver is read-only */
+    H5E_BEGIN_TRY {
+        fid = H5Fopen(filename, H5F_ACC_RDWR, fapl_id);
+    } H5E_END_TRY;
+    if(fid >= 0)
+        FAIL_PUTS_ERROR("file opened for writing with MMAP driver");
+    H5E_BEGIN_TRY {
+        fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id);
+    } H5E_END_TRY;
+    if(fid >= 0)
+        FAIL_PUTS_ERROR("file created with MMAP driver");
+
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl_id)) < 0)
+        TEST_ERROR
+
+    /* Check that the driver is correct */
+    if((fapl_id_out = H5Fget_access_plist(fid)) < 0)
+        TEST_ERROR
+    if(H5FD_MMAP != H5Pget_driver(fapl_id_out))
+        TEST_ERROR
+    if(H5Pclose(fapl_id_out) < 0)
+        TEST_ERROR
+
+    /* Check that we can get an operating-system-specific handle from
+     * the library.
+     */
+    if(H5Fget_vfd_handle(fid, H5P_DEFAULT, &os_file_handle) < 0)
+        TEST_ERROR
+    if(os_file_handle == NULL)
+        FAIL_PUTS_ERROR("NULL os-specific vfd/file handle was returned from H5Fget_vfd_handle");
+
+    /* Read both datasets back, whole and with a strided selection */
+    if((msid = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR
+    start[0] = 0; start[1] = 1;
+    stride[0] = 1; stride[1] = 2;
+    count[0] = MMAP_DIM1; count[1] = MMAP_DIM2 / 2;
+    if(H5Sselect_hyperslab(fsid, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+        TEST_ERROR
+    if(H5Sselect_hyperslab(msid, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+        TEST_ERROR
+    for(u = 0; u < 2; u++) {
+        if((did = H5Dopen2(fid, dset_names[u], H5P_DEFAULT)) < 0)
+            TEST_ERROR
+
+        HDmemset(data_r, 0, MMAP_DIM1 * MMAP_DIM2 * sizeof(int));
+        if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data_r) < 0)
+            TEST_ERROR
+        if(HDmemcmp(data_r, data_w, MMAP_DIM1 * MMAP_DIM2 * sizeof(int)))
+            FAIL_PUTS_ERROR("incorrect data read with MMAP driver");
+
+        HDmemset(data_r, 0, MMAP_DIM1 * MMAP_DIM2 * sizeof(int));
+        if(H5Dread(did, H5T_NATIVE_INT, msid, fsid, H5P_DEFAULT, data_r) < 0)
+            TEST_ERROR
+        for(i = 0; i < MMAP_DIM1; i++)
+            for(j = 0; j < MMAP_DIM2; j++)
+                if(data_r[(i * MMAP_DIM2) + j] != ((j % 2) ? data_w[(i * MMAP_DIM2) + j] : 0))
+                    FAIL_PUTS_ERROR("incorrect data read with strided selection");
+
+        if(H5Dclose(did) < 0)
+            TEST_ERROR
+    } /* end for */
+
+    if(H5Sclose(msid) < 0)
+        TEST_ERROR
+    if(H5Sclose(fsid) < 0)
+        TEST_ERROR
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR
+    h5_delete_test_file(FILENAME[11], sec2_fapl_id);
+
+    if(H5Pclose(fapl_id) < 0)
+        TEST_ERROR
+    if(H5Pclose(sec2_fapl_id) < 0)
+        TEST_ERROR
+
+    HDfree(data_w);
+    HDfree(data_r);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Sclose(msid);
+        H5Sclose(fsid);
+        H5Pclose(dcpl_id);
+        H5Pclose(fapl_id_out);
+        H5Pclose(fapl_id);
+        H5Pclose(sec2_fapl_id);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+
+    HDfree(data_w);
+    HDfree(data_r);
+
+    return -1;
+#endif /* H5_HAVE_MMAP */
+} /* end test_mmap() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_iouring
+ *
+ * Purpose:     Tests the file access properties and the vector I/O of the
+ *              io_uring driver.  A small queue depth is used, so that the
+ *              vector requests are split over several batches.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_iouring(void)
+{
+#ifdef H5_HAVE_IOURING
+    hid_t       fid = -1;                   /* file ID                      */
+    hid_t       fapl_id = -1;               /* file access property list ID */
+    hid_t       fapl_id_out = -1;           /* from H5Fget_access_plist     */
+    hid_t       driver_id = -1;             /* ID for this VFD              */
+    unsigned    queue_depth = 0;            /* queue depth from the fapl    */
+    char        filename[1024];             /* filename                     */
+#endif /* H5_HAVE_IOURING */
+
+    TESTING("IOURING file driver");
+
+#ifndef H5_HAVE_IOURING
+    SKIPPED();
+    return 0;
+#else /* H5_HAVE_IOURING */
+
+    if((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR
+
+    /* A queue depth of zero selects the default */
+    if(H5Pset_fapl_iouring(fapl_id, 0) < 0)
+        TEST_ERROR
+    if(H5Pget_fapl_iouring(fapl_id, &queue_depth) < 0)
+        TEST_ERROR
+    if(H5FD_IOURING_QUEUE_DEPTH_DEF != queue_depth)
+        FAIL_PUTS_ERROR("incorrect default queue depth");
+
+    /* The driver doesn't sieve raw data, so the default sieve buffer
+     * size is kept, and raw data I/O still uses the vector callbacks.
+     */
+    if(H5Pset_fapl_iouring(fapl_id, 4) < 0)
+        TEST_ERROR
+
+    /* The driver and its properties are retrieved from an open file */
+    h5_fixname(FILENAME[12], fapl_id, filename, sizeof(filename));
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) < 0)
+        TEST_ERROR
+    if((fapl_id_out = H5Fget_access_plist(fid)) < 0)
+        TEST_ERROR
+    if(H5FD_IOURING != (driver_id = H5Pget_driver(fapl_id_out)))
+        FAIL_PUTS_ERROR("incorrect VFD retrieved");
+    queue_depth = 0;
+    if(H5Pget_fapl_iouring(fapl_id_out, &queue_depth) < 0)
+        TEST_ERROR
+    if(4 != queue_depth)
+        FAIL_PUTS_ERROR("incorrect queue depth retrieved");
+    if(H5Pclose(fapl_id_out) < 0)
+        TEST_ERROR
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR
+    h5_delete_test_file(FILENAME[12], fapl_id);
+
+    /* Strided raw data I/O with batched vector requests */
+    if(test_vector_io_dset(fapl_id, FALSE) < 0)
+        TEST_ERROR
+    if(test_vector_io_dset(fapl_id, TRUE) < 0)
+        TEST_ERROR
+
+    if(H5Pclose(fapl_id) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl_id_out);
+        H5Pclose(fapl_id);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+#endif /* H5_HAVE_IOURING */
+} /* end test_iouring() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:    main
@@ -1921,6 +2422,9 @@ main(void)
     nerrors += test_log() < 0            ? 1 : 0;
     nerrors += test_stdio() < 0          ? 1 : 0;
     nerrors += test_windows() < 0        ? 1 : 0;
+    nerrors += test_vector_io() < 0      ? 1 : 0;
+    nerrors += test_mmap() < 0           ? 1 : 0;
+    nerrors += test_iouring() < 0        ? 1 : 0;
 
     if(nerrors) {
         HDprintf("***** %d Virtual File Driver TEST%s FAILED! *****\n",